@@ -85,6 +85,18 @@
 //
 #define CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS 150
 
+// Hosts usually serve several subscribers, share encoded attribute reports between them.
+#define CHIP_IM_SERVER_MAX_NUM_CACHED_ATTRIBUTE_REPORTS 16
+
+// Expand wildcard attribute paths from a flattened copy of the data model.
+#define CHIP_IM_SERVER_PATH_EXPANSION_CACHE_MAX_ATTRIBUTES 512
+
+// Hosts are often commissioners on busy networks, where the same mDNS queries keep coming.
+#define CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE 8
+
+// Commissioners resolve the same nodes over and over, keep the records they advertise.
+#define CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE 32
+
 // Safe to enable this flag since standalone is associated with host and not a device.
 #define CONFIG_BUILD_FOR_HOST_UNIT_TEST 1
 
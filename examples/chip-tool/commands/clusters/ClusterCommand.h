@@ -75,7 +75,7 @@ public:
         if (CHIP_NO_ERROR != error)
         {
             ChipLogError(chipTool, "Response Failure: %s", chip::ErrorStr(error));
-            mError = error;
+            SetInteractionError(client, error);
             return;
         }
 
@@ -85,7 +85,7 @@ public:
             if (CHIP_NO_ERROR != error)
             {
                 ChipLogError(chipTool, "Response Failure: Can not decode Data");
-                mError = error;
+                SetInteractionError(client, error);
                 return;
             }
         }
@@ -94,16 +94,12 @@ public:
     virtual void OnError(const chip::app::CommandSender * client, CHIP_ERROR error) override
     {
         ChipLogProgress(chipTool, "Error: %s", chip::ErrorStr(error));
-        mError = error;
+        SetInteractionError(client, error);
     }
 
     virtual void OnDone(chip::app::CommandSender * client) override
     {
-        if (mCommandSender.size())
-        {
-            mCommandSender.front().reset();
-            mCommandSender.erase(mCommandSender.begin());
-        }
+        InteractionModelCommands::CleanupCommandSender(client);
 
         // If the command is repeated N times, wait for all the responses to comes in
         // before exiting.
@@ -116,17 +112,18 @@ public:
 
         if (shouldStop)
         {
-            SetCommandExitStatus(mError);
+            SetInteractionDone(client);
         }
     }
 
-    void Shutdown() override
+protected:
+    // Repeated commands would consume the repeat count on the first destination.
+    bool SupportsBatch() const override { return !mRepeatCount.HasValue(); }
+    const void * GetLastStartedInteraction() const override
     {
-        mError = CHIP_NO_ERROR;
-        ModelCommand::Shutdown();
+        return mCommandSender.empty() ? nullptr : mCommandSender.back().get();
     }
 
-protected:
     ClusterCommand(const char * commandName, CredentialIssuerCommands * credsIssuerConfig) :
         InteractionModelCommands(this), ModelCommand(commandName, credsIssuerConfig)
     {
@@ -185,6 +182,5 @@ private:
     chip::ClusterId mClusterId;
     chip::CommandId mCommandId;
 
-    CHIP_ERROR mError = CHIP_NO_ERROR;
     CustomArgument mPayload;
 };
@@ -21,31 +21,82 @@
 #include <app/InteractionModelEngine.h>
 #include <inttypes.h>
 
+#include <algorithm>
+
 using namespace ::chip;
 
+namespace {
+constexpr uint16_t kDefaultBatchConcurrency = 8;
+} // namespace
+
+ModelCommand::BatchSlot::BatchSlot(ModelCommand * aCommand) :
+    command(aCommand), onConnected(OnBatchDeviceConnectedFn, this), onFailure(OnBatchDeviceConnectionFailureFn, this)
+{}
+
 CHIP_ERROR ModelCommand::RunCommand()
 {
+    if (mDestinationIds.size() > 1)
+    {
+        return RunBatch();
+    }
 
-    if (IsGroupId(mDestinationId))
+    NodeId destinationId = mDestinationIds.front();
+    if (IsGroupId(destinationId))
     {
         FabricIndex fabricIndex = CurrentCommissioner().GetFabricIndex();
-        ChipLogProgress(chipTool, "Sending command to group 0x%x", GroupIdFromNodeId(mDestinationId));
+        ChipLogProgress(chipTool, "Sending command to group 0x%x", GroupIdFromNodeId(destinationId));
 
-        return SendGroupCommand(GroupIdFromNodeId(mDestinationId), fabricIndex);
+        return SendGroupCommand(GroupIdFromNodeId(destinationId), fabricIndex);
     }
 
-    ChipLogProgress(chipTool, "Sending command to node 0x%" PRIx64, mDestinationId);
+    ChipLogProgress(chipTool, "Sending command to node 0x%" PRIx64, destinationId);
 
     CommissioneeDeviceProxy * commissioneeDeviceProxy = nullptr;
-    if (CHIP_NO_ERROR == CurrentCommissioner().GetDeviceBeingCommissioned(mDestinationId, &commissioneeDeviceProxy))
+    if (CHIP_NO_ERROR == CurrentCommissioner().GetDeviceBeingCommissioned(destinationId, &commissioneeDeviceProxy))
     {
         return SendCommand(commissioneeDeviceProxy, mEndPointId);
     }
 
-    return CurrentCommissioner().GetConnectedDevice(mDestinationId, &mOnDeviceConnectedCallback,
+    return CurrentCommissioner().GetConnectedDevice(destinationId, &mOnDeviceConnectedCallback,
                                                     &mOnDeviceConnectionFailureCallback);
 }
 
+System::Clock::Timeout ModelCommand::GetInvocationWaitDuration() const
+{
+    // In batch mode, the destinations are connected to and sent the command up to the batch
+    // concurrency at a time.
+    const size_t destinations = std::max<size_t>(mDestinationIds.size(), 1);
+    const size_t concurrency  = std::min<size_t>(mBatchConcurrency.ValueOr(kDefaultBatchConcurrency), destinations);
+    return GetWaitDuration() * static_cast<uint32_t>((destinations + concurrency - 1) / concurrency);
+}
+
+void ModelCommand::SetInteractionError(const void * interaction, CHIP_ERROR error)
+{
+    if (!mBatchActive)
+    {
+        mError = error;
+        return;
+    }
+
+    BatchSlot * slot = FindBatchSlot(interaction);
+    VerifyOrReturn(slot != nullptr,
+                   ChipLogError(chipTool, "Error from an unknown interaction: %" CHIP_ERROR_FORMAT, error.Format()));
+    slot->error = error;
+}
+
+void ModelCommand::SetInteractionDone(const void * interaction)
+{
+    if (!mBatchActive)
+    {
+        SetCommandExitStatus(mError);
+        return;
+    }
+
+    BatchSlot * slot = FindBatchSlot(interaction);
+    VerifyOrReturn(slot != nullptr, ChipLogError(chipTool, "Completion of an unknown interaction"));
+    OnBatchDestinationDone(*slot, slot->error);
+}
+
 void ModelCommand::OnDeviceConnectedFn(void * context, chip::Messaging::ExchangeManager & exchangeMgr,
                                        const chip::SessionHandle & sessionHandle)
 {
@@ -66,10 +117,263 @@ void ModelCommand::OnDeviceConnectionFailureFn(void * context, const chip::Scope
     command->SetCommandExitStatus(err);
 }
 
+CHIP_ERROR ModelCommand::RunBatch()
+{
+    VerifyOrReturnError(SupportsBatch(), CHIP_ERROR_INVALID_ARGUMENT,
+                        ChipLogError(chipTool, "%s does not support multiple destinations", GetName()));
+
+    if (mBatchResultsFile.HasValue())
+    {
+        mBatchResultsStream = fopen(mBatchResultsFile.Value(), "a");
+        VerifyOrReturnError(mBatchResultsStream != nullptr, CHIP_ERROR_OPEN_FAILED,
+                            ChipLogError(chipTool, "Can not open %s", mBatchResultsFile.Value()));
+    }
+    else
+    {
+        mBatchResultsStream = stdout;
+    }
+
+    const size_t concurrency = std::min<size_t>(mBatchConcurrency.ValueOr(kDefaultBatchConcurrency), mDestinationIds.size());
+    for (size_t i = 0; i < concurrency; i++)
+    {
+        mBatchSlots.push_back(std::make_unique<BatchSlot>(this));
+    }
+
+    ChipLogProgress(chipTool, "Sending command to %u destinations, connecting to up to %u at once",
+                    static_cast<unsigned>(mDestinationIds.size()), static_cast<unsigned>(concurrency));
+
+    mBatchActive = true;
+    StartBatchConnections();
+    return CHIP_NO_ERROR;
+}
+
+void ModelCommand::StartBatchConnections()
+{
+    // Connection failures may be reported synchronously and free a slot; the loop below picks it up.
+    VerifyOrReturn(!mBatchStartingConnections);
+    mBatchStartingConnections = true;
+
+    while (mBatchActive && mBatchNextDestination < mDestinationIds.size())
+    {
+        auto iter = std::find_if(mBatchSlots.begin(), mBatchSlots.end(), [](const auto & slot) { return !slot->inUse; });
+        if (iter == mBatchSlots.end())
+        {
+            break;
+        }
+
+        BatchSlot & slot = **iter;
+        slot.inUse       = true;
+        slot.index       = mBatchNextDestination++;
+        StartBatchConnection(slot);
+    }
+
+    mBatchStartingConnections = false;
+}
+
+void ModelCommand::StartBatchConnection(BatchSlot & slot)
+{
+    const NodeId destinationId = mDestinationIds[slot.index];
+    slot.connectStartTime      = System::SystemClock().GetMonotonicTimestamp();
+
+    if (IsGroupId(destinationId))
+    {
+        // Group destinations need no session.
+        slot.connectedTime = slot.connectStartTime;
+        mBatchReadySlots.push_back(&slot);
+        RunReadyBatchDestinations();
+        return;
+    }
+
+    CHIP_ERROR err = CurrentCommissioner().GetConnectedDevice(destinationId, &slot.onConnected, &slot.onFailure);
+    if (err != CHIP_NO_ERROR)
+    {
+        OnBatchDestinationDone(slot, err);
+    }
+}
+
+void ModelCommand::OnBatchDeviceConnectedFn(void * context, chip::Messaging::ExchangeManager & exchangeMgr,
+                                            const chip::SessionHandle & sessionHandle)
+{
+    BatchSlot * slot = reinterpret_cast<BatchSlot *>(context);
+    VerifyOrReturn(slot != nullptr, ChipLogError(chipTool, "OnBatchDeviceConnectedFn: context is null"));
+
+    slot->exchangeMgr   = &exchangeMgr;
+    slot->connectedTime = System::SystemClock().GetMonotonicTimestamp();
+    slot->session.Grab(sessionHandle);
+    slot->command->mBatchReadySlots.push_back(slot);
+    slot->command->RunReadyBatchDestinations();
+}
+
+void ModelCommand::OnBatchDeviceConnectionFailureFn(void * context, const chip::ScopedNodeId & peerId, CHIP_ERROR err)
+{
+    BatchSlot * slot = reinterpret_cast<BatchSlot *>(context);
+    VerifyOrReturn(slot != nullptr, ChipLogError(chipTool, "OnBatchDeviceConnectionFailureFn: context is null"));
+
+    ChipLogError(chipTool, "Failed to connect to node 0x%" PRIx64 ": %" CHIP_ERROR_FORMAT, peerId.GetNodeId(), err.Format());
+    slot->command->OnBatchDestinationDone(*slot, err);
+}
+
+void ModelCommand::RunReadyBatchDestinations()
+{
+    // The command is sent from a separate task so that it is never re-entered from the callbacks of
+    // an interaction that just completed.
+    VerifyOrReturn(mBatchActive && !mBatchReadySlots.empty() && !mBatchRunScheduled);
+    mBatchRunScheduled = true;
+    DeviceLayer::PlatformMgr().ScheduleWork(RunReadyBatchDestinationsFn, reinterpret_cast<intptr_t>(this));
+}
+
+void ModelCommand::RunReadyBatchDestinationsFn(intptr_t context)
+{
+    ModelCommand * command      = reinterpret_cast<ModelCommand *>(context);
+    command->mBatchRunScheduled = false;
+
+    // There are no more ready destinations than slots, so no more interactions in flight than the
+    // batch concurrency.
+    while (command->mBatchActive && !command->mBatchReadySlots.empty())
+    {
+        BatchSlot & slot = *command->mBatchReadySlots.front();
+        command->mBatchReadySlots.pop_front();
+        command->StartBatchCommand(slot);
+    }
+}
+
+void ModelCommand::StartBatchCommand(BatchSlot & slot)
+{
+    const NodeId destinationId = mDestinationIds[slot.index];
+    if (!IsGroupId(destinationId) && !slot.session)
+    {
+        // The session was released before the command could be sent: look it up again.
+        StartBatchConnection(slot);
+        return;
+    }
+
+    slot.running          = true;
+    slot.interaction      = nullptr;
+    slot.error            = CHIP_NO_ERROR;
+    slot.commandStartTime = System::SystemClock().GetMonotonicTimestamp();
+
+    // Interactions that complete before the command is sent, such as group ones, report to the
+    // destination being started.
+    CHIP_ERROR err     = CHIP_NO_ERROR;
+    mBatchStartingSlot = &slot;
+    if (IsGroupId(destinationId))
+    {
+        err = SendGroupCommand(GroupIdFromNodeId(destinationId), CurrentCommissioner().GetFabricIndex());
+    }
+    else
+    {
+        chip::OperationalDeviceProxy device(slot.exchangeMgr, slot.session.Get().Value());
+        err = SendCommand(&device, mEndPointId);
+    }
+    mBatchStartingSlot = nullptr;
+
+    // The destination may be done already, and its slot reused for the next one, which is not
+    // running yet.
+    VerifyOrReturn(slot.running);
+
+    if (err != CHIP_NO_ERROR)
+    {
+        OnBatchDestinationDone(slot, err);
+        return;
+    }
+
+    slot.interaction = GetLastStartedInteraction();
+}
+
+ModelCommand::BatchSlot * ModelCommand::FindBatchSlot(const void * interaction)
+{
+    if (interaction != nullptr)
+    {
+        auto iter = std::find_if(mBatchSlots.begin(), mBatchSlots.end(),
+                                 [interaction](const auto & slot) { return slot->running && slot->interaction == interaction; });
+        if (iter != mBatchSlots.end())
+        {
+            return iter->get();
+        }
+    }
+
+    return mBatchStartingSlot;
+}
+
+void ModelCommand::OnBatchDestinationDone(BatchSlot & slot, CHIP_ERROR status)
+{
+    WriteBatchResult(slot, status);
+
+    if (status != CHIP_NO_ERROR && mBatchStatus == CHIP_NO_ERROR)
+    {
+        mBatchStatus = status;
+    }
+
+    slot.session.Release();
+    slot.exchangeMgr      = nullptr;
+    slot.connectedTime    = System::Clock::kZero;
+    slot.commandStartTime = System::Clock::kZero;
+    slot.running          = false;
+    slot.interaction      = nullptr;
+    slot.inUse            = false;
+
+    if (++mBatchDoneCount == mDestinationIds.size())
+    {
+        ChipLogProgress(chipTool, "Batch done: %" CHIP_ERROR_FORMAT, mBatchStatus.Format());
+        mBatchActive = false;
+        SetCommandExitStatus(mBatchStatus);
+        return;
+    }
+
+    StartBatchConnections();
+}
+
+void ModelCommand::WriteBatchResult(const BatchSlot & slot, CHIP_ERROR status)
+{
+    const System::Clock::Timestamp now            = System::SystemClock().GetMonotonicTimestamp();
+    const System::Clock::Timestamp connectEndTime = (slot.connectedTime != System::Clock::kZero) ? slot.connectedTime : now;
+    const System::Clock::Timestamp commandStartTime =
+        (slot.commandStartTime != System::Clock::kZero) ? slot.commandStartTime : now;
+
+    // Time spent looking up (or establishing) the session, waiting for the command to be sent, and
+    // running the command.
+    const uint64_t connectMs = (connectEndTime - slot.connectStartTime).count();
+    const uint64_t waitMs    = (commandStartTime - connectEndTime).count();
+    const uint64_t commandMs = (now - commandStartTime).count();
+
+    const NodeId destinationId = mDestinationIds[slot.index];
+    fprintf(mBatchResultsStream,
+            "{\"destination\":\"0x%016" PRIX64 "\",\"group\":%s,\"status\":\"%s\",\"error\":\"0x%08" PRIX32
+            "\",\"connectMs\":%" PRIu64 ",\"waitMs\":%" PRIu64 ",\"commandMs\":%" PRIu64 "}\n",
+            destinationId, IsGroupId(destinationId) ? "true" : "false", status == CHIP_NO_ERROR ? "success" : "failure",
+            status.AsInteger(), connectMs, waitMs, commandMs);
+    fflush(mBatchResultsStream);
+}
+
+void ModelCommand::ResetBatch()
+{
+    for (auto & slot : mBatchSlots)
+    {
+        slot->onConnected.Cancel();
+        slot->onFailure.Cancel();
+    }
+    mBatchSlots.clear();
+    mBatchReadySlots.clear();
+    mBatchStartingSlot    = nullptr;
+    mBatchActive          = false;
+    mBatchRunScheduled    = false;
+    mBatchNextDestination = 0;
+    mBatchDoneCount       = 0;
+    mBatchStatus          = CHIP_NO_ERROR;
+
+    if (mBatchResultsStream != nullptr && mBatchResultsStream != stdout)
+    {
+        fclose(mBatchResultsStream);
+    }
+    mBatchResultsStream = nullptr;
+}
+
 void ModelCommand::Shutdown()
 {
     mOnDeviceConnectedCallback.Cancel();
     mOnDeviceConnectionFailureCallback.Cancel();
+    ResetBatch();
+    mError = CHIP_NO_ERROR;
 
     CHIPCommand::Shutdown();
 }
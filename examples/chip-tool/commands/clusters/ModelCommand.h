@@ -25,6 +25,9 @@
 #include "../common/CHIPCommand.h"
 #include <lib/core/CHIPEncoding.h>
 
+#include <deque>
+#include <memory>
+
 class ModelCommand : public CHIPCommand
 {
 public:
@@ -35,9 +38,10 @@ public:
 
     void AddArguments()
     {
-        AddArgument(
-            "destination-id", 0, UINT64_MAX, &mDestinationId,
-            "64-bit node or group identifier.\n  Group identifiers are detected by being in the 0xFFFF'FFFF'FFFF'xxxx range.");
+        AddArgument("destination-id", 0, UINT64_MAX, &mDestinationIds,
+                    "64-bit node or group identifier.\n  Group identifiers are detected by being in the 0xFFFF'FFFF'FFFF'xxxx "
+                    "range.\n  A comma-separated list of identifiers (e.g. \"0x1,0x2,0x3\") runs the command against each of them "
+                    "in batch mode.");
         if (mSupportsMultipleEndpoints)
         {
             AddArgument("endpoint-ids", 0, UINT16_MAX, &mEndPointId,
@@ -50,11 +54,16 @@ public:
                         "Endpoint the command is targeted at.");
         }
         AddArgument("timeout", 0, UINT16_MAX, &mTimeout);
+        AddArgument("batch-concurrency", 1, UINT16_MAX, &mBatchConcurrency,
+                    "In batch mode, the maximum number of destinations the command is sent to at once.  Defaults to 8.");
+        AddArgument("batch-results-file", &mBatchResultsFile,
+                    "In batch mode, the file the result of each destination is appended to, as a JSON line.  Defaults to stdout.");
     }
 
     /////////// CHIPCommand Interface /////////
     CHIP_ERROR RunCommand() override;
     chip::System::Clock::Timeout GetWaitDuration() const override { return chip::System::Clock::Seconds16(mTimeout.ValueOr(20)); }
+    chip::System::Clock::Timeout GetInvocationWaitDuration() const override;
 
     virtual CHIP_ERROR SendCommand(chip::DeviceProxy * device, std::vector<chip::EndpointId> endPointIds) = 0;
 
@@ -63,11 +72,68 @@ public:
     void Shutdown() override;
 
 protected:
+    // Whether the command can be run against several destinations in batch mode, which sends it
+    // to up to --batch-concurrency destinations at once.
+    virtual bool SupportsBatch() const { return true; }
+
+    // Get the interaction started by the last successful SendCommand call.  In batch mode, it ties
+    // the errors and the completion reported for the interaction to its destination.
+    virtual const void * GetLastStartedInteraction() const { return nullptr; }
+
+    // Record an error met by an interaction started by SendCommand or SendGroupCommand.  The last
+    // error recorded is the result of the command or, in batch mode, of the destination the
+    // interaction was sent to.
+    void SetInteractionError(const void * interaction, CHIP_ERROR error);
+
+    // Report that an interaction started by SendCommand or SendGroupCommand is done.
+    void SetInteractionDone(const void * interaction);
+
+    bool IsBatchActive() const { return mBatchActive; }
+
     chip::Optional<uint16_t> mTimeout;
 
 private:
-    chip::NodeId mDestinationId;
+    // A destination of a batch, from the time a session is looked up for it until the command
+    // sent to it is done.
+    struct BatchSlot
+    {
+        BatchSlot(ModelCommand * command);
+
+        ModelCommand * const command;
+        size_t index                                   = 0; // into mDestinationIds
+        bool inUse                                     = false;
+        bool running                                   = false; // the command was sent to the destination
+        const void * interaction                       = nullptr;
+        CHIP_ERROR error                               = CHIP_NO_ERROR;
+        chip::Messaging::ExchangeManager * exchangeMgr = nullptr;
+        chip::SessionHolder session;
+        chip::System::Clock::Timestamp connectStartTime = chip::System::Clock::kZero;
+        chip::System::Clock::Timestamp connectedTime    = chip::System::Clock::kZero;
+        chip::System::Clock::Timestamp commandStartTime = chip::System::Clock::kZero;
+
+        chip::Callback::Callback<chip::OnDeviceConnected> onConnected;
+        chip::Callback::Callback<chip::OnDeviceConnectionFailure> onFailure;
+    };
+
+    CHIP_ERROR RunBatch();
+    void StartBatchConnections();
+    void StartBatchConnection(BatchSlot & slot);
+    void RunReadyBatchDestinations();
+    void StartBatchCommand(BatchSlot & slot);
+    BatchSlot * FindBatchSlot(const void * interaction);
+    void OnBatchDestinationDone(BatchSlot & slot, CHIP_ERROR status);
+    void WriteBatchResult(const BatchSlot & slot, CHIP_ERROR status);
+    void ResetBatch();
+
+    static void OnBatchDeviceConnectedFn(void * context, chip::Messaging::ExchangeManager & exchangeMgr,
+                                         const chip::SessionHandle & sessionHandle);
+    static void OnBatchDeviceConnectionFailureFn(void * context, const chip::ScopedNodeId & peerId, CHIP_ERROR error);
+    static void RunReadyBatchDestinationsFn(intptr_t context);
+
+    std::vector<chip::NodeId> mDestinationIds;
     std::vector<chip::EndpointId> mEndPointId;
+    chip::Optional<uint16_t> mBatchConcurrency;
+    chip::Optional<char *> mBatchResultsFile;
 
     static void OnDeviceConnectedFn(void * context, chip::Messaging::ExchangeManager & exchangeMgr,
                                     const chip::SessionHandle & sessionHandle);
@@ -76,4 +142,17 @@ private:
     chip::Callback::Callback<chip::OnDeviceConnected> mOnDeviceConnectedCallback;
     chip::Callback::Callback<chip::OnDeviceConnectionFailure> mOnDeviceConnectionFailureCallback;
     const bool mSupportsMultipleEndpoints;
+    CHIP_ERROR mError = CHIP_NO_ERROR; // last error met by the interactions, outside of batch mode
+
+    // Batch mode state.
+    bool mBatchActive              = false;
+    bool mBatchStartingConnections = false;
+    bool mBatchRunScheduled        = false;
+    size_t mBatchNextDestination   = 0; // next destination to look up a session for
+    size_t mBatchDoneCount         = 0;
+    CHIP_ERROR mBatchStatus        = CHIP_NO_ERROR; // first failure of the batch
+    FILE * mBatchResultsStream     = nullptr;
+    std::vector<std::unique_ptr<BatchSlot>> mBatchSlots;
+    std::deque<BatchSlot *> mBatchReadySlots; // destinations waiting for the command to be sent to them
+    BatchSlot * mBatchStartingSlot = nullptr; // destination the command is being sent to
 };
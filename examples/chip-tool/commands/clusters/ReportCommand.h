@@ -33,19 +33,50 @@ public:
     /////////// ReadClient Callback Interface /////////
     void OnAttributeData(const chip::app::ConcreteDataAttributePath & path, chip::TLV::TLVReader * data,
                          const chip::app::StatusIB & status) override
+    {
+        OnAttributeData(this, path, data, status);
+    }
+
+    void OnEventData(const chip::app::EventHeader & eventHeader, chip::TLV::TLVReader * data,
+                     const chip::app::StatusIB * status) override
+    {
+        OnEventData(this, eventHeader, data, status);
+    }
+
+    void OnError(CHIP_ERROR error) override { OnError(this, error); }
+
+    void OnDeallocatePaths(chip::app::ReadPrepareParams && aReadPrepareParams) override
+    {
+        InteractionModelReports::OnDeallocatePaths(std::move(aReadPrepareParams));
+    }
+
+    void Shutdown() override
+    {
+        // We don't shut down InteractionModelReports here; we leave it for
+        // Cleanup to handle.
+        ModelCommand::Shutdown();
+    }
+
+    void Cleanup() override { InteractionModelReports::Shutdown(); }
+
+protected:
+    // Handle the data and errors received by an interaction, which is either this command or, in
+    // batch mode, the callback of the destination the interaction was sent to.
+    void OnAttributeData(const void * interaction, const chip::app::ConcreteDataAttributePath & path, chip::TLV::TLVReader * data,
+                         const chip::app::StatusIB & status)
     {
         CHIP_ERROR error = status.ToChipError();
         if (CHIP_NO_ERROR != error)
         {
             ChipLogError(chipTool, "Response Failure: %s", chip::ErrorStr(error));
-            mError = error;
+            SetInteractionError(interaction, error);
             return;
         }
 
         if (data == nullptr)
         {
             ChipLogError(chipTool, "Response Failure: No Data");
-            mError = CHIP_ERROR_INTERNAL;
+            SetInteractionError(interaction, CHIP_ERROR_INTERNAL);
             return;
         }
 
@@ -53,13 +84,13 @@ public:
         if (CHIP_NO_ERROR != error)
         {
             ChipLogError(chipTool, "Response Failure: Can not decode Data");
-            mError = error;
+            SetInteractionError(interaction, error);
             return;
         }
     }
 
-    void OnEventData(const chip::app::EventHeader & eventHeader, chip::TLV::TLVReader * data,
-                     const chip::app::StatusIB * status) override
+    void OnEventData(const void * interaction, const chip::app::EventHeader & eventHeader, chip::TLV::TLVReader * data,
+                     const chip::app::StatusIB * status)
     {
         if (status != nullptr)
         {
@@ -67,7 +98,7 @@ public:
             if (CHIP_NO_ERROR != error)
             {
                 ChipLogError(chipTool, "Response Failure: %s", chip::ErrorStr(error));
-                mError = error;
+                SetInteractionError(interaction, error);
                 return;
             }
         }
@@ -75,7 +106,7 @@ public:
         if (data == nullptr)
         {
             ChipLogError(chipTool, "Response Failure: No Data");
-            mError = CHIP_ERROR_INTERNAL;
+            SetInteractionError(interaction, CHIP_ERROR_INTERNAL);
             return;
         }
 
@@ -83,55 +114,102 @@ public:
         if (CHIP_NO_ERROR != error)
         {
             ChipLogError(chipTool, "Response Failure: Can not decode Data");
-            mError = error;
+            SetInteractionError(interaction, error);
             return;
         }
     }
 
-    void OnError(CHIP_ERROR error) override
+    void OnError(const void * interaction, CHIP_ERROR error)
     {
         ChipLogProgress(chipTool, "Error: %s", chip::ErrorStr(error));
-        mError = error;
+        SetInteractionError(interaction, error);
     }
 
-    void OnDeallocatePaths(chip::app::ReadPrepareParams && aReadPrepareParams) override
-    {
-        InteractionModelReports::OnDeallocatePaths(std::move(aReadPrepareParams));
-    }
-
-    void Shutdown() override
-    {
-        // We don't shut down InteractionModelReports here; we leave it for
-        // Cleanup to handle.
-        mError = CHIP_NO_ERROR;
-        ModelCommand::Shutdown();
-    }
-
-    void Cleanup() override { InteractionModelReports::Shutdown(); }
-
-protected:
     // Use a 3x-longer-than-default timeout because wildcard reads can take a
     // while.
     chip::System::Clock::Timeout GetWaitDuration() const override
     {
         return mTimeout.HasValue() ? chip::System::Clock::Seconds16(mTimeout.Value()) : (ModelCommand::GetWaitDuration() * 3);
     }
-
-    CHIP_ERROR mError = CHIP_NO_ERROR;
 };
 
 class ReadCommand : public ReportCommand
 {
+public:
+    void Cleanup() override
+    {
+        ReportCommand::Cleanup();
+        mDestinationCallbacks.clear();
+    }
+
 protected:
     ReadCommand(const char * commandName, CredentialIssuerCommands * credsIssuerConfig) :
         ReportCommand(commandName, credsIssuerConfig)
     {}
 
-    void OnDone(chip::app::ReadClient * aReadClient) override
+    void OnDone(chip::app::ReadClient * aReadClient) override { OnDone(this, aReadClient); }
+
+    // In batch mode, the read sent to each destination reports to its own callback: BufferedReadCallback
+    // keeps the state of the report being received, and the callback ties the data and errors received
+    // to the destination.
+    class DestinationCallback : public chip::app::ReadClient::Callback
+    {
+    public:
+        DestinationCallback(ReadCommand & command) : mCommand(command), mBufferedReadAdapter(*this) {}
+
+        chip::app::BufferedReadCallback & GetBufferedCallback() { return mBufferedReadAdapter; }
+
+        void OnAttributeData(const chip::app::ConcreteDataAttributePath & path, chip::TLV::TLVReader * data,
+                             const chip::app::StatusIB & status) override
+        {
+            mCommand.OnAttributeData(this, path, data, status);
+        }
+
+        void OnEventData(const chip::app::EventHeader & eventHeader, chip::TLV::TLVReader * data,
+                         const chip::app::StatusIB * status) override
+        {
+            mCommand.OnEventData(this, eventHeader, data, status);
+        }
+
+        void OnError(CHIP_ERROR error) override { mCommand.OnError(this, error); }
+
+        void OnDone(chip::app::ReadClient * aReadClient) override { mCommand.OnDone(this, aReadClient); }
+
+        void OnDeallocatePaths(chip::app::ReadPrepareParams && aReadPrepareParams) override
+        {
+            mCommand.OnDeallocatePaths(std::move(aReadPrepareParams));
+        }
+
+    private:
+        ReadCommand & mCommand;
+        chip::app::BufferedReadCallback mBufferedReadAdapter;
+    };
+
+    chip::app::ReadClient::Callback & GetReadClientCallback() override
+    {
+        VerifyOrReturnValue(IsBatchActive(), ReportCommand::GetReadClientCallback());
+        mDestinationCallbacks.push_back(std::make_unique<DestinationCallback>(*this));
+        return mDestinationCallbacks.back()->GetBufferedCallback();
+    }
+
+    const void * GetLastStartedInteraction() const override
+    {
+        return mDestinationCallbacks.empty() ? nullptr : mDestinationCallbacks.back().get();
+    }
+
+private:
+    void OnDone(const void * interaction, chip::app::ReadClient * aReadClient)
     {
         InteractionModelReports::CleanupReadClient(aReadClient);
-        SetCommandExitStatus(mError);
+        SetInteractionDone(interaction);
+
+        // OnDone is the last call a destination callback forwards, so it can go now.
+        mDestinationCallbacks.erase(std::remove_if(mDestinationCallbacks.begin(), mDestinationCallbacks.end(),
+                                                   [interaction](auto & item) { return item.get() == interaction; }),
+                                    mDestinationCallbacks.end());
     }
+
+    std::vector<std::unique_ptr<DestinationCallback>> mDestinationCallbacks;
 };
 
 class SubscribeCommand : public ReportCommand
@@ -153,7 +231,7 @@ protected:
 
         if (!mSubscriptionEstablished)
         {
-            SetCommandExitStatus(mError);
+            SetInteractionDone(this);
         }
         // else we must be getting here from Cleanup(), which means we have
         // already done our exit status thing.
@@ -165,6 +243,10 @@ protected:
         ReportCommand::Shutdown();
     }
 
+    // Subscriptions stay alive past the point where the command is done, so the end of a
+    // subscription could not be told apart from a failure of the next destination.
+    bool SupportsBatch() const override { return false; }
+
     // For subscriptions we always defer interactive cleanup.  Either our
     // ReadClients will terminate themselves (in which case they will be removed
     // from our list anyway), or they should hang around until shutdown.
@@ -429,12 +511,6 @@ public:
 
     ~ReadAll() {}
 
-    void OnDone(chip::app::ReadClient * aReadClient) override
-    {
-        InteractionModelReports::CleanupReadClient(aReadClient);
-        SetCommandExitStatus(mError);
-    }
-
     CHIP_ERROR SendCommand(chip::DeviceProxy * device, std::vector<chip::EndpointId> endpointIds) override
     {
         return ReadCommand::ReadAll(device, endpointIds, mClusterIds, mAttributeIds, mEventIds);
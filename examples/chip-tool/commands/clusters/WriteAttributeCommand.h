@@ -110,20 +110,20 @@ public:
         if (CHIP_NO_ERROR != error)
         {
             ChipLogError(chipTool, "Response Failure: %s", chip::ErrorStr(error));
-            mError = error;
+            SetInteractionError(client, error);
         }
     }
 
     void OnError(const chip::app::WriteClient * client, CHIP_ERROR error) override
     {
         ChipLogProgress(chipTool, "Error: %s", chip::ErrorStr(error));
-        mError = error;
+        SetInteractionError(client, error);
     }
 
     void OnDone(chip::app::WriteClient * client) override
     {
-        InteractionModelWriter::Shutdown();
-        SetCommandExitStatus(mError);
+        InteractionModelWriter::CleanupWriteClient(client);
+        SetInteractionDone(client);
     }
 
     CHIP_ERROR SendCommand(chip::DeviceProxy * device, std::vector<chip::EndpointId> endpointIds,
@@ -147,13 +147,14 @@ public:
                                                            dataVersion);
     }
 
-    void Shutdown() override
+protected:
+    // Repeated writes would all be tied to the destination of the first one.
+    bool SupportsBatch() const override { return !mRepeatCount.HasValue(); }
+    const void * GetLastStartedInteraction() const override
     {
-        mError = CHIP_NO_ERROR;
-        ModelCommand::Shutdown();
+        return mWrites.empty() ? nullptr : mWrites.back()->writeClient.get();
     }
 
-protected:
     WriteAttribute(const char * attributeName, CredentialIssuerCommands * credsIssuerConfig) :
         InteractionModelWriter(this), ModelCommand("write", credsIssuerConfig)
     {
@@ -248,7 +249,6 @@ private:
     std::vector<chip::ClusterId> mClusterIds;
     std::vector<chip::AttributeId> mAttributeIds;
 
-    CHIP_ERROR mError = CHIP_NO_ERROR;
     T mAttributeValues;
 };
 
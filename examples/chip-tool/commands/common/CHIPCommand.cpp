@@ -215,7 +215,7 @@ CHIP_ERROR CHIPCommand::Run()
 {
     ReturnErrorOnFailure(MaybeSetUpStack());
 
-    CHIP_ERROR err = StartWaiting(GetWaitDuration());
+    CHIP_ERROR err = StartWaiting(GetInvocationWaitDuration());
 
     bool deferCleanup = (IsInteractive() && DeferInteractiveCleanup());
 
@@ -108,6 +108,10 @@ protected:
     // Get the wait duration, in seconds, before the command times out.
     virtual chip::System::Clock::Timeout GetWaitDuration() const = 0;
 
+    // Get the wait duration before the whole invocation times out, for commands that run
+    // several times per invocation.
+    virtual chip::System::Clock::Timeout GetInvocationWaitDuration() const { return GetWaitDuration(); }
+
     // Shut down the command.  After a Shutdown call the command object is ready
     // to be used for another command invocation.
     virtual void Shutdown() { ResetArguments(); }
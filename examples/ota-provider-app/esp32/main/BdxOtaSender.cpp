@@ -54,6 +54,14 @@ CHIP_ERROR BdxOtaSender::InitializeTransfer(chip::FabricIndex fabricIndex, chip:
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR BdxOtaSender::InitializeTransfer(chip::FabricIndex fabricIndex, chip::NodeId nodeId, chip::System::Layer * layer,
+                                            chip::BitFlags<TransferControlFlags> xferControlOpts, uint16_t maxBlockSize,
+                                            chip::System::Clock::Timeout timeout, chip::System::Clock::Timeout pollFreq)
+{
+    ReturnErrorOnFailure(InitializeTransfer(fabricIndex, nodeId));
+    return PrepareForTransfer(layer, chip::bdx::TransferRole::kSender, xferControlOpts, maxBlockSize, timeout, pollFreq);
+}
+
 void BdxOtaSender::SetCallbacks(BdxOtaSenderCallbacks callbacks)
 {
     mOnBlockQueryCallback       = callbacks.onBlockQuery;
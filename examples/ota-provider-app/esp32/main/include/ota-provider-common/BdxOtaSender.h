@@ -76,6 +76,11 @@ public:
     // Initializes BDX transfer-related metadata. Should always be called first.
     CHIP_ERROR InitializeTransfer(chip::FabricIndex fabricIndex, chip::NodeId nodeId);
 
+    // Initializes BDX transfer-related metadata and prepares the transfer session to receive a transfer request.
+    CHIP_ERROR InitializeTransfer(chip::FabricIndex fabricIndex, chip::NodeId nodeId, chip::System::Layer * layer,
+                                  chip::BitFlags<chip::bdx::TransferControlFlags> xferControlOpts, uint16_t maxBlockSize,
+                                  chip::System::Clock::Timeout timeout, chip::System::Clock::Timeout pollFreq);
+
     void SetCallbacks(BdxOtaSenderCallbacks callbacks);
 
     /**
@@ -55,6 +55,8 @@ constexpr uint16_t kOptionUserConsentState          = 'u';
 constexpr uint16_t kOptionIgnoreQueryImage          = 'x';
 constexpr uint16_t kOptionIgnoreApplyUpdate         = 'y';
 constexpr uint16_t kOptionPollInterval              = 'P';
+constexpr uint16_t kOptionMaxConcurrentTransfers    = 'T';
+constexpr uint16_t kOptionMaxBlocksPerPoll          = 'B';
 
 OTAProviderExample gOtaProvider;
 chip::ota::DefaultOTAProviderUserConsent gUserConsentProvider;
@@ -72,6 +74,8 @@ static bool gUserConsentNeeded                       = false;
 static uint32_t gIgnoreQueryImageCount               = 0;
 static uint32_t gIgnoreApplyUpdateCount              = 0;
 static uint32_t gPollInterval                        = 0;
+static uint16_t gMaxConcurrentTransfers              = 0;
+static uint16_t gMaxBlocksPerPoll                    = 0;
 
 // Parses the JSON filepath and extracts DeviceSoftwareVersionModel parameters
 static bool ParseJsonFileAndPopulateCandidates(const char * filepath,
@@ -245,6 +249,12 @@ bool HandleOptions(const char * aProgram, OptionSet * aOptions, int aIdentifier,
     case kOptionPollInterval:
         gPollInterval = static_cast<uint32_t>(strtoul(aValue, NULL, 0));
         break;
+    case kOptionMaxConcurrentTransfers:
+        gMaxConcurrentTransfers = static_cast<uint16_t>(strtoul(aValue, NULL, 0));
+        break;
+    case kOptionMaxBlocksPerPoll:
+        gMaxBlocksPerPoll = static_cast<uint16_t>(strtoul(aValue, NULL, 0));
+        break;
 
     default:
         PrintArgError("%s: INTERNAL ERROR: Unhandled option: %s\n", aProgram, aName);
@@ -268,6 +278,8 @@ OptionDef cmdLineOptionsDef[] = {
     { "ignoreQueryImage", chip::ArgParser::kArgumentRequired, kOptionIgnoreQueryImage },
     { "ignoreApplyUpdate", chip::ArgParser::kArgumentRequired, kOptionIgnoreApplyUpdate },
     { "pollInterval", chip::ArgParser::kArgumentRequired, kOptionPollInterval },
+    { "maxConcurrentTransfers", chip::ArgParser::kArgumentRequired, kOptionMaxConcurrentTransfers },
+    { "maxBlocksPerPoll", chip::ArgParser::kArgumentRequired, kOptionMaxBlocksPerPoll },
     {},
 };
 
@@ -308,7 +320,13 @@ OptionSet cmdLineOptions = { HandleOptions, cmdLineOptionsDef, "PROGRAM OPTIONS"
                              "  -y, --ignoreApplyUpdate <ignore count>\n"
                              "        The number of times to ignore the ApplyUpdateRequest Command and not send a response.\n"
                              "  -P, --pollInterval <time in milliseconds>\n"
-                             "        Poll interval for the BDX transfer \n" };
+                             "        Poll interval for the BDX transfer \n"
+                             "  -T, --maxConcurrentTransfers <count>\n"
+                             "        Number of BDX transfers that can be in progress at the same time (default and maximum: 16).\n"
+                             "        Further requestors get a QueryImageResponse with the Busy status.\n"
+                             "  -B, --maxBlocksPerPoll <count>\n"
+                             "        Number of blocks served across all BDX transfers on each poll, shared fairly between\n"
+                             "        the transfers. Defaults to 0, no limit.\n" };
 
 OptionSet * allOptions[] = { &cmdLineOptions, nullptr };
 
@@ -361,6 +379,12 @@ void ApplicationInit()
         gOtaProvider.SetPollInterval(gPollInterval);
     }
 
+    if (gMaxConcurrentTransfers != 0)
+    {
+        bdxOtaSender->SetMaxConcurrentTransfers(gMaxConcurrentTransfers);
+    }
+    bdxOtaSender->SetMaxBlocksPerPoll(gMaxBlocksPerPoll);
+
     ChipLogDetail(SoftwareUpdate, "Using ImageList file: %s", gOtaImageListFilepath ? gOtaImageListFilepath : "(none)");
 
     if (gOtaImageListFilepath != nullptr)
@@ -19,12 +19,14 @@
 
 #include <lib/core/CHIPError.h>
 #include <lib/support/BitFlags.h>
-#include <lib/support/CHIPMemString.h>
+#include <lib/support/CodeUtils.h>
 #include <messaging/ExchangeContext.h>
 #include <messaging/Flags.h>
 #include <protocols/bdx/BdxTransferSession.h>
+#include <system/SystemClock.h>
 
-#include <fstream>
+#include <algorithm>
+#include <string.h>
 
 using chip::bdx::StatusCode;
 using chip::bdx::TransferControlFlags;
@@ -32,36 +34,222 @@ using chip::bdx::TransferSession;
 
 BdxOtaSender::BdxOtaSender()
 {
-    memset(mFileDesignator, 0, chip::bdx::kMaxFileDesignatorLen);
+    for (Transfer & transfer : mTransfers)
+    {
+        transfer.Init(this);
+    }
 }
 
-CHIP_ERROR BdxOtaSender::InitializeTransfer(chip::FabricIndex fabricIndex, chip::NodeId nodeId)
+CHIP_ERROR BdxOtaSender::InitializeTransfer(chip::FabricIndex fabricIndex, chip::NodeId nodeId, chip::System::Layer * layer,
+                                            chip::BitFlags<TransferControlFlags> xferControlOpts, uint16_t maxBlockSize,
+                                            chip::System::Clock::Timeout timeout, chip::System::Clock::Timeout pollFreq)
 {
-    if (mInitialized)
+    VerifyOrReturnError(layer != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    // Reset stale connection from the Same Node if exists
+    Transfer * transfer = FindTransfer(fabricIndex, nodeId);
+    if (transfer != nullptr)
+    {
+        transfer->Reset();
+    }
+
+    if (GetActiveTransferCount() >= mMaxConcurrentTransfers)
+    {
+        return CHIP_ERROR_BUSY;
+    }
+
+    for (Transfer & candidate : mTransfers)
     {
-        // Reset stale connection from the Same Node if exists
-        if ((mFabricIndex.HasValue() && mFabricIndex.Value() == fabricIndex) && (mNodeId.HasValue() && mNodeId.Value() == nodeId))
+        if (!candidate.IsInUse())
         {
-            Reset();
+            transfer = &candidate;
+            break;
         }
-        // Prevent a new node connection since another is active
-        else if ((mFabricIndex.HasValue() && mFabricIndex.Value() != fabricIndex) ||
-                 (mNodeId.HasValue() && mNodeId.Value() != nodeId))
+    }
+    VerifyOrReturnError(transfer != nullptr, CHIP_ERROR_BUSY);
+
+    ReturnErrorOnFailure(transfer->Prepare(fabricIndex, nodeId, xferControlOpts, maxBlockSize, timeout));
+
+    mSystemLayer = layer;
+    mPollFreq    = pollFreq;
+    if (!mPolling)
+    {
+        mPolling = true;
+        mSystemLayer->StartTimer(mPollFreq, PollTimerHandler, this);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+void BdxOtaSender::SetMaxConcurrentTransfers(uint16_t count)
+{
+    mMaxConcurrentTransfers = std::min(std::max(count, static_cast<uint16_t>(1)), kMaxConcurrentTransfers);
+}
+
+uint16_t BdxOtaSender::GetActiveTransferCount() const
+{
+    uint16_t count = 0;
+    for (const Transfer & transfer : mTransfers)
+    {
+        if (transfer.IsInUse())
         {
-            return CHIP_ERROR_BUSY;
+            count++;
         }
-        else
+    }
+    return count;
+}
+
+CHIP_ERROR BdxOtaSender::OnUnsolicitedMessageReceived(const chip::PayloadHeader & payloadHeader,
+                                                      chip::Messaging::ExchangeDelegate *& newDelegate)
+{
+    // The peer is only known once the exchange exists, see OnMessageReceived.
+    newDelegate = this;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR BdxOtaSender::OnMessageReceived(chip::Messaging::ExchangeContext * ec, const chip::PayloadHeader & payloadHeader,
+                                           chip::System::PacketBufferHandle && payload)
+{
+    chip::ScopedNodeId peer = ec->GetSessionHandle()->GetPeer();
+    Transfer * transfer     = FindTransfer(peer.GetFabricIndex(), peer.GetNodeId());
+    if (transfer == nullptr || transfer->HasExchange())
+    {
+        ChipLogError(BDX, "No BDX transfer is waiting for node " ChipLogFormatX64, ChipLogValueX64(peer.GetNodeId()));
+        return CHIP_ERROR_INCORRECT_STATE;
+    }
+
+    ec->SetDelegate(transfer);
+    return transfer->OnMessageReceived(ec, payloadHeader, std::move(payload));
+}
+
+BdxOtaSender::Transfer * BdxOtaSender::FindTransfer(chip::FabricIndex fabricIndex, chip::NodeId nodeId)
+{
+    for (Transfer & transfer : mTransfers)
+    {
+        if (transfer.IsFor(fabricIndex, nodeId))
         {
-            return CHIP_ERROR_INTERNAL;
+            return &transfer;
         }
     }
-    mFabricIndex.SetValue(fabricIndex);
-    mNodeId.SetValue(nodeId);
-    mInitialized = true;
+    return nullptr;
+}
+
+void BdxOtaSender::PollTimerHandler(chip::System::Layer * systemLayer, void * appState)
+{
+    VerifyOrReturn(appState != nullptr);
+    static_cast<BdxOtaSender *>(appState)->PollTransfers();
+}
+
+void BdxOtaSender::PollTransfers()
+{
+    chip::System::Clock::Timestamp now = chip::System::SystemClock().GetMonotonicTimestamp();
+    uint16_t blocksServed              = 0;
+    uint16_t start                     = mNextTransferToPoll;
+
+    // Start one transfer further on every poll, or from the first transfer left out by the block budget, so that no transfer is
+    // always served last.
+    mNextTransferToPoll = static_cast<uint16_t>((start + 1) % kMaxConcurrentTransfers);
+    for (uint16_t i = 0; i < kMaxConcurrentTransfers; i++)
+    {
+        uint16_t index      = static_cast<uint16_t>((start + i) % kMaxConcurrentTransfers);
+        Transfer & transfer = mTransfers[index];
+        if (!transfer.IsInUse())
+        {
+            continue;
+        }
+
+        if (mMaxBlocksPerPoll != 0 && blocksServed >= mMaxBlocksPerPoll)
+        {
+            mNextTransferToPoll = index;
+            break;
+        }
+
+        if (transfer.Poll(now))
+        {
+            blocksServed++;
+        }
+    }
+
+    if (GetActiveTransferCount() > 0)
+    {
+        mSystemLayer->StartTimer(mPollFreq, PollTimerHandler, this);
+    }
+    else
+    {
+        mPolling = false;
+    }
+}
+
+CHIP_ERROR BdxOtaSender::Transfer::Prepare(chip::FabricIndex fabricIndex, chip::NodeId nodeId,
+                                           chip::BitFlags<TransferControlFlags> xferControlOpts, uint16_t maxBlockSize,
+                                           chip::System::Clock::Timeout timeout)
+{
+    ReturnErrorOnFailure(mTransfer.WaitForTransfer(chip::bdx::TransferRole::kSender, xferControlOpts, maxBlockSize, timeout));
+
+    mFabricIndex = fabricIndex;
+    mNodeId      = nodeId;
+    mInUse       = true;
+    mReservedAt  = chip::System::SystemClock().GetMonotonicTimestamp();
+    mTimeout     = timeout;
     return CHIP_NO_ERROR;
 }
 
-void BdxOtaSender::HandleTransferSessionOutput(TransferSession::OutputEvent & event)
+bool BdxOtaSender::Transfer::Poll(chip::System::Clock::Timestamp now)
+{
+    if (mExchangeCtx == nullptr && mImage.empty() && now - mReservedAt >= mTimeout)
+    {
+        ChipLogError(BDX, "Node " ChipLogFormatX64 " never started its transfer", ChipLogValueX64(mNodeId));
+        Reset();
+        return false;
+    }
+
+    TransferSession::OutputEvent event;
+    mTransfer.PollOutput(event, now);
+
+    bool isBlockQuery = event.EventType == TransferSession::OutputEventType::kQueryReceived ||
+        event.EventType == TransferSession::OutputEventType::kQueryWithSkipReceived;
+    HandleTransferSessionOutput(event);
+    return isBlockQuery;
+}
+
+CHIP_ERROR BdxOtaSender::Transfer::OnMessageReceived(chip::Messaging::ExchangeContext * ec,
+                                                     const chip::PayloadHeader & payloadHeader,
+                                                     chip::System::PacketBufferHandle && payload)
+{
+    if (mExchangeCtx == nullptr)
+    {
+        mExchangeCtx = ec;
+    }
+
+    CHIP_ERROR err =
+        mTransfer.HandleMessageReceived(payloadHeader, std::move(payload), chip::System::SystemClock().GetMonotonicTimestamp());
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(BDX, "failed to handle message: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+
+    // The response to every message is sent from the next poll, see TransferFacilitator::OnMessageReceived.
+    ec->WillSendMessage();
+
+    return err;
+}
+
+void BdxOtaSender::Transfer::OnResponseTimeout(chip::Messaging::ExchangeContext * ec)
+{
+    ChipLogError(BDX, "%s, ec: " ChipLogFormatExchange, __FUNCTION__, ChipLogValueExchange(ec));
+    mExchangeCtx = nullptr;
+    Reset();
+}
+
+void BdxOtaSender::Transfer::OnExchangeClosing(chip::Messaging::ExchangeContext * ec)
+{
+    if (ec == mExchangeCtx)
+    {
+        mExchangeCtx = nullptr;
+    }
+}
+
+void BdxOtaSender::Transfer::HandleTransferSessionOutput(TransferSession::OutputEvent & event)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
 
@@ -90,8 +278,10 @@ void BdxOtaSender::HandleTransferSessionOutput(TransferSession::OutputEvent & ev
         {
             if (!sendFlags.Has(chip::Messaging::SendMessageFlags::kExpectResponse))
             {
-                // After sending the StatusReport, exchange context gets closed so, set mExchangeCtx to null
+                // After sending the StatusReport, exchange context gets closed so, set mExchangeCtx to null and release the
+                // transfer.
                 mExchangeCtx = nullptr;
+                Reset();
             }
         }
         else
@@ -102,85 +292,19 @@ void BdxOtaSender::HandleTransferSessionOutput(TransferSession::OutputEvent & ev
 
         break;
     }
-    case TransferSession::OutputEventType::kInitReceived: {
-        // TransferSession will automatically reject a transfer if there are no
-        // common supported control modes. It will also default to the smaller
-        // block size.
-        TransferSession::TransferAcceptData acceptData;
-        acceptData.ControlMode  = TransferControlFlags::kReceiverDrive; // OTA must use receiver drive
-        acceptData.MaxBlockSize = mTransfer.GetTransferBlockSize();
-        acceptData.StartOffset  = mTransfer.GetStartOffset();
-        acceptData.Length       = mTransfer.GetTransferLength();
-        VerifyOrReturn(mTransfer.AcceptTransfer(acceptData) == CHIP_NO_ERROR,
-                       ChipLogError(BDX, "AcceptTransfer failed: %" CHIP_ERROR_FORMAT, err.Format()));
-
-        // Store the file designator used during block query
-        uint16_t fdl       = 0;
-        const uint8_t * fd = mTransfer.GetFileDesignator(fdl);
-        VerifyOrReturn(fdl < chip::bdx::kMaxFileDesignatorLen,
-                       ChipLogError(BDX, "Cannot store file designator with length = %d", fdl));
-        memcpy(mFileDesignator, fd, fdl);
-        mFileDesignator[fdl] = 0;
-
+    case TransferSession::OutputEventType::kInitReceived:
+        HandleInitReceived();
         break;
-    }
-    case TransferSession::OutputEventType::kQueryReceived: {
-        TransferSession::BlockData blockData;
-        uint16_t blockSize   = mTransfer.GetTransferBlockSize();
-        uint16_t bytesToRead = blockSize;
-
-        // TODO: This should be a utility function in TransferSession
-        if (mTransfer.GetTransferLength() > 0 && mNumBytesSent + blockSize > mTransfer.GetTransferLength())
-        {
-            // cast should be safe because of condition above
-            bytesToRead = static_cast<uint16_t>(mTransfer.GetTransferLength() - mNumBytesSent);
-        }
-
-        chip::System::PacketBufferHandle blockBuf = chip::System::PacketBufferHandle::New(bytesToRead);
-        if (blockBuf.IsNull())
-        {
-            // TODO(#13981): AbortTransfer() needs to support GeneralStatusCode failures as well as BDX specific errors.
-            mTransfer.AbortTransfer(StatusCode::kUnknown);
-            return;
-        }
-
-        std::ifstream otaFile(mFileDesignator, std::ifstream::in);
-        if (!otaFile.good())
-        {
-            ChipLogError(BDX, "OTA file open failed");
-            mTransfer.AbortTransfer(StatusCode::kFileDesignatorUnknown);
-            return;
-        }
-
-        otaFile.seekg(mNumBytesSent);
-        otaFile.read(reinterpret_cast<char *>(blockBuf->Start()), bytesToRead);
-        if (!(otaFile.good() || otaFile.eof()))
-        {
-            ChipLogError(BDX, "OTA file read failed");
-            mTransfer.AbortTransfer(StatusCode::kFileDesignatorUnknown);
-            return;
-        }
-
-        blockData.Data   = blockBuf->Start();
-        blockData.Length = static_cast<size_t>(otaFile.gcount());
-        blockData.IsEof  = (blockData.Length < blockSize) ||
-            (mNumBytesSent + static_cast<uint64_t>(blockData.Length) == mTransfer.GetTransferLength() || (otaFile.peek() == EOF));
-        mNumBytesSent = static_cast<uint32_t>(mNumBytesSent + blockData.Length);
-        otaFile.close();
-
-        err = mTransfer.PrepareBlock(blockData);
-        if (err != CHIP_NO_ERROR)
-        {
-            ChipLogError(BDX, "PrepareBlock failed: %" CHIP_ERROR_FORMAT, err.Format());
-            mTransfer.AbortTransfer(StatusCode::kUnknown);
-        }
+    case TransferSession::OutputEventType::kQueryReceived:
+        HandleQueryReceived(0);
+        break;
+    case TransferSession::OutputEventType::kQueryWithSkipReceived:
+        HandleQueryReceived(event.bytesToSkip.BytesToSkip);
         break;
-    }
     case TransferSession::OutputEventType::kAckReceived:
         break;
     case TransferSession::OutputEventType::kAckEOFReceived:
         ChipLogDetail(BDX, "Transfer completed, got AckEOF");
-        mStopPolling = true; // Stop polling the TransferSession only after receiving BlockAckEOF
         Reset();
         break;
     case TransferSession::OutputEventType::kStatusReceived:
@@ -203,23 +327,94 @@ void BdxOtaSender::HandleTransferSessionOutput(TransferSession::OutputEvent & ev
     }
 }
 
-/* Reset() calls bdx::TransferSession::Reset() which sets the output event type to
- * TransferSession::OutputEventType::kNone. So, bdx::TransferFacilitator::PollForOutput()
- * will call HandleTransferSessionOutput() with event TransferSession::OutputEventType::kNone.
- * Since we are ignoring kNone events so, it is okay HandleTransferSessionOutput() being called with event kNone
+void BdxOtaSender::Transfer::HandleInitReceived()
+{
+    char fileDesignator[chip::bdx::kMaxFileDesignatorLen];
+    uint16_t fdl       = 0;
+    const uint8_t * fd = mTransfer.GetFileDesignator(fdl);
+    if (fdl >= chip::bdx::kMaxFileDesignatorLen)
+    {
+        ChipLogError(BDX, "Cannot store file designator with length = %d", fdl);
+        mTransfer.AbortTransfer(StatusCode::kFileDesignatorUnknown);
+        return;
+    }
+    memcpy(fileDesignator, fd, fdl);
+    fileDesignator[fdl] = 0;
+
+    CHIP_ERROR err = mOwner->mImageCache.Acquire(fileDesignator, mImage);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(BDX, "OTA file open failed: %" CHIP_ERROR_FORMAT, err.Format());
+        mTransfer.AbortTransfer(StatusCode::kFileDesignatorUnknown);
+        return;
+    }
+
+    mOffset = mTransfer.GetStartOffset();
+    if (mOffset > mImage.size())
+    {
+        mTransfer.AbortTransfer(StatusCode::kStartOffsetNotSupported);
+        return;
+    }
+
+    mEndOffset = mImage.size();
+    if (mTransfer.GetTransferLength() > 0)
+    {
+        mEndOffset = std::min(mEndOffset, mOffset + mTransfer.GetTransferLength());
+    }
+
+    // TransferSession will automatically reject a transfer if there are no
+    // common supported control modes. It will also default to the smaller
+    // block size.
+    TransferSession::TransferAcceptData acceptData;
+    acceptData.ControlMode  = TransferControlFlags::kReceiverDrive; // OTA must use receiver drive
+    acceptData.MaxBlockSize = mTransfer.GetTransferBlockSize();
+    acceptData.StartOffset  = mTransfer.GetStartOffset();
+    acceptData.Length       = mTransfer.GetTransferLength();
+    err                     = mTransfer.AcceptTransfer(acceptData);
+    VerifyOrReturn(err == CHIP_NO_ERROR, ChipLogError(BDX, "AcceptTransfer failed: %" CHIP_ERROR_FORMAT, err.Format()));
+}
+
+void BdxOtaSender::Transfer::HandleQueryReceived(uint64_t bytesToSkip)
+{
+    mOffset = std::min(mOffset + bytesToSkip, mEndOffset);
+
+    // Blocks point straight into the image mapping, PrepareBlock copies them into the outgoing message.
+    TransferSession::BlockData blockData;
+    blockData.Data   = mImage.data() + mOffset;
+    blockData.Length = static_cast<size_t>(std::min<uint64_t>(mTransfer.GetTransferBlockSize(), mEndOffset - mOffset));
+    blockData.IsEof  = (mOffset + blockData.Length == mEndOffset);
+    mOffset += blockData.Length;
+
+    CHIP_ERROR err = mTransfer.PrepareBlock(blockData);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(BDX, "PrepareBlock failed: %" CHIP_ERROR_FORMAT, err.Format());
+        mTransfer.AbortTransfer(StatusCode::kUnknown);
+    }
+}
+
+/* TransferSession::Reset() sets the output event type to TransferSession::OutputEventType::kNone, so a transfer that is reset
+ * while it is being polled has nothing left to handle.
  */
-void BdxOtaSender::Reset()
+void BdxOtaSender::Transfer::Reset()
 {
-    mFabricIndex.ClearValue();
-    mNodeId.ClearValue();
-    Responder::ResetTransfer();
+    mTransfer.Reset();
     if (mExchangeCtx != nullptr)
     {
-        mExchangeCtx->Close();
-        mExchangeCtx = nullptr;
+        chip::Messaging::ExchangeContext * ec = mExchangeCtx;
+        mExchangeCtx                          = nullptr;
+        ec->Close();
+    }
+
+    if (!mImage.empty())
+    {
+        mOwner->mImageCache.Release(mImage);
+        mImage = chip::ByteSpan();
     }
 
-    mInitialized  = false;
-    mNumBytesSent = 0;
-    memset(mFileDesignator, 0, chip::bdx::kMaxFileDesignatorLen);
+    mFabricIndex = chip::kUndefinedFabricIndex;
+    mNodeId      = chip::kUndefinedNodeId;
+    mInUse       = false;
+    mOffset      = 0;
+    mEndOffset   = 0;
 }
@@ -15,33 +15,130 @@
  *    limitations under the License.
  */
 
+#include <lib/support/BitFlags.h>
+#include <messaging/ExchangeContext.h>
+#include <messaging/ExchangeDelegate.h>
+#include <ota-provider-common/OTAImageCache.h>
 #include <protocols/bdx/BdxTransferSession.h>
-#include <protocols/bdx/TransferFacilitator.h>
+#include <system/SystemLayer.h>
 
 #pragma once
 
-class BdxOtaSender : public chip::bdx::Responder
+/**
+ * Serves OTA images over BDX to several OTA Requestors at once.
+ *
+ * Each transfer is reserved for a requestor when a QueryImageResponse hands it an image URI, and the first BDX message received
+ * from that requestor is routed to its transfer. Image blocks are served from memory mappings shared by all the transfers of the
+ * same image. All transfers are polled from a single timer, in round-robin order, so that a budget of blocks per poll is shared
+ * fairly between them.
+ */
+class BdxOtaSender : public chip::Messaging::UnsolicitedMessageHandler, public chip::Messaging::ExchangeDelegate
 {
 public:
+    static constexpr uint16_t kMaxConcurrentTransfers = 16;
+
     BdxOtaSender();
 
-    // Initializes BDX transfer-related metadata. Should always be called first.
-    CHIP_ERROR InitializeTransfer(chip::FabricIndex fabricIndex, chip::NodeId nodeId);
+    /**
+     * Reserve a transfer for the given requestor and prepare it to receive a ReceiveInit message. A transfer already reserved for
+     * the same requestor is considered stale and is replaced.
+     *
+     * @retval CHIP_ERROR_BUSY if the maximum number of concurrent transfers are in progress.
+     */
+    CHIP_ERROR InitializeTransfer(chip::FabricIndex fabricIndex, chip::NodeId nodeId, chip::System::Layer * layer,
+                                  chip::BitFlags<chip::bdx::TransferControlFlags> xferControlOpts, uint16_t maxBlockSize,
+                                  chip::System::Clock::Timeout timeout, chip::System::Clock::Timeout pollFreq);
+
+    /**
+     * Set the number of transfers that can be in progress at the same time, at most kMaxConcurrentTransfers.
+     * Only takes effect for transfers initialized afterwards.
+     */
+    void SetMaxConcurrentTransfers(uint16_t count);
+
+    /**
+     * Set the number of blocks served across all transfers on each poll, 0 meaning no limit. When the budget runs out, the
+     * next poll resumes with the transfers that were not served.
+     */
+    void SetMaxBlocksPerPoll(uint16_t count) { mMaxBlocksPerPoll = count; }
+
+    uint16_t GetActiveTransferCount() const;
 
 private:
-    // Inherited from bdx::TransferFacilitator
-    void HandleTransferSessionOutput(chip::bdx::TransferSession::OutputEvent & event) override;
+    class Transfer : public chip::Messaging::ExchangeDelegate
+    {
+    public:
+        void Init(BdxOtaSender * owner) { mOwner = owner; }
+
+        CHIP_ERROR Prepare(chip::FabricIndex fabricIndex, chip::NodeId nodeId,
+                           chip::BitFlags<chip::bdx::TransferControlFlags> xferControlOpts, uint16_t maxBlockSize,
+                           chip::System::Clock::Timeout timeout);
+
+        bool IsInUse() const { return mInUse; }
+        bool IsFor(chip::FabricIndex fabricIndex, chip::NodeId nodeId) const
+        {
+            return mInUse && mFabricIndex == fabricIndex && mNodeId == nodeId;
+        }
+        bool HasExchange() const { return mExchangeCtx != nullptr; }
+
+        /**
+         * Poll the TransferSession and handle its output.
+         *
+         * @retval true if an image block was prepared.
+         */
+        bool Poll(chip::System::Clock::Timestamp now);
+
+        void Reset();
+
+        // Inherited from ExchangeDelegate
+        CHIP_ERROR OnMessageReceived(chip::Messaging::ExchangeContext * ec, const chip::PayloadHeader & payloadHeader,
+                                     chip::System::PacketBufferHandle && payload) override;
+        void OnResponseTimeout(chip::Messaging::ExchangeContext * ec) override;
+        void OnExchangeClosing(chip::Messaging::ExchangeContext * ec) override;
+
+    private:
+        void HandleTransferSessionOutput(chip::bdx::TransferSession::OutputEvent & event);
+        void HandleInitReceived();
+        void HandleQueryReceived(uint64_t bytesToSkip);
+
+        BdxOtaSender * mOwner = nullptr;
+        chip::bdx::TransferSession mTransfer;
+        chip::Messaging::ExchangeContext * mExchangeCtx = nullptr;
+
+        chip::FabricIndex mFabricIndex = chip::kUndefinedFabricIndex;
+        chip::NodeId mNodeId           = chip::kUndefinedNodeId;
+        bool mInUse                    = false;
+
+        // Transfers that never receive a ReceiveInit are released after mTimeout.
+        chip::System::Clock::Timestamp mReservedAt = chip::System::Clock::kZero;
+        chip::System::Clock::Timeout mTimeout      = chip::System::Clock::kZero;
+
+        chip::ByteSpan mImage;
+        uint64_t mOffset    = 0;
+        uint64_t mEndOffset = 0;
+    };
+
+    // Inherited from UnsolicitedMessageHandler
+    CHIP_ERROR OnUnsolicitedMessageReceived(const chip::PayloadHeader & payloadHeader,
+                                            chip::Messaging::ExchangeDelegate *& newDelegate) override;
 
-    void Reset();
+    // Inherited from ExchangeDelegate, only used to route the first message of an exchange to its transfer.
+    CHIP_ERROR OnMessageReceived(chip::Messaging::ExchangeContext * ec, const chip::PayloadHeader & payloadHeader,
+                                 chip::System::PacketBufferHandle && payload) override;
+    void OnResponseTimeout(chip::Messaging::ExchangeContext * ec) override {}
 
-    // Null-terminated string representing file designator
-    char mFileDesignator[chip::bdx::kMaxFileDesignatorLen];
+    Transfer * FindTransfer(chip::FabricIndex fabricIndex, chip::NodeId nodeId);
 
-    uint32_t mNumBytesSent = 0;
+    static void PollTimerHandler(chip::System::Layer * systemLayer, void * appState);
+    void PollTransfers();
 
-    bool mInitialized = false;
+    Transfer mTransfers[kMaxConcurrentTransfers];
+    uint16_t mMaxConcurrentTransfers = kMaxConcurrentTransfers;
+    uint16_t mMaxBlocksPerPoll       = 0;
+    uint16_t mNextTransferToPoll     = 0;
 
-    chip::Optional<chip::FabricIndex> mFabricIndex;
+    chip::System::Layer * mSystemLayer = nullptr;
+    chip::System::Clock::Timeout mPollFreq;
+    bool mPolling = false;
 
-    chip::Optional<chip::NodeId> mNodeId;
+    OTAImageCache mImageCache;
 };
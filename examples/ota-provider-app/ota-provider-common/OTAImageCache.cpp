@@ -0,0 +1,114 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <ota-provider-common/OTAImageCache.h>
+
+#include <lib/support/CHIPMemString.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+OTAImageCache::~OTAImageCache()
+{
+    for (Entry & entry : mEntries)
+    {
+        Unmap(entry);
+    }
+}
+
+CHIP_ERROR OTAImageCache::Acquire(const char * path, chip::ByteSpan & image)
+{
+    VerifyOrReturnError(path != nullptr && strlen(path) < sizeof(Entry::mPath), CHIP_ERROR_INVALID_ARGUMENT);
+
+    Entry * freeEntry = nullptr;
+    for (Entry & entry : mEntries)
+    {
+        if (entry.mRefCount > 0 && strcmp(entry.mPath, path) == 0)
+        {
+            entry.mRefCount++;
+            image = chip::ByteSpan(entry.mData, entry.mSize);
+            return CHIP_NO_ERROR;
+        }
+        if (entry.mRefCount == 0 && freeEntry == nullptr)
+        {
+            freeEntry = &entry;
+        }
+    }
+    VerifyOrReturnError(freeEntry != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        ChipLogError(BDX, "Cannot open OTA image file %s", path);
+        return CHIP_ERROR_OPEN_FAILED;
+    }
+
+    struct stat fileStat;
+    void * data = MAP_FAILED;
+    if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0)
+    {
+        data = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    }
+    // The mapping stays valid after the descriptor is closed.
+    close(fd);
+
+    if (data == MAP_FAILED)
+    {
+        ChipLogError(BDX, "Cannot map OTA image file %s", path);
+        return CHIP_ERROR_OPEN_FAILED;
+    }
+
+    chip::Platform::CopyString(freeEntry->mPath, path);
+    freeEntry->mData     = static_cast<const uint8_t *>(data);
+    freeEntry->mSize     = static_cast<size_t>(fileStat.st_size);
+    freeEntry->mRefCount = 1;
+
+    ChipLogDetail(BDX, "Mapped OTA image file %s (%u bytes)", path, static_cast<unsigned>(freeEntry->mSize));
+
+    image = chip::ByteSpan(freeEntry->mData, freeEntry->mSize);
+    return CHIP_NO_ERROR;
+}
+
+void OTAImageCache::Release(const chip::ByteSpan & image)
+{
+    for (Entry & entry : mEntries)
+    {
+        if (entry.mRefCount > 0 && entry.mData == image.data())
+        {
+            if (--entry.mRefCount == 0)
+            {
+                Unmap(entry);
+            }
+            return;
+        }
+    }
+}
+
+void OTAImageCache::Unmap(Entry & entry)
+{
+    if (entry.mData != nullptr)
+    {
+        munmap(const_cast<uint8_t *>(entry.mData), entry.mSize);
+    }
+
+    entry = Entry();
+}
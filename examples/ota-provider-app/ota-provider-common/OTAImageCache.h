@@ -0,0 +1,68 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <lib/support/Span.h>
+#include <protocols/bdx/BdxMessages.h>
+
+/**
+ * A set of read-only memory mappings of OTA image files, shared by all the BDX transfers serving the same image.
+ *
+ * An image is mapped by the first Acquire() for its path and unmapped once every transfer that acquired it has released it.
+ */
+class OTAImageCache
+{
+public:
+    static constexpr size_t kMaxImages = 4;
+
+    OTAImageCache() = default;
+    ~OTAImageCache();
+
+    OTAImageCache(const OTAImageCache &) = delete;
+    OTAImageCache & operator=(const OTAImageCache &) = delete;
+
+    /**
+     * Get the content of the image file at the given path, mapping it if it is not mapped yet.
+     *
+     * @param[in]  path  Null-terminated path of the image file.
+     * @param[out] image The content of the image, valid until the matching Release().
+     *
+     * @retval CHIP_ERROR_OPEN_FAILED if the file cannot be opened or mapped.
+     * @retval CHIP_ERROR_NO_MEMORY if kMaxImages different images are already mapped.
+     */
+    CHIP_ERROR Acquire(const char * path, chip::ByteSpan & image);
+
+    /**
+     * Release an image returned by Acquire().
+     */
+    void Release(const chip::ByteSpan & image);
+
+private:
+    struct Entry
+    {
+        char mPath[chip::bdx::kMaxFileDesignatorLen] = { 0 };
+        const uint8_t * mData                        = nullptr;
+        size_t mSize                                 = 0;
+        uint32_t mRefCount                           = 0;
+    };
+
+    static void Unmap(Entry & entry);
+
+    Entry mEntries[kMaxImages];
+};
@@ -271,29 +271,28 @@ void OTAProviderExample::SendQueryImageResponse(app::CommandHandler * commandObj
         // Initialize the transfer session in prepartion for a BDX transfer
         BitFlags<TransferControlFlags> bdxFlags;
         bdxFlags.Set(TransferControlFlags::kReceiverDrive);
-        if (mBdxOtaSender.InitializeTransfer(commandObj->GetSubjectDescriptor().fabricIndex,
-                                             commandObj->GetSubjectDescriptor().subject) == CHIP_NO_ERROR)
+        CHIP_ERROR error = mBdxOtaSender.InitializeTransfer(
+            commandObj->GetSubjectDescriptor().fabricIndex, commandObj->GetSubjectDescriptor().subject,
+            &chip::DeviceLayer::SystemLayer(), bdxFlags, kMaxBdxBlockSize, kBdxTimeout,
+            chip::System::Clock::Milliseconds32(mPollInterval));
+        if (error == CHIP_NO_ERROR)
         {
-            CHIP_ERROR error =
-                mBdxOtaSender.PrepareForTransfer(&chip::DeviceLayer::SystemLayer(), chip::bdx::TransferRole::kSender, bdxFlags,
-                                                 kMaxBdxBlockSize, kBdxTimeout, chip::System::Clock::Milliseconds32(mPollInterval));
-            if (error != CHIP_NO_ERROR)
-            {
-                ChipLogError(SoftwareUpdate, "Cannot prepare for transfer: %" CHIP_ERROR_FORMAT, error.Format());
-                commandObj->AddStatus(commandPath, Status::Failure);
-                return;
-            }
-
             response.imageURI.Emplace(chip::CharSpan::fromCharString(mImageUri));
             response.softwareVersion.Emplace(mSoftwareVersion);
             response.softwareVersionString.Emplace(chip::CharSpan::fromCharString(mSoftwareVersionString));
             response.updateToken.Emplace(chip::ByteSpan(updateToken));
         }
-        else
+        else if (error == CHIP_ERROR_BUSY)
         {
-            // Another BDX transfer in progress
+            // All BDX transfers are in progress
             mQueryImageStatus = OTAQueryStatus::kBusy;
         }
+        else
+        {
+            ChipLogError(SoftwareUpdate, "Cannot prepare for transfer: %" CHIP_ERROR_FORMAT, error.Format());
+            commandObj->AddStatus(commandPath, Status::Failure);
+            return;
+        }
     }
 
     // Delay action time is only applicable when the provider is busy
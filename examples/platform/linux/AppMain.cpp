@@ -67,6 +67,10 @@
 #include "TraceHandlers.h"
 #endif // CHIP_CONFIG_TRANSPORT_TRACE_ENABLED
 
+#if defined(ENABLE_ASYNC_LOGGING)
+#include <platform/Linux/AsyncLogging.h>
+#endif
+
 #if CHIP_DEVICE_CONFIG_ENABLE_OTA_REQUESTOR
 #include <app/clusters/ota-requestor/OTATestEventTriggerDelegate.h>
 #endif
@@ -115,12 +119,47 @@ void EventHandler(const DeviceLayer::ChipDeviceEvent * event, intptr_t arg)
     }
 }
 
+#if defined(ENABLE_ASYNC_LOGGING)
+FILE * gAsyncLogFile = nullptr;
+
+CHIP_ERROR InitAsyncLogging()
+{
+    LinuxDeviceOptions & options = LinuxDeviceOptions::GetInstance();
+    VerifyOrReturnError(options.asyncLogging, CHIP_NO_ERROR);
+
+    Logging::Platform::AsyncLoggingConfig config;
+    config.binary = options.asyncLoggingBinary;
+    if (options.asyncLogFile != nullptr)
+    {
+        gAsyncLogFile = fopen(options.asyncLogFile, config.binary ? "wb" : "w");
+        VerifyOrReturnError(gAsyncLogFile != nullptr, CHIP_ERROR_OPEN_FAILED);
+        config.output = gAsyncLogFile;
+    }
+
+    return Logging::Platform::StartAsyncLogging(config);
+}
+
+void ShutdownAsyncLogging()
+{
+    Logging::Platform::StopAsyncLogging();
+    if (gAsyncLogFile != nullptr)
+    {
+        fclose(gAsyncLogFile);
+        gAsyncLogFile = nullptr;
+    }
+}
+#endif // defined(ENABLE_ASYNC_LOGGING)
+
 void Cleanup()
 {
 #if CHIP_CONFIG_TRANSPORT_TRACE_ENABLED
     chip::trace::DeInitTrace();
 #endif // CHIP_CONFIG_TRANSPORT_TRACE_ENABLED
 
+#if defined(ENABLE_ASYNC_LOGGING)
+    ShutdownAsyncLogging();
+#endif // defined(ENABLE_ASYNC_LOGGING)
+
     // TODO(16968): Lifecycle management of storage-using components like GroupDataProvider, etc
 }
 
@@ -209,6 +248,11 @@ int ChipLinuxAppInit(int argc, char * const argv[], OptionSet * customOptions)
     err = ParseArguments(argc, argv, customOptions);
     SuccessOrExit(err);
 
+#if defined(ENABLE_ASYNC_LOGGING)
+    err = InitAsyncLogging();
+    SuccessOrExit(err);
+#endif // defined(ENABLE_ASYNC_LOGGING)
+
 #ifdef CHIP_CONFIG_KVS_PATH
     if (LinuxDeviceOptions::GetInstance().KVS == nullptr)
     {
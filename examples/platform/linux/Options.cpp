@@ -74,6 +74,8 @@ enum
     kOptionCSRResponseCSRExistingKeyPair                = 0x101e,
     kDeviceOption_TestEventTriggerEnableKey             = 0x101f,
     kCommissionerOption_FabricID                        = 0x1020,
+    kDeviceOption_AsyncLog                              = 0x1021,
+    kDeviceOption_AsyncLogFile                          = 0x1022,
 };
 
 constexpr unsigned kAppUsageLength = 64;
@@ -120,6 +122,10 @@ OptionDef sDeviceOptionDefs[] = {
     { "cert_error_attestation_signature_invalid", kNoArgument, kOptionCSRResponseAttestationSignatureInvalid },
     { "enable-key", kArgumentRequired, kDeviceOption_TestEventTriggerEnableKey },
     { "commissioner-fabric-id", kArgumentRequired, kCommissionerOption_FabricID },
+#if defined(ENABLE_ASYNC_LOGGING)
+    { "async-log", kArgumentRequired, kDeviceOption_AsyncLog },
+    { "async-log-file", kArgumentRequired, kDeviceOption_AsyncLogFile },
+#endif // defined(ENABLE_ASYNC_LOGGING)
     {}
 };
 
@@ -226,6 +232,13 @@ const char * sDeviceOptionHelp =
     "       Configure the CSRResponse to be build with an AttestationSignature that does not match what is expected.\n"
     "  --enable-key <key>\n"
     "       A 16-byte, hex-encoded key, used to validate TestEventTrigger command of Generial Diagnostics cluster\n"
+#if defined(ENABLE_ASYNC_LOGGING)
+    "  --async-log <text|binary>\n"
+    "       Format and write log messages from a background thread, as text lines or in the binary log format\n"
+    "       read by chip-log-decoder.\n"
+    "  --async-log-file <file>\n"
+    "       Write the asynchronous log to the provided file instead of stdout.\n"
+#endif // defined(ENABLE_ASYNC_LOGGING)
     "\n";
 
 bool Base64ArgToVector(const char * arg, size_t maxSize, std::vector<uint8_t> & outVector)
@@ -467,6 +480,24 @@ bool HandleOption(const char * aProgram, OptionSet * aOptions, int aIdentifier,
         break;
     }
 
+#if defined(ENABLE_ASYNC_LOGGING)
+    case kDeviceOption_AsyncLog:
+        if (strcmp(aValue, "text") == 0 || strcmp(aValue, "binary") == 0)
+        {
+            LinuxDeviceOptions::GetInstance().asyncLogging       = true;
+            LinuxDeviceOptions::GetInstance().asyncLoggingBinary = (strcmp(aValue, "binary") == 0);
+        }
+        else
+        {
+            PrintArgError("%s: ERROR: invalid value specified for %s\n", aProgram, aName);
+            retval = false;
+        }
+        break;
+    case kDeviceOption_AsyncLogFile:
+        LinuxDeviceOptions::GetInstance().asyncLogFile = aValue;
+        break;
+#endif // defined(ENABLE_ASYNC_LOGGING)
+
     default:
         PrintArgError("%s: INTERNAL ERROR: Unhandled option: %s\n", aProgram, aName);
         retval = false;
@@ -61,6 +61,9 @@ struct LinuxDeviceOptions
     chip::CSRResponseOptions mCSRResponseOptions;
     uint8_t testEventTriggerEnableKey[16] = { 0 };
     chip::FabricId commissionerFabricId   = chip::kUndefinedFabricId;
+    bool asyncLogging                     = false;
+    bool asyncLoggingBinary               = false;
+    const char * asyncLogFile             = nullptr;
 
     static LinuxDeviceOptions & GetInstance();
 };
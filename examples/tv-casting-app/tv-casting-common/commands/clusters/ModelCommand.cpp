@@ -28,31 +28,38 @@ CHIP_ERROR ModelCommand::RunCommand()
 {
     FabricIndex fabricIndex = CastingServer::GetInstance()->CurrentFabricIndex();
 
-    if (mDestinationId == 0)
+    // Batch mode is not supported here: only the first destination is used.
+    NodeId destinationId = mDestinationIds.front();
+    if (destinationId == 0)
     {
         ChipLogProgress(chipTool, "nodeId set to 0, using default for fabric %d", fabricIndex);
-        mDestinationId = CastingServer::GetInstance()->GetVideoPlayerNodeForFabricIndex(fabricIndex);
+        destinationId = CastingServer::GetInstance()->GetVideoPlayerNodeForFabricIndex(fabricIndex);
     }
     else
     {
         // potentially change fabric index if this is not the right one for the given nodeId
-        fabricIndex = CastingServer::GetInstance()->GetVideoPlayerFabricIndexForNode(mDestinationId);
+        fabricIndex = CastingServer::GetInstance()->GetVideoPlayerFabricIndexForNode(destinationId);
     }
-    ChipLogProgress(chipTool, "Sending command to node 0x%" PRIx64, mDestinationId);
+    ChipLogProgress(chipTool, "Sending command to node 0x%" PRIx64, destinationId);
 
-    if (IsGroupId(mDestinationId))
+    if (IsGroupId(destinationId))
     {
-        ChipLogProgress(chipTool, "Sending command to group 0x%x", GroupIdFromNodeId(mDestinationId));
+        ChipLogProgress(chipTool, "Sending command to group 0x%x", GroupIdFromNodeId(destinationId));
 
-        return SendGroupCommand(GroupIdFromNodeId(mDestinationId), fabricIndex);
+        return SendGroupCommand(GroupIdFromNodeId(destinationId), fabricIndex);
     }
 
     Server * server = &(chip::Server::GetInstance());
-    server->GetCASESessionManager()->FindOrEstablishSession(ScopedNodeId(mDestinationId, fabricIndex), &mOnDeviceConnectedCallback,
+    server->GetCASESessionManager()->FindOrEstablishSession(ScopedNodeId(destinationId, fabricIndex), &mOnDeviceConnectedCallback,
                                                             &mOnDeviceConnectionFailureCallback);
     return CHIP_NO_ERROR;
 }
 
+System::Clock::Timeout ModelCommand::GetInvocationWaitDuration() const
+{
+    return GetWaitDuration();
+}
+
 void ModelCommand::OnDeviceConnectedFn(void * context, Messaging::ExchangeManager & exchangeMgr,
                                        const SessionHandle & sessionHandle)
 {
@@ -0,0 +1,96 @@
+#!/usr/bin/env bash
+
+# Serves one OTA image to many OTA Requestors at once, all running on this host, and checks that every requestor downloads the
+# image. The provider is started with a limit on concurrent BDX transfers lower than the number of requestors, so that some of them
+# are told to retry later.
+
+NUM_REQUESTORS=${1:-8}
+MAX_CONCURRENT_TRANSFERS=${2:-4}
+PASSCODE=${3:-20202021}
+FIRST_DISCRIMINATOR=${4:-100}
+FIRST_UDP_PORT=${5:-5600}
+FIRMWARE_SIZE_KB=${6:-256}
+
+FIRMWARE_BIN="my-firmware.bin"
+FIRMWARE_OTA="my-firmware.ota"
+LOG_DIR="/tmp/ota-load"
+
+OTA_PROVIDER_APP="chip-ota-provider-app"
+OTA_PROVIDER_FOLDER="out/ota_provider_debug"
+OTA_REQUESTOR_APP="chip-ota-requestor-app"
+OTA_REQUESTOR_FOLDER="out/ota_requestor_debug"
+CHIP_TOOL_APP="chip-tool"
+CHIP_TOOL_FOLDER="out"
+
+PROVIDER_NODE_ID=1
+FIRST_REQUESTOR_NODE_ID=2
+
+killall -e "$OTA_PROVIDER_APP" "$OTA_REQUESTOR_APP"
+rm -rf "$FIRMWARE_OTA" "$FIRMWARE_BIN" "$LOG_DIR"
+mkdir -p "$LOG_DIR"
+
+set -e
+
+scripts/examples/gn_build_example.sh examples/chip-tool "$CHIP_TOOL_FOLDER"
+scripts/examples/gn_build_example.sh examples/ota-requestor-app/linux "$OTA_REQUESTOR_FOLDER" chip_config_network_layer_ble=false
+scripts/examples/gn_build_example.sh examples/ota-provider-app/linux "$OTA_PROVIDER_FOLDER" chip_config_network_layer_ble=false
+
+head -c "$((FIRMWARE_SIZE_KB * 1024))" /dev/urandom >"$FIRMWARE_BIN"
+
+rm -f /tmp/chip_*
+
+./src/app/ota_image_tool.py create -v 0xDEAD -p 0xBEEF -vn 10 -vs "10.0" -da sha256 "$FIRMWARE_BIN" "$FIRMWARE_OTA"
+
+./"$OTA_PROVIDER_FOLDER"/"$OTA_PROVIDER_APP" -f "$FIRMWARE_OTA" --maxConcurrentTransfers "$MAX_CONCURRENT_TRANSFERS" >"$LOG_DIR"/provider-log.txt 2>&1 &
+
+echo "Commissioning Provider"
+
+./"$CHIP_TOOL_FOLDER"/"$CHIP_TOOL_APP" pairing onnetwork "$PROVIDER_NODE_ID" "$PASSCODE" >"$LOG_DIR"/chip-tool-commission-provider.txt
+grep -q "Device commissioning completed with success" "$LOG_DIR"/chip-tool-commission-provider.txt
+
+./"$CHIP_TOOL_FOLDER"/"$CHIP_TOOL_APP" accesscontrol write acl '[{"fabricIndex": 1, "privilege": 5, "authMode": 2, "subjects": [112233], "targets": null}, {"fabricIndex": 1, "privilege": 3, "authMode": 2, "subjects": null, "targets": null}]' "$PROVIDER_NODE_ID" 0
+
+for i in $(seq 0 $((NUM_REQUESTORS - 1))); do
+    DISCRIMINATOR=$((FIRST_DISCRIMINATOR + i))
+    NODE_ID=$((FIRST_REQUESTOR_NODE_ID + i))
+
+    stdbuf -o0 ./"$OTA_REQUESTOR_FOLDER"/"$OTA_REQUESTOR_APP" --discriminator "$DISCRIMINATOR" \
+        --secured-device-port "$((FIRST_UDP_PORT + i))" --KVS /tmp/chip_kvs_requestor_"$i" \
+        --otaDownloadPath "$LOG_DIR"/download-"$i".bin >"$LOG_DIR"/requestor-log-"$i".txt 2>&1 &
+
+    echo "Commissioning Requestor $i"
+
+    ./"$CHIP_TOOL_FOLDER"/"$CHIP_TOOL_APP" pairing onnetwork-long "$NODE_ID" "$PASSCODE" "$DISCRIMINATOR" >"$LOG_DIR"/chip-tool-commission-requestor-"$i".txt
+    grep -q "Device commissioning completed with success" "$LOG_DIR"/chip-tool-commission-requestor-"$i".txt
+done
+
+echo "Sending announce-ota-provider to $NUM_REQUESTORS requestors"
+
+for i in $(seq 0 $((NUM_REQUESTORS - 1))); do
+    ./"$CHIP_TOOL_FOLDER"/"$CHIP_TOOL_APP" otasoftwareupdaterequestor announce-ota-provider "$PROVIDER_NODE_ID" 0 0 0 \
+        "$((FIRST_REQUESTOR_NODE_ID + i))" 0 >"$LOG_DIR"/chip-tool-announce-ota-"$i".txt
+done
+
+# Requestors told that the provider is busy retry after the default delayed action time, allow a few rounds of retries.
+RETURN_VALUE=0
+for i in $(seq 0 $((NUM_REQUESTORS - 1))); do
+    if ! timeout 600 grep -q "OTA image downloaded to" <(tail -n +1 -f "$LOG_DIR"/requestor-log-"$i".txt); then
+        echo "Requestor $i did not download the image"
+        RETURN_VALUE=1
+    elif ! cmp "$LOG_DIR"/download-"$i".bin "$FIRMWARE_BIN"; then
+        echo "Requestor $i downloaded a corrupted image"
+        RETURN_VALUE=1
+    fi
+done
+
+echo "Exiting, logs are in $LOG_DIR"
+
+killall -s SIGKILL -e "$OTA_PROVIDER_APP" "$OTA_REQUESTOR_APP"
+rm -f "$FIRMWARE_OTA" "$FIRMWARE_BIN"
+
+if [ "$RETURN_VALUE" -eq 0 ]; then
+    echo "Test passed"
+else
+    echo "Test failed"
+fi
+exit "$RETURN_VALUE"
@@ -68,14 +68,59 @@ AttributePathExpandIterator::AttributePathExpandIterator(ObjectList<AttributePat
     mGlobalAttributeIndex = UINT8_MAX;
 
     // Make the iterator ready to emit the first valid path in the list.
+    RefreshExpansionCache();
     Next();
 }
 
+bool AttributePathExpandIterator::EndpointIndexIsEnabled(uint16_t aEndpointIndex) const
+{
+#if CHIP_IM_SERVER_PATH_EXPANSION_CACHE_MAX_ATTRIBUTES > 0
+    if (mpExpansionCache != nullptr)
+    {
+        return mpExpansionCache->IsEndpointEnabled(aEndpointIndex);
+    }
+#endif
+    return emberAfEndpointIndexIsEnabled(aEndpointIndex);
+}
+
+ClusterId AttributePathExpandIterator::GetServerClusterId(EndpointId aEndpointId) const
+{
+#if CHIP_IM_SERVER_PATH_EXPANSION_CACHE_MAX_ATTRIBUTES > 0
+    if (mpExpansionCache != nullptr)
+    {
+        return mpExpansionCache->GetClusterId(mEndpointIndex, mClusterIndex);
+    }
+#endif
+    // emberAfGetNthClusterId must return a valid cluster id here since we have verified the mClusterIndex does not exceed the
+    // mEndClusterIndex.
+    return emberAfGetNthClusterId(aEndpointId, mClusterIndex, true /* server */).Value();
+}
+
+AttributeId AttributePathExpandIterator::GetServerAttributeId(EndpointId aEndpointId, ClusterId aClusterId) const
+{
+#if CHIP_IM_SERVER_PATH_EXPANSION_CACHE_MAX_ATTRIBUTES > 0
+    if (mpExpansionCache != nullptr)
+    {
+        return mpExpansionCache->GetAttributeId(mEndpointIndex, mClusterIndex, mAttributeIndex);
+    }
+#endif
+    // GetServerAttributeIdByIdex must return a valid attribute here since we have verified the mAttributeIndex does not exceed
+    // the mEndAttributeIndex.
+    return emberAfGetServerAttributeIdByIndex(aEndpointId, aClusterId, mAttributeIndex).Value();
+}
+
 void AttributePathExpandIterator::PrepareEndpointIndexRange(const AttributePathParams & aAttributePath)
 {
     if (aAttributePath.HasWildcardEndpointId())
     {
-        mEndpointIndex    = 0;
+        mEndpointIndex = 0;
+#if CHIP_IM_SERVER_PATH_EXPANSION_CACHE_MAX_ATTRIBUTES > 0
+        if (mpExpansionCache != nullptr)
+        {
+            mEndEndpointIndex = mpExpansionCache->GetEndpointCount();
+            return;
+        }
+#endif
         mEndEndpointIndex = emberAfEndpointCount();
     }
     else
@@ -91,7 +136,14 @@ void AttributePathExpandIterator::PrepareClusterIndexRange(const AttributePathPa
 {
     if (aAttributePath.HasWildcardClusterId())
     {
-        mClusterIndex    = 0;
+        mClusterIndex = 0;
+#if CHIP_IM_SERVER_PATH_EXPANSION_CACHE_MAX_ATTRIBUTES > 0
+        if (mpExpansionCache != nullptr)
+        {
+            mEndClusterIndex = mpExpansionCache->GetClusterCount(mEndpointIndex);
+            return;
+        }
+#endif
         mEndClusterIndex = emberAfClusterCount(aEndpointId, true /* server */);
     }
     else
@@ -109,9 +161,16 @@ void AttributePathExpandIterator::PrepareAttributeIndexRange(const AttributePath
     if (aAttributePath.HasWildcardAttributeId())
     {
         mAttributeIndex          = 0;
-        mEndAttributeIndex       = emberAfGetServerAttributeCount(aEndpointId, aClusterId);
         mGlobalAttributeIndex    = 0;
         mGlobalAttributeEndIndex = ArraySize(GlobalAttributesNotInMetadata);
+#if CHIP_IM_SERVER_PATH_EXPANSION_CACHE_MAX_ATTRIBUTES > 0
+        if (mpExpansionCache != nullptr)
+        {
+            mEndAttributeIndex = mpExpansionCache->GetAttributeCount(mEndpointIndex, mClusterIndex);
+            return;
+        }
+#endif
+        mEndAttributeIndex = emberAfGetServerAttributeCount(aEndpointId, aClusterId);
     }
     else
     {
@@ -162,9 +221,83 @@ void AttributePathExpandIterator::ResetCurrentCluster()
     // in a valid path, which is the first attribute id we will emit for the current cluster.
     mAttributeIndex       = UINT16_MAX;
     mGlobalAttributeIndex = UINT8_MAX;
+    RefreshExpansionCache();
     Next();
 }
 
+#if CHIP_IM_SERVER_PATH_EXPANSION_CACHE_MAX_ATTRIBUTES > 0
+void AttributePathExpandIterator::RelocateAfterOutputPath()
+{
+    const AttributePathParams & attributePath = mpAttributePath->mValue;
+    // ResetCurrentCluster leaves both attribute indexes unset, so that the current cluster is expanded again from its start.
+    const bool restartCluster = (mAttributeIndex == UINT16_MAX && mGlobalAttributeIndex == UINT8_MAX);
+
+    // Endpoints keep their index while they exist. If the endpoint of the last path is gone, its index is resumed from the start,
+    // whatever now lives there has not been emitted yet.
+    const uint16_t previousEndpointIndex = mEndpointIndex;
+    PrepareEndpointIndexRange(attributePath);
+    mEndpointIndex = emberAfIndexFromEndpoint(mOutputPath.mEndpointId);
+    mClusterIndex  = UINT8_MAX;
+    if (mEndpointIndex == UINT16_MAX || !EndpointIndexIsEnabled(mEndpointIndex))
+    {
+        mEndpointIndex = attributePath.HasWildcardEndpointId() ? previousEndpointIndex : mEndEndpointIndex;
+        return;
+    }
+
+    PrepareClusterIndexRange(attributePath, mOutputPath.mEndpointId);
+    mClusterIndex         = emberAfClusterIndex(mOutputPath.mEndpointId, mOutputPath.mClusterId, CLUSTER_MASK_SERVER);
+    mAttributeIndex       = UINT16_MAX;
+    mGlobalAttributeIndex = UINT8_MAX;
+    if (mClusterIndex == UINT8_MAX)
+    {
+        // The endpoint was replaced by one without the cluster, expand it from its start.
+        return;
+    }
+    if (restartCluster)
+    {
+        return;
+    }
+
+    PrepareAttributeIndexRange(attributePath, mOutputPath.mEndpointId, mOutputPath.mClusterId);
+    const uint16_t attributeIndex =
+        emberAfGetServerAttributeIndexByAttributeId(mOutputPath.mEndpointId, mOutputPath.mClusterId, mOutputPath.mAttributeId);
+    if (attributeIndex != UINT16_MAX)
+    {
+        mAttributeIndex = static_cast<uint16_t>(attributeIndex + 1);
+        return;
+    }
+
+    // The last path is a global attribute that is not part of the metadata, they come after all the others.
+    mAttributeIndex = mEndAttributeIndex;
+    for (uint8_t idx = 0; idx < ArraySize(GlobalAttributesNotInMetadata); ++idx)
+    {
+        if (GlobalAttributesNotInMetadata[idx] == mOutputPath.mAttributeId)
+        {
+            mGlobalAttributeIndex = static_cast<uint8_t>(idx + 1);
+            break;
+        }
+    }
+}
+#endif
+
+void AttributePathExpandIterator::RefreshExpansionCache()
+{
+#if CHIP_IM_SERVER_PATH_EXPANSION_CACHE_MAX_ATTRIBUTES > 0
+    AttributePathExpansionCache & expansionCache = AttributePathExpansionCache::Instance();
+    mpExpansionCache                             = expansionCache.Refresh() ? &expansionCache : nullptr;
+    if (mpExpansionCache != nullptr && mpExpansionCache->GetGeneration() != mExpansionCacheGeneration)
+    {
+        // The data model changed since the index ranges were prepared, they may point past the new set of endpoints, clusters or
+        // attributes. Find where the expansion of the current wildcard path stands in the new data model.
+        mExpansionCacheGeneration = mpExpansionCache->GetGeneration();
+        if (mpAttributePath != nullptr && mpAttributePath->mValue.IsWildcardPath() && mEndpointIndex != UINT16_MAX)
+        {
+            RelocateAfterOutputPath();
+        }
+    }
+#endif
+}
+
 bool AttributePathExpandIterator::Next()
 {
     for (; mpAttributePath != nullptr; (mpAttributePath = mpAttributePath->mpNext, mEndpointIndex = UINT16_MAX))
@@ -192,7 +325,7 @@ bool AttributePathExpandIterator::Next()
         for (; mEndpointIndex < mEndEndpointIndex;
              (mEndpointIndex++, mClusterIndex = UINT8_MAX, mAttributeIndex = UINT16_MAX, mGlobalAttributeIndex = UINT8_MAX))
         {
-            if (!emberAfEndpointIndexIsEnabled(mEndpointIndex))
+            if (!EndpointIndexIsEnabled(mEndpointIndex))
             {
                 // Not an enabled endpoint; skip it.
                 continue;
@@ -210,9 +343,7 @@ bool AttributePathExpandIterator::Next()
             for (; mClusterIndex < mEndClusterIndex;
                  (mClusterIndex++, mAttributeIndex = UINT16_MAX, mGlobalAttributeIndex = UINT8_MAX))
             {
-                // emberAfGetNthClusterId must return a valid cluster id here since we have verified the mClusterIndex does
-                // not exceed the mEndClusterIndex.
-                ClusterId clusterId = emberAfGetNthClusterId(endpointId, mClusterIndex, true /* server */).Value();
+                ClusterId clusterId = GetServerClusterId(endpointId);
                 if (mAttributeIndex == UINT16_MAX && mGlobalAttributeIndex == UINT8_MAX)
                 {
                     PrepareAttributeIndexRange(mpAttributePath->mValue, endpointId, clusterId);
@@ -220,9 +351,7 @@ bool AttributePathExpandIterator::Next()
 
                 if (mAttributeIndex < mEndAttributeIndex)
                 {
-                    // GetServerAttributeIdByIdex must return a valid attribute here since we have verified the mAttributeIndex does
-                    // not exceed the mEndAttributeIndex.
-                    mOutputPath.mAttributeId = emberAfGetServerAttributeIdByIndex(endpointId, clusterId, mAttributeIndex).Value();
+                    mOutputPath.mAttributeId = GetServerAttributeId(endpointId, clusterId);
                     mOutputPath.mClusterId   = clusterId;
                     mOutputPath.mEndpointId  = endpointId;
                     mAttributeIndex++;
@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <app/AttributePathExpansionCache.h>
 #include <app/AttributePathParams.h>
 #include <app/ConcreteAttributePath.h>
 #include <app/EventManagement.h>
@@ -56,6 +57,10 @@ namespace app {
  * The iterator does not copy the given AttributePathParams, The given AttributePathParams must be valid when using the iterator.
  * If the set of endpoints, clusters, or attributes that are supported changes, AttributePathExpandIterator must be reinitialized.
  *
+ * When CHIP_IM_SERVER_PATH_EXPANSION_CACHE_MAX_ATTRIBUTES is non-zero, wildcards are expanded from the flattened copy of the data
+ * model kept by AttributePathExpansionCache, which is refreshed when the iteration starts and by RefreshExpansionCache(). The
+ * ember metadata is only walked directly if the data model does not fit in that cache.
+ *
  * A initialized iterator will return the first valid path, no need to call Next() before calling Get() for the first time.
  *
  * Note: The Next() and Get() are two separate operations by design since a possible call of this iterator might be:
@@ -97,6 +102,13 @@ public:
      */
     void ResetCurrentCluster();
 
+    /**
+     * Bring the iterator up to date with data model changes made since the iteration started, before resuming an iteration that
+     * was left aside, e.g. for the next chunk of a report. The iteration goes on after the path the iterator currently points
+     * to, which is kept.
+     */
+    void RefreshExpansionCache();
+
     /**
      * Returns if the iterator is valid (not exhausted). An iterator is exhausted if and only if:
      * - Next() is called after iterating last path.
@@ -118,6 +130,13 @@ private:
     // metadata.
     uint8_t mGlobalAttributeIndex, mGlobalAttributeEndIndex;
 
+#if CHIP_IM_SERVER_PATH_EXPANSION_CACHE_MAX_ATTRIBUTES > 0
+    // The expansion cache, if it holds the current data model, updated by RefreshExpansionCache().
+    const AttributePathExpansionCache * mpExpansionCache = nullptr;
+    // The generation of the data model the current index ranges were prepared against.
+    uint32_t mExpansionCacheGeneration = 0;
+#endif
+
     /**
      * Prepare*IndexRange will update mBegin*Index and mEnd*Index variables.
      * If AttributePathParams contains a wildcard field, it will set mBegin*Index to 0 and mEnd*Index to count.
@@ -130,6 +149,21 @@ private:
     void PrepareEndpointIndexRange(const AttributePathParams & aAttributePath);
     void PrepareClusterIndexRange(const AttributePathParams & aAttributePath, EndpointId aEndpointId);
     void PrepareAttributeIndexRange(const AttributePathParams & aAttributePath, EndpointId aEndpointId, ClusterId aClusterId);
+
+#if CHIP_IM_SERVER_PATH_EXPANSION_CACHE_MAX_ATTRIBUTES > 0
+    /**
+     * Recompute the index ranges of the current wildcard path against a data model that changed since they were prepared, so that
+     * the expansion resumes right after mOutputPath, the last path emitted, instead of emitting the paths before it again.
+     */
+    void RelocateAfterOutputPath();
+#endif
+
+    /**
+     * Lookups of the data model by index, served by the expansion cache when it is usable and by the ember metadata otherwise.
+     */
+    bool EndpointIndexIsEnabled(uint16_t aEndpointIndex) const;
+    ClusterId GetServerClusterId(EndpointId aEndpointId) const;
+    AttributeId GetServerAttributeId(EndpointId aEndpointId, ClusterId aClusterId) const;
 };
 } // namespace app
 } // namespace chip
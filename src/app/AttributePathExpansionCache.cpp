@@ -0,0 +1,118 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/AttributePathExpansionCache.h>
+
+#if CHIP_IM_SERVER_PATH_EXPANSION_CACHE_MAX_ATTRIBUTES > 0
+
+#include <lib/core/Optional.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+using namespace chip;
+
+// See AttributePathExpandIterator.cpp, these are re-declared here so we don't depend on the app specific generated files pulled in
+// by af.h.
+extern uint16_t emberAfEndpointCount();
+extern uint8_t emberAfClusterCount(EndpointId endpoint, bool server);
+extern uint16_t emberAfGetServerAttributeCount(chip::EndpointId endpoint, chip::ClusterId cluster);
+extern chip::EndpointId emberAfEndpointFromIndex(uint16_t index);
+extern Optional<ClusterId> emberAfGetNthClusterId(chip::EndpointId endpoint, uint8_t n, bool server);
+extern Optional<AttributeId> emberAfGetServerAttributeIdByIndex(chip::EndpointId endpoint, chip::ClusterId cluster,
+                                                                uint16_t attributeIndex);
+extern bool emberAfEndpointIndexIsEnabled(uint16_t index);
+extern uint32_t emberAfMetadataStructureGeneration();
+
+namespace chip {
+namespace app {
+
+AttributePathExpansionCache & AttributePathExpansionCache::Instance()
+{
+    static AttributePathExpansionCache sInstance;
+    return sInstance;
+}
+
+bool AttributePathExpansionCache::Refresh()
+{
+    uint32_t generation = emberAfMetadataStructureGeneration();
+    if (!mBuilt || generation != mGeneration)
+    {
+        mGeneration = generation;
+        mBuilt      = true;
+        mValid      = Build();
+#if CONFIG_BUILD_FOR_HOST_UNIT_TEST
+        mBuildCount++;
+#endif
+        if (!mValid)
+        {
+            ChipLogDetail(DataManagement, "Data model does not fit in the path expansion cache, expanding from ember metadata");
+        }
+    }
+    return mValid;
+}
+
+bool AttributePathExpansionCache::Build()
+{
+    uint16_t endpointCount = emberAfEndpointCount();
+    uint16_t numClusters   = 0;
+    uint16_t numAttributes = 0;
+
+    mEndpointCount = 0;
+    VerifyOrReturnValue(endpointCount <= kMaxEndpoints, false);
+
+    for (uint16_t endpointIndex = 0; endpointIndex < endpointCount; endpointIndex++)
+    {
+        EndpointEntry & endpoint = mEndpoints[endpointIndex];
+        endpoint                 = EndpointEntry();
+        endpoint.mFirstCluster   = numClusters;
+
+        // Disabled endpoints are skipped by the path expansion, and may not even have a valid endpoint id.
+        endpoint.mEnabled = emberAfEndpointIndexIsEnabled(endpointIndex);
+        if (!endpoint.mEnabled)
+        {
+            continue;
+        }
+
+        EndpointId endpointId  = emberAfEndpointFromIndex(endpointIndex);
+        endpoint.mClusterCount = emberAfClusterCount(endpointId, true /* server */);
+        VerifyOrReturnValue(numClusters + endpoint.mClusterCount <= kMaxClusters, false);
+
+        for (uint8_t clusterIndex = 0; clusterIndex < endpoint.mClusterCount; clusterIndex++)
+        {
+            ClusterEntry & cluster  = mClusters[numClusters++];
+            cluster.mClusterId      = emberAfGetNthClusterId(endpointId, clusterIndex, true /* server */).Value();
+            cluster.mAttributeCount = emberAfGetServerAttributeCount(endpointId, cluster.mClusterId);
+            cluster.mFirstAttribute = numAttributes;
+            VerifyOrReturnValue(numAttributes + cluster.mAttributeCount <= kMaxAttributes, false);
+
+            for (uint16_t attributeIndex = 0; attributeIndex < cluster.mAttributeCount; attributeIndex++)
+            {
+                mAttributeIds[numAttributes++] =
+                    emberAfGetServerAttributeIdByIndex(endpointId, cluster.mClusterId, attributeIndex).Value();
+            }
+        }
+    }
+
+    mEndpointCount = endpointCount;
+    return true;
+}
+
+} // namespace app
+} // namespace chip
+
+#endif // CHIP_IM_SERVER_PATH_EXPANSION_CACHE_MAX_ATTRIBUTES > 0
@@ -0,0 +1,135 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines a flattened, version-stamped copy of the endpoint / cluster / attribute structure of the data model,
+ *      used to expand wildcard attribute paths without walking the ember metadata for every emitted path.
+ *
+ */
+
+#pragma once
+
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/DataModelTypes.h>
+
+#if CHIP_IM_SERVER_PATH_EXPANSION_CACHE_MAX_ATTRIBUTES > 0
+
+namespace chip {
+namespace app {
+
+/**
+ * AttributePathExpansionCache holds, for every endpoint index known to ember, the list of server cluster ids and, for every such
+ * cluster, the list of attribute ids in the metadata.  The lists are laid out in flat arrays so that the id at a given
+ * (endpoint index, cluster index, attribute index) position is a direct lookup, using the same indices as
+ * emberAfEndpointFromIndex, emberAfGetNthClusterId and emberAfGetServerAttributeIdByIndex.
+ *
+ * The cache is stamped with emberAfMetadataStructureGeneration() and is rebuilt by Refresh() whenever endpoints are added, removed,
+ * enabled or disabled.  If the data model does not fit, Refresh() returns false and callers must fall back to querying ember.
+ */
+class AttributePathExpansionCache
+{
+public:
+    static constexpr size_t kMaxEndpoints  = CHIP_IM_SERVER_PATH_EXPANSION_CACHE_MAX_ENDPOINTS;
+    static constexpr size_t kMaxClusters   = CHIP_IM_SERVER_PATH_EXPANSION_CACHE_MAX_CLUSTERS;
+    static constexpr size_t kMaxAttributes = CHIP_IM_SERVER_PATH_EXPANSION_CACHE_MAX_ATTRIBUTES;
+
+    static AttributePathExpansionCache & Instance();
+
+    /**
+     * Rebuild the cache if the ember metadata structure changed since it was last built.
+     *
+     * @retval true if the cache holds the current data model, and the accessors below can be used.
+     */
+    bool Refresh();
+
+    /**
+     * Force the cache to be rebuilt on the next call to Refresh().
+     */
+    void Invalidate() { mBuilt = false; }
+
+    /**
+     * The emberAfMetadataStructureGeneration() value the cache was last built for.
+     */
+    uint32_t GetGeneration() const { return mGeneration; }
+
+    uint16_t GetEndpointCount() const { return mEndpointCount; }
+    bool IsEndpointEnabled(uint16_t aEndpointIndex) const { return mEndpoints[aEndpointIndex].mEnabled; }
+    uint8_t GetClusterCount(uint16_t aEndpointIndex) const { return mEndpoints[aEndpointIndex].mClusterCount; }
+
+    ClusterId GetClusterId(uint16_t aEndpointIndex, uint8_t aClusterIndex) const
+    {
+        return GetCluster(aEndpointIndex, aClusterIndex).mClusterId;
+    }
+
+    uint16_t GetAttributeCount(uint16_t aEndpointIndex, uint8_t aClusterIndex) const
+    {
+        return GetCluster(aEndpointIndex, aClusterIndex).mAttributeCount;
+    }
+
+    AttributeId GetAttributeId(uint16_t aEndpointIndex, uint8_t aClusterIndex, uint16_t aAttributeIndex) const
+    {
+        return mAttributeIds[GetCluster(aEndpointIndex, aClusterIndex).mFirstAttribute + aAttributeIndex];
+    }
+
+#if CONFIG_BUILD_FOR_HOST_UNIT_TEST
+    uint32_t GetBuildCount() const { return mBuildCount; }
+#endif
+
+private:
+    struct EndpointEntry
+    {
+        bool mEnabled          = false;
+        uint8_t mClusterCount  = 0;
+        uint16_t mFirstCluster = 0;
+    };
+
+    struct ClusterEntry
+    {
+        ClusterId mClusterId     = kInvalidClusterId;
+        uint16_t mAttributeCount = 0;
+        uint16_t mFirstAttribute = 0;
+    };
+
+    static_assert(kMaxClusters <= UINT16_MAX && kMaxAttributes <= UINT16_MAX, "Cache entries are indexed with 16-bit values");
+
+    const ClusterEntry & GetCluster(uint16_t aEndpointIndex, uint8_t aClusterIndex) const
+    {
+        return mClusters[mEndpoints[aEndpointIndex].mFirstCluster + aClusterIndex];
+    }
+
+    bool Build();
+
+    EndpointEntry mEndpoints[kMaxEndpoints];
+    ClusterEntry mClusters[kMaxClusters];
+    AttributeId mAttributeIds[kMaxAttributes];
+    uint16_t mEndpointCount = 0;
+
+    uint32_t mGeneration = 0;
+    bool mBuilt          = false;
+    bool mValid          = false;
+
+#if CONFIG_BUILD_FOR_HOST_UNIT_TEST
+    uint32_t mBuildCount = 0;
+#endif
+};
+
+} // namespace app
+} // namespace chip
+
+#endif // CHIP_IM_SERVER_PATH_EXPANSION_CACHE_MAX_ATTRIBUTES > 0
@@ -0,0 +1,54 @@
+/*
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/AttributePersistenceProvider.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+namespace chip {
+namespace app {
+
+CHIP_ERROR AttributePersistenceProvider::ReadValues(EndpointId aEndpointId, ClusterId aClusterId,
+                                                  Span<const EmberAfAttributeMetadata> aAttributes, MutableByteSpan aBuffer,
+                                                  ValueHandler & aHandler)
+{
+    for (const EmberAfAttributeMetadata & metadata : aAttributes)
+    {
+        if (!metadata.IsAutomaticallyPersisted())
+        {
+            continue;
+        }
+
+        ConcreteAttributePath path(aEndpointId, aClusterId, metadata.attributeId);
+        MutableByteSpan value = aBuffer;
+        CHIP_ERROR err        = ReadValue(path, &metadata, value);
+        if (err == CHIP_NO_ERROR)
+        {
+            aHandler.OnValueRead(path, &metadata, value);
+        }
+        else if (err != CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND)
+        {
+            // Values never written are expected, other failures are worth noting.
+            ChipLogDetail(DataManagement,
+                          "Failed to read stored attribute (%u, " ChipLogFormatMEI ", " ChipLogFormatMEI "): %" CHIP_ERROR_FORMAT,
+                          aEndpointId, ChipLogValueMEI(aClusterId), ChipLogValueMEI(metadata.attributeId), err.Format());
+        }
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+} // namespace app
+} // namespace chip
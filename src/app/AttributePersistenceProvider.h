@@ -67,6 +67,50 @@ public:
      */
     virtual CHIP_ERROR ReadValue(const ConcreteAttributePath & aPath, const EmberAfAttributeMetadata * aMetadata,
                                  MutableByteSpan & aValue) = 0;
+
+    /**
+     * Receives the attribute values read by ReadValues.
+     */
+    class ValueHandler
+    {
+    public:
+        virtual ~ValueHandler() = default;
+
+        /**
+         * Called for each attribute that has a persisted value.
+         *
+         * @param [in] aPath the attribute path.
+         * @param [in] aMetadata the attribute metadata.
+         * @param [in] aValue the persisted value, in the representation
+         *             described in the ReadValue documentation.  Only valid
+         *             for the duration of the call.
+         */
+        virtual void OnValueRead(const ConcreteAttributePath & aPath, const EmberAfAttributeMetadata * aMetadata,
+                                 const ByteSpan & aValue) = 0;
+    };
+
+    /**
+     * Read the persisted values of the automatically persisted attributes of
+     * a cluster instance in one pass, as when loading the attribute store at
+     * startup.
+     *
+     * Attributes that have no persisted value, or whose persisted value cannot
+     * be read, are skipped, and are expected to keep their default value.
+     *
+     * The default implementation calls ReadValue for each attribute.
+     * Providers whose storage can retrieve several values at once should
+     * override it.
+     *
+     * @param [in] aEndpointId the endpoint of the cluster instance.
+     * @param [in] aClusterId the cluster of the cluster instance.
+     * @param [in] aAttributes the metadata of the attributes of the cluster;
+     *             attributes not automatically persisted are ignored.
+     * @param [in] aBuffer scratch space to read values into, no smaller than
+     *             the `size` member of the metadata of any of the attributes.
+     * @param [in] aHandler the handler of the values read.
+     */
+    virtual CHIP_ERROR ReadValues(EndpointId aEndpointId, ClusterId aClusterId, Span<const EmberAfAttributeMetadata> aAttributes,
+                                  MutableByteSpan aBuffer, ValueHandler & aHandler);
 };
 
 /**
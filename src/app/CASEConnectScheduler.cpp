@@ -0,0 +1,294 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/CASEConnectScheduler.h>
+
+#include <crypto/RandUtils.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+namespace chip {
+
+CASEConnectScheduler::Slot::Slot() : onConnected(HandleConnected, this), onFailure(HandleConnectionFailure, this) {}
+
+CASEConnectScheduler::CASEConnectScheduler()
+{
+    for (auto & slot : mSlots)
+    {
+        slot.scheduler = this;
+    }
+}
+
+CHIP_ERROR CASEConnectScheduler::Init(System::Layer * systemLayer, CASESessionEstablisher * establisher,
+                                      const CASEConnectSchedulerConfig & config)
+{
+    VerifyOrReturnError(systemLayer != nullptr && establisher != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(config.maxConcurrency > 0 && config.maxConcurrency <= kMaxConcurrency, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(mRequests.Empty(), CHIP_ERROR_INCORRECT_STATE);
+
+    mSystemLayer   = systemLayer;
+    mEstablisher   = establisher;
+    mConfig        = config;
+    mNextStartTime = System::Clock::kZero;
+    return CHIP_NO_ERROR;
+}
+
+void CASEConnectScheduler::Shutdown()
+{
+    while (!mRequests.Empty())
+    {
+        Cancel(*mRequests.begin());
+    }
+
+    if (mSystemLayer != nullptr)
+    {
+        mSystemLayer->CancelTimer(HandlePacingTimer, this);
+    }
+    mSystemLayer = nullptr;
+    mEstablisher = nullptr;
+}
+
+CHIP_ERROR CASEConnectScheduler::Start(BulkConnectRequest & request)
+{
+    VerifyOrReturnError(mEstablisher != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(!request.IsInList(), CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(!request.mPeers.empty(), CHIP_ERROR_INVALID_ARGUMENT);
+
+    request.mStats    = BulkConnectStats();
+    request.mNextPeer = 0;
+    request.mInFlight = 0;
+    mRequests.PushBack(&request);
+
+    ChipLogProgress(CASESessionManager, "Scheduling CASE establishment with %u peers (priority %u)",
+                    static_cast<unsigned>(request.mPeers.size()), static_cast<unsigned>(request.mPriority));
+
+    ScheduleNext();
+    return CHIP_NO_ERROR;
+}
+
+void CASEConnectScheduler::Cancel(BulkConnectRequest & request)
+{
+    VerifyOrReturn(request.IsInList());
+
+    for (auto & slot : mSlots)
+    {
+        if (slot.request == &request)
+        {
+            slot.onConnected.Cancel();
+            slot.onFailure.Cancel();
+            ReleaseSlot(slot);
+            request.mStats.cancelled++;
+        }
+    }
+
+    request.mStats.cancelled += static_cast<uint32_t>(request.mPeers.size() - request.mNextPeer);
+    request.mNextPeer = request.mPeers.size();
+    mRequests.Remove(&request);
+
+    // Freed slots may be used by other requests
+    ScheduleNext();
+}
+
+size_t CASEConnectScheduler::GetInFlightCount() const
+{
+    size_t count = 0;
+    for (const auto & slot : mSlots)
+    {
+        if (slot.request != nullptr && !slot.waitingForRetry)
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+BulkConnectRequest * CASEConnectScheduler::NextPendingRequest()
+{
+    BulkConnectRequest * next = nullptr;
+    for (auto & request : mRequests)
+    {
+        if (request.HasPendingPeers() && (next == nullptr || request.mPriority < next->mPriority))
+        {
+            next = &request;
+        }
+    }
+    return next;
+}
+
+CASEConnectScheduler::Slot * CASEConnectScheduler::NextSlotToStart()
+{
+    // Establishments that could not get a session setup are retried before starting new ones
+    for (size_t i = 0; i < mConfig.maxConcurrency; i++)
+    {
+        if (mSlots[i].waitingForRetry)
+        {
+            return &mSlots[i];
+        }
+    }
+
+    VerifyOrReturnValue(NextPendingRequest() != nullptr, nullptr);
+
+    for (size_t i = 0; i < mConfig.maxConcurrency; i++)
+    {
+        if (mSlots[i].request == nullptr)
+        {
+            return &mSlots[i];
+        }
+    }
+
+    return nullptr;
+}
+
+System::Clock::Milliseconds32 CASEConnectScheduler::NextPacingDelay() const
+{
+    System::Clock::Milliseconds32 delay = mConfig.pacingInterval;
+    if (mConfig.pacingJitter.count() > 0)
+    {
+        delay += System::Clock::Milliseconds32(Crypto::GetRandU32() % (mConfig.pacingJitter.count() + 1));
+    }
+    return delay;
+}
+
+void CASEConnectScheduler::ScheduleNext()
+{
+    VerifyOrReturn(mSystemLayer != nullptr);
+
+    mSystemLayer->CancelTimer(HandlePacingTimer, this);
+    VerifyOrReturn(NextSlotToStart() != nullptr);
+
+    const System::Clock::Timestamp now = System::SystemClock().GetMonotonicTimestamp();
+    const System::Clock::Timeout delay = (mNextStartTime > now) ? (mNextStartTime - now) : System::Clock::kZero;
+
+    CHIP_ERROR err = mSystemLayer->StartTimer(delay, HandlePacingTimer, this);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(CASESessionManager, "Failed to schedule CASE establishment: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+}
+
+void CASEConnectScheduler::HandlePacingTimer(System::Layer * systemLayer, void * context)
+{
+    static_cast<CASEConnectScheduler *>(context)->StartNext();
+}
+
+void CASEConnectScheduler::StartNext()
+{
+    Slot * slot = NextSlotToStart();
+    VerifyOrReturn(slot != nullptr);
+
+    if (slot->waitingForRetry)
+    {
+        slot->waitingForRetry = false;
+    }
+    else
+    {
+        BulkConnectRequest * request = NextPendingRequest();
+        slot->request                = request;
+        slot->peerId                 = request->mPeers.data()[request->mNextPeer++];
+        slot->retries                = 0;
+        request->mInFlight++;
+    }
+
+    slot->startTime = System::SystemClock().GetMonotonicTimestamp();
+    mNextStartTime  = slot->startTime + NextPacingDelay();
+
+    // Callbacks may be called before this returns and update the schedule
+    mEstablisher->FindOrEstablishSession(slot->peerId, &slot->onConnected, &slot->onFailure);
+
+    ScheduleNext();
+}
+
+void CASEConnectScheduler::ReleaseSlot(Slot & slot)
+{
+    slot.request->mInFlight--;
+    slot.request         = nullptr;
+    slot.retries         = 0;
+    slot.waitingForRetry = false;
+}
+
+void CASEConnectScheduler::CompleteIfDone(BulkConnectRequest & request)
+{
+    VerifyOrReturn(request.IsInList() && request.IsDone());
+
+    mRequests.Remove(&request);
+
+    const BulkConnectStats & stats = request.mStats;
+    ChipLogProgress(CASESessionManager,
+                    "CASE establishment with %u peers done: %u succeeded, %u failed, %u retried, latency min/avg/max %u/%u/%u ms",
+                    static_cast<unsigned>(request.mPeers.size()), static_cast<unsigned>(stats.succeeded),
+                    static_cast<unsigned>(stats.failed), static_cast<unsigned>(stats.retried),
+                    static_cast<unsigned>(stats.minLatency.count()), static_cast<unsigned>(stats.GetAverageLatency().count()),
+                    static_cast<unsigned>(stats.maxLatency.count()));
+
+    request.mCallback.OnBulkConnectDone(request);
+}
+
+void CASEConnectScheduler::HandleConnected(void * context, Messaging::ExchangeManager & exchangeMgr,
+                                           const SessionHandle & sessionHandle)
+{
+    Slot & slot                        = *static_cast<Slot *>(context);
+    CASEConnectScheduler * self        = slot.scheduler;
+    BulkConnectRequest & request       = *slot.request;
+    const ScopedNodeId peerId          = slot.peerId;
+    const System::Clock::Timestamp now = System::SystemClock().GetMonotonicTimestamp();
+    const auto latency                 = std::chrono::duration_cast<System::Clock::Milliseconds32>(now - slot.startTime);
+
+    BulkConnectStats & stats = request.mStats;
+    stats.minLatency         = (stats.succeeded == 0 || latency < stats.minLatency) ? latency : stats.minLatency;
+    stats.maxLatency         = (latency > stats.maxLatency) ? latency : stats.maxLatency;
+    stats.totalLatency += latency;
+    stats.succeeded++;
+
+    self->ReleaseSlot(slot);
+    request.mCallback.OnPeerConnected(request, peerId, exchangeMgr, sessionHandle);
+    self->CompleteIfDone(request);
+    self->ScheduleNext();
+}
+
+void CASEConnectScheduler::HandleConnectionFailure(void * context, const ScopedNodeId & peerId, CHIP_ERROR error)
+{
+    Slot & slot                  = *static_cast<Slot *>(context);
+    CASEConnectScheduler * self  = slot.scheduler;
+    BulkConnectRequest & request = *slot.request;
+
+    if (error == CHIP_ERROR_NO_MEMORY && slot.retries < self->mConfig.maxRetries)
+    {
+        // Session setups are exhausted: pause all establishments, backing off exponentially,
+        // rather than failing every pending peer in a burst.
+        slot.retries++;
+        slot.waitingForRetry = true;
+        request.mStats.retried++;
+
+        const System::Clock::Milliseconds32 backoff(self->NextPacingDelay().count() << slot.retries);
+        self->mNextStartTime = System::SystemClock().GetMonotonicTimestamp() + backoff;
+
+        ChipLogProgress(CASESessionManager, "No session setup available for [%u:" ChipLogFormatX64 "], retrying in %u ms",
+                        peerId.GetFabricIndex(), ChipLogValueX64(peerId.GetNodeId()), static_cast<unsigned>(backoff.count()));
+        self->ScheduleNext();
+        return;
+    }
+
+    request.mStats.failed++;
+
+    self->ReleaseSlot(slot);
+    request.mCallback.OnPeerConnectionFailure(request, peerId, error);
+    self->CompleteIfDone(request);
+    self->ScheduleNext();
+}
+
+} // namespace chip
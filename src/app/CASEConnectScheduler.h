@@ -0,0 +1,206 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/OperationalSessionSetup.h>
+#include <lib/core/CHIPCallback.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/ScopedNodeId.h>
+#include <lib/support/IntrusiveList.h>
+#include <lib/support/Span.h>
+#include <system/SystemClock.h>
+#include <system/SystemLayer.h>
+
+namespace chip {
+
+/**
+ * Finds or establishes a CASE session with a single peer.
+ *
+ * Implemented by CASESessionManager; the callback semantics are those of
+ * CASESessionManager::FindOrEstablishSession.
+ */
+class CASESessionEstablisher
+{
+public:
+    virtual ~CASESessionEstablisher() = default;
+
+    virtual void FindOrEstablishSession(const ScopedNodeId & peerId, Callback::Callback<OnDeviceConnected> * onConnection,
+                                        Callback::Callback<OnDeviceConnectionFailure> * onFailure) = 0;
+};
+
+/**
+ * Priority class of a bulk connect request. Pending establishments of a higher
+ * priority request are always started before those of a lower priority one;
+ * requests of the same priority are served in the order they were started.
+ */
+enum class BulkConnectPriority : uint8_t
+{
+    kHigh   = 0,
+    kNormal = 1,
+    kLow    = 2,
+};
+
+struct BulkConnectStats
+{
+    uint32_t succeeded = 0;
+    uint32_t failed    = 0;
+    uint32_t cancelled = 0;
+    uint32_t retried   = 0; // attempts repeated because no session setup could be allocated
+
+    // Time from the (last) start of an establishment to its success.
+    System::Clock::Milliseconds32 minLatency   = System::Clock::kZero;
+    System::Clock::Milliseconds32 maxLatency   = System::Clock::kZero;
+    System::Clock::Milliseconds64 totalLatency = System::Clock::kZero;
+
+    System::Clock::Milliseconds32 GetAverageLatency() const
+    {
+        return succeeded == 0 ? System::Clock::kZero : System::Clock::Milliseconds32(totalLatency.count() / succeeded);
+    }
+};
+
+/**
+ * A set of peers to connect to, scheduled by a CASEConnectScheduler.
+ *
+ * The request and the peer list are owned by the caller and must outlive the
+ * request: until OnBulkConnectDone is called or the request is cancelled.
+ */
+class BulkConnectRequest : public IntrusiveListNodeBase<>
+{
+public:
+    class Callback
+    {
+    public:
+        virtual ~Callback() = default;
+
+        virtual void OnPeerConnected(BulkConnectRequest & request, const ScopedNodeId & peerId,
+                                     Messaging::ExchangeManager & exchangeMgr, const SessionHandle & sessionHandle)
+        {}
+        virtual void OnPeerConnectionFailure(BulkConnectRequest & request, const ScopedNodeId & peerId, CHIP_ERROR error) {}
+
+        /// Called once every peer of the request either connected or failed. Not called on cancellation.
+        virtual void OnBulkConnectDone(BulkConnectRequest & request) = 0;
+    };
+
+    BulkConnectRequest(Span<const ScopedNodeId> peers, Callback & callback,
+                       BulkConnectPriority priority = BulkConnectPriority::kNormal) :
+        mPeers(peers),
+        mCallback(callback), mPriority(priority)
+    {}
+
+    BulkConnectPriority GetPriority() const { return mPriority; }
+    Span<const ScopedNodeId> GetPeers() const { return mPeers; }
+    const BulkConnectStats & GetStats() const { return mStats; }
+
+    bool IsActive() const { return IsInList(); }
+
+private:
+    friend class CASEConnectScheduler;
+
+    bool HasPendingPeers() const { return mNextPeer < mPeers.size(); }
+    bool IsDone() const { return !HasPendingPeers() && mInFlight == 0; }
+
+    Span<const ScopedNodeId> mPeers;
+    Callback & mCallback;
+    BulkConnectPriority mPriority;
+    BulkConnectStats mStats;
+    size_t mNextPeer = 0; // index of the next peer to connect to
+    size_t mInFlight = 0; // establishments currently started for this request
+};
+
+struct CASEConnectSchedulerConfig
+{
+    /// Maximum number of session establishments in progress at once, at most CASEConnectScheduler::kMaxConcurrency
+    uint8_t maxConcurrency = CHIP_CONFIG_CASE_CONNECT_MAX_CONCURRENCY;
+    /// Number of times an establishment is retried when no session setup could be allocated
+    uint8_t maxRetries = CHIP_CONFIG_CASE_CONNECT_MAX_RETRIES;
+    /// Minimum delay between the starts of two establishments
+    System::Clock::Milliseconds32 pacingInterval = System::Clock::Milliseconds32(CHIP_CONFIG_CASE_CONNECT_PACING_INTERVAL_MS);
+    /// Random delay in [0, pacingJitter] added to pacingInterval, spreading Sigma1 messages over time
+    System::Clock::Milliseconds32 pacingJitter = System::Clock::Milliseconds32(CHIP_CONFIG_CASE_CONNECT_PACING_JITTER_MS);
+};
+
+/**
+ * Admission control for CASE session establishment.
+ *
+ * Connects to the peers of BulkConnectRequests through a CASESessionEstablisher while
+ * bounding the number of establishments in progress, pacing their starts with a
+ * jittered delay and backing off when session setups cannot be allocated.
+ */
+class CASEConnectScheduler
+{
+public:
+    static constexpr size_t kMaxConcurrency = CHIP_CONFIG_CASE_CONNECT_MAX_CONCURRENCY;
+
+    CASEConnectScheduler();
+    ~CASEConnectScheduler() { Shutdown(); }
+
+    CHIP_ERROR Init(System::Layer * systemLayer, CASESessionEstablisher * establisher,
+                    const CASEConnectSchedulerConfig & config = CASEConnectSchedulerConfig());
+
+    /// Cancels every active request.
+    void Shutdown();
+
+    /// Schedules the establishment of a session with every peer of `request`.
+    CHIP_ERROR Start(BulkConnectRequest & request);
+
+    /**
+     * Stops scheduling `request`. Establishments in progress keep running but are no
+     * longer reported, and are counted as cancelled along with the pending ones.
+     */
+    void Cancel(BulkConnectRequest & request);
+
+    size_t GetInFlightCount() const;
+
+private:
+    struct Slot
+    {
+        Slot();
+
+        CASEConnectScheduler * scheduler = nullptr;
+        BulkConnectRequest * request     = nullptr;
+        ScopedNodeId peerId;
+        System::Clock::Timestamp startTime = System::Clock::kZero;
+        uint8_t retries                    = 0;
+        bool waitingForRetry               = false;
+
+        Callback::Callback<OnDeviceConnected> onConnected;
+        Callback::Callback<OnDeviceConnectionFailure> onFailure;
+    };
+
+    static void HandleConnected(void * context, Messaging::ExchangeManager & exchangeMgr, const SessionHandle & sessionHandle);
+    static void HandleConnectionFailure(void * context, const ScopedNodeId & peerId, CHIP_ERROR error);
+    static void HandlePacingTimer(System::Layer * systemLayer, void * context);
+
+    BulkConnectRequest * NextPendingRequest();
+    Slot * NextSlotToStart();
+    System::Clock::Milliseconds32 NextPacingDelay() const;
+    void StartNext();
+    void ScheduleNext();
+    void ReleaseSlot(Slot & slot);
+    void CompleteIfDone(BulkConnectRequest & request);
+
+    System::Layer * mSystemLayer          = nullptr;
+    CASESessionEstablisher * mEstablisher = nullptr;
+    CASEConnectSchedulerConfig mConfig;
+    IntrusiveList<BulkConnectRequest> mRequests;
+    Slot mSlots[kMaxConcurrency];
+    System::Clock::Timestamp mNextStartTime = System::Clock::kZero; // no establishment is started before that time
+};
+
+} // namespace chip
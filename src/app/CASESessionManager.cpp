@@ -24,6 +24,7 @@ namespace chip {
 CHIP_ERROR CASESessionManager::Init(chip::System::Layer * systemLayer, const CASESessionManagerConfig & params)
 {
     ReturnErrorOnFailure(params.sessionInitParams.Validate());
+    ReturnErrorOnFailure(mConnectScheduler.Init(systemLayer, this, params.connectScheduler));
     mConfig = params;
     params.sessionInitParams.exchangeMgr->GetReliableMessageMgr()->RegisterSessionUpdateDelegate(this);
     return AddressResolve::Resolver::Instance().Init(systemLayer);
@@ -19,6 +19,7 @@
 #pragma once
 
 #include <app/CASEClientPool.h>
+#include <app/CASEConnectScheduler.h>
 #include <app/OperationalSessionSetup.h>
 #include <app/OperationalSessionSetupPool.h>
 #include <lib/core/CHIPConfig.h>
@@ -39,6 +40,7 @@ struct CASESessionManagerConfig
     CASEClientInitParams sessionInitParams;
     CASEClientPoolDelegate * clientPool                    = nullptr;
     OperationalSessionSetupPoolDelegate * sessionSetupPool = nullptr;
+    CASEConnectSchedulerConfig connectScheduler;
 };
 
 /**
@@ -48,8 +50,9 @@ struct CASESessionManagerConfig
  * 3. API to lookup an existing proxy object, or allocate a new one by triggering session establishment with the peer node.
  * 4. During session establishment, trigger node ID resolution (if needed), and update the DNS-SD cache (if resolution is
  * successful)
+ * 5. API to connect to many peer nodes at once, with admission control of the session establishments.
  */
-class CASESessionManager : public OperationalSessionReleaseDelegate, public SessionUpdateDelegate
+class CASESessionManager : public OperationalSessionReleaseDelegate, public SessionUpdateDelegate, public CASESessionEstablisher
 {
 public:
     CASESessionManager() = default;
@@ -62,7 +65,7 @@ public:
     }
 
     CHIP_ERROR Init(chip::System::Layer * systemLayer, const CASESessionManagerConfig & params);
-    void Shutdown() {}
+    void Shutdown() { mConnectScheduler.Shutdown(); }
 
     /**
      * Find an existing session for the given node ID, or trigger a new session
@@ -79,7 +82,25 @@ public:
      * call returns, for error cases that are detected synchronously.
      */
     void FindOrEstablishSession(const ScopedNodeId & peerId, Callback::Callback<OnDeviceConnected> * onConnection,
-                                Callback::Callback<OnDeviceConnectionFailure> * onFailure);
+                                Callback::Callback<OnDeviceConnectionFailure> * onFailure) override;
+
+    /**
+     * Find or establish sessions with every peer of `request`.
+     *
+     * Establishments are scheduled according to the `connectScheduler` configuration: at most
+     * `maxConcurrency` of them are in progress at once, their starts are paced with a jittered
+     * delay, and higher priority requests are served first. The callback of the request is told
+     * about each peer, then about the completion of the request along with its statistics.
+     *
+     * All requests are cancelled when the CASESessionManager is shut down.
+     */
+    CHIP_ERROR BulkConnect(BulkConnectRequest & request) { return mConnectScheduler.Start(request); }
+
+    /**
+     * Stop establishing sessions for `request`. Its remaining peers are reported as cancelled
+     * in its statistics, and its callback is no longer called.
+     */
+    void CancelBulkConnect(BulkConnectRequest & request) { mConnectScheduler.Cancel(request); }
 
     void ReleaseSessionsForFabric(FabricIndex fabricIndex);
 
@@ -107,6 +128,7 @@ private:
     Optional<SessionHandle> FindExistingSession(const ScopedNodeId & peerId) const;
 
     CASESessionManagerConfig mConfig;
+    CASEConnectScheduler mConnectScheduler;
 };
 
 } // namespace chip
@@ -0,0 +1,274 @@
+/*
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <app/CoalescingAttributePersistenceProvider.h>
+
+#include <lib/support/logging/CHIPLogging.h>
+#include <platform/CHIPDeviceLayer.h>
+
+#include <string.h>
+
+namespace chip {
+namespace app {
+
+namespace {
+
+// Passes the values read by the decorated persister, except those of attributes with a
+// pending value, which are newer and reported separately.
+class PendingValueFilter : public AttributePersistenceProvider::ValueHandler
+{
+public:
+    PendingValueFilter(AttributePersistenceProvider::ValueHandler & handler,
+                       const Span<CoalescingAttributePersistenceProvider::Entry> & entries) :
+        mHandler(handler),
+        mEntries(entries)
+    {}
+
+    void OnValueRead(const ConcreteAttributePath & aPath, const EmberAfAttributeMetadata * aMetadata,
+                     const ByteSpan & aValue) override;
+
+private:
+    AttributePersistenceProvider::ValueHandler & mHandler;
+    const Span<CoalescingAttributePersistenceProvider::Entry> mEntries;
+};
+
+} // namespace
+
+CHIP_ERROR CoalescingAttributePersistenceProvider::WriteValue(const ConcreteAttributePath & path, const ByteSpan & value)
+{
+    mMetrics.writesRequested++;
+
+    Entry * entry = FindPending(path);
+
+    if (value.size() > kMaxValueSize)
+    {
+        // Too large to be held, the pending value is stale anyway.
+        if (entry != nullptr)
+        {
+            entry->mPending = false;
+            mPendingCount--;
+            mMetrics.writesCoalesced++;
+        }
+        mMetrics.writesPersisted++;
+        return mPersister.WriteValue(path, value);
+    }
+
+    if (entry != nullptr)
+    {
+        // Keep the flush time of the first write, so that the value is not held longer than the write delay.
+        mMetrics.writesCoalesced++;
+    }
+    else
+    {
+        entry             = AllocateEntry();
+        entry->mPath      = path;
+        entry->mFlushTime = System::SystemClock().GetMonotonicTimestamp() + mWriteDelay;
+        entry->mPending   = true;
+
+        if (mPendingCount++ == 0)
+        {
+            // Other entries are due earlier, the timer is already armed for them otherwise.
+            DeviceLayer::SystemLayer().StartTimer(mWriteDelay, OnFlushTimer, this);
+        }
+    }
+
+    memcpy(entry->mValue, value.data(), value.size());
+    entry->mSize = static_cast<uint16_t>(value.size());
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CoalescingAttributePersistenceProvider::ReadValue(const ConcreteAttributePath & path,
+                                                             const EmberAfAttributeMetadata * metadata, MutableByteSpan & value)
+{
+    const Entry * entry = FindPending(path);
+
+    if (entry == nullptr)
+    {
+        return mPersister.ReadValue(path, metadata, value);
+    }
+
+    return CopySpanToMutableSpan(ByteSpan(entry->mValue, entry->mSize), value);
+}
+
+CHIP_ERROR CoalescingAttributePersistenceProvider::ReadValues(EndpointId endpointId, ClusterId clusterId,
+                                                              Span<const EmberAfAttributeMetadata> attributes,
+                                                              MutableByteSpan buffer, ValueHandler & handler)
+{
+    if (mPendingCount == 0)
+    {
+        return mPersister.ReadValues(endpointId, clusterId, attributes, buffer, handler);
+    }
+
+    PendingValueFilter filter(handler, mEntries);
+    ReturnErrorOnFailure(mPersister.ReadValues(endpointId, clusterId, attributes, buffer, filter));
+
+    for (const EmberAfAttributeMetadata & metadata : attributes)
+    {
+        if (!metadata.IsAutomaticallyPersisted())
+        {
+            continue;
+        }
+
+        const Entry * entry = FindPending(ConcreteAttributePath(endpointId, clusterId, metadata.attributeId));
+        if (entry != nullptr)
+        {
+            handler.OnValueRead(entry->mPath, &metadata, ByteSpan(entry->mValue, entry->mSize));
+        }
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+void CoalescingAttributePersistenceProvider::Flush()
+{
+    DeviceLayer::SystemLayer().CancelTimer(OnFlushTimer, this);
+
+    for (Entry & entry : mEntries)
+    {
+        if (entry.mPending)
+        {
+            FlushEntry(entry);
+        }
+    }
+}
+
+void CoalescingAttributePersistenceProvider::Discard()
+{
+    DeviceLayer::SystemLayer().CancelTimer(OnFlushTimer, this);
+
+    for (Entry & entry : mEntries)
+    {
+        entry.mPending = false;
+    }
+    mPendingCount = 0;
+}
+
+void CoalescingAttributePersistenceProvider::OnFlushTimer(System::Layer * layer, void * me)
+{
+    static_cast<CoalescingAttributePersistenceProvider *>(me)->FlushDueAndScheduleNext();
+}
+
+CoalescingAttributePersistenceProvider::Entry *
+CoalescingAttributePersistenceProvider::FindPending(const ConcreteAttributePath & path)
+{
+    if (mPendingCount == 0)
+    {
+        return nullptr;
+    }
+
+    for (Entry & entry : mEntries)
+    {
+        if (entry.Matches(path))
+        {
+            return &entry;
+        }
+    }
+
+    return nullptr;
+}
+
+CoalescingAttributePersistenceProvider::Entry * CoalescingAttributePersistenceProvider::AllocateEntry()
+{
+    Entry * oldest = nullptr;
+
+    for (Entry & entry : mEntries)
+    {
+        if (!entry.mPending)
+        {
+            return &entry;
+        }
+
+        if (oldest == nullptr || entry.mFlushTime < oldest->mFlushTime)
+        {
+            oldest = &entry;
+        }
+    }
+
+    // The table is full, make room by writing the value that would have been written first.
+    // The timer armed for it finds nothing due and is armed again for the next entry.
+    FlushEntry(*oldest);
+    mMetrics.evictions++;
+    return oldest;
+}
+
+void CoalescingAttributePersistenceProvider::FlushEntry(Entry & entry)
+{
+    CHIP_ERROR err = mPersister.WriteValue(entry.mPath, ByteSpan(entry.mValue, entry.mSize));
+
+    if (err != CHIP_NO_ERROR)
+    {
+        // Retrying would hold the entry for good if the storage is full, the value is lost.
+        ChipLogError(DataManagement,
+                     "Failed to write attribute (%u, " ChipLogFormatMEI ", " ChipLogFormatMEI "): %" CHIP_ERROR_FORMAT,
+                     entry.mPath.mEndpointId, ChipLogValueMEI(entry.mPath.mClusterId), ChipLogValueMEI(entry.mPath.mAttributeId),
+                     err.Format());
+    }
+
+    entry.mPending = false;
+    mPendingCount--;
+    mMetrics.writesPersisted++;
+}
+
+void CoalescingAttributePersistenceProvider::FlushDueAndScheduleNext()
+{
+    const System::Clock::Timestamp now = System::SystemClock().GetMonotonicTimestamp();
+    // Values due shortly are written along with the due ones, so that values of attributes
+    // changed at about the same time are written in a single wake-up.
+    const System::Clock::Timestamp flushTime = now + mWriteDelay / 4;
+    System::Clock::Timestamp nextFlushTime   = System::Clock::Timestamp::max();
+
+    for (Entry & entry : mEntries)
+    {
+        if (!entry.mPending)
+        {
+            continue;
+        }
+
+        if (entry.mFlushTime <= flushTime)
+        {
+            FlushEntry(entry);
+        }
+        else
+        {
+            nextFlushTime = chip::min(nextFlushTime, entry.mFlushTime);
+        }
+    }
+
+    if (nextFlushTime != System::Clock::Timestamp::max())
+    {
+        DeviceLayer::SystemLayer().StartTimer(nextFlushTime - now, OnFlushTimer, this);
+    }
+}
+
+namespace {
+
+void PendingValueFilter::OnValueRead(const ConcreteAttributePath & aPath, const EmberAfAttributeMetadata * aMetadata,
+                                     const ByteSpan & aValue)
+{
+    for (const CoalescingAttributePersistenceProvider::Entry & entry : mEntries)
+    {
+        if (entry.Matches(aPath))
+        {
+            return;
+        }
+    }
+
+    mHandler.OnValueRead(aPath, aMetadata, aValue);
+}
+
+} // namespace
+
+} // namespace app
+} // namespace chip
@@ -0,0 +1,114 @@
+/*
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <app/AttributePersistenceProvider.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/support/Span.h>
+#include <system/SystemClock.h>
+
+namespace chip {
+namespace app {
+
+/**
+ * Decorator class for the AttributePersistenceProvider implementation that
+ * coalesces writes of all attributes.
+ *
+ * Unlike DeferredAttributePersistenceProvider, the attributes do not need to
+ * be known in advance: the values written are held in a bounded table of
+ * entries provided by the caller, and written to the decorated persister once
+ * the write delay has elapsed since the first write that made them pending.
+ * Further writes of a pending attribute only update the held value, so the
+ * pending value is never older than the write delay.
+ *
+ * When the table is full, the oldest pending value is written to make room.
+ * Values larger than an entry are written immediately.
+ */
+class CoalescingAttributePersistenceProvider : public AttributePersistenceProvider
+{
+public:
+    static constexpr size_t kMaxValueSize = CHIP_CONFIG_ATTRIBUTE_WRITE_COALESCING_MAX_VALUE_SIZE;
+
+    class Entry
+    {
+    public:
+        bool IsPending() const { return mPending; }
+        bool Matches(const ConcreteAttributePath & path) const { return mPending && mPath == path; }
+
+    private:
+        friend class CoalescingAttributePersistenceProvider;
+
+        ConcreteAttributePath mPath;
+        System::Clock::Timestamp mFlushTime;
+        uint16_t mSize = 0;
+        bool mPending  = false;
+        uint8_t mValue[kMaxValueSize];
+    };
+
+    struct Metrics
+    {
+        // Writes passed to WriteValue.
+        uint32_t writesRequested = 0;
+        // Writes made to the decorated persister.
+        uint32_t writesPersisted = 0;
+        // Writes replacing a pending value, i.e. writes saved.
+        uint32_t writesCoalesced = 0;
+        // Pending values written early because the table was full.
+        uint32_t evictions = 0;
+    };
+
+    CoalescingAttributePersistenceProvider(AttributePersistenceProvider & persister, const Span<Entry> & entries,
+                                           System::Clock::Milliseconds32 writeDelay) :
+        mPersister(persister),
+        mEntries(entries), mWriteDelay(writeDelay)
+    {}
+
+    CHIP_ERROR WriteValue(const ConcreteAttributePath & path, const ByteSpan & value) override;
+    CHIP_ERROR ReadValue(const ConcreteAttributePath & path, const EmberAfAttributeMetadata * metadata,
+                         MutableByteSpan & value) override;
+    CHIP_ERROR ReadValues(EndpointId endpointId, ClusterId clusterId, Span<const EmberAfAttributeMetadata> attributes,
+                          MutableByteSpan buffer, ValueHandler & handler) override;
+
+    /**
+     * Write all pending values to the decorated persister, e.g. before shutting down.
+     */
+    void Flush();
+
+    /**
+     * Drop all pending values without writing them, e.g. before a factory reset
+     * erases the storage.
+     */
+    void Discard();
+
+    const Metrics & GetMetrics() const { return mMetrics; }
+
+private:
+    static void OnFlushTimer(System::Layer * layer, void * me);
+
+    Entry * FindPending(const ConcreteAttributePath & path);
+    Entry * AllocateEntry();
+    void FlushEntry(Entry & entry);
+    void FlushDueAndScheduleNext();
+
+    AttributePersistenceProvider & mPersister;
+    const Span<Entry> mEntries;
+    const System::Clock::Milliseconds32 mWriteDelay;
+    size_t mPendingCount = 0;
+    Metrics mMetrics;
+};
+
+} // namespace app
+} // namespace chip
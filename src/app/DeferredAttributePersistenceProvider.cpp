@@ -63,6 +63,13 @@ CHIP_ERROR DeferredAttributePersistenceProvider::ReadValue(const ConcreteAttribu
     return mPersister.ReadValue(path, metadata, value);
 }
 
+CHIP_ERROR DeferredAttributePersistenceProvider::ReadValues(EndpointId endpointId, ClusterId clusterId,
+                                                            Span<const EmberAfAttributeMetadata> attributes, MutableByteSpan buffer,
+                                                            ValueHandler & handler)
+{
+    return mPersister.ReadValues(endpointId, clusterId, attributes, buffer, handler);
+}
+
 void DeferredAttributePersistenceProvider::FlushAndScheduleNext()
 {
     const System::Clock::Timestamp now     = System::SystemClock().GetMonotonicTimestamp();
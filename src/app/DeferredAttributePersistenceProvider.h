@@ -69,6 +69,8 @@ public:
     CHIP_ERROR WriteValue(const ConcreteAttributePath & path, const ByteSpan & value) override;
     CHIP_ERROR ReadValue(const ConcreteAttributePath & path, const EmberAfAttributeMetadata * metadata,
                          MutableByteSpan & value) override;
+    CHIP_ERROR ReadValues(EndpointId endpointId, ClusterId clusterId, Span<const EmberAfAttributeMetadata> attributes,
+                          MutableByteSpan buffer, ValueHandler & handler) override;
 
 private:
     void FlushAndScheduleNext();
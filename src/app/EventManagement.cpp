@@ -63,12 +63,6 @@ EventManagement & EventManagement::GetInstance()
     return sInstance;
 }
 
-struct ReclaimEventCtx
-{
-    CircularEventBuffer * mpEventBuffer = nullptr;
-    size_t mSpaceNeededForMovedEvent    = 0;
-};
-
 /**
  * @brief
  *  Internal structure for traversing event list.
@@ -124,42 +118,84 @@ void EventManagement::Init(Messaging::ExchangeManager * apExchangeManager, uint3
     mBytesWritten = 0;
 }
 
-CHIP_ERROR EventManagement::CopyToNextBuffer(CircularEventBuffer * apEventBuffer)
+CHIP_ERROR EventManagement::ReadEventPriority(TLVReader & aReader, PriorityLevel & aPriority, EventNumber & aEventNumber)
 {
-    CircularTLVWriter writer;
-    CircularTLVReader reader;
-    CHIP_ERROR err                   = CHIP_NO_ERROR;
-    CircularEventBuffer * nextBuffer = apEventBuffer->GetNextCircularEventBuffer();
-    if (nextBuffer == nullptr)
+    TLVType containerType;
+    TLVType containerType1;
+
+    ReturnErrorOnFailure(aReader.EnterContainer(containerType));
+    ReturnErrorOnFailure(aReader.Next(TLV::ContextTag(to_underlying(EventReportIB::Tag::kEventData))));
+    ReturnErrorOnFailure(aReader.EnterContainer(containerType1));
+
+    // The event number and the priority are written right after the path by ConstructEvent, stop as soon as we have the priority
+    // instead of walking the whole event.
+    CHIP_ERROR err;
+    while ((err = aReader.Next()) == CHIP_NO_ERROR)
     {
-        return CHIP_ERROR_INVALID_ARGUMENT;
+        if (aReader.GetTag() == TLV::ContextTag(to_underlying(EventDataIB::Tag::kEventNumber)))
+        {
+            ReturnErrorOnFailure(aReader.Get(aEventNumber));
+        }
+        else if (aReader.GetTag() == TLV::ContextTag(to_underlying(EventDataIB::Tag::kPriority)))
+        {
+            uint16_t extPriority; // Note: the type here matches the type case in EventManagement::LogEvent, priority section
+            ReturnErrorOnFailure(aReader.Get(extPriority));
+            aPriority = static_cast<PriorityLevel>(extPriority);
+            return CHIP_NO_ERROR;
+        }
     }
-    CircularEventBuffer backup = *nextBuffer;
 
-    // Set up the next buffer s.t. it fails if needs to evict an element
-    nextBuffer->mProcessEvictedElement = AlwaysFail;
+    return err == CHIP_END_OF_TLV ? CHIP_ERROR_INVALID_TLV_ELEMENT : err;
+}
 
-    writer.Init(*nextBuffer);
+CHIP_ERROR EventManagement::GetHeadSegment(CircularEventBuffer & aBuffer, size_t aSpaceNeeded, EventSegment & aSegment)
+{
+    CircularTLVReader reader;
+    CircularEventBuffer * nextBuffer = aBuffer.GetNextCircularEventBuffer();
 
-    // Set up the reader s.t. it is positioned to read the head event
-    reader.Init(*apEventBuffer);
+    reader.Init(aBuffer);
+    reader.ImplicitProfileId = aBuffer.mImplicitProfileId;
+    aSegment                 = EventSegment();
 
-    err = reader.Next();
-    SuccessOrExit(err);
+    while (aSegment.mLength < aSpaceNeeded)
+    {
+        CHIP_ERROR err = reader.Next();
+        if (err == CHIP_END_OF_TLV && aSegment.mNumEvents > 0)
+        {
+            break;
+        }
+        ReturnErrorOnFailure(err);
 
-    err = writer.CopyElement(reader);
-    SuccessOrExit(err);
+        TLVReader eventReader;
+        PriorityLevel priority  = PriorityLevel::Invalid;
+        EventNumber eventNumber = 0;
+        eventReader.Init(reader);
+        ReturnErrorOnFailure(ReadEventPriority(eventReader, priority, eventNumber));
 
-    err = writer.Finalize();
-    SuccessOrExit(err);
+        const bool drop = aBuffer.IsFinalDestinationForPriority(priority);
+        if (aSegment.mNumEvents == 0)
+        {
+            aSegment.mDrop             = drop;
+            aSegment.mFirstEventNumber = eventNumber;
+        }
+        else if (drop != aSegment.mDrop)
+        {
+            break;
+        }
 
-    ChipLogDetail(EventLogging, "Copy Event to next buffer with priority %u", static_cast<unsigned>(nextBuffer->GetPriority()));
-exit:
-    if (err != CHIP_NO_ERROR)
-    {
-        *nextBuffer = backup;
+        ReturnErrorOnFailure(reader.Skip());
+
+        // A segment is moved to the next buffer as a whole, so it must fit there.
+        if (!drop && aSegment.mNumEvents > 0 && nextBuffer != nullptr && reader.GetLengthRead() > nextBuffer->GetTotalDataLength())
+        {
+            break;
+        }
+
+        aSegment.mLength = reader.GetLengthRead();
+        aSegment.mNumEvents++;
     }
-    return err;
+
+    return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(size_t aRequiredSpace)
@@ -167,7 +203,7 @@ CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(size_t aRequiredSpace)
     CHIP_ERROR err                    = CHIP_NO_ERROR;
     size_t requiredSpace              = aRequiredSpace;
     CircularEventBuffer * eventBuffer = mpEventBuffer;
-    ReclaimEventCtx ctx;
+    EventSegment segment;
 
     // check whether we actually need to do anything, exit if we don't
     VerifyOrExit(requiredSpace > eventBuffer->AvailableDataLength(), err = CHIP_NO_ERROR);
@@ -179,61 +215,45 @@ CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(size_t aRequiredSpace)
 
         if (requiredSpace > eventBuffer->AvailableDataLength())
         {
-            ctx.mpEventBuffer             = eventBuffer;
-            ctx.mSpaceNeededForMovedEvent = 0;
-
-            eventBuffer->mProcessEvictedElement = EvictEvent;
-            eventBuffer->mAppData               = &ctx;
-            err                                 = eventBuffer->EvictHead();
+            // Free up the missing space one segment at a time: a segment is the run of events at the head of the buffer that are
+            // either all dropped, because this buffer is their final destination, or all moved to the next buffer.
+            err = GetHeadSegment(*eventBuffer, requiredSpace - eventBuffer->AvailableDataLength(), segment);
+            SuccessOrExit(err);
 
-            // one of two things happened: either the element was evicted immediately if the head's priority is same as current
-            // buffer(final one), or we figured out how much space we need to evict it into the next buffer, the check happens in
-            // EvictEvent function
+            if (segment.mDrop)
+            {
+                ChipLogProgress(EventLogging,
+                                "Dropped %u events from buffer with priority %u starting at event number 0x" ChipLogFormatX64
+                                " due to overflow",
+                                static_cast<unsigned>(segment.mNumEvents), static_cast<unsigned>(eventBuffer->GetPriority()),
+                                ChipLogValueX64(segment.mFirstEventNumber));
+                err = eventBuffer->DiscardHead(segment.mLength);
+                SuccessOrExit(err);
+                continue;
+            }
 
-            if (err != CHIP_NO_ERROR)
+            CircularEventBuffer * nextBuffer = eventBuffer->GetNextCircularEventBuffer();
+            VerifyOrExit(nextBuffer != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
+            if (segment.mLength <= nextBuffer->AvailableDataLength())
             {
-                VerifyOrExit(ctx.mSpaceNeededForMovedEvent != 0, /* no-op, return err */);
-                VerifyOrExit(eventBuffer->GetNextCircularEventBuffer() != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
-                if (ctx.mSpaceNeededForMovedEvent <= eventBuffer->GetNextCircularEventBuffer()->AvailableDataLength())
-                {
-                    // we can copy the event outright.  copy event and
-                    // subsequently evict head s.t. evicting the head
-                    // element always succeeds.
-                    // Since we're calling CopyElement and we've checked
-                    // that there is space in the next buffer, we don't expect
-                    // this to fail.
-                    err = CopyToNextBuffer(eventBuffer);
-                    SuccessOrExit(err);
-                    // success; evict head unconditionally
-                    eventBuffer->mProcessEvictedElement = nullptr;
-                    err                                 = eventBuffer->EvictHead();
-                    // if unconditional eviction failed, this
-                    // means that we have no way of further
-                    // clearing the buffer.  fail out and let the
-                    // caller know that we could not honor the
-                    // request
-                    SuccessOrExit(err);
-                    continue;
-                }
-                // we cannot copy event outright. We remember the
-                // current required space in mRequiredSpaceForEvicted, we note the
-                // space requirements for the event in the current
-                // buffer and make that space in the next buffer.
-                eventBuffer->SetRequiredSpaceforEvicted(requiredSpace);
-                eventBuffer = eventBuffer->GetNextCircularEventBuffer();
-
-                // Sanity check: return error  here on null event buffer.  If
-                // eventBuffer->mpNext were null, then the `EvictBuffer`
-                // would have succeeded -- the event was
-                // already in the final buffer.
-                VerifyOrExit(eventBuffer != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
-                requiredSpace = ctx.mSpaceNeededForMovedEvent;
+                // Move the events with a raw copy of their encoding, there is no need to parse them again.
+                err = eventBuffer->MoveHeadTo(*nextBuffer, segment.mLength);
+                SuccessOrExit(err);
+                ChipLogDetail(EventLogging, "Moved %u events to next buffer with priority %u",
+                              static_cast<unsigned>(segment.mNumEvents), static_cast<unsigned>(nextBuffer->GetPriority()));
+                continue;
             }
+
+            // The segment does not fit in the next buffer yet.  We remember the current required space in
+            // mRequiredSpaceForEvicted, and first make room for the whole segment in the next buffer.
+            eventBuffer->SetRequiredSpaceforEvicted(requiredSpace);
+            eventBuffer   = nextBuffer;
+            requiredSpace = segment.mLength;
         }
         else
         {
             // this branch is only taken when we go back in the buffer chain since we have free/spare enough space in next buffer,
-            // and need to retry to copy event from current buffer to next buffer, and free space for current buffer
+            // and need to retry to move events from current buffer to next buffer, and free space for current buffer
             if (eventBuffer == mpEventBuffer)
                 break;
             eventBuffer   = eventBuffer->GetPreviousCircularEventBuffer();
@@ -242,9 +262,6 @@ CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(size_t aRequiredSpace)
         }
     }
 
-    mpEventBuffer->mProcessEvictedElement = nullptr;
-    mpEventBuffer->mAppData               = nullptr;
-
 exit:
     return err;
 }
@@ -796,48 +813,6 @@ CHIP_ERROR EventManagement::FetchEventParameters(const TLVReader & aReader, size
     return CHIP_NO_ERROR;
 }
 
-CHIP_ERROR EventManagement::EvictEvent(TLVCircularBuffer & apBuffer, void * apAppData, TLVReader & aReader)
-{
-    // pull out the delta time, pull out the priority
-    ReturnErrorOnFailure(aReader.Next());
-
-    TLVType containerType;
-    TLVType containerType1;
-    ReturnErrorOnFailure(aReader.EnterContainer(containerType));
-    ReturnErrorOnFailure(aReader.Next());
-
-    ReturnErrorOnFailure(aReader.EnterContainer(containerType1));
-    EventEnvelopeContext context;
-    constexpr bool recurse = false;
-    CHIP_ERROR err         = TLV::Utilities::Iterate(aReader, FetchEventParameters, &context, recurse);
-    if (err == CHIP_END_OF_TLV)
-    {
-        err = CHIP_NO_ERROR;
-    }
-    ReturnErrorOnFailure(err);
-
-    ReturnErrorOnFailure(aReader.ExitContainer(containerType1));
-    ReturnErrorOnFailure(aReader.ExitContainer(containerType));
-    const PriorityLevel imp = static_cast<PriorityLevel>(context.mPriority);
-
-    ReclaimEventCtx * const ctx             = static_cast<ReclaimEventCtx *>(apAppData);
-    CircularEventBuffer * const eventBuffer = ctx->mpEventBuffer;
-    if (eventBuffer->IsFinalDestinationForPriority(imp))
-    {
-        ChipLogProgress(EventLogging,
-                        "Dropped 1 event from buffer with priority %u and event number  0x" ChipLogFormatX64
-                        " due to overflow: event priority_level: %u",
-                        static_cast<unsigned>(eventBuffer->GetPriority()), ChipLogValueX64(context.mEventNumber),
-                        static_cast<unsigned>(imp));
-        ctx->mSpaceNeededForMovedEvent = 0;
-        return CHIP_NO_ERROR;
-    }
-
-    // event is not getting dropped. Note how much space it requires, and return.
-    ctx->mSpaceNeededForMovedEvent = aReader.GetLengthRead();
-    return CHIP_END_OF_TLV;
-}
-
 void EventManagement::SetScheduledEventInfo(EventNumber & aEventNumber, uint32_t & aInitialWrittenEventBytes) const
 {
     aEventNumber              = mLastEventNumber;
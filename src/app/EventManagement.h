@@ -395,22 +395,39 @@ private:
     CHIP_ERROR LogEventPrivate(EventLoggingDelegate * apDelegate, const EventOptions & aEventOptions, EventNumber & aEventNumber);
 
     /**
-     * @brief copy the event outright to next buffer with higher priority
-     *
-     * @param[in] apEventBuffer  CircularEventBuffer
-     *
+     * @brief
+     *   A run of consecutive events at the head of a CircularEventBuffer that share the same fate when the buffer needs room:
+     *   either they are all dropped, or they are all moved to the next buffer.
      */
-    CHIP_ERROR CopyToNextBuffer(CircularEventBuffer * apEventBuffer);
+    struct EventSegment
+    {
+        uint32_t mLength              = 0; ///< Encoded length of the events, in bytes.
+        uint32_t mNumEvents           = 0;
+        EventNumber mFirstEventNumber = 0;
+        bool mDrop                    = false;
+    };
 
     /**
-     * @brief eusure current buffer has enough space, if not, when current buffer is final destination of last tail's event
-     * priority, we need to drop event, otherwises, move the last event to the buffer with higher priority
+     * @brief ensure current buffer has enough space. Events are removed from the head of the buffer one segment at a time, a
+     * segment is dropped when the current buffer is the final destination for the priority of its events, otherwise the segment is
+     * moved to the buffer with higher priority, without re-encoding its events.
      *
      * @param[in] aRequiredSpace  require space
      *
      */
     CHIP_ERROR EnsureSpaceInCircularBuffer(size_t aRequiredSpace);
 
+    /**
+     * @brief Measure the segment at the head of aBuffer, covering at least aSpaceNeeded bytes unless the fate of the events changes
+     * before that, in which case the segment stops at the first event with a different fate.
+     */
+    static CHIP_ERROR GetHeadSegment(CircularEventBuffer & aBuffer, size_t aSpaceNeeded, EventSegment & aSegment);
+
+    /**
+     * @brief Read the priority and event number of the event aReader is positioned on, without parsing the rest of the event.
+     */
+    static CHIP_ERROR ReadEventPriority(TLV::TLVReader & aReader, PriorityLevel & aPriority, EventNumber & aEventNumber);
+
     /**
      * @brief Iterate the event elements inside event tlv and mark the fabric index as kUndefinedFabricIndex if
      * it matches the FabricIndex apFabricIndex points to.
@@ -462,16 +479,6 @@ private:
      */
     static CHIP_ERROR CopyAndAdjustDeltaTime(const TLV::TLVReader & aReader, size_t aDepth, void * apContext);
 
-    /**
-     * @brief checking if the tail's event can be moved to higher priority, if not, dropped, if yes, note how much space it
-     * requires, and return.
-     */
-    static CHIP_ERROR EvictEvent(chip::TLV::TLVCircularBuffer & aBuffer, void * apAppData, TLV::TLVReader & aReader);
-    static CHIP_ERROR AlwaysFail(chip::TLV::TLVCircularBuffer & aBuffer, void * apAppData, TLV::TLVReader & aReader)
-    {
-        return CHIP_ERROR_NO_MEMORY;
-    };
-
     /**
      * @brief Check whether the event instance represented by the EventEnvelopeContext should be included in the report.
      *
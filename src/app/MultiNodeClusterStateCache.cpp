@@ -0,0 +1,151 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/MultiNodeClusterStateCache.h>
+
+#include <lib/core/TLV.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+namespace chip {
+namespace app {
+
+namespace {
+
+CHIP_ERROR GetElementTLVSize(TLV::TLVReader * apData, size_t & aSize)
+{
+    Platform::ScopedMemoryBufferWithSize<uint8_t> backingBuffer;
+    TLV::TLVReader reader;
+    reader.Init(*apData);
+    size_t totalBufSize = reader.GetTotalLength();
+    backingBuffer.Calloc(totalBufSize);
+    VerifyOrReturnError(backingBuffer.Get() != nullptr, CHIP_ERROR_NO_MEMORY);
+    TLV::ScopedBufferTLVWriter writer(std::move(backingBuffer), totalBufSize);
+    ReturnErrorOnFailure(writer.CopyElement(TLV::AnonymousTag(), reader));
+    aSize = writer.GetLengthWritten();
+    ReturnErrorOnFailure(writer.Finalize(backingBuffer));
+    return CHIP_NO_ERROR;
+}
+
+} // namespace
+
+CHIP_ERROR MultiNodeClusterStateCache::UpdateCache(const ScopedNodeId & node, const ConcreteDataAttributePath & path,
+                                                   TLV::TLVReader * apData, const StatusIB & status)
+{
+    AttributeState state;
+
+    if (apData)
+    {
+        size_t elementSize = 0;
+        ReturnErrorOnFailure(GetElementTLVSize(apData, elementSize));
+        Platform::ScopedMemoryBufferWithSize<uint8_t> backingBuffer;
+        backingBuffer.Calloc(elementSize);
+        VerifyOrReturnError(backingBuffer.Get() != nullptr, CHIP_ERROR_NO_MEMORY);
+        TLV::ScopedBufferTLVWriter writer(std::move(backingBuffer), elementSize);
+        ReturnErrorOnFailure(writer.CopyElement(TLV::AnonymousTag(), *apData));
+        ReturnErrorOnFailure(writer.Finalize(backingBuffer));
+
+        state.Set<Platform::ScopedMemoryBufferWithSize<uint8_t>>(std::move(backingBuffer));
+    }
+    else
+    {
+        state.Set<StatusIB>(status);
+    }
+
+    mCache[node][path] = std::move(state);
+    return CHIP_NO_ERROR;
+}
+
+void MultiNodeClusterStateCache::OnNodeAttributeData(const ScopedNodeId & aNode, const ConcreteDataAttributePath & aPath,
+                                                     TLV::TLVReader * apData, const StatusIB & aStatus)
+{
+    TLV::TLVReader dataSnapshot;
+    if (apData)
+    {
+        dataSnapshot.Init(*apData);
+    }
+
+    CHIP_ERROR err = UpdateCache(aNode, aPath, apData, aStatus);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DataManagement, "Failed to cache attribute of %02x:" ChipLogFormatX64 ": %" CHIP_ERROR_FORMAT,
+                     aNode.GetFabricIndex(), ChipLogValueX64(aNode.GetNodeId()), err.Format());
+    }
+
+    mCallback.OnNodeAttributeData(aNode, aPath, apData ? &dataSnapshot : nullptr, aStatus);
+
+    if (err == CHIP_NO_ERROR)
+    {
+        mCallback.OnAttributeChanged(this, aNode, aPath);
+    }
+}
+
+const MultiNodeClusterStateCache::AttributeState *
+MultiNodeClusterStateCache::GetAttributeState(const ScopedNodeId & node, const ConcreteAttributePath & path, CHIP_ERROR & err) const
+{
+    auto nodeIter = mCache.find(node);
+    if (nodeIter == mCache.end())
+    {
+        err = CHIP_ERROR_KEY_NOT_FOUND;
+        return nullptr;
+    }
+
+    auto attributeIter = nodeIter->second.find(path);
+    if (attributeIter == nodeIter->second.end())
+    {
+        err = CHIP_ERROR_KEY_NOT_FOUND;
+        return nullptr;
+    }
+
+    err = CHIP_NO_ERROR;
+    return &attributeIter->second;
+}
+
+CHIP_ERROR MultiNodeClusterStateCache::Get(const ScopedNodeId & node, const ConcreteAttributePath & path,
+                                           TLV::TLVReader & reader) const
+{
+    CHIP_ERROR err;
+    auto attributeState = GetAttributeState(node, path, err);
+    ReturnErrorOnFailure(err);
+    if (attributeState->Is<StatusIB>())
+    {
+        return CHIP_ERROR_IM_STATUS_CODE_RECEIVED;
+    }
+
+    reader.Init(attributeState->Get<Platform::ScopedMemoryBufferWithSize<uint8_t>>().Get(),
+                attributeState->Get<Platform::ScopedMemoryBufferWithSize<uint8_t>>().AllocatedSize());
+    return reader.Next();
+}
+
+CHIP_ERROR MultiNodeClusterStateCache::GetStatus(const ScopedNodeId & node, const ConcreteAttributePath & path,
+                                                 StatusIB & status) const
+{
+    CHIP_ERROR err;
+    auto attributeState = GetAttributeState(node, path, err);
+    ReturnErrorOnFailure(err);
+    if (!attributeState->Is<StatusIB>())
+    {
+        return CHIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    status = attributeState->Get<StatusIB>();
+    return CHIP_NO_ERROR;
+}
+
+} // namespace app
+} // namespace chip
@@ -0,0 +1,174 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/ConcreteAttributePath.h>
+#include <app/MultiNodeReadClient.h>
+#include <app/MessageDef/StatusIB.h>
+#include <app/data-model/Decode.h>
+#include <lib/core/ScopedNodeId.h>
+#include <lib/support/ScopedBuffer.h>
+#include <lib/support/Variant.h>
+#include <map>
+
+namespace chip {
+namespace app {
+
+/*
+ * Attribute cache for the nodes of a MultiNodeReadClient: the attribute data and statuses
+ * reported by every node are stored, as TLV, in a single cache keyed by node and then by
+ * concrete attribute path.
+ *
+ * Like ClusterStateCache, the cache forwards every callback to a registered callback, and
+ * notifies it of every attribute updated in the cache.  Unlike it, events are not cached.
+ *
+ * Entries of a node are kept once the interaction with the node is over, until ClearNode is called.
+ */
+class MultiNodeClusterStateCache : public MultiNodeReadClient::Callback
+{
+public:
+    class Callback : public MultiNodeReadClient::Callback
+    {
+    public:
+        /*
+         * Called anytime an attribute of a node has been updated in the cache
+         */
+        virtual void OnAttributeChanged(MultiNodeClusterStateCache * cache, const ScopedNodeId & node,
+                                        const ConcreteAttributePath & path)
+        {}
+    };
+
+    MultiNodeClusterStateCache(Callback & callback) : mCallback(callback) {}
+
+    /*
+     * Retrieve the value of an attribute of a node from the cache, decoding it into 'value'.  See
+     * ClusterStateCache::Get for the lifetime of the decoded value and the notable return values.
+     */
+    template <typename AttributeObjectTypeT>
+    CHIP_ERROR Get(const ScopedNodeId & node, const ConcreteAttributePath & path,
+                   typename AttributeObjectTypeT::DecodableType & value) const
+    {
+        TLV::TLVReader reader;
+
+        if (path.mClusterId != AttributeObjectTypeT::GetClusterId() || path.mAttributeId != AttributeObjectTypeT::GetAttributeId())
+        {
+            return CHIP_ERROR_SCHEMA_MISMATCH;
+        }
+
+        ReturnErrorOnFailure(Get(node, path, reader));
+        return DataModel::Decode(reader, value);
+    }
+
+    /*
+     * Position 'reader' on the value of an attribute of a node.
+     *
+     * Notable return values:
+     *      - If neither data nor status for the specified node and path exist in the cache, CHIP_ERROR_KEY_NOT_FOUND
+     *        shall be returned.
+     *
+     *      - If a StatusIB is present in the cache instead of data, CHIP_ERROR_IM_STATUS_CODE_RECEIVED shall be returned.
+     */
+    CHIP_ERROR Get(const ScopedNodeId & node, const ConcreteAttributePath & path, TLV::TLVReader & reader) const;
+
+    /*
+     * Retrieve the StatusIB reported for an attribute of a node.  If data exists in the cache instead of status,
+     * CHIP_ERROR_INVALID_ARGUMENT shall be returned.
+     */
+    CHIP_ERROR GetStatus(const ScopedNodeId & node, const ConcreteAttributePath & path, StatusIB & status) const;
+
+    /*
+     * Execute an iterator function for every node with entries in the cache.
+     *
+     * The iterator is expected to have this signature:
+     *      CHIP_ERROR IteratorFunc(const ScopedNodeId &node);
+     */
+    template <typename IteratorFunc>
+    CHIP_ERROR ForEachNode(IteratorFunc func) const
+    {
+        for (auto & nodeIter : mCache)
+        {
+            ReturnErrorOnFailure(func(nodeIter.first));
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    /*
+     * Execute an iterator function for every attribute of a node in the cache.
+     *
+     * The iterator is expected to have this signature:
+     *      CHIP_ERROR IteratorFunc(const ConcreteAttributePath &path);
+     *
+     * If the node has no entries in the cache, CHIP_ERROR_KEY_NOT_FOUND shall be returned.
+     */
+    template <typename IteratorFunc>
+    CHIP_ERROR ForEachAttribute(const ScopedNodeId & node, IteratorFunc func) const
+    {
+        auto nodeIter = mCache.find(node);
+        VerifyOrReturnError(nodeIter != mCache.end(), CHIP_ERROR_KEY_NOT_FOUND);
+
+        for (auto & attributeIter : nodeIter->second)
+        {
+            ReturnErrorOnFailure(func(attributeIter.first));
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    size_t GetNodeCount() const { return mCache.size(); }
+    void ClearNode(const ScopedNodeId & node) { mCache.erase(node); }
+
+private:
+    using AttributeState = Variant<Platform::ScopedMemoryBufferWithSize<uint8_t>, StatusIB>;
+    using NodeState      = std::map<ConcreteAttributePath, AttributeState>;
+
+    CHIP_ERROR UpdateCache(const ScopedNodeId & node, const ConcreteDataAttributePath & path, TLV::TLVReader * apData,
+                           const StatusIB & status);
+    const AttributeState * GetAttributeState(const ScopedNodeId & node, const ConcreteAttributePath & path,
+                                             CHIP_ERROR & err) const;
+
+    //
+    // MultiNodeReadClient::Callback
+    //
+    void OnNodeReportBegin(const ScopedNodeId & aNode) override { mCallback.OnNodeReportBegin(aNode); }
+    void OnNodeReportEnd(const ScopedNodeId & aNode) override { mCallback.OnNodeReportEnd(aNode); }
+    void OnNodeAttributeData(const ScopedNodeId & aNode, const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData,
+                             const StatusIB & aStatus) override;
+    void OnNodeEventData(const ScopedNodeId & aNode, const EventHeader & aEventHeader, TLV::TLVReader * apData,
+                         const StatusIB * apStatus) override
+    {
+        mCallback.OnNodeEventData(aNode, aEventHeader, apData, apStatus);
+    }
+    void OnNodeSubscriptionEstablished(const ScopedNodeId & aNode, SubscriptionId aSubscriptionId) override
+    {
+        mCallback.OnNodeSubscriptionEstablished(aNode, aSubscriptionId);
+    }
+    void OnNodeResubscriptionScheduled(const ScopedNodeId & aNode, CHIP_ERROR aTerminationCause,
+                                       System::Clock::Milliseconds32 aDelay) override
+    {
+        mCallback.OnNodeResubscriptionScheduled(aNode, aTerminationCause, aDelay);
+    }
+    void OnNodeError(const ScopedNodeId & aNode, CHIP_ERROR aError) override { mCallback.OnNodeError(aNode, aError); }
+    void OnNodeDone(const ScopedNodeId & aNode) override { mCallback.OnNodeDone(aNode); }
+    void OnDone(MultiNodeReadClient * apClient) override { mCallback.OnDone(apClient); }
+
+    Callback & mCallback;
+    std::map<ScopedNodeId, NodeState> mCache;
+};
+
+} // namespace app
+} // namespace chip
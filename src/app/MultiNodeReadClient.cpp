@@ -0,0 +1,204 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/MultiNodeReadClient.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+namespace chip {
+namespace app {
+
+namespace {
+
+// Copies everything but the session and the data version filters.
+void CopyRequest(const ReadPrepareParams & aFrom, ReadPrepareParams & aTo)
+{
+    aTo.mpEventPathParamsList        = aFrom.mpEventPathParamsList;
+    aTo.mEventPathParamsListSize     = aFrom.mEventPathParamsListSize;
+    aTo.mpAttributePathParamsList    = aFrom.mpAttributePathParamsList;
+    aTo.mAttributePathParamsListSize = aFrom.mAttributePathParamsListSize;
+    aTo.mEventNumber                 = aFrom.mEventNumber;
+    aTo.mTimeout                     = aFrom.mTimeout;
+    aTo.mMinIntervalFloorSeconds     = aFrom.mMinIntervalFloorSeconds;
+    aTo.mMaxIntervalCeilingSeconds   = aFrom.mMaxIntervalCeilingSeconds;
+    aTo.mKeepSubscriptions           = aFrom.mKeepSubscriptions;
+    aTo.mIsFabricFiltered            = aFrom.mIsFabricFiltered;
+}
+
+} // namespace
+
+CHIP_ERROR MultiNodeReadClient::SetRequest(ReadPrepareParams && aReadPrepareParams)
+{
+    VerifyOrReturnError(mNodes.Allocated() == 0, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(aReadPrepareParams.mAttributePathParamsListSize != 0 || aReadPrepareParams.mEventPathParamsListSize != 0,
+                        CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(aReadPrepareParams.mDataVersionFilterListSize == 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    mReadPrepareParams = std::move(aReadPrepareParams);
+    mReadPrepareParams.mSessionHolder.Release();
+    mPayload    = nullptr;
+    mHasRequest = true;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR MultiNodeReadClient::AddNode(const SessionHandle & aSession)
+{
+    VerifyOrReturnError(mHasRequest, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(aSession->IsSecureSession(), CHIP_ERROR_INVALID_ARGUMENT);
+
+    const ScopedNodeId node = aSession->AsSecureSession()->GetPeer();
+    VerifyOrReturnError(FindNode(node) == nullptr, CHIP_ERROR_DUPLICATE_KEY_ID);
+
+    NodeClient * nodeClient = mNodes.CreateObject(*this, node);
+    VerifyOrReturnError(nodeClient != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    ReadPrepareParams params(aSession);
+    CopyRequest(mReadPrepareParams, params);
+
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    if (mPayload.IsNull())
+    {
+        // The request does not depend on the session, and node clients leave data version filters and
+        // event numbers to the request, so the request encoded by any of them can be sent to all.
+        err = nodeClient->mReadClient.EncodeRequest(params, mPayload);
+    }
+
+    System::PacketBufferHandle payload;
+    if (err == CHIP_NO_ERROR)
+    {
+        payload = mPayload.CloneData();
+        err     = payload.IsNull() ? CHIP_ERROR_NO_MEMORY : CHIP_NO_ERROR;
+    }
+
+    if (err == CHIP_NO_ERROR)
+    {
+        if (mInteractionType == ReadClient::InteractionType::Subscribe)
+        {
+            err = nodeClient->mReadClient.SendAutoResubscribeRequest(std::move(params), std::move(payload));
+        }
+        else
+        {
+            err = nodeClient->mReadClient.SendRequest(params, std::move(payload));
+        }
+    }
+
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DataManagement, "Failed to send request to %02x:" ChipLogFormatX64 ": %" CHIP_ERROR_FORMAT,
+                     node.GetFabricIndex(), ChipLogValueX64(node.GetNodeId()), err.Format());
+        mNodes.ReleaseObject(nodeClient);
+    }
+
+    return err;
+}
+
+void MultiNodeReadClient::RemoveNode(const ScopedNodeId & aNode)
+{
+    NodeClient * nodeClient = FindNode(aNode);
+    if (nodeClient != nullptr)
+    {
+        mNodes.ReleaseObject(nodeClient);
+    }
+}
+
+void MultiNodeReadClient::Shutdown()
+{
+    mNodes.ReleaseAll();
+    mPayload = nullptr;
+}
+
+size_t MultiNodeReadClient::GetResubscribingNodeCount()
+{
+    size_t count = 0;
+    mNodes.ForEachActiveObject([&count](NodeClient * nodeClient) {
+        count += nodeClient->mResubscribing ? 1 : 0;
+        return Loop::Continue;
+    });
+    return count;
+}
+
+void MultiNodeReadClient::OverrideLivenessTimeout(System::Clock::Timeout aLivenessTimeout)
+{
+    mNodes.ForEachActiveObject([aLivenessTimeout](NodeClient * nodeClient) {
+        if (nodeClient->mSubscriptionActive)
+        {
+            nodeClient->mReadClient.OverrideLivenessTimeout(aLivenessTimeout);
+        }
+        return Loop::Continue;
+    });
+}
+
+MultiNodeReadClient::NodeClient * MultiNodeReadClient::FindNode(const ScopedNodeId & aNode)
+{
+    NodeClient * found = nullptr;
+    mNodes.ForEachActiveObject([&found, &aNode](NodeClient * nodeClient) {
+        if (nodeClient->mNode == aNode)
+        {
+            found = nodeClient;
+            return Loop::Break;
+        }
+        return Loop::Continue;
+    });
+    return found;
+}
+
+CHIP_ERROR MultiNodeReadClient::ScheduleResubscription(NodeClient & aNodeClient, CHIP_ERROR aTerminationCause)
+{
+    const System::Clock::Timestamp now = System::SystemClock().GetMonotonicTimestamp();
+
+    // Start no earlier than the node's own back-off allows, and no earlier than the spacing after the
+    // re-subscription scheduled last for the set.
+    System::Clock::Timestamp start =
+        now + System::Clock::Milliseconds32(aNodeClient.mReadClient.ComputeTimeTillNextSubscription());
+    if (start < mNextResubscribeTime)
+    {
+        start = mNextResubscribeTime;
+    }
+
+    const auto delay = std::chrono::duration_cast<System::Clock::Milliseconds32>(start - now);
+    ReturnErrorOnFailure(
+        aNodeClient.mReadClient.ScheduleResubscription(delay.count(), NullOptional, aTerminationCause == CHIP_ERROR_TIMEOUT));
+
+    mNextResubscribeTime       = start + mResubscribeSpacing;
+    aNodeClient.mResubscribing = true;
+
+    ChipLogProgress(DataManagement,
+                    "Will try to resubscribe to %02x:" ChipLogFormatX64 " after %" PRIu32 "ms due to error %" CHIP_ERROR_FORMAT,
+                    aNodeClient.mNode.GetFabricIndex(), ChipLogValueX64(aNodeClient.mNode.GetNodeId()), delay.count(),
+                    aTerminationCause.Format());
+
+    mCallback.OnNodeResubscriptionScheduled(aNodeClient.mNode, aTerminationCause, delay);
+    return CHIP_NO_ERROR;
+}
+
+void MultiNodeReadClient::OnNodeDone(NodeClient & aNodeClient)
+{
+    // The node client, including its ReadClient, is destroyed: nothing below may use it.
+    const ScopedNodeId node = aNodeClient.mNode;
+    mNodes.ReleaseObject(&aNodeClient);
+
+    mCallback.OnNodeDone(node);
+    if (mNodes.Allocated() == 0)
+    {
+        mCallback.OnDone(this);
+    }
+}
+
+} // namespace app
+} // namespace chip
@@ -0,0 +1,188 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/BufferedReadCallback.h>
+#include <app/ReadClient.h>
+#include <app/ReadPrepareParams.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/ScopedNodeId.h>
+#include <lib/support/Pool.h>
+#include <system/SystemClock.h>
+#include <system/SystemPacketBuffer.h>
+
+namespace chip {
+namespace app {
+
+/**
+ * Issues the same read or subscribe request to a set of nodes.
+ *
+ * The request is encoded once and a copy of that payload is sent to every node added to the
+ * client, through a ReadClient per node.  Reports of all nodes are delivered to a single
+ * callback, tagged with the node they come from, with chunked lists already reassembled (see
+ * BufferedReadCallback).  A MultiNodeClusterStateCache can be used as that callback to mirror
+ * the attributes of every node.
+ *
+ * Subscriptions are automatically re-established with the default back-off of each node, but
+ * the re-subscriptions of the whole set are spaced by at least a configurable interval, so that
+ * nodes whose subscriptions dropped together (for instance when the controller lost connectivity)
+ * are not all re-subscribed, and CASE re-established with, in a burst.
+ *
+ * Since the payload is shared, per-node data version filters are not supported.
+ */
+class MultiNodeReadClient
+{
+public:
+    class Callback
+    {
+    public:
+        virtual ~Callback() = default;
+
+        /// See ReadClient::Callback for the semantics of the per-node callbacks.
+        virtual void OnNodeReportBegin(const ScopedNodeId & aNode) {}
+        virtual void OnNodeReportEnd(const ScopedNodeId & aNode) {}
+        virtual void OnNodeAttributeData(const ScopedNodeId & aNode, const ConcreteDataAttributePath & aPath,
+                                         TLV::TLVReader * apData, const StatusIB & aStatus)
+        {}
+        virtual void OnNodeEventData(const ScopedNodeId & aNode, const EventHeader & aEventHeader, TLV::TLVReader * apData,
+                                     const StatusIB * apStatus)
+        {}
+        virtual void OnNodeSubscriptionEstablished(const ScopedNodeId & aNode, SubscriptionId aSubscriptionId) {}
+        virtual void OnNodeResubscriptionScheduled(const ScopedNodeId & aNode, CHIP_ERROR aTerminationCause,
+                                                   System::Clock::Milliseconds32 aDelay)
+        {}
+        virtual void OnNodeError(const ScopedNodeId & aNode, CHIP_ERROR aError) {}
+
+        /// Called once the interaction with aNode is over; the node is then no longer part of the client.
+        virtual void OnNodeDone(const ScopedNodeId & aNode) {}
+
+        /// Called when the interaction with the last node of the client is over.
+        virtual void OnDone(MultiNodeReadClient * apClient) = 0;
+    };
+
+    MultiNodeReadClient(InteractionModelEngine * apImEngine, Messaging::ExchangeManager * apExchangeMgr, Callback & aCallback,
+                        ReadClient::InteractionType aInteractionType,
+                        System::Clock::Milliseconds32 aResubscribeSpacing =
+                            System::Clock::Milliseconds32(CHIP_RESUBSCRIBE_MULTI_NODE_SPACING_MS)) :
+        mpImEngine(apImEngine),
+        mpExchangeMgr(apExchangeMgr), mCallback(aCallback), mInteractionType(aInteractionType),
+        mResubscribeSpacing(aResubscribeSpacing)
+    {}
+    ~MultiNodeReadClient() { Shutdown(); }
+
+    /**
+     * Sets the request sent to the nodes.  The session of aReadPrepareParams is ignored.  The
+     * path lists are not copied: they must remain valid until the client is shut down.
+     *
+     * @retval CHIP_ERROR_INVALID_ARGUMENT if data version filters are provided.
+     */
+    CHIP_ERROR SetRequest(ReadPrepareParams && aReadPrepareParams);
+
+    /**
+     * Sends the request over aSession and adds its peer to the client.  Nodes can be added at any
+     * time, for instance as sessions get established by CASESessionManager::BulkConnect.
+     *
+     * @retval CHIP_ERROR_DUPLICATE_KEY_ID if the peer of aSession is already part of the client.
+     */
+    CHIP_ERROR AddNode(const SessionHandle & aSession);
+
+    /// Ends the interaction with aNode without calling OnNodeDone.
+    void RemoveNode(const ScopedNodeId & aNode);
+
+    /// Ends the interaction with every node without calling any callback.
+    void Shutdown();
+
+    size_t GetNodeCount() const { return mNodes.Allocated(); }
+    bool HasNode(const ScopedNodeId & aNode) { return FindNode(aNode) != nullptr; }
+
+    /// Number of nodes waiting for a re-subscription attempt.
+    size_t GetResubscribingNodeCount();
+
+    /// Overrides the liveness timeout of every active subscription, see ReadClient::OverrideLivenessTimeout.
+    void OverrideLivenessTimeout(System::Clock::Timeout aLivenessTimeout);
+
+private:
+    class NodeClient : public ReadClient::Callback
+    {
+    public:
+        NodeClient(MultiNodeReadClient & aOwner, const ScopedNodeId & aNode) :
+            mOwner(aOwner), mNode(aNode), mBufferedReadCallback(*this),
+            mReadClient(aOwner.mpImEngine, aOwner.mpExchangeMgr, mBufferedReadCallback, aOwner.mInteractionType)
+        {}
+
+        const ScopedNodeId & GetNode() const { return mNode; }
+
+    private:
+        friend class MultiNodeReadClient;
+
+        //
+        // ReadClient::Callback
+        //
+        void OnReportBegin() override { mOwner.mCallback.OnNodeReportBegin(mNode); }
+        void OnReportEnd() override { mOwner.mCallback.OnNodeReportEnd(mNode); }
+        void OnAttributeData(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData, const StatusIB & aStatus) override
+        {
+            mOwner.mCallback.OnNodeAttributeData(mNode, aPath, apData, aStatus);
+        }
+        void OnEventData(const EventHeader & aEventHeader, TLV::TLVReader * apData, const StatusIB * apStatus) override
+        {
+            mOwner.mCallback.OnNodeEventData(mNode, aEventHeader, apData, apStatus);
+        }
+        void OnSubscriptionEstablished(SubscriptionId aSubscriptionId) override
+        {
+            mSubscriptionActive = true;
+            mResubscribing      = false;
+            mOwner.mCallback.OnNodeSubscriptionEstablished(mNode, aSubscriptionId);
+        }
+        CHIP_ERROR OnResubscriptionNeeded(ReadClient * apReadClient, CHIP_ERROR aTerminationCause) override
+        {
+            mSubscriptionActive = false;
+            return mOwner.ScheduleResubscription(*this, aTerminationCause);
+        }
+        void OnError(CHIP_ERROR aError) override { mOwner.mCallback.OnNodeError(mNode, aError); }
+        void OnDone(ReadClient * apReadClient) override { mOwner.OnNodeDone(*this); }
+
+        MultiNodeReadClient & mOwner;
+        const ScopedNodeId mNode;
+        bool mSubscriptionActive = false;
+        bool mResubscribing      = false;
+        BufferedReadCallback mBufferedReadCallback;
+        ReadClient mReadClient;
+    };
+
+    NodeClient * FindNode(const ScopedNodeId & aNode);
+    CHIP_ERROR ScheduleResubscription(NodeClient & aNodeClient, CHIP_ERROR aTerminationCause);
+    void OnNodeDone(NodeClient & aNodeClient);
+
+    InteractionModelEngine * mpImEngine;
+    Messaging::ExchangeManager * mpExchangeMgr;
+    Callback & mCallback;
+    ReadClient::InteractionType mInteractionType;
+    System::Clock::Milliseconds32 mResubscribeSpacing;
+
+    ReadPrepareParams mReadPrepareParams;
+    bool mHasRequest = false;
+    System::PacketBufferHandle mPayload; // request encoded once, sent as a copy to every node
+
+    ObjectPool<NodeClient, CHIP_CONFIG_MULTI_NODE_READ_MAX_NODES> mNodes;
+    System::Clock::Timestamp mNextResubscribeTime = System::Clock::kZero; // no re-subscription is attempted before that time
+};
+
+} // namespace app
+} // namespace chip
@@ -28,6 +28,7 @@
 #include <app/ReadClient.h>
 #include <app/StatusResponse.h>
 #include <assert.h>
+#include <lib/core/TLVIndex.h>
 #include <lib/core/TLVTypes.h>
 #include <lib/support/FibonacciUtils.h>
 #include <messaging/ReliableMessageMgr.h>
@@ -245,14 +246,57 @@ CHIP_ERROR ReadClient::SendRequest(ReadPrepareParams & aReadPrepareParams)
     return CHIP_ERROR_INVALID_ARGUMENT;
 }
 
-CHIP_ERROR ReadClient::SendReadRequest(ReadPrepareParams & aReadPrepareParams)
+CHIP_ERROR ReadClient::SendRequest(ReadPrepareParams & aReadPrepareParams, System::PacketBufferHandle && aPayload)
 {
-    // TODO: SendRequest parameter is too long, need to have the structure to represent it
-    CHIP_ERROR err = CHIP_NO_ERROR;
+    VerifyOrReturnError(!aPayload.IsNull(), CHIP_ERROR_INVALID_ARGUMENT);
+
+    if (mInteractionType == InteractionType::Read)
+    {
+        VerifyOrReturnError(ClientState::Idle == mState, CHIP_ERROR_INCORRECT_STATE);
+        return SendReadRequest(aReadPrepareParams, std::move(aPayload));
+    }
+
+    if (mInteractionType == InteractionType::Subscribe)
+    {
+        VerifyOrReturnError(aReadPrepareParams.mMinIntervalFloorSeconds <= aReadPrepareParams.mMaxIntervalCeilingSeconds,
+                            CHIP_ERROR_INVALID_ARGUMENT);
+        VerifyOrReturnError(ClientState::Idle == mState, CHIP_ERROR_INCORRECT_STATE);
+        return SendSubscribeRequestImpl(aReadPrepareParams, std::move(aPayload));
+    }
+
+    return CHIP_ERROR_INVALID_ARGUMENT;
+}
+
+CHIP_ERROR ReadClient::EncodeRequest(ReadPrepareParams & aReadPrepareParams, System::PacketBufferHandle & aPayload)
+{
+    if (mInteractionType == InteractionType::Read)
+    {
+        return BuildReadRequest(aReadPrepareParams, aPayload);
+    }
+
+    if (mInteractionType == InteractionType::Subscribe)
+    {
+        return BuildSubscribeRequest(aReadPrepareParams, aPayload);
+    }
 
+    return CHIP_ERROR_INVALID_ARGUMENT;
+}
+
+CHIP_ERROR ReadClient::SendReadRequest(ReadPrepareParams & aReadPrepareParams)
+{
     ChipLogDetail(DataManagement, "%s ReadClient[%p]: Sending Read Request", __func__, this);
 
-    VerifyOrReturnError(ClientState::Idle == mState, err = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(ClientState::Idle == mState, CHIP_ERROR_INCORRECT_STATE);
+
+    System::PacketBufferHandle msgBuf;
+    ReturnErrorOnFailure(BuildReadRequest(aReadPrepareParams, msgBuf));
+    return SendReadRequest(aReadPrepareParams, std::move(msgBuf));
+}
+
+CHIP_ERROR ReadClient::BuildReadRequest(ReadPrepareParams & aReadPrepareParams, System::PacketBufferHandle & aMsgBuf)
+{
+    // TODO: SendRequest parameter is too long, need to have the structure to represent it
+    CHIP_ERROR err = CHIP_NO_ERROR;
 
     Span<AttributePathParams> attributePaths(aReadPrepareParams.mpAttributePathParamsList,
                                              aReadPrepareParams.mAttributePathParamsListSize);
@@ -260,7 +304,6 @@ CHIP_ERROR ReadClient::SendReadRequest(ReadPrepareParams & aReadPrepareParams)
     Span<DataVersionFilter> dataVersionFilters(aReadPrepareParams.mpDataVersionFilterList,
                                                aReadPrepareParams.mDataVersionFilterListSize);
 
-    System::PacketBufferHandle msgBuf;
     ReadRequestMessage::Builder request;
     System::PacketBufferTLVWriter writer;
 
@@ -314,12 +357,15 @@ CHIP_ERROR ReadClient::SendReadRequest(ReadPrepareParams & aReadPrepareParams)
     }
 
     ReturnErrorOnFailure(request.EndOfReadRequestMessage().GetError());
-    ReturnErrorOnFailure(writer.Finalize(&msgBuf));
+    return writer.Finalize(&aMsgBuf);
+}
 
+CHIP_ERROR ReadClient::SendReadRequest(ReadPrepareParams & aReadPrepareParams, System::PacketBufferHandle && aMsgBuf)
+{
     VerifyOrReturnError(aReadPrepareParams.mSessionHolder, CHIP_ERROR_MISSING_SECURE_SESSION);
 
     auto exchange = mpExchangeMgr->NewContext(aReadPrepareParams.mSessionHolder.Get().Value(), this);
-    VerifyOrReturnError(exchange != nullptr, err = CHIP_ERROR_NO_MEMORY);
+    VerifyOrReturnError(exchange != nullptr, CHIP_ERROR_NO_MEMORY);
 
     mExchange.Grab(exchange);
 
@@ -332,7 +378,7 @@ CHIP_ERROR ReadClient::SendReadRequest(ReadPrepareParams & aReadPrepareParams)
         mExchange->SetResponseTimeout(aReadPrepareParams.mTimeout);
     }
 
-    ReturnErrorOnFailure(mExchange->SendMessage(Protocols::InteractionModel::MsgType::ReadRequest, std::move(msgBuf),
+    ReturnErrorOnFailure(mExchange->SendMessage(Protocols::InteractionModel::MsgType::ReadRequest, std::move(aMsgBuf),
                                                 Messaging::SendFlags(Messaging::SendMessageFlags::kExpectResponse)));
 
     mPeer = aReadPrepareParams.mSessionHolder->AsSecureSession()->GetPeer();
@@ -516,6 +562,19 @@ CHIP_ERROR ReadClient::ProcessReportData(System::PacketBufferHandle && aPayload)
     AttributeReportIBs::Parser attributeReportIBs;
     System::PacketBufferTLVReader reader;
     reader.Init(std::move(aPayload));
+
+#if CHIP_IM_CLIENT_REPORT_TLV_INDEX_SIZE > 0
+    // The parsers below walk the report again for each field they look up and each struct whose schema they check.
+    // Index its containers once so that these walks jump over them. A report that cannot be indexed is malformed,
+    // which the parsers report.
+    TLV::TLVIndex::Entry indexEntries[CHIP_IM_CLIENT_REPORT_TLV_INDEX_SIZE];
+    TLV::TLVIndex index{ Span<TLV::TLVIndex::Entry>(indexEntries) };
+    if (index.Build(reader) == CHIP_NO_ERROR)
+    {
+        reader.SetIndex(&index);
+    }
+#endif // CHIP_IM_CLIENT_REPORT_TLV_INDEX_SIZE > 0
+
     err = report.Init(reader);
     SuccessOrExit(err);
 
@@ -935,6 +994,17 @@ CHIP_ERROR ReadClient::SendAutoResubscribeRequest(ReadPrepareParams && aReadPrep
     return err;
 }
 
+CHIP_ERROR ReadClient::SendAutoResubscribeRequest(ReadPrepareParams && aReadPrepareParams, System::PacketBufferHandle && aPayload)
+{
+    mReadPrepareParams = std::move(aReadPrepareParams);
+    CHIP_ERROR err     = SendRequest(mReadPrepareParams, std::move(aPayload));
+    if (err != CHIP_NO_ERROR)
+    {
+        StopResubscription();
+    }
+    return err;
+}
+
 CHIP_ERROR ReadClient::SendSubscribeRequest(const ReadPrepareParams & aReadPrepareParams)
 {
     VerifyOrReturnError(aReadPrepareParams.mMinIntervalFloorSeconds <= aReadPrepareParams.mMaxIntervalCeilingSeconds,
@@ -947,13 +1017,13 @@ CHIP_ERROR ReadClient::SendSubscribeRequestImpl(const ReadPrepareParams & aReadP
 {
     VerifyOrReturnError(ClientState::Idle == mState, CHIP_ERROR_INCORRECT_STATE);
 
-    if (&aReadPrepareParams != &mReadPrepareParams)
-    {
-        mReadPrepareParams.mSessionHolder = aReadPrepareParams.mSessionHolder;
-    }
-
-    mMinIntervalFloorSeconds = aReadPrepareParams.mMinIntervalFloorSeconds;
+    System::PacketBufferHandle msgBuf;
+    ReturnErrorOnFailure(BuildSubscribeRequest(aReadPrepareParams, msgBuf));
+    return SendSubscribeRequestImpl(aReadPrepareParams, std::move(msgBuf));
+}
 
+CHIP_ERROR ReadClient::BuildSubscribeRequest(const ReadPrepareParams & aReadPrepareParams, System::PacketBufferHandle & aMsgBuf)
+{
     // Todo: Remove the below, Update span in ReadPrepareParams
     Span<AttributePathParams> attributePaths(aReadPrepareParams.mpAttributePathParamsList,
                                              aReadPrepareParams.mAttributePathParamsListSize);
@@ -961,7 +1031,6 @@ CHIP_ERROR ReadClient::SendSubscribeRequestImpl(const ReadPrepareParams & aReadP
     Span<DataVersionFilter> dataVersionFilters(aReadPrepareParams.mpDataVersionFilterList,
                                                aReadPrepareParams.mDataVersionFilterListSize);
 
-    System::PacketBufferHandle msgBuf;
     System::PacketBufferTLVWriter writer;
     SubscribeRequestMessage::Builder request;
     InitWriterWithSpaceReserved(writer, kReservedSizeForTLVEncodingOverhead);
@@ -1018,7 +1087,17 @@ CHIP_ERROR ReadClient::SendSubscribeRequestImpl(const ReadPrepareParams & aReadP
     }
 
     ReturnErrorOnFailure(request.EndOfSubscribeRequestMessage().GetError());
-    ReturnErrorOnFailure(writer.Finalize(&msgBuf));
+    return writer.Finalize(&aMsgBuf);
+}
+
+CHIP_ERROR ReadClient::SendSubscribeRequestImpl(const ReadPrepareParams & aReadPrepareParams, System::PacketBufferHandle && aMsgBuf)
+{
+    if (&aReadPrepareParams != &mReadPrepareParams)
+    {
+        mReadPrepareParams.mSessionHolder = aReadPrepareParams.mSessionHolder;
+    }
+
+    mMinIntervalFloorSeconds = aReadPrepareParams.mMinIntervalFloorSeconds;
 
     VerifyOrReturnError(aReadPrepareParams.mSessionHolder, CHIP_ERROR_MISSING_SECURE_SESSION);
 
@@ -1045,7 +1124,7 @@ CHIP_ERROR ReadClient::SendSubscribeRequestImpl(const ReadPrepareParams & aReadP
         mExchange->SetResponseTimeout(aReadPrepareParams.mTimeout);
     }
 
-    ReturnErrorOnFailure(mExchange->SendMessage(Protocols::InteractionModel::MsgType::SubscribeRequest, std::move(msgBuf),
+    ReturnErrorOnFailure(mExchange->SendMessage(Protocols::InteractionModel::MsgType::SubscribeRequest, std::move(aMsgBuf),
                                                 Messaging::SendFlags(Messaging::SendMessageFlags::kExpectResponse)));
 
     mPeer = aReadPrepareParams.mSessionHolder->AsSecureSession()->GetPeer();
@@ -301,6 +301,21 @@ public:
      */
     CHIP_ERROR SendRequest(ReadPrepareParams & aReadPrepareParams);
 
+    /**
+     *  Encode the request SendRequest would send for aReadPrepareParams into aPayload, without sending it.
+     *
+     *  The encoded request does not depend on the session, so it can be sent (as a copy) by any number of
+     *  ReadClients of the same InteractionType through the SendRequest overload taking a payload, as long as
+     *  their callbacks provide the same data version filters and event number as this client's callback.
+     */
+    CHIP_ERROR EncodeRequest(ReadPrepareParams & aReadPrepareParams, System::PacketBufferHandle & aPayload);
+
+    /**
+     *  Like SendRequest, but sends aPayload, which must have been encoded by EncodeRequest with the same
+     *  aReadPrepareParams (except for the session), instead of encoding the request again.
+     */
+    CHIP_ERROR SendRequest(ReadPrepareParams & aReadPrepareParams, System::PacketBufferHandle && aPayload);
+
     void OnUnsolicitedReportData(Messaging::ExchangeContext * apExchangeContext, System::PacketBufferHandle && aPayload);
 
     void OnUnsolicitedMessageFromPublisher()
@@ -364,6 +379,12 @@ public:
      */
     CHIP_ERROR SendAutoResubscribeRequest(ReadPrepareParams && aReadPrepareParams);
 
+    /**
+     *  Like SendAutoResubscribeRequest, but the initial request is aPayload, encoded by EncodeRequest.  Re-subscriptions
+     *  encode a new request from the moved ReadPrepareParams.
+     */
+    CHIP_ERROR SendAutoResubscribeRequest(ReadPrepareParams && aReadPrepareParams, System::PacketBufferHandle && aPayload);
+
     /**
      *   This provides a standard re-subscription policy implementation that given a termination cause, does the following:
      *   - Calculates the time till next subscription with fibonacci back-off (implemented by ComputeTimeTillNextSubscription()).
@@ -486,10 +507,14 @@ private:
 
     // Specialized request-sending functions.
     CHIP_ERROR SendReadRequest(ReadPrepareParams & aReadPrepareParams);
+    CHIP_ERROR SendReadRequest(ReadPrepareParams & aReadPrepareParams, System::PacketBufferHandle && aMsgBuf);
     // SendSubscribeRequest performs som validation on aSubscribePrepareParams
     // and then calls SendSubscribeRequestImpl.
     CHIP_ERROR SendSubscribeRequest(const ReadPrepareParams & aSubscribePrepareParams);
     CHIP_ERROR SendSubscribeRequestImpl(const ReadPrepareParams & aSubscribePrepareParams);
+    CHIP_ERROR SendSubscribeRequestImpl(const ReadPrepareParams & aSubscribePrepareParams, System::PacketBufferHandle && aMsgBuf);
+    CHIP_ERROR BuildReadRequest(ReadPrepareParams & aReadPrepareParams, System::PacketBufferHandle & aMsgBuf);
+    CHIP_ERROR BuildSubscribeRequest(const ReadPrepareParams & aSubscribePrepareParams, System::PacketBufferHandle & aMsgBuf);
     void UpdateDataVersionFilters(const ConcreteDataAttributePath & aPath);
     static void OnResubscribeTimerCallback(System::Layer * apSystemLayer, void * apAppState);
     // Called to ensure OnReportBegin is called before calling OnEventData or OnAttributeData
@@ -425,6 +425,13 @@ private:
     // engine, the "oldest" subscription is the subscription with the smallest generation.
     uint64_t mTransactionStartGeneration = 0;
 
+    // The time the last report of this handler was completed, or the time the request was received if no report has been
+    // completed yet.  The reporting engine uses it to order handlers by their max interval deadline and to measure report latency.
+    System::Clock::Timestamp mLastReportTimestamp = System::Clock::kZero;
+
+    // The reporting engine run in which this handler was last serviced, to service each handler at most once per run.
+    uint32_t mLastServicedRun = 0;
+
     SubscriptionId mSubscriptionId    = 0;
     uint16_t mMinIntervalFloorSeconds = 0;
     uint16_t mMaxInterval             = 0;
@@ -0,0 +1,81 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/reporting/AttributeReportEncodeCache.h>
+
+#include <lib/support/CodeUtils.h>
+
+#include <string.h>
+
+#if CHIP_IM_SERVER_MAX_NUM_CACHED_ATTRIBUTE_REPORTS > 0
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+void AttributeReportEncodeCache::Clear()
+{
+    for (auto & entry : mEntries)
+    {
+        entry.mValid = false;
+    }
+}
+
+bool AttributeReportEncodeCache::Find(const ConcreteReadAttributePath & aPath, FabricIndex aFabricIndex, bool aIsFabricFiltered,
+                                      ByteSpan & aEncoded) const
+{
+    for (const auto & entry : mEntries)
+    {
+        if (entry.mValid && entry.mPath == aPath && entry.mPath.mExpanded == aPath.mExpanded &&
+            entry.mFabricIndex == aFabricIndex && entry.mIsFabricFiltered == aIsFabricFiltered)
+        {
+            aEncoded = ByteSpan(entry.mBuffer, entry.mLength);
+#if CONFIG_BUILD_FOR_HOST_UNIT_TEST
+            mHitCount++;
+#endif
+            return true;
+        }
+    }
+
+#if CONFIG_BUILD_FOR_HOST_UNIT_TEST
+    mMissCount++;
+#endif
+    return false;
+}
+
+void AttributeReportEncodeCache::Store(const ConcreteReadAttributePath & aPath, FabricIndex aFabricIndex, bool aIsFabricFiltered,
+                                       const ByteSpan & aEncoded)
+{
+    VerifyOrReturn(aEncoded.size() <= kEntrySize);
+
+    Entry & entry = mEntries[mNextEntry];
+    mNextEntry    = (mNextEntry + 1) % kNumEntries;
+
+    memcpy(entry.mBuffer, aEncoded.data(), aEncoded.size());
+    entry.mPath             = aPath;
+    entry.mFabricIndex      = aFabricIndex;
+    entry.mIsFabricFiltered = aIsFabricFiltered;
+    entry.mLength           = aEncoded.size();
+    entry.mValid            = true;
+}
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
+
+#endif // CHIP_IM_SERVER_MAX_NUM_CACHED_ATTRIBUTE_REPORTS > 0
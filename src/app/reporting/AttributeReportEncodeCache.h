@@ -0,0 +1,116 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines a cache of encoded attribute reports, shared by all the ReadHandlers serviced by the reporting engine.
+ *
+ */
+
+#pragma once
+
+#include <app/ConcreteAttributePath.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/support/Span.h>
+
+#if CHIP_IM_SERVER_MAX_NUM_CACHED_ATTRIBUTE_REPORTS > 0
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+/**
+ * AttributeReportEncodeCache keeps the encoded AttributeReportIBs of recently reported attributes, so that the reporting engine
+ * does not read and encode the same attribute once per ReadHandler when several subscribers are interested in the same path.
+ *
+ * An entry is keyed by the concrete path and by the fabric context it was encoded for: fabric-scoped and fabric-sensitive data are
+ * encoded differently depending on the accessing fabric and on whether the read is fabric filtered.  Access control is not part of
+ * the key; the caller must check access for each subject before using a cached encoding.
+ *
+ * The cache is stamped with the dirty set generation of the reporting engine, all entries are dropped as soon as any attribute is
+ * marked dirty, so a cached encoding always carries the current value and data version.
+ */
+class AttributeReportEncodeCache
+{
+public:
+    static constexpr size_t kNumEntries = CHIP_IM_SERVER_MAX_NUM_CACHED_ATTRIBUTE_REPORTS;
+    static constexpr size_t kEntrySize  = CHIP_IM_SERVER_CACHED_ATTRIBUTE_REPORT_SIZE;
+
+    /**
+     * Drop all the entries if they were encoded under a different dirty set generation.
+     */
+    void SetGeneration(uint64_t aGeneration)
+    {
+        if (aGeneration != mGeneration)
+        {
+            Clear();
+            mGeneration = aGeneration;
+        }
+    }
+
+    void Clear();
+
+    /**
+     * Look up the encoding of aPath for the given fabric context.
+     *
+     * @param[out] aEncoded  The encoded AttributeReportIB elements, only valid until the next call to Store, Clear or
+     *                       SetGeneration.
+     *
+     * @retval true if a cached encoding was found.
+     */
+    bool Find(const ConcreteReadAttributePath & aPath, FabricIndex aFabricIndex, bool aIsFabricFiltered, ByteSpan & aEncoded) const;
+
+    /**
+     * Keep a copy of the AttributeReportIB elements encoded for aPath in the given fabric context, in place of the least recently
+     * stored entry.  Encodings larger than an entry are not kept.
+     */
+    void Store(const ConcreteReadAttributePath & aPath, FabricIndex aFabricIndex, bool aIsFabricFiltered,
+               const ByteSpan & aEncoded);
+
+#if CONFIG_BUILD_FOR_HOST_UNIT_TEST
+    uint32_t GetHitCount() const { return mHitCount; }
+    uint32_t GetMissCount() const { return mMissCount; }
+#endif
+
+private:
+    struct Entry
+    {
+        ConcreteReadAttributePath mPath;
+        FabricIndex mFabricIndex = kUndefinedFabricIndex;
+        bool mIsFabricFiltered   = false;
+        bool mValid              = false;
+        size_t mLength           = 0;
+        uint8_t mBuffer[kEntrySize];
+    };
+
+    Entry mEntries[kNumEntries];
+    size_t mNextEntry    = 0;
+    uint64_t mGeneration = 0;
+
+#if CONFIG_BUILD_FOR_HOST_UNIT_TEST
+    mutable uint32_t mHitCount  = 0;
+    mutable uint32_t mMissCount = 0;
+#endif
+};
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
+
+#endif // CHIP_IM_SERVER_MAX_NUM_CACHED_ATTRIBUTE_REPORTS > 0
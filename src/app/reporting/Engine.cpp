@@ -37,7 +37,7 @@ namespace reporting {
 CHIP_ERROR Engine::Init()
 {
     mNumReportsInFlight = 0;
-    mCurReadHandlerIdx  = 0;
+    mRunCount           = 0;
     return CHIP_NO_ERROR;
 }
 
@@ -46,8 +46,9 @@ void Engine::Shutdown()
     // Flush out the event buffer synchronously
     ScheduleUrgentEventDeliverySync();
 
-    mNumReportsInFlight = 0;
-    mCurReadHandlerIdx  = 0;
+    mNumReportsInFlight   = 0;
+    mNumPendingDirtyPaths = 0;
+    mDirtyBatchDepth      = 0;
     mGlobalDirtySet.ReleaseAll();
 }
 
@@ -126,6 +127,9 @@ CHIP_ERROR Engine::BuildSingleReportDataAttributeReportIBs(ReportDataMessage::Bu
         uint32_t attributesRead = 0;
 #endif
 
+        // The data model may have changed since the previous chunk.
+        apReadHandler->GetAttributePathExpandIterator()->RefreshExpansionCache();
+
         // For each path included in the interested path of the read handler...
         for (; apReadHandler->GetAttributePathExpandIterator()->Get(readPath);
              apReadHandler->GetAttributePathExpandIterator()->Next())
@@ -177,8 +181,30 @@ CHIP_ERROR Engine::BuildSingleReportDataAttributeReportIBs(ReportDataMessage::Bu
             ConcreteReadAttributePath pathForRetrieval(readPath);
             // Load the saved state from previous encoding session for chunking of one single attribute (list chunking).
             AttributeValueEncoder::AttributeEncodeState encodeState = apReadHandler->GetAttributeEncodeState();
-            err = RetrieveClusterData(apReadHandler->GetSubjectDescriptor(), apReadHandler->IsFabricFiltered(), attributeReportIBs,
-                                      pathForRetrieval, &encodeState);
+#if CHIP_IM_SERVER_MAX_NUM_CACHED_ATTRIBUTE_REPORTS > 0
+            // Only attributes encoded from scratch can be shared, a list being chunked is specific to this read handler.
+            const bool shareEncoding = mUseEncodeCache && CanShareEncodedReports(*apReadHandler) &&
+                !encodeState.AllowPartialData() && IsSharedReadAllowed(apReadHandler, pathForRetrieval);
+            const uint32_t encodeStart = attributeReportIBs.GetWriter()->GetLengthWritten();
+
+            err = shareEncoding ? RetrieveClusterDataFromCache(apReadHandler, attributeReportIBs, pathForRetrieval)
+                                : CHIP_ERROR_KEY_NOT_FOUND;
+            if (err == CHIP_ERROR_KEY_NOT_FOUND)
+#endif
+            {
+                err = RetrieveClusterData(apReadHandler->GetSubjectDescriptor(), apReadHandler->IsFabricFiltered(),
+                                          attributeReportIBs, pathForRetrieval, &encodeState);
+#if CHIP_IM_SERVER_MAX_NUM_CACHED_ATTRIBUTE_REPORTS > 0
+                if (shareEncoding && err == CHIP_NO_ERROR)
+                {
+                    // Keep what was just encoded into the report for the other read handlers, rather than reading it again.
+                    const uint32_t encodeEnd = attributeReportIBs.GetWriter()->GetLengthWritten();
+                    mEncodeCache.Store(pathForRetrieval, apReadHandler->GetAccessingFabricIndex(),
+                                       apReadHandler->IsFabricFiltered(),
+                                       ByteSpan(mpReportData + encodeStart, encodeEnd - encodeStart));
+                }
+#endif
+            }
             if (err != CHIP_NO_ERROR)
             {
                 ChipLogError(DataManagement,
@@ -291,6 +317,39 @@ exit:
     return err;
 }
 
+#if CHIP_IM_SERVER_MAX_NUM_CACHED_ATTRIBUTE_REPORTS > 0
+bool Engine::IsSharedReadAllowed(ReadHandler * apReadHandler, const ConcreteReadAttributePath & aPath)
+{
+    // Access control depends on the subject, which is not part of the cache key, so it is checked for every read handler.  Denied
+    // paths are left to RetrieveClusterData, which knows whether a status needs to be reported for them.
+    Access::RequestPath requestPath{ .cluster = aPath.mClusterId, .endpoint = aPath.mEndpointId };
+    Access::Privilege requestPrivilege = RequiredPrivilege::ForReadAttribute(aPath);
+    return Access::GetAccessControl().Check(apReadHandler->GetSubjectDescriptor(), requestPath, requestPrivilege) == CHIP_NO_ERROR;
+}
+
+CHIP_ERROR Engine::RetrieveClusterDataFromCache(ReadHandler * apReadHandler, AttributeReportIBs::Builder & aAttributeReportIBs,
+                                                const ConcreteReadAttributePath & aPath)
+{
+    mEncodeCache.SetGeneration(GetDirtySetGeneration());
+
+    ByteSpan encoded;
+    VerifyOrReturnError(
+        mEncodeCache.Find(aPath, apReadHandler->GetAccessingFabricIndex(), apReadHandler->IsFabricFiltered(), encoded),
+        CHIP_ERROR_KEY_NOT_FOUND);
+
+    TLV::TLVReader reader;
+    CHIP_ERROR err;
+
+    reader.Init(encoded);
+    while ((err = reader.Next()) == CHIP_NO_ERROR)
+    {
+        // Running out of room is handled by the caller, as for RetrieveClusterData.
+        ReturnErrorOnFailure(aAttributeReportIBs.GetWriter()->CopyElement(reader));
+    }
+    return (err == CHIP_END_OF_TLV) ? CHIP_NO_ERROR : err;
+}
+#endif
+
 CHIP_ERROR Engine::CheckAccessDeniedEventPaths(TLV::TLVWriter & aWriter, bool & aHasEncodedData, ReadHandler * apReadHandler)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
@@ -475,6 +534,9 @@ CHIP_ERROR Engine::BuildAndSendSingleReportData(ReadHandler * apReadHandler)
         reservedSize = static_cast<uint16_t>(bufHandle->AvailableDataLength() - kMaxSecureSduLengthBytes);
     }
 
+#if CHIP_IM_SERVER_MAX_NUM_CACHED_ATTRIBUTE_REPORTS > 0
+    mpReportData = bufHandle->Start() + bufHandle->DataLength();
+#endif
     reportDataWriter.Init(std::move(bufHandle));
 
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
@@ -557,8 +619,8 @@ CHIP_ERROR Engine::BuildAndSendSingleReportData(ReadHandler * apReadHandler)
     VerifyOrExit(err == CHIP_NO_ERROR,
                  ChipLogError(DataManagement, "<RE> Error sending out report data with %" CHIP_ERROR_FORMAT "!", err.Format()));
 
-    ChipLogDetail(DataManagement, "<RE> ReportsInFlight = %" PRIu32 " with readHandler %" PRIu32 ", RE has %s", mNumReportsInFlight,
-                  mCurReadHandlerIdx, hasMoreChunks ? "more messages" : "no more messages");
+    ChipLogDetail(DataManagement, "<RE> ReportsInFlight = %" PRIu32 " with readHandler %p, RE has %s", mNumReportsInFlight,
+                  apReadHandler, hasMoreChunks ? "more messages" : "no more messages");
 
 exit:
     if (err != CHIP_NO_ERROR || (apReadHandler->IsType(ReadHandler::InteractionType::Read) && !hasMoreChunks) ||
@@ -609,48 +671,223 @@ CHIP_ERROR Engine::ScheduleRun()
     return CHIP_NO_ERROR;
 }
 
-void Engine::Run()
+Engine::ReportPriority Engine::GetReportPriority(const ReadHandler & aReadHandler) const
 {
-    uint32_t numReadHandled = 0;
+    ReportPriority priority;
+    priority.mDeadline = aReadHandler.mLastReportTimestamp;
+    if (aReadHandler.IsType(ReadHandler::InteractionType::Subscribe) && !aReadHandler.IsPriming())
+    {
+        priority.mDeadline += System::Clock::Seconds16(aReadHandler.mMaxInterval);
+    }
 
-    InteractionModelEngine * imEngine = InteractionModelEngine::GetInstance();
+    // Priming reports are never urgent, so that they cannot hold back subscriptions about to miss their max interval.
+    priority.mIsUrgent = !aReadHandler.IsPriming() &&
+        (aReadHandler.mFlags.Has(ReadHandler::ReadHandlerFlags::ForceDirty) ||
+         (aReadHandler.IsType(ReadHandler::InteractionType::Subscribe) && priority.mDeadline <= mReportCandidatesTimestamp));
+    return priority;
+}
+
+void Engine::CollectReportCandidates(System::Clock::Timestamp aNow)
+{
+    mReportCandidatesTimestamp = aNow;
+    mReportCandidatesTruncated = false;
+    memset(mNumReportCandidates, 0, sizeof(mNumReportCandidates));
+
+    InteractionModelEngine::GetInstance()->mReadHandlers.ForEachActiveObject([this](ReadHandler * handler) {
+        if (!handler->IsReportable() || handler->mLastServicedRun == mRunCount)
+        {
+            return Loop::Continue;
+        }
+
+        const size_t fabricSlot       = FabricSlot(handler->GetAccessingFabricIndex());
+        ReadHandler ** candidates     = mReportCandidates[fabricSlot];
+        uint8_t & numCandidates       = mNumReportCandidates[fabricSlot];
+        const ReportPriority priority = GetReportPriority(*handler);
+
+        size_t index = numCandidates;
+        while (index > 0 && priority.IsBefore(GetReportPriority(*candidates[index - 1])))
+        {
+            index--;
+        }
+
+        if (numCandidates == CHIP_IM_MAX_REPORTS_IN_FLIGHT)
+        {
+            // The last candidate of the fabric, or this handler, is left for a later collection.
+            mReportCandidatesTruncated = true;
+            VerifyOrReturnValue(index < numCandidates, Loop::Continue);
+        }
+        else
+        {
+            numCandidates++;
+        }
 
-    // We may be deallocating read handlers as we go.  Track how many we had
-    // initially, so we make sure to go through all of them.
-    size_t initialAllocated = imEngine->mReadHandlers.Allocated();
-    while ((mNumReportsInFlight < CHIP_IM_MAX_REPORTS_IN_FLIGHT) && (numReadHandled < initialAllocated))
+        for (size_t i = numCandidates - 1; i > index; i--)
+        {
+            candidates[i] = candidates[i - 1];
+        }
+        candidates[index] = handler;
+        return Loop::Continue;
+    });
+}
+
+void Engine::RemoveReportCandidate(size_t aFabricSlot, size_t aIndex)
+{
+    ReadHandler ** candidates = mReportCandidates[aFabricSlot];
+    uint8_t & numCandidates   = mNumReportCandidates[aFabricSlot];
+    for (size_t i = aIndex + 1; i < numCandidates; i++)
     {
-        ReadHandler * readHandler = imEngine->ActiveHandlerAt(mCurReadHandlerIdx % (uint32_t) imEngine->mReadHandlers.Allocated());
-        VerifyOrDie(readHandler != nullptr);
+        candidates[i - 1] = candidates[i];
+    }
+    numCandidates--;
+}
 
-        if (readHandler->IsReportable())
+void Engine::ResetReadHandlerTracker(ReadHandler * apReadHandlerBeingDeleted)
+{
+    for (size_t fabricSlot = 0; fabricSlot < ArraySize(mNumReportCandidates); fabricSlot++)
+    {
+        for (size_t i = 0; i < mNumReportCandidates[fabricSlot]; i++)
         {
-            mRunningReadHandler = readHandler;
-            CHIP_ERROR err      = BuildAndSendSingleReportData(readHandler);
-            mRunningReadHandler = nullptr;
-            if (err != CHIP_NO_ERROR)
+            if (mReportCandidates[fabricSlot][i] == apReadHandlerBeingDeleted)
             {
+                RemoveReportCandidate(fabricSlot, i);
                 return;
             }
         }
+    }
+}
+
+ReadHandler * Engine::NextReadHandlerToReport()
+{
+    ReadHandler * next         = nullptr;
+    size_t nextFabricSlot      = 0;
+    uint16_t nextFabricReports = 0;
+    ReportPriority nextPriority = { false, System::Clock::kZero };
+
+    // The first candidate of each fabric is the one it should have serviced next.
+    for (size_t fabricSlot = 0; fabricSlot < ArraySize(mNumReportCandidates); fabricSlot++)
+    {
+        if (mNumReportCandidates[fabricSlot] == 0)
+        {
+            continue;
+        }
 
-        numReadHandled++;
-        // If readHandler removed itself from our list, we also decremented
-        // mCurReadHandlerIdx to account for that removal, so it's safe to
-        // increment here.
-        mCurReadHandlerIdx++;
+        ReadHandler * handler         = mReportCandidates[fabricSlot][0];
+        const ReportPriority priority = GetReportPriority(*handler);
+        const uint16_t fabricReports  = mReportsPerFabricInRun[fabricSlot];
+
+        bool isBetter;
+        if (next == nullptr || priority.mIsUrgent != nextPriority.mIsUrgent)
+        {
+            isBetter = (next == nullptr) || priority.mIsUrgent;
+        }
+        else if (fabricReports != nextFabricReports)
+        {
+            isBetter = fabricReports < nextFabricReports;
+        }
+        else
+        {
+            isBetter = priority.mDeadline < nextPriority.mDeadline;
+        }
+
+        if (isBetter)
+        {
+            next              = handler;
+            nextFabricSlot    = fabricSlot;
+            nextFabricReports = fabricReports;
+            nextPriority      = priority;
+        }
     }
 
-    //
-    // If our tracker has exceeded the bounds of the handler list, reset it back to 0.
-    // This isn't strictly necessary, but does make it easier to debug issues in this code if they
-    // do arise.
-    //
-    if (mCurReadHandlerIdx >= imEngine->mReadHandlers.Allocated())
+    if (next != nullptr)
+    {
+        RemoveReportCandidate(nextFabricSlot, 0);
+        return next;
+    }
+
+    if (mReportCandidatesTruncated)
     {
-        mCurReadHandlerIdx = 0;
+        // More reports were started in this run than there were candidates kept, gather the handlers left out.
+        CollectReportCandidates(mReportCandidatesTimestamp);
+        return NextReadHandlerToReport();
     }
 
+    return nullptr;
+}
+
+void Engine::RecordReportLatency(const ReadHandler & aReadHandler, System::Clock::Timestamp aNow)
+{
+    // Only measure the start of a report of an established subscription, chunks and priming reports are driven by the client.
+    VerifyOrReturn(aReadHandler.IsType(ReadHandler::InteractionType::Subscribe) && !aReadHandler.IsPriming() &&
+                   !aReadHandler.IsReporting());
+
+    const System::Clock::Milliseconds32 elapsed =
+        std::chrono::duration_cast<System::Clock::Milliseconds32>(aNow - aReadHandler.mLastReportTimestamp);
+    const System::Clock::Milliseconds32 maxInterval = System::Clock::Seconds16(aReadHandler.mMaxInterval);
+
+    mReportLatencyStats.mNumReports++;
+    if (elapsed > maxInterval)
+    {
+        mReportLatencyStats.mNumMaxIntervalMisses++;
+        if (elapsed - maxInterval > mReportLatencyStats.mWorstMaxIntervalOverrun)
+        {
+            mReportLatencyStats.mWorstMaxIntervalOverrun = elapsed - maxInterval;
+        }
+    }
+
+#if CHIP_CONFIG_IM_REPORT_LATENCY_LOGGING
+    ChipLogDetail(DataManagement, "<RE> Subscription %" PRIx32 " reporting %" PRIu32 "ms after its last report (min %us, max %us)",
+                  aReadHandler.mSubscriptionId, elapsed.count(), aReadHandler.mMinIntervalFloorSeconds, aReadHandler.mMaxInterval);
+#endif
+}
+
+void Engine::Run()
+{
+    InteractionModelEngine * imEngine = InteractionModelEngine::GetInstance();
+
+#if CHIP_IM_SERVER_MAX_NUM_CACHED_ATTRIBUTE_REPORTS > 0
+    // Sharing encoded attribute reports only pays off if more than one subscription is going to report changes in this run.
+    size_t numReportable = 0;
+    imEngine->mReadHandlers.ForEachActiveObject([&numReportable](ReadHandler * handler) {
+        if (handler->IsReportable() && CanShareEncodedReports(*handler))
+        {
+            numReportable++;
+        }
+        return Loop::Continue;
+    });
+    mUseEncodeCache = (numReportable > 1);
+    mEncodeCache.Clear();
+#endif
+
+    // Each read handler is serviced at most once per run, handlers that have more chunks to send get serviced again in a later
+    // run once their report is confirmed.
+    mRunCount++;
+    memset(mReportsPerFabricInRun, 0, sizeof(mReportsPerFabricInRun));
+    CollectReportCandidates(System::SystemClock().GetMonotonicTimestamp());
+
+    while (mNumReportsInFlight < CHIP_IM_MAX_REPORTS_IN_FLIGHT)
+    {
+        ReadHandler * readHandler = NextReadHandlerToReport();
+        if (readHandler == nullptr)
+        {
+            break;
+        }
+
+        // The read handler may be released while building the report, grab what we need beforehand.
+        const size_t fabricSlot       = FabricSlot(readHandler->GetAccessingFabricIndex());
+        readHandler->mLastServicedRun = mRunCount;
+        RecordReportLatency(*readHandler, System::SystemClock().GetMonotonicTimestamp());
+
+        CHIP_ERROR err = BuildAndSendSingleReportData(readHandler);
+        if (err != CHIP_NO_ERROR)
+        {
+            ReleaseEncodeCache();
+            return;
+        }
+        mReportsPerFabricInRun[fabricSlot]++;
+    }
+
+    ReleaseEncodeCache();
+
     bool allReadClean = true;
 
     imEngine->mReadHandlers.ForEachActiveObject([&allReadClean](ReadHandler * handler) {
@@ -671,6 +908,14 @@ void Engine::Run()
     }
 }
 
+void Engine::ReleaseEncodeCache()
+{
+#if CHIP_IM_SERVER_MAX_NUM_CACHED_ATTRIBUTE_REPORTS > 0
+    mUseEncodeCache = false;
+    mEncodeCache.Clear();
+#endif
+}
+
 bool Engine::MergeOverlappedAttributePath(const AttributePathParams & aAttributePath)
 {
     return Loop::Break == mGlobalDirtySet.ForEachActiveObject([&](auto * path) {
@@ -808,39 +1053,107 @@ CHIP_ERROR Engine::InsertPathIntoDirtySet(const AttributePathParams & aAttribute
 
 CHIP_ERROR Engine::SetDirty(AttributePathParams & aAttributePath)
 {
+    if (IsDirtyBatchOpen())
+    {
+        return AddPendingDirtyPath(aAttributePath);
+    }
+
+    return SetDirty(Span<const AttributePathParams>(&aAttributePath, 1));
+}
+
+CHIP_ERROR Engine::SetDirty(const Span<const AttributePathParams> & aAttributePaths)
+{
+    ReturnErrorCodeIf(aAttributePaths.empty(), CHIP_NO_ERROR);
+
     BumpDirtySetGeneration();
 
-    bool intersectsInterestPath = false;
-    InteractionModelEngine::GetInstance()->mReadHandlers.ForEachActiveObject(
-        [&aAttributePath, &intersectsInterestPath](ReadHandler * handler) {
-            // We call SetDirty for both read interactions and subscribe interactions, since we may send inconsistent attribute data
-            // between two chunks. SetDirty will be ignored automatically by read handlers which are waiting for a response to the
-            // last message chunk for read interactions.
-            if (handler->IsGeneratingReports() || handler->IsAwaitingReportResponse())
-            {
-                for (auto object = handler->GetAttributePathList(); object != nullptr; object = object->mpNext)
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    for (const auto & changedPath : aAttributePaths)
+    {
+        bool intersectsInterestPath = false;
+        InteractionModelEngine::GetInstance()->mReadHandlers.ForEachActiveObject(
+            [&changedPath, &intersectsInterestPath](ReadHandler * handler) {
+                // We call SetDirty for both read interactions and subscribe interactions, since we may send inconsistent attribute
+                // data between two chunks. SetDirty will be ignored automatically by read handlers which are waiting for a response
+                // to the last message chunk for read interactions.
+                if (handler->IsGeneratingReports() || handler->IsAwaitingReportResponse())
                 {
-                    if (object->mValue.Intersects(aAttributePath))
+                    for (auto object = handler->GetAttributePathList(); object != nullptr; object = object->mpNext)
                     {
-                        handler->SetDirty(aAttributePath);
-                        intersectsInterestPath = true;
-                        break;
+                        if (object->mValue.Intersects(changedPath))
+                        {
+                            handler->SetDirty(changedPath);
+                            intersectsInterestPath = true;
+                            break;
+                        }
                     }
                 }
-            }
 
-            return Loop::Continue;
-        });
+                return Loop::Continue;
+            });
+
+        if (!intersectsInterestPath)
+        {
+            continue;
+        }
 
-    if (!intersectsInterestPath)
+        // Keep going on failure, so that the other changed paths still make it into the global dirty set.
+        CHIP_ERROR insertErr = InsertPathIntoDirtySet(changedPath);
+        if (err == CHIP_NO_ERROR)
+        {
+            err = insertErr;
+        }
+    }
+
+    return err;
+}
+
+CHIP_ERROR Engine::AddPendingDirtyPath(const AttributePathParams & aAttributePath)
+{
+    for (size_t i = 0; i < mNumPendingDirtyPaths; i++)
     {
-        return CHIP_NO_ERROR;
+        AttributePathParams & pendingPath = mPendingDirtyPaths[i];
+        if (pendingPath.IsAttributePathSupersetOf(aAttributePath))
+        {
+            return CHIP_NO_ERROR;
+        }
+        if (aAttributePath.IsAttributePathSupersetOf(pendingPath))
+        {
+            // The new path may cover more than one pending path, the remaining ones are harmless duplicates that will be merged
+            // into this one when inserted into the global dirty set.
+            pendingPath = aAttributePath;
+            return CHIP_NO_ERROR;
+        }
+    }
+
+    if (mNumPendingDirtyPaths == ArraySize(mPendingDirtyPaths))
+    {
+        ReturnErrorOnFailure(FlushPendingDirtyPaths());
     }
-    ReturnErrorOnFailure(InsertPathIntoDirtySet(aAttributePath));
 
+    mPendingDirtyPaths[mNumPendingDirtyPaths++] = aAttributePath;
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR Engine::FlushPendingDirtyPaths()
+{
+    Span<const AttributePathParams> pendingPaths(mPendingDirtyPaths, mNumPendingDirtyPaths);
+    mNumPendingDirtyPaths = 0;
+    return SetDirty(pendingPaths);
+}
+
+CHIP_ERROR Engine::EndDirtyBatch()
+{
+    VerifyOrReturnError(mDirtyBatchDepth > 0, CHIP_ERROR_INCORRECT_STATE);
+
+    if (--mDirtyBatchDepth > 0)
+    {
+        return CHIP_NO_ERROR;
+    }
+
+    return FlushPendingDirtyPaths();
+}
+
 CHIP_ERROR Engine::SendReport(ReadHandler * apReadHandler, System::PacketBufferHandle && aPayload, bool aHasMoreChunks)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
@@ -975,3 +1288,7 @@ void __attribute__((weak)) MatterPostAttributeReadCallback(const chip::app::Conc
 void __attribute__((weak))
 MatterReportingAttributeChangeCallback(chip::EndpointId endpoint, chip::ClusterId clusterId, chip::AttributeId attributeId)
 {}
+
+void __attribute__((weak))
+MatterReportingAttributeChangeCallback(const chip::Span<const chip::app::ConcreteAttributePath> & aPaths)
+{}
@@ -27,6 +27,7 @@
 #include <access/AccessControl.h>
 #include <app/MessageDef/ReportDataMessage.h>
 #include <app/ReadHandler.h>
+#include <app/reporting/AttributeReportEncodeCache.h>
 #include <app/util/basic-types.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/support/CodeUtils.h>
@@ -89,6 +90,28 @@ public:
      */
     CHIP_ERROR SetDirty(AttributePathParams & aAttributePathParams);
 
+    /**
+     * Application marks a set of mutated paths in one pass.  The dirty set generation is bumped once for the whole set, the read
+     * handlers are walked once, and at most one engine run is scheduled.
+     */
+    CHIP_ERROR SetDirty(const Span<const AttributePathParams> & aAttributePaths);
+
+    /**
+     * Open a batch of attribute changes.  While a batch is open, SetDirty only records the path into a small pending buffer in
+     * which overlapping paths are coalesced.  The pending paths are flushed through the bulk SetDirty when the outermost batch is
+     * closed, or earlier if the pending buffer runs out of space.  Batches may be nested.
+     *
+     * Prefer ScopedDirtyBatch over calling BeginDirtyBatch / EndDirtyBatch directly.
+     */
+    void BeginDirtyBatch() { mDirtyBatchDepth++; }
+
+    /**
+     * Close a batch opened by BeginDirtyBatch, flushing the pending paths if this was the outermost batch.
+     */
+    CHIP_ERROR EndDirtyBatch();
+
+    bool IsDirtyBatchOpen() const { return mDirtyBatchDepth > 0; }
+
     /**
      * @brief
      *  Schedule the event delivery
@@ -96,32 +119,29 @@ public:
      */
     CHIP_ERROR ScheduleEventDelivery(ConcreteEventPath & aPath, uint32_t aBytesWritten);
 
-    /*
-     * Resets the tracker that tracks the currently serviced read handler.
-     * apReadHandler can be non-null to indicate that the reset is due to a
-     * specific ReadHandler being deallocated.
+    /**
+     * Statistics on how subscription reports are delivered with respect to the max interval negotiated for the subscription.
+     * Only reports that follow the priming reports of a subscription are counted.
      */
-    void ResetReadHandlerTracker(ReadHandler * apReadHandlerBeingDeleted)
+    struct ReportLatencyStats
     {
-        if (apReadHandlerBeingDeleted == mRunningReadHandler)
-        {
-            // Just decrement, so our increment after we finish running it will
-            // do the right thing.
-            --mCurReadHandlerIdx;
-        }
-        else
-        {
-            // No idea what to do here to make the indexing sane.  Just start at
-            // the beginning.  We need to do better here; see
-            // https://github.com/project-chip/connectedhomeip/issues/13809
-            mCurReadHandlerIdx = 0;
-        }
-    }
+        uint32_t mNumReports           = 0; ///< Number of subscription reports started.
+        uint32_t mNumMaxIntervalMisses = 0; ///< Number of reports started after the max interval had elapsed.
+        System::Clock::Milliseconds32 mWorstMaxIntervalOverrun = System::Clock::kZero;
+    };
+
+    const ReportLatencyStats & GetReportLatencyStats() const { return mReportLatencyStats; }
+    void ResetReportLatencyStats() { mReportLatencyStats = ReportLatencyStats(); }
 
     uint32_t GetNumReportsInFlight() const { return mNumReportsInFlight; }
 
     uint64_t GetDirtySetGeneration() const { return mDirtyGeneration; }
 
+    /**
+     * Forget about a read handler that is being deallocated, so that the current run does not try to service it.
+     */
+    void ResetReadHandlerTracker(ReadHandler * apReadHandlerBeingDeleted);
+
     /**
      * Schedule event delivery to happen immediately and run reporting to get
      * those reports into messages and on the wire.  This can be done either for
@@ -150,6 +170,51 @@ private:
         uint64_t mGeneration = 0;
     };
 
+    /**
+     * How soon a read handler should be serviced, fabric fairness aside.
+     */
+    struct ReportPriority
+    {
+        bool mIsUrgent;
+        System::Clock::Timestamp mDeadline;
+
+        bool IsBefore(const ReportPriority & aOther) const
+        {
+            return (mIsUrgent != aOther.mIsUrgent) ? mIsUrgent : (mDeadline < aOther.mDeadline);
+        }
+    };
+
+    ReportPriority GetReportPriority(const ReadHandler & aReadHandler) const;
+
+    /**
+     * Gather the reportable read handlers that have not been serviced in the current run yet, as of aNow.  Only the first
+     * CHIP_IM_MAX_REPORTS_IN_FLIGHT handlers of each fabric are kept, since no more reports than that can be started at once.
+     */
+    void CollectReportCandidates(System::Clock::Timestamp aNow);
+
+    void RemoveReportCandidate(size_t aFabricSlot, size_t aIndex);
+
+    /**
+     * Pick the read handler that should be serviced next among the ones gathered by CollectReportCandidates, or nullptr if every
+     * reportable handler has already been serviced in this run.
+     *
+     * Handlers are ordered by:
+     *   1. urgency: subscriptions with urgent events pending, or which have reached their max interval deadline, come first;
+     *   2. fabric fairness: handlers of fabrics which got fewer reports in this run come first;
+     *   3. deadline: the end of the max interval for established subscriptions, the time the request was received otherwise.
+     */
+    ReadHandler * NextReadHandlerToReport();
+
+    /**
+     * Record how late the report apReadHandler is about to start is with respect to its reporting intervals.
+     */
+    void RecordReportLatency(const ReadHandler & aReadHandler, System::Clock::Timestamp aNow);
+
+    static size_t FabricSlot(FabricIndex aFabricIndex)
+    {
+        return (aFabricIndex <= CHIP_CONFIG_MAX_FABRICS) ? aFabricIndex : kUndefinedFabricIndex;
+    }
+
     /**
      * Build Single Report Data including attribute changes and event data stream, and send out
      *
@@ -164,6 +229,37 @@ private:
                                    AttributeReportIBs::Builder & aAttributeReportIBs,
                                    const ConcreteReadAttributePath & aClusterInfo,
                                    AttributeValueEncoder::AttributeEncodeState * apEncoderState);
+#if CHIP_IM_SERVER_MAX_NUM_CACHED_ATTRIBUTE_REPORTS > 0
+    /**
+     * Whether the reports of aReadHandler can share encoded attributes with other read handlers.  Only established subscriptions
+     * reporting changes do: a read or a priming report has to observe the attribute values as they are when it is processed.
+     */
+    static bool CanShareEncodedReports(const ReadHandler & aReadHandler)
+    {
+        return aReadHandler.IsType(ReadHandler::InteractionType::Subscribe) && !aReadHandler.IsPriming();
+    }
+
+    /**
+     * Whether apReadHandler may read the attribute at aPath, and so use an encoding shared with the other read handlers.
+     */
+    static bool IsSharedReadAllowed(ReadHandler * apReadHandler, const ConcreteReadAttributePath & aPath);
+
+    /**
+     * Encode the attribute at aPath for apReadHandler by copying an encoding shared with the other read handlers serviced in this
+     * run.
+     *
+     * @retval #CHIP_ERROR_KEY_NOT_FOUND if no encoding is shared yet: the caller is expected to encode the attribute with
+     *         RetrieveClusterData and store the result in the cache.
+     */
+    CHIP_ERROR RetrieveClusterDataFromCache(ReadHandler * apReadHandler, AttributeReportIBs::Builder & aAttributeReportIBs,
+                                            const ConcreteReadAttributePath & aPath);
+#endif
+
+    /**
+     * Stop sharing encoded attribute reports, called at the end of each run.
+     */
+    void ReleaseEncodeCache();
+
     CHIP_ERROR CheckAccessDeniedEventPaths(TLV::TLVWriter & aWriter, bool & aHasEncodedData, ReadHandler * apReadHandler);
 
     // If version match, it means don't send, if version mismatch, it means send.
@@ -222,6 +318,17 @@ private:
 
     CHIP_ERROR InsertPathIntoDirtySet(const AttributePathParams & aAttributePath);
 
+    /**
+     * Record a path into the pending buffer of the currently open batch, coalescing it with any overlapping pending path.  The
+     * pending buffer is flushed first if there is no room left for the new path.
+     */
+    CHIP_ERROR AddPendingDirtyPath(const AttributePathParams & aAttributePath);
+
+    /**
+     * Flush the pending paths of the current batch through the bulk SetDirty.
+     */
+    CHIP_ERROR FlushPendingDirtyPaths();
+
     inline void BumpDirtySetGeneration() { mDirtyGeneration++; }
 
     /**
@@ -238,15 +345,26 @@ private:
     uint32_t mNumReportsInFlight = 0;
 
     /**
-     *  Current read handler index
-     *
+     * Number of runs so far, used to service each read handler at most once per run.
+     */
+    uint32_t mRunCount = 0;
+
+    /**
+     * Number of reports sent to each fabric in the current run.  Fabric indices beyond CHIP_CONFIG_MAX_FABRICS share the slot of
+     * kUndefinedFabricIndex.
      */
-    uint32_t mCurReadHandlerIdx = 0;
+    uint16_t mReportsPerFabricInRun[CHIP_CONFIG_MAX_FABRICS + 1];
 
     /**
-     * The read handler we're calling BuildAndSendSingleReportData on right now.
+     * Read handlers left to service in the current run for each fabric, in the same slots as mReportsPerFabricInRun, ordered by
+     * urgency and deadline.
      */
-    ReadHandler * mRunningReadHandler = nullptr;
+    ReadHandler * mReportCandidates[CHIP_CONFIG_MAX_FABRICS + 1][CHIP_IM_MAX_REPORTS_IN_FLIGHT];
+    uint8_t mNumReportCandidates[CHIP_CONFIG_MAX_FABRICS + 1] = {};
+    bool mReportCandidatesTruncated = false; ///< Whether some reportable read handlers did not fit in mReportCandidates
+    System::Clock::Timestamp mReportCandidatesTimestamp;
+
+    ReportLatencyStats mReportLatencyStats;
 
     /**
      *  mGlobalDirtySet is used to track the set of attribute/event paths marked dirty for reporting purposes.
@@ -273,12 +391,62 @@ private:
      */
     uint64_t mDirtyGeneration = 1;
 
+#if CHIP_IM_SERVER_MAX_NUM_CACHED_ATTRIBUTE_REPORTS > 0
+    /**
+     * Encoded attribute reports shared between the read handlers serviced in one run.  Only used when more than one subscription
+     * reporting changes is reportable at the start of the run.
+     */
+    AttributeReportEncodeCache mEncodeCache;
+    bool mUseEncodeCache = false;
+    // Start of the single buffer the report being built is encoded into, where attributes are copied from to mEncodeCache.
+    const uint8_t * mpReportData = nullptr;
+#endif
+
+    /**
+     * Paths marked dirty while a batch is open, see BeginDirtyBatch.
+     */
+    AttributePathParams mPendingDirtyPaths[CHIP_IM_SERVER_MAX_NUM_PENDING_DIRTY_PATHS];
+    size_t mNumPendingDirtyPaths = 0;
+    uint32_t mDirtyBatchDepth    = 0;
+
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
     uint32_t mReservedSize          = 0;
     uint32_t mMaxAttributesPerChunk = UINT32_MAX;
 #endif
 };
 
+/**
+ * RAII helper that keeps a batch of attribute changes open on the reporting engine for its lifetime, e.g. while a bridge applies a
+ * burst of updates received from its bridged devices:
+ *
+ *     {
+ *         reporting::ScopedDirtyBatch batch(InteractionModelEngine::GetInstance()->GetReportingEngine());
+ *         for (auto & update : updates)
+ *         {
+ *             MatterReportingAttributeChangeCallback(update.mEndpointId, update.mClusterId, update.mAttributeId);
+ *         }
+ *     }
+ */
+class ScopedDirtyBatch
+{
+public:
+    explicit ScopedDirtyBatch(Engine & aEngine) : mEngine(aEngine) { mEngine.BeginDirtyBatch(); }
+    ~ScopedDirtyBatch()
+    {
+        CHIP_ERROR err = mEngine.EndDirtyBatch();
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(DataManagement, "Failed to flush the batched dirty paths: %" CHIP_ERROR_FORMAT, err.Format());
+        }
+    }
+
+    ScopedDirtyBatch(const ScopedDirtyBatch &) = delete;
+    ScopedDirtyBatch & operator=(const ScopedDirtyBatch &) = delete;
+
+private:
+    Engine & mEngine;
+};
+
 }; // namespace reporting
 }; // namespace app
 }; // namespace chip
@@ -18,6 +18,7 @@
 #pragma once
 
 #include <app/ConcreteAttributePath.h>
+#include <lib/support/Span.h>
 
 /** @brief Reporting Attribute Change
  *
@@ -33,6 +34,12 @@ void MatterReportingAttributeChangeCallback(chip::EndpointId endpoint, chip::Clu
  */
 void MatterReportingAttributeChangeCallback(const chip::app::ConcreteAttributePath & aPath);
 
+/*
+ * Same but for a set of attributes that changed together, e.g. a bridge applying a burst of updates from its bridged devices.  The
+ * data version of each affected cluster is increased once and the reporting engine is marked dirty in a single pass.
+ */
+void MatterReportingAttributeChangeCallback(const chip::Span<const chip::app::ConcreteAttributePath> & aPaths);
+
 /*
  * Same but only with an EndpointId, this is used when adding / enabling an endpoint during runtime.
  */
@@ -144,7 +144,11 @@ CHIP_ERROR Server::Init(const ServerInitParams & initParams)
     // Set up attribute persistence before we try to bring up the data model
     // handler.
     SuccessOrExit(mAttributePersister.Init(mDeviceStorage));
+#if CHIP_CONFIG_ATTRIBUTE_WRITE_COALESCING_DELAY_MS > 0
+    SetAttributePersistenceProvider(&mCoalescingAttributePersister);
+#else
     SetAttributePersistenceProvider(&mAttributePersister);
+#endif // CHIP_CONFIG_ATTRIBUTE_WRITE_COALESCING_DELAY_MS > 0
 
     {
         FabricTable::InitParams fabricTableInitParams;
@@ -411,6 +415,10 @@ void Server::ScheduleFactoryReset()
         // Delete all fabrics and emit Leave event.
         GetInstance().GetFabricTable().DeleteAllFabrics();
         PlatformMgr().HandleServerShuttingDown();
+#if CHIP_CONFIG_ATTRIBUTE_WRITE_COALESCING_DELAY_MS > 0
+        // Pending values written after the storage is erased would outlive the factory reset.
+        GetInstance().mCoalescingAttributePersister.Discard();
+#endif // CHIP_CONFIG_ATTRIBUTE_WRITE_COALESCING_DELAY_MS > 0
         ConfigurationMgr().InitiateFactoryReset();
     });
 }
@@ -432,6 +440,9 @@ void Server::Shutdown()
     mAccessControl.Finish();
     Access::ResetAccessControlToDefault();
     Credentials::SetGroupDataProvider(nullptr);
+#if CHIP_CONFIG_ATTRIBUTE_WRITE_COALESCING_DELAY_MS > 0
+    mCoalescingAttributePersister.Flush();
+#endif // CHIP_CONFIG_ATTRIBUTE_WRITE_COALESCING_DELAY_MS > 0
     mAttributePersister.Shutdown();
     // TODO(16969): Remove chip::Platform::MemoryInit() call from Server class, it belongs to outer code
     chip::Platform::MemoryShutdown();
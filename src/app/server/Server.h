@@ -23,6 +23,7 @@
 #include <access/examples/ExampleAccessControlDelegate.h>
 #include <app/CASEClientPool.h>
 #include <app/CASESessionManager.h>
+#include <app/CoalescingAttributePersistenceProvider.h>
 #include <app/DefaultAttributePersistenceProvider.h>
 #include <app/FailSafeContext.h>
 #include <app/OperationalSessionSetupPool.h>
@@ -342,6 +343,10 @@ public:
 
     app::DefaultAttributePersistenceProvider & GetDefaultAttributePersister() { return mAttributePersister; }
 
+#if CHIP_CONFIG_ATTRIBUTE_WRITE_COALESCING_DELAY_MS > 0
+    app::CoalescingAttributePersistenceProvider & GetCoalescingAttributePersister() { return mCoalescingAttributePersister; }
+#endif // CHIP_CONFIG_ATTRIBUTE_WRITE_COALESCING_DELAY_MS > 0
+
     /**
      * This function send the ShutDown event before stopping
      * the event loop.
@@ -508,6 +513,13 @@ private:
     Credentials::CertificateValidityPolicy * mCertificateValidityPolicy;
     Credentials::GroupDataProvider * mGroupsProvider;
     app::DefaultAttributePersistenceProvider mAttributePersister;
+#if CHIP_CONFIG_ATTRIBUTE_WRITE_COALESCING_DELAY_MS > 0
+    app::CoalescingAttributePersistenceProvider::Entry mCoalescingEntries[CHIP_CONFIG_ATTRIBUTE_WRITE_COALESCING_TABLE_SIZE];
+    app::CoalescingAttributePersistenceProvider mCoalescingAttributePersister{
+        mAttributePersister, Span<app::CoalescingAttributePersistenceProvider::Entry>(mCoalescingEntries),
+        System::Clock::Milliseconds32(CHIP_CONFIG_ATTRIBUTE_WRITE_COALESCING_DELAY_MS)
+    };
+#endif // CHIP_CONFIG_ATTRIBUTE_WRITE_COALESCING_DELAY_MS > 0
     GroupDataProviderListener mListener;
     ServerFabricDelegate mFabricDelegate;
 
@@ -0,0 +1,222 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Measures the time taken at startup to load the persisted attribute values of 1, 10 and 100
+ *      endpoints, as emAfLoadAttributeDefaults does, through DefaultAttributePersistenceProvider
+ *      over the INI file storage of the Linux platform.
+ *
+ *      Usage: attribute-persistence-benchmark [runs]
+ */
+
+#include <app-common/zap-generated/attribute-type.h>
+#include <app/DefaultAttributePersistenceProvider.h>
+#include <lib/core/CHIPPersistentStorageDelegate.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <platform/Linux/CHIPLinuxStorage.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::app;
+
+constexpr size_t kDefaultRuns           = 5;
+constexpr uint16_t kEndpointCounts[]    = { 1, 10, 100 };
+constexpr uint8_t kClustersPerEndpoint  = 8;
+constexpr size_t kOtherPersistedEntries = 64;
+
+// A cluster with 12 attributes, 4 of them persisted; all but one of those have a stored value.
+const EmberAfAttributeMetadata kAttributes[] = {
+    { uint32_t(0), 0x0000, 1, ZCL_INT8U_ATTRIBUTE_TYPE, ATTRIBUTE_MASK_NONVOLATILE },
+    { uint32_t(0), 0x0001, 2, ZCL_INT16U_ATTRIBUTE_TYPE, 0 },
+    { uint32_t(0), 0x0002, 2, ZCL_INT16U_ATTRIBUTE_TYPE, ATTRIBUTE_MASK_NONVOLATILE },
+    { uint32_t(0), 0x0003, 4, ZCL_INT32U_ATTRIBUTE_TYPE, 0 },
+    { uint32_t(0), 0x0004, 33, ZCL_CHAR_STRING_ATTRIBUTE_TYPE, ATTRIBUTE_MASK_NONVOLATILE },
+    { uint32_t(0), 0x0005, 1, ZCL_BOOLEAN_ATTRIBUTE_TYPE, 0 },
+    { uint32_t(0), 0x0006, 1, ZCL_ENUM8_ATTRIBUTE_TYPE, 0 },
+    { uint32_t(0), 0x0007, 2, ZCL_INT16U_ATTRIBUTE_TYPE, 0 },
+    { uint32_t(0), 0x0008, 4, ZCL_INT32U_ATTRIBUTE_TYPE, ATTRIBUTE_MASK_NONVOLATILE },
+    { uint32_t(0), 0x0009, 1, ZCL_INT8U_ATTRIBUTE_TYPE, ATTRIBUTE_MASK_EXTERNAL_STORAGE },
+    { uint32_t(0), 0xFFFC, 4, ZCL_BITMAP32_ATTRIBUTE_TYPE, 0 },
+    { uint32_t(0), 0xFFFD, 2, ZCL_INT16U_ATTRIBUTE_TYPE, 0 },
+};
+
+// Attribute whose value is never written, as after a factory reset.
+constexpr AttributeId kUnwrittenAttribute = 0x0008;
+
+// PersistentStorageDelegate reading the INI file storage as the Linux KeyValueStoreManager does.
+class LinuxStorageDelegate : public PersistentStorageDelegate
+{
+public:
+    explicit LinuxStorageDelegate(DeviceLayer::Internal::ChipLinuxStorage & storage) : mStorage(storage) {}
+
+    CHIP_ERROR SyncGetKeyValue(const char * key, void * buffer, uint16_t & size) override
+    {
+        size_t readSize;
+        CHIP_ERROR err = mStorage.ReadValueBin(key, static_cast<uint8_t *>(buffer), size, readSize);
+        if (err == CHIP_ERROR_KEY_NOT_FOUND)
+        {
+            return CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND;
+        }
+        ReturnErrorOnFailure(err);
+        size = static_cast<uint16_t>(readSize);
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR SyncSetKeyValue(const char * key, const void * value, uint16_t size) override
+    {
+        // Committed once all the values are written.
+        return mStorage.WriteValueBin(key, static_cast<const uint8_t *>(value), size);
+    }
+
+    CHIP_ERROR SyncDeleteKeyValue(const char * key) override { return mStorage.ClearValue(key); }
+
+private:
+    DeviceLayer::Internal::ChipLinuxStorage & mStorage;
+};
+
+class CountingHandler : public AttributePersistenceProvider::ValueHandler
+{
+public:
+    void OnValueRead(const ConcreteAttributePath & aPath, const EmberAfAttributeMetadata * aMetadata,
+                     const ByteSpan & aValue) override
+    {
+        mValues++;
+    }
+
+    size_t mValues = 0;
+};
+
+CHIP_ERROR WriteStorage(const char * path, uint16_t endpointCount)
+{
+    DeviceLayer::Internal::ChipLinuxStorage storage;
+    LinuxStorageDelegate delegate(storage);
+    DefaultAttributePersistenceProvider provider;
+    const uint8_t value[] = { 12, 'b', 'e', 'n', 'c', 'h', 'm', 'a', 'r', 'k', 'i', 'n', 'g' };
+
+    unlink(path);
+    ReturnErrorOnFailure(storage.Init(path));
+    ReturnErrorOnFailure(provider.Init(&delegate));
+
+    // Other persisted data, such as fabric tables, shares the storage.
+    for (size_t i = 0; i < kOtherPersistedEntries; i++)
+    {
+        std::string key = "f/" + std::to_string(i);
+        ReturnErrorOnFailure(delegate.SyncSetKeyValue(key.c_str(), value, sizeof(value)));
+    }
+
+    for (uint16_t endpoint = 0; endpoint < endpointCount; endpoint++)
+    {
+        for (ClusterId cluster = 0; cluster < kClustersPerEndpoint; cluster++)
+        {
+            for (const auto & attribute : kAttributes)
+            {
+                if (!attribute.IsAutomaticallyPersisted() || attribute.attributeId == kUnwrittenAttribute)
+                {
+                    continue;
+                }
+                ConcreteAttributePath attributePath(endpoint, cluster, attribute.attributeId);
+                ByteSpan attributeValue(value, chip::min<size_t>(sizeof(value), attribute.size));
+                ReturnErrorOnFailure(provider.WriteValue(attributePath, attributeValue));
+            }
+        }
+    }
+
+    return storage.Commit();
+}
+
+CHIP_ERROR RunBenchmark(const char * path, uint16_t endpointCount, size_t runs)
+{
+    ReturnErrorOnFailure(WriteStorage(path, endpointCount));
+
+    std::chrono::duration<double> total(0);
+    size_t values = 0;
+
+    for (size_t run = 0; run < runs; run++)
+    {
+        // A fresh storage, as at startup.
+        DeviceLayer::Internal::ChipLinuxStorage storage;
+        LinuxStorageDelegate delegate(storage);
+        DefaultAttributePersistenceProvider provider;
+        ReturnErrorOnFailure(storage.Init(path));
+        ReturnErrorOnFailure(provider.Init(&delegate));
+
+        uint8_t buffer[64];
+        CountingHandler handler;
+        const auto start = std::chrono::steady_clock::now();
+        for (uint16_t endpoint = 0; endpoint < endpointCount; endpoint++)
+        {
+            for (ClusterId cluster = 0; cluster < kClustersPerEndpoint; cluster++)
+            {
+                ReturnErrorOnFailure(provider.ReadValues(endpoint, cluster, Span<const EmberAfAttributeMetadata>(kAttributes),
+                                                         MutableByteSpan(buffer), handler));
+            }
+        }
+        total += std::chrono::steady_clock::now() - start;
+        values = handler.mValues;
+    }
+
+    printf("%3u endpoints: %9.3f ms per load (%zu values of %u attributes)\n", endpointCount, total.count() * 1000 / double(runs),
+           values, static_cast<unsigned>(endpointCount * kClustersPerEndpoint * ArraySize(kAttributes)));
+    return CHIP_NO_ERROR;
+}
+
+} // namespace
+
+int main(int argc, char * argv[])
+{
+    const size_t runs = (argc > 1) ? strtoul(argv[1], nullptr, 0) : kDefaultRuns;
+    char path[]       = "/tmp/attribute-persistence-benchmark-XXXXXX";
+
+    if (runs == 0)
+    {
+        fprintf(stderr, "Usage: %s [runs]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    CHIP_ERROR err = Platform::MemoryInit();
+    SuccessOrExit(err);
+
+    {
+        int fd = mkstemp(path);
+        VerifyOrExit(fd >= 0, err = CHIP_ERROR_OPEN_FAILED);
+        close(fd);
+    }
+
+    for (uint16_t endpointCount : kEndpointCounts)
+    {
+        err = RunBenchmark(path, endpointCount, runs);
+        SuccessOrExit(err);
+    }
+
+exit:
+    if (err != CHIP_NO_ERROR)
+    {
+        fprintf(stderr, "Benchmark failed: %" CHIP_ERROR_FORMAT "\n", err.Format());
+    }
+    unlink(path);
+    Platform::MemoryShutdown();
+    return (err == CHIP_NO_ERROR) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,237 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Measures the throughput of the generated Decode methods of cluster objects, decoding lists
+ *      of structs, commands and events of a few representative clusters as a controller does when
+ *      receiving reports.
+ *
+ *      Usage: cluster-objects-decode-benchmark [runs]
+ */
+
+#include <app-common/zap-generated/cluster-objects.h>
+#include <app/data-model/Decode.h>
+#include <app/data-model/Encode.h>
+#include <lib/core/TLV.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::app::Clusters;
+
+constexpr size_t kDefaultRuns = 200;
+constexpr size_t kElements    = 1000;
+
+// Consumes the decoded lists, as the decoded values of a report would be.
+CHIP_ERROR Consume(const AccessControl::Structs::AccessControlEntryStruct::DecodableType & entry, uint64_t & sum)
+{
+    if (!entry.subjects.IsNull())
+    {
+        auto subjects = entry.subjects.Value().begin();
+        while (subjects.Next())
+        {
+            sum += subjects.GetValue();
+        }
+        ReturnErrorOnFailure(subjects.GetStatus());
+    }
+    if (!entry.targets.IsNull())
+    {
+        auto targets = entry.targets.Value().begin();
+        while (targets.Next())
+        {
+            const auto & cluster = targets.GetValue().cluster;
+            sum += cluster.IsNull() ? 0 : cluster.Value();
+        }
+        ReturnErrorOnFailure(targets.GetStatus());
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR EncodeElement(TLV::TLVWriter & writer, const AccessControl::Structs::AccessControlEntryStruct::Type & entry)
+{
+    return entry.EncodeForRead(writer, TLV::AnonymousTag(), entry.fabricIndex);
+}
+
+template <typename Type>
+CHIP_ERROR EncodeElement(TLV::TLVWriter & writer, const Type & value)
+{
+    return DataModel::Encode(writer, TLV::AnonymousTag(), value);
+}
+
+template <typename DecodableType>
+CHIP_ERROR Consume(const DecodableType & value, uint64_t & sum)
+{
+    sum++;
+    return CHIP_NO_ERROR;
+}
+
+template <typename Type, typename DecodableType>
+CHIP_ERROR RunBenchmark(const char * name, const Type & value, size_t runs)
+{
+    std::vector<uint8_t> buffer(kElements * 256);
+
+    TLV::TLVWriter writer;
+    TLV::TLVType outer;
+    writer.Init(buffer.data(), buffer.size());
+    ReturnErrorOnFailure(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Array, outer));
+    for (size_t i = 0; i < kElements; i++)
+    {
+        ReturnErrorOnFailure(EncodeElement(writer, value));
+    }
+    ReturnErrorOnFailure(writer.EndContainer(outer));
+    ReturnErrorOnFailure(writer.Finalize());
+    const uint32_t length = writer.GetLengthWritten();
+
+    std::chrono::duration<double> total(0);
+    uint64_t sum = 0;
+
+    for (size_t run = 0; run < runs; run++)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        TLV::TLVReader reader;
+        reader.Init(buffer.data(), length);
+        ReturnErrorOnFailure(reader.Next(TLV::kTLVType_Array, TLV::AnonymousTag()));
+        ReturnErrorOnFailure(reader.EnterContainer(outer));
+
+        CHIP_ERROR err;
+        while ((err = reader.Next()) == CHIP_NO_ERROR)
+        {
+            DecodableType decoded;
+            ReturnErrorOnFailure(DataModel::Decode(reader, decoded));
+            ReturnErrorOnFailure(Consume(decoded, sum));
+        }
+        VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+        ReturnErrorOnFailure(reader.ExitContainer(outer));
+
+        total += std::chrono::steady_clock::now() - start;
+    }
+
+    const double elements = static_cast<double>(runs * kElements);
+    printf("%-48s %8.1f ns per element %8.1f MB/s (%u bytes per list, check %llu)\n", name, total.count() * 1e9 / elements,
+           static_cast<double>(length) * static_cast<double>(runs) / total.count() / 1e6, length,
+           static_cast<unsigned long long>(sum));
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR RunBenchmarks(size_t runs)
+{
+    {
+        Descriptor::Structs::DeviceTypeStruct::Type value;
+        value.deviceType = 0x0100;
+        value.revision   = 2;
+        ReturnErrorOnFailure((RunBenchmark<decltype(value), Descriptor::Structs::DeviceTypeStruct::DecodableType>(
+            "Descriptor DeviceTypeStruct", value, runs)));
+    }
+
+    {
+        const uint8_t ssid[]  = { 'n', 'e', 't', 'w', 'o', 'r', 'k' };
+        const uint8_t bssid[] = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55 };
+        NetworkCommissioning::Structs::WiFiInterfaceScanResult::Type value;
+        value.security = NetworkCommissioning::WiFiSecurity::kWpa2Personal;
+        value.ssid     = ByteSpan(ssid);
+        value.bssid    = ByteSpan(bssid);
+        value.channel  = 6;
+        value.wiFiBand = NetworkCommissioning::WiFiBand::k2g4;
+        value.rssi     = -60;
+        ReturnErrorOnFailure((RunBenchmark<decltype(value), NetworkCommissioning::Structs::WiFiInterfaceScanResult::DecodableType>(
+            "NetworkCommissioning WiFiInterfaceScanResult", value, runs)));
+    }
+
+    {
+        const uint64_t subjects[] = { 0x1122334455667788, 0x99AABBCCDDEEFF00 };
+        AccessControl::Structs::Target::Type targets[2];
+        targets[0].cluster.SetNonNull(OnOff::Id);
+        targets[0].endpoint.SetNonNull(static_cast<EndpointId>(1));
+        targets[1].deviceType.SetNonNull(static_cast<DeviceTypeId>(0x0100));
+        AccessControl::Structs::AccessControlEntryStruct::Type value;
+        value.privilege   = AccessControl::AccessControlEntryPrivilegeEnum::kOperate;
+        value.authMode    = AccessControl::AccessControlEntryAuthModeEnum::kCase;
+        value.fabricIndex = 1;
+        value.subjects.SetNonNull(subjects);
+        value.targets.SetNonNull(targets);
+        ReturnErrorOnFailure((RunBenchmark<decltype(value), AccessControl::Structs::AccessControlEntryStruct::DecodableType>(
+            "AccessControl AccessControlEntryStruct", value, runs)));
+    }
+
+    {
+        LevelControl::Commands::MoveToLevelWithOnOff::Type value;
+        value.level = 128;
+        value.transitionTime.SetNonNull(static_cast<uint16_t>(10));
+        ReturnErrorOnFailure((RunBenchmark<decltype(value), LevelControl::Commands::MoveToLevelWithOnOff::DecodableType>(
+            "LevelControl MoveToLevelWithOnOff command", value, runs)));
+    }
+
+    {
+        ColorControl::Commands::MoveToColor::Type value;
+        value.colorX         = 0x6000;
+        value.colorY         = 0x5000;
+        value.transitionTime = 10;
+        ReturnErrorOnFailure((RunBenchmark<decltype(value), ColorControl::Commands::MoveToColor::DecodableType>(
+            "ColorControl MoveToColor command", value, runs)));
+    }
+
+    {
+        AccessControl::Events::AccessControlEntryChanged::Type value;
+        value.adminNodeID.SetNonNull(static_cast<NodeId>(0x1122334455667788));
+        value.changeType  = AccessControl::ChangeTypeEnum::kAdded;
+        value.fabricIndex = 1;
+        value.latestValue.SetNonNull();
+        value.latestValue.Value().privilege   = AccessControl::AccessControlEntryPrivilegeEnum::kAdminister;
+        value.latestValue.Value().authMode    = AccessControl::AccessControlEntryAuthModeEnum::kCase;
+        value.latestValue.Value().fabricIndex = 1;
+        ReturnErrorOnFailure((RunBenchmark<decltype(value), AccessControl::Events::AccessControlEntryChanged::DecodableType>(
+            "AccessControl AccessControlEntryChanged event", value, runs)));
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+} // namespace
+
+int main(int argc, char * argv[])
+{
+    const size_t runs = (argc > 1) ? strtoul(argv[1], nullptr, 0) : kDefaultRuns;
+
+    if (runs == 0)
+    {
+        fprintf(stderr, "Usage: %s [runs]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    CHIP_ERROR err = Platform::MemoryInit();
+    if (err == CHIP_NO_ERROR)
+    {
+        err = RunBenchmarks(runs);
+    }
+
+    if (err != CHIP_NO_ERROR)
+    {
+        fprintf(stderr, "Benchmark failed: %" CHIP_ERROR_FORMAT "\n", err.Format());
+    }
+    Platform::MemoryShutdown();
+    return (err == CHIP_NO_ERROR) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -22,6 +22,7 @@
 #include <app/EventManagement.h>
 #include <app/ObjectList.h>
 #include <app/util/mock/Constants.h>
+#include <app/util/mock/Functions.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/core/TLVDebug.h>
 #include <lib/support/CodeUtils.h>
@@ -357,6 +358,114 @@ void TestMultipleClusInfo(nlTestSuite * apSuite, void * apContext)
     NL_TEST_ASSERT(apSuite, index == ArraySize(paths));
 }
 
+void TestWildcardDisabledEndpoint(nlTestSuite * apSuite, void * apContext)
+{
+    app::ObjectList<app::AttributePathParams> clusInfo;
+
+    app::ConcreteAttributePath path;
+    size_t numAllPaths = 0;
+    for (app::AttributePathExpandIterator iter(&clusInfo); iter.Get(path); iter.Next())
+    {
+        numAllPaths++;
+    }
+
+#if CHIP_IM_SERVER_PATH_EXPANSION_CACHE_MAX_ATTRIBUTES > 0
+    uint32_t buildCount = AttributePathExpansionCache::Instance().GetBuildCount();
+#endif
+
+    SetMockEndpointEnabled(kMockEndpoint2, false);
+
+    size_t numPaths = 0;
+    for (app::AttributePathExpandIterator iter(&clusInfo); iter.Get(path); iter.Next())
+    {
+        NL_TEST_ASSERT(apSuite, path.mEndpointId != kMockEndpoint2);
+        numPaths++;
+    }
+    NL_TEST_ASSERT(apSuite, numPaths > 0 && numPaths < numAllPaths);
+
+#if CHIP_IM_SERVER_PATH_EXPANSION_CACHE_MAX_ATTRIBUTES > 0
+    // Disabling the endpoint must have invalidated the flattened data model.
+    NL_TEST_ASSERT(apSuite, AttributePathExpansionCache::Instance().GetBuildCount() == buildCount + 1);
+#endif
+
+    SetMockEndpointEnabled(kMockEndpoint2, true);
+
+    numPaths = 0;
+    for (app::AttributePathExpandIterator iter(&clusInfo); iter.Get(path); iter.Next())
+    {
+        numPaths++;
+    }
+    NL_TEST_ASSERT(apSuite, numPaths == numAllPaths);
+}
+
+void TestWildcardEndpointDisabledWhileIterating(nlTestSuite * apSuite, void * apContext)
+{
+    app::ObjectList<app::AttributePathParams> clusInfo;
+
+    app::ConcreteAttributePath allPaths[128];
+    size_t numAllPaths = 0;
+    for (app::AttributePathExpandIterator iter(&clusInfo); iter.Get(allPaths[numAllPaths]); iter.Next())
+    {
+        numAllPaths++;
+        VerifyOrReturn(numAllPaths < ArraySize(allPaths), NL_TEST_ASSERT(apSuite, false));
+    }
+
+    // Stop after every path, as a ReadHandler would when a chunk is full, and disable each endpoint in turn: the expansion must go
+    // on right after the paths already emitted, without emitting any of them again.
+    for (EndpointId disabledEndpoint : { kMockEndpoint1, kMockEndpoint2, kMockEndpoint3 })
+    {
+        for (size_t numEmitted = 1; numEmitted < numAllPaths; numEmitted++)
+        {
+            app::ConcreteAttributePath path;
+            app::AttributePathExpandIterator iter(&clusInfo);
+            for (size_t i = 0; i < numEmitted; i++)
+            {
+                NL_TEST_ASSERT(apSuite, iter.Get(path) && path == allPaths[i]);
+                iter.Next();
+            }
+
+            SetMockEndpointEnabled(disabledEndpoint, false);
+
+            // The next chunk picks the change up. The iterator already points to the next path, which it keeps.
+            iter.RefreshExpansionCache();
+            NL_TEST_ASSERT(apSuite, iter.Get(path) && path == allPaths[numEmitted]);
+            iter.Next();
+
+            size_t index = numEmitted + 1;
+            for (; iter.Get(path); iter.Next())
+            {
+                while (index < numAllPaths && allPaths[index].mEndpointId == disabledEndpoint)
+                {
+                    index++;
+                }
+                NL_TEST_ASSERT(apSuite, index < numAllPaths && path == allPaths[index]);
+                index++;
+            }
+            while (index < numAllPaths && allPaths[index].mEndpointId == disabledEndpoint)
+            {
+                index++;
+            }
+            NL_TEST_ASSERT(apSuite, index == numAllPaths);
+
+            SetMockEndpointEnabled(disabledEndpoint, true);
+        }
+    }
+
+    // Resetting the current cluster while the data model changes still expands that cluster again from its start.
+    {
+        app::ConcreteAttributePath path;
+        app::AttributePathExpandIterator iter(&clusInfo);
+        iter.Next();
+        NL_TEST_ASSERT(apSuite, iter.Get(path) && path == allPaths[1]);
+        NL_TEST_ASSERT(apSuite, ConcreteClusterPath(allPaths[0]) == ConcreteClusterPath(allPaths[1]));
+
+        SetMockEndpointEnabled(kMockEndpoint3, false);
+        iter.ResetCurrentCluster();
+        NL_TEST_ASSERT(apSuite, iter.Get(path) && path == allPaths[0]);
+        SetMockEndpointEnabled(kMockEndpoint3, true);
+    }
+}
+
 static int TestSetup(void * inContext)
 {
     return SUCCESS;
@@ -385,6 +494,8 @@ const nlTest sTests[] =
         NL_TEST_DEF("TestWildcardAttribute", TestWildcardAttribute),
         NL_TEST_DEF("TestNoWildcard", TestNoWildcard),
         NL_TEST_DEF("TestMultipleClusInfo", TestMultipleClusInfo),
+        NL_TEST_DEF("TestWildcardDisabledEndpoint", TestWildcardDisabledEndpoint),
+        NL_TEST_DEF("TestWildcardEndpointDisabledWhileIterating", TestWildcardEndpointDisabledWhileIterating),
         NL_TEST_SENTINEL()
 };
 // clang-format on
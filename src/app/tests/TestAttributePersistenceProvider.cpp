@@ -0,0 +1,139 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app-common/zap-generated/attribute-type.h>
+#include <app/DefaultAttributePersistenceProvider.h>
+#include <app/DeferredAttributePersistenceProvider.h>
+#include <lib/support/TestPersistentStorageDelegate.h>
+#include <lib/support/UnitTestRegistration.h>
+
+#include <nlunit-test.h>
+
+#include <vector>
+
+using namespace chip;
+using namespace chip::app;
+
+namespace {
+
+constexpr EndpointId kEndpoint = 3;
+constexpr ClusterId kCluster   = 0x0008;
+
+const EmberAfAttributeMetadata kAttributes[] = {
+    { uint32_t(0), 0x0000, 1, ZCL_INT8U_ATTRIBUTE_TYPE, ATTRIBUTE_MASK_NONVOLATILE },
+    { uint32_t(0), 0x0001, 2, ZCL_INT16U_ATTRIBUTE_TYPE, 0 },
+    { uint32_t(0), 0x0002, 2, ZCL_INT16U_ATTRIBUTE_TYPE, ATTRIBUTE_MASK_NONVOLATILE },
+    { uint32_t(0), 0x0003, 4, ZCL_INT32U_ATTRIBUTE_TYPE, ATTRIBUTE_MASK_NONVOLATILE | ATTRIBUTE_MASK_EXTERNAL_STORAGE },
+    { uint32_t(0), 0x0004, 17, ZCL_CHAR_STRING_ATTRIBUTE_TYPE, ATTRIBUTE_MASK_NONVOLATILE },
+    { uint32_t(0), 0x0005, 4, ZCL_INT32U_ATTRIBUTE_TYPE, ATTRIBUTE_MASK_NONVOLATILE },
+};
+
+class RecordingHandler : public AttributePersistenceProvider::ValueHandler
+{
+public:
+    void OnValueRead(const ConcreteAttributePath & aPath, const EmberAfAttributeMetadata * aMetadata,
+                     const ByteSpan & aValue) override
+    {
+        mPaths.push_back(aPath);
+        mValues.emplace_back(aValue.begin(), aValue.end());
+    }
+
+    std::vector<ConcreteAttributePath> mPaths;
+    std::vector<std::vector<uint8_t>> mValues;
+};
+
+void WriteValues(AttributePersistenceProvider & provider)
+{
+    const uint8_t value0[]   = { 0x2a };
+    const uint8_t value1[]   = { 0x34, 0x12 };
+    const uint8_t value3[]   = { 1, 2, 3, 4 };
+    const uint8_t value4[]   = { 5, 'h', 'e', 'l', 'l', 'o' };
+    const uint8_t badValue[] = { 1, 2 };
+
+    // 0x0001 is not persisted and 0x0003 is external, values are written for
+    // them to check that they are not read.
+    provider.WriteValue(ConcreteAttributePath(kEndpoint, kCluster, 0x0000), ByteSpan(value0));
+    provider.WriteValue(ConcreteAttributePath(kEndpoint, kCluster, 0x0001), ByteSpan(value1));
+    provider.WriteValue(ConcreteAttributePath(kEndpoint, kCluster, 0x0003), ByteSpan(value3));
+    provider.WriteValue(ConcreteAttributePath(kEndpoint, kCluster, 0x0004), ByteSpan(value4));
+    // Not the size of the attribute
+    provider.WriteValue(ConcreteAttributePath(kEndpoint, kCluster, 0x0005), ByteSpan(badValue));
+    // Another endpoint
+    provider.WriteValue(ConcreteAttributePath(kEndpoint + 1, kCluster, 0x0002), ByteSpan(value1));
+}
+
+void CheckValues(nlTestSuite * inSuite, const RecordingHandler & handler)
+{
+    // Attribute 0x0002 has no persisted value, and the value of 0x0005 is invalid.
+    NL_TEST_ASSERT(inSuite, handler.mPaths.size() == 2);
+    VerifyOrReturn(handler.mPaths.size() == 2);
+
+    NL_TEST_ASSERT(inSuite, handler.mPaths[0] == ConcreteAttributePath(kEndpoint, kCluster, 0x0000));
+    NL_TEST_ASSERT(inSuite, handler.mValues[0] == std::vector<uint8_t>({ 0x2a }));
+    NL_TEST_ASSERT(inSuite, handler.mPaths[1] == ConcreteAttributePath(kEndpoint, kCluster, 0x0004));
+    NL_TEST_ASSERT(inSuite, handler.mValues[1] == std::vector<uint8_t>({ 5, 'h', 'e', 'l', 'l', 'o' }));
+}
+
+void TestReadValues(nlTestSuite * inSuite, void * inContext)
+{
+    TestPersistentStorageDelegate storage;
+    DefaultAttributePersistenceProvider provider;
+    NL_TEST_ASSERT(inSuite, provider.Init(&storage) == CHIP_NO_ERROR);
+    WriteValues(provider);
+
+    uint8_t buffer[32];
+    RecordingHandler handler;
+    Span<const EmberAfAttributeMetadata> attributes(kAttributes);
+    MutableByteSpan scratch(buffer);
+    NL_TEST_ASSERT(inSuite, provider.ReadValues(kEndpoint, kCluster, attributes, scratch, handler) == CHIP_NO_ERROR);
+    CheckValues(inSuite, handler);
+}
+
+void TestReadValuesDeferred(nlTestSuite * inSuite, void * inContext)
+{
+    TestPersistentStorageDelegate storage;
+    DefaultAttributePersistenceProvider persister;
+    NL_TEST_ASSERT(inSuite, persister.Init(&storage) == CHIP_NO_ERROR);
+    WriteValues(persister);
+
+    DeferredAttribute deferredAttributes[] = { DeferredAttribute(ConcreteAttributePath(kEndpoint, kCluster, 0x0000)) };
+    DeferredAttributePersistenceProvider provider(persister, Span<DeferredAttribute>(deferredAttributes),
+                                                  System::Clock::Milliseconds32(1000));
+
+    uint8_t buffer[32];
+    RecordingHandler handler;
+    Span<const EmberAfAttributeMetadata> attributes(kAttributes);
+    MutableByteSpan scratch(buffer);
+    NL_TEST_ASSERT(inSuite, provider.ReadValues(kEndpoint, kCluster, attributes, scratch, handler) == CHIP_NO_ERROR);
+    CheckValues(inSuite, handler);
+}
+
+const nlTest sTests[] = { NL_TEST_DEF("Test ReadValues", TestReadValues),
+                          NL_TEST_DEF("Test ReadValues through deferred persistence", TestReadValuesDeferred),
+                          NL_TEST_SENTINEL() };
+
+} // namespace
+
+int TestAttributePersistenceProvider()
+{
+    nlTestSuite theSuite = { "Attribute persistence provider tests", &sTests[0], nullptr, nullptr };
+
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestAttributePersistenceProvider)
@@ -0,0 +1,292 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/CASEConnectScheduler.h>
+#include <app/tests/AppTestContext.h>
+#include <lib/support/UnitTestContext.h>
+#include <lib/support/UnitTestRegistration.h>
+
+#include <nlunit-test.h>
+
+using TestContext = chip::Test::AppContext;
+
+using namespace chip;
+
+namespace {
+
+constexpr FabricIndex kFabric = 1;
+
+const ScopedNodeId kPeers[] = {
+    ScopedNodeId(0x1001, kFabric), ScopedNodeId(0x1002, kFabric), ScopedNodeId(0x1003, kFabric),
+    ScopedNodeId(0x1004, kFabric), ScopedNodeId(0x1005, kFabric),
+};
+
+/// Records establishments and completes them on demand.
+class FakeEstablisher : public CASESessionEstablisher
+{
+public:
+    struct Attempt
+    {
+        ScopedNodeId peerId;
+        Callback::Callback<OnDeviceConnected> * onConnection;
+        Callback::Callback<OnDeviceConnectionFailure> * onFailure;
+    };
+
+    void FindOrEstablishSession(const ScopedNodeId & peerId, Callback::Callback<OnDeviceConnected> * onConnection,
+                                Callback::Callback<OnDeviceConnectionFailure> * onFailure) override
+    {
+        if (mNoMemoryFailures > 0)
+        {
+            mNoMemoryFailures--;
+            onFailure->mCall(onFailure->mContext, peerId, CHIP_ERROR_NO_MEMORY);
+            return;
+        }
+        mAttempts[mAttemptCount++] = { peerId, onConnection, onFailure };
+    }
+
+    void Succeed(size_t attempt, TestContext & ctx)
+    {
+        auto * cb = mAttempts[attempt].onConnection;
+        cb->mCall(cb->mContext, ctx.GetExchangeManager(), ctx.GetSessionBobToAlice());
+    }
+
+    void Fail(size_t attempt, CHIP_ERROR error)
+    {
+        auto * cb = mAttempts[attempt].onFailure;
+        cb->mCall(cb->mContext, mAttempts[attempt].peerId, error);
+    }
+
+    Attempt mAttempts[16];
+    size_t mAttemptCount     = 0;
+    size_t mNoMemoryFailures = 0;
+};
+
+class RecordingCallback : public BulkConnectRequest::Callback
+{
+public:
+    void OnPeerConnected(BulkConnectRequest & request, const ScopedNodeId & peerId, Messaging::ExchangeManager & exchangeMgr,
+                         const SessionHandle & sessionHandle) override
+    {
+        mConnected++;
+    }
+    void OnPeerConnectionFailure(BulkConnectRequest & request, const ScopedNodeId & peerId, CHIP_ERROR error) override
+    {
+        mFailed++;
+        mLastError = error;
+    }
+    void OnBulkConnectDone(BulkConnectRequest & request) override { mDone++; }
+
+    size_t mConnected     = 0;
+    size_t mFailed        = 0;
+    size_t mDone          = 0;
+    CHIP_ERROR mLastError = CHIP_NO_ERROR;
+};
+
+CASEConnectSchedulerConfig UnpacedConfig(uint8_t maxConcurrency)
+{
+    CASEConnectSchedulerConfig config;
+    config.maxConcurrency = maxConcurrency;
+    config.pacingInterval = System::Clock::kZero;
+    config.pacingJitter   = System::Clock::kZero;
+    return config;
+}
+
+void DriveUntilAttempts(TestContext & ctx, FakeEstablisher & establisher, size_t count)
+{
+    ctx.GetIOContext().DriveIOUntil(System::Clock::Seconds16(1), [&]() { return establisher.mAttemptCount >= count; });
+}
+
+void TestConcurrencyLimit(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+    FakeEstablisher establisher;
+    RecordingCallback callback;
+    CASEConnectScheduler scheduler;
+    BulkConnectRequest request(Span<const ScopedNodeId>(kPeers), callback);
+
+    NL_TEST_ASSERT(inSuite, scheduler.Init(&ctx.GetSystemLayer(), &establisher, UnpacedConfig(2)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, scheduler.Start(request) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, request.IsActive());
+
+    // Only two establishments may be in progress at once
+    DriveUntilAttempts(ctx, establisher, 2);
+    ctx.DrainAndServiceIO();
+    NL_TEST_ASSERT(inSuite, establisher.mAttemptCount == 2);
+    NL_TEST_ASSERT(inSuite, scheduler.GetInFlightCount() == 2);
+
+    establisher.Succeed(0, ctx);
+    DriveUntilAttempts(ctx, establisher, 3);
+    NL_TEST_ASSERT(inSuite, establisher.mAttemptCount == 3);
+
+    establisher.Fail(1, CHIP_ERROR_TIMEOUT);
+    DriveUntilAttempts(ctx, establisher, 4);
+    NL_TEST_ASSERT(inSuite, establisher.mAttemptCount == 4);
+    NL_TEST_ASSERT(inSuite, callback.mLastError == CHIP_ERROR_TIMEOUT);
+
+    establisher.Succeed(2, ctx);
+    establisher.Succeed(3, ctx);
+    DriveUntilAttempts(ctx, establisher, 5);
+    NL_TEST_ASSERT(inSuite, establisher.mAttemptCount == 5);
+    NL_TEST_ASSERT(inSuite, callback.mDone == 0);
+
+    establisher.Succeed(4, ctx);
+    NL_TEST_ASSERT(inSuite, callback.mDone == 1);
+    NL_TEST_ASSERT(inSuite, callback.mConnected == 4);
+    NL_TEST_ASSERT(inSuite, callback.mFailed == 1);
+    NL_TEST_ASSERT(inSuite, !request.IsActive());
+    NL_TEST_ASSERT(inSuite, scheduler.GetInFlightCount() == 0);
+
+    for (size_t i = 0; i < establisher.mAttemptCount; i++)
+    {
+        NL_TEST_ASSERT(inSuite, establisher.mAttempts[i].peerId == kPeers[i]);
+    }
+
+    const BulkConnectStats & stats = request.GetStats();
+    NL_TEST_ASSERT(inSuite, stats.succeeded == 4);
+    NL_TEST_ASSERT(inSuite, stats.failed == 1);
+    NL_TEST_ASSERT(inSuite, stats.cancelled == 0);
+    NL_TEST_ASSERT(inSuite, stats.minLatency <= stats.GetAverageLatency());
+    NL_TEST_ASSERT(inSuite, stats.GetAverageLatency() <= stats.maxLatency);
+
+    scheduler.Shutdown();
+}
+
+void TestPriorityClasses(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+    FakeEstablisher establisher;
+    RecordingCallback lowCallback;
+    RecordingCallback highCallback;
+    CASEConnectScheduler scheduler;
+    BulkConnectRequest low(Span<const ScopedNodeId>(kPeers, 2), lowCallback, BulkConnectPriority::kLow);
+    BulkConnectRequest high(Span<const ScopedNodeId>(kPeers + 2, 2), highCallback, BulkConnectPriority::kHigh);
+
+    NL_TEST_ASSERT(inSuite, scheduler.Init(&ctx.GetSystemLayer(), &establisher, UnpacedConfig(1)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, scheduler.Start(low) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, scheduler.Start(high) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, scheduler.Start(high) == CHIP_ERROR_INCORRECT_STATE);
+
+    // The high priority request is served first even though it was started last
+    for (size_t i = 0; i < 4; i++)
+    {
+        DriveUntilAttempts(ctx, establisher, i + 1);
+        NL_TEST_ASSERT(inSuite, establisher.mAttemptCount == i + 1);
+        establisher.Succeed(i, ctx);
+    }
+
+    NL_TEST_ASSERT(inSuite, establisher.mAttempts[0].peerId == kPeers[2]);
+    NL_TEST_ASSERT(inSuite, establisher.mAttempts[1].peerId == kPeers[3]);
+    NL_TEST_ASSERT(inSuite, establisher.mAttempts[2].peerId == kPeers[0]);
+    NL_TEST_ASSERT(inSuite, establisher.mAttempts[3].peerId == kPeers[1]);
+    NL_TEST_ASSERT(inSuite, highCallback.mDone == 1 && highCallback.mConnected == 2);
+    NL_TEST_ASSERT(inSuite, lowCallback.mDone == 1 && lowCallback.mConnected == 2);
+
+    scheduler.Shutdown();
+}
+
+void TestRetryWhenOutOfSessionSetups(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+    FakeEstablisher establisher;
+    RecordingCallback callback;
+    CASEConnectScheduler scheduler;
+    BulkConnectRequest request(Span<const ScopedNodeId>(kPeers, 2), callback);
+
+    CASEConnectSchedulerConfig config = UnpacedConfig(1);
+    config.maxRetries                 = 2;
+    NL_TEST_ASSERT(inSuite, scheduler.Init(&ctx.GetSystemLayer(), &establisher, config) == CHIP_NO_ERROR);
+
+    // Two allocation failures are retried for the first peer...
+    establisher.mNoMemoryFailures = 2;
+    NL_TEST_ASSERT(inSuite, scheduler.Start(request) == CHIP_NO_ERROR);
+    DriveUntilAttempts(ctx, establisher, 1);
+    NL_TEST_ASSERT(inSuite, establisher.mAttemptCount == 1);
+    NL_TEST_ASSERT(inSuite, establisher.mAttempts[0].peerId == kPeers[0]);
+    NL_TEST_ASSERT(inSuite, request.GetStats().retried == 2);
+    NL_TEST_ASSERT(inSuite, callback.mFailed == 0);
+
+    // ... but not a third one for the second peer
+    establisher.mNoMemoryFailures = 3;
+    establisher.Succeed(0, ctx);
+    ctx.GetIOContext().DriveIOUntil(System::Clock::Seconds16(1), [&]() { return callback.mDone != 0; });
+    NL_TEST_ASSERT(inSuite, callback.mDone == 1);
+    NL_TEST_ASSERT(inSuite, callback.mFailed == 1);
+    NL_TEST_ASSERT(inSuite, callback.mLastError == CHIP_ERROR_NO_MEMORY);
+    NL_TEST_ASSERT(inSuite, request.GetStats().retried == 4);
+    NL_TEST_ASSERT(inSuite, request.GetStats().succeeded == 1);
+    NL_TEST_ASSERT(inSuite, request.GetStats().failed == 1);
+
+    scheduler.Shutdown();
+}
+
+void TestCancelOnShutdown(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+    FakeEstablisher establisher;
+    RecordingCallback callback;
+    CASEConnectScheduler scheduler;
+    BulkConnectRequest request(Span<const ScopedNodeId>(kPeers), callback);
+
+    NL_TEST_ASSERT(inSuite, scheduler.Init(&ctx.GetSystemLayer(), &establisher, UnpacedConfig(2)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, scheduler.Start(request) == CHIP_NO_ERROR);
+    DriveUntilAttempts(ctx, establisher, 2);
+    NL_TEST_ASSERT(inSuite, establisher.mAttemptCount == 2);
+
+    establisher.Succeed(0, ctx);
+    scheduler.Shutdown();
+
+    NL_TEST_ASSERT(inSuite, !request.IsActive());
+    NL_TEST_ASSERT(inSuite, request.GetStats().succeeded == 1);
+    NL_TEST_ASSERT(inSuite, request.GetStats().cancelled == 4);
+    NL_TEST_ASSERT(inSuite, callback.mDone == 0);
+    NL_TEST_ASSERT(inSuite, scheduler.Start(request) == CHIP_ERROR_INCORRECT_STATE);
+
+    // Nothing is started after shutdown
+    ctx.DrainAndServiceIO();
+    NL_TEST_ASSERT(inSuite, establisher.mAttemptCount == 2);
+}
+
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("TestConcurrencyLimit", TestConcurrencyLimit),
+    NL_TEST_DEF("TestPriorityClasses", TestPriorityClasses),
+    NL_TEST_DEF("TestRetryWhenOutOfSessionSetups", TestRetryWhenOutOfSessionSetups),
+    NL_TEST_DEF("TestCancelOnShutdown", TestCancelOnShutdown),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+// clang-format off
+nlTestSuite sSuite =
+{
+    "TestCASEConnectScheduler",
+    &sTests[0],
+    TestContext::Initialize,
+    TestContext::Finalize
+};
+// clang-format on
+
+} // namespace
+
+int TestCASEConnectScheduler()
+{
+    return chip::ExecuteTestsWithContext<TestContext>(&sSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestCASEConnectScheduler)
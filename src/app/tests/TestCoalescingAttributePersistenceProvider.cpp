@@ -0,0 +1,250 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app-common/zap-generated/attribute-type.h>
+#include <app/CoalescingAttributePersistenceProvider.h>
+#include <app/DefaultAttributePersistenceProvider.h>
+#include <lib/support/TestPersistentStorageDelegate.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <system/SystemClock.h>
+
+#include <nlunit-test.h>
+
+#include <string.h>
+#include <vector>
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::System::Clock::Literals;
+
+namespace {
+
+constexpr EndpointId kEndpoint = 1;
+constexpr ClusterId kCluster   = 0x0008;
+
+const EmberAfAttributeMetadata kAttributes[] = {
+    { uint32_t(0), 0x0000, 1, ZCL_INT8U_ATTRIBUTE_TYPE, ATTRIBUTE_MASK_NONVOLATILE },
+    { uint32_t(0), 0x0001, 1, ZCL_INT8U_ATTRIBUTE_TYPE, ATTRIBUTE_MASK_NONVOLATILE },
+    { uint32_t(0), 0x0002, 1, ZCL_INT8U_ATTRIBUTE_TYPE, ATTRIBUTE_MASK_NONVOLATILE },
+};
+
+// Counts the writes reaching the storage.
+class CountingPersister : public DefaultAttributePersistenceProvider
+{
+public:
+    CHIP_ERROR WriteValue(const ConcreteAttributePath & aPath, const ByteSpan & aValue) override
+    {
+        mWrites++;
+        return DefaultAttributePersistenceProvider::WriteValue(aPath, aValue);
+    }
+
+    size_t mWrites = 0;
+};
+
+class RecordingHandler : public AttributePersistenceProvider::ValueHandler
+{
+public:
+    void OnValueRead(const ConcreteAttributePath & aPath, const EmberAfAttributeMetadata * aMetadata,
+                     const ByteSpan & aValue) override
+    {
+        mPaths.push_back(aPath);
+        mValues.emplace_back(aValue.begin(), aValue.end());
+    }
+
+    std::vector<ConcreteAttributePath> mPaths;
+    std::vector<std::vector<uint8_t>> mValues;
+};
+
+class TestContext
+{
+public:
+    TestContext() : mRealClock(&System::SystemClock())
+    {
+        System::Clock::Internal::SetSystemClockForTesting(&mMockClock);
+        mPersister.Init(&mStorage);
+    }
+    ~TestContext() { System::Clock::Internal::SetSystemClockForTesting(mRealClock); }
+
+    void Write(CoalescingAttributePersistenceProvider & provider, AttributeId attributeId, uint8_t value)
+    {
+        const uint8_t buffer[] = { value };
+        provider.WriteValue(ConcreteAttributePath(kEndpoint, kCluster, attributeId), ByteSpan(buffer));
+    }
+
+    // Value in the storage, or 0xFF if none.
+    uint8_t Stored(AttributeId attributeId)
+    {
+        uint8_t buffer[1];
+        MutableByteSpan value(buffer);
+        VerifyOrReturnValue(mPersister.ReadValue(ConcreteAttributePath(kEndpoint, kCluster, attributeId),
+                                                 &kAttributes[attributeId], value) == CHIP_NO_ERROR,
+                            0xFF);
+        return buffer[0];
+    }
+
+    System::Clock::Internal::MockClock mMockClock;
+    System::Clock::ClockBase * mRealClock;
+    TestPersistentStorageDelegate mStorage;
+    CountingPersister mPersister;
+};
+
+void TestCoalesceWrites(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext ctx;
+    CoalescingAttributePersistenceProvider::Entry entries[2];
+    CoalescingAttributePersistenceProvider provider(ctx.mPersister, Span<CoalescingAttributePersistenceProvider::Entry>(entries),
+                                                    System::Clock::Milliseconds32(1000));
+
+    for (uint8_t i = 0; i < 10; i++)
+    {
+        ctx.Write(provider, 0x0000, i);
+    }
+
+    // The last value is read back before being written.
+    uint8_t buffer[1];
+    MutableByteSpan value(buffer);
+    NL_TEST_ASSERT(inSuite,
+                   provider.ReadValue(ConcreteAttributePath(kEndpoint, kCluster, 0x0000), &kAttributes[0], value) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, value.size() == 1 && buffer[0] == 9);
+    NL_TEST_ASSERT(inSuite, ctx.mPersister.mWrites == 0);
+    NL_TEST_ASSERT(inSuite, ctx.Stored(0x0000) == 0xFF);
+
+    provider.Flush();
+    NL_TEST_ASSERT(inSuite, ctx.mPersister.mWrites == 1);
+    NL_TEST_ASSERT(inSuite, ctx.Stored(0x0000) == 9);
+
+    const auto & metrics = provider.GetMetrics();
+    NL_TEST_ASSERT(inSuite, metrics.writesRequested == 10);
+    NL_TEST_ASSERT(inSuite, metrics.writesPersisted == 1);
+    NL_TEST_ASSERT(inSuite, metrics.writesCoalesced == 9);
+    NL_TEST_ASSERT(inSuite, metrics.evictions == 0);
+
+    // Nothing left to write.
+    provider.Flush();
+    NL_TEST_ASSERT(inSuite, ctx.mPersister.mWrites == 1);
+}
+
+void TestEviction(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext ctx;
+    CoalescingAttributePersistenceProvider::Entry entries[2];
+    CoalescingAttributePersistenceProvider provider(ctx.mPersister, Span<CoalescingAttributePersistenceProvider::Entry>(entries),
+                                                    System::Clock::Milliseconds32(1000));
+
+    ctx.Write(provider, 0x0001, 1);
+    ctx.mMockClock.AdvanceMonotonic(10_ms64);
+    ctx.Write(provider, 0x0000, 2);
+    ctx.mMockClock.AdvanceMonotonic(10_ms64);
+    ctx.Write(provider, 0x0001, 3);
+
+    // The table is full, the oldest pending value makes room for the new one.
+    ctx.Write(provider, 0x0002, 4);
+    NL_TEST_ASSERT(inSuite, ctx.mPersister.mWrites == 1);
+    NL_TEST_ASSERT(inSuite, ctx.Stored(0x0001) == 3);
+    NL_TEST_ASSERT(inSuite, ctx.Stored(0x0000) == 0xFF);
+    NL_TEST_ASSERT(inSuite, provider.GetMetrics().evictions == 1);
+
+    provider.Flush();
+    NL_TEST_ASSERT(inSuite, ctx.mPersister.mWrites == 3);
+    NL_TEST_ASSERT(inSuite, ctx.Stored(0x0000) == 2);
+    NL_TEST_ASSERT(inSuite, ctx.Stored(0x0002) == 4);
+}
+
+void TestLargeValue(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext ctx;
+    CoalescingAttributePersistenceProvider::Entry entries[2];
+    CoalescingAttributePersistenceProvider provider(ctx.mPersister, Span<CoalescingAttributePersistenceProvider::Entry>(entries),
+                                                    System::Clock::Milliseconds32(1000));
+    const ConcreteAttributePath path(kEndpoint, kCluster, 0x0003);
+    const uint8_t shortValue[] = { 1, 'a' };
+    uint8_t longValue[CoalescingAttributePersistenceProvider::kMaxValueSize + 1];
+    memset(longValue, 'a', sizeof(longValue));
+    longValue[0] = CoalescingAttributePersistenceProvider::kMaxValueSize;
+
+    provider.WriteValue(path, ByteSpan(shortValue));
+    NL_TEST_ASSERT(inSuite, ctx.mPersister.mWrites == 0);
+
+    // Written immediately, and the pending value is not written after it.
+    provider.WriteValue(path, ByteSpan(longValue));
+    NL_TEST_ASSERT(inSuite, ctx.mPersister.mWrites == 1);
+    provider.Flush();
+    NL_TEST_ASSERT(inSuite, ctx.mPersister.mWrites == 1);
+}
+
+void TestReadValues(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext ctx;
+    CoalescingAttributePersistenceProvider::Entry entries[2];
+    CoalescingAttributePersistenceProvider provider(ctx.mPersister, Span<CoalescingAttributePersistenceProvider::Entry>(entries),
+                                                    System::Clock::Milliseconds32(1000));
+
+    // 0x0000 is stored and pending, 0x0001 only stored, 0x0002 only pending.
+    const uint8_t stored[] = { 7 };
+    ctx.mPersister.WriteValue(ConcreteAttributePath(kEndpoint, kCluster, 0x0000), ByteSpan(stored));
+    ctx.mPersister.WriteValue(ConcreteAttributePath(kEndpoint, kCluster, 0x0001), ByteSpan(stored));
+    ctx.Write(provider, 0x0000, 8);
+    ctx.Write(provider, 0x0002, 9);
+
+    uint8_t buffer[8];
+    RecordingHandler handler;
+    NL_TEST_ASSERT(inSuite,
+                   provider.ReadValues(kEndpoint, kCluster, Span<const EmberAfAttributeMetadata>(kAttributes),
+                                       MutableByteSpan(buffer), handler) == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, handler.mPaths.size() == 3);
+    VerifyOrReturn(handler.mPaths.size() == 3);
+    NL_TEST_ASSERT(inSuite, handler.mPaths[0].mAttributeId == 0x0001 && handler.mValues[0] == std::vector<uint8_t>({ 7 }));
+    NL_TEST_ASSERT(inSuite, handler.mPaths[1].mAttributeId == 0x0000 && handler.mValues[1] == std::vector<uint8_t>({ 8 }));
+    NL_TEST_ASSERT(inSuite, handler.mPaths[2].mAttributeId == 0x0002 && handler.mValues[2] == std::vector<uint8_t>({ 9 }));
+}
+
+void TestDiscard(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext ctx;
+    CoalescingAttributePersistenceProvider::Entry entries[2];
+    CoalescingAttributePersistenceProvider provider(ctx.mPersister, Span<CoalescingAttributePersistenceProvider::Entry>(entries),
+                                                    System::Clock::Milliseconds32(1000));
+
+    ctx.Write(provider, 0x0000, 1);
+    provider.Discard();
+    provider.Flush();
+    NL_TEST_ASSERT(inSuite, ctx.mPersister.mWrites == 0);
+
+    // Entries are reusable.
+    ctx.Write(provider, 0x0000, 2);
+    provider.Flush();
+    NL_TEST_ASSERT(inSuite, ctx.Stored(0x0000) == 2);
+}
+
+const nlTest sTests[] = { NL_TEST_DEF("Test coalescing writes", TestCoalesceWrites),
+                          NL_TEST_DEF("Test eviction when the table is full", TestEviction),
+                          NL_TEST_DEF("Test values too large to be held", TestLargeValue),
+                          NL_TEST_DEF("Test ReadValues with pending values", TestReadValues),
+                          NL_TEST_DEF("Test discarding pending values", TestDiscard), NL_TEST_SENTINEL() };
+
+} // namespace
+
+int TestCoalescingAttributePersistenceProvider()
+{
+    nlTestSuite theSuite = { "Coalescing attribute persistence provider tests", &sTests[0], nullptr, nullptr };
+
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestCoalescingAttributePersistenceProvider)
@@ -40,6 +40,7 @@
 #include <messaging/ExchangeContext.h>
 #include <messaging/Flags.h>
 #include <platform/CHIPDeviceLayer.h>
+#include <system/SystemClock.h>
 #include <system/TLVPacketBufferBackingStore.h>
 
 #include <nlunit-test.h>
@@ -170,7 +171,83 @@ static void CheckLogEventOverFlow(nlTestSuite * apSuite, void * apContext)
     }
 }
 
-const nlTest sTests[] = { NL_TEST_DEF("CheckLogEventOverFlow", CheckLogEventOverFlow), NL_TEST_SENTINEL() };
+static chip::EventNumber ReadEventNumber(nlTestSuite * apSuite, const chip::TLV::TLVReader & aReader)
+{
+    chip::TLV::TLVReader reader;
+    chip::TLV::TLVType containerType;
+    chip::EventNumber eventNumber = 0;
+
+    reader.Init(aReader);
+    NL_TEST_ASSERT(apSuite, reader.EnterContainer(containerType) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, reader.Next() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, reader.EnterContainer(containerType) == CHIP_NO_ERROR);
+    while (reader.Next() == CHIP_NO_ERROR)
+    {
+        if (reader.GetTag() == chip::TLV::ContextTag(chip::to_underlying(chip::app::EventDataIB::Tag::kEventNumber)))
+        {
+            NL_TEST_ASSERT(apSuite, reader.Get(eventNumber) == CHIP_NO_ERROR);
+            break;
+        }
+    }
+    return eventNumber;
+}
+
+/**
+ * Keep the debug buffer overflowing with a burst of debug events, with the occasional critical event, and report how long LogEvent
+ * takes while events are being evicted and promoted.  The latency is only reported, not checked, so that slow CI machines do not
+ * make the test flaky.
+ */
+static void CheckLogEventOverflowLatency(nlTestSuite * apSuite, void * apContext)
+{
+    constexpr uint32_t kNumEvents = 2000;
+    chip::EventNumber oldEid      = 0;
+    chip::EventNumber eid         = 0;
+    chip::app::EventOptions options;
+    TestEventGenerator testEventGenerator;
+    uint64_t totalUs = 0;
+    uint64_t maxUs   = 0;
+
+    options.mPath = { 1, 0x00000006, 1 };
+
+    chip::app::EventManagement & logMgmt = chip::app::EventManagement::GetInstance();
+    for (uint32_t i = 0; i < kNumEvents; i++)
+    {
+        options.mPriority = (i % 20 == 0) ? chip::app::PriorityLevel::Critical : chip::app::PriorityLevel::Debug;
+
+        uint64_t startUs = chip::System::SystemClock().GetMonotonicMicroseconds64().count();
+        CHIP_ERROR err   = logMgmt.LogEvent(&testEventGenerator, options, eid);
+        uint64_t spentUs = chip::System::SystemClock().GetMonotonicMicroseconds64().count() - startUs;
+
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, oldEid == 0 || eid == oldEid + 1);
+        oldEid = eid;
+
+        totalUs += spentUs;
+        maxUs = std::max(maxUs, spentUs);
+    }
+
+    ChipLogProgress(EventLogging, "LogEvent latency under overflow over %u events: average %u us, worst %u us",
+                    static_cast<unsigned>(kNumEvents), static_cast<unsigned>(totalUs / kNumEvents), static_cast<unsigned>(maxUs));
+
+    // Moving whole segments between the priority buffers must keep the events in order: reading from the critical buffer back to
+    // the debug buffer goes from the oldest to the newest event.
+    chip::TLV::TLVReader reader;
+    chip::app::CircularEventBufferWrapper bufWrapper;
+    chip::EventNumber lastEventNumber = 0;
+    size_t numEvents                  = 0;
+    NL_TEST_ASSERT(apSuite, logMgmt.GetEventReader(reader, chip::app::PriorityLevel::Critical, &bufWrapper) == CHIP_NO_ERROR);
+    while (reader.Next() == CHIP_NO_ERROR)
+    {
+        chip::EventNumber eventNumber = ReadEventNumber(apSuite, reader);
+        NL_TEST_ASSERT(apSuite, numEvents == 0 || eventNumber > lastEventNumber);
+        lastEventNumber = eventNumber;
+        numEvents++;
+    }
+    NL_TEST_ASSERT(apSuite, numEvents > 0 && lastEventNumber == eid);
+}
+
+const nlTest sTests[] = { NL_TEST_DEF("CheckLogEventOverFlow", CheckLogEventOverFlow),
+                          NL_TEST_DEF("CheckLogEventOverflowLatency", CheckLogEventOverflowLatency), NL_TEST_SENTINEL() };
 
 // clang-format off
 nlTestSuite sSuite =
@@ -56,10 +56,24 @@ public:
     static void TestBuildAndSendSingleReportData(nlTestSuite * apSuite, void * apContext);
     static void TestMergeOverlappedAttributePath(nlTestSuite * apSuite, void * apContext);
     static void TestMergeAttributePathWhenDirtySetPoolExhausted(nlTestSuite * apSuite, void * apContext);
+    static void TestDirtyBatch(nlTestSuite * apSuite, void * apContext);
+    static void TestNextReadHandlerToReport(nlTestSuite * apSuite, void * apContext);
+#if CHIP_IM_SERVER_MAX_NUM_CACHED_ATTRIBUTE_REPORTS > 0
+    static void TestAttributeReportEncodeCache(nlTestSuite * apSuite, void * apContext);
+#endif
 
 private:
     static bool InsertToDirtySet(const AttributePathParams & aPath);
 
+    // Turn aReadHandler into an established subscription, due to report aMaxInterval seconds after aLastReport.
+    static void MakeReportableSubscription(ReadHandler & aReadHandler, System::Clock::Timestamp aLastReport, uint16_t aMaxInterval)
+    {
+        aReadHandler.ClearStateFlag(ReadHandler::ReadHandlerFlags::PrimingReports);
+        aReadHandler.mLastReportTimestamp = aLastReport;
+        aReadHandler.mMaxInterval         = aMaxInterval;
+        aReadHandler.MoveToState(ReadHandler::HandlerState::GeneratingReports);
+    }
+
     struct ExpectedDirtySetContent : public AttributePathParams
     {
         ExpectedDirtySetContent(const AttributePathParams & path) : AttributePathParams(path) {}
@@ -321,6 +335,196 @@ void TestReportingEngine::TestMergeAttributePathWhenDirtySetPoolExhausted(nlTest
     InteractionModelEngine::GetInstance()->GetReportingEngine().Shutdown();
 }
 
+void TestReportingEngine::TestDirtyBatch(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    CHIP_ERROR err    = CHIP_NO_ERROR;
+    err               = InteractionModelEngine::GetInstance()->Init(&ctx.GetExchangeManager(), &ctx.GetFabricTable());
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    Engine & engine             = InteractionModelEngine::GetInstance()->GetReportingEngine();
+    uint64_t initialGeneration  = engine.GetDirtySetGeneration();
+    AttributePathParams path1   = AttributePathParams(kTestEndpointId, kTestClusterId, kTestFieldId1);
+    AttributePathParams path2   = AttributePathParams(kTestEndpointId, kTestClusterId, kTestFieldId2);
+    AttributePathParams cluster = AttributePathParams(kTestEndpointId, kTestClusterId);
+
+    {
+        ScopedDirtyBatch outerBatch(engine);
+        NL_TEST_ASSERT(apSuite, engine.IsDirtyBatchOpen());
+
+        // Duplicates are coalesced and nothing is applied while the batch is open.
+        NL_TEST_ASSERT(apSuite, engine.SetDirty(path1) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, engine.SetDirty(path1) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, engine.SetDirty(path2) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, engine.mNumPendingDirtyPaths == 2);
+        NL_TEST_ASSERT(apSuite, engine.GetDirtySetGeneration() == initialGeneration);
+
+        {
+            // A nested batch does not flush, and a wildcard path swallows the pending paths it covers.
+            ScopedDirtyBatch innerBatch(engine);
+            NL_TEST_ASSERT(apSuite, engine.SetDirty(cluster) == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(apSuite, engine.mPendingDirtyPaths[0] == cluster);
+        }
+        NL_TEST_ASSERT(apSuite, engine.IsDirtyBatchOpen());
+        NL_TEST_ASSERT(apSuite, engine.GetDirtySetGeneration() == initialGeneration);
+    }
+
+    // Closing the outermost batch flushes all pending paths with a single generation bump.
+    NL_TEST_ASSERT(apSuite, !engine.IsDirtyBatchOpen());
+    NL_TEST_ASSERT(apSuite, engine.mNumPendingDirtyPaths == 0);
+    NL_TEST_ASSERT(apSuite, engine.GetDirtySetGeneration() == initialGeneration + 1);
+
+    // Running out of pending space flushes early instead of dropping paths.
+    {
+        ScopedDirtyBatch batch(engine);
+        for (EndpointId i = 1; i <= CHIP_IM_SERVER_MAX_NUM_PENDING_DIRTY_PATHS + 1; i++)
+        {
+            AttributePathParams path(i, kTestClusterId, kTestFieldId1);
+            NL_TEST_ASSERT(apSuite, engine.SetDirty(path) == CHIP_NO_ERROR);
+        }
+        NL_TEST_ASSERT(apSuite, engine.mNumPendingDirtyPaths == 1);
+        NL_TEST_ASSERT(apSuite, engine.GetDirtySetGeneration() == initialGeneration + 2);
+    }
+    NL_TEST_ASSERT(apSuite, engine.GetDirtySetGeneration() == initialGeneration + 3);
+
+    NL_TEST_ASSERT(apSuite, engine.EndDirtyBatch() == CHIP_ERROR_INCORRECT_STATE);
+
+    engine.Shutdown();
+}
+
+void TestReportingEngine::TestNextReadHandlerToReport(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    CHIP_ERROR err    = CHIP_NO_ERROR;
+    err               = InteractionModelEngine::GetInstance()->Init(&ctx.GetExchangeManager(), &ctx.GetFabricTable());
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    Engine & engine = InteractionModelEngine::GetInstance()->GetReportingEngine();
+    auto & pool     = InteractionModelEngine::GetInstance()->GetReadHandlerPool();
+    TestExchangeDelegate delegate;
+    DummyDelegate dummy;
+
+    // The handlers are iterated in creation order, so each expectation below picks a handler other than the first one.
+    ReadHandler * first  = pool.CreateObject(dummy, ctx.NewExchangeToAlice(&delegate), ReadHandler::InteractionType::Subscribe);
+    ReadHandler * second = pool.CreateObject(dummy, ctx.NewExchangeToAlice(&delegate), ReadHandler::InteractionType::Subscribe);
+    ReadHandler * other  = pool.CreateObject(dummy, ctx.NewExchangeToBob(&delegate), ReadHandler::InteractionType::Subscribe);
+    NL_TEST_ASSERT(apSuite, first != nullptr && second != nullptr && other != nullptr);
+    NL_TEST_ASSERT(apSuite, first->GetAccessingFabricIndex() == second->GetAccessingFabricIndex());
+    NL_TEST_ASSERT(apSuite, first->GetAccessingFabricIndex() != other->GetAccessingFabricIndex());
+
+    const System::Clock::Timestamp now = System::Clock::Seconds64(1000);
+    const size_t firstFabric           = Engine::FabricSlot(first->GetAccessingFabricIndex());
+    engine.mRunCount++;
+    memset(engine.mReportsPerFabricInRun, 0, sizeof(engine.mReportsPerFabricInRun));
+
+    // The expectations below change the handlers between picks, so the candidates are gathered again for each of them.
+    auto nextReadHandlerToReport = [&engine, now]() {
+        engine.CollectReportCandidates(now);
+        return engine.NextReadHandlerToReport();
+    };
+
+    // Nothing is reportable until the handlers are generating reports.
+    NL_TEST_ASSERT(apSuite, nextReadHandlerToReport() == nullptr);
+
+    // Deadline: the subscription whose max interval ends first goes first.
+    MakeReportableSubscription(*first, now - System::Clock::Seconds16(10), 60);
+    MakeReportableSubscription(*second, now - System::Clock::Seconds16(20), 60);
+    MakeReportableSubscription(*other, now - System::Clock::Seconds16(5), 60);
+    NL_TEST_ASSERT(apSuite, nextReadHandlerToReport() == second);
+
+    // Fairness: a fabric that already reported in this run yields to the others, whatever their deadlines.
+    engine.mReportsPerFabricInRun[firstFabric] = 1;
+    NL_TEST_ASSERT(apSuite, nextReadHandlerToReport() == other);
+
+    // Urgency: a subscription past its max interval goes first, even from a fabric that already reported.
+    second->mMaxInterval = 10;
+    NL_TEST_ASSERT(apSuite, nextReadHandlerToReport() == second);
+    second->mMaxInterval = 60;
+
+    // Urgency: so does a forced report, and urgent handlers are ordered by deadline among themselves.
+    first->SetStateFlag(ReadHandler::ReadHandlerFlags::ForceDirty);
+    NL_TEST_ASSERT(apSuite, nextReadHandlerToReport() == first);
+    second->SetStateFlag(ReadHandler::ReadHandlerFlags::ForceDirty);
+    engine.mReportsPerFabricInRun[firstFabric] = 0;
+    NL_TEST_ASSERT(apSuite, nextReadHandlerToReport() == second);
+
+    // Priming reports are never urgent, and their deadline is the time the request was received.
+    second->SetStateFlag(ReadHandler::ReadHandlerFlags::PrimingReports);
+    NL_TEST_ASSERT(apSuite, nextReadHandlerToReport() == first);
+    first->ClearStateFlag(ReadHandler::ReadHandlerFlags::ForceDirty);
+    NL_TEST_ASSERT(apSuite, nextReadHandlerToReport() == second);
+
+    // A handler is serviced at most once per run.
+    second->mLastServicedRun = engine.mRunCount;
+    NL_TEST_ASSERT(apSuite, nextReadHandlerToReport() == first);
+    first->mLastServicedRun = engine.mRunCount;
+    NL_TEST_ASSERT(apSuite, nextReadHandlerToReport() == other);
+    other->mLastServicedRun = engine.mRunCount;
+    NL_TEST_ASSERT(apSuite, nextReadHandlerToReport() == nullptr);
+
+    // Within a run, the candidates gathered once are handed out in order, and a released handler is skipped.
+    engine.mRunCount++;
+    second->ClearStateFlag(ReadHandler::ReadHandlerFlags::PrimingReports);
+    second->ClearStateFlag(ReadHandler::ReadHandlerFlags::ForceDirty);
+    engine.CollectReportCandidates(now);
+    NL_TEST_ASSERT(apSuite, engine.NextReadHandlerToReport() == second);
+    engine.mReportsPerFabricInRun[firstFabric] = 1;
+    engine.ResetReadHandlerTracker(other);
+    NL_TEST_ASSERT(apSuite, engine.NextReadHandlerToReport() == first);
+    NL_TEST_ASSERT(apSuite, engine.NextReadHandlerToReport() == nullptr);
+
+    pool.ReleaseAll();
+    ctx.DrainAndServiceIO();
+    NL_TEST_ASSERT(apSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
+    engine.Shutdown();
+}
+
+#if CHIP_IM_SERVER_MAX_NUM_CACHED_ATTRIBUTE_REPORTS > 0
+void TestReportingEngine::TestAttributeReportEncodeCache(nlTestSuite * apSuite, void * apContext)
+{
+    AttributeReportEncodeCache cache;
+    ConcreteReadAttributePath path(kTestEndpointId, kTestClusterId, kTestFieldId1);
+    const uint8_t encoded[] = { 0x16, 0x18 };
+    ByteSpan found;
+
+    cache.SetGeneration(1);
+    NL_TEST_ASSERT(apSuite, !cache.Find(path, 1, false, found));
+
+    cache.Store(path, 1, false, ByteSpan(encoded));
+    NL_TEST_ASSERT(apSuite, cache.Find(path, 1, false, found));
+    NL_TEST_ASSERT(apSuite, found.data_equal(ByteSpan(encoded)));
+
+    // Encodings larger than an entry are not kept.
+    uint8_t large[AttributeReportEncodeCache::kEntrySize + 1] = {};
+    ConcreteReadAttributePath largePath(kTestEndpointId, kTestClusterId, kTestFieldId2);
+    cache.Store(largePath, 1, false, ByteSpan(large));
+    NL_TEST_ASSERT(apSuite, !cache.Find(largePath, 1, false, found));
+
+    // The fabric context is part of the key.
+    NL_TEST_ASSERT(apSuite, !cache.Find(path, 2, false, found));
+    NL_TEST_ASSERT(apSuite, !cache.Find(path, 1, true, found));
+
+    // Whether the path comes from a wildcard expansion changes how errors are reported, so it is part of the key as well.
+    ConcreteReadAttributePath expandedPath(path);
+    expandedPath.mExpanded = true;
+    NL_TEST_ASSERT(apSuite, !cache.Find(expandedPath, 1, false, found));
+
+    // Entries are kept as long as the dirty set generation does not move.
+    cache.SetGeneration(1);
+    NL_TEST_ASSERT(apSuite, cache.Find(path, 1, false, found));
+    cache.SetGeneration(2);
+    NL_TEST_ASSERT(apSuite, !cache.Find(path, 1, false, found));
+
+    // The oldest entry is evicted once every entry is in use.
+    for (AttributeId i = 0; i <= AttributeReportEncodeCache::kNumEntries; i++)
+    {
+        cache.Store(ConcreteReadAttributePath(kTestEndpointId, kTestClusterId, i), 1, false, ByteSpan(encoded));
+    }
+    NL_TEST_ASSERT(apSuite, !cache.Find(ConcreteReadAttributePath(kTestEndpointId, kTestClusterId, 0), 1, false, found));
+    NL_TEST_ASSERT(apSuite, cache.Find(ConcreteReadAttributePath(kTestEndpointId, kTestClusterId, 1), 1, false, found));
+}
+#endif
+
 } // namespace reporting
 } // namespace app
 } // namespace chip
@@ -332,6 +536,11 @@ const nlTest sTests[] =
     NL_TEST_DEF("CheckBuildAndSendSingleReportData", chip::app::reporting::TestReportingEngine::TestBuildAndSendSingleReportData),
     NL_TEST_DEF("TestMergeOverlappedAttributePath", chip::app::reporting::TestReportingEngine::TestMergeOverlappedAttributePath),
     NL_TEST_DEF("TestMergeAttributePathWhenDirtySetPoolExhausted", chip::app::reporting::TestReportingEngine::TestMergeAttributePathWhenDirtySetPoolExhausted),
+    NL_TEST_DEF("TestDirtyBatch", chip::app::reporting::TestReportingEngine::TestDirtyBatch),
+    NL_TEST_DEF("TestNextReadHandlerToReport", chip::app::reporting::TestReportingEngine::TestNextReadHandlerToReport),
+#if CHIP_IM_SERVER_MAX_NUM_CACHED_ATTRIBUTE_REPORTS > 0
+    NL_TEST_DEF("TestAttributeReportEncodeCache", chip::app::reporting::TestReportingEngine::TestAttributeReportEncodeCache),
+#endif
     NL_TEST_SENTINEL()
 };
 // clang-format on
@@ -182,7 +182,7 @@ void InteractionModel::OnError(const WriteClient * client, CHIP_ERROR error)
 
 void InteractionModel::OnDone(WriteClient * client)
 {
-    mWriteClient.reset();
+    InteractionModelWriter::CleanupWriteClient(client);
     ContinueOnChipMainThread(CHIP_NO_ERROR);
 }
 
@@ -201,11 +201,7 @@ void InteractionModel::OnError(const CommandSender * client, CHIP_ERROR error)
 
 void InteractionModel::OnDone(CommandSender * client)
 {
-    if (mCommandSender.size())
-    {
-        mCommandSender.front().reset();
-        mCommandSender.erase(mCommandSender.begin());
-    }
+    InteractionModelCommands::CleanupCommandSender(client);
 
     // If the command is repeated N times, wait for all the responses to comes in
     // before exiting.
@@ -353,7 +349,7 @@ CHIP_ERROR InteractionModelReports::ReportAttribute(DeviceProxy * device, std::v
     }
 
     auto client = std::make_unique<ReadClient>(InteractionModelEngine::GetInstance(), device->GetExchangeManager(),
-                                               mBufferedReadAdapter, interactionType);
+                                               GetReadClientCallback(), interactionType);
     if (interactionType == ReadClient::InteractionType::Read)
     {
         ReturnErrorOnFailure(client->SendRequest(params));
@@ -482,7 +478,7 @@ CHIP_ERROR InteractionModelReports::ReportEvent(DeviceProxy * device, std::vecto
     }
 
     auto client = std::make_unique<ReadClient>(InteractionModelEngine::GetInstance(), device->GetExchangeManager(),
-                                               mBufferedReadAdapter, interactionType);
+                                               GetReadClientCallback(), interactionType);
     if (mAutoResubscribe.ValueOr(false))
     {
         eventPathParams.release();
@@ -621,7 +617,7 @@ CHIP_ERROR InteractionModelReports::ReportAll(chip::DeviceProxy * device, std::v
     }
 
     auto client = std::make_unique<ReadClient>(InteractionModelEngine::GetInstance(), device->GetExchangeManager(),
-                                               mBufferedReadAdapter, interactionType);
+                                               GetReadClientCallback(), interactionType);
     ReturnErrorOnFailure(client->SendRequest(params));
     mReadClients.push_back(std::move(client));
     return CHIP_NO_ERROR;
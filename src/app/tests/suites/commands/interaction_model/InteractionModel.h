@@ -28,6 +28,8 @@
 #include <lib/support/CodeUtils.h>
 #include <lib/support/UnitTestUtils.h>
 
+#include <algorithm>
+
 constexpr uint8_t kMaxAllowedPaths = 10;
 
 namespace chip {
@@ -56,8 +58,12 @@ class InteractionModelReports
 {
 public:
     InteractionModelReports(chip::app::ReadClient::Callback * callback) : mBufferedReadAdapter(*callback) { ResetOptions(); }
+    virtual ~InteractionModelReports() = default;
 
 protected:
+    // Get the callback the next read client reports to.
+    virtual chip::app::ReadClient::Callback & GetReadClientCallback() { return mBufferedReadAdapter; }
+
     CHIP_ERROR ReadAttribute(chip::DeviceProxy * device, std::vector<chip::EndpointId> endpointIds,
                              std::vector<chip::ClusterId> clusterIds, std::vector<chip::AttributeId> attributeIds)
     {
@@ -281,6 +287,13 @@ protected:
         mCommandSender.clear();
     }
 
+    void CleanupCommandSender(chip::app::CommandSender * commandSender)
+    {
+        mCommandSender.erase(std::remove_if(mCommandSender.begin(), mCommandSender.end(),
+                                            [commandSender](auto & item) { return item.get() == commandSender; }),
+                             mCommandSender.end());
+    }
+
     std::vector<std::unique_ptr<chip::app::CommandSender>> mCommandSender;
     chip::app::CommandSender::Callback * mCallback;
 
@@ -363,7 +376,7 @@ protected:
 class InteractionModelWriter
 {
 public:
-    InteractionModelWriter(chip::app::WriteClient::Callback * callback) : mChunkedWriteCallback(callback) {}
+    InteractionModelWriter(chip::app::WriteClient::Callback * callback) : mCallback(callback), mChunkedWriteCallback(callback) {}
 
 protected:
     template <class T>
@@ -381,19 +394,23 @@ protected:
         while (repeat--)
         {
 
-            mWriteClient = std::make_unique<chip::app::WriteClient>(device->GetExchangeManager(), &mChunkedWriteCallback,
-                                                                    mTimedInteractionTimeoutMs, mSuppressResponse.ValueOr(false));
-            VerifyOrReturnError(mWriteClient != nullptr, CHIP_ERROR_NO_MEMORY);
+            auto write = std::make_unique<PendingWrite>(mCallback);
+            VerifyOrReturnError(write != nullptr, CHIP_ERROR_NO_MEMORY);
+            write->writeClient =
+                std::make_unique<chip::app::WriteClient>(device->GetExchangeManager(), &write->chunkedWriteCallback,
+                                                         mTimedInteractionTimeoutMs, mSuppressResponse.ValueOr(false));
+            VerifyOrReturnError(write->writeClient != nullptr, CHIP_ERROR_NO_MEMORY);
 
             for (uint8_t i = 0; i < pathsConfig.count; i++)
             {
                 auto & path        = pathsConfig.attributePathParams[i];
                 auto & dataVersion = pathsConfig.dataVersionFilter[i].mDataVersion;
                 const T & value    = i >= values.size() ? values.at(0) : values.at(i);
-                ReturnErrorOnFailure(EncodeAttribute<T>(path, dataVersion, value));
+                ReturnErrorOnFailure(EncodeAttribute<T>(*write->writeClient, path, dataVersion, value));
             }
 
-            ReturnErrorOnFailure(mWriteClient->SendWriteRequest(device->GetSecureSession().Value()));
+            ReturnErrorOnFailure(write->writeClient->SendWriteRequest(device->GetSecureSession().Value()));
+            mWrites.push_back(std::move(write));
 
             if (mBusyWaitForMs.HasValue())
             {
@@ -452,9 +469,28 @@ protected:
         return writeClient.SendWriteRequest(chip::SessionHandle(session));
     }
 
-    void Shutdown() { mWriteClient.reset(); }
+    // A write in flight.  Each one has its own ChunkedWriteCallback, which holds the status of the
+    // last path responded to until the next response or the end of the write.
+    struct PendingWrite
+    {
+        PendingWrite(chip::app::WriteClient::Callback * callback) : chunkedWriteCallback(callback) {}
+
+        chip::app::ChunkedWriteCallback chunkedWriteCallback;
+        std::unique_ptr<chip::app::WriteClient> writeClient;
+    };
+
+    void Shutdown() { mWrites.clear(); }
+
+    void CleanupWriteClient(const chip::app::WriteClient * writeClient)
+    {
+        mWrites.erase(std::remove_if(mWrites.begin(), mWrites.end(),
+                                     [writeClient](auto & item) { return item->writeClient.get() == writeClient; }),
+                      mWrites.end());
+    }
 
-    std::unique_ptr<chip::app::WriteClient> mWriteClient;
+    std::vector<std::unique_ptr<PendingWrite>> mWrites;
+    chip::app::WriteClient::Callback * mCallback;
+    // Group writes are done by the time they are sent, so they share this one.
     chip::app::ChunkedWriteCallback mChunkedWriteCallback;
 
     InteractionModelWriter & SetTimedInteractionTimeoutMs(uint16_t timedInteractionTimeoutMs)
@@ -548,17 +584,19 @@ protected:
 
 private:
     template <typename T>
-    CHIP_ERROR EncodeAttribute(const chip::app::AttributePathParams & path, const chip::Optional<chip::DataVersion> & dataVersion,
-                               T value, typename std::enable_if<!std::is_pointer<T>::value>::type * = 0)
+    CHIP_ERROR EncodeAttribute(chip::app::WriteClient & writeClient, const chip::app::AttributePathParams & path,
+                               const chip::Optional<chip::DataVersion> & dataVersion, T value,
+                               typename std::enable_if<!std::is_pointer<T>::value>::type * = 0)
     {
-        return mWriteClient->EncodeAttribute(path, value, dataVersion);
+        return writeClient.EncodeAttribute(path, value, dataVersion);
     }
 
     template <typename T>
-    CHIP_ERROR EncodeAttribute(const chip::app::AttributePathParams & path, const chip::Optional<chip::DataVersion> & dataVersion,
-                               T value, typename std::enable_if<std::is_pointer<T>::value>::type * = 0)
+    CHIP_ERROR EncodeAttribute(chip::app::WriteClient & writeClient, const chip::app::AttributePathParams & path,
+                               const chip::Optional<chip::DataVersion> & dataVersion, T value,
+                               typename std::enable_if<std::is_pointer<T>::value>::type * = 0)
     {
-        return mWriteClient->EncodeAttribute(path, *value, dataVersion);
+        return writeClient.EncodeAttribute(path, *value, dataVersion);
     }
 };
 
@@ -64,6 +64,10 @@ uint8_t singletonAttributeData[ACTUAL_SINGLETONS_SIZE];
 
 uint16_t emberEndpointCount = 0;
 
+// Bumped whenever endpoints are added, removed, enabled or disabled, so that cached views of the endpoint / cluster / attribute
+// structure know they have to be rebuilt.
+uint32_t sMetadataStructureGeneration = 0;
+
 // If we have attributes that are more than 4 bytes, then
 // we need this data block for the defaults
 #if (defined(GENERATED_DEFAULTS) && GENERATED_DEFAULTS_COUNT)
@@ -151,6 +155,7 @@ void emberAfEndpointConfigure()
         // this endpoint has.
         currentDataVersions += emberAfClusterCountByIndex(ep, /* server = */ true);
     }
+    sMetadataStructureGeneration++;
 
 #if CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT
     if (MAX_ENDPOINT_COUNT > FIXED_ENDPOINT_COUNT)
@@ -169,6 +174,7 @@ void emberAfEndpointConfigure()
 void emberAfSetDynamicEndpointCount(uint16_t dynamicEndpointCount)
 {
     emberEndpointCount = static_cast<uint16_t>(FIXED_ENDPOINT_COUNT + dynamicEndpointCount);
+    sMetadataStructureGeneration++;
 }
 
 uint16_t emberAfGetDynamicIndexFromEndpoint(EndpointId id)
@@ -258,6 +264,7 @@ EndpointId emberAfClearDynamicEndpoint(uint16_t index)
         ep = emAfEndpoints[index].endpoint;
         emberAfEndpointEnableDisable(ep, false);
         emAfEndpoints[index].endpoint = kInvalidEndpointId;
+        sMetadataStructureGeneration++;
     }
 
     return ep;
@@ -278,6 +285,11 @@ bool emberAfEndpointIndexIsEnabled(uint16_t index)
     return (emAfEndpoints[index].bitmask & EMBER_AF_ENDPOINT_ENABLED);
 }
 
+uint32_t emberAfMetadataStructureGeneration()
+{
+    return sMetadataStructureGeneration;
+}
+
 // some data types (like strings) are sent OTA in human readable order
 // (how they are read) instead of little endian as the data types are.
 bool emberAfIsThisDataTypeAStringType(EmberAfAttributeType dataType)
@@ -839,6 +851,8 @@ bool emberAfEndpointEnableDisable(EndpointId endpoint, bool enable)
 
     if (currentlyEnabled != enable)
     {
+        sMetadataStructureGeneration++;
+
         if (enable)
         {
             initializeEndpoint(&(emAfEndpoints[index]));
@@ -1121,15 +1135,39 @@ void emberAfResetAttributes(EndpointId endpoint)
     emAfLoadAttributeDefaults(endpoint, true);
 }
 
+namespace {
+
+// Writes the persisted attribute values read at startup into the attribute store.
+class PersistedValueLoader : public app::AttributePersistenceProvider::ValueHandler
+{
+public:
+    void OnValueRead(const app::ConcreteAttributePath & aPath, const EmberAfAttributeMetadata * aMetadata,
+                     const ByteSpan & aValue) override
+    {
+        EmberAfAttributeSearchRecord record;
+        record.endpoint    = aPath.mEndpointId;
+        record.clusterId   = aPath.mClusterId;
+        record.attributeId = aPath.mAttributeId;
+
+        emAfReadOrWriteAttribute(&record,
+                                 nullptr, // metadata - unused
+                                 const_cast<uint8_t *>(aValue.data()),
+                                 0,     // buffer size - unused
+                                 true); // write?
+    }
+};
+
+} // anonymous namespace
+
 void emAfLoadAttributeDefaults(EndpointId endpoint, bool ignoreStorage, Optional<ClusterId> clusterId)
 {
     uint16_t ep;
     uint8_t clusterI;
     uint16_t attr;
-    uint8_t * ptr;
     uint16_t epCount = emberAfEndpointCount();
     uint8_t attrData[ATTRIBUTE_LARGEST];
     auto * attrStorage = ignoreStorage ? nullptr : app::GetAttributePersistenceProvider();
+    PersistedValueLoader persistedValueLoader;
     // Don't check whether we actually have an attrStorage here, because it's OK
     // to have one if none of our attributes have NVM storage.
 
@@ -1165,31 +1203,14 @@ void emAfLoadAttributeDefaults(EndpointId endpoint, bool ignoreStorage, Optional
             {
                 // halResetWatchdog();
             }
+            bool hasPersistedAttributes = false;
             for (attr = 0; attr < cluster->attributeCount; attr++)
             {
                 const EmberAfAttributeMetadata * am = &(cluster->attributes[attr]);
-                ptr                                 = nullptr; // Will get set to the value to write, as needed.
 
-                // First check for a persisted value.
-                if (!ignoreStorage && am->IsAutomaticallyPersisted())
-                {
-                    VerifyOrDie(attrStorage && "Attribute persistence needs a persistence provider");
-                    MutableByteSpan bytes(attrData);
-                    CHIP_ERROR err = attrStorage->ReadValue(
-                        app::ConcreteAttributePath(de->endpoint, cluster->clusterId, am->attributeId), am, bytes);
-                    if (err == CHIP_NO_ERROR)
-                    {
-                        ptr = attrData;
-                    }
-                    else
-                    {
-                        ChipLogDetail(
-                            DataManagement,
-                            "Failed to read stored attribute (%u, " ChipLogFormatMEI ", " ChipLogFormatMEI ": %" CHIP_ERROR_FORMAT,
-                            de->endpoint, ChipLogValueMEI(cluster->clusterId), ChipLogValueMEI(am->attributeId), err.Format());
-                        // Just fall back to default value.
-                    }
-                }
+                // Persisted values are loaded for the whole cluster below,
+                // over the default values.
+                hasPersistedAttributes = hasPersistedAttributes || am->IsAutomaticallyPersisted();
 
                 if (!am->IsExternal())
                 {
@@ -1198,56 +1219,54 @@ void emAfLoadAttributeDefaults(EndpointId endpoint, bool ignoreStorage, Optional
                     record.clusterId   = cluster->clusterId;
                     record.attributeId = am->attributeId;
 
-                    if (ptr == nullptr)
+                    uint8_t * ptr;
+                    size_t defaultValueSizeForBigEndianNudger = 0;
+                    // Bypasses compiler warning about unused variable for little endian platforms.
+                    (void) defaultValueSizeForBigEndianNudger;
+                    if ((am->mask & ATTRIBUTE_MASK_MIN_MAX) != 0U)
                     {
-                        size_t defaultValueSizeForBigEndianNudger = 0;
-                        // Bypasses compiler warning about unused variable for little endian platforms.
-                        (void) defaultValueSizeForBigEndianNudger;
-                        if ((am->mask & ATTRIBUTE_MASK_MIN_MAX) != 0U)
+                        // This is intentionally 2 and not 4 bytes since defaultValue in min/max
+                        // attributes is still uint16_t.
+                        if (emberAfAttributeSize(am) <= 2)
                         {
-                            // This is intentionally 2 and not 4 bytes since defaultValue in min/max
-                            // attributes is still uint16_t.
-                            if (emberAfAttributeSize(am) <= 2)
-                            {
-                                static_assert(sizeof(am->defaultValue.ptrToMinMaxValue->defaultValue.defaultValue) == 2,
-                                              "if statement relies on size of max/min defaultValue being 2");
-                                ptr = (uint8_t *) &(am->defaultValue.ptrToMinMaxValue->defaultValue.defaultValue);
-                                defaultValueSizeForBigEndianNudger =
-                                    sizeof(am->defaultValue.ptrToMinMaxValue->defaultValue.defaultValue);
-                            }
-                            else
-                            {
-                                ptr = (uint8_t *) am->defaultValue.ptrToMinMaxValue->defaultValue.ptrToDefaultValue;
-                            }
+                            static_assert(sizeof(am->defaultValue.ptrToMinMaxValue->defaultValue.defaultValue) == 2,
+                                          "if statement relies on size of max/min defaultValue being 2");
+                            ptr = (uint8_t *) &(am->defaultValue.ptrToMinMaxValue->defaultValue.defaultValue);
+                            defaultValueSizeForBigEndianNudger =
+                                sizeof(am->defaultValue.ptrToMinMaxValue->defaultValue.defaultValue);
                         }
                         else
                         {
-                            if ((emberAfAttributeSize(am) <= 4) && !emberAfIsStringAttributeType(am->attributeType))
-                            {
-                                ptr                                = (uint8_t *) &(am->defaultValue.defaultValue);
-                                defaultValueSizeForBigEndianNudger = sizeof(am->defaultValue.defaultValue);
-                            }
-                            else
-                            {
-                                ptr = (uint8_t *) am->defaultValue.ptrToDefaultValue;
-                            }
+                            ptr = (uint8_t *) am->defaultValue.ptrToMinMaxValue->defaultValue.ptrToDefaultValue;
                         }
-                        // At this point, ptr either points to a default value, or is NULL, in which case
-                        // it should be treated as if it is pointing to an array of all zeroes.
-
-#if (BIGENDIAN_CPU)
-                        // The default values for attributes that are less than or equal to
-                        // defaultValueSizeForBigEndianNudger in bytes are stored in an
-                        // uint32_t.  On big-endian platforms, a pointer to the default value
-                        // of size less than defaultValueSizeForBigEndianNudger will point to the wrong
-                        // byte.  So, for those cases, nudge the pointer forward so it points
-                        // to the correct byte.
-                        if (emberAfAttributeSize(am) < defaultValueSizeForBigEndianNudger && ptr != NULL)
+                    }
+                    else
+                    {
+                        if ((emberAfAttributeSize(am) <= 4) && !emberAfIsStringAttributeType(am->attributeType))
                         {
-                            ptr += (defaultValueSizeForBigEndianNudger - emberAfAttributeSize(am));
+                            ptr                                = (uint8_t *) &(am->defaultValue.defaultValue);
+                            defaultValueSizeForBigEndianNudger = sizeof(am->defaultValue.defaultValue);
                         }
-#endif // BIGENDIAN
+                        else
+                        {
+                            ptr = (uint8_t *) am->defaultValue.ptrToDefaultValue;
+                        }
+                    }
+                    // At this point, ptr either points to a default value, or is NULL, in which case
+                    // it should be treated as if it is pointing to an array of all zeroes.
+
+#if (BIGENDIAN_CPU)
+                    // The default values for attributes that are less than or equal to
+                    // defaultValueSizeForBigEndianNudger in bytes are stored in an
+                    // uint32_t.  On big-endian platforms, a pointer to the default value
+                    // of size less than defaultValueSizeForBigEndianNudger will point to the wrong
+                    // byte.  So, for those cases, nudge the pointer forward so it points
+                    // to the correct byte.
+                    if (emberAfAttributeSize(am) < defaultValueSizeForBigEndianNudger && ptr != NULL)
+                    {
+                        ptr += (defaultValueSizeForBigEndianNudger - emberAfAttributeSize(am));
                     }
+#endif // BIGENDIAN
 
                     emAfReadOrWriteAttribute(&record,
                                              nullptr, // metadata - unused
@@ -1260,6 +1279,21 @@ void emAfLoadAttributeDefaults(EndpointId endpoint, bool ignoreStorage, Optional
                     }
                 }
             }
+
+            if (!ignoreStorage && hasPersistedAttributes)
+            {
+                VerifyOrDie(attrStorage && "Attribute persistence needs a persistence provider");
+                Span<const EmberAfAttributeMetadata> attributes(cluster->attributes, cluster->attributeCount);
+                CHIP_ERROR err = attrStorage->ReadValues(de->endpoint, cluster->clusterId, attributes, MutableByteSpan(attrData),
+                                                         persistedValueLoader);
+                if (err != CHIP_NO_ERROR)
+                {
+                    ChipLogDetail(DataManagement,
+                                  "Failed to read stored attributes (%u, " ChipLogFormatMEI "): %" CHIP_ERROR_FORMAT, de->endpoint,
+                                  ChipLogValueMEI(cluster->clusterId), err.Format());
+                    // Just keep the default values.
+                }
+            }
         }
         if (endpoint != EMBER_BROADCAST_ENDPOINT)
         {
@@ -243,6 +243,10 @@ EmberAfStatus emberAfSetDynamicEndpoint(uint16_t index, chip::EndpointId id, con
 chip::EndpointId emberAfClearDynamicEndpoint(uint16_t index);
 uint16_t emberAfGetDynamicIndexFromEndpoint(chip::EndpointId id);
 
+// Get a counter that changes whenever an endpoint is added, removed, enabled or disabled, i.e. whenever the set of endpoints,
+// clusters or attributes that are supported may have changed.
+uint32_t emberAfMetadataStructureGeneration();
+
 // Get the number of attributes of the specific cluster under the endpoint.
 // Returns 0 if the cluster does not exist.
 uint16_t emberAfGetServerAttributeCount(chip::EndpointId endpoint, chip::ClusterId cluster);
@@ -1127,6 +1127,34 @@ void MatterReportingAttributeChangeCallback(const ConcreteAttributePath & aPath)
     return MatterReportingAttributeChangeCallback(aPath.mEndpointId, aPath.mClusterId, aPath.mAttributeId);
 }
 
+void MatterReportingAttributeChangeCallback(const Span<const ConcreteAttributePath> & aPaths)
+{
+    assertChipStackLockedByCurrentThread();
+
+    reporting::ScopedDirtyBatch batch(InteractionModelEngine::GetInstance()->GetReportingEngine());
+
+    const ConcreteAttributePath * paths = aPaths.data();
+    for (size_t i = 0; i < aPaths.size(); i++)
+    {
+        const ConcreteAttributePath & path = paths[i];
+
+        // Only bump the data version the first time we see a cluster, a single version change covers all the attributes of the
+        // cluster that changed within this batch.
+        bool clusterSeen = false;
+        for (size_t j = 0; j < i && !clusterSeen; j++)
+        {
+            clusterSeen = (paths[j].mEndpointId == path.mEndpointId && paths[j].mClusterId == path.mClusterId);
+        }
+        if (!clusterSeen)
+        {
+            IncreaseClusterDataVersion(ConcreteClusterPath(path.mEndpointId, path.mClusterId));
+        }
+
+        AttributePathParams info(path.mEndpointId, path.mClusterId, path.mAttributeId);
+        InteractionModelEngine::GetInstance()->GetReportingEngine().SetDirty(info);
+    }
+}
+
 void MatterReportingAttributeChangeCallback(EndpointId endpoint)
 {
     // Attribute writes have asserted this already, but this assert should catch
@@ -36,5 +36,6 @@ CHIP_ERROR ReadSingleMockClusterData(FabricIndex aAccessingFabricIndex, const ap
                                      app::AttributeValueEncoder::AttributeEncodeState * apEncoderState);
 void BumpVersion();
 DataVersion GetVersion();
+void SetMockEndpointEnabled(EndpointId aEndpointId, bool aEnabled);
 } // namespace Test
 } // namespace chip
@@ -78,6 +78,10 @@ AttributeId attributes[]  = {
     // clang-format on
 };
 
+// Endpoints can be disabled by tests, which changes the metadata structure generation.
+bool endpointDisabled[ArraySize(endpoints)] = {};
+uint32_t metadataStructureGeneration        = 0;
+
 uint16_t mockClusterRevision = 1;
 uint32_t mockFeatureMap      = 0x1234;
 bool mockAttribute1          = true;
@@ -220,7 +224,12 @@ uint8_t emberAfClusterIndex(chip::EndpointId endpoint, chip::ClusterId cluster,
 
 bool emberAfEndpointIndexIsEnabled(uint16_t index)
 {
-    return index < ArraySize(endpoints);
+    return index < ArraySize(endpoints) && !endpointDisabled[index];
+}
+
+uint32_t emberAfMetadataStructureGeneration()
+{
+    return metadataStructureGeneration;
 }
 
 // This duplication of basic utilities is really unfortunate, but we can't link
@@ -271,6 +280,17 @@ DataVersion GetVersion()
     return dataVersion;
 }
 
+void SetMockEndpointEnabled(EndpointId aEndpointId, bool aEnabled)
+{
+    uint16_t endpointIndex = emberAfIndexFromEndpoint(aEndpointId);
+    VerifyOrDie(endpointIndex < ArraySize(endpoints));
+    if (endpointDisabled[endpointIndex] == aEnabled)
+    {
+        endpointDisabled[endpointIndex] = !aEnabled;
+        metadataStructureGeneration++;
+    }
+}
+
 CHIP_ERROR ReadSingleMockClusterData(FabricIndex aAccessingFabricIndex, const ConcreteAttributePath & aPath,
                                      AttributeReportIBs::Builder & aAttributeReports,
                                      AttributeValueEncoder::AttributeEncodeState * apEncoderState)
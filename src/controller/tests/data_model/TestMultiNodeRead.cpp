@@ -0,0 +1,331 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include <app/InteractionModelEngine.h>
+#include <app/MultiNodeClusterStateCache.h>
+#include <app/MultiNodeReadClient.h>
+#include <app/tests/AppTestContext.h>
+#include <app/util/mock/Constants.h>
+#include <lib/support/UnitTestContext.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <messaging/tests/MessagingContext.h>
+#include <nlunit-test.h>
+
+using TestContext = chip::Test::AppContext;
+
+using namespace chip;
+using namespace chip::app;
+
+namespace {
+
+// Hundreds of nodes, all simulated by the interaction model engine of the test context, each
+// reached over its own CASE session.
+constexpr size_t kNodeCount            = 200;
+constexpr NodeId kFirstNodeId          = 0x1000;
+constexpr uint16_t kFirstSessionId     = 0x100; // clear of the sessions of the messaging context
+constexpr EndpointId kEndpointId       = chip::Test::kMockEndpoint2;
+constexpr ClusterId kClusterId         = chip::Test::MockClusterId(3);
+constexpr AttributeId kBoolAttributeId = chip::Test::MockAttributeId(1);
+constexpr AttributeId kInt16AttributeId = chip::Test::MockAttributeId(2);
+
+class SimulatedNodes
+{
+public:
+    CHIP_ERROR Create(TestContext & ctx)
+    {
+        const NodeId controllerNodeId = ctx.GetBobFabric()->GetNodeId();
+
+        for (size_t i = 0; i < kNodeCount; i++)
+        {
+            const uint16_t controllerSessionId = static_cast<uint16_t>(kFirstSessionId + 2 * i);
+            const uint16_t nodeSessionId       = static_cast<uint16_t>(controllerSessionId + 1);
+            const NodeId nodeId                = kFirstNodeId + i;
+
+            ReturnErrorOnFailure(ctx.GetSecureSessionManager().InjectCaseSessionWithTestKey(
+                mControllerSessions[i], controllerSessionId, nodeSessionId, controllerNodeId, nodeId, ctx.GetBobFabricIndex(),
+                Transport::PeerAddress::UDP(ctx.GetAddress(), CHIP_PORT + 1), CryptoContext::SessionRole::kInitiator));
+            ReturnErrorOnFailure(ctx.GetSecureSessionManager().InjectCaseSessionWithTestKey(
+                mNodeSessions[i], nodeSessionId, controllerSessionId, nodeId, controllerNodeId, ctx.GetAliceFabricIndex(),
+                Transport::PeerAddress::UDP(ctx.GetAddress(), CHIP_PORT), CryptoContext::SessionRole::kResponder));
+        }
+
+        return CHIP_NO_ERROR;
+    }
+
+    void Destroy()
+    {
+        for (size_t i = 0; i < kNodeCount; i++)
+        {
+            if (mControllerSessions[i])
+            {
+                mControllerSessions[i]->AsSecureSession()->MarkForEviction();
+            }
+            if (mNodeSessions[i])
+            {
+                mNodeSessions[i]->AsSecureSession()->MarkForEviction();
+            }
+        }
+    }
+
+    CHIP_ERROR AddTo(MultiNodeReadClient & client, size_t i) { return client.AddNode(mControllerSessions[i].Get().Value()); }
+    ScopedNodeId GetNode(size_t i) { return mControllerSessions[i]->AsSecureSession()->GetPeer(); }
+
+private:
+    SessionHolder mControllerSessions[kNodeCount];
+    SessionHolder mNodeSessions[kNodeCount];
+};
+
+class TestCallback : public MultiNodeClusterStateCache::Callback
+{
+public:
+    void OnNodeSubscriptionEstablished(const ScopedNodeId & aNode, SubscriptionId aSubscriptionId) override
+    {
+        mSubscriptionsEstablished++;
+    }
+
+    void OnNodeResubscriptionScheduled(const ScopedNodeId & aNode, CHIP_ERROR aTerminationCause,
+                                       System::Clock::Milliseconds32 aDelay) override
+    {
+        mResubscriptionTimes.push_back(System::SystemClock().GetMonotonicTimestamp() + aDelay);
+        mLastTerminationCause = aTerminationCause;
+    }
+
+    void OnNodeError(const ScopedNodeId & aNode, CHIP_ERROR aError) override { mErrors++; }
+    void OnNodeDone(const ScopedNodeId & aNode) override { mNodesDone++; }
+    void OnDone(MultiNodeReadClient * apClient) override { mDone++; }
+
+    void OnAttributeChanged(MultiNodeClusterStateCache * cache, const ScopedNodeId & node,
+                            const ConcreteAttributePath & path) override
+    {
+        mAttributesChanged++;
+    }
+
+    size_t mSubscriptionsEstablished = 0;
+    size_t mErrors                   = 0;
+    size_t mNodesDone                = 0;
+    size_t mDone                     = 0;
+    size_t mAttributesChanged        = 0;
+    std::vector<System::Clock::Timestamp> mResubscriptionTimes;
+    CHIP_ERROR mLastTerminationCause = CHIP_NO_ERROR;
+};
+
+SimulatedNodes gNodes;
+
+void CheckCachedAttributes(nlTestSuite * apSuite, MultiNodeClusterStateCache & cache)
+{
+    NL_TEST_ASSERT(apSuite, cache.GetNodeCount() == kNodeCount);
+
+    for (size_t i = 0; i < kNodeCount; i++)
+    {
+        TLV::TLVReader reader;
+        bool boolValue   = false;
+        int16_t intValue = 0;
+
+        NL_TEST_ASSERT(apSuite,
+                       cache.Get(gNodes.GetNode(i), ConcreteAttributePath(kEndpointId, kClusterId, kBoolAttributeId), reader) ==
+                           CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, reader.Get(boolValue) == CHIP_NO_ERROR && boolValue);
+
+        NL_TEST_ASSERT(apSuite,
+                       cache.Get(gNodes.GetNode(i), ConcreteAttributePath(kEndpointId, kClusterId, kInt16AttributeId), reader) ==
+                           CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, reader.Get(intValue) == CHIP_NO_ERROR && intValue == 42);
+    }
+
+    TLV::TLVReader reader;
+    NL_TEST_ASSERT(apSuite,
+                   cache.Get(ScopedNodeId(kFirstNodeId + kNodeCount, gNodes.GetNode(0).GetFabricIndex()),
+                             ConcreteAttributePath(kEndpointId, kClusterId, kBoolAttributeId), reader) == CHIP_ERROR_KEY_NOT_FOUND);
+}
+
+void TestMultiNodeRead(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+
+    TestCallback callback;
+    MultiNodeClusterStateCache cache(callback);
+    MultiNodeReadClient client(InteractionModelEngine::GetInstance(), &ctx.GetExchangeManager(), cache,
+                               ReadClient::InteractionType::Read);
+
+    AttributePathParams attributePathParams[1];
+    attributePathParams[0] = AttributePathParams(kEndpointId, kClusterId);
+
+    ReadPrepareParams readPrepareParams;
+    readPrepareParams.mpAttributePathParamsList    = attributePathParams;
+    readPrepareParams.mAttributePathParamsListSize = ArraySize(attributePathParams);
+    NL_TEST_ASSERT(apSuite, client.SetRequest(std::move(readPrepareParams)) == CHIP_NO_ERROR);
+
+    for (size_t i = 0; i < kNodeCount; i++)
+    {
+        NL_TEST_ASSERT(apSuite, gNodes.AddTo(client, i) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(apSuite, client.GetNodeCount() == kNodeCount);
+    NL_TEST_ASSERT(apSuite, gNodes.AddTo(client, 0) == CHIP_ERROR_DUPLICATE_KEY_ID);
+
+    ctx.GetIOContext().DriveIOUntil(System::Clock::Seconds16(10), [&]() { return callback.mDone > 0; });
+
+    NL_TEST_ASSERT(apSuite, callback.mDone == 1);
+    NL_TEST_ASSERT(apSuite, callback.mNodesDone == kNodeCount);
+    NL_TEST_ASSERT(apSuite, callback.mErrors == 0);
+    NL_TEST_ASSERT(apSuite, client.GetNodeCount() == 0);
+    NL_TEST_ASSERT(apSuite, callback.mAttributesChanged >= 2 * kNodeCount);
+
+    CheckCachedAttributes(apSuite, cache);
+
+    ctx.DrainAndServiceIO();
+    NL_TEST_ASSERT(apSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
+}
+
+void TestMultiNodeRejectsDataVersionFilters(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+
+    TestCallback callback;
+    MultiNodeReadClient client(InteractionModelEngine::GetInstance(), &ctx.GetExchangeManager(), callback,
+                               ReadClient::InteractionType::Read);
+
+    AttributePathParams attributePathParams[1];
+    attributePathParams[0] = AttributePathParams(kEndpointId, kClusterId);
+    DataVersionFilter dataVersionFilters[1];
+    dataVersionFilters[0] = DataVersionFilter(kEndpointId, kClusterId, 0);
+
+    ReadPrepareParams readPrepareParams;
+    readPrepareParams.mpAttributePathParamsList    = attributePathParams;
+    readPrepareParams.mAttributePathParamsListSize = ArraySize(attributePathParams);
+    readPrepareParams.mpDataVersionFilterList      = dataVersionFilters;
+    readPrepareParams.mDataVersionFilterListSize   = ArraySize(dataVersionFilters);
+    NL_TEST_ASSERT(apSuite, client.SetRequest(std::move(readPrepareParams)) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(apSuite, gNodes.AddTo(client, 0) == CHIP_ERROR_INCORRECT_STATE);
+}
+
+void TestMultiNodeSubscribe(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+
+    constexpr System::Clock::Milliseconds32 kResubscribeSpacing(1000);
+
+    TestCallback callback;
+    MultiNodeClusterStateCache cache(callback);
+
+    {
+        MultiNodeReadClient client(InteractionModelEngine::GetInstance(), &ctx.GetExchangeManager(), cache,
+                                   ReadClient::InteractionType::Subscribe, kResubscribeSpacing);
+
+        AttributePathParams attributePathParams[1];
+        attributePathParams[0] = AttributePathParams(kEndpointId, kClusterId);
+
+        ReadPrepareParams readPrepareParams;
+        readPrepareParams.mpAttributePathParamsList    = attributePathParams;
+        readPrepareParams.mAttributePathParamsListSize = ArraySize(attributePathParams);
+        readPrepareParams.mMaxIntervalCeilingSeconds   = 60;
+        // Every simulated node is served by the same engine, which would otherwise only keep the latest subscription.
+        readPrepareParams.mKeepSubscriptions = true;
+        NL_TEST_ASSERT(apSuite, client.SetRequest(std::move(readPrepareParams)) == CHIP_NO_ERROR);
+
+        for (size_t i = 0; i < kNodeCount; i++)
+        {
+            NL_TEST_ASSERT(apSuite, gNodes.AddTo(client, i) == CHIP_NO_ERROR);
+        }
+
+        ctx.GetIOContext().DriveIOUntil(System::Clock::Seconds16(10),
+                                        [&]() { return callback.mSubscriptionsEstablished >= kNodeCount; });
+
+        NL_TEST_ASSERT(apSuite, callback.mSubscriptionsEstablished == kNodeCount);
+        NL_TEST_ASSERT(apSuite, callback.mErrors == 0);
+        NL_TEST_ASSERT(apSuite, client.GetNodeCount() == kNodeCount);
+
+        CheckCachedAttributes(apSuite, cache);
+
+        //
+        // Let every subscription time out at once: the re-subscriptions must be spread rather than all
+        // attempted right away.
+        //
+        client.OverrideLivenessTimeout(System::Clock::Milliseconds32(50));
+
+        ctx.GetIOContext().DriveIOUntil(System::Clock::Seconds16(5),
+                                        [&]() { return callback.mResubscriptionTimes.size() >= kNodeCount; });
+
+        NL_TEST_ASSERT(apSuite, callback.mResubscriptionTimes.size() == kNodeCount);
+        NL_TEST_ASSERT(apSuite, callback.mLastTerminationCause == CHIP_ERROR_TIMEOUT);
+
+        std::sort(callback.mResubscriptionTimes.begin(), callback.mResubscriptionTimes.end());
+        for (size_t i = 1; i < callback.mResubscriptionTimes.size(); i++)
+        {
+            // Timestamps are taken after the delays were computed, allow them a millisecond of skew.
+            NL_TEST_ASSERT(apSuite,
+                           callback.mResubscriptionTimes[i] - callback.mResubscriptionTimes[i - 1] + System::Clock::Milliseconds32(1) >=
+                               kResubscribeSpacing);
+        }
+
+        // The first re-subscription is attempted right away and fails, since there is no way to re-establish CASE
+        // in this test; all others are still pending.
+        NL_TEST_ASSERT(apSuite, client.GetResubscribingNodeCount() + callback.mNodesDone == kNodeCount);
+        NL_TEST_ASSERT(apSuite, callback.mNodesDone <= 1);
+    }
+
+    // Destroying the client cancels the pending re-subscriptions without calling back.
+    NL_TEST_ASSERT(apSuite, callback.mNodesDone <= 1);
+
+    InteractionModelEngine::GetInstance()->ShutdownActiveReads();
+    ctx.DrainAndServiceIO();
+}
+
+int Initialize(void * apContext)
+{
+    VerifyOrReturnError(TestContext::Initialize(apContext) == SUCCESS, FAILURE);
+    VerifyOrReturnError(gNodes.Create(*static_cast<TestContext *>(apContext)) == CHIP_NO_ERROR, FAILURE);
+    return SUCCESS;
+}
+
+int Finalize(void * apContext)
+{
+    gNodes.Destroy();
+    return TestContext::Finalize(apContext);
+}
+
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("TestMultiNodeRead", TestMultiNodeRead),
+    NL_TEST_DEF("TestMultiNodeRejectsDataVersionFilters", TestMultiNodeRejectsDataVersionFilters),
+    NL_TEST_DEF("TestMultiNodeSubscribe", TestMultiNodeSubscribe),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+// clang-format off
+nlTestSuite sSuite =
+{
+    "TestMultiNodeRead",
+    &sTests[0],
+    Initialize,
+    Finalize
+};
+// clang-format on
+
+} // namespace
+
+int TestMultiNodeReadSuite()
+{
+    return chip::ExecuteTestsWithContext<TestContext>(&sSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestMultiNodeReadSuite)
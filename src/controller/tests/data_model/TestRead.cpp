@@ -259,6 +259,10 @@ public:
     static void TestReadFabricScopedWithoutFabricFilter(nlTestSuite * apSuite, void * apContext);
     static void TestReadFabricScopedWithFabricFilter(nlTestSuite * apSuite, void * apContext);
     static void TestReadHandler_MultipleSubscriptions(nlTestSuite * apSuite, void * apContext);
+    static void TestReadHandler_MultipleSubscriptionsReportLatency(nlTestSuite * apSuite, void * apContext);
+#if CHIP_IM_SERVER_MAX_NUM_CACHED_ATTRIBUTE_REPORTS > 0
+    static void TestReadHandler_MultipleSubscriptionsSharedReports(nlTestSuite * apSuite, void * apContext);
+#endif
     static void TestReadHandler_SubscriptionAppRejection(nlTestSuite * apSuite, void * apContext);
     static void TestReadHandler_MultipleReads(nlTestSuite * apSuite, void * apContext);
     static void TestReadHandler_OneSubscribeMultipleReads(nlTestSuite * apSuite, void * apContext);
@@ -1796,6 +1800,166 @@ void TestReadInteraction::TestReadHandler_MultipleSubscriptions(nlTestSuite * ap
     app::InteractionModelEngine::GetInstance()->UnregisterReadHandlerAppCallback();
 }
 
+void TestReadInteraction::TestReadHandler_MultipleSubscriptionsReportLatency(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    // Hundreds of subscriptions, split between two fabrics, with a max interval short enough for any of them to miss it if the
+    // engine does not share the bounded number of reports in flight fairly.
+    constexpr size_t kNumSubscriptionsPerFabric         = 150;
+    constexpr size_t kNumSubscriptions                  = 2 * kNumSubscriptionsPerFabric;
+    constexpr size_t kSubscriptionBatchSize             = 25;
+    constexpr uint16_t kMaxIntervalSeconds              = 2;
+    constexpr System::Clock::Timeout kContentionTimeout = System::Clock::Seconds16(3 * kMaxIntervalSeconds);
+    const SessionHandle sessions[]                      = { ctx.GetSessionBobToAlice(), ctx.GetSessionAliceToBob() };
+    uint32_t numReports[kNumSubscriptions]              = {};
+    uint32_t numSubscriptionEstablishedCalls            = 0;
+    uint32_t numTotalReports                            = 0;
+
+    responseDirective = kSendDataResponse;
+
+    auto onFailureCb = [&apSuite](const app::ConcreteDataAttributePath * attributePath, CHIP_ERROR aError) {
+        NL_TEST_ASSERT(apSuite, false);
+    };
+
+    auto onSubscriptionEstablishedCb = [&numSubscriptionEstablishedCalls](const app::ReadClient & readClient) {
+        numSubscriptionEstablishedCalls++;
+    };
+
+    app::InteractionModelEngine::GetInstance()->RegisterReadHandlerAppCallback(&gTestReadInteraction);
+
+    // Establish the subscriptions in batches, to bound the number of exchanges open at once.
+    for (size_t i = 0; i < kNumSubscriptions; i++)
+    {
+        auto onSuccessCb = [&numReports, &numTotalReports, i](const app::ConcreteDataAttributePath & attributePath,
+                                                              const auto & dataResponse) {
+            numReports[i]++;
+            numTotalReports++;
+        };
+
+        NL_TEST_ASSERT(apSuite,
+                       Controller::SubscribeAttribute<Clusters::UnitTesting::Attributes::Int16u::TypeInfo>(
+                           &ctx.GetExchangeManager(), sessions[i % 2], kTestEndpointId, onSuccessCb, onFailureCb, 0,
+                           kMaxIntervalSeconds, onSubscriptionEstablishedCb, nullptr, false, true) == CHIP_NO_ERROR);
+
+        if ((i + 1) % kSubscriptionBatchSize == 0)
+        {
+            ctx.GetIOContext().DriveIOUntil(System::Clock::Seconds16(60),
+                                            [&]() { return numSubscriptionEstablishedCalls == i + 1; });
+        }
+    }
+    NL_TEST_ASSERT(apSuite, numSubscriptionEstablishedCalls == kNumSubscriptions);
+    NL_TEST_ASSERT(apSuite, gTestReadInteraction.mNumActiveSubscriptions == kNumSubscriptions);
+
+    //
+    // Keep every subscription dirty for several max intervals: the attribute is marked dirty again each time half of the
+    // subscriptions have reported, so there are always many more reportable subscriptions than reports allowed in flight, and a
+    // subscription that is not picked in time misses its max interval.
+    //
+    app::reporting::Engine & reportingEngine = app::InteractionModelEngine::GetInstance()->GetReportingEngine();
+    app::AttributePathParams dirtyPath(kTestEndpointId, Clusters::UnitTesting::Id, Clusters::UnitTesting::Attributes::Int16u::Id);
+    memset(numReports, 0, sizeof(numReports));
+    numTotalReports = 0;
+    reportingEngine.ResetReportLatencyStats();
+
+    const System::Clock::Timestamp start = System::SystemClock().GetMonotonicTimestamp();
+    while (System::SystemClock().GetMonotonicTimestamp() - start < kContentionTimeout)
+    {
+        const uint32_t numTotalReportsBefore = numTotalReports;
+        NL_TEST_ASSERT(apSuite, reportingEngine.SetDirty(dirtyPath) == CHIP_NO_ERROR);
+        ctx.GetIOContext().DriveIOUntil(System::Clock::Seconds16(60), [&]() {
+            return numTotalReports - numTotalReportsBefore >= kNumSubscriptions / 2;
+        });
+    }
+
+    // Snapshot the statistics before the subscriptions fall back to reporting at their max interval.
+    const app::reporting::Engine::ReportLatencyStats stats = reportingEngine.GetReportLatencyStats();
+    ChipLogProgress(DataManagement, "%" PRIu32 " reports, %" PRIu32 " max interval misses, worst overrun %" PRIu32 "ms",
+                    stats.mNumReports, stats.mNumMaxIntervalMisses, stats.mWorstMaxIntervalOverrun.count());
+
+    NL_TEST_ASSERT(apSuite, stats.mNumMaxIntervalMisses == 0);
+    NL_TEST_ASSERT(apSuite, stats.mNumReports >= 3 * kNumSubscriptions);
+
+    // Each subscription got its share of the reports, whichever fabric it is on.
+    uint32_t numFabricReports[2] = {};
+    for (size_t i = 0; i < kNumSubscriptions; i++)
+    {
+        NL_TEST_ASSERT(apSuite, numReports[i] >= 2);
+        numFabricReports[i % 2] += numReports[i];
+    }
+    NL_TEST_ASSERT(apSuite, numFabricReports[0] * 10 >= numFabricReports[1] * 9);
+    NL_TEST_ASSERT(apSuite, numFabricReports[1] * 10 >= numFabricReports[0] * 9);
+
+    app::InteractionModelEngine::GetInstance()->ShutdownActiveReads();
+
+    NL_TEST_ASSERT(apSuite, gTestReadInteraction.mNumActiveSubscriptions == 0);
+    NL_TEST_ASSERT(apSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
+
+    app::InteractionModelEngine::GetInstance()->UnregisterReadHandlerAppCallback();
+}
+
+#if CHIP_IM_SERVER_MAX_NUM_CACHED_ATTRIBUTE_REPORTS > 0
+void TestReadInteraction::TestReadHandler_MultipleSubscriptionsSharedReports(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx                        = *static_cast<TestContext *>(apContext);
+    auto sessionHandle                       = ctx.GetSessionBobToAlice();
+    constexpr size_t kNumSubscriptions       = 3;
+    uint16_t values[kNumSubscriptions]       = {};
+    uint32_t numReports                      = 0;
+    uint32_t numSubscriptionEstablishedCalls = 0;
+
+    responseDirective = kSendDataResponse;
+
+    auto onFailureCb = [&apSuite](const app::ConcreteDataAttributePath * attributePath, CHIP_ERROR aError) {
+        NL_TEST_ASSERT(apSuite, false);
+    };
+
+    auto onSubscriptionEstablishedCb = [&numSubscriptionEstablishedCalls](const app::ReadClient & readClient) {
+        numSubscriptionEstablishedCalls++;
+    };
+
+    app::InteractionModelEngine::GetInstance()->RegisterReadHandlerAppCallback(&gTestReadInteraction);
+
+    for (size_t i = 0; i < kNumSubscriptions; i++)
+    {
+        auto onSuccessCb = [&values, &numReports, i](const app::ConcreteDataAttributePath & attributePath,
+                                                     const auto & dataResponse) {
+            values[i] = dataResponse;
+            numReports++;
+        };
+
+        NL_TEST_ASSERT(apSuite,
+                       Controller::SubscribeAttribute<Clusters::UnitTesting::Attributes::Int16u::TypeInfo>(
+                           &ctx.GetExchangeManager(), sessionHandle, kTestEndpointId, onSuccessCb, onFailureCb, 0, 20,
+                           onSubscriptionEstablishedCb, nullptr, false, true) == CHIP_NO_ERROR);
+    }
+
+    ctx.GetIOContext().DriveIOUntil(System::Clock::Seconds16(60),
+                                    [&]() { return numSubscriptionEstablishedCalls == kNumSubscriptions; });
+    NL_TEST_ASSERT(apSuite, numSubscriptionEstablishedCalls == kNumSubscriptions);
+
+    // Reading the attribute has a side effect, which must happen once for all the subscriptions reporting the change.
+    app::AttributePathParams dirtyPath(kTestEndpointId, Clusters::UnitTesting::Id, Clusters::UnitTesting::Attributes::Int16u::Id);
+    const uint16_t readCountBefore = totalReadCount;
+    numReports                     = 0;
+    NL_TEST_ASSERT(apSuite, app::InteractionModelEngine::GetInstance()->GetReportingEngine().SetDirty(dirtyPath) == CHIP_NO_ERROR);
+    ctx.GetIOContext().DriveIOUntil(System::Clock::Seconds16(60), [&]() { return numReports == kNumSubscriptions; });
+
+    NL_TEST_ASSERT(apSuite, numReports == kNumSubscriptions);
+    NL_TEST_ASSERT(apSuite, totalReadCount == readCountBefore + 1);
+    for (auto value : values)
+    {
+        NL_TEST_ASSERT(apSuite, value == totalReadCount);
+    }
+
+    app::InteractionModelEngine::GetInstance()->ShutdownActiveReads();
+
+    NL_TEST_ASSERT(apSuite, gTestReadInteraction.mNumActiveSubscriptions == 0);
+    NL_TEST_ASSERT(apSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
+
+    app::InteractionModelEngine::GetInstance()->UnregisterReadHandlerAppCallback();
+}
+#endif
+
 void TestReadInteraction::TestReadHandler_SubscriptionAppRejection(nlTestSuite * apSuite, void * apContext)
 {
     TestContext & ctx                        = *static_cast<TestContext *>(apContext);
@@ -4556,6 +4720,10 @@ const nlTest sTests[] =
     NL_TEST_DEF("TestReadFabricScopedWithoutFabricFilter", TestReadInteraction::TestReadFabricScopedWithoutFabricFilter),
     NL_TEST_DEF("TestReadFabricScopedWithFabricFilter", TestReadInteraction::TestReadFabricScopedWithFabricFilter),
     NL_TEST_DEF("TestReadHandler_MultipleSubscriptions", TestReadInteraction::TestReadHandler_MultipleSubscriptions),
+    NL_TEST_DEF("TestReadHandler_MultipleSubscriptionsReportLatency", TestReadInteraction::TestReadHandler_MultipleSubscriptionsReportLatency),
+#if CHIP_IM_SERVER_MAX_NUM_CACHED_ATTRIBUTE_REPORTS > 0
+    NL_TEST_DEF("TestReadHandler_MultipleSubscriptionsSharedReports", TestReadInteraction::TestReadHandler_MultipleSubscriptionsSharedReports),
+#endif
     NL_TEST_DEF("TestReadHandler_SubscriptionAppRejection", TestReadInteraction::TestReadHandler_SubscriptionAppRejection),
     NL_TEST_DEF("TestReadHandler_MultipleSubscriptionsWithDataVersionFilter", TestReadInteraction::TestReadHandler_MultipleSubscriptionsWithDataVersionFilter),
     NL_TEST_DEF("TestReadHandler_MultipleReads", TestReadInteraction::TestReadHandler_MultipleReads),
@@ -305,3 +305,5 @@ uint8_t emberAfClusterIndex(EndpointId endpoint, ClusterId clusterId, EmberAfClu
 }
 
 bool emberAfEndpointIndexIsEnabled(uint16_t index) { return index == 0; }
+
+uint32_t emberAfMetadataStructureGeneration() { return 0; }
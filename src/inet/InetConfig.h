@@ -272,4 +272,39 @@
 #endif
 #endif // INET_CONFIG_UDP_SOCKET_PKTINFO
 
+/**
+ *  @def INET_CONFIG_UDP_SOCKET_MMSG
+ *
+ *  @brief
+ *    Use recvmmsg() to receive several UDP datagrams per system call in the
+ *    socket-based implementation of UDP endpoints.
+ *
+ *  @details
+ *    When this flag is set, a listening UDP endpoint drains up to
+ *    #INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE datagrams each time its socket
+ *    becomes readable.
+ */
+#ifndef INET_CONFIG_UDP_SOCKET_MMSG
+#if defined(__linux__)
+#define INET_CONFIG_UDP_SOCKET_MMSG 1
+#else
+#define INET_CONFIG_UDP_SOCKET_MMSG 0
+#endif
+#endif // INET_CONFIG_UDP_SOCKET_MMSG
+
+/**
+ *  @def INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE
+ *
+ *  @brief
+ *    The maximum number of UDP datagrams received by a single recvmmsg()
+ *    call, when #INET_CONFIG_UDP_SOCKET_MMSG is set.
+ *
+ *  @details
+ *    When packet buffers are allocated from the heap, a listening endpoint
+ *    keeps up to that many receive packet buffers allocated between calls.
+ */
+#ifndef INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE
+#define INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE 16
+#endif // INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE
+
 // clang-format on
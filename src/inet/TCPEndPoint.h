@@ -276,6 +276,26 @@ public:
      */
     virtual CHIP_ERROR AckReceive(uint16_t len) = 0;
 
+    /**
+     * @brief   Receive the data as a sequence of length-prefixed frames.
+     *
+     * @param[in]   maxFrameLength  largest frame length accepted, excluding the prefix.
+     *
+     * @retval  CHIP_NO_ERROR                   success: framing enabled.
+     * @retval  CHIP_ERROR_INVALID_ARGUMENT     a frame of \c maxFrameLength would not fit in a packet buffer.
+     * @retval  CHIP_ERROR_NOT_IMPLEMENTED      the implementation cannot choose the receive buffers.
+     *
+     * @details
+     *  Each frame is a 16-bit little-endian length followed by that many bytes.  Once framing is
+     *  enabled, data is read from the connection into a buffer allocated for the frame it belongs to,
+     *  and only complete frames are passed to \c OnDataReceived: every buffer of the chain holds
+     *  exactly one frame, prefix included.  A frame longer than \c maxFrameLength aborts the
+     *  connection with CHIP_ERROR_MESSAGE_TOO_LONG.
+     *
+     *  This method should be called before any data is received on the connection.
+     */
+    virtual CHIP_ERROR EnableLengthPrefixedFraming(uint16_t maxFrameLength) { return CHIP_ERROR_NOT_IMPLEMENTED; }
+
     /**
      * @brief   Set the receive queue, for testing.
      *
@@ -528,6 +548,11 @@ public:
      */
     constexpr static size_t kMaxReceiveMessageSize = System::PacketBuffer::kMaxSizeWithoutReserve;
 
+    /**
+     * Size of the length prefix of a frame, see EnableLengthPrefixedFraming().
+     */
+    constexpr static size_t kFrameLengthPrefixSize = sizeof(uint16_t);
+
 protected:
     friend class ::chip::Transport::TCPTest;
     friend class TCPTest;
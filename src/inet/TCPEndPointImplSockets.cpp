@@ -25,11 +25,13 @@
 #include <inet/InetFaultInjection.h>
 #include <inet/arpa-inet-compatibility.h>
 
+#include <lib/core/CHIPEncoding.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/SafeInt.h>
 #include <lib/support/logging/CHIPLogging.h>
 #include <system/SystemFaultInjection.h>
 
+#include <algorithm>
 #include <stdio.h>
 #include <string.h>
 #include <utility>
@@ -41,6 +43,7 @@
 #include <sys/ioctl.h>
 #include <sys/select.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 // SOCK_CLOEXEC not defined on all platforms, e.g. iOS/macOS:
@@ -67,6 +70,17 @@
 namespace chip {
 namespace Inet {
 
+namespace {
+
+// Largest number of queued buffers gathered into a single sendmsg() call.
+constexpr size_t kMaxSendIOVecs = 16;
+
+// Largest number of reads of the socket for frames per readable event, so that a peer
+// sending continuously does not starve the other endpoints.
+constexpr int kMaxFrameReadsPerEvent = 16;
+
+} // namespace
+
 CHIP_ERROR TCPEndPointImplSockets::BindImpl(IPAddressType addrType, const IPAddress & addr, uint16_t port, bool reuseAddr)
 {
     CHIP_ERROR res = GetSocket(addrType);
@@ -450,6 +464,15 @@ CHIP_ERROR TCPEndPointImplSockets::AckReceive(uint16_t len)
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR TCPEndPointImplSockets::EnableLengthPrefixedFraming(uint16_t maxFrameLength)
+{
+    VerifyOrReturnError(maxFrameLength != 0 && kFrameLengthPrefixSize + maxFrameLength <= kMaxReceiveMessageSize,
+                        CHIP_ERROR_INVALID_ARGUMENT);
+
+    mMaxFrameLength = maxFrameLength;
+    return CHIP_NO_ERROR;
+}
+
 CHIP_ERROR TCPEndPointImplSockets::SetUserTimeoutImpl(uint32_t userTimeoutMillis)
 {
 #if defined(TCP_USER_TIMEOUT)
@@ -484,9 +507,29 @@ CHIP_ERROR TCPEndPointImplSockets::DriveSendingImpl()
 
     while (!mSendQueue.IsNull())
     {
-        uint16_t bufLen = mSendQueue->DataLength();
+        // Gather as many queued buffers as possible into a single call, bounded so that the
+        // number of bytes sent still fits the OnDataSent callback.
+        iovec iov[kMaxSendIOVecs];
+        size_t iovCount = 0;
+        uint16_t bufLen = 0;
+        for (System::PacketBufferHandle buf = mSendQueue.Retain(); !buf.IsNull() && iovCount < kMaxSendIOVecs; buf = buf->Next())
+        {
+            if (bufLen + buf->DataLength() > UINT16_MAX)
+            {
+                break;
+            }
+            iov[iovCount].iov_base = buf->Start();
+            iov[iovCount].iov_len  = buf->DataLength();
+            bufLen                 = static_cast<uint16_t>(bufLen + buf->DataLength());
+            iovCount++;
+        }
+
+        msghdr msgHeader;
+        memset(&msgHeader, 0, sizeof(msgHeader));
+        msgHeader.msg_iov    = iov;
+        msgHeader.msg_iovlen = static_cast<decltype(msgHeader.msg_iovlen)>(iovCount);
 
-        ssize_t lenSentRaw = send(mSocket, mSendQueue->Start(), bufLen, sendFlags);
+        ssize_t lenSentRaw = sendmsg(mSocket, &msgHeader, sendFlags);
 
         if (lenSentRaw == -1)
         {
@@ -509,21 +552,19 @@ CHIP_ERROR TCPEndPointImplSockets::DriveSendingImpl()
         // Mark the connection as being active.
         MarkActive();
 
-        if (lenSent < bufLen)
+        // Free the buffers sent entirely, and consume the part sent of the last one.
+        mSendQueue.Consume(lenSent);
+        while (!mSendQueue.IsNull() && mSendQueue->DataLength() == 0)
         {
-            mSendQueue->ConsumeHead(lenSent);
+            mSendQueue.FreeHead();
         }
-        else
+        if (mSendQueue.IsNull())
         {
-            mSendQueue.FreeHead();
-            if (mSendQueue.IsNull())
+            // Do not wait for ability to write on this endpoint.
+            err = static_cast<System::LayerSockets &>(GetSystemLayer()).ClearCallbackOnPendingWrite(mWatch);
+            if (err != CHIP_NO_ERROR)
             {
-                // Do not wait for ability to write on this endpoint.
-                err = static_cast<System::LayerSockets &>(GetSystemLayer()).ClearCallbackOnPendingWrite(mWatch);
-                if (err != CHIP_NO_ERROR)
-                {
-                    break;
-                }
+                break;
             }
         }
 
@@ -599,6 +640,13 @@ void TCPEndPointImplSockets::DoCloseImpl(CHIP_ERROR err, State oldState)
 {
     struct linger lingerStruct;
 
+    // A partially received frame can no longer be completed.
+    if (mState == State::kClosed)
+    {
+        mRcvFrame             = nullptr;
+        mRcvFrameHeaderLength = 0;
+    }
+
     // If the socket hasn't been closed already...
     if (mSocket != kInvalidSocketFd)
     {
@@ -843,33 +891,47 @@ void TCPEndPointImplSockets::ReceiveData()
 {
     System::PacketBufferHandle rcvBuf;
     bool isNewBuf = true;
+    ssize_t rcvLen;
 
-    if (mRcvQueue.IsNull())
+    if (mMaxFrameLength != 0)
     {
-        rcvBuf = System::PacketBufferHandle::New(kMaxReceiveMessageSize, 0);
+        // Complete frames are queued as they are received.
+        CHIP_ERROR err = ReceiveFrames(rcvLen);
+        if (err != CHIP_NO_ERROR)
+        {
+            DoClose(err, false);
+            return;
+        }
     }
     else
     {
-        rcvBuf = mRcvQueue->Last();
-        if (rcvBuf->AvailableDataLength() == 0)
+        if (mRcvQueue.IsNull())
         {
             rcvBuf = System::PacketBufferHandle::New(kMaxReceiveMessageSize, 0);
         }
         else
         {
-            isNewBuf = false;
-            rcvBuf->CompactHead();
+            rcvBuf = mRcvQueue->Last();
+            if (rcvBuf->AvailableDataLength() == 0)
+            {
+                rcvBuf = System::PacketBufferHandle::New(kMaxReceiveMessageSize, 0);
+            }
+            else
+            {
+                isNewBuf = false;
+                rcvBuf->CompactHead();
+            }
         }
-    }
 
-    if (rcvBuf.IsNull())
-    {
-        DoClose(CHIP_ERROR_NO_MEMORY, false);
-        return;
-    }
+        if (rcvBuf.IsNull())
+        {
+            DoClose(CHIP_ERROR_NO_MEMORY, false);
+            return;
+        }
 
-    // Attempt to receive data from the socket.
-    ssize_t rcvLen = recv(mSocket, rcvBuf->Start() + rcvBuf->DataLength(), rcvBuf->AvailableDataLength(), 0);
+        // Attempt to receive data from the socket.
+        rcvLen = recv(mSocket, rcvBuf->Start() + rcvBuf->DataLength(), rcvBuf->AvailableDataLength(), 0);
+    }
 
 #if INET_CONFIG_OVERRIDE_SYSTEM_TCP_USER_TIMEOUT
     CHIP_ERROR err;
@@ -945,7 +1007,7 @@ void TCPEndPointImplSockets::ReceiveData()
         }
 
         // Otherwise, add the new data onto the receive queue.
-        else
+        else if (mMaxFrameLength == 0)
         {
             VerifyOrDie(rcvLen > 0);
             size_t newDataLength = rcvBuf->DataLength() + static_cast<size_t>(rcvLen);
@@ -974,6 +1036,101 @@ void TCPEndPointImplSockets::ReceiveData()
     DriveReceiving();
 }
 
+CHIP_ERROR TCPEndPointImplSockets::ReceiveFrames(ssize_t & rcvLen)
+{
+    rcvLen = 0;
+
+    for (int i = 0; i < kMaxFrameReadsPerEvent; i++)
+    {
+        // Read the rest of the current frame, if any, directly into its buffer, followed by
+        // the length prefix of the next frame.  The prefix is only read once the frame is complete.
+        iovec iov[2];
+        int iovCount = 0;
+        if (!mRcvFrame.IsNull())
+        {
+            iov[iovCount].iov_base = mRcvFrame->Start() + mRcvFrame->DataLength();
+            iov[iovCount].iov_len  = static_cast<size_t>(mRcvFrameLength - mRcvFrame->DataLength());
+            iovCount++;
+        }
+        iov[iovCount].iov_base = mRcvFrameHeader + mRcvFrameHeaderLength;
+        iov[iovCount].iov_len  = sizeof(mRcvFrameHeader) - mRcvFrameHeaderLength;
+        iovCount++;
+
+        const size_t requested = iov[0].iov_len + ((iovCount > 1) ? iov[1].iov_len : 0);
+        ssize_t lenRead        = readv(mSocket, iov, iovCount);
+
+        if (lenRead < 0 && rcvLen > 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            // Everything available has been read.
+            break;
+        }
+        if (lenRead <= 0)
+        {
+            rcvLen = lenRead;
+            break;
+        }
+        rcvLen += lenRead;
+
+        size_t remaining = static_cast<size_t>(lenRead);
+        if (!mRcvFrame.IsNull())
+        {
+            const size_t frameLen = std::min(remaining, iov[0].iov_len);
+            mRcvFrame->SetDataLength(static_cast<uint16_t>(mRcvFrame->DataLength() + frameLen));
+            remaining -= frameLen;
+            if (mRcvFrame->DataLength() == mRcvFrameLength)
+            {
+                QueueReceivedFrame();
+            }
+        }
+
+        mRcvFrameHeaderLength = static_cast<uint8_t>(mRcvFrameHeaderLength + remaining);
+        if (mRcvFrameHeaderLength == sizeof(mRcvFrameHeader))
+        {
+            ReturnErrorOnFailure(StartReceivedFrame());
+        }
+
+        if (static_cast<size_t>(lenRead) < requested)
+        {
+            // The socket has no more data for now.
+            break;
+        }
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR TCPEndPointImplSockets::StartReceivedFrame()
+{
+    const uint16_t frameLength = Encoding::LittleEndian::Get16(mRcvFrameHeader);
+    VerifyOrReturnError(frameLength <= mMaxFrameLength, CHIP_ERROR_MESSAGE_TOO_LONG);
+
+    // Cast is safe because EnableLengthPrefixedFraming() checked that the largest frame fits in a buffer.
+    mRcvFrameLength = static_cast<uint16_t>(sizeof(mRcvFrameHeader) + frameLength);
+    mRcvFrame       = System::PacketBufferHandle::NewWithData(mRcvFrameHeader, sizeof(mRcvFrameHeader),
+                                                              static_cast<uint16_t>(frameLength), 0);
+    VerifyOrReturnError(!mRcvFrame.IsNull(), CHIP_ERROR_NO_MEMORY);
+    mRcvFrameHeaderLength = 0;
+
+    if (frameLength == 0)
+    {
+        QueueReceivedFrame();
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+void TCPEndPointImplSockets::QueueReceivedFrame()
+{
+    if (mRcvQueue.IsNull())
+    {
+        mRcvQueue = std::move(mRcvFrame);
+    }
+    else
+    {
+        mRcvQueue->AddToEnd(std::move(mRcvFrame));
+    }
+}
+
 void TCPEndPointImplSockets::HandleIncomingConnection()
 {
     CHIP_ERROR err                 = CHIP_NO_ERROR;
@@ -47,6 +47,7 @@ public:
     CHIP_ERROR EnableKeepAlive(uint16_t interval, uint16_t timeoutCount) override;
     CHIP_ERROR DisableKeepAlive() override;
     CHIP_ERROR AckReceive(uint16_t len) override;
+    CHIP_ERROR EnableLengthPrefixedFraming(uint16_t maxFrameLength) override;
 #if INET_CONFIG_OVERRIDE_SYSTEM_TCP_USER_TIMEOUT
     void TCPUserTimeoutHandler() override;
 #endif // INET_CONFIG_OVERRIDE_SYSTEM_TCP_USER_TIMEOUT
@@ -66,10 +67,20 @@ private:
     CHIP_ERROR GetSocket(IPAddressType addrType);
     void HandlePendingIO(System::SocketEvents events);
     void ReceiveData();
+    CHIP_ERROR ReceiveFrames(ssize_t & rcvLen);
+    CHIP_ERROR StartReceivedFrame();
+    void QueueReceivedFrame();
     void HandleIncomingConnection();
     CHIP_ERROR BindSrcAddrFromIntf(IPAddressType addrType, InterfaceId intfId);
     static void HandlePendingIO(System::SocketEvents events, intptr_t data);
 
+    // Length-prefixed framing of the received data, enabled when mMaxFrameLength is not 0.
+    uint16_t mMaxFrameLength = 0;
+    uint16_t mRcvFrameLength = 0; // Length of mRcvFrame once complete, prefix included.
+    System::PacketBufferHandle mRcvFrame;
+    uint8_t mRcvFrameHeader[kFrameLengthPrefixSize];
+    uint8_t mRcvFrameHeaderLength = 0;
+
 #if INET_CONFIG_OVERRIDE_SYSTEM_TCP_USER_TIMEOUT
     /// This counts the number of bytes written on the TCP socket since thelast probe into the TCP outqueue was made.
     uint32_t mBytesWrittenSinceLastProbe;
@@ -26,6 +26,7 @@
 #define __APPLE_USE_RFC_3542
 #include <inet/UDPEndPointImplSockets.h>
 
+#include <lib/support/CHIPMem.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/SafeInt.h>
 #include <lib/support/logging/CHIPLogging.h>
@@ -161,8 +162,106 @@ CHIP_ERROR IPv4Bind(int socket, const IPAddress & address, uint16_t port)
 }
 #endif // INET_CONFIG_ENABLE_IPV4
 
+constexpr size_t kControlDataSize = 256;
+
+// Storage that the header of a message being received points to.
+struct MessageStorage
+{
+    struct iovec iov;
+    SockAddr peerSockAddr;
+    uint8_t controlData[kControlDataSize];
+};
+
+void PrepareReceiveMessage(const System::PacketBufferHandle & buffer, struct msghdr & msgHeader, MessageStorage & storage)
+{
+    storage.iov.iov_base = buffer->Start();
+    storage.iov.iov_len  = buffer->AvailableDataLength();
+
+    memset(&storage.peerSockAddr, 0, sizeof(storage.peerSockAddr));
+
+    memset(&msgHeader, 0, sizeof(msgHeader));
+
+    msgHeader.msg_name       = &storage.peerSockAddr;
+    msgHeader.msg_namelen    = sizeof(storage.peerSockAddr);
+    msgHeader.msg_iov        = &storage.iov;
+    msgHeader.msg_iovlen     = 1;
+    msgHeader.msg_control    = storage.controlData;
+    msgHeader.msg_controllen = sizeof(storage.controlData);
+}
+
+// Sets the length of a received datagram and fills in its packet information from the message header.
+CHIP_ERROR ParseReceivedMessage(struct msghdr & msgHeader, size_t rcvLen, const System::PacketBufferHandle & buffer,
+                                IPPacketInfo & lPacketInfo)
+{
+    VerifyOrReturnError(rcvLen <= buffer->AvailableDataLength(), CHIP_ERROR_INBOUND_MESSAGE_TOO_BIG);
+    buffer->SetDataLength(static_cast<uint16_t>(rcvLen));
+
+    const SockAddr & lPeerSockAddr = *static_cast<const SockAddr *>(msgHeader.msg_name);
+    if (lPeerSockAddr.any.sa_family == AF_INET6)
+    {
+        lPacketInfo.SrcAddress = IPAddress(lPeerSockAddr.in6.sin6_addr);
+        lPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in6.sin6_port);
+    }
+#if INET_CONFIG_ENABLE_IPV4
+    else if (lPeerSockAddr.any.sa_family == AF_INET)
+    {
+        lPacketInfo.SrcAddress = IPAddress(lPeerSockAddr.in.sin_addr);
+        lPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in.sin_port);
+    }
+#endif // INET_CONFIG_ENABLE_IPV4
+    else
+    {
+        return CHIP_ERROR_INCORRECT_STATE;
+    }
+
+    for (struct cmsghdr * controlHdr = CMSG_FIRSTHDR(&msgHeader); controlHdr != nullptr;
+         controlHdr                  = CMSG_NXTHDR(&msgHeader, controlHdr))
+    {
+#if INET_CONFIG_ENABLE_IPV4
+#ifdef IP_PKTINFO
+        if (controlHdr->cmsg_level == IPPROTO_IP && controlHdr->cmsg_type == IP_PKTINFO)
+        {
+            auto * inPktInfo = reinterpret_cast<struct in_pktinfo *> CMSG_DATA(controlHdr);
+            if (!CanCastTo<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex))
+            {
+                return CHIP_ERROR_INCORRECT_STATE;
+            }
+            lPacketInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex));
+            lPacketInfo.DestAddress = IPAddress(inPktInfo->ipi_addr);
+            continue;
+        }
+#endif // defined(IP_PKTINFO)
+#endif // INET_CONFIG_ENABLE_IPV4
+
+#ifdef IPV6_PKTINFO
+        if (controlHdr->cmsg_level == IPPROTO_IPV6 && controlHdr->cmsg_type == IPV6_PKTINFO)
+        {
+            auto * in6PktInfo = reinterpret_cast<struct in6_pktinfo *> CMSG_DATA(controlHdr);
+            if (!CanCastTo<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex))
+            {
+                return CHIP_ERROR_INCORRECT_STATE;
+            }
+            lPacketInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex));
+            lPacketInfo.DestAddress = IPAddress(in6PktInfo->ipi6_addr);
+            continue;
+        }
+#endif // defined(IPV6_PKTINFO)
+    }
+
+    return CHIP_NO_ERROR;
+}
+
 } // anonymous namespace
 
+#if INET_CONFIG_UDP_SOCKET_MMSG
+struct UDPEndPointImplSockets::ReceiveBatch
+{
+    struct mmsghdr headers[INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE];
+    MessageStorage storage[INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE];
+    System::PacketBufferHandle buffers[INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE]; // allocated as needed
+};
+#endif // INET_CONFIG_UDP_SOCKET_MMSG
+
 #if CHIP_SYSTEM_CONFIG_USE_PLATFORM_MULTICAST_API
 UDPEndPointImplSockets::MulticastGroupHandler UDPEndPointImplSockets::sJoinMulticastGroupHandler;
 UDPEndPointImplSockets::MulticastGroupHandler UDPEndPointImplSockets::sLeaveMulticastGroupHandler;
@@ -419,6 +518,14 @@ CHIP_ERROR UDPEndPointImplSockets::SendMsgImpl(const IPPacketInfo * aPktInfo, Sy
 
 void UDPEndPointImplSockets::CloseImpl()
 {
+#if INET_CONFIG_UDP_SOCKET_MMSG
+    if (mReceiveBatch != nullptr)
+    {
+        Platform::Delete(mReceiveBatch);
+        mReceiveBatch = nullptr;
+    }
+#endif // INET_CONFIG_UDP_SOCKET_MMSG
+
     if (mSocket != kInvalidSocketFd)
     {
         static_cast<System::LayerSockets *>(&GetSystemLayer())->StopWatchingSocket(&mWatch);
@@ -562,6 +669,18 @@ void UDPEndPointImplSockets::HandlePendingIO(System::SocketEvents events)
         return;
     }
 
+#if INET_CONFIG_UDP_SOCKET_MMSG
+    if (mBatchedReceive && HandlePendingReadBatch())
+    {
+        return;
+    }
+#endif // INET_CONFIG_UDP_SOCKET_MMSG
+
+    HandlePendingRead();
+}
+
+void UDPEndPointImplSockets::HandlePendingRead()
+{
     CHIP_ERROR lStatus = CHIP_NO_ERROR;
     IPPacketInfo lPacketInfo;
     System::PacketBufferHandle lBuffer;
@@ -574,24 +693,9 @@ void UDPEndPointImplSockets::HandlePendingIO(System::SocketEvents events)
 
     if (!lBuffer.IsNull())
     {
-        struct iovec msgIOV;
-        SockAddr lPeerSockAddr;
-        uint8_t controlData[256];
+        MessageStorage storage;
         struct msghdr msgHeader;
-
-        msgIOV.iov_base = lBuffer->Start();
-        msgIOV.iov_len  = lBuffer->AvailableDataLength();
-
-        memset(&lPeerSockAddr, 0, sizeof(lPeerSockAddr));
-
-        memset(&msgHeader, 0, sizeof(msgHeader));
-
-        msgHeader.msg_name       = &lPeerSockAddr;
-        msgHeader.msg_namelen    = sizeof(lPeerSockAddr);
-        msgHeader.msg_iov        = &msgIOV;
-        msgHeader.msg_iovlen     = 1;
-        msgHeader.msg_control    = controlData;
-        msgHeader.msg_controllen = sizeof(controlData);
+        PrepareReceiveMessage(lBuffer, msgHeader, storage);
 
         ssize_t rcvLen = recvmsg(mSocket, &msgHeader, MSG_DONTWAIT);
 
@@ -599,69 +703,9 @@ void UDPEndPointImplSockets::HandlePendingIO(System::SocketEvents events)
         {
             lStatus = CHIP_ERROR_POSIX(errno);
         }
-        else if (rcvLen > lBuffer->AvailableDataLength())
-        {
-            lStatus = CHIP_ERROR_INBOUND_MESSAGE_TOO_BIG;
-        }
         else
         {
-            lBuffer->SetDataLength(static_cast<uint16_t>(rcvLen));
-
-            if (lPeerSockAddr.any.sa_family == AF_INET6)
-            {
-                lPacketInfo.SrcAddress = IPAddress(lPeerSockAddr.in6.sin6_addr);
-                lPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in6.sin6_port);
-            }
-#if INET_CONFIG_ENABLE_IPV4
-            else if (lPeerSockAddr.any.sa_family == AF_INET)
-            {
-                lPacketInfo.SrcAddress = IPAddress(lPeerSockAddr.in.sin_addr);
-                lPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in.sin_port);
-            }
-#endif // INET_CONFIG_ENABLE_IPV4
-            else
-            {
-                lStatus = CHIP_ERROR_INCORRECT_STATE;
-            }
-        }
-
-        if (lStatus == CHIP_NO_ERROR)
-        {
-            for (struct cmsghdr * controlHdr = CMSG_FIRSTHDR(&msgHeader); controlHdr != nullptr;
-                 controlHdr                  = CMSG_NXTHDR(&msgHeader, controlHdr))
-            {
-#if INET_CONFIG_ENABLE_IPV4
-#ifdef IP_PKTINFO
-                if (controlHdr->cmsg_level == IPPROTO_IP && controlHdr->cmsg_type == IP_PKTINFO)
-                {
-                    auto * inPktInfo = reinterpret_cast<struct in_pktinfo *> CMSG_DATA(controlHdr);
-                    if (!CanCastTo<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex))
-                    {
-                        lStatus = CHIP_ERROR_INCORRECT_STATE;
-                        break;
-                    }
-                    lPacketInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex));
-                    lPacketInfo.DestAddress = IPAddress(inPktInfo->ipi_addr);
-                    continue;
-                }
-#endif // defined(IP_PKTINFO)
-#endif // INET_CONFIG_ENABLE_IPV4
-
-#ifdef IPV6_PKTINFO
-                if (controlHdr->cmsg_level == IPPROTO_IPV6 && controlHdr->cmsg_type == IPV6_PKTINFO)
-                {
-                    auto * in6PktInfo = reinterpret_cast<struct in6_pktinfo *> CMSG_DATA(controlHdr);
-                    if (!CanCastTo<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex))
-                    {
-                        lStatus = CHIP_ERROR_INCORRECT_STATE;
-                        break;
-                    }
-                    lPacketInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex));
-                    lPacketInfo.DestAddress = IPAddress(in6PktInfo->ipi6_addr);
-                    continue;
-                }
-#endif // defined(IPV6_PKTINFO)
-            }
+            lStatus = ParseReceivedMessage(msgHeader, static_cast<size_t>(rcvLen), lBuffer, lPacketInfo);
         }
     }
     else
@@ -683,6 +727,103 @@ void UDPEndPointImplSockets::HandlePendingIO(System::SocketEvents events)
     }
 }
 
+#if INET_CONFIG_UDP_SOCKET_MMSG
+
+void UDPEndPointImplSockets::SetBatchedReceive(bool enable)
+{
+    mBatchedReceive = enable;
+    if (!enable && mReceiveBatch != nullptr)
+    {
+        Platform::Delete(mReceiveBatch);
+        mReceiveBatch = nullptr;
+    }
+}
+
+// Returns false, without receiving anything, when no receive buffer could be allocated.
+bool UDPEndPointImplSockets::HandlePendingReadBatch()
+{
+    if (mReceiveBatch == nullptr)
+    {
+        mReceiveBatch = Platform::New<ReceiveBatch>();
+        VerifyOrReturnValue(mReceiveBatch != nullptr, false);
+    }
+
+    // Buffers left over by the previous batch are reused; the others are allocated, until the first failure.
+    unsigned int count = 0;
+    for (; count < INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE; count++)
+    {
+        System::PacketBufferHandle & buffer = mReceiveBatch->buffers[count];
+        if (buffer.IsNull())
+        {
+            buffer = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSizeWithoutReserve, 0);
+            if (buffer.IsNull())
+            {
+                break;
+            }
+        }
+        PrepareReceiveMessage(buffer, mReceiveBatch->headers[count].msg_hdr, mReceiveBatch->storage[count]);
+    }
+    VerifyOrReturnValue(count > 0, false);
+
+    const int received = recvmmsg(mSocket, mReceiveBatch->headers, count, MSG_DONTWAIT, nullptr);
+    if (received < 0)
+    {
+        const CHIP_ERROR lStatus = CHIP_ERROR_POSIX(errno);
+        if (OnReceiveError != nullptr && lStatus != CHIP_ERROR_POSIX(EAGAIN))
+        {
+            OnReceiveError(this, lStatus, nullptr);
+        }
+        return true;
+    }
+
+    // Take the received datagrams out of the batch before calling back: a callback may close the endpoint,
+    // which releases the batch.
+    System::PacketBufferHandle lBuffers[INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE];
+    IPPacketInfo lPacketInfos[INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE];
+    CHIP_ERROR lStatuses[INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE];
+    for (int i = 0; i < received; i++)
+    {
+        lBuffers[i] = std::move(mReceiveBatch->buffers[i]);
+        lPacketInfos[i].Clear();
+        lPacketInfos[i].DestPort  = mBoundPort;
+        lPacketInfos[i].Interface = mBoundIntfId;
+
+        lStatuses[i] = ParseReceivedMessage(mReceiveBatch->headers[i].msg_hdr, mReceiveBatch->headers[i].msg_len, lBuffers[i],
+                                            lPacketInfos[i]);
+    }
+
+    // Keep the unused buffers, at the front, for the next batch, unless they come from a fixed pool that other users
+    // may run short of.
+    for (unsigned int i = static_cast<unsigned int>(received); i < count; i++)
+    {
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE == 0
+        mReceiveBatch->buffers[i - static_cast<unsigned int>(received)] = std::move(mReceiveBatch->buffers[i]);
+#else
+        mReceiveBatch->buffers[i] = nullptr;
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE == 0
+    }
+
+    // A callback may also free the endpoint: keep it alive until all the datagrams are delivered.
+    Retain();
+    for (int i = 0; i < received && mState == State::kListening && OnMessageReceived != nullptr; i++)
+    {
+        if (lStatuses[i] == CHIP_NO_ERROR)
+        {
+            lBuffers[i].RightSize();
+            OnMessageReceived(this, std::move(lBuffers[i]), &lPacketInfos[i]);
+        }
+        else if (OnReceiveError != nullptr)
+        {
+            OnReceiveError(this, lStatuses[i], nullptr);
+        }
+    }
+    Release();
+
+    return true;
+}
+
+#endif // INET_CONFIG_UDP_SOCKET_MMSG
+
 #if IP_MULTICAST_LOOP || IPV6_MULTICAST_LOOP
 static CHIP_ERROR SocketsSetMulticastLoopback(int aSocket, bool aLoopback, int aProtocol, int aOption)
 {
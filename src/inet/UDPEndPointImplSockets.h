@@ -42,6 +42,16 @@ public:
     uint16_t GetBoundPort() const override;
     void Free() override;
 
+#if INET_CONFIG_UDP_SOCKET_MMSG
+    /**
+     * Enable or disable batched receive (enabled by default).
+     *
+     * When enabled, each time the socket becomes readable up to INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE datagrams are
+     * received through a single recvmmsg() call, and OnMessageReceived is called for each of them in turn.
+     */
+    void SetBatchedReceive(bool enable);
+#endif // INET_CONFIG_UDP_SOCKET_MMSG
+
 private:
     // UDPEndPoint overrides.
 #if INET_CONFIG_ENABLE_IPV4
@@ -57,10 +67,20 @@ private:
     CHIP_ERROR GetSocket(IPAddressType addressType);
     void HandlePendingIO(System::SocketEvents events);
     static void HandlePendingIO(System::SocketEvents events, intptr_t data);
+    void HandlePendingRead();
 
     InterfaceId mBoundIntfId;
     uint16_t mBoundPort;
 
+#if INET_CONFIG_UDP_SOCKET_MMSG
+    struct ReceiveBatch;
+
+    bool HandlePendingReadBatch();
+
+    ReceiveBatch * mReceiveBatch = nullptr; // receive headers and buffers, kept between batches
+    bool mBatchedReceive         = true;
+#endif // INET_CONFIG_UDP_SOCKET_MMSG
+
 #if CHIP_SYSTEM_CONFIG_USE_PLATFORM_MULTICAST_API
 public:
     using MulticastGroupHandler = CHIP_ERROR (*)(InterfaceId, const IPAddress &);
@@ -0,0 +1,198 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Measures the number of UDP datagrams per second that a sender endpoint can
+ *      deliver over the loopback interface to a set of receiver endpoints, all
+ *      serviced by the same system layer, with one recvmsg() call per datagram
+ *      and with batched recvmmsg() calls.
+ *
+ *      Usage: inet-udp-batch-benchmark [packets] [payload size] [receivers]
+ */
+
+#include <inet/UDPEndPoint.h>
+#include <inet/UDPEndPointImpl.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <system/SystemLayerImpl.h>
+#include <system/SystemPacketBuffer.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+using namespace chip;
+using namespace chip::Inet;
+
+constexpr size_t kDefaultPackets   = 200000;
+constexpr uint16_t kDefaultPayload = 64;
+constexpr size_t kDefaultReceivers = 4;
+constexpr uint32_t kBurstTimeoutMs = 200;
+
+// Datagrams sent before waiting for their reception, few enough not to overflow the socket buffers.
+constexpr size_t kBurstSize = 64;
+
+struct BenchmarkState
+{
+    size_t received = 0;
+    bool timedOut   = false;
+};
+
+void HandleMessageReceived(UDPEndPoint * endPoint, System::PacketBufferHandle && msg, const IPPacketInfo * pktInfo)
+{
+    static_cast<BenchmarkState *>(endPoint->mAppState)->received++;
+}
+
+void HandleReceiveError(UDPEndPoint * endPoint, CHIP_ERROR err, const IPPacketInfo * pktInfo)
+{
+    fprintf(stderr, "Receive error: %" CHIP_ERROR_FORMAT "\n", err.Format());
+}
+
+void HandleBurstTimeout(System::Layer * layer, void * appState)
+{
+    static_cast<BenchmarkState *>(appState)->timedOut = true;
+}
+
+void ConfigureBatching(UDPEndPoint * endPoint, bool batched)
+{
+#if INET_CONFIG_UDP_SOCKET_MMSG
+    static_cast<UDPEndPointImpl *>(endPoint)->SetBatchedReceive(batched);
+#endif // INET_CONFIG_UDP_SOCKET_MMSG
+}
+
+CHIP_ERROR RunBenchmark(System::LayerImpl & layer, UDPEndPointManagerImpl & udp, bool batched, size_t packets, uint16_t payload,
+                        size_t receiverCount)
+{
+    BenchmarkState state;
+    std::vector<UDPEndPoint *> receivers(receiverCount, nullptr);
+    UDPEndPoint * sender = nullptr;
+    IPAddress loopback;
+    VerifyOrDie(IPAddress::FromString("::1", loopback));
+
+    CHIP_ERROR err = udp.NewEndPoint(&sender);
+    SuccessOrExit(err);
+    err = sender->Bind(IPAddressType::kIPv6, IPAddress::Any, 0);
+    SuccessOrExit(err);
+
+    for (auto & receiver : receivers)
+    {
+        err = udp.NewEndPoint(&receiver);
+        SuccessOrExit(err);
+        err = receiver->Bind(IPAddressType::kIPv6, loopback, 0);
+        SuccessOrExit(err);
+        ConfigureBatching(receiver, batched);
+        err = receiver->Listen(HandleMessageReceived, HandleReceiveError, &state);
+        SuccessOrExit(err);
+    }
+
+    {
+        const auto start = std::chrono::steady_clock::now();
+        size_t sent      = 0;
+
+        while (sent < packets)
+        {
+            const size_t burst = std::min(kBurstSize, packets - sent);
+            for (size_t i = 0; i < burst; i++, sent++)
+            {
+                System::PacketBufferHandle msg = System::PacketBufferHandle::New(payload);
+                VerifyOrExit(!msg.IsNull(), err = CHIP_ERROR_NO_MEMORY);
+                memset(msg->Start(), 0xA5, payload);
+                msg->SetDataLength(payload);
+                err = sender->SendTo(loopback, receivers[sent % receiverCount]->GetBoundPort(), std::move(msg));
+                SuccessOrExit(err);
+            }
+
+            state.timedOut = false;
+            SuccessOrExit(err = layer.StartTimer(System::Clock::Milliseconds32(kBurstTimeoutMs), HandleBurstTimeout, &state));
+            while (state.received < sent && !state.timedOut)
+            {
+                layer.PrepareEvents();
+                layer.WaitForEvents();
+                layer.HandleEvents();
+            }
+            layer.CancelTimer(HandleBurstTimeout, &state);
+        }
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        printf("%-8s %12.0f packets/s  (%zu sent, %zu received, %.3f s)\n", batched ? "batched" : "single",
+               static_cast<double>(state.received) / elapsed.count(), sent, state.received, elapsed.count());
+    }
+
+exit:
+    for (auto receiver : receivers)
+    {
+        if (receiver != nullptr)
+        {
+            receiver->Free();
+        }
+    }
+    if (sender != nullptr)
+    {
+        sender->Free();
+    }
+    return err;
+}
+
+} // namespace
+
+int main(int argc, char * argv[])
+{
+    const size_t packets       = (argc > 1) ? strtoul(argv[1], nullptr, 0) : kDefaultPackets;
+    const uint16_t payload     = (argc > 2) ? static_cast<uint16_t>(strtoul(argv[2], nullptr, 0)) : kDefaultPayload;
+    const size_t receiverCount = (argc > 3) ? strtoul(argv[3], nullptr, 0) : kDefaultReceivers;
+
+    if (packets == 0 || payload == 0 || payload > System::PacketBuffer::kMaxSizeWithoutReserve || receiverCount == 0)
+    {
+        fprintf(stderr, "Usage: %s [packets] [payload size] [receivers]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    System::LayerImpl layer;
+    UDPEndPointManagerImpl udp;
+    CHIP_ERROR err = Platform::MemoryInit();
+    SuccessOrExit(err);
+    err = layer.Init();
+    SuccessOrExit(err);
+    err = udp.Init(layer);
+    SuccessOrExit(err);
+
+    printf("%zu datagrams of %u bytes to %zu receivers over ::1\n", packets, payload, receiverCount);
+#if !INET_CONFIG_UDP_SOCKET_MMSG
+    printf("INET_CONFIG_UDP_SOCKET_MMSG is not set: both runs use recvmsg()\n");
+#endif // !INET_CONFIG_UDP_SOCKET_MMSG
+
+    err = RunBenchmark(layer, udp, false, packets, payload, receiverCount);
+    SuccessOrExit(err);
+    err = RunBenchmark(layer, udp, true, packets, payload, receiverCount);
+    SuccessOrExit(err);
+
+exit:
+    if (err != CHIP_NO_ERROR)
+    {
+        fprintf(stderr, "Benchmark failed: %" CHIP_ERROR_FORMAT "\n", err.Format());
+    }
+    udp.Shutdown();
+    layer.Shutdown();
+    Platform::MemoryShutdown();
+    return (err == CHIP_NO_ERROR) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -28,6 +28,7 @@
 #define __STDC_LIMIT_MACROS
 #endif
 
+#include <algorithm>
 #include <errno.h>
 #include <inttypes.h>
 #include <stdint.h>
@@ -38,6 +39,7 @@
 #include <inet/IPPrefix.h>
 #include <inet/InetError.h>
 
+#include <lib/core/CHIPEncoding.h>
 #include <lib/support/CHIPArgParser.hpp>
 #include <lib/support/CHIPMem.h>
 #include <lib/support/CodeUtils.h>
@@ -360,6 +362,222 @@ static void TestInetEndPointInternal(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, SYSTEM_STATS_TEST_HIGH_WATER_MARK(System::Stats::kInetLayer_NumTCPEps, 1));
 }
 
+struct UDPLoopbackState
+{
+    IPAddress address;
+    uint16_t senderPort;
+    uint32_t received;
+    uint32_t freeAfter;
+    bool inOrder;
+};
+
+void HandleUDPLoopbackMessage(UDPEndPoint * endPoint, PacketBufferHandle && msg, const IPPacketInfo * pktInfo)
+{
+    auto * state = static_cast<UDPLoopbackState *>(endPoint->mAppState);
+
+    uint32_t index = UINT32_MAX;
+    if (msg->DataLength() == sizeof(index))
+    {
+        memcpy(&index, msg->Start(), sizeof(index));
+    }
+    state->inOrder = state->inOrder && index == state->received && pktInfo->SrcPort == state->senderPort &&
+        pktInfo->DestPort == endPoint->GetBoundPort() && pktInfo->DestAddress == state->address;
+
+    if (++state->received == state->freeAfter)
+    {
+        endPoint->Free();
+    }
+}
+
+void SetUDPBatching(UDPEndPoint * endPoint, bool batched)
+{
+#if INET_CONFIG_UDP_SOCKET_MMSG
+    static_cast<UDPEndPointImpl *>(endPoint)->SetBatchedReceive(batched);
+#endif // INET_CONFIG_UDP_SOCKET_MMSG
+}
+
+// Send datagrams over the loopback interface, and check that they are all received, one at a time or in batches, in
+// order, with their packet information.  With freeAfter set, the receiver frees itself from its callback.
+static void CheckUDPLoopback(nlTestSuite * inSuite, bool batched, uint32_t count, uint32_t freeAfter)
+{
+    UDPEndPoint * receiver = nullptr;
+    UDPEndPoint * sender   = nullptr;
+    UDPLoopbackState state = { IPAddress::Any, 0, 0, freeAfter, true };
+
+    NL_TEST_ASSERT(inSuite, IPAddress::FromString("::1", state.address));
+    NL_TEST_ASSERT(inSuite, gUDP.NewEndPoint(&receiver) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, gUDP.NewEndPoint(&sender) == CHIP_NO_ERROR);
+    SetUDPBatching(receiver, batched);
+
+    NL_TEST_ASSERT(inSuite, receiver->Bind(IPAddressType::kIPv6, state.address, 0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, receiver->Listen(HandleUDPLoopbackMessage, nullptr, &state) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sender->Bind(IPAddressType::kIPv6, IPAddress::Any, 0) == CHIP_NO_ERROR);
+    state.senderPort = sender->GetBoundPort();
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        PacketBufferHandle msg = PacketBufferHandle::NewWithData(&i, sizeof(i));
+        NL_TEST_ASSERT(inSuite, sender->SendTo(state.address, receiver->GetBoundPort(), std::move(msg)) == CHIP_NO_ERROR);
+    }
+
+    const uint32_t expected = (freeAfter != 0) ? freeAfter : count;
+    for (int i = 0; i < 100 && state.received < expected; i++)
+    {
+        ServiceEvents(10);
+    }
+    // Nothing more may be delivered to a freed endpoint.
+    ServiceEvents(10);
+
+    NL_TEST_ASSERT(inSuite, state.received == expected);
+    NL_TEST_ASSERT(inSuite, state.inOrder);
+
+    sender->Free();
+    if (freeAfter == 0)
+    {
+        receiver->Free();
+    }
+}
+
+static void TestInetUDPLoopback(nlTestSuite * inSuite, void * inContext)
+{
+    // More datagrams than fit in a single batch
+    CheckUDPLoopback(inSuite, false, 2 * INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE + 1, 0);
+    CheckUDPLoopback(inSuite, true, 2 * INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE + 1, 0);
+
+    // The receiver goes away in the middle of a batch
+    CheckUDPLoopback(inSuite, false, 8, 3);
+    CheckUDPLoopback(inSuite, true, 8, 3);
+}
+
+#if INET_CONFIG_ENABLE_TCP_ENDPOINT && CHIP_SYSTEM_CONFIG_USE_SOCKETS
+constexpr uint16_t kTCPFrameLengths[] = { 5, 0, 1, 700, 1200, 2, 64 };
+constexpr uint16_t kTCPMaxFrameLength = 1200;
+constexpr uint16_t kTCPFramingPort    = 4242;
+
+struct TCPFramingState
+{
+    TCPEndPoint * connection;
+    uint32_t framesReceived;
+    bool framed;
+    CHIP_ERROR closeError;
+};
+
+uint8_t TCPFrameByte(size_t frame, size_t offset)
+{
+    return static_cast<uint8_t>(frame * 31 + offset);
+}
+
+CHIP_ERROR HandleTCPFramedData(TCPEndPoint * endPoint, PacketBufferHandle && data)
+{
+    auto * state = static_cast<TCPFramingState *>(endPoint->mAppState);
+
+    // Every buffer must hold exactly the next frame, prefix included.
+    while (!data.IsNull())
+    {
+        PacketBufferHandle frame = data.PopHead();
+        const size_t index       = state->framesReceived++;
+        bool framed              = index < ArraySize(kTCPFrameLengths) &&
+            frame->DataLength() == TCPEndPoint::kFrameLengthPrefixSize + kTCPFrameLengths[index] &&
+            Encoding::LittleEndian::Get16(frame->Start()) == kTCPFrameLengths[index];
+        for (size_t i = 0; framed && i < kTCPFrameLengths[index]; i++)
+        {
+            framed = frame->Start()[TCPEndPoint::kFrameLengthPrefixSize + i] == TCPFrameByte(index, i);
+        }
+        state->framed = state->framed && framed;
+    }
+    return CHIP_NO_ERROR;
+}
+
+void HandleTCPFramedClosed(TCPEndPoint * endPoint, CHIP_ERROR err)
+{
+    static_cast<TCPFramingState *>(endPoint->mAppState)->closeError = err;
+}
+
+void HandleTCPFramedConnection(TCPEndPoint * listenEndPoint, TCPEndPoint * conEndPoint, const IPAddress & peerAddr,
+                               uint16_t peerPort)
+{
+    auto * state = static_cast<TCPFramingState *>(listenEndPoint->mAppState);
+
+    state->connection               = conEndPoint;
+    conEndPoint->mAppState          = state;
+    conEndPoint->OnDataReceived     = HandleTCPFramedData;
+    conEndPoint->OnConnectionClosed = HandleTCPFramedClosed;
+    conEndPoint->EnableLengthPrefixedFraming(kTCPMaxFrameLength);
+}
+
+// Send length-prefixed frames over the loopback interface, in buffers that split frames and length prefixes alike,
+// and check that they are received one frame per buffer.  A final frame longer than allowed must abort the connection.
+static void TestInetTCPFraming(nlTestSuite * inSuite, void * inContext)
+{
+    TCPEndPoint * listener = nullptr;
+    TCPEndPoint * client   = nullptr;
+    TCPFramingState state  = { nullptr, 0, true, CHIP_NO_ERROR };
+    IPAddress loopback;
+
+    uint8_t stream[ArraySize(kTCPFrameLengths) * TCPEndPoint::kFrameLengthPrefixSize + 2000];
+    size_t streamLength = 0;
+    for (size_t frame = 0; frame < ArraySize(kTCPFrameLengths); frame++)
+    {
+        Encoding::LittleEndian::Put16(stream + streamLength, kTCPFrameLengths[frame]);
+        streamLength += TCPEndPoint::kFrameLengthPrefixSize;
+        for (size_t i = 0; i < kTCPFrameLengths[frame]; i++)
+        {
+            stream[streamLength++] = TCPFrameByte(frame, i);
+        }
+    }
+
+    NL_TEST_ASSERT(inSuite, IPAddress::FromString("::1", loopback));
+    NL_TEST_ASSERT(inSuite, gTCP.NewEndPoint(&listener) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, gTCP.NewEndPoint(&client) == CHIP_NO_ERROR);
+    listener->mAppState            = &state;
+    listener->OnConnectionReceived = HandleTCPFramedConnection;
+    NL_TEST_ASSERT(inSuite, listener->Bind(IPAddressType::kIPv6, loopback, kTCPFramingPort, true) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, listener->Listen(1) == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, client->Connect(loopback, kTCPFramingPort) == CHIP_NO_ERROR);
+    for (int i = 0; i < 100 && (state.connection == nullptr || !client->IsConnected()); i++)
+    {
+        ServiceEvents(10);
+    }
+    NL_TEST_ASSERT(inSuite, state.connection != nullptr && client->IsConnected());
+
+    // Queue every buffer before sending, so that they are sent together.
+    const size_t chunkLengths[] = { 1, 3, 4, 700, 1000 };
+    size_t offset               = 0;
+    for (size_t i = 0; offset < streamLength; i++)
+    {
+        const size_t length      = std::min(chunkLengths[i % ArraySize(chunkLengths)], streamLength - offset);
+        PacketBufferHandle chunk = PacketBufferHandle::NewWithData(stream + offset, length);
+
+        offset += length;
+        NL_TEST_ASSERT(inSuite, client->Send(std::move(chunk), offset == streamLength) == CHIP_NO_ERROR);
+    }
+    for (int i = 0; i < 100 && state.framesReceived < ArraySize(kTCPFrameLengths); i++)
+    {
+        ServiceEvents(10);
+    }
+    NL_TEST_ASSERT(inSuite, state.framesReceived == ArraySize(kTCPFrameLengths));
+    NL_TEST_ASSERT(inSuite, state.framed);
+
+    Encoding::LittleEndian::Put16(stream, kTCPMaxFrameLength + 1);
+    NL_TEST_ASSERT(inSuite,
+                   client->Send(PacketBufferHandle::NewWithData(stream, TCPEndPoint::kFrameLengthPrefixSize)) == CHIP_NO_ERROR);
+    for (int i = 0; i < 100 && state.closeError == CHIP_NO_ERROR; i++)
+    {
+        ServiceEvents(10);
+    }
+    NL_TEST_ASSERT(inSuite, state.closeError == CHIP_ERROR_MESSAGE_TOO_LONG);
+    NL_TEST_ASSERT(inSuite, state.framesReceived == ArraySize(kTCPFrameLengths));
+
+    if (state.connection != nullptr)
+    {
+        state.connection->Free();
+    }
+    client->Free();
+    listener->Free();
+}
+#endif // INET_CONFIG_ENABLE_TCP_ENDPOINT && CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
 #if !CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
 // Test the Inet resource limitations.
 static void TestInetEndPointLimit(nlTestSuite * inSuite, void * inContext)
@@ -451,6 +669,10 @@ static const nlTest sTests[] = { NL_TEST_DEF("InetEndPoint::PreTest", TestInetPr
                                  NL_TEST_DEF("InetEndPoint::TestInetError", TestInetError),
                                  NL_TEST_DEF("InetEndPoint::TestInetInterface", TestInetInterface),
                                  NL_TEST_DEF("InetEndPoint::TestInetEndPoint", TestInetEndPointInternal),
+                                 NL_TEST_DEF("InetEndPoint::TestInetUDPLoopback", TestInetUDPLoopback),
+#if INET_CONFIG_ENABLE_TCP_ENDPOINT && CHIP_SYSTEM_CONFIG_USE_SOCKETS
+                                 NL_TEST_DEF("InetEndPoint::TestInetTCPFraming", TestInetTCPFraming),
+#endif
 #if !CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
                                  NL_TEST_DEF("InetEndPoint::TestEndPointLimit", TestInetEndPointLimit),
 #endif
@@ -700,6 +700,17 @@
 #define CHIP_CONFIG_SECURE_SESSION_REFCOUNT_LOGGING 0
 #endif
 
+/**
+ * @def CHIP_CONFIG_IM_REPORT_LATENCY_LOGGING
+ *
+ * @brief This enables logging, for every report of an established
+ * subscription, how long after the previous report it starts.
+ *
+ */
+#ifndef CHIP_CONFIG_IM_REPORT_LATENCY_LOGGING
+#define CHIP_CONFIG_IM_REPORT_LATENCY_LOGGING 0
+#endif
+
 /**
  *  @def CHIP_CONFIG_MAX_FABRICS
  *
@@ -797,6 +808,12 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
  *      * #CHIP_IM_MAX_REPORTS_IN_FLIGHT
  *      * #CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS
  *      * #CHIP_IM_SERVER_MAX_NUM_DIRTY_SET
+ *      * #CHIP_IM_SERVER_MAX_NUM_PENDING_DIRTY_PATHS
+ *      * #CHIP_IM_SERVER_MAX_NUM_CACHED_ATTRIBUTE_REPORTS
+ *      * #CHIP_IM_SERVER_CACHED_ATTRIBUTE_REPORT_SIZE
+ *      * #CHIP_IM_SERVER_PATH_EXPANSION_CACHE_MAX_ENDPOINTS
+ *      * #CHIP_IM_SERVER_PATH_EXPANSION_CACHE_MAX_CLUSTERS
+ *      * #CHIP_IM_SERVER_PATH_EXPANSION_CACHE_MAX_ATTRIBUTES
  *      * #CHIP_IM_MAX_NUM_WRITE_HANDLER
  *      * #CHIP_IM_MAX_NUM_WRITE_CLIENT
  *      * #CHIP_IM_MAX_NUM_TIMED_HANDLER
@@ -874,6 +891,65 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_IM_SERVER_MAX_NUM_DIRTY_SET 8
 #endif
 
+/**
+ * @def CHIP_IM_SERVER_MAX_NUM_PENDING_DIRTY_PATHS
+ *
+ * @brief Defines the number of dirty paths the reporting engine can hold while a batch of attribute changes is open, before it has
+ *        to flush them early.
+ */
+#ifndef CHIP_IM_SERVER_MAX_NUM_PENDING_DIRTY_PATHS
+#define CHIP_IM_SERVER_MAX_NUM_PENDING_DIRTY_PATHS 16
+#endif
+
+/**
+ * @def CHIP_IM_SERVER_MAX_NUM_CACHED_ATTRIBUTE_REPORTS
+ *
+ * @brief Defines the number of encoded attribute reports the reporting engine keeps to share between the read handlers it services
+ *        within one run.  Set to 0 to disable sharing encoded reports.
+ */
+#ifndef CHIP_IM_SERVER_MAX_NUM_CACHED_ATTRIBUTE_REPORTS
+#define CHIP_IM_SERVER_MAX_NUM_CACHED_ATTRIBUTE_REPORTS 0
+#endif
+
+/**
+ * @def CHIP_IM_SERVER_CACHED_ATTRIBUTE_REPORT_SIZE
+ *
+ * @brief Defines the largest encoded attribute report, in bytes, that can be shared between read handlers.  Larger attributes are
+ *        always encoded separately for each read handler.
+ */
+#ifndef CHIP_IM_SERVER_CACHED_ATTRIBUTE_REPORT_SIZE
+#define CHIP_IM_SERVER_CACHED_ATTRIBUTE_REPORT_SIZE 128
+#endif
+
+/**
+ * @def CHIP_IM_SERVER_PATH_EXPANSION_CACHE_MAX_ATTRIBUTES
+ *
+ * @brief Defines the number of attributes, across all endpoints and clusters, the flattened copy of the data model used to expand
+ *        wildcard attribute paths can hold.  Set to 0 to always expand wildcard paths from the ember metadata directly.
+ */
+#ifndef CHIP_IM_SERVER_PATH_EXPANSION_CACHE_MAX_ATTRIBUTES
+#define CHIP_IM_SERVER_PATH_EXPANSION_CACHE_MAX_ATTRIBUTES 0
+#endif
+
+/**
+ * @def CHIP_IM_SERVER_PATH_EXPANSION_CACHE_MAX_ENDPOINTS
+ *
+ * @brief Defines the number of endpoints the flattened copy of the data model used to expand wildcard attribute paths can hold.
+ */
+#ifndef CHIP_IM_SERVER_PATH_EXPANSION_CACHE_MAX_ENDPOINTS
+#define CHIP_IM_SERVER_PATH_EXPANSION_CACHE_MAX_ENDPOINTS 8
+#endif
+
+/**
+ * @def CHIP_IM_SERVER_PATH_EXPANSION_CACHE_MAX_CLUSTERS
+ *
+ * @brief Defines the number of server clusters, across all endpoints, the flattened copy of the data model used to expand wildcard
+ *        attribute paths can hold.
+ */
+#ifndef CHIP_IM_SERVER_PATH_EXPANSION_CACHE_MAX_CLUSTERS
+#define CHIP_IM_SERVER_PATH_EXPANSION_CACHE_MAX_CLUSTERS 64
+#endif
+
 /**
  * @def CHIP_IM_MAX_NUM_WRITE_HANDLER
  *
@@ -902,6 +978,18 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_IM_MAX_NUM_TIMED_HANDLER 8
 #endif
 
+/**
+ * @def CHIP_IM_CLIENT_REPORT_TLV_INDEX_SIZE
+ *
+ * @brief Defines the number of containers of a received report that the read client indexes, so that the
+ *        parsers of the report jump over them instead of reading them again for each field lookup and
+ *        schema check. Each entry takes 8 bytes of stack while the report is processed. Set to 0 to
+ *        disable the index.
+ */
+#ifndef CHIP_IM_CLIENT_REPORT_TLV_INDEX_SIZE
+#define CHIP_IM_CLIENT_REPORT_TLV_INDEX_SIZE 32
+#endif
+
 /**
  * @def CONFIG_BUILD_FOR_HOST_UNIT_TEST
  *
@@ -969,6 +1057,48 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_DEVICE_MAX_ACTIVE_CASE_CLIENTS 2
 #endif
 
+/**
+ * @def CHIP_CONFIG_CASE_CONNECT_MAX_CONCURRENCY
+ *
+ * @brief Maximum number of CASE session establishments that the bulk connect
+ *        scheduler of CASESessionManager keeps in progress at once. Should not
+ *        exceed the number of session setups and CASE clients available.
+ */
+#ifndef CHIP_CONFIG_CASE_CONNECT_MAX_CONCURRENCY
+#define CHIP_CONFIG_CASE_CONNECT_MAX_CONCURRENCY 4
+#endif
+
+/**
+ * @def CHIP_CONFIG_CASE_CONNECT_PACING_INTERVAL_MS
+ *
+ * @brief Default minimum delay, in milliseconds, between the starts of two CASE
+ *        session establishments by the bulk connect scheduler.
+ */
+#ifndef CHIP_CONFIG_CASE_CONNECT_PACING_INTERVAL_MS
+#define CHIP_CONFIG_CASE_CONNECT_PACING_INTERVAL_MS 50
+#endif
+
+/**
+ * @def CHIP_CONFIG_CASE_CONNECT_PACING_JITTER_MS
+ *
+ * @brief Default maximum random delay, in milliseconds, added to
+ *        CHIP_CONFIG_CASE_CONNECT_PACING_INTERVAL_MS.
+ */
+#ifndef CHIP_CONFIG_CASE_CONNECT_PACING_JITTER_MS
+#define CHIP_CONFIG_CASE_CONNECT_PACING_JITTER_MS 50
+#endif
+
+/**
+ * @def CHIP_CONFIG_CASE_CONNECT_MAX_RETRIES
+ *
+ * @brief Default number of times the bulk connect scheduler retries an
+ *        establishment, with exponential backoff, when no session setup
+ *        could be allocated for it.
+ */
+#ifndef CHIP_CONFIG_CASE_CONNECT_MAX_RETRIES
+#define CHIP_CONFIG_CASE_CONNECT_MAX_RETRIES 3
+#endif
+
 /**
  * @def CHIP_CONFIG_DEVICE_MAX_ACTIVE_DEVICES
  *
@@ -1227,6 +1357,31 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_RESUBSCRIBE_WAIT_TIME_MULTIPLIER_MS 10000
 #endif
 
+/**
+ *  @def CHIP_RESUBSCRIBE_MULTI_NODE_SPACING_MS
+ *
+ *  @brief
+ *    Minimum time between two re-subscription attempts of the subscriptions of
+ *    a MultiNodeReadClient, so that nodes whose subscriptions dropped at the same
+ *    time are not all re-subscribed (and CASE re-established with) at once.
+ *
+ */
+#ifndef CHIP_RESUBSCRIBE_MULTI_NODE_SPACING_MS
+#define CHIP_RESUBSCRIBE_MULTI_NODE_SPACING_MS 100
+#endif
+
+/**
+ *  @def CHIP_CONFIG_MULTI_NODE_READ_MAX_NODES
+ *
+ *  @brief
+ *    Maximum number of nodes a MultiNodeReadClient can interact with at once.
+ *    Ignored when pools use the heap.
+ *
+ */
+#ifndef CHIP_CONFIG_MULTI_NODE_READ_MAX_NODES
+#define CHIP_CONFIG_MULTI_NODE_READ_MAX_NODES 8
+#endif
+
 /*
  * @def CHIP_CONFIG_MAX_ATTRIBUTE_STORE_ELEMENT_SIZE
  *
@@ -1243,20 +1398,6 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MAX_ATTRIBUTE_STORE_ELEMENT_SIZE 1003
 #endif // CHIP_CONFIG_MAX_ATTRIBUTE_STORE_ELEMENT_SIZE
 
-/*
- * @def CHIP_CONFIG_MINMDNS_DYNAMIC_OPERATIONAL_RESPONDER_LIST
- *
- * @brief Enables usage of heap in the minmdns DNSSD implementation
- *        for tracking active operational responder lists.
- *
- *        When this is not set, CHIP_CONFIG_MAX_FABRICS is used to determine
- *        and statically allocate pointers needed to track active
- *        operational responder lists.
- */
-#ifndef CHIP_CONFIG_MINMDNS_DYNAMIC_OPERATIONAL_RESPONDER_LIST
-#define CHIP_CONFIG_MINMDNS_DYNAMIC_OPERATIONAL_RESPONDER_LIST 0
-#endif // CHIP_CONFIG_MINMDNS_DYNAMIC_OPERATIONAL_RESPONDER_LIST
-
 /*
  * @def CHIP_CONFIG_MINMDNS_MAX_PARALLEL_RESOLVES
  *
@@ -1270,6 +1411,43 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MINMDNS_MAX_PARALLEL_RESOLVES 2
 #endif // CHIP_CONFIG_MINMDNS_MAX_PARALLEL_RESOLVES
 
+/*
+ * @def CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE
+ *
+ * @brief Determines the number of replies to recent queries that the minmdns
+ *        responder keeps encoded, to answer the same queries again without
+ *        building the replies from scratch. Each entry takes a little over
+ *        600 bytes. Set to 0 to disable caching replies.
+ */
+#ifndef CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE
+#define CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE 0
+#endif // CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE
+
+/*
+ * @def CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE
+ *
+ * @brief Determines the number of records received in mDNS replies that the
+ *        minmdns resolver keeps until their TTL expires. Cached records resolve
+ *        nodes without querying the network again and are sent as known answers
+ *        to browse queries. Each entry takes a little under 300 bytes. Set to 0
+ *        to disable caching records.
+ */
+#ifndef CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE
+#define CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE 0
+#endif // CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE
+
+/*
+ * @def CHIP_CONFIG_MINMDNS_PACKET_INDEX_SIZE
+ *
+ * @brief Determines the number of queries and resource records of a received
+ *        mDNS packet that the minmdns resolver and responder index at once.
+ *        Larger packets are indexed in several steps. Each entry takes 16
+ *        bytes, for the resolver and for the responder.
+ */
+#ifndef CHIP_CONFIG_MINMDNS_PACKET_INDEX_SIZE
+#define CHIP_CONFIG_MINMDNS_PACKET_INDEX_SIZE 16
+#endif // CHIP_CONFIG_MINMDNS_PACKET_INDEX_SIZE
+
 /**
  * def CHIP_CONFIG_MDNS_RESOLVE_LOOKUP_RESULTS
  *
@@ -1336,6 +1514,40 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #ifndef CHIP_CONFIG_MAX_CLIENT_REG_PER_FABRIC
 #define CHIP_CONFIG_MAX_CLIENT_REG_PER_FABRIC 1
 #endif // CHIP_CONFIG_MAX_CLIENT_REG_PER_FABRIC
+
+/**
+ * @def CHIP_CONFIG_ATTRIBUTE_WRITE_COALESCING_DELAY_MS
+ *
+ * @brief How long the server holds back writes of persisted attribute values,
+ *        so that successive writes of an attribute result in a single write to
+ *        non-volatile storage. Set to 0 to write values immediately.
+ */
+#ifndef CHIP_CONFIG_ATTRIBUTE_WRITE_COALESCING_DELAY_MS
+#define CHIP_CONFIG_ATTRIBUTE_WRITE_COALESCING_DELAY_MS 0
+#endif // CHIP_CONFIG_ATTRIBUTE_WRITE_COALESCING_DELAY_MS
+
+/**
+ * @def CHIP_CONFIG_ATTRIBUTE_WRITE_COALESCING_TABLE_SIZE
+ *
+ * @brief Number of attributes whose writes can be held back at the same time
+ *        when CHIP_CONFIG_ATTRIBUTE_WRITE_COALESCING_DELAY_MS is set. When the
+ *        table is full, the oldest pending write is made to make room.
+ */
+#ifndef CHIP_CONFIG_ATTRIBUTE_WRITE_COALESCING_TABLE_SIZE
+#define CHIP_CONFIG_ATTRIBUTE_WRITE_COALESCING_TABLE_SIZE 16
+#endif // CHIP_CONFIG_ATTRIBUTE_WRITE_COALESCING_TABLE_SIZE
+
+/**
+ * @def CHIP_CONFIG_ATTRIBUTE_WRITE_COALESCING_MAX_VALUE_SIZE
+ *
+ * @brief Largest attribute value whose writes can be held back. Larger values,
+ *        such as long strings, are written immediately. Each entry of the table
+ *        takes this many bytes plus 24.
+ */
+#ifndef CHIP_CONFIG_ATTRIBUTE_WRITE_COALESCING_MAX_VALUE_SIZE
+#define CHIP_CONFIG_ATTRIBUTE_WRITE_COALESCING_MAX_VALUE_SIZE 16
+#endif // CHIP_CONFIG_ATTRIBUTE_WRITE_COALESCING_MAX_VALUE_SIZE
+
 /**
  * @}
  */
@@ -35,6 +35,10 @@ public:
     bool IsOperational() const { return mFabricIndex != kUndefinedFabricIndex && IsOperationalNodeId(mNodeId); }
     bool operator==(const ScopedNodeId & that) const { return (mNodeId == that.mNodeId) && (mFabricIndex == that.mFabricIndex); }
     bool operator!=(const ScopedNodeId & that) const { return !(*this == that); }
+    bool operator<(const ScopedNodeId & that) const
+    {
+        return (mFabricIndex < that.mFabricIndex) || ((mFabricIndex == that.mFabricIndex) && (mNodeId < that.mNodeId));
+    }
 
 private:
     NodeId mNodeId;
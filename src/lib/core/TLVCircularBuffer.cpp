@@ -38,7 +38,9 @@
 
 #include <lib/support/CodeUtils.h>
 
+#include <algorithm>
 #include <stdint.h>
+#include <string.h>
 
 namespace chip {
 namespace TLV {
@@ -165,6 +167,49 @@ CHIP_ERROR TLVCircularBuffer::EvictHead()
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR TLVCircularBuffer::DiscardHead(uint32_t aLength)
+{
+    VerifyOrReturnError(aLength <= mQueueLength, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(aLength > 0, CHIP_NO_ERROR);
+
+    mQueueHead = mQueue + ((static_cast<size_t>(mQueueHead - mQueue) + aLength) % mQueueSize);
+    mQueueLength -= aLength;
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR TLVCircularBuffer::MoveHeadTo(TLVCircularBuffer & aDestination, uint32_t aLength)
+{
+    VerifyOrReturnError(aLength <= mQueueLength, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(aLength <= aDestination.AvailableDataLength(), CHIP_ERROR_NO_MEMORY);
+
+    // The head region may wrap around the end of the backing store, copy it in at most two runs.
+    const uint8_t * source = mQueueHead;
+    uint32_t remaining     = aLength;
+    while (remaining > 0)
+    {
+        uint32_t run = std::min(remaining, static_cast<uint32_t>(mQueue + mQueueSize - source));
+        aDestination.AppendToTail(source, run);
+        source = (source + run == mQueue + mQueueSize) ? mQueue : source + run;
+        remaining -= run;
+    }
+
+    return DiscardHead(aLength);
+}
+
+void TLVCircularBuffer::AppendToTail(const uint8_t * aData, uint32_t aLength)
+{
+    while (aLength > 0)
+    {
+        uint8_t * tail = QueueTail();
+        uint32_t run   = std::min(aLength, static_cast<uint32_t>(mQueue + mQueueSize - tail));
+        memcpy(tail, aData, run);
+        mQueueLength += run;
+        aData += run;
+        aLength -= run;
+    }
+}
+
 /**
  * @brief
  *  Implements TLVBackingStore::OnInit(TLVWriter) for circular buffers.
@@ -70,6 +70,31 @@ public:
 
     CHIP_ERROR EvictHead();
 
+    /**
+     * @brief
+     *   Drop the first @a aLength bytes of the buffer without parsing them.
+     *
+     * The caller is responsible for @a aLength ending on a top-level TLV element boundary, e.g. by having measured the elements
+     * with a CircularTLVReader beforehand.  #mProcessEvictedElement is not called.
+     *
+     * @retval #CHIP_NO_ERROR                On success.
+     * @retval #CHIP_ERROR_INVALID_ARGUMENT  If the buffer holds fewer than @a aLength bytes.
+     */
+    CHIP_ERROR DiscardHead(uint32_t aLength);
+
+    /**
+     * @brief
+     *   Move the first @a aLength bytes of this buffer to the tail of @a aDestination, as a raw copy of the encoded elements,
+     *   and drop them from this buffer.
+     *
+     * As with DiscardHead, @a aLength must end on a top-level TLV element boundary.  Nothing is evicted from @a aDestination.
+     *
+     * @retval #CHIP_NO_ERROR                On success.
+     * @retval #CHIP_ERROR_INVALID_ARGUMENT  If this buffer holds fewer than @a aLength bytes.
+     * @retval #CHIP_ERROR_NO_MEMORY         If @a aDestination does not have @a aLength bytes available.
+     */
+    CHIP_ERROR MoveHeadTo(TLVCircularBuffer & aDestination, uint32_t aLength);
+
     // chip::TLV::TLVBackingStore overrides:
     CHIP_ERROR OnInit(TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen) override;
     CHIP_ERROR GetNextBuffer(TLVReader & ioReader, const uint8_t *& outBufStart, uint32_t & outBufLen) override;
@@ -129,6 +154,8 @@ public:
                                    implementing the mProcessEvictedElement function. */
 
 private:
+    void AppendToTail(const uint8_t * aData, uint32_t aLength);
+
     uint8_t * mQueue;
     uint32_t mQueueSize;
     uint8_t * mQueueHead;
@@ -0,0 +1,110 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <lib/core/TLVIndex.h>
+
+#include <lib/support/CodeUtils.h>
+
+namespace chip {
+namespace TLV {
+
+CHIP_ERROR TLVIndex::Build(const ContiguousBufferTLVReader & aReader)
+{
+    // Entries of the containers being read and types of the containers enclosing them.
+    size_t openEntries[kMaxDepth];
+    TLVType outer[kMaxDepth];
+    size_t depth = 0;
+    CHIP_ERROR err;
+
+    Clear();
+
+    TLVReader reader;
+    reader.Init(aReader);
+    reader.SetIndex(nullptr);
+    mData   = reader.GetReadPoint();
+    mLength = reader.GetRemainingLength();
+
+    while (true)
+    {
+        err = reader.Next();
+        if (err == CHIP_END_OF_TLV && depth > 0)
+        {
+            depth--;
+            SuccessOrExit(err = reader.ExitContainer(outer[depth]));
+            mEntries.data()[openEntries[depth]].end = static_cast<uint32_t>(reader.GetReadPoint() - mData);
+            continue;
+        }
+        if (err == CHIP_END_OF_TLV)
+        {
+            break;
+        }
+        SuccessOrExit(err);
+
+        // Only enter the containers that can be indexed. The others are read element by element by the next call to Next().
+        if (TLVTypeIsContainer(reader.GetType()) && depth < kMaxDepth && mCount < mEntries.size())
+        {
+            Entry & entry      = mEntries.data()[mCount];
+            entry.start        = static_cast<uint32_t>(reader.GetReadPoint() - mData);
+            entry.end          = 0;
+            openEntries[depth] = mCount++;
+            SuccessOrExit(err = reader.EnterContainer(outer[depth]));
+            depth++;
+        }
+    }
+
+    return CHIP_NO_ERROR;
+
+exit:
+    Clear();
+    // Running out of data in a container is an underrun, as for the readers.
+    return (err == CHIP_END_OF_TLV) ? CHIP_ERROR_TLV_UNDERRUN : err;
+}
+
+void TLVIndex::Clear()
+{
+    mData   = nullptr;
+    mLength = 0;
+    mCount  = 0;
+}
+
+const uint8_t * TLVIndex::FindContainerEnd(const uint8_t * contentStart) const
+{
+    VerifyOrReturnValue(mCount > 0 && contentStart >= mData && contentStart < mData + mLength, nullptr);
+    const uint32_t start = static_cast<uint32_t>(contentStart - mData);
+
+    // Containers are indexed in the order of their start.
+    size_t low  = 0;
+    size_t high = mCount;
+    while (low < high)
+    {
+        const size_t middle = low + (high - low) / 2;
+        if (mEntries.data()[middle].start < start)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    VerifyOrReturnValue(low < mCount && mEntries.data()[low].start == start, nullptr);
+    return mData + mEntries.data()[low].end;
+}
+
+} // namespace TLV
+} // namespace chip
@@ -0,0 +1,103 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines an index of the containers of a TLV encoding, that lets
+ *      readers jump over containers instead of reading them element by element.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <lib/core/TLVReader.h>
+#include <lib/support/Span.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace TLV {
+
+/**
+ * Index of the containers of a TLV encoding held in a contiguous buffer,
+ * built in a single pass over the encoding.
+ *
+ * Readers the index is attached to with TLVReader::SetIndex(), and the
+ * readers initialized from them, jump to the end of the indexed containers
+ * they skip (in Next(), Skip(), ExitContainer(), FindElementWithTag(),
+ * CountRemainingInContainer()...) instead of reading their elements again.
+ * As all the elements were verified when building the index, this changes
+ * nothing but the time taken, provided that the encoding is not modified
+ * while the index is in use.
+ *
+ * The entries are provided by the caller. Containers are indexed in the order
+ * of their start, so the outer containers, which are the most worth jumping
+ * over, are indexed before the ones they contain. Containers beyond the
+ * capacity of the entries or nested deeper than kMaxDepth are read element by
+ * element.
+ */
+class TLVIndex
+{
+public:
+    static constexpr size_t kMaxDepth = 16;
+
+    struct Entry
+    {
+        // Offsets in the indexed encoding of the first element of the container,
+        // and of the end of the container, past its end-of-container element.
+        uint32_t start;
+        uint32_t end;
+    };
+
+    explicit TLVIndex(const Span<Entry> & entries) : mEntries(entries) {}
+
+    TLVIndex(const TLVIndex &) = delete;
+    TLVIndex & operator=(const TLVIndex &) = delete;
+
+    /**
+     * Index the containers read by a reader from its current position, which must be
+     * between elements, to the end of its current container or of the encoding.
+     * The reader itself is left untouched.
+     *
+     * @retval #CHIP_NO_ERROR  If the encoding was indexed.
+     * @retval other           The error met reading the encoding, in which case nothing is indexed.
+     */
+    CHIP_ERROR Build(const ContiguousBufferTLVReader & reader);
+
+    /**
+     * Drop the index, e.g. before the indexed encoding gets modified.
+     */
+    void Clear();
+
+    size_t GetCount() const { return mCount; }
+
+    /**
+     * Returns the end of the indexed container whose first element starts at contentStart,
+     * or nullptr if there is no such container in the index.
+     */
+    const uint8_t * FindContainerEnd(const uint8_t * contentStart) const;
+
+private:
+    const Span<Entry> mEntries;
+    const uint8_t * mData = nullptr;
+    uint32_t mLength      = 0;
+    size_t mCount         = 0;
+};
+
+} // namespace TLV
+} // namespace chip
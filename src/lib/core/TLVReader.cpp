@@ -28,6 +28,7 @@
 #include <lib/core/CHIPEncoding.h>
 #include <lib/core/CHIPSafeCasts.h>
 #include <lib/core/TLV.h>
+#include <lib/core/TLVIndex.h>
 #include <lib/support/CHIPMem.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/SafeInt.h>
@@ -44,6 +45,7 @@ void TLVReader::Init(const uint8_t * data, size_t dataLen)
     // TODO: Maybe we can just make mMaxLen and mLenRead size_t instead?
     uint32_t actualDataLen = dataLen > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(dataLen);
     mBackingStore          = nullptr;
+    mIndex                 = nullptr;
     mReadPoint             = data;
     mBufEnd                = data + actualDataLen;
     mLenRead               = 0;
@@ -58,6 +60,7 @@ void TLVReader::Init(const uint8_t * data, size_t dataLen)
 CHIP_ERROR TLVReader::Init(TLVBackingStore & backingStore, uint32_t maxLen)
 {
     mBackingStore   = &backingStore;
+    mIndex          = nullptr;
     mReadPoint      = nullptr;
     uint32_t bufLen = 0;
     CHIP_ERROR err  = mBackingStore->OnInit(*this, mReadPoint, bufLen);
@@ -83,6 +86,7 @@ void TLVReader::Init(const TLVReader & aReader)
     mElemTag       = aReader.mElemTag;
     mElemLenOrVal  = aReader.mElemLenOrVal;
     mBackingStore  = aReader.mBackingStore;
+    mIndex         = aReader.mIndex;
     mReadPoint     = aReader.mReadPoint;
     mBufEnd        = aReader.mBufEnd;
     mLenRead       = aReader.mLenRead;
@@ -439,6 +443,7 @@ CHIP_ERROR TLVReader::OpenContainer(TLVReader & containerReader)
         return CHIP_ERROR_INCORRECT_STATE;
 
     containerReader.mBackingStore = mBackingStore;
+    containerReader.mIndex        = mIndex;
     containerReader.mReadPoint    = mReadPoint;
     containerReader.mBufEnd       = mBufEnd;
     containerReader.mLenRead      = mLenRead;
@@ -519,19 +524,10 @@ CHIP_ERROR TLVReader::VerifyEndOfContainer()
 
 CHIP_ERROR TLVReader::Next()
 {
-    CHIP_ERROR err;
-    TLVElementType elemType = ElementType();
-
-    err = Skip();
-    if (err != CHIP_NO_ERROR)
-        return err;
+    ReturnErrorOnFailure(Skip());
+    ReturnErrorOnFailure(ReadElement());
 
-    err = ReadElement();
-    if (err != CHIP_NO_ERROR)
-        return err;
-
-    elemType = ElementType();
-    if (elemType == TLVElementType::EndOfContainer)
+    if (ElementType() == TLVElementType::EndOfContainer)
         return CHIP_END_OF_TLV;
 
     return CHIP_NO_ERROR;
@@ -565,7 +561,13 @@ CHIP_ERROR TLVReader::Skip()
     if (elemType == TLVElementType::EndOfContainer)
         return CHIP_END_OF_TLV;
 
-    if (TLVTypeIsContainer(elemType))
+    if (TLVTypeIsContainer(elemType) && JumpOverContainer())
+    {
+        SetContainerOpen(false);
+        ClearElementState();
+    }
+
+    else if (TLVTypeIsContainer(elemType))
     {
         TLVType outerContainerType;
         err = EnterContainer(outerContainerType);
@@ -649,7 +651,7 @@ CHIP_ERROR TLVReader::SkipToEndOfContainer()
             mContainerType = (nestLevel == 0) ? outerContainerType : kTLVType_UnknownContainer;
         }
 
-        else if (TLVTypeIsContainer(elemType))
+        else if (TLVTypeIsContainer(elemType) && !JumpOverContainer())
         {
             nestLevel++;
             mContainerType = static_cast<TLVType>(elemType);
@@ -665,6 +667,24 @@ CHIP_ERROR TLVReader::SkipToEndOfContainer()
     }
 }
 
+/**
+ * Move the reader, positioned on a container element, to the end of the container if it is in the index
+ * of the encoding.
+ *
+ * @return true if the reader was moved, false if it has to read the elements of the container instead.
+ */
+bool TLVReader::JumpOverContainer()
+{
+    VerifyOrReturnValue(mIndex != nullptr && mBackingStore == nullptr, false);
+
+    const uint8_t * end = mIndex->FindContainerEnd(mReadPoint);
+    VerifyOrReturnValue(end != nullptr && end <= mBufEnd, false);
+
+    mLenRead += static_cast<uint32_t>(end - mReadPoint);
+    mReadPoint = end;
+    return true;
+}
+
 CHIP_ERROR TLVReader::ReadElement()
 {
     CHIP_ERROR err;
@@ -673,9 +693,12 @@ CHIP_ERROR TLVReader::ReadElement()
     TLVElementType elemType;
 
     // Make sure we have input data. Return CHIP_END_OF_TLV if no more data is available.
-    err = EnsureData(CHIP_END_OF_TLV);
-    if (err != CHIP_NO_ERROR)
-        return err;
+    if (mReadPoint == mBufEnd)
+    {
+        err = EnsureData(CHIP_END_OF_TLV);
+        if (err != CHIP_NO_ERROR)
+            return err;
+    }
 
     if (mReadPoint == nullptr)
     {
@@ -724,8 +747,14 @@ CHIP_ERROR TLVReader::ReadElement()
     // Skip over the control byte.
     p++;
 
-    // Read the tag field, if present.
-    mElemTag = ReadTag(tagControl, p);
+    // Read the tag field, if present. Context-specific and anonymous tags, which are the ones used by the
+    // Interaction Model, are read here without going through ReadTag().
+    if (tagControl == TLVTagControl::ContextSpecific)
+        mElemTag = ContextTag(Read8(p));
+    else if (tagControl == TLVTagControl::Anonymous)
+        mElemTag = AnonymousTag();
+    else
+        mElemTag = ReadTag(tagControl, p);
 
     // Read the length/value field, if present.
     switch (lenOrValFieldSize)
@@ -843,6 +872,16 @@ CHIP_ERROR TLVReader::ReadData(uint8_t * buf, uint32_t len)
 {
     CHIP_ERROR err;
 
+    // Data lying within the current buffer, which is all of it for readers without a backing store, is read in one step.
+    if (len <= static_cast<uint32_t>(mBufEnd - mReadPoint))
+    {
+        if (buf != nullptr && len > 0)
+            memcpy(buf, mReadPoint, len);
+        mReadPoint += len;
+        mLenRead += len;
+        return CHIP_NO_ERROR;
+    }
+
     while (len > 0)
     {
         err = EnsureData(CHIP_ERROR_TLV_UNDERRUN);
@@ -935,16 +974,6 @@ CHIP_ERROR TLVReader::GetElementHeadLength(uint8_t & elemHeadBytes) const
     return CHIP_NO_ERROR;
 }
 
-/**
- * This is a private method that returns the TLVElementType from mControlByte
- */
-TLVElementType TLVReader::ElementType() const
-{
-    if (mControlByte == static_cast<uint16_t>(kTLVControlByte_NotSpecified))
-        return TLVElementType::NotSpecified;
-    return static_cast<TLVElementType>(mControlByte & kTLVTypeMask);
-}
-
 CHIP_ERROR TLVReader::FindElementWithTag(Tag tag, TLVReader & destReader) const
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
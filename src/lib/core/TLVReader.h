@@ -43,6 +43,8 @@
 namespace chip {
 namespace TLV {
 
+class TLVIndex;
+
 /**
  * Provides a memory efficient parser for data encoded in CHIP TLV format.
  *
@@ -852,6 +854,17 @@ public:
      */
     const uint8_t * GetReadPoint() const { return mReadPoint; }
 
+    /**
+     * Sets the index of the containers of the TLV encoding being read, which the reader, and the
+     * readers initialized from it, use to jump over the indexed containers they skip.
+     *
+     * The index must outlive its use by the readers, and the indexed encoding must not be modified
+     * while it is in use. Only readers without a backing store use the index.
+     *
+     * @param[in] index     The index, built over the encoding being read, or nullptr to stop using one.
+     */
+    void SetIndex(const TLVIndex * index) { mIndex = index; }
+
     /**
      * Advances the TLVReader object to immediately after the current TLV element.
      *
@@ -920,6 +933,7 @@ protected:
     Tag mElemTag;
     uint64_t mElemLenOrVal;
     TLVBackingStore * mBackingStore;
+    const TLVIndex * mIndex;
     const uint8_t * mReadPoint;
     const uint8_t * mBufEnd;
     uint32_t mLenRead;
@@ -938,12 +952,19 @@ protected:
     void ClearElementState();
     CHIP_ERROR SkipData();
     CHIP_ERROR SkipToEndOfContainer();
+    bool JumpOverContainer();
     CHIP_ERROR VerifyElement();
     Tag ReadTag(TLVTagControl tagControl, const uint8_t *& p) const;
     CHIP_ERROR EnsureData(CHIP_ERROR noDataErr);
     CHIP_ERROR ReadData(uint8_t * buf, uint32_t len);
     CHIP_ERROR GetElementHeadLength(uint8_t & elemHeadBytes) const;
-    TLVElementType ElementType() const;
+    // Returns the TLVElementType from mControlByte.
+    TLVElementType ElementType() const
+    {
+        if (mControlByte == static_cast<uint16_t>(kTLVControlByte_NotSpecified))
+            return TLVElementType::NotSpecified;
+        return static_cast<TLVElementType>(mControlByte & kTLVTypeMask);
+    }
 };
 
 /*
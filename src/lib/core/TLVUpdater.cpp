@@ -85,6 +85,7 @@ CHIP_ERROR TLVUpdater::Init(TLVReader & aReader, uint32_t freeLen)
 
     // Initialize the internal reader object
     mUpdaterReader.mBackingStore  = nullptr;
+    mUpdaterReader.mIndex         = nullptr;
     mUpdaterReader.mReadPoint     = buf + freeLen;
     mUpdaterReader.mBufEnd        = buf + freeLen + remainingDataLen;
     mUpdaterReader.mLenRead       = readDataLen;
@@ -0,0 +1,318 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Measures the throughput of TLV encoding and decoding over payloads shaped like
+ *      Interaction Model reports: writing them to a contiguous buffer and to a backing
+ *      store, reading every element of them, skipping over their elements, and looking
+ *      up their fields as the MessageDef parsers do, with and without a TLVIndex.
+ *
+ *      Usage: tlv-benchmark [iterations]
+ */
+
+#include <lib/core/CHIPError.h>
+#include <lib/core/TLV.h>
+#include <lib/core/TLVIndex.h>
+#include <lib/support/CodeUtils.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+using namespace chip;
+using namespace chip::TLV;
+
+constexpr size_t kDefaultIterations = 2000;
+constexpr size_t kReports           = 64;
+constexpr size_t kBufferSize        = 8192;
+constexpr size_t kIndexEntries      = 32;
+
+// Hands out a single buffer, as PacketBufferTLVWriter does when it does not chain buffers.
+class SingleBufferBackingStore : public TLVBackingStore
+{
+public:
+    SingleBufferBackingStore(uint8_t * buffer, uint32_t length) : mBuffer(buffer), mLength(length) {}
+
+    CHIP_ERROR OnInit(TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen) override
+    {
+        bufStart = mBuffer;
+        bufLen   = mLength;
+        return CHIP_NO_ERROR;
+    }
+    CHIP_ERROR GetNextBuffer(TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen) override
+    {
+        bufStart = nullptr;
+        bufLen   = 0;
+        return CHIP_NO_ERROR;
+    }
+    CHIP_ERROR OnInit(TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override
+    {
+        bufStart = mBuffer;
+        bufLen   = mLength;
+        return CHIP_NO_ERROR;
+    }
+    CHIP_ERROR GetNewBuffer(TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override { return CHIP_ERROR_NO_MEMORY; }
+    CHIP_ERROR FinalizeBuffer(TLVWriter & writer, uint8_t * bufStart, uint32_t bufLen) override { return CHIP_NO_ERROR; }
+
+private:
+    uint8_t * mBuffer;
+    uint32_t mLength;
+};
+
+// Writes a report of kReports attribute values, with the layout of a ReportDataMessage:
+// { 1: [ { 1: { 0: dataVersion, 1: { 2: endpoint, 3: cluster, 4: attribute }, 2: value } }, ... ], 255: revision }
+CHIP_ERROR WriteReport(TLVWriter & writer, size_t & elements)
+{
+    TLVType report, reports, reportIB, data, path;
+
+    elements = 0;
+    ReturnErrorOnFailure(writer.StartContainer(AnonymousTag(), kTLVType_Structure, report));
+    ReturnErrorOnFailure(writer.StartContainer(ContextTag(1), kTLVType_Array, reports));
+    for (size_t i = 0; i < kReports; i++)
+    {
+        ReturnErrorOnFailure(writer.StartContainer(AnonymousTag(), kTLVType_Structure, reportIB));
+        ReturnErrorOnFailure(writer.StartContainer(ContextTag(1), kTLVType_Structure, data));
+        ReturnErrorOnFailure(writer.Put(ContextTag(0), static_cast<uint32_t>(0x12345678 + i)));
+        ReturnErrorOnFailure(writer.StartContainer(ContextTag(1), kTLVType_List, path));
+        ReturnErrorOnFailure(writer.Put(ContextTag(2), static_cast<uint16_t>(1 + i % 4)));
+        ReturnErrorOnFailure(writer.Put(ContextTag(3), static_cast<uint32_t>(0x0300)));
+        ReturnErrorOnFailure(writer.Put(ContextTag(4), static_cast<uint32_t>(i)));
+        ReturnErrorOnFailure(writer.EndContainer(path));
+        switch (i % 3)
+        {
+        case 0:
+            ReturnErrorOnFailure(writer.PutBoolean(ContextTag(2), (i & 1) != 0));
+            break;
+        case 1:
+            ReturnErrorOnFailure(writer.Put(ContextTag(2), static_cast<uint16_t>(i * 100)));
+            break;
+        default:
+            ReturnErrorOnFailure(writer.PutString(ContextTag(2), "Living room lamp"));
+            break;
+        }
+        ReturnErrorOnFailure(writer.EndContainer(data));
+        ReturnErrorOnFailure(writer.EndContainer(reportIB));
+        // Elements, counting the end of each container.
+        elements += 13;
+    }
+    ReturnErrorOnFailure(writer.EndContainer(reports));
+    ReturnErrorOnFailure(writer.Put(ContextTag(255), static_cast<uint8_t>(1)));
+    ReturnErrorOnFailure(writer.EndContainer(report));
+    elements += 5;
+    return writer.Finalize();
+}
+
+// Reads every element of the container the reader is positioned on, recursively.
+CHIP_ERROR ReadContainer(TLVReader & reader, uint64_t & sum)
+{
+    TLVType outer;
+    CHIP_ERROR err;
+
+    ReturnErrorOnFailure(reader.EnterContainer(outer));
+    while ((err = reader.Next()) == CHIP_NO_ERROR)
+    {
+        switch (reader.GetType())
+        {
+        case kTLVType_Structure:
+        case kTLVType_Array:
+        case kTLVType_List:
+            ReturnErrorOnFailure(ReadContainer(reader, sum));
+            break;
+        case kTLVType_UnsignedInteger: {
+            uint32_t value;
+            ReturnErrorOnFailure(reader.Get(value));
+            sum += value;
+            break;
+        }
+        case kTLVType_Boolean: {
+            bool value;
+            ReturnErrorOnFailure(reader.Get(value));
+            sum += value;
+            break;
+        }
+        case kTLVType_UTF8String: {
+            CharSpan value;
+            ReturnErrorOnFailure(reader.Get(value));
+            sum += value.size();
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+    return reader.ExitContainer(outer);
+}
+
+// Steps over the reports without entering them, as parsers looking for a given field do.
+CHIP_ERROR SkipReports(TLVReader & reader, uint64_t & sum)
+{
+    TLVType report, reports;
+    CHIP_ERROR err;
+
+    ReturnErrorOnFailure(reader.EnterContainer(report));
+    ReturnErrorOnFailure(reader.Next(kTLVType_Array, ContextTag(1)));
+    ReturnErrorOnFailure(reader.EnterContainer(reports));
+    while ((err = reader.Next()) == CHIP_NO_ERROR)
+    {
+        sum++;
+    }
+    VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+    ReturnErrorOnFailure(reader.ExitContainer(reports));
+    return reader.ExitContainer(report);
+}
+
+// Looks up the fields of the report as ReportDataMessage::Parser does: a walk over the fields to check
+// their order, then a walk from the start of the report for each field.
+CHIP_ERROR LookUpFields(TLVReader & reader, uint64_t & sum)
+{
+    const uint8_t kFields[] = { 4, 0, 3, 2, 1, 255 };
+    TLVType report;
+    CHIP_ERROR err;
+
+    ReturnErrorOnFailure(reader.EnterContainer(report));
+
+    TLVReader fields(reader);
+    while ((err = fields.Next()) == CHIP_NO_ERROR)
+    {
+        sum++;
+    }
+    VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+
+    for (uint8_t field : kFields)
+    {
+        TLVReader fieldReader;
+        err = reader.FindElementWithTag(ContextTag(field), fieldReader);
+        VerifyOrReturnError(err == CHIP_NO_ERROR || err == CHIP_END_OF_TLV, err);
+        sum += (err == CHIP_NO_ERROR) ? 1 : 0;
+    }
+    return CHIP_NO_ERROR;
+}
+
+template <typename Function>
+void Report(const char * name, size_t iterations, size_t elements, uint32_t length, Function function)
+{
+    uint64_t sum     = 0;
+    CHIP_ERROR err   = CHIP_NO_ERROR;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations && err == CHIP_NO_ERROR; i++)
+    {
+        err = function(sum);
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    if (err != CHIP_NO_ERROR)
+    {
+        printf("%-40s failed: %" CHIP_ERROR_FORMAT "\n", name, err.Format());
+        return;
+    }
+    const double total = static_cast<double>(iterations);
+    printf("%-40s %8.1f ns per element %8.1f MB/s (check %llu)\n", name, elapsed.count() * 1e9 / (total * elements),
+           total * length / elapsed.count() / 1e6, static_cast<unsigned long long>(sum));
+}
+
+} // namespace
+
+int main(int argc, char * argv[])
+{
+    const size_t iterations = (argc > 1) ? strtoul(argv[1], nullptr, 0) : kDefaultIterations;
+
+    if (iterations == 0)
+    {
+        fprintf(stderr, "Usage: %s [iterations]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::vector<uint8_t> buffer(kBufferSize);
+    size_t elements = 0;
+    TLVWriter writer;
+    writer.Init(buffer.data(), buffer.size());
+    if (WriteReport(writer, elements) != CHIP_NO_ERROR)
+    {
+        fprintf(stderr, "Failed to encode the report\n");
+        return EXIT_FAILURE;
+    }
+    const uint32_t length = writer.GetLengthWritten();
+    printf("Report of %u bytes, %u elements\n", static_cast<unsigned>(length), static_cast<unsigned>(elements));
+
+    std::vector<uint8_t> output(kBufferSize);
+    SingleBufferBackingStore store(output.data(), static_cast<uint32_t>(output.size()));
+
+    Report("Encode, contiguous buffer", iterations, elements, length, [&](uint64_t & sum) {
+        TLVWriter w;
+        size_t count;
+        w.Init(output.data(), output.size());
+        ReturnErrorOnFailure(WriteReport(w, count));
+        sum += w.GetLengthWritten();
+        return CHIP_NO_ERROR;
+    });
+
+    Report("Encode, backing store", iterations, elements, length, [&](uint64_t & sum) {
+        TLVWriter w;
+        size_t count;
+        w.Init(store);
+        ReturnErrorOnFailure(WriteReport(w, count));
+        sum += w.GetLengthWritten();
+        return CHIP_NO_ERROR;
+    });
+
+    Report("Decode all elements, contiguous buffer", iterations, elements, length, [&](uint64_t & sum) {
+        ContiguousBufferTLVReader reader;
+        reader.Init(buffer.data(), length);
+        ReturnErrorOnFailure(reader.Next());
+        return ReadContainer(reader, sum);
+    });
+
+    SingleBufferBackingStore inputStore(buffer.data(), length);
+    Report("Decode all elements, backing store", iterations, elements, length, [&](uint64_t & sum) {
+        TLVReader reader;
+        ReturnErrorOnFailure(reader.Init(inputStore));
+        ReturnErrorOnFailure(reader.Next());
+        return ReadContainer(reader, sum);
+    });
+
+    Report("Skip reports, contiguous buffer", iterations, elements, length, [&](uint64_t & sum) {
+        ContiguousBufferTLVReader reader;
+        reader.Init(buffer.data(), length);
+        ReturnErrorOnFailure(reader.Next());
+        return SkipReports(reader, sum);
+    });
+
+    Report("Look up report fields", iterations, elements, length, [&](uint64_t & sum) {
+        ContiguousBufferTLVReader reader;
+        reader.Init(buffer.data(), length);
+        ReturnErrorOnFailure(reader.Next());
+        return LookUpFields(reader, sum);
+    });
+
+    TLVIndex::Entry entries[kIndexEntries];
+    Report("Look up report fields, building an index", iterations, elements, length, [&](uint64_t & sum) {
+        ContiguousBufferTLVReader reader;
+        TLVIndex index{ Span<TLVIndex::Entry>(entries) };
+        reader.Init(buffer.data(), length);
+        ReturnErrorOnFailure(index.Build(reader));
+        reader.SetIndex(&index);
+        ReturnErrorOnFailure(reader.Next());
+        return LookUpFields(reader, sum);
+    });
+
+    return EXIT_SUCCESS;
+}
@@ -31,6 +31,7 @@
 #include <lib/core/TLVCircularBuffer.h>
 #include <lib/core/TLVData.h>
 #include <lib/core/TLVDebug.h>
+#include <lib/core/TLVIndex.h>
 #include <lib/core/TLVUtilities.h>
 
 #include <lib/support/CHIPMem.h>
@@ -2460,6 +2461,68 @@ void CheckCircularTLVBufferEvictStraddlingEvent(nlTestSuite * inSuite, void * in
     TestEnd<TLVReader>(inSuite, reader);
 }
 
+void CheckCircularTLVBufferMoveHead(nlTestSuite * inSuite, void * inContext)
+{
+    CHIP_ERROR err;
+    uint8_t backingStore[20];
+    uint8_t backingStore1[14];
+    uint8_t backingStore2[7];
+    CircularTLVWriter writer;
+    CircularTLVReader reader;
+
+    // Start both buffers midway, so the elements straddle the end of the backing store on both sides of the move.
+    TLVCircularBuffer buffer(backingStore, sizeof(backingStore), &(backingStore[15]));
+    TLVCircularBuffer buffer1(backingStore1, sizeof(backingStore1), &(backingStore1[10]));
+    TLVCircularBuffer buffer2(backingStore2, sizeof(backingStore2));
+
+    writer.Init(buffer);
+    writer.ImplicitProfileId = TestProfile_2;
+
+    err = writer.PutBoolean(ProfileTag(TestProfile_1, 2), true);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = writer.PutBoolean(ProfileTag(TestProfile_1, 2), false);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = writer.Finalize();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, buffer.DataLength() == 14);
+
+    // Moving or discarding more than the buffer holds must fail and leave it untouched.
+    NL_TEST_ASSERT(inSuite, buffer.DiscardHead(15) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, buffer.MoveHeadTo(buffer1, 15) == CHIP_ERROR_INVALID_ARGUMENT);
+
+    // The destination must have room for the whole move, nothing is evicted from it.
+    NL_TEST_ASSERT(inSuite, buffer.MoveHeadTo(buffer2, 14) == CHIP_ERROR_NO_MEMORY);
+    NL_TEST_ASSERT(inSuite, buffer.DataLength() == 14 && buffer2.DataLength() == 0);
+
+    err = buffer.MoveHeadTo(buffer1, 14);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, buffer.DataLength() == 0);
+    NL_TEST_ASSERT(inSuite, buffer1.DataLength() == 14);
+
+    reader.Init(buffer1);
+    reader.ImplicitProfileId = TestProfile_2;
+
+    TestNext<TLVReader>(inSuite, reader);
+    TEST_GET_NOERROR(inSuite, reader, kTLVType_Boolean, ProfileTag(TestProfile_1, 2), true);
+    TestNext<TLVReader>(inSuite, reader);
+    TEST_GET_NOERROR(inSuite, reader, kTLVType_Boolean, ProfileTag(TestProfile_1, 2), false);
+    TestEnd<TLVReader>(inSuite, reader);
+
+    // Drop the first element by length, the second one must still be readable.
+    err = buffer1.DiscardHead(7);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, buffer1.DataLength() == 7);
+
+    reader.Init(buffer1);
+    reader.ImplicitProfileId = TestProfile_2;
+
+    TestNext<TLVReader>(inSuite, reader);
+    TEST_GET_NOERROR(inSuite, reader, kTLVType_Boolean, ProfileTag(TestProfile_1, 2), false);
+    TestEnd<TLVReader>(inSuite, reader);
+}
+
 void CheckCircularTLVBufferEdge(nlTestSuite * inSuite, void * inContext)
 {
     TestTLVContext * context = static_cast<TestTLVContext *>(inContext);
@@ -4483,6 +4546,93 @@ static void CheckTLVScopedBuffer(nlTestSuite * inSuite, void * inContext)
     }
 }
 
+static void CheckTLVIndex(nlTestSuite * inSuite, void * inContext)
+{
+    uint8_t buf[64];
+    TLVWriter writer;
+    TLVType outer, array, inner;
+    uint32_t length;
+
+    // { 1 = [ { 0 = 1 }, { 0 = 2 }, [ 3 ] ], 2 = 255 }
+    writer.Init(buf);
+    NL_TEST_ASSERT_SUCCESS(inSuite, writer.StartContainer(AnonymousTag(), kTLVType_Structure, outer));
+    NL_TEST_ASSERT_SUCCESS(inSuite, writer.StartContainer(ContextTag(1), kTLVType_Array, array));
+    for (uint8_t i = 1; i <= 2; i++)
+    {
+        NL_TEST_ASSERT_SUCCESS(inSuite, writer.StartContainer(AnonymousTag(), kTLVType_Structure, inner));
+        NL_TEST_ASSERT_SUCCESS(inSuite, writer.Put(ContextTag(0), i));
+        NL_TEST_ASSERT_SUCCESS(inSuite, writer.EndContainer(inner));
+    }
+    NL_TEST_ASSERT_SUCCESS(inSuite, writer.StartContainer(AnonymousTag(), kTLVType_List, inner));
+    NL_TEST_ASSERT_SUCCESS(inSuite, writer.Put(AnonymousTag(), static_cast<uint8_t>(3)));
+    NL_TEST_ASSERT_SUCCESS(inSuite, writer.EndContainer(inner));
+    NL_TEST_ASSERT_SUCCESS(inSuite, writer.EndContainer(array));
+    NL_TEST_ASSERT_SUCCESS(inSuite, writer.Put(ContextTag(2), static_cast<uint8_t>(255)));
+    NL_TEST_ASSERT_SUCCESS(inSuite, writer.EndContainer(outer));
+    NL_TEST_ASSERT_SUCCESS(inSuite, writer.Finalize());
+    length = writer.GetLengthWritten();
+
+    auto checkLookUp = [&](const TLVIndex * index) {
+        ContiguousBufferTLVReader reader;
+        TLVReader field;
+        size_t count;
+        uint8_t value;
+
+        reader.Init(buf, length);
+        reader.SetIndex(index);
+        NL_TEST_ASSERT_SUCCESS(inSuite, reader.Next(kTLVType_Structure, AnonymousTag()));
+        NL_TEST_ASSERT_SUCCESS(inSuite, reader.EnterContainer(outer));
+        NL_TEST_ASSERT_SUCCESS(inSuite, reader.CountRemainingInContainer(&count));
+        NL_TEST_ASSERT(inSuite, count == 2);
+        NL_TEST_ASSERT_SUCCESS(inSuite, reader.FindElementWithTag(ContextTag(2), field));
+        NL_TEST_ASSERT_SUCCESS(inSuite, field.Get(value));
+        NL_TEST_ASSERT(inSuite, value == 255);
+        NL_TEST_ASSERT_SUCCESS(inSuite, reader.ExitContainer(outer));
+        NL_TEST_ASSERT(inSuite, reader.Next() == CHIP_END_OF_TLV);
+    };
+
+    ContiguousBufferTLVReader reader;
+    reader.Init(buf, length);
+
+    // All the containers are indexed.
+    TLVIndex::Entry entries[8];
+    TLVIndex index{ Span<TLVIndex::Entry>(entries) };
+    NL_TEST_ASSERT_SUCCESS(inSuite, index.Build(reader));
+    NL_TEST_ASSERT(inSuite, index.GetCount() == 5);
+    checkLookUp(nullptr);
+    checkLookUp(&index);
+
+    // Containers beyond the capacity of the entries are read element by element.
+    TLVIndex::Entry fewEntries[2];
+    TLVIndex smallIndex{ Span<TLVIndex::Entry>(fewEntries) };
+    NL_TEST_ASSERT_SUCCESS(inSuite, smallIndex.Build(reader));
+    NL_TEST_ASSERT(inSuite, smallIndex.GetCount() == 2);
+    checkLookUp(&smallIndex);
+
+    // A malformed encoding is not indexed.
+    ContiguousBufferTLVReader truncatedReader;
+    truncatedReader.Init(buf, length - 1);
+    NL_TEST_ASSERT(inSuite, index.Build(truncatedReader) != CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, index.GetCount() == 0);
+    checkLookUp(&index);
+
+    // The elements of indexed containers are not read again: corrupting the first element of the array
+    // only fails the lookup without the index.
+    NL_TEST_ASSERT_SUCCESS(inSuite, index.Build(reader));
+    NL_TEST_ASSERT_SUCCESS(inSuite, reader.Next());
+    NL_TEST_ASSERT_SUCCESS(inSuite, reader.EnterContainer(outer));
+    NL_TEST_ASSERT_SUCCESS(inSuite, reader.Next(kTLVType_Array, ContextTag(1)));
+    NL_TEST_ASSERT_SUCCESS(inSuite, reader.EnterContainer(array));
+    buf[reader.GetReadPoint() - buf] = 0xFF;
+    checkLookUp(&index);
+
+    reader.Init(buf, length);
+    NL_TEST_ASSERT_SUCCESS(inSuite, reader.Next());
+    NL_TEST_ASSERT_SUCCESS(inSuite, reader.EnterContainer(outer));
+    TLVReader field;
+    NL_TEST_ASSERT(inSuite, reader.FindElementWithTag(ContextTag(2), field) != CHIP_NO_ERROR);
+}
+
 // Test Suite
 
 /**
@@ -4508,6 +4658,7 @@ static const nlTest sTests[] =
     NL_TEST_DEF("CHIP Circular TLV buffer, mid-buffer start", CheckCircularTLVBufferStartMidway),
     NL_TEST_DEF("CHIP Circular TLV buffer, straddle",  CheckCircularTLVBufferEvictStraddlingEvent),
     NL_TEST_DEF("CHIP Circular TLV buffer, edge",      CheckCircularTLVBufferEdge),
+    NL_TEST_DEF("CHIP Circular TLV buffer, move head", CheckCircularTLVBufferMoveHead),
     NL_TEST_DEF("CHIP TLV Printf",                     CheckTLVPutStringF),
     NL_TEST_DEF("CHIP TLV String Span",                CheckTLVPutStringSpan),
     NL_TEST_DEF("CHIP TLV Printf, Circular TLV buf",   CheckTLVPutStringFCircular),
@@ -4519,6 +4670,7 @@ static const nlTest sTests[] =
     NL_TEST_DEF("CHIP TLV Reader Fuzz Test",           TLVReaderFuzzTest),
     NL_TEST_DEF("CHIP TLV GetStringView Test",         CheckGetStringView),
     NL_TEST_DEF("CHIP TLV GetByteView Test",           CheckGetByteView),
+    NL_TEST_DEF("CHIP TLV Index",                      CheckTLVIndex),
     NL_TEST_DEF("Int Min/Max Test",                    TestIntMinMax),
 
     NL_TEST_SENTINEL()
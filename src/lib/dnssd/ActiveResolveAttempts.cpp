@@ -268,7 +268,20 @@ bool ActiveResolveAttempts::IsWaitingForIpResolutionFor(SerializedQNameIterator
             continue;
         }
 
-        if (hostName == entry.attempt.IpResolveData().hostName.Content())
+        if (hostName == entry.attempt.IpResolveData().hostName.Get())
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool ActiveResolveAttempts::IsPending(const ScheduledAttempt & attempt) const
+{
+    for (auto & entry : mRetryQueue)
+    {
+        if (!entry.attempt.IsEmpty() && entry.attempt.Matches(attempt))
         {
             return true;
         }
@@ -22,8 +22,9 @@
 
 #include <lib/core/Optional.h>
 #include <lib/core/PeerId.h>
+#include <lib/dnssd/IncrementalResolve.h>
 #include <lib/dnssd/Resolver.h>
-#include <lib/dnssd/minimal_mdns/core/HeapQName.h>
+#include <lib/dnssd/minimal_mdns/core/QName.h>
 #include <lib/support/Variant.h>
 #include <system/SystemClock.h>
 
@@ -65,13 +66,12 @@ public:
 
         struct IpResolve
         {
-            HeapQName hostName;
-            IpResolve(HeapQName && host) : hostName(std::move(host)) {}
+            chip::Dnssd::StoredServerName hostName;
         };
 
         ScheduledAttempt()
         {
-            static_assert(sizeof(Resolve) <= sizeof(Browse) || sizeof(Resolve) <= sizeof(HeapQName),
+            static_assert(sizeof(Resolve) <= sizeof(Browse) || sizeof(Resolve) <= sizeof(IpResolve),
                           "Figure out where to put the Resolve counter so that Resolve is not making ScheduledAttempt bigger than "
                           "it has to be anyway to handle the other attempt types.");
         }
@@ -127,14 +127,14 @@ public:
                 auto & a = resolveData.Get<IpResolve>();
                 auto & b = other.resolveData.Get<IpResolve>();
 
-                return a.hostName == b.hostName;
+                return a.hostName.Get() == b.hostName.Get();
             }
             return false;
         }
 
         bool MatchesIpResolve(SerializedQNameIterator hostName) const
         {
-            return resolveData.Is<IpResolve>() && (hostName == resolveData.Get<IpResolve>().hostName.Content());
+            return resolveData.Is<IpResolve>() && (hostName == resolveData.Get<IpResolve>().hostName.Get());
         }
         bool Matches(const chip::PeerId & peer) const
         {
@@ -289,6 +289,10 @@ public:
     /// IP resolution.
     bool IsWaitingForIpResolutionFor(SerializedQNameIterator hostName) const;
 
+    /// Check if a resolution matching the given attempt is still pending,
+    /// regardless of when it is scheduled to be sent next.
+    bool IsPending(const ScheduledAttempt & attempt) const;
+
 private:
     struct RetryEntry
     {
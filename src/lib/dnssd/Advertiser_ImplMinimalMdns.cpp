@@ -26,6 +26,7 @@
 #include <crypto/RandUtils.h>
 #include <lib/dnssd/Advertiser_ImplMinimalMdnsAllocator.h>
 #include <lib/dnssd/minimal_mdns/AddressPolicy.h>
+#include <lib/dnssd/minimal_mdns/PacketIndex.h>
 #include <lib/dnssd/minimal_mdns/ResponseSender.h>
 #include <lib/dnssd/minimal_mdns/Server.h>
 #include <lib/dnssd/minimal_mdns/core/FlatAllocatedQName.h>
@@ -156,8 +157,7 @@ enum BroadcastAdvertiseType
 };
 
 class AdvertiserMinMdns : public ServiceAdvertiser,
-                          public MdnsPacketDelegate, // receive query packets
-                          public ParserDelegate      // parses queries
+                          public MdnsPacketDelegate // receive query packets
 {
 public:
     AdvertiserMinMdns() : mResponseSender(&GlobalMinimalMdnsServer::Server())
@@ -192,12 +192,9 @@ public:
     // MdnsPacketDelegate
     void OnMdnsPacketData(const BytesRange & data, const chip::Inet::IPPacketInfo * info) override;
 
-    // ParserDelegate
-    void OnHeader(ConstHeaderRef & header) override { mMessageId = header.GetMessageId(); }
-    void OnResource(ResourceType type, const ResourceData & data) override {}
-    void OnQuery(const QueryData & data) override;
-
 private:
+    void OnQuery(const QueryData & data);
+
     /// Advertise available records configured within the server.
     ///
     /// Establishes a type of 'Advertise all currently configured items'
@@ -291,6 +288,7 @@ private:
     // current request handling
     const chip::Inet::IPPacketInfo * mCurrentSource = nullptr;
     uint32_t mMessageId                             = 0;
+    PacketIndex mPacketIndex;
 
     const char * mEmptyTextEntries[1] = {
         "=",
@@ -306,7 +304,25 @@ void AdvertiserMinMdns::OnMdnsPacketData(const BytesRange & data, const chip::In
 #endif
 
     mCurrentSource = info;
-    if (!ParsePacket(data, this))
+
+    // Only the queries are of interest: packets with more entries than the index holds
+    // are indexed again until all their queries have been answered.
+    bool valid = mPacketIndex.Index(data);
+    if (mPacketIndex.HasHeader())
+    {
+        mMessageId = mPacketIndex.GetHeader().GetMessageId();
+    }
+    while (true)
+    {
+        mPacketIndex.ForEachQuery([this](const QueryData & query) { OnQuery(query); });
+        if (!valid || !mPacketIndex.IsTruncated() || (mPacketIndex.GetNextEntry() >= mPacketIndex.GetHeader().GetQueryCount()))
+        {
+            break;
+        }
+        valid = mPacketIndex.Index(data, mPacketIndex.GetNextEntry());
+    }
+
+    if (!valid)
     {
         ChipLogError(Discovery, "Failed to parse mDNS query");
     }
@@ -348,6 +364,9 @@ CHIP_ERROR AdvertiserMinMdns::Init(chip::Inet::EndPointManager<chip::Inet::UDPEn
     // GlobalMinimalMdnsServer (used for testing).
     mResponseSender.SetServer(&GlobalMinimalMdnsServer::Server());
 
+    // Interfaces may have changed, and with them the addresses in cached replies
+    mResponseSender.InvalidateResponseCache();
+
     ReturnErrorOnFailure(GlobalMinimalMdnsServer::Instance().StartServer(udpEndPointManager, kMdnsPort));
 
     ChipLogProgress(Discovery, "CHIP minimal mDNS started advertising.");
@@ -409,9 +428,13 @@ void AdvertiserMinMdns::ClearServices()
 
 OperationalQueryAllocator::Allocator * AdvertiserMinMdns::FindOperationalAllocator(const FullQName & qname)
 {
+    // The response sender indexes all records, new instance names are not searched for
+    QueryResponderBase * responder = mResponseSender.FindQueryResponder(QType::SRV, qname);
+    VerifyOrReturnValue(responder != nullptr, nullptr);
+
     for (auto & it : mOperationalResponders)
     {
-        if (it.GetAllocator()->GetResponder(QType::SRV, qname) != nullptr)
+        if (it.GetAllocator()->GetQueryResponder() == responder)
         {
             return it.GetAllocator();
         }
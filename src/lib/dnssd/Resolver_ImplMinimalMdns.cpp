@@ -26,13 +26,18 @@
 #include <lib/dnssd/ResolverProxy.h>
 #include <lib/dnssd/ServiceNaming.h>
 #include <lib/dnssd/minimal_mdns/Logging.h>
+#include <lib/dnssd/minimal_mdns/PacketIndex.h>
 #include <lib/dnssd/minimal_mdns/Parser.h>
 #include <lib/dnssd/minimal_mdns/QueryBuilder.h>
+#include <lib/dnssd/minimal_mdns/RecordCache.h>
 #include <lib/dnssd/minimal_mdns/RecordData.h>
 #include <lib/dnssd/minimal_mdns/core/FlatAllocatedQName.h>
 #include <lib/support/CHIPMemString.h>
+#include <lib/support/Iterators.h>
 #include <lib/support/logging/CHIPLogging.h>
 
+#include <strings.h>
+
 // MDNS servers will receive all broadcast packets over the network.
 // Disable 'invalid packet' messages because the are expected and common
 // These logs are useful for debug only
@@ -47,117 +52,140 @@ constexpr uint16_t kMdnsPort        = 5353;
 
 using namespace mdns::Minimal;
 
+#if CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+/// Checks if a name is within one of the Matter services (_matter._tcp, _matterc._udp
+/// and _matterd._udp), including their subtypes and service instances.
+bool IsMatterServiceName(SerializedQNameIterator name)
+{
+    size_t labelCount           = 0;
+    SerializedQNameIterator end = name;
+    while (end.Next())
+    {
+        labelCount++;
+    }
+    VerifyOrReturnValue(end.IsValid() && (labelCount >= 3), false);
+
+    for (size_t i = 0; i < labelCount - 3; i++)
+    {
+        name.Next();
+    }
+
+    VerifyOrReturnValue(name.Next(), false);
+    const bool operational   = (strcasecmp(name.Value(), kOperationalServiceName) == 0);
+    const bool commissioning = (strcasecmp(name.Value(), kCommissionableServiceName) == 0) ||
+        (strcasecmp(name.Value(), kCommissionerServiceName) == 0);
+    VerifyOrReturnValue(operational || commissioning, false);
+
+    VerifyOrReturnValue(name.Next() && (strcasecmp(name.Value(), operational ? kOperationalProtocol : kCommissionProtocol) == 0),
+                        false);
+    return name.Next() && (strcasecmp(name.Value(), kLocalDomain) == 0);
+}
+#endif // CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+
 /// Handles processing of minmdns packet data.
 ///
 /// Can process multiple incremental resolves based on SRV data and allows
 /// retrieval of pending (e.g. to ask for AAAA) and complete data items.
 ///
-class PacketParser : private ParserDelegate
+class PacketParser
 {
 public:
     PacketParser(ActiveResolveAttempts & activeResolves) : mActiveResolves(activeResolves) {}
 
-    /// Goes through the given SRV records within a response packet
-    /// and sets up data resolution
-    void ParseSrvRecords(const BytesRange & packet);
-
-    /// Goes through non-SRV records and feeds them through the initialized
-    /// SRV record parsing.
+    /// Goes through the SRV records within a response packet and sets up data
+    /// resolution, then feeds the non-SRV records through the initialized SRV
+    /// record parsing.
     ///
-    /// Must be called AFTER ParseSrvRecords has been called.
-    void ParseNonSrvRecords(Inet::InterfaceId interface, const BytesRange & packet);
+    /// The packet is indexed once and both steps walk the index.
+    void ParseRecords(Inet::InterfaceId interface, const BytesRange & packet);
 
     IncrementalResolver * ResolverBegin() { return mResolvers; }
     IncrementalResolver * ResolverEnd() { return mResolvers + kMinMdnsNumParallelResolvers; }
 
+#if CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+    /// Feeds the cached records of the given service instance through the
+    /// resolvers, as if they had just been received.
+    template <typename Name>
+    void ParseCachedRecords(const Name & instanceName, System::Clock::Timestamp now)
+    {
+        mRecordCache.ForEachRecord(now, [&](const RecordCacheBase::CachedRecord & record) {
+            if ((record.data.GetType() == QType::SRV) && (record.data.GetName() == instanceName))
+            {
+                mPacketRange = record.range;
+                ParseSRVResource(record.data);
+            }
+            return Loop::Continue;
+        });
+
+        mRecordCache.ForEachRecord(now, [&](const RecordCacheBase::CachedRecord & record) {
+            mPacketRange = record.range;
+            mInterfaceId = record.interface;
+            ParseResource(record.data);
+            return Loop::Continue;
+        });
+    }
+
+    RecordCacheBase & GetRecordCache() { return mRecordCache; }
+#endif // CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+
 private:
-    // ParserDelegate implementation
-    void OnHeader(ConstHeaderRef & header) override;
-    void OnQuery(const QueryData & data) override;
-    void OnResource(ResourceType type, const ResourceData & data) override;
+    /// Call function(ResourceType, const ResourceData &) for all the resource records
+    /// of the indexed packet. Packets that do not fit in the index are indexed again,
+    /// one window of records at a time.
+    ///
+    /// Returns false if the packet is malformed.
+    template <typename Function>
+    bool ForEachIndexedResource(Function && function)
+    {
+        if (mPacketIndex.GetFirstEntry() != 0)
+        {
+            mPacketIndex.Index(mPacketRange);
+        }
 
-    /// Called IFF data is of SRV type and we are in SRV initialization state
+        while (true)
+        {
+            mPacketIndex.ForEachResource(function);
+            if (!mPacketIndex.IsValid() || !mPacketIndex.IsTruncated())
+            {
+                return mPacketIndex.IsValid();
+            }
+            mPacketIndex.Index(mPacketRange, mPacketIndex.GetNextEntry());
+        }
+    }
+
+    /// Called for SRV records, before any other record of the packet
     ///
     /// Initializes a resolver with the given SRV content as long as
     /// inactive resolvers exist.
     void ParseSRVResource(const ResourceData & data);
 
-    /// Called IFF parsing state is in RecordParsing
+    /// Called for all records, once the SRV records have been parsed
     ///
     /// Forwards the resource to all active resolvers.
     void ParseResource(const ResourceData & data);
 
-    enum class RecordParsingState
-    {
-        kIdle,
-        kSrvInitialization,
-        kRecordParsing,
-    };
+#if CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+    /// Keeps the Matter service records and the addresses of their hosts
+    void CacheRecord(const ResourceData & data);
+    bool IsCachedSrvTarget(SerializedQNameIterator hostName);
+#endif
 
     static constexpr size_t kMinMdnsNumParallelResolvers = CHIP_CONFIG_MINMDNS_MAX_PARALLEL_RESOLVES;
 
     // Individual parse set
-    bool mIsResponse               = false;
     Inet::InterfaceId mInterfaceId = Inet::InterfaceId::Null();
     BytesRange mPacketRange;
-    RecordParsingState mParsingState = RecordParsingState::kIdle;
+    PacketIndex mPacketIndex;
 
     // resolvers kept between parse steps
     ActiveResolveAttempts & mActiveResolves;
     IncrementalResolver mResolvers[kMinMdnsNumParallelResolvers];
-};
-
-void PacketParser::OnHeader(ConstHeaderRef & header)
-{
-    mIsResponse = header.GetFlags().IsResponse();
 
-#ifdef MINMDNS_RESOLVER_OVERLY_VERBOSE
-    if (header.GetFlags().IsTruncated())
-    {
-        // MinMdns does not cache data, so receiving piecewise data does not work
-        ChipLogError(Discovery, "Truncated responses not supported for address resolution");
-    }
+#if CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+    System::Clock::Timestamp mReceivedTime = System::Clock::kZero;
+    RecordCache<CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE> mRecordCache;
 #endif
-}
-
-void PacketParser::OnQuery(const QueryData & data)
-{
-    // Ignore queries:
-    //   - unicast answers will include the corresponding query in the answer
-    //     packet, however that is not interesting for the resolver.
-}
-
-void PacketParser::OnResource(ResourceType type, const ResourceData & data)
-{
-    if (!mIsResponse)
-    {
-        return;
-    }
-
-    switch (mParsingState)
-    {
-    case RecordParsingState::kSrvInitialization: {
-        if (data.GetType() != QType::SRV)
-        {
-            return;
-        }
-        mdns::Minimal::Logging::LogReceivedResource(data);
-        ParseSRVResource(data);
-        break;
-    }
-    case RecordParsingState::kRecordParsing:
-        if (data.GetType() != QType::SRV)
-        {
-            // SRV packets logged during 'SrvInitialization' phase
-            mdns::Minimal::Logging::LogReceivedResource(data);
-        }
-        ParseResource(data);
-        break;
-    case RecordParsingState::kIdle:
-        ChipLogError(Discovery, "Illegal state: received DNSSD resource while IDLE");
-        break;
-    }
-}
+};
 
 void PacketParser::ParseResource(const ResourceData & data)
 {
@@ -235,31 +263,90 @@ void PacketParser::ParseSRVResource(const ResourceData & data)
 #endif
 }
 
-void PacketParser::ParseSrvRecords(const BytesRange & packet)
+#if CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+void PacketParser::CacheRecord(const ResourceData & data)
 {
-    mParsingState = RecordParsingState::kSrvInitialization;
-    mPacketRange  = packet;
-
-    if (!ParsePacket(packet, this))
+    switch (data.GetType())
     {
-        ChipLogError(Discovery, "DNSSD packet parsing failed (for SRV records)");
+    case QType::PTR:
+    case QType::SRV:
+    case QType::TXT:
+        VerifyOrReturn(IsMatterServiceName(data.GetName()));
+        break;
+    case QType::A:
+    case QType::AAAA:
+        // SRV records come first, so the SRV of the same packet is already cached
+        VerifyOrReturn(IsCachedSrvTarget(data.GetName()));
+        break;
+    default:
+        return;
     }
 
-    mParsingState = RecordParsingState::kIdle;
+    // Records that cannot be cached (e.g. too large) are still used as received
+    (void) mRecordCache.Add(mInterfaceId, data, mPacketRange, mReceivedTime);
 }
 
-void PacketParser::ParseNonSrvRecords(Inet::InterfaceId interface, const BytesRange & packet)
+bool PacketParser::IsCachedSrvTarget(SerializedQNameIterator hostName)
 {
-    mParsingState = RecordParsingState::kRecordParsing;
-    mPacketRange  = packet;
-    mInterfaceId  = interface;
+    return mRecordCache.ForEachRecord(mReceivedTime, [&](const RecordCacheBase::CachedRecord & record) {
+        SrvRecord srv;
+        if ((record.data.GetType() == QType::SRV) && srv.Parse(record.data.GetData(), record.range) && (srv.GetName() == hostName))
+        {
+            return Loop::Break;
+        }
+        return Loop::Continue;
+    }) == Loop::Break;
+}
+#endif // CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+
+void PacketParser::ParseRecords(Inet::InterfaceId interface, const BytesRange & packet)
+{
+    mPacketRange = packet;
+    mInterfaceId = interface;
+#if CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+    mReceivedTime = System::SystemClock().GetMonotonicTimestamp();
+#endif
+
+    bool valid = mPacketIndex.Index(packet);
 
-    if (!ParsePacket(packet, this))
+    // Queries are ignored: unicast answers include the corresponding query in the
+    // answer packet, however that is not interesting for the resolver.
+    if (mPacketIndex.HasHeader() && mPacketIndex.GetHeader().GetFlags().IsResponse())
     {
-        ChipLogError(Discovery, "DNSSD packet parsing failed (for non-srv records)");
+#ifdef MINMDNS_RESOLVER_OVERLY_VERBOSE
+        if (mPacketIndex.GetHeader().GetFlags().IsTruncated())
+        {
+            // MinMdns does not cache data, so receiving piecewise data does not work
+            ChipLogError(Discovery, "Truncated responses not supported for address resolution");
+        }
+#endif
+
+        valid = ForEachIndexedResource([this](ResourceType, const ResourceData & data) {
+            VerifyOrReturn(data.GetType() == QType::SRV);
+            mdns::Minimal::Logging::LogReceivedResource(data);
+#if CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+            CacheRecord(data);
+#endif
+            ParseSRVResource(data);
+        });
+
+        ForEachIndexedResource([this](ResourceType, const ResourceData & data) {
+            if (data.GetType() != QType::SRV)
+            {
+                // SRV records logged and cached along with the SRV record parsing
+                mdns::Minimal::Logging::LogReceivedResource(data);
+#if CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+                CacheRecord(data);
+#endif
+            }
+            ParseResource(data);
+        });
     }
 
-    mParsingState = RecordParsingState::kIdle;
+    if (!valid)
+    {
+        ChipLogError(Discovery, "DNSSD packet parsing failed");
+    }
 }
 
 class MinMdnsResolver : public Resolver, public MdnsPacketDelegate
@@ -297,9 +384,35 @@ private:
     CHIP_ERROR SendAllPendingQueries();
     CHIP_ERROR ScheduleRetries();
 
+    /// Send the pending queries on the next event loop iteration, so that
+    /// the queries asked for in the meantime are sent along. Errors met
+    /// sending them are logged.
+    CHIP_ERROR ScheduleSendPendingQueries();
+
+    /// Allocate the packet of a new query
+    CHIP_ERROR StartQuery(QueryBuilder & builder);
+
+    /// Send a query packet and release it from the builder
+    CHIP_ERROR SendQuery(QueryBuilder & builder, bool unicastAnswers);
+
+#if CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+    /// Resolve a resolve or browse attempt from the cached records.
+    ///
+    /// Returns true if the attempt is complete and no query has to be sent.
+    bool ResolveFromCache(const ActiveResolveAttempts::ScheduledAttempt & attempt);
+
+    /// Add the cached records that answer the queries of the builder as known answers
+    void AddKnownAnswers(QueryBuilder & builder);
+#endif
+
     /// Prepare a query for the given schedule attempt
+    ///
+    /// Returns CHIP_ERROR_BUFFER_TOO_SMALL if the query does not fit in the packet.
     CHIP_ERROR BuildQuery(QueryBuilder & builder, const ActiveResolveAttempts::ScheduledAttempt & attempt);
 
+    /// Get the name queried for a browse, allocated in qnameStorage
+    CHIP_ERROR BuildBrowseQName(const ActiveResolveAttempts::ScheduledAttempt::Browse & data, mdns::Minimal::FullQName & qname);
+
     /// Prepare a query for specific resolve types
     CHIP_ERROR BuildQuery(QueryBuilder & builder, const ActiveResolveAttempts::ScheduledAttempt::Browse & data, bool firstSend);
     CHIP_ERROR BuildQuery(QueryBuilder & builder, const ActiveResolveAttempts::ScheduledAttempt::Resolve & data, bool firstSend);
@@ -328,13 +441,13 @@ private:
 
 void MinMdnsResolver::ScheduleIpAddressResolve(SerializedQNameIterator hostName)
 {
-    HeapQName target(hostName);
-    if (!target.IsOk())
+    ActiveResolveAttempts::ScheduledAttempt::IpResolve target;
+    if (target.hostName.Set(hostName) != CHIP_NO_ERROR)
     {
-        ChipLogError(Discovery, "Memory allocation error for IP address resolution");
+        ChipLogError(Discovery, "Host name too long for IP address resolution");
         return;
     }
-    mActiveResolves.MarkPending(ActiveResolveAttempts::ScheduledAttempt::IpResolve(std::move(target)));
+    mActiveResolves.MarkPending(std::move(target));
 }
 
 void MinMdnsResolver::AdvancePendingResolverStates()
@@ -418,8 +531,7 @@ void MinMdnsResolver::AdvancePendingResolverStates()
 void MinMdnsResolver::OnMdnsPacketData(const BytesRange & data, const chip::Inet::IPPacketInfo * info)
 {
     // Fill up any relevant data
-    mPacketParser.ParseSrvRecords(data);
-    mPacketParser.ParseNonSrvRecords(info->Interface, data);
+    mPacketParser.ParseRecords(info->Interface, data);
 
     AdvancePendingResolverStates();
 
@@ -445,10 +557,10 @@ void MinMdnsResolver::Shutdown()
     GlobalMinimalMdnsServer::Instance().ShutdownServer();
 }
 
-CHIP_ERROR MinMdnsResolver::BuildQuery(QueryBuilder & builder, const ActiveResolveAttempts::ScheduledAttempt::Browse & data,
-                                       bool firstSend)
+CHIP_ERROR MinMdnsResolver::BuildBrowseQName(const ActiveResolveAttempts::ScheduledAttempt::Browse & data,
+                                              mdns::Minimal::FullQName & qname)
 {
-    mdns::Minimal::FullQName qname;
+    qname = mdns::Minimal::FullQName();
 
     switch (data.type)
     {
@@ -490,6 +602,14 @@ CHIP_ERROR MinMdnsResolver::BuildQuery(QueryBuilder & builder, const ActiveResol
     }
 
     ReturnErrorCodeIf(!qname.nameCount, CHIP_ERROR_NO_MEMORY);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR MinMdnsResolver::BuildQuery(QueryBuilder & builder, const ActiveResolveAttempts::ScheduledAttempt::Browse & data,
+                                       bool firstSend)
+{
+    mdns::Minimal::FullQName qname;
+    ReturnErrorOnFailure(BuildBrowseQName(data, qname));
 
     mdns::Minimal::Query query(qname);
     query
@@ -531,13 +651,7 @@ CHIP_ERROR MinMdnsResolver::BuildQuery(QueryBuilder & builder, const ActiveResol
                                        bool firstSend)
 {
 
-    Query query(data.hostName.Content());
-
-    query
-        .SetClass(QClass::IN)           //
-        .SetType(QType::AAAA)           //
-        .SetAnswerViaUnicast(firstSend) //
-        ;
+    QueryData query(QType::AAAA, QClass::IN, firstSend, data.hostName.Get());
 
     mdns::Minimal::Logging::LogSendingQuery(query);
     builder.AddQuery(query);
@@ -564,12 +678,109 @@ CHIP_ERROR MinMdnsResolver::BuildQuery(QueryBuilder & builder, const ActiveResol
         return CHIP_ERROR_INVALID_ARGUMENT;
     }
 
-    ReturnErrorCodeIf(!builder.Ok(), CHIP_ERROR_INTERNAL);
+    ReturnErrorCodeIf(!builder.Ok(), CHIP_ERROR_BUFFER_TOO_SMALL);
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR MinMdnsResolver::StartQuery(QueryBuilder & builder)
+{
+    System::PacketBufferHandle buffer = System::PacketBufferHandle::New(kMdnsMaxPacketSize);
+    ReturnErrorCodeIf(buffer.IsNull(), CHIP_ERROR_NO_MEMORY);
+
+    builder.Reset(std::move(buffer));
+    builder.Header().SetMessageId(0);
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR MinMdnsResolver::SendQuery(QueryBuilder & builder, bool unicastAnswers)
+{
+#if CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+    AddKnownAnswers(builder);
+#endif
+
+    if (unicastAnswers)
+    {
+        return GlobalMinimalMdnsServer::Server().BroadcastUnicastQuery(builder.ReleasePacket(), kMdnsPort);
+    }
+    return GlobalMinimalMdnsServer::Server().BroadcastSend(builder.ReleasePacket(), kMdnsPort);
+}
+
+#if CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+bool MinMdnsResolver::ResolveFromCache(const ActiveResolveAttempts::ScheduledAttempt & attempt)
+{
+    const System::Clock::Timestamp now = System::SystemClock().GetMonotonicTimestamp();
+
+    if (attempt.IsResolve())
+    {
+        char nameBuffer[kMaxOperationalServiceNameSize] = "";
+        VerifyOrReturnValue(MakeInstanceName(nameBuffer, sizeof(nameBuffer), attempt.ResolveData().peerId) == CHIP_NO_ERROR, false);
+
+        const char * instanceQName[] = { nameBuffer, kOperationalServiceName, kOperationalProtocol, kLocalDomain };
+        mPacketParser.ParseCachedRecords(mdns::Minimal::FullQName(instanceQName), now);
+        AdvancePendingResolverStates();
+    }
+    else if (attempt.IsBrowse())
+    {
+        mdns::Minimal::FullQName qname;
+        VerifyOrReturnValue(BuildBrowseQName(attempt.BrowseData(), qname) == CHIP_NO_ERROR, false);
+
+        // Browsing by instance name asks for the instance itself, other browses for PTR records
+        // to instances. Instances are resolved one at a time as there are few parallel resolvers.
+        mPacketParser.ParseCachedRecords(qname, now);
+        AdvancePendingResolverStates();
+
+        mPacketParser.GetRecordCache().ForEachRecord(now, [&](const RecordCacheBase::CachedRecord & record) {
+            if ((record.data.GetType() == QType::PTR) && (record.data.GetName() == qname))
+            {
+                mPacketParser.ParseCachedRecords(SerializedQNameIterator(record.range, record.data.GetData().Start()), now);
+                AdvancePendingResolverStates();
+            }
+            return Loop::Continue;
+        });
+    }
+
+    return !mActiveResolves.IsPending(attempt);
+}
+
+void MinMdnsResolver::AddKnownAnswers(QueryBuilder & builder)
+{
+    // Only PTR records are sent as known answers, and only if the instance they point to is cached
+    // as well: other records are asked for when they are missing from the cache, and suppressing
+    // the answer to a PTR is only safe if the instance can be resolved without it.
+    const System::Clock::Timestamp now = System::SystemClock().GetMonotonicTimestamp();
+    RecordCacheBase & cache            = mPacketParser.GetRecordCache();
+
+    builder.ForEachQuery([&](const QueryData & query) {
+        if ((query.GetType() != QType::ANY) && (query.GetType() != QType::PTR))
+        {
+            return;
+        }
+
+        cache.ForEachRecord(now, [&](const RecordCacheBase::CachedRecord & record) {
+            if ((record.data.GetType() != QType::PTR) || !record.usableAsKnownAnswer || !(record.data.GetName() == query.GetName()))
+            {
+                return Loop::Continue;
+            }
+
+            SerializedQNameIterator instance(record.range, record.data.GetData().Start());
+            if (cache.HasRecord(QType::SRV, instance, now) && !builder.AddKnownAnswer(record.range))
+            {
+                return Loop::Break; // packet is full
+            }
+            return Loop::Continue;
+        });
+    });
+}
+#endif // CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+
 CHIP_ERROR MinMdnsResolver::SendAllPendingQueries()
 {
+    // Queries are sent together: one packet for the queries sent for the first
+    // time, which ask for unicast answers, and one for the retries.
+    QueryBuilder unicastQuery;
+    QueryBuilder multicastQuery;
+
     while (true)
     {
         Optional<ActiveResolveAttempts::ScheduledAttempt> resolve = mActiveResolves.NextScheduled();
@@ -579,22 +790,37 @@ CHIP_ERROR MinMdnsResolver::SendAllPendingQueries()
             break;
         }
 
-        System::PacketBufferHandle buffer = System::PacketBufferHandle::New(kMdnsMaxPacketSize);
-        ReturnErrorCodeIf(buffer.IsNull(), CHIP_ERROR_NO_MEMORY);
-
-        QueryBuilder builder(std::move(buffer));
-        builder.Header().SetMessageId(0);
-
-        ReturnErrorOnFailure(BuildQuery(builder, resolve.Value()));
+#if CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+        if (resolve.Value().firstSend && ResolveFromCache(resolve.Value()))
+        {
+            continue;
+        }
+#endif
 
-        if (resolve.Value().firstSend)
+        QueryBuilder & builder = resolve.Value().firstSend ? unicastQuery : multicastQuery;
+        if (!builder.HasPacket())
         {
-            ReturnErrorOnFailure(GlobalMinimalMdnsServer::Server().BroadcastUnicastQuery(builder.ReleasePacket(), kMdnsPort));
+            ReturnErrorOnFailure(StartQuery(builder));
         }
-        else
+
+        CHIP_ERROR err = BuildQuery(builder, resolve.Value());
+        if ((err == CHIP_ERROR_BUFFER_TOO_SMALL) && (builder.Header().GetQueryCount() > 0))
         {
-            ReturnErrorOnFailure(GlobalMinimalMdnsServer::Server().BroadcastSend(builder.ReleasePacket(), kMdnsPort));
+            // Send the queries that fit and try again in a new packet
+            ReturnErrorOnFailure(SendQuery(builder, resolve.Value().firstSend));
+            ReturnErrorOnFailure(StartQuery(builder));
+            err = BuildQuery(builder, resolve.Value());
         }
+        ReturnErrorOnFailure(err);
+    }
+
+    if (unicastQuery.HasPacket())
+    {
+        ReturnErrorOnFailure(SendQuery(unicastQuery, /* unicastAnswers = */ true));
+    }
+    if (multicastQuery.HasPacket())
+    {
+        ReturnErrorOnFailure(SendQuery(multicastQuery, /* unicastAnswers = */ false));
     }
 
     ExpireIncrementalResolvers();
@@ -650,14 +876,14 @@ CHIP_ERROR MinMdnsResolver::BrowseNodes(DiscoveryType type, DiscoveryFilter filt
 {
     mActiveResolves.MarkPending(filter, type);
 
-    return SendAllPendingQueries();
+    return ScheduleSendPendingQueries();
 }
 
 CHIP_ERROR MinMdnsResolver::ResolveNodeId(const PeerId & peerId)
 {
     mActiveResolves.MarkPending(peerId);
 
-    return SendAllPendingQueries();
+    return ScheduleSendPendingQueries();
 }
 
 void MinMdnsResolver::NodeIdResolutionNoLongerNeeded(const PeerId & peerId)
@@ -680,9 +906,23 @@ CHIP_ERROR MinMdnsResolver::ScheduleRetries()
     return mSystemLayer->StartTimer(delay.Value(), &RetryCallback, this);
 }
 
+CHIP_ERROR MinMdnsResolver::ScheduleSendPendingQueries()
+{
+    ReturnErrorCodeIf(mSystemLayer == nullptr, CHIP_ERROR_INCORRECT_STATE);
+    mSystemLayer->CancelTimer(&RetryCallback, this);
+
+    return mSystemLayer->StartTimer(System::Clock::kZero, &RetryCallback, this);
+}
+
 void MinMdnsResolver::RetryCallback(System::Layer *, void * self)
 {
-    reinterpret_cast<MinMdnsResolver *>(self)->SendAllPendingQueries();
+    // The queries are sent after ResolveNodeId and the browse calls have returned, so the
+    // errors met sending them can only be logged here.
+    CHIP_ERROR err = reinterpret_cast<MinMdnsResolver *>(self)->SendAllPendingQueries();
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(Discovery, "Failed to send mDNS queries: %" CHIP_ERROR_FORMAT, err.Format());
+    }
 }
 
 MinMdnsResolver gResolver;
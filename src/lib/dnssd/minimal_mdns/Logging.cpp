@@ -63,6 +63,14 @@ void LogSendingQuery(const mdns::Minimal::Query & query)
                     query.IsAnswerViaUnicast() ? "UNICAST" : "MULTICAST", name.c_str(), name.Fit() ? "" : "...");
 }
 
+void LogSendingQuery(const mdns::Minimal::QueryData & query)
+{
+    QNameString name(query.GetName());
+
+    ChipLogProgress(Discovery, "MINMDNS: Sending query %s/%s for %s%s", QueryTypeToString(query.GetType()),
+                    query.RequestedUnicastAnswer() ? "UNICAST" : "MULTICAST", name.c_str(), name.Fit() ? "" : "...");
+}
+
 void LogReceivedResource(const mdns::Minimal::ResourceData & data)
 {
     QNameString name(data.GetName());
@@ -31,6 +31,7 @@ namespace Logging {
 #if CHIP_MINMDNS_HIGH_VERBOSITY
 
 void LogSendingQuery(const mdns::Minimal::Query & query);
+void LogSendingQuery(const mdns::Minimal::QueryData & query);
 void LogReceivedResource(const mdns::Minimal::ResourceData & data);
 void LogFoundOperationalSrvRecord(const chip::PeerId & peerId, const mdns::Minimal::SerializedQNameIterator & targetHost);
 void LogFoundCommissionSrvRecord(const char * instance, const mdns::Minimal::SerializedQNameIterator & targetHost);
@@ -39,6 +40,7 @@ void LogFoundIPAddress(const mdns::Minimal::SerializedQNameIterator & targetHost
 #else
 
 inline void LogSendingQuery(const mdns::Minimal::Query & query) {}
+inline void LogSendingQuery(const mdns::Minimal::QueryData & query) {}
 inline void LogReceivedResource(const mdns::Minimal::ResourceData & data) {}
 inline void LogFoundOperationalSrvRecord(const chip::PeerId & peerId, const mdns::Minimal::SerializedQNameIterator & targetHost) {}
 inline void LogFoundCommissionSrvRecord(const char * instance, const mdns::Minimal::SerializedQNameIterator & targetHost) {}
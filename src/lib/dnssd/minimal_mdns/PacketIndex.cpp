@@ -0,0 +1,187 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "PacketIndex.h"
+
+#include <lib/core/CHIPEncoding.h>
+#include <lib/support/CodeUtils.h>
+
+#include <limits>
+
+namespace mdns {
+namespace Minimal {
+
+namespace {
+
+using chip::Encoding::BigEndian::Get16;
+using chip::Encoding::BigEndian::Get32;
+
+constexpr uint8_t kPtrMask        = 0xC0;
+constexpr uint8_t kMaxLabelLength = 63;
+
+constexpr size_t kQueryFieldsSize    = 2 * sizeof(uint16_t);                    // TYPE, CLASS
+constexpr size_t kResourceFieldsSize = 3 * sizeof(uint16_t) + sizeof(uint32_t); // TYPE, CLASS, TTL, RDLENGTH
+
+/// Returns the offset following the name at `offset`, or 0 if the name is malformed.
+///
+/// Same checks as SerializedQNameIterator::FindDataEnd, without copying the labels:
+/// compression pointers end the name and are only followed when the name is read.
+size_t SkipName(const BytesRange & packet, size_t offset)
+{
+    const uint8_t * data = packet.Start();
+    const size_t size    = packet.Size();
+
+    while (offset < size)
+    {
+        const uint8_t length = data[offset];
+        if (length == 0)
+        {
+            return offset + 1;
+        }
+        if ((length & kPtrMask) == kPtrMask)
+        {
+            return (offset + 1 < size) ? offset + 2 : 0;
+        }
+        VerifyOrReturnValue(length <= kMaxLabelLength, 0);
+        offset += 1 + length;
+    }
+
+    return 0;
+}
+
+} // namespace
+
+bool PacketIndex::Index(const BytesRange & packet, size_t firstEntry)
+{
+    mPacket     = packet;
+    mFirstEntry = firstEntry;
+    mEntryCount = 0;
+    mHasHeader  = false;
+    mValid      = false;
+    mTruncated  = false;
+
+    VerifyOrReturnValue(packet.Size() >= HeaderRef::kSizeBytes, false);
+    VerifyOrReturnValue(packet.Size() <= std::numeric_limits<uint16_t>::max(), false);
+
+    const ConstHeaderRef header(packet.Start());
+    VerifyOrReturnValue(header.GetFlags().IsValidMdns(), false);
+    mHasHeader = true;
+
+    const struct
+    {
+        Section section;
+        uint16_t count;
+    } sections[] = {
+        { Section::kQuery, header.GetQueryCount() },
+        { Section::kAnswer, header.GetAnswerCount() },
+        { Section::kAuthority, header.GetAuthorityCount() },
+        { Section::kAdditional, header.GetAdditionalCount() },
+    };
+
+    size_t offset = HeaderRef::kSizeBytes;
+    size_t entry  = 0;
+    Entry skipped;
+
+    for (const auto & section : sections)
+    {
+        for (uint16_t i = 0; i < section.count; i++, entry++)
+        {
+            if (entry >= firstEntry + kMaxEntries)
+            {
+                mTruncated = true;
+                mValid     = true;
+                return true;
+            }
+
+            const bool indexed = (entry >= firstEntry);
+            VerifyOrReturnValue(ParseEntry(section.section, offset, indexed ? mEntries[mEntryCount] : skipped), false);
+            if (indexed)
+            {
+                mEntryCount++;
+            }
+        }
+    }
+
+    mValid = true;
+    return true;
+}
+
+bool PacketIndex::ParseEntry(Section section, size_t & offset, Entry & entry) const
+{
+    const size_t nameEnd = SkipName(mPacket, offset);
+    VerifyOrReturnValue(nameEnd != 0, false);
+
+    const bool isQuery      = (section == Section::kQuery);
+    const size_t fieldsSize = isQuery ? kQueryFieldsSize : kResourceFieldsSize;
+    const uint8_t * fields  = mPacket.Start() + nameEnd;
+    const size_t remaining  = mPacket.Size() - nameEnd;
+    VerifyOrReturnValue(remaining >= fieldsSize, false);
+
+    entry.nameOffset = static_cast<uint16_t>(offset);
+    entry.type       = Get16(fields);
+    entry.klass      = Get16(fields + sizeof(uint16_t));
+    entry.section    = section;
+
+    if (isQuery)
+    {
+        entry.dataOffset = 0;
+        entry.dataLength = 0;
+        entry.ttl        = 0;
+        offset           = nameEnd + fieldsSize;
+        return true;
+    }
+
+    entry.ttl        = Get32(fields + 2 * sizeof(uint16_t));
+    entry.dataLength = Get16(fields + 2 * sizeof(uint16_t) + sizeof(uint32_t));
+    entry.dataOffset = static_cast<uint16_t>(nameEnd + fieldsSize);
+    VerifyOrReturnValue(remaining - fieldsSize >= entry.dataLength, false);
+
+    offset = nameEnd + fieldsSize + entry.dataLength;
+    return true;
+}
+
+ResourceType PacketIndex::GetResourceType(size_t index) const
+{
+    switch (mEntries[index].section)
+    {
+    case Section::kAuthority:
+        return ResourceType::kAuthority;
+    case Section::kAdditional:
+        return ResourceType::kAdditional;
+    default:
+        return ResourceType::kAnswer;
+    }
+}
+
+QueryData PacketIndex::GetQuery(size_t index) const
+{
+    const Entry & entry = mEntries[index];
+    return QueryData(static_cast<QType>(entry.type), static_cast<QClass>(entry.klass & ~kQClassUnicastAnswerFlag),
+                     (entry.klass & kQClassUnicastAnswerFlag) != 0, mPacket.Start() + entry.nameOffset, mPacket);
+}
+
+ResourceData PacketIndex::GetResource(size_t index) const
+{
+    const Entry & entry  = mEntries[index];
+    const uint8_t * data = mPacket.Start() + entry.dataOffset;
+    return ResourceData(static_cast<QType>(entry.type), static_cast<QClass>(entry.klass), entry.ttl,
+                        SerializedQNameIterator(mPacket, mPacket.Start() + entry.nameOffset),
+                        BytesRange(data, data + entry.dataLength));
+}
+
+} // namespace Minimal
+} // namespace mdns
@@ -0,0 +1,145 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPConfig.h>
+#include <lib/dnssd/minimal_mdns/Parser.h>
+#include <lib/dnssd/minimal_mdns/core/BytesRange.h>
+#include <lib/dnssd/minimal_mdns/core/Constants.h>
+#include <lib/dnssd/minimal_mdns/core/DnsHeader.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace mdns {
+namespace Minimal {
+
+/// Indexes the queries and resource records of a mDNS packet in a single pass.
+///
+/// Entries only keep offsets within the packet: names are skipped without being
+/// decompressed or copied, and are only read when the QueryData or ResourceData of an
+/// entry is iterated. Consumers that go over the records several times (e.g. SRV records
+/// first, then all the others) walk the index instead of parsing the packet again.
+///
+/// The index has room for kMaxEntries entries. Packets with more queries and records are
+/// indexed in windows: IsTruncated() tells that more entries follow, which are indexed
+/// by calling Index again starting at GetNextEntry().
+///
+/// The packet must stay valid while the index is used.
+class PacketIndex
+{
+public:
+    static constexpr size_t kMaxEntries = CHIP_CONFIG_MINMDNS_PACKET_INDEX_SIZE;
+
+    PacketIndex() {}
+
+    /// Index `packet`, skipping its first `firstEntry` queries and records.
+    ///
+    /// Returns false if the packet is not a valid mDNS packet or if one of its queries or
+    /// records is malformed. Entries before the malformed one stay indexed, as
+    /// ParsePacket reports them before failing.
+    bool Index(const BytesRange & packet, size_t firstEntry = 0);
+
+    /// The packet has a valid mDNS header, available through GetHeader().
+    bool HasHeader() const { return mHasHeader; }
+    ConstHeaderRef GetHeader() const { return ConstHeaderRef(mPacket.Start()); }
+
+    /// The last call to Index succeeded.
+    bool IsValid() const { return mValid; }
+
+    /// The packet has more entries than the index holds, starting at GetNextEntry().
+    bool IsTruncated() const { return mTruncated; }
+    size_t GetFirstEntry() const { return mFirstEntry; }
+    size_t GetNextEntry() const { return mFirstEntry + mEntryCount; }
+
+    const BytesRange & GetPacket() const { return mPacket; }
+    size_t GetEntryCount() const { return mEntryCount; }
+
+    bool IsQuery(size_t index) const { return mEntries[index].section == Section::kQuery; }
+    QType GetType(size_t index) const { return static_cast<QType>(mEntries[index].type); }
+
+    /// Only valid for resource records.
+    ResourceType GetResourceType(size_t index) const;
+
+    QueryData GetQuery(size_t index) const;
+    ResourceData GetResource(size_t index) const;
+
+    /// Call function(const QueryData &) for the indexed queries.
+    template <typename Function>
+    void ForEachQuery(Function && function) const
+    {
+        for (size_t i = 0; i < mEntryCount; i++)
+        {
+            if (IsQuery(i))
+            {
+                const QueryData query = GetQuery(i);
+                function(query);
+            }
+        }
+    }
+
+    /// Call function(ResourceType, const ResourceData &) for the indexed resource records,
+    /// in packet order.
+    template <typename Function>
+    void ForEachResource(Function && function) const
+    {
+        for (size_t i = 0; i < mEntryCount; i++)
+        {
+            if (!IsQuery(i))
+            {
+                const ResourceData resource = GetResource(i);
+                function(GetResourceType(i), resource);
+            }
+        }
+    }
+
+private:
+    enum class Section : uint8_t
+    {
+        kQuery,
+        kAnswer,
+        kAuthority,
+        kAdditional,
+    };
+
+    /// Offsets are relative to the packet start, larger packets are not indexed.
+    struct Entry
+    {
+        uint16_t nameOffset;
+        uint16_t dataOffset; // resource records only
+        uint16_t dataLength; // resource records only
+        uint16_t type;
+        uint16_t klass; // as found in the packet, including the unicast or cache-flush bit
+        Section section;
+        uint32_t ttl; // resource records only
+    };
+
+    /// Parse the query or resource record at `offset` and advance `offset` past it.
+    bool ParseEntry(Section section, size_t & offset, Entry & entry) const;
+
+    BytesRange mPacket;
+    size_t mFirstEntry = 0;
+    size_t mEntryCount = 0;
+    bool mHasHeader    = false;
+    bool mValid        = false;
+    bool mTruncated    = false;
+    Entry mEntries[kMaxEntries];
+};
+
+} // namespace Minimal
+} // namespace mdns
@@ -38,6 +38,10 @@ public:
         mType(type), mClass(klass), mAnswerViaUnicast(unicast), mNameIterator(validData, nameStart)
     {}
 
+    QueryData(QType type, QClass klass, bool unicast, const SerializedQNameIterator & name) :
+        mType(type), mClass(klass), mAnswerViaUnicast(unicast), mNameIterator(name)
+    {}
+
     QType GetType() const { return mType; }
     QClass GetClass() const { return mClass; }
     bool RequestedUnicastAnswer() const { return mAnswerViaUnicast; }
@@ -80,6 +84,10 @@ public:
     ResourceData(const ResourceData &) = default;
     ResourceData & operator=(const ResourceData &) = default;
 
+    ResourceData(QType type, QClass klass, uint64_t ttl, const SerializedQNameIterator & name, const BytesRange & data) :
+        mNameIterator(name), mType(type), mClass(klass), mTtl(ttl), mData(data)
+    {}
+
     QType GetType() const { return mType; }
     QClass GetClass() const { return mClass; }
     uint64_t GetTtlSeconds() const { return mTtl; }
@@ -19,8 +19,12 @@
 
 #include <system/SystemPacketBuffer.h>
 
+#include <lib/dnssd/minimal_mdns/Parser.h>
 #include <lib/dnssd/minimal_mdns/Query.h>
 #include <lib/dnssd/minimal_mdns/core/DnsHeader.h>
+#include <lib/support/CodeUtils.h>
+
+#include <string.h>
 
 namespace mdns {
 namespace Minimal {
@@ -33,8 +37,9 @@ public:
 
     QueryBuilder & Reset(chip::System::PacketBufferHandle && packet)
     {
-        mPacket = std::move(packet);
-        mHeader = HeaderRef(mPacket->Start());
+        mPacket       = std::move(packet);
+        mHeader       = HeaderRef(mPacket->Start());
+        mQueryBuildOk = true;
 
         if (mPacket->AvailableDataLength() >= HeaderRef::kSizeBytes)
         {
@@ -58,9 +63,14 @@ public:
         return std::move(mPacket);
     }
 
+    /// Check if a packet is being built: Reset was called and the packet was not released since.
+    bool HasPacket() const { return !mPacket.IsNull(); }
+
     HeaderRef & Header() { return mHeader; }
 
-    QueryBuilder & AddQuery(const Query & query)
+    /// Add a query, either a Query or a QueryData.
+    template <typename QueryType>
+    QueryBuilder & AddQuery(const QueryType & query)
     {
         if (!mQueryBuildOk)
         {
@@ -81,6 +91,43 @@ public:
         return *this;
     }
 
+    /// Add a known answer (RFC 6762 section 7.1), after all the queries.
+    ///
+    /// [record] is a serialized resource record whose names are not compressed.
+    /// Returns false if the record does not fit, in which case the packet is left
+    /// unchanged and can still be sent.
+    bool AddKnownAnswer(const BytesRange & record)
+    {
+        if (!mQueryBuildOk || (record.Size() > mPacket->AvailableDataLength()))
+        {
+            return false;
+        }
+
+        memcpy(mPacket->Start() + mPacket->DataLength(), record.Start(), record.Size());
+        mPacket->SetDataLength(static_cast<uint16_t>(mPacket->DataLength() + record.Size()));
+        mHeader.SetAnswerCount(static_cast<uint16_t>(mHeader.GetAnswerCount() + 1));
+        return true;
+    }
+
+    /// Call function(const QueryData &) for the queries added so far.
+    template <typename Function>
+    void ForEachQuery(Function && function) const
+    {
+        VerifyOrReturn(HasPacket());
+
+        const BytesRange packet(mPacket->Start(), mPacket->Start() + mPacket->DataLength());
+        const uint8_t * data = packet.Start() + HeaderRef::kSizeBytes;
+        for (uint16_t i = 0; i < mHeader.GetQueryCount(); i++)
+        {
+            QueryData query;
+            if (!query.Parse(packet, &data))
+            {
+                return;
+            }
+            function(static_cast<const QueryData &>(query));
+        }
+    }
+
     bool Ok() const { return mQueryBuildOk; }
 
 private:
@@ -0,0 +1,222 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "RecordCache.h"
+
+#include <lib/core/CHIPEncoding.h>
+#include <lib/dnssd/minimal_mdns/RecordData.h>
+#include <lib/support/BufferWriter.h>
+#include <lib/support/CodeUtils.h>
+
+#include <algorithm>
+#include <limits>
+#include <string.h>
+
+namespace mdns {
+namespace Minimal {
+
+namespace {
+
+using chip::Encoding::BigEndian::BufferWriter;
+using chip::System::Clock::Timestamp;
+
+/// Records received this long before a cache-flush record are flushed by it.
+constexpr chip::System::Clock::Milliseconds32 kCacheFlushDelay = chip::System::Clock::Seconds32(1);
+
+/// Write a name with no compression, as a list of labels each preceded by its length.
+CHIP_ERROR WriteName(BufferWriter & out, SerializedQNameIterator name)
+{
+    while (name.Next())
+    {
+        size_t labelLength = strlen(name.Value());
+        out.Put8(static_cast<uint8_t>(labelLength)).Put(name.Value(), labelLength);
+    }
+    VerifyOrReturnError(name.IsValid(), CHIP_ERROR_INVALID_ARGUMENT);
+    out.Put8(0);
+    return CHIP_NO_ERROR;
+}
+
+/// Compare uncompressed names. Label lengths are below 64, so they are not affected by the case conversion.
+bool NamesEqual(const uint8_t * a, const uint8_t * b, size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        uint8_t lowerA = ((a[i] >= 'A') && (a[i] <= 'Z')) ? static_cast<uint8_t>(a[i] - 'A' + 'a') : a[i];
+        uint8_t lowerB = ((b[i] >= 'A') && (b[i] <= 'Z')) ? static_cast<uint8_t>(b[i] - 'A' + 'a') : b[i];
+        if (lowerA != lowerB)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+Timestamp ExpiryTime(const Internal::RecordCacheEntry & entry)
+{
+    return entry.receivedTime + chip::System::Clock::Seconds32(entry.ttlSeconds);
+}
+
+} // namespace
+
+CHIP_ERROR RecordCacheBase::Add(chip::Inet::InterfaceId interface, const ResourceData & record, const BytesRange & packet,
+                                Timestamp now)
+{
+    Internal::RecordCacheEntry entry;
+    BufferWriter out(entry.data, sizeof(entry.data));
+
+    const uint64_t ttl = record.GetTtlSeconds();
+    const bool flush   = (static_cast<uint16_t>(record.GetClass()) & kQClassResponseFlushBit) != 0;
+
+    ReturnErrorOnFailure(WriteName(out, record.GetName()));
+    entry.nameSize = out.Needed();
+    out.Put16(static_cast<uint16_t>(record.GetType()));
+    out.Put16(static_cast<uint16_t>(static_cast<uint16_t>(record.GetClass()) & ~kQClassResponseFlushBit));
+    out.Put32(static_cast<uint32_t>(std::min<uint64_t>(ttl, std::numeric_limits<uint32_t>::max())));
+
+    const size_t dataLengthOffset = out.Needed();
+    out.Put16(0); // set once the data is written
+
+    switch (record.GetType())
+    {
+    case QType::PTR:
+        ReturnErrorOnFailure(WriteName(out, SerializedQNameIterator(packet, record.GetData().Start())));
+        break;
+    case QType::SRV: {
+        SrvRecord srv;
+        VerifyOrReturnError(srv.Parse(record.GetData(), packet), CHIP_ERROR_INVALID_ARGUMENT);
+        out.Put16(srv.GetPriority()).Put16(srv.GetWeight()).Put16(srv.GetPort());
+        ReturnErrorOnFailure(WriteName(out, srv.GetName()));
+        break;
+    }
+    case QType::TXT:
+    case QType::A:
+    case QType::AAAA:
+        out.Put(record.GetData().Start(), record.GetData().Size());
+        break;
+    default:
+        return CHIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    VerifyOrReturnError(out.Fit(), CHIP_ERROR_BUFFER_TOO_SMALL);
+    chip::Encoding::BigEndian::Put16(&entry.data[dataLengthOffset],
+                                     static_cast<uint16_t>(out.Needed() - dataLengthOffset - sizeof(uint16_t)));
+
+    entry.valid        = true;
+    entry.interface    = interface;
+    entry.receivedTime = now;
+    entry.ttlSeconds   = static_cast<uint32_t>(std::min<uint64_t>(ttl, std::numeric_limits<uint32_t>::max()));
+    entry.size         = out.Needed();
+
+    // Drop expired records, the previous copy of this record and the records flushed by it
+    for (size_t i = 0; i < mEntryCount; i++)
+    {
+        Internal::RecordCacheEntry & other = mEntries[i];
+        if (!other.valid)
+        {
+            continue;
+        }
+
+        if ((now >= ExpiryTime(other)) || SameRecord(other, entry) ||
+            (flush && SameNameAndType(other, entry) && (now - other.receivedTime > kCacheFlushDelay)))
+        {
+            other.valid = false;
+        }
+    }
+
+    // A TTL of 0 announces that the record is gone
+    VerifyOrReturnError(ttl > 0, CHIP_NO_ERROR);
+
+    Internal::RecordCacheEntry * slot = nullptr;
+    for (size_t i = 0; i < mEntryCount; i++)
+    {
+        if (!mEntries[i].valid)
+        {
+            slot = &mEntries[i];
+            break;
+        }
+        if ((slot == nullptr) || (ExpiryTime(mEntries[i]) < ExpiryTime(*slot)))
+        {
+            slot = &mEntries[i];
+        }
+    }
+    VerifyOrReturnError(slot != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    *slot = entry;
+    return CHIP_NO_ERROR;
+}
+
+bool RecordCacheBase::HasRecord(QType type, const SerializedQNameIterator & name, Timestamp now)
+{
+    return ForEachRecord(now, [&](const CachedRecord & record) {
+               return ((record.data.GetType() == type) && (record.data.GetName() == name)) ? chip::Loop::Break
+                                                                                           : chip::Loop::Continue;
+           }) == chip::Loop::Break;
+}
+
+void RecordCacheBase::Clear()
+{
+    for (size_t i = 0; i < mEntryCount; i++)
+    {
+        mEntries[i].valid = false;
+    }
+}
+
+bool RecordCacheBase::Get(Internal::RecordCacheEntry & entry, Timestamp now, CachedRecord & record)
+{
+    VerifyOrReturnValue(entry.valid, false);
+
+    if (now >= ExpiryTime(entry))
+    {
+        entry.valid = false;
+        return false;
+    }
+
+    // Records are handed out with the TTL they have left, as known answers must be
+    const uint32_t elapsedSeconds =
+        static_cast<uint32_t>(std::chrono::duration_cast<chip::System::Clock::Seconds32>(now - entry.receivedTime).count());
+    const uint32_t remainingSeconds = entry.ttlSeconds - elapsedSeconds;
+    chip::Encoding::BigEndian::Put32(&entry.data[entry.nameSize + 2 * sizeof(uint16_t)], remainingSeconds);
+
+    record.range          = BytesRange(entry.data, entry.data + entry.size);
+    const uint8_t * start = entry.data;
+    if (!record.data.Parse(record.range, &start))
+    {
+        entry.valid = false;
+        return false;
+    }
+    record.interface           = entry.interface;
+    record.usableAsKnownAnswer = static_cast<uint64_t>(remainingSeconds) * 2 > entry.ttlSeconds;
+
+    return true;
+}
+
+bool RecordCacheBase::SameNameAndType(const Internal::RecordCacheEntry & a, const Internal::RecordCacheEntry & b)
+{
+    // Name, type and class are followed by the TTL
+    return (a.interface == b.interface) && (a.nameSize == b.nameSize) && NamesEqual(a.data, b.data, a.nameSize) &&
+        (memcmp(&a.data[a.nameSize], &b.data[b.nameSize], 2 * sizeof(uint16_t)) == 0);
+}
+
+bool RecordCacheBase::SameRecord(const Internal::RecordCacheEntry & a, const Internal::RecordCacheEntry & b)
+{
+    const size_t dataOffset = a.nameSize + 2 * sizeof(uint16_t) + sizeof(uint32_t);
+    return SameNameAndType(a, b) && (a.size == b.size) &&
+        (memcmp(&a.data[dataOffset], &b.data[dataOffset], a.size - dataOffset) == 0);
+}
+
+} // namespace Minimal
+} // namespace mdns
@@ -0,0 +1,124 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <inet/InetInterface.h>
+#include <lib/core/CHIPError.h>
+#include <lib/dnssd/minimal_mdns/Parser.h>
+#include <lib/dnssd/minimal_mdns/core/QName.h>
+#include <lib/support/Iterators.h>
+#include <system/SystemClock.h>
+
+namespace mdns {
+namespace Minimal {
+
+namespace Internal {
+
+/// A cached resource record, serialized as in a packet but with no compressed names,
+/// so that it can be parsed and sent again on its own.
+struct RecordCacheEntry
+{
+    static constexpr size_t kMaxRecordSize = 256;
+
+    bool valid                                  = false;
+    chip::Inet::InterfaceId interface           = chip::Inet::InterfaceId::Null();
+    chip::System::Clock::Timestamp receivedTime = chip::System::Clock::kZero;
+    uint32_t ttlSeconds                         = 0;
+    size_t nameSize                             = 0; // offset of the record type
+    size_t size                                 = 0;
+    uint8_t data[kMaxRecordSize];
+};
+
+} // namespace Internal
+
+/// Keeps the resource records received in mDNS replies until their TTL expires.
+///
+/// Cached records are used to resolve names again without asking the network and are sent
+/// as known answers, so that responders do not repeat records the querier already has.
+/// When full, the record closest to expiring is replaced.
+class RecordCacheBase
+{
+public:
+    /// A record as provided by ForEachRecord.
+    struct CachedRecord
+    {
+        ResourceData data; // TTL is the remaining TTL
+        BytesRange range;  // the serialized record, names of `data` point within it
+        chip::Inet::InterfaceId interface;
+
+        /// More than half of the TTL remains, as required for known answers (RFC 6762 section 7.1).
+        bool usableAsKnownAnswer;
+    };
+
+    RecordCacheBase(Internal::RecordCacheEntry * entries, size_t entryCount) : mEntries(entries), mEntryCount(entryCount) {}
+
+    /// Cache a PTR, SRV, TXT, A or AAAA record found in `packet`, received at `now`.
+    ///
+    /// A TTL of 0 removes the record and the cache-flush bit removes records of the same
+    /// name and type received more than a second ago (RFC 6762 section 10.2).
+    CHIP_ERROR Add(chip::Inet::InterfaceId interface, const ResourceData & record, const BytesRange & packet,
+                   chip::System::Clock::Timestamp now);
+
+    /// Call function(const CachedRecord &) for all the records that have not expired at `now`,
+    /// until it returns chip::Loop::Break.
+    template <typename Function>
+    chip::Loop ForEachRecord(chip::System::Clock::Timestamp now, Function && function)
+    {
+        for (size_t i = 0; i < mEntryCount; i++)
+        {
+            CachedRecord record;
+            if (!Get(mEntries[i], now, record))
+            {
+                continue;
+            }
+            if (function(static_cast<const CachedRecord &>(record)) == chip::Loop::Break)
+            {
+                return chip::Loop::Break;
+            }
+        }
+        return chip::Loop::Finish;
+    }
+
+    /// Check for a record of the given type and name that has not expired at `now`.
+    bool HasRecord(QType type, const SerializedQNameIterator & name, chip::System::Clock::Timestamp now);
+
+    void Clear();
+
+private:
+    /// Fills `record` from `entry`, returns false if the entry is unused or expired.
+    bool Get(Internal::RecordCacheEntry & entry, chip::System::Clock::Timestamp now, CachedRecord & record);
+
+    static bool SameNameAndType(const Internal::RecordCacheEntry & a, const Internal::RecordCacheEntry & b);
+    static bool SameRecord(const Internal::RecordCacheEntry & a, const Internal::RecordCacheEntry & b);
+
+    Internal::RecordCacheEntry * mEntries;
+    const size_t mEntryCount;
+};
+
+template <size_t kEntryCount>
+class RecordCache : public RecordCacheBase
+{
+public:
+    RecordCache() : RecordCacheBase(mEntryStorage, kEntryCount) {}
+
+private:
+    Internal::RecordCacheEntry mEntryStorage[kEntryCount];
+};
+
+} // namespace Minimal
+} // namespace mdns
@@ -0,0 +1,196 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "ResponderRegistry.h"
+
+#include <lib/support/CHIPMem.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <string.h>
+
+namespace mdns {
+namespace Minimal {
+
+namespace {
+
+constexpr uint32_t kFnvOffsetBasis = 2166136261u;
+constexpr uint32_t kFnvPrime       = 16777619u;
+
+/// FNV-1a over the lower case label, preceded by its length so that label boundaries count.
+uint32_t HashLabel(uint32_t hash, const char * label)
+{
+    hash = (hash ^ static_cast<uint8_t>(strlen(label))) * kFnvPrime;
+    for (const char * c = label; *c != '\0'; c++)
+    {
+        char lower = ((*c >= 'A') && (*c <= 'Z')) ? static_cast<char>(*c - 'A' + 'a') : *c;
+        hash       = (hash ^ static_cast<uint8_t>(lower)) * kFnvPrime;
+    }
+    return hash;
+}
+
+} // namespace
+
+ResponderRegistry::~ResponderRegistry()
+{
+    while (!mResponders.Empty())
+    {
+        QueryResponderBase * responder = &*mResponders.begin();
+        responder->SetChangeDelegate(nullptr);
+        mResponders.Remove(responder);
+    }
+    ReleaseIndex();
+}
+
+CHIP_ERROR ResponderRegistry::Add(QueryResponderBase * responder)
+{
+    VerifyOrReturnError(responder != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    ReturnErrorCodeIf(responder->GetChangeDelegate() == this, CHIP_NO_ERROR); // already registered
+    VerifyOrReturnError(responder->GetChangeDelegate() == nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    responder->SetChangeDelegate(this);
+    mResponders.PushBack(responder);
+
+    QueryResponderRecordFilter validRecords;
+    for (auto it = responder->begin(&validRecords); it != responder->end(); it++)
+    {
+        OnRecordAdded(responder, it.GetInternal());
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ResponderRegistry::Remove(QueryResponderBase * responder)
+{
+    VerifyOrReturnError((responder != nullptr) && (responder->GetChangeDelegate() == this), CHIP_ERROR_NOT_FOUND);
+
+    mResponders.Remove(responder);
+    responder->SetChangeDelegate(nullptr);
+    OnRecordsRemoved(responder);
+
+    return CHIP_NO_ERROR;
+}
+
+void ResponderRegistry::OnRecordAdded(QueryResponderBase * responder, Internal::QueryResponderInfo * info)
+{
+    mGeneration++;
+    VerifyOrReturn(mIndexValid);
+
+    if ((mIndexCount + 1) * 2 > mIndexSize)
+    {
+        mIndexValid = false; // grown on the next lookup
+        return;
+    }
+
+    InsertInIndex(responder, info);
+}
+
+void ResponderRegistry::OnRecordsRemoved(QueryResponderBase * responder)
+{
+    mGeneration++;
+    mIndexValid = false;
+}
+
+uint32_t ResponderRegistry::Hash(const FullQName & name)
+{
+    uint32_t hash = kFnvOffsetBasis;
+    for (size_t i = 0; i < name.nameCount; i++)
+    {
+        hash = HashLabel(hash, name.names[i]);
+    }
+    return hash;
+}
+
+uint32_t ResponderRegistry::Hash(SerializedQNameIterator name)
+{
+    uint32_t hash = kFnvOffsetBasis;
+    while (name.Next())
+    {
+        hash = HashLabel(hash, name.Value());
+    }
+    return hash;
+}
+
+bool ResponderRegistry::EnsureIndex()
+{
+    VerifyOrReturnValue(!mIndexValid, true);
+
+    size_t recordCount = 0;
+    ForEachRecord([&recordCount](QueryResponderBase *, Internal::QueryResponderInfo *) {
+        recordCount++;
+        return CHIP_NO_ERROR;
+    });
+
+    // Leave room for as many records to be added before the table has to grow
+    size_t indexSize = kMinIndexSize;
+    while (indexSize < recordCount * 4)
+    {
+        indexSize *= 2;
+    }
+
+    if (indexSize != mIndexSize)
+    {
+        ReleaseIndex();
+        mIndex = static_cast<IndexEntry *>(chip::Platform::MemoryCalloc(indexSize, sizeof(IndexEntry)));
+        if (mIndex == nullptr)
+        {
+            ChipLogError(Discovery, "Failed to allocate an index for %u mDNS records", static_cast<unsigned>(recordCount));
+            return false;
+        }
+        mIndexSize = indexSize;
+    }
+    else
+    {
+        memset(mIndex, 0, mIndexSize * sizeof(IndexEntry));
+    }
+
+    mIndexCount = 0;
+    ForEachRecord([this](QueryResponderBase * responder, Internal::QueryResponderInfo * info) {
+        InsertInIndex(responder, info);
+        return CHIP_NO_ERROR;
+    });
+    mIndexValid = true;
+
+    return true;
+}
+
+void ResponderRegistry::InsertInIndex(QueryResponderBase * responder, Internal::QueryResponderInfo * info)
+{
+    // Records of the same name stay in insertion order along the probe sequence
+    const uint32_t hash = Hash(info->responder->GetQName());
+    size_t i            = hash & (mIndexSize - 1);
+    while (mIndex[i].info != nullptr)
+    {
+        i = (i + 1) & (mIndexSize - 1);
+    }
+
+    mIndex[i].hash      = hash;
+    mIndex[i].responder = responder;
+    mIndex[i].info      = info;
+    mIndexCount++;
+}
+
+void ResponderRegistry::ReleaseIndex()
+{
+    chip::Platform::MemoryFree(mIndex);
+    mIndex      = nullptr;
+    mIndexSize  = 0;
+    mIndexCount = 0;
+    mIndexValid = false;
+}
+
+} // namespace Minimal
+} // namespace mdns
@@ -0,0 +1,139 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <lib/dnssd/minimal_mdns/core/QName.h>
+#include <lib/dnssd/minimal_mdns/responders/QueryResponder.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/IntrusiveList.h>
+
+namespace mdns {
+namespace Minimal {
+
+/// Keeps track of the query responders of a ResponseSender and indexes their records by QName.
+///
+/// Any number of responders can be registered, they are linked in an intrusive list. Records are
+/// indexed in an open addressing hash table keyed by a case insensitive hash of their QName, so
+/// that the records answering a query are found without looking at the records of all the other
+/// responders (e.g. those of hundreds of operational identities). Records are filtered by QType
+/// and QClass by the caller, as ANY queries need all the records of a name.
+///
+/// The table is allocated on the heap and sized for the number of records. Added records are
+/// inserted as they come, removing records drops the table and it is rebuilt by the next lookup.
+/// If the table cannot be allocated, lookups walk all the records instead.
+class ResponderRegistry : public QueryResponderChangeDelegate
+{
+public:
+    ResponderRegistry() {}
+    ~ResponderRegistry() override;
+
+    /// Register a responder. Registering the same responder again does nothing.
+    CHIP_ERROR Add(QueryResponderBase * responder);
+    CHIP_ERROR Remove(QueryResponderBase * responder);
+    bool IsEmpty() const { return mResponders.Empty(); }
+
+    /// Changes whenever records are added or removed.
+    uint32_t GetGeneration() const { return mGeneration; }
+
+    /// Call function(responder) for all the responders in registration order, stopping at the
+    /// first error returned.
+    template <typename Function>
+    CHIP_ERROR ForEachResponder(Function && function)
+    {
+        for (auto & responder : mResponders)
+        {
+            ReturnErrorOnFailure(function(&responder));
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    /// Call function(responder, info) for all the records, stopping at the first error returned.
+    template <typename Function>
+    CHIP_ERROR ForEachRecord(Function && function)
+    {
+        QueryResponderRecordFilter validRecords;
+        for (auto & responder : mResponders)
+        {
+            for (auto it = responder.begin(&validRecords); it != responder.end(); it++)
+            {
+                ReturnErrorOnFailure(function(&responder, it.GetInternal()));
+            }
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    /// Call function(responder, info) for the records named `name` (a FullQName or a
+    /// SerializedQNameIterator), stopping at the first error returned.
+    template <typename Name, typename Function>
+    CHIP_ERROR ForEachRecordNamed(const Name & name, Function && function)
+    {
+        if (!EnsureIndex())
+        {
+            return ForEachRecord([&](QueryResponderBase * responder, Internal::QueryResponderInfo * info) {
+                return NameEquals(name, info->responder->GetQName()) ? function(responder, info) : CHIP_NO_ERROR;
+            });
+        }
+
+        const uint32_t hash = Hash(name);
+        for (size_t i = hash & (mIndexSize - 1); mIndex[i].info != nullptr; i = (i + 1) & (mIndexSize - 1))
+        {
+            if ((mIndex[i].hash == hash) && NameEquals(name, mIndex[i].info->responder->GetQName()))
+            {
+                ReturnErrorOnFailure(function(mIndex[i].responder, mIndex[i].info));
+            }
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    // Implementation of QueryResponderChangeDelegate
+    void OnRecordAdded(QueryResponderBase * responder, Internal::QueryResponderInfo * info) override;
+    void OnRecordsRemoved(QueryResponderBase * responder) override;
+
+private:
+    struct IndexEntry
+    {
+        uint32_t hash;
+        QueryResponderBase * responder;
+        Internal::QueryResponderInfo * info; // nullptr for free slots
+    };
+
+    static constexpr size_t kMinIndexSize = 16;
+
+    static uint32_t Hash(const FullQName & name);
+    static uint32_t Hash(SerializedQNameIterator name);
+
+    static bool NameEquals(const FullQName & name, const FullQName & other) { return name == other; }
+    static bool NameEquals(const SerializedQNameIterator & name, const FullQName & other) { return name == other; }
+
+    /// Make sure the index has all the records, returns false if it could not be allocated.
+    bool EnsureIndex();
+    void InsertInIndex(QueryResponderBase * responder, Internal::QueryResponderInfo * info);
+    void ReleaseIndex();
+
+    chip::IntrusiveList<QueryResponderBase, chip::IntrusiveMode::AutoUnlink> mResponders;
+
+    IndexEntry * mIndex  = nullptr;
+    size_t mIndexSize    = 0; // power of 2, at least twice mIndexCount
+    size_t mIndexCount   = 0;
+    bool mIndexValid     = false;
+    uint32_t mGeneration = 0;
+};
+
+} // namespace Minimal
+} // namespace mdns
@@ -0,0 +1,176 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "ResponseCache.h"
+
+#include <string.h>
+
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+
+namespace mdns {
+namespace Minimal {
+
+const chip::System::Clock::Milliseconds32 ResponseCache::kEntryLifetime = chip::System::Clock::Seconds32(5);
+
+bool ResponseCache::Key::Set(const QueryData & query, bool unicast, chip::Inet::InterfaceId interface)
+{
+    mType       = query.GetType();
+    mClass      = query.GetClass();
+    mUnicast    = unicast;
+    mInterface  = interface;
+    mNameLength = 0;
+
+    SerializedQNameIterator name = query.GetName();
+    while (name.Next())
+    {
+        size_t labelLength = strlen(name.Value());
+        if (mNameLength + 1 + labelLength > sizeof(mName))
+        {
+            return false;
+        }
+
+        mName[mNameLength++] = static_cast<uint8_t>(labelLength);
+        memcpy(&mName[mNameLength], name.Value(), labelLength);
+        mNameLength += labelLength;
+    }
+
+    return name.IsValid();
+}
+
+bool ResponseCache::Key::operator==(const Key & other) const
+{
+    return (mType == other.mType) && (mClass == other.mClass) && (mUnicast == other.mUnicast) && (mInterface == other.mInterface) &&
+        (mNameLength == other.mNameLength) && (memcmp(mName, other.mName, mNameLength) == 0);
+}
+
+bool ResponseCache::Entry::WasMulticastSince(chip::System::Clock::Timestamp time) const
+{
+    for (size_t i = 0; i < mAnswerCount; i++)
+    {
+        if (mAnswers[i]->lastMulticastTime >= time)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ResponseCache::Entry::SetMulticastTime(chip::System::Clock::Timestamp time)
+{
+    for (size_t i = 0; i < mAnswerCount; i++)
+    {
+        mAnswers[i]->lastMulticastTime = time;
+    }
+}
+
+ResponseCache::Entry * ResponseCache::Find(const Key & key, chip::System::Clock::Timestamp now)
+{
+    for (Entry & entry : mEntries)
+    {
+        if (!entry.mValid || !(entry.mKey == key))
+        {
+            continue;
+        }
+
+        if (now - entry.mCreated >= kEntryLifetime)
+        {
+            entry.mValid = false;
+            return nullptr;
+        }
+
+        entry.mLastUsed = now;
+        return &entry;
+    }
+
+    return nullptr;
+}
+
+void ResponseCache::BeginRecord(const Key & key)
+{
+    mRecording = nullptr;
+    for (Entry & entry : mEntries)
+    {
+        if (!entry.mValid)
+        {
+            mRecording = &entry;
+            break;
+        }
+        if ((mRecording == nullptr) || (entry.mLastUsed < mRecording->mLastUsed))
+        {
+            mRecording = &entry;
+        }
+    }
+    VerifyOrReturn(mRecording != nullptr);
+
+    mRecording->mValid       = false;
+    mRecording->mKey         = key;
+    mRecording->mAnswerCount = 0;
+    mRecording->mReplyLength = 0;
+    mRecording->mHasReply    = false;
+}
+
+void ResponseCache::RecordAnswer(QueryResponderRecord * record)
+{
+    VerifyOrReturn(mRecording != nullptr);
+
+    if (mRecording->mAnswerCount >= kMaxAnswers)
+    {
+        CancelRecord();
+        return;
+    }
+
+    mRecording->mAnswers[mRecording->mAnswerCount++] = record;
+}
+
+void ResponseCache::RecordReply(const chip::System::PacketBufferHandle & packet)
+{
+    VerifyOrReturn(mRecording != nullptr);
+
+    if (mRecording->mHasReply || packet->HasChainedBuffer() || (packet->DataLength() > sizeof(mRecording->mReply)))
+    {
+        CancelRecord();
+        return;
+    }
+
+    memcpy(mRecording->mReply, packet->Start(), packet->DataLength());
+    mRecording->mReplyLength = packet->DataLength();
+    mRecording->mHasReply    = true;
+}
+
+void ResponseCache::CommitRecord(chip::System::Clock::Timestamp now)
+{
+    VerifyOrReturn(mRecording != nullptr);
+
+    mRecording->mValid    = true;
+    mRecording->mCreated  = now;
+    mRecording->mLastUsed = now;
+    mRecording            = nullptr;
+}
+
+void ResponseCache::Invalidate()
+{
+    for (Entry & entry : mEntries)
+    {
+        entry.mValid = false;
+    }
+    mRecording = nullptr;
+}
+
+} // namespace Minimal
+} // namespace mdns
+
+#endif // CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
@@ -0,0 +1,124 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <inet/InetInterface.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/dnssd/minimal_mdns/Parser.h>
+#include <lib/dnssd/minimal_mdns/responders/QueryResponder.h>
+#include <lib/support/Span.h>
+#include <system/SystemClock.h>
+#include <system/SystemPacketBuffer.h>
+
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+
+namespace mdns {
+namespace Minimal {
+
+/// Keeps the encoded replies to recent queries, so that a query that is asked again (as happens
+/// constantly on a busy network) is answered without walking all the query responders and
+/// encoding the records again.
+///
+/// Only replies that fit in a single packet and do not repeat the query are kept. An entry
+/// remembers which records it answered with, so that multicast replies are still throttled
+/// per record. Entries expire after kEntryLifetime, because interface addresses may change
+/// without the advertiser being told, and are all dropped by Invalidate().
+class ResponseCache
+{
+public:
+    static constexpr size_t kEntryCount   = CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE;
+    static constexpr size_t kMaxReplySize = 512;
+    static constexpr size_t kMaxAnswers   = 8;
+    static constexpr size_t kMaxNameSize  = 128;
+
+    static const chip::System::Clock::Milliseconds32 kEntryLifetime;
+
+    /// What a reply depends on, besides the records of the query responders.
+    class Key
+    {
+    public:
+        /// Returns false if the query cannot be used as a key (name too long or invalid).
+        bool Set(const QueryData & query, bool unicast, chip::Inet::InterfaceId interface);
+
+        bool operator==(const Key & other) const;
+
+    private:
+        QType mType                        = QType::ANY;
+        QClass mClass                      = QClass::IN;
+        bool mUnicast                      = false;
+        chip::Inet::InterfaceId mInterface = chip::Inet::InterfaceId::Null();
+        size_t mNameLength                 = 0;
+        uint8_t mName[kMaxNameSize]; // labels, each preceded by its length
+    };
+
+    class Entry
+    {
+    public:
+        /// The reply packet, empty if nothing was to be sent back.
+        chip::ByteSpan GetReply() const { return chip::ByteSpan(mReply, mReplyLength); }
+
+        /// Check if any answer of the reply was multicast at or after the given time.
+        bool WasMulticastSince(chip::System::Clock::Timestamp time) const;
+
+        /// Mark all the answers of the reply as multicast at the given time.
+        void SetMulticastTime(chip::System::Clock::Timestamp time);
+
+    private:
+        friend class ResponseCache;
+
+        Key mKey;
+        bool mValid                              = false;
+        chip::System::Clock::Timestamp mCreated  = chip::System::Clock::kZero;
+        chip::System::Clock::Timestamp mLastUsed = chip::System::Clock::kZero;
+        QueryResponderRecord * mAnswers[kMaxAnswers];
+        size_t mAnswerCount = 0;
+        size_t mReplyLength = 0;
+        bool mHasReply      = false;
+        uint8_t mReply[kMaxReplySize];
+    };
+
+    /// Find the reply to a query, nullptr if it is not cached or expired.
+    Entry * Find(const Key & key, chip::System::Clock::Timestamp now);
+
+    /// Start recording the reply to a query, reusing the least recently used entry.
+    void BeginRecord(const Key & key);
+
+    /// Record a record that is sent as an answer in the reply being recorded.
+    void RecordAnswer(QueryResponderRecord * record);
+
+    /// Record the reply packet. Replies split over several packets are not kept.
+    void RecordReply(const chip::System::PacketBufferHandle & packet);
+
+    /// Make the recorded reply visible to Find.
+    void CommitRecord(chip::System::Clock::Timestamp now);
+
+    void CancelRecord() { mRecording = nullptr; }
+    bool IsRecording() const { return mRecording != nullptr; }
+
+    /// Drop all entries, called whenever the records of the query responders change.
+    void Invalidate();
+
+private:
+    Entry mEntries[kEntryCount];
+    Entry * mRecording = nullptr;
+};
+
+} // namespace Minimal
+} // namespace mdns
+
+#endif // CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
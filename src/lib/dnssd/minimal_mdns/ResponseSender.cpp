@@ -35,6 +35,70 @@ constexpr uint16_t kMdnsStandardPort = 5353;
 //    the header.
 constexpr uint16_t kPacketSizeBytes = 512;
 
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+static_assert(kPacketSizeBytes <= ResponseCache::kMaxReplySize, "Cached replies must fit a whole reply packet");
+#endif
+
+/// Calls function(responder, info) for the records that may answer the query: all of them for
+/// advertisements, only those with the queried name otherwise.
+template <typename Function>
+CHIP_ERROR ForEachCandidateRecord(ResponderRegistry & responders, const QueryData & query, Function && function)
+{
+    if (query.IsInternalBroadcast())
+    {
+        return responders.ForEachRecord(function);
+    }
+    return responders.ForEachRecordNamed(query.GetName(), function);
+}
+
+/// Responders with records that answered the query being replied to.
+///
+/// Additional records can only be marked in these. Past kMaxTracked responders, all the
+/// registered responders are looked at instead.
+class AnsweringResponders
+{
+public:
+    static constexpr size_t kMaxTracked = 8;
+
+    void Add(QueryResponderBase * responder)
+    {
+        for (size_t i = 0; (i < mCount) && !mTrackAll; i++)
+        {
+            VerifyOrReturn(mResponders[i] != responder);
+        }
+
+        if (mCount < kMaxTracked)
+        {
+            mResponders[mCount++] = responder;
+        }
+        else
+        {
+            mTrackAll = true;
+        }
+    }
+
+    /// Calls function(responder) for all the answering responders, stopping at the first error returned.
+    template <typename Function>
+    CHIP_ERROR ForEach(ResponderRegistry & responders, Function && function)
+    {
+        if (mTrackAll)
+        {
+            return responders.ForEachResponder(function);
+        }
+
+        for (size_t i = 0; i < mCount; i++)
+        {
+            ReturnErrorOnFailure(function(mResponders[i]));
+        }
+        return CHIP_NO_ERROR;
+    }
+
+private:
+    QueryResponderBase * mResponders[kMaxTracked];
+    size_t mCount  = 0;
+    bool mTrackAll = false;
+};
+
 } // namespace
 namespace Internal {
 
@@ -52,52 +116,30 @@ bool ResponseSendingState::IncludeQuery() const
 
 CHIP_ERROR ResponseSender::AddQueryResponder(QueryResponderBase * queryResponder)
 {
-    // If already existing or we find a free slot, just use it
-    // Note that dynamic memory implementations are never expected to be nullptr
-    //
-    for (auto & responder : mResponders)
-    {
-        if (responder == nullptr || responder == queryResponder)
-        {
-            responder = queryResponder;
-            return CHIP_NO_ERROR;
-        }
-    }
-
-#if CHIP_CONFIG_MINMDNS_DYNAMIC_OPERATIONAL_RESPONDER_LIST
-    mResponders.push_back(queryResponder);
-    return CHIP_NO_ERROR;
-#else
-    return CHIP_ERROR_NO_MEMORY;
-#endif
+    return mResponders.Add(queryResponder);
 }
 
 CHIP_ERROR ResponseSender::RemoveQueryResponder(QueryResponderBase * queryResponder)
 {
-    for (auto it = mResponders.begin(); it != mResponders.end(); it++)
-    {
-        if (*it == queryResponder)
-        {
-            *it = nullptr;
-#if CHIP_CONFIG_MINMDNS_DYNAMIC_OPERATIONAL_RESPONDER_LIST
-            mResponders.erase(it);
-#endif
-            return CHIP_NO_ERROR;
-        }
-    }
-    return CHIP_ERROR_NOT_FOUND;
+    return mResponders.Remove(queryResponder);
 }
 
 bool ResponseSender::HasQueryResponders() const
 {
-    for (auto responder : mResponders)
-    {
-        if (responder != nullptr)
+    return !mResponders.IsEmpty();
+}
+
+QueryResponderBase * ResponseSender::FindQueryResponder(QType qtype, const FullQName & qname)
+{
+    QueryResponderBase * found = nullptr;
+    mResponders.ForEachRecordNamed(qname, [&](QueryResponderBase * responder, Internal::QueryResponderInfo * info) {
+        if ((found == nullptr) && (info->responder->GetQType() == qtype))
         {
-            return true;
+            found = responder;
         }
-    }
-    return false;
+        return CHIP_NO_ERROR;
+    });
+    return found;
 }
 
 CHIP_ERROR ResponseSender::Respond(uint32_t messageId, const QueryData & query, const chip::Inet::IPPacketInfo * querySource,
@@ -105,23 +147,47 @@ CHIP_ERROR ResponseSender::Respond(uint32_t messageId, const QueryData & query,
 {
     mSendState.Reset(messageId, query, querySource);
 
-    // Responder has a stateful 'additional replies required' that is used within the response
-    // loop. 'no additionals required' is set at the start and additionals are marked as the query
-    // reply is built.
-    for (auto & responder : mResponders)
+    const chip::System::Clock::Timestamp kTimeNow = chip::System::SystemClock().GetMonotonicTimestamp();
+
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+    if (mResponseCacheGeneration != mResponders.GetGeneration())
+    {
+        mResponseCache.Invalidate();
+        mResponseCacheGeneration = mResponders.GetGeneration();
+    }
+
+    // Replies that repeat the query, advertisements and replies with adjusted TTLs are not cached
+    ResponseCache::Key cacheKey;
+    mResponseCache.CancelRecord();
+    if (!query.IsInternalBroadcast() && !mSendState.IncludeQuery() && !configuration.GetTtlSecondsOverride().HasValue() &&
+        cacheKey.Set(query, mSendState.SendUnicast(), querySource->Interface))
     {
+        const chip::System::Clock::Timestamp multicastBefore = kTimeNow - chip::System::Clock::Seconds32(1);
+        ResponseCache::Entry * cached                        = mResponseCache.Find(cacheKey, kTimeNow);
+
+        if (cached == nullptr)
         {
-            if (responder != nullptr)
+            // A reply missing answers that were multicast too recently is not the usual reply to this query
+            if (mSendState.SendUnicast() || !HasThrottledAnswers(query, multicastBefore))
             {
-                responder->ResetAdditionals();
+                mResponseCache.BeginRecord(cacheKey);
             }
         }
+        else if (mSendState.SendUnicast() || !cached->WasMulticastSince(multicastBefore))
+        {
+            return SendCachedReply(*cached, kTimeNow);
+        }
     }
+#endif
+
+    // Responders have a stateful 'additional replies required' that is used within the response
+    // loop. Additionals are marked as the query reply is built, and only responders that answered
+    // the query may have some. The marks are cleared once the reply is built.
+    AnsweringResponders answeringResponders;
+    CHIP_ERROR err = CHIP_NO_ERROR;
 
     // send all 'Answer' replies
     {
-        const chip::System::Clock::Timestamp kTimeNow = chip::System::SystemClock().GetMonotonicTimestamp();
-
         QueryReplyFilter queryReplyFilter(query);
         QueryResponderRecordFilter responseFilter;
 
@@ -135,28 +201,30 @@ CHIP_ERROR ResponseSender::Respond(uint32_t messageId, const QueryData & query,
             //       broadcasts on one interface to throttle broadcasts on another interface.
             responseFilter.SetIncludeOnlyMulticastBeforeMS(kTimeNow - chip::System::Clock::Seconds32(1));
         }
-        for (auto & responder : mResponders)
-        {
-            if (responder == nullptr)
-            {
-                continue;
-            }
-            for (auto it = responder->begin(&responseFilter); it != responder->end(); it++)
-            {
-                it->responder->AddAllResponses(querySource, this, configuration);
-                ReturnErrorOnFailure(mSendState.GetError());
 
-                responder->MarkAdditionalRepliesFor(it);
+        err = ForEachCandidateRecord(mResponders, query, [&](QueryResponderBase * responder, Internal::QueryResponderInfo * info) {
+            VerifyOrReturnError(responseFilter.Accept(info), CHIP_NO_ERROR);
+
+            info->responder->AddAllResponses(querySource, this, configuration);
+            ReturnErrorOnFailure(mSendState.GetError());
 
-                if (!mSendState.SendUnicast())
-                {
-                    it->lastMulticastTime = kTimeNow;
-                }
+            responder->MarkAdditionalRepliesFor(info);
+            answeringResponders.Add(responder);
+
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+            mResponseCache.RecordAnswer(info);
+#endif
+
+            if (!mSendState.SendUnicast())
+            {
+                info->lastMulticastTime = kTimeNow;
             }
-        }
+            return CHIP_NO_ERROR;
+        });
     }
 
     // send all 'Additional' replies
+    if (err == CHIP_NO_ERROR)
     {
         mSendState.SetResourceType(ResourceType::kAdditional);
 
@@ -168,21 +236,30 @@ CHIP_ERROR ResponseSender::Respond(uint32_t messageId, const QueryData & query,
         responseFilter
             .SetReplyFilter(&queryReplyFilter) //
             .SetIncludeAdditionalRepliesOnly(true);
-        for (auto & responder : mResponders)
-        {
-            if (responder == nullptr)
-            {
-                continue;
-            }
+
+        err = answeringResponders.ForEach(mResponders, [&](QueryResponderBase * responder) {
             for (auto it = responder->begin(&responseFilter); it != responder->end(); it++)
             {
                 it->responder->AddAllResponses(querySource, this, configuration);
                 ReturnErrorOnFailure(mSendState.GetError());
             }
-        }
+            return CHIP_NO_ERROR;
+        });
     }
 
-    return FlushReply();
+    answeringResponders.ForEach(mResponders, [](QueryResponderBase * responder) {
+        responder->ResetAdditionals();
+        return CHIP_NO_ERROR;
+    });
+    ReturnErrorOnFailure(err);
+
+    ReturnErrorOnFailure(FlushReply());
+
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+    mResponseCache.CommitRecord(kTimeNow);
+#endif
+
+    return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR ResponseSender::FlushReply()
@@ -191,29 +268,37 @@ CHIP_ERROR ResponseSender::FlushReply()
 
     if (mResponseBuilder.HasResponseRecords())
     {
-        char srcAddressString[chip::Inet::IPAddress::kMaxStringLength];
-        VerifyOrDie(mSendState.GetSourceAddress().ToString(srcAddressString) != nullptr);
+        chip::System::PacketBufferHandle packet = mResponseBuilder.ReleasePacket();
 
-        if (mSendState.SendUnicast())
-        {
-#if CHIP_MINMDNS_HIGH_VERBOSITY
-            ChipLogDetail(Discovery, "Directly sending mDns reply to peer %s on port %d", srcAddressString,
-                          mSendState.GetSourcePort());
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+        mResponseCache.RecordReply(packet);
 #endif
-            ReturnErrorOnFailure(mServer->DirectSend(mResponseBuilder.ReleasePacket(), mSendState.GetSourceAddress(),
-                                                     mSendState.GetSourcePort(), mSendState.GetSourceInterfaceId()));
-        }
-        else
-        {
+
+        return SendReply(std::move(packet));
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ResponseSender::SendReply(chip::System::PacketBufferHandle && packet)
+{
+    char srcAddressString[chip::Inet::IPAddress::kMaxStringLength];
+    VerifyOrDie(mSendState.GetSourceAddress().ToString(srcAddressString) != nullptr);
+
+    if (mSendState.SendUnicast())
+    {
 #if CHIP_MINMDNS_HIGH_VERBOSITY
-            ChipLogDetail(Discovery, "Broadcasting mDns reply for query from %s", srcAddressString);
+        ChipLogDetail(Discovery, "Directly sending mDns reply to peer %s on port %d", srcAddressString, mSendState.GetSourcePort());
 #endif
-            ReturnErrorOnFailure(mServer->BroadcastSend(mResponseBuilder.ReleasePacket(), kMdnsStandardPort,
-                                                        mSendState.GetSourceInterfaceId(), mSendState.GetSourceAddress().Type()));
-        }
+        return mServer->DirectSend(std::move(packet), mSendState.GetSourceAddress(), mSendState.GetSourcePort(),
+                                   mSendState.GetSourceInterfaceId());
     }
 
-    return CHIP_NO_ERROR;
+#if CHIP_MINMDNS_HIGH_VERBOSITY
+    ChipLogDetail(Discovery, "Broadcasting mDns reply for query from %s", srcAddressString);
+#endif
+    return mServer->BroadcastSend(std::move(packet), kMdnsStandardPort, mSendState.GetSourceInterfaceId(),
+                                  mSendState.GetSourceAddress().Type());
 }
 
 CHIP_ERROR ResponseSender::PrepareNewReplyPacket()
@@ -270,5 +355,38 @@ void ResponseSender::AddResponse(const ResourceRecord & record)
     }
 }
 
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+CHIP_ERROR ResponseSender::SendCachedReply(ResponseCache::Entry & entry, chip::System::Clock::Timestamp now)
+{
+    chip::ByteSpan reply = entry.GetReply();
+    ReturnErrorCodeIf(reply.empty(), CHIP_NO_ERROR); // nothing to reply
+
+    chip::System::PacketBufferHandle packet = chip::System::PacketBufferHandle::NewWithData(reply.data(), reply.size());
+    ReturnErrorCodeIf(packet.IsNull(), CHIP_ERROR_NO_MEMORY);
+    HeaderRef(packet->Start()).SetMessageId(mSendState.GetMessageId());
+
+    if (!mSendState.SendUnicast())
+    {
+        entry.SetMulticastTime(now);
+    }
+
+    return SendReply(std::move(packet));
+}
+
+bool ResponseSender::HasThrottledAnswers(const QueryData & query, chip::System::Clock::Timestamp multicastBefore)
+{
+    QueryReplyFilter queryReplyFilter(query);
+    QueryResponderRecordFilter responseFilter;
+    responseFilter.SetReplyFilter(&queryReplyFilter);
+
+    bool throttled = false;
+    ForEachCandidateRecord(mResponders, query, [&](QueryResponderBase * responder, Internal::QueryResponderInfo * info) {
+        throttled = throttled || (responseFilter.Accept(info) && (info->lastMulticastTime >= multicastBefore));
+        return CHIP_NO_ERROR;
+    });
+    return throttled;
+}
+#endif
+
 } // namespace Minimal
 } // namespace mdns
@@ -18,30 +18,15 @@
 #pragma once
 
 #include "Parser.h"
+#include "ResponderRegistry.h"
 #include "ResponseBuilder.h"
+#include "ResponseCache.h"
 #include "Server.h"
 
 #include <lib/dnssd/minimal_mdns/responders/QueryResponder.h>
 
 #include <system/SystemPacketBuffer.h>
 
-#if CHIP_CONFIG_MINMDNS_DYNAMIC_OPERATIONAL_RESPONDER_LIST
-
-#include <list>
-using QueryResponderPtrPool = std::list<mdns::Minimal::QueryResponderBase *>;
-#else
-
-#include <array>
-
-// Note: ptr storage is 2 + number of operational networks required, based on
-// the current implementation of Advertiser_ImplMinimalMdns.cpp:
-//    - 1 for commissionable advertising
-//    - 1 for commissioner responder
-//    - extra for every operational advertisement
-using QueryResponderPtrPool = std::array<mdns::Minimal::QueryResponderBase *, CHIP_CONFIG_MAX_FABRICS + 2>;
-
-#endif
-
 namespace mdns {
 namespace Minimal {
 
@@ -102,6 +87,13 @@ private:
 ///
 /// Handles processing the query via a QueryResponderBase and then sending back the reply
 /// using appropriate paths (unicast or multicast) via the given Server.
+///
+/// Query responders are kept in a ResponderRegistry, which finds the records answering
+/// a query by name.
+///
+/// Replies to queries are kept in a ResponseCache (if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE
+/// is not 0). The cache is dropped when records are added or removed; InvalidateResponseCache
+/// must be called when anything else the replies depend on changes.
 class ResponseSender : public ResponderDelegate
 {
 public:
@@ -120,16 +112,39 @@ public:
 
     void SetServer(ServerBase * server) { mServer = server; }
 
+    /// Find the query responder with a record of the given type and name, nullptr if none.
+    QueryResponderBase * FindQueryResponder(QType qtype, const FullQName & qname);
+
+    /// Drop the cached replies, to be called whenever something that the replies depend on
+    /// changes, other than which records the query responders have (e.g. interface addresses).
+    void InvalidateResponseCache()
+    {
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+        mResponseCache.Invalidate();
+#endif
+    }
+
 private:
     CHIP_ERROR FlushReply();
+    CHIP_ERROR SendReply(chip::System::PacketBufferHandle && packet);
     CHIP_ERROR PrepareNewReplyPacket();
 
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+    CHIP_ERROR SendCachedReply(ResponseCache::Entry & entry, chip::System::Clock::Timestamp now);
+    bool HasThrottledAnswers(const QueryData & query, chip::System::Clock::Timestamp multicastBefore);
+#endif
+
     ServerBase * mServer;
-    QueryResponderPtrPool mResponders = {};
+    ResponderRegistry mResponders;
 
     /// Current send state
     ResponseBuilder mResponseBuilder;          // packet being built
     Internal::ResponseSendingState mSendState; // sending state
+
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+    ResponseCache mResponseCache;
+    uint32_t mResponseCacheGeneration = 0; // generation of mResponders that the cached replies were built from
+#endif
 };
 
 } // namespace Minimal
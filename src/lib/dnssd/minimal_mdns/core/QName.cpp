@@ -61,9 +61,9 @@ bool SerializedQNameIterator::Next(bool followIndirectPointers)
             }
 
             size_t offset = ((*mCurrentPosition & 0x3F) << 8) | *(mCurrentPosition + 1);
-            if (offset > mLookBehindMax)
+            if (offset >= mLookBehindMax)
             {
-                // Potential infinite recursion.
+                // Potential infinite recursion: every pointer has to go further back than the previous one.
                 mIsValid = false;
                 return false;
             }
@@ -163,6 +163,16 @@ void InvalidReferencing(nlTestSuite * inSuite, void * inContext)
         NL_TEST_ASSERT(inSuite, !it.IsValid());
     }
 
+    {
+        // Infinite recursion by referencing the same element again
+        static const uint8_t kData[] = "\03abc\xc0\x00\xc0\x00";
+        SerializedQNameIterator it(BytesRange(kData, kData + sizeof(kData) - 1), kData + 6);
+
+        NL_TEST_ASSERT(inSuite, it.Next());
+        NL_TEST_ASSERT(inSuite, !it.Next());
+        NL_TEST_ASSERT(inSuite, !it.IsValid());
+    }
+
     {
         // Reference that goes forwad instead of backward
         static const uint8_t kData[] = "\03test\xc0\x07";
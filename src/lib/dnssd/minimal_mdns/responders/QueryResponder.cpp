@@ -31,6 +31,14 @@ QueryResponderBase::QueryResponderBase(Internal::QueryResponderInfo * infos, siz
     Responder(QType::PTR, FullQName(kDnsSdQueryPath)), mResponderInfos(infos), mResponderInfoSize(infoSizes)
 {}
 
+QueryResponderBase::~QueryResponderBase()
+{
+    if (mChangeDelegate != nullptr)
+    {
+        mChangeDelegate->OnRecordsRemoved(this);
+    }
+}
+
 void QueryResponderBase::Init()
 {
     for (size_t i = 0; i < mResponderInfoSize; i++)
@@ -38,10 +46,20 @@ void QueryResponderBase::Init()
         mResponderInfos[i].Clear();
     }
 
+    if (mChangeDelegate != nullptr)
+    {
+        mChangeDelegate->OnRecordsRemoved(this);
+    }
+
     if (mResponderInfoSize > 0)
     {
         // reply to queries about services available
         mResponderInfos[0].responder = this;
+
+        if (mChangeDelegate != nullptr)
+        {
+            mChangeDelegate->OnRecordAdded(this, &mResponderInfos[0]);
+        }
     }
 
     if (mResponderInfoSize < 2)
@@ -66,6 +84,11 @@ QueryResponderSettings QueryResponderBase::AddResponder(RecordResponder * respon
             mResponderInfos[i].Clear();
             mResponderInfos[i].responder = responder;
 
+            if (mChangeDelegate != nullptr)
+            {
+                mChangeDelegate->OnRecordAdded(this, &mResponderInfos[i]);
+            }
+
             return QueryResponderSettings(&mResponderInfos[i]);
         }
     }
@@ -106,10 +129,8 @@ size_t QueryResponderBase::MarkAdditional(const FullQName & qname)
     return count;
 }
 
-void QueryResponderBase::MarkAdditionalRepliesFor(QueryResponderIterator it)
+void QueryResponderBase::MarkAdditionalRepliesFor(Internal::QueryResponderInfo * info)
 {
-    Internal::QueryResponderInfo * info = it.GetInternal();
-
     if (!info->alsoReportAdditionalQName)
     {
         return; // nothing additional to report
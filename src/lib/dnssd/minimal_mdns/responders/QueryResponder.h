@@ -21,6 +21,7 @@
 #include "ReplyFilter.h"
 #include "Responder.h"
 
+#include <lib/support/IntrusiveList.h>
 #include <system/SystemClock.h>
 
 namespace mdns {
@@ -55,6 +56,22 @@ struct QueryResponderInfo : public QueryResponderRecord
 
 } // namespace Internal
 
+class QueryResponderBase;
+
+/// Notified of changes to the records of a QueryResponderBase, to keep indexes
+/// of the records up to date.
+class QueryResponderChangeDelegate
+{
+public:
+    virtual ~QueryResponderChangeDelegate() {}
+
+    /// A record was added to the responder.
+    virtual void OnRecordAdded(QueryResponderBase * responder, Internal::QueryResponderInfo * info) = 0;
+
+    /// Records were removed from the responder, or the responder is being destroyed.
+    virtual void OnRecordsRemoved(QueryResponderBase * responder) = 0;
+};
+
 /// Allows building query responder configuration
 class QueryResponderSettings
 {
@@ -234,12 +251,16 @@ private:
 ///
 /// Maintains a stateful list of 'additional replies' that can be marked/unmarked
 /// for query processing
-class QueryResponderBase : public Responder // "_services._dns-sd._udp.local"
+///
+/// Responders are linked into the ResponderRegistry of the ResponseSender they are
+/// added to, and unlink themselves when destroyed.
+class QueryResponderBase : public Responder, // "_services._dns-sd._udp.local"
+                           public chip::IntrusiveListNodeBase<chip::IntrusiveMode::AutoUnlink>
 {
 public:
     /// Builds a new responder with the given storage for the response infos
     QueryResponderBase(Internal::QueryResponderInfo * infos, size_t infoSizes);
-    ~QueryResponderBase() override {}
+    ~QueryResponderBase() override;
 
     /// Setup initial settings (clears all infos and sets up dns-sd query replies)
     void Init();
@@ -269,15 +290,23 @@ public:
     size_t MarkAdditional(const FullQName & qname);
 
     /// Flag any additional responses required for the given iterator
-    void MarkAdditionalRepliesFor(QueryResponderIterator it);
+    void MarkAdditionalRepliesFor(QueryResponderIterator it) { MarkAdditionalRepliesFor(it.GetInternal()); }
+
+    /// Flag any additional responses required for the given record of this responder
+    void MarkAdditionalRepliesFor(Internal::QueryResponderInfo * info);
 
     /// Resets the internal broadcast throttle setting to allow re-broadcasting
     /// of all packets without a timedelay.
     void ClearBroadcastThrottle();
 
+    /// Set what gets notified of record changes, nullptr for nothing.
+    void SetChangeDelegate(QueryResponderChangeDelegate * delegate) { mChangeDelegate = delegate; }
+    QueryResponderChangeDelegate * GetChangeDelegate() const { return mChangeDelegate; }
+
 private:
     Internal::QueryResponderInfo * mResponderInfos;
     size_t mResponderInfoSize;
+    QueryResponderChangeDelegate * mChangeDelegate = nullptr;
 };
 
 template <size_t kSize>
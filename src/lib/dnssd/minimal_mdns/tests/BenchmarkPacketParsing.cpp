@@ -0,0 +1,330 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Measures the throughput of mDNS packet parsing, comparing the two ParsePacket
+ *      passes that the resolver used to make over every packet (SRV records, then the
+ *      other records) with indexing the packet once and walking the index twice.
+ *
+ *      Packets are read from pcap captures of mDNS traffic given on the command line
+ *      (UDP port 5353 over Ethernet, Linux cooked or raw IP links), or built-in
+ *      sample packets are used.
+ */
+
+#include <lib/core/CHIPEncoding.h>
+#include <lib/dnssd/minimal_mdns/PacketIndex.h>
+#include <lib/dnssd/minimal_mdns/Parser.h>
+#include <lib/dnssd/minimal_mdns/RecordData.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+using namespace mdns::Minimal;
+using chip::Encoding::BigEndian::Get16;
+
+using Packet = std::vector<uint8_t>;
+
+constexpr size_t kDefaultIterations = 100000;
+constexpr uint16_t kMdnsPort        = 5353;
+
+// A reply to an operational browse: PTR answer, SRV, TXT and AAAA additional records
+const uint8_t kOperationalReply[] = {
+    0x00, 0x00, 0x84, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x03,
+    // _matter._tcp.local PTR
+    0x07, '_', 'm', 'a', 't', 't', 'e', 'r', 0x04, '_', 't', 'c', 'p', 0x05, 'l', 'o', 'c', 'a', 'l', 0x00, //
+    0x00, 0x0C, 0x00, 0x01, 0x00, 0x00, 0x11, 0x94, 0x00, 0x24,                                           //
+    0x21, '2', '9', '0', '6', 'C', '9', '0', '8', 'D', '1', '1', '5', 'D', '3', '6', '2', '-', '0', '0', '0', '0', '0',
+    '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '1', 0xC0, 0x0C,
+    // instance SRV
+    0xC0, 0x2A, 0x00, 0x21, 0x80, 0x01, 0x00, 0x00, 0x00, 0x78, 0x00, 0x19, //
+    0x00, 0x00, 0x00, 0x00, 0x15, 0xA4,                                     //
+    0x10, 'D', 'C', 'A', '6', '3', '2', 'A', 'C', '6', '3', 'D', 'D', 'B', '6', '8', '7', 0xC0, 0x19,
+    // instance TXT
+    0xC0, 0x2A, 0x00, 0x10, 0x80, 0x01, 0x00, 0x00, 0x11, 0x94, 0x00, 0x10, //
+    0x07, 'S', 'I', 'I', '=', '5', '0', '0', 0x07, 'S', 'A', 'I', '=', '3', '0', '0',
+    // host AAAA
+    0xC0, 0x60, 0x00, 0x1C, 0x80, 0x01, 0x00, 0x00, 0x00, 0x78, 0x00, 0x10, //
+    0xFE, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x11, 0x22, 0xFF, 0xFE, 0x33, 0x44, 0x55,
+};
+
+// A browse query for commissionable nodes, with a known answer
+const uint8_t kBrowseQuery[] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00,
+    // _matterc._udp.local PTR
+    0x08, '_', 'm', 'a', 't', 't', 'e', 'r', 'c', 0x04, '_', 'u', 'd', 'p', 0x05, 'l', 'o', 'c', 'a', 'l', 0x00, //
+    0x00, 0x0C, 0x00, 0x01,                                                                                     //
+    // known answer
+    0xC0, 0x0C, 0x00, 0x0C, 0x00, 0x01, 0x00, 0x00, 0x11, 0x00, 0x00, 0x13, //
+    0x10, '4', '2', 'B', '5', '0', 'F', '4', '4', '9', '8', '1', '0', 'C', '3', 'F', '1', 0xC0, 0x0C,
+};
+
+/// Extract the mDNS payloads of a pcap capture. Returns false if the file cannot be read.
+bool LoadCapture(const char * path, std::vector<Packet> & packets)
+{
+    FILE * file = fopen(path, "rb");
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    std::vector<uint8_t> capture;
+    uint8_t buffer[4096];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    {
+        capture.insert(capture.end(), buffer, buffer + read);
+    }
+    fclose(file);
+
+    if (capture.size() < 24)
+    {
+        return false;
+    }
+
+    // Captures are written in the byte order of the capturing host
+    const uint32_t magic = chip::Encoding::LittleEndian::Get32(capture.data());
+    const bool swapped   = (magic == 0xD4C3B2A1) || (magic == 0x4D3CB2A1);
+    if (!swapped && (magic != 0xA1B2C3D4) && (magic != 0xA1B23C4D))
+    {
+        return false;
+    }
+    auto get32 = [swapped](const uint8_t * p) {
+        return swapped ? chip::Encoding::BigEndian::Get32(p) : chip::Encoding::LittleEndian::Get32(p);
+    };
+
+    const uint32_t linkType = get32(capture.data() + 20);
+    size_t offset           = 24;
+
+    while (offset + 16 <= capture.size())
+    {
+        const size_t length   = get32(capture.data() + offset + 8);
+        const uint8_t * frame = capture.data() + offset + 16;
+        offset += 16 + length;
+        if (offset > capture.size())
+        {
+            break;
+        }
+
+        // Link layer
+        size_t ip          = 0;
+        uint16_t etherType = 0;
+        switch (linkType)
+        {
+        case 1: // Ethernet
+            ip        = 14;
+            etherType = (length >= ip) ? Get16(frame + 12) : 0;
+            if ((etherType == 0x8100) && (length >= ip + 4)) // VLAN tag
+            {
+                etherType = Get16(frame + 16);
+                ip += 4;
+            }
+            break;
+        case 113: // Linux cooked
+            ip        = 16;
+            etherType = (length >= ip) ? Get16(frame + 14) : 0;
+            break;
+        case 101: // Raw IP
+            etherType = (length > 0) ? (((frame[0] >> 4) == 6) ? 0x86DD : 0x0800) : 0;
+            break;
+        default:
+            fprintf(stderr, "%s: unsupported link type %u\n", path, static_cast<unsigned>(linkType));
+            return false;
+        }
+
+        // Network layer, IPv6 extension headers are not supported
+        size_t udp = 0;
+        if ((etherType == 0x0800) && (length >= ip + 20) && (frame[ip + 9] == 17))
+        {
+            udp = ip + static_cast<size_t>((frame[ip] & 0x0F) * 4);
+        }
+        else if ((etherType == 0x86DD) && (length >= ip + 40) && (frame[ip + 6] == 17))
+        {
+            udp = ip + 40;
+        }
+        if ((udp == 0) || (length < udp + 8))
+        {
+            continue;
+        }
+
+        if ((Get16(frame + udp) != kMdnsPort) && (Get16(frame + udp + 2) != kMdnsPort))
+        {
+            continue;
+        }
+        packets.emplace_back(frame + udp + 8, frame + length);
+    }
+
+    return true;
+}
+
+/// Does the work the resolver does on every record, short of resolving: records are
+/// walked twice (SRV records, then the others) and their names are read.
+class BenchmarkDelegate : public ParserDelegate
+{
+public:
+    BenchmarkDelegate(const BytesRange & packet, bool srvPass) : mPacket(packet), mSrvPass(srvPass) {}
+
+    void OnHeader(ConstHeaderRef & header) override {}
+    void OnQuery(const QueryData & data) override {}
+    void OnResource(ResourceType type, const ResourceData & data) override
+    {
+        if (mSrvPass == (data.GetType() == QType::SRV))
+        {
+            mChecksum += Process(mPacket, data);
+        }
+    }
+
+    static size_t Process(const BytesRange & packet, const ResourceData & data)
+    {
+        size_t checksum              = static_cast<size_t>(data.GetType());
+        SerializedQNameIterator name = data.GetName();
+        while (name.Next())
+        {
+            checksum += strlen(name.Value());
+        }
+
+        SrvRecord srv;
+        if ((data.GetType() == QType::SRV) && srv.Parse(data.GetData(), packet))
+        {
+            checksum += srv.GetPort();
+        }
+        return checksum;
+    }
+
+    size_t GetChecksum() const { return mChecksum; }
+
+private:
+    BytesRange mPacket;
+    bool mSrvPass;
+    size_t mChecksum = 0;
+};
+
+size_t ParseTwice(const BytesRange & packet)
+{
+    BenchmarkDelegate srvPass(packet, true);
+    BenchmarkDelegate otherPass(packet, false);
+    ParsePacket(packet, &srvPass);
+    ParsePacket(packet, &otherPass);
+    return srvPass.GetChecksum() + otherPass.GetChecksum();
+}
+
+size_t IndexOnce(PacketIndex & index, const BytesRange & packet)
+{
+    size_t checksum = 0;
+    index.Index(packet);
+
+    // Packets larger than the index are walked a window at a time, as the resolver does
+    for (bool srvPass : { true, false })
+    {
+        if (index.GetFirstEntry() != 0)
+        {
+            index.Index(packet);
+        }
+        while (true)
+        {
+            index.ForEachResource([&](ResourceType, const ResourceData & data) {
+                if (srvPass == (data.GetType() == QType::SRV))
+                {
+                    checksum += BenchmarkDelegate::Process(packet, data);
+                }
+            });
+            if (!index.IsValid() || !index.IsTruncated())
+            {
+                break;
+            }
+            index.Index(packet, index.GetNextEntry());
+        }
+    }
+    return checksum;
+}
+
+template <typename Function>
+double Measure(const std::vector<Packet> & packets, size_t iterations, size_t & checksum, Function && function)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++)
+    {
+        for (const Packet & packet : packets)
+        {
+            checksum += function(BytesRange(packet.data(), packet.data() + packet.size()));
+        }
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    size_t iterations = kDefaultIterations;
+    std::vector<Packet> packets;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "--iterations") == 0) && (i + 1 < argc))
+        {
+            iterations = strtoul(argv[++i], nullptr, 10);
+        }
+        else if (!LoadCapture(argv[i], packets))
+        {
+            fprintf(stderr, "Usage: %s [--iterations N] [capture.pcap ...]\n", argv[0]);
+            fprintf(stderr, "Cannot read pcap capture %s\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (packets.empty())
+    {
+        packets.emplace_back(kOperationalReply, kOperationalReply + sizeof(kOperationalReply));
+        packets.emplace_back(kBrowseQuery, kBrowseQuery + sizeof(kBrowseQuery));
+    }
+
+    size_t bytes = 0;
+    for (const Packet & packet : packets)
+    {
+        bytes += packet.size();
+    }
+    printf("%zu packets, %zu bytes, %zu iterations\n", packets.size(), bytes, iterations);
+
+    size_t parseChecksum = 0;
+    size_t indexChecksum = 0;
+    PacketIndex index;
+
+    const double parseTime = Measure(packets, iterations, parseChecksum, ParseTwice);
+    const double indexTime = Measure(packets, iterations, indexChecksum,
+                                     [&index](const BytesRange & packet) { return IndexOnce(index, packet); });
+
+    const double total = static_cast<double>(packets.size() * iterations);
+    printf("ParsePacket, 2 passes:   %10.0f packets/s  %8.1f MB/s\n", total / parseTime,
+           static_cast<double>(bytes * iterations) / parseTime / 1e6);
+    printf("PacketIndex, 1 pass:     %10.0f packets/s  %8.1f MB/s\n", total / indexTime,
+           static_cast<double>(bytes * iterations) / indexTime / 1e6);
+
+    if (parseChecksum != indexChecksum)
+    {
+        fprintf(stderr, "Mismatch between ParsePacket and PacketIndex results\n");
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
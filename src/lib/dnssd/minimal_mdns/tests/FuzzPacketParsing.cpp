@@ -1,8 +1,12 @@
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <limits>
 
+#include <lib/dnssd/minimal_mdns/PacketIndex.h>
 #include <lib/dnssd/minimal_mdns/Parser.h>
 #include <lib/dnssd/minimal_mdns/RecordData.h>
+#include <lib/support/CodeUtils.h>
 
 namespace {
 
@@ -51,6 +55,83 @@ private:
     mdns::Minimal::BytesRange mPacketRange;
 };
 
+bool SameName(SerializedQNameIterator a, SerializedQNameIterator b)
+{
+    while (true)
+    {
+        const bool hasA = a.Next();
+        const bool hasB = b.Next();
+        if ((hasA != hasB) || (a.IsValid() != b.IsValid()))
+        {
+            return false;
+        }
+        if (!hasA)
+        {
+            return true;
+        }
+        if (strcmp(a.Value(), b.Value()) != 0)
+        {
+            return false;
+        }
+    }
+}
+
+/// Checks that PacketIndex finds the same queries and records as ParsePacket.
+class IndexCheckDelegate : public ParserDelegate
+{
+public:
+    IndexCheckDelegate(const BytesRange & packet) : mPacketRange(packet) { mIndex.Index(packet); }
+
+    void OnHeader(ConstHeaderRef & header) override { VerifyOrDie(mIndex.HasHeader()); }
+
+    void OnQuery(const QueryData & data) override
+    {
+        VerifyOrDie(NextEntry() && mIndex.IsQuery(mEntry));
+
+        const QueryData indexed = mIndex.GetQuery(mEntry++);
+        VerifyOrDie(indexed.GetType() == data.GetType());
+        VerifyOrDie(indexed.GetClass() == data.GetClass());
+        VerifyOrDie(indexed.RequestedUnicastAnswer() == data.RequestedUnicastAnswer());
+        VerifyOrDie(SameName(indexed.GetName(), data.GetName()));
+    }
+
+    void OnResource(ResourceType type, const ResourceData & data) override
+    {
+        VerifyOrDie(NextEntry() && !mIndex.IsQuery(mEntry) && (mIndex.GetResourceType(mEntry) == type));
+
+        const ResourceData indexed = mIndex.GetResource(mEntry++);
+        VerifyOrDie(indexed.GetType() == data.GetType());
+        VerifyOrDie(indexed.GetClass() == data.GetClass());
+        VerifyOrDie(indexed.GetTtlSeconds() == data.GetTtlSeconds());
+        VerifyOrDie(indexed.GetData().Start() == data.GetData().Start());
+        VerifyOrDie(indexed.GetData().End() == data.GetData().End());
+        VerifyOrDie(SameName(indexed.GetName(), data.GetName()));
+    }
+
+    /// Called once ParsePacket is done: the index must hold no other entry and agree on the packet validity.
+    void CheckEnd(bool parsed)
+    {
+        VerifyOrDie(!NextEntry() && !mIndex.IsTruncated());
+        VerifyOrDie(mIndex.IsValid() == parsed);
+    }
+
+private:
+    /// Moves to the next window of the index once all the indexed entries have been checked.
+    bool NextEntry()
+    {
+        if ((mEntry == mIndex.GetEntryCount()) && mIndex.IsTruncated())
+        {
+            mIndex.Index(mPacketRange, mIndex.GetNextEntry());
+            mEntry = 0;
+        }
+        return mEntry < mIndex.GetEntryCount();
+    }
+
+    mdns::Minimal::BytesRange mPacketRange;
+    PacketIndex mIndex;
+    size_t mEntry = 0;
+};
+
 } // namespace
 
 extern "C" int LLVMFuzzerTestOneInput(const uint8_t * data, size_t len)
@@ -61,5 +142,12 @@ extern "C" int LLVMFuzzerTestOneInput(const uint8_t * data, size_t len)
 
     mdns::Minimal::ParsePacket(packet, &delegate);
 
+    // The index only takes packets that its 16 bit offsets can address
+    if (len <= std::numeric_limits<uint16_t>::max())
+    {
+        IndexCheckDelegate indexCheck(packet);
+        indexCheck.CheckEnd(mdns::Minimal::ParsePacket(packet, &indexCheck));
+    }
+
     return 0;
 }
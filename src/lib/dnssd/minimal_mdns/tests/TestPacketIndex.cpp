@@ -0,0 +1,217 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <lib/dnssd/minimal_mdns/PacketIndex.h>
+
+#include <lib/dnssd/minimal_mdns/RecordData.h>
+#include <lib/support/BufferWriter.h>
+#include <lib/support/UnitTestRegistration.h>
+
+#include <string.h>
+
+#include <nlunit-test.h>
+
+namespace {
+
+using namespace chip;
+using namespace mdns::Minimal;
+
+// A unicast reply, repeating the query and using compressed names
+const uint8_t kReply[] = {
+    0x12, 0x34,                           // message id
+    0x84, 0x00,                           // response, authoritative
+    0, 1,                                 // queries
+    0, 1,                                 // answers
+    0, 0,                                 // authority
+    0, 1,                                 // additional
+    // 12: _matter._tcp.local
+    7, '_', 'm', 'a', 't', 't', 'e', 'r', //
+    4, '_', 't', 'c', 'p',                //
+    5, 'l', 'o', 'c', 'a', 'l',           //
+    0,                                    //
+    0, 12,                                // PTR
+    0x80, 1,                              // IN, unicast answer
+    // 36: _matter._tcp.local
+    0xC0, 12,                             //
+    0, 12,                                // PTR
+    0, 1,                                 // IN
+    0, 0, 0, 120,                         // TTL
+    0, 6,                                 // data length
+    3, 'a', 'b', 'c', 0xC0, 12,           // 48: abc._matter._tcp.local
+    // 54: abc._matter._tcp.local
+    0xC0, 48,                             //
+    0, 33,                                // SRV
+    0x80, 1,                              // IN, cache flush
+    0, 0, 0, 120,                         // TTL
+    0, 13,                                // data length
+    0, 0,                                 // priority
+    0, 0,                                 // weight
+    0x15, 0xA4,                           // port 5540
+    4, 'h', 'o', 's', 't', 0xC0, 25,      // host.local
+};
+
+constexpr size_t kPtrDataOffset = 48;
+constexpr size_t kSrvDataOffset = 66;
+
+const QNamePart kServiceName[]  = { "_matter", "_tcp", "local" };
+const QNamePart kInstanceName[] = { "abc", "_matter", "_tcp", "local" };
+const QNamePart kHostName[]     = { "host", "local" };
+
+/// Builds a query for _matter._tcp.local, repeated `count` times with compressed names.
+size_t BuildQueries(uint8_t * buffer, size_t size, uint16_t count)
+{
+    Encoding::BigEndian::BufferWriter out(buffer, size);
+    out.Put16(0).Put16(0).Put16(count).Put16(0).Put16(0).Put16(0);
+    out.Put(&kReply[12], 24); // _matter._tcp.local PTR/IN
+    for (uint16_t i = 1; i < count; i++)
+    {
+        out.Put8(0xC0).Put8(12).Put16(static_cast<uint16_t>(QType::PTR)).Put16(static_cast<uint16_t>(QClass::IN));
+    }
+    return out.Fit() ? out.Needed() : 0;
+}
+
+void IndexesQueriesAndRecords(nlTestSuite * inSuite, void * inContext)
+{
+    const BytesRange packet(kReply, kReply + sizeof(kReply));
+    PacketIndex index;
+
+    NL_TEST_ASSERT(inSuite, index.Index(packet));
+    NL_TEST_ASSERT(inSuite, index.IsValid());
+    NL_TEST_ASSERT(inSuite, index.HasHeader());
+    NL_TEST_ASSERT(inSuite, index.GetHeader().GetMessageId() == 0x1234);
+    NL_TEST_ASSERT(inSuite, !index.IsTruncated());
+    NL_TEST_ASSERT(inSuite, index.GetEntryCount() == 3);
+
+    NL_TEST_ASSERT(inSuite, index.IsQuery(0));
+    const QueryData query = index.GetQuery(0);
+    NL_TEST_ASSERT(inSuite, query.GetType() == QType::PTR);
+    NL_TEST_ASSERT(inSuite, query.GetClass() == QClass::IN);
+    NL_TEST_ASSERT(inSuite, query.RequestedUnicastAnswer());
+    NL_TEST_ASSERT(inSuite, query.GetName() == FullQName(kServiceName));
+
+    NL_TEST_ASSERT(inSuite, !index.IsQuery(1));
+    NL_TEST_ASSERT(inSuite, index.GetType(1) == QType::PTR);
+    NL_TEST_ASSERT(inSuite, index.GetResourceType(1) == ResourceType::kAnswer);
+    const ResourceData ptr = index.GetResource(1);
+    NL_TEST_ASSERT(inSuite, ptr.GetName() == FullQName(kServiceName));
+    NL_TEST_ASSERT(inSuite, ptr.GetTtlSeconds() == 120);
+    NL_TEST_ASSERT(inSuite, ptr.GetData().Start() == &kReply[kPtrDataOffset]);
+    NL_TEST_ASSERT(inSuite, ptr.GetData().Size() == 6);
+    SerializedQNameIterator instanceName;
+    NL_TEST_ASSERT(inSuite, ParsePtrRecord(ptr.GetData(), packet, &instanceName));
+    NL_TEST_ASSERT(inSuite, instanceName == FullQName(kInstanceName));
+
+    NL_TEST_ASSERT(inSuite, index.GetType(2) == QType::SRV);
+    NL_TEST_ASSERT(inSuite, index.GetResourceType(2) == ResourceType::kAdditional);
+    const ResourceData srv = index.GetResource(2);
+    NL_TEST_ASSERT(inSuite, srv.GetName() == FullQName(kInstanceName));
+    NL_TEST_ASSERT(inSuite, srv.GetClass() == QClass::IN_FLUSH);
+    NL_TEST_ASSERT(inSuite, srv.GetData().Start() == &kReply[kSrvDataOffset]);
+    SrvRecord srvRecord;
+    NL_TEST_ASSERT(inSuite, srvRecord.Parse(srv.GetData(), packet));
+    NL_TEST_ASSERT(inSuite, srvRecord.GetPort() == 5540);
+    NL_TEST_ASSERT(inSuite, srvRecord.GetName() == FullQName(kHostName));
+
+    size_t queryCount    = 0;
+    size_t resourceCount = 0;
+    index.ForEachQuery([&](const QueryData &) { queryCount++; });
+    index.ForEachResource([&](ResourceType, const ResourceData &) { resourceCount++; });
+    NL_TEST_ASSERT(inSuite, queryCount == 1);
+    NL_TEST_ASSERT(inSuite, resourceCount == 2);
+}
+
+void IndexesLargePacketsInWindows(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr uint16_t kQueryCount = PacketIndex::kMaxEntries * 2 + 3;
+    uint8_t buffer[HeaderRef::kSizeBytes + 24 + (kQueryCount - 1) * 6];
+    const size_t size = BuildQueries(buffer, sizeof(buffer), kQueryCount);
+    NL_TEST_ASSERT(inSuite, size != 0);
+
+    const BytesRange packet(buffer, buffer + size);
+    PacketIndex index;
+    size_t total   = 0;
+    size_t windows = 0;
+
+    bool valid = index.Index(packet);
+    while (true)
+    {
+        NL_TEST_ASSERT(inSuite, valid);
+        NL_TEST_ASSERT(inSuite, index.GetFirstEntry() == total);
+        index.ForEachQuery([&](const QueryData & query) {
+            NL_TEST_ASSERT(inSuite, query.GetName() == FullQName(kServiceName));
+            total++;
+        });
+        windows++;
+        if (!index.IsTruncated())
+        {
+            break;
+        }
+        NL_TEST_ASSERT(inSuite, index.GetEntryCount() == PacketIndex::kMaxEntries);
+        valid = index.Index(packet, index.GetNextEntry());
+    }
+
+    NL_TEST_ASSERT(inSuite, total == kQueryCount);
+    NL_TEST_ASSERT(inSuite, windows == 3);
+    NL_TEST_ASSERT(inSuite, index.GetEntryCount() == 3);
+}
+
+void RejectsMalformedPackets(nlTestSuite * inSuite, void * inContext)
+{
+    PacketIndex index;
+
+    // Not a complete header
+    NL_TEST_ASSERT(inSuite, !index.Index(BytesRange(kReply, kReply + 6)));
+    NL_TEST_ASSERT(inSuite, !index.HasHeader());
+    NL_TEST_ASSERT(inSuite, index.GetEntryCount() == 0);
+
+    // The SRV record data is cut: the query and the PTR record are still indexed
+    NL_TEST_ASSERT(inSuite, !index.Index(BytesRange(kReply, kReply + sizeof(kReply) - 1)));
+    NL_TEST_ASSERT(inSuite, index.HasHeader());
+    NL_TEST_ASSERT(inSuite, !index.IsValid());
+    NL_TEST_ASSERT(inSuite, !index.IsTruncated());
+    NL_TEST_ASSERT(inSuite, index.GetEntryCount() == 2);
+
+    // Labels longer than 63 bytes are invalid
+    uint8_t packet[sizeof(kReply)];
+    memcpy(packet, kReply, sizeof(kReply));
+    packet[12] = 64;
+    NL_TEST_ASSERT(inSuite, !index.Index(BytesRange(packet, packet + sizeof(packet))));
+    NL_TEST_ASSERT(inSuite, index.GetEntryCount() == 0);
+
+    // Packets with an error return code are not valid mDNS packets
+    memcpy(packet, kReply, sizeof(kReply));
+    packet[3] = 3; // NXDOMAIN
+    NL_TEST_ASSERT(inSuite, !index.Index(BytesRange(packet, packet + sizeof(packet))));
+    NL_TEST_ASSERT(inSuite, !index.HasHeader());
+}
+
+const nlTest sTests[] = {
+    NL_TEST_DEF("IndexesQueriesAndRecords", IndexesQueriesAndRecords),         //
+    NL_TEST_DEF("IndexesLargePacketsInWindows", IndexesLargePacketsInWindows), //
+    NL_TEST_DEF("RejectsMalformedPackets", RejectsMalformedPackets),           //
+    NL_TEST_SENTINEL()                                                         //
+};
+
+} // namespace
+
+int TestPacketIndex()
+{
+    nlTestSuite theSuite = { "PacketIndex", sTests, nullptr, nullptr };
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestPacketIndex)
@@ -0,0 +1,303 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <lib/dnssd/minimal_mdns/RecordCache.h>
+
+#include <lib/dnssd/minimal_mdns/QueryBuilder.h>
+#include <lib/dnssd/minimal_mdns/RecordData.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/UnitTestRegistration.h>
+
+#include <string.h>
+
+#include <nlunit-test.h>
+
+namespace {
+
+using namespace chip;
+using namespace mdns::Minimal;
+
+// A reply with compressed names, as sent by responders
+const uint8_t kReply[] = {
+    // 0: _matter._tcp.local
+    7, '_', 'm', 'a', 't', 't', 'e', 'r', //
+    4, '_', 't', 'c', 'p',                //
+    5, 'l', 'o', 'c', 'a', 'l',           //
+    0,                                    //
+    0, 12,                                // PTR
+    0, 1,                                 // IN
+    0, 0, 0, 120,                         // TTL
+    0, 6,                                 // data length
+    3, 'a', 'b', 'c', 0xC0, 0,            // 30: abc._matter._tcp.local
+    // 36: abc._matter._tcp.local
+    0xC0, 30,                             //
+    0, 33,                                // SRV
+    0x80, 1,                              // IN, cache flush
+    0, 0, 0, 120,                         // TTL
+    0, 13,                                // data length
+    0, 0,                                 // priority
+    0, 0,                                 // weight
+    0x15, 0xA4,                           // 52: port 5540
+    4, 'h', 'o', 's', 't', 0xC0, 13,      // host.local
+};
+
+constexpr size_t kPtrOffset     = 0;
+constexpr size_t kSrvOffset     = 36;
+constexpr size_t kSrvTtlOffset  = 42;
+constexpr size_t kSrvPortOffset = 52;
+
+const QNamePart kServiceName[]  = { "_matter", "_tcp", "local" };
+const QNamePart kInstanceName[] = { "abc", "_matter", "_tcp", "local" };
+const QNamePart kHostName[]     = { "host", "local" };
+
+System::Clock::Timestamp AtSeconds(uint32_t seconds)
+{
+    return System::Clock::Seconds32(seconds);
+}
+
+ResourceData RecordAt(const uint8_t * packet, size_t packetSize, size_t offset)
+{
+    ResourceData record;
+    const uint8_t * start = packet + offset;
+    record.Parse(BytesRange(packet, packet + packetSize), &start);
+    return record;
+}
+
+size_t CountRecords(RecordCacheBase & cache, System::Clock::Timestamp now)
+{
+    size_t count = 0;
+    cache.ForEachRecord(now, [&count](const RecordCacheBase::CachedRecord &) {
+        count++;
+        return Loop::Continue;
+    });
+    return count;
+}
+
+void CachesRecordsWithoutCompression(nlTestSuite * inSuite, void * inContext)
+{
+    const BytesRange reply(kReply, kReply + sizeof(kReply));
+    RecordCache<4> cache;
+
+    NL_TEST_ASSERT(inSuite,
+                   cache.Add(Inet::InterfaceId::Null(), RecordAt(kReply, sizeof(kReply), kPtrOffset), reply, AtSeconds(100)) ==
+                       CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite,
+                   cache.Add(Inet::InterfaceId::Null(), RecordAt(kReply, sizeof(kReply), kSrvOffset), reply, AtSeconds(100)) ==
+                       CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, CountRecords(cache, AtSeconds(100)) == 2);
+
+    // Cached records are parsed on their own, names do not refer to the reply any more
+    cache.ForEachRecord(AtSeconds(100), [&](const RecordCacheBase::CachedRecord & record) {
+        if (record.data.GetType() == QType::PTR)
+        {
+            NL_TEST_ASSERT(inSuite, record.data.GetName() == FullQName(kServiceName));
+            SerializedQNameIterator target(record.range, record.data.GetData().Start());
+            NL_TEST_ASSERT(inSuite, target == FullQName(kInstanceName));
+        }
+        else
+        {
+            SrvRecord srv;
+            NL_TEST_ASSERT(inSuite, record.data.GetType() == QType::SRV);
+            NL_TEST_ASSERT(inSuite, record.data.GetClass() == QClass::IN);
+            NL_TEST_ASSERT(inSuite, record.data.GetName() == FullQName(kInstanceName));
+            NL_TEST_ASSERT(inSuite, srv.Parse(record.data.GetData(), record.range));
+            NL_TEST_ASSERT(inSuite, srv.GetPort() == 5540);
+            NL_TEST_ASSERT(inSuite, srv.GetName() == FullQName(kHostName));
+        }
+        return Loop::Continue;
+    });
+
+    const uint8_t instanceName[] = {
+        3, 'A', 'B', 'C',                     //
+        7, '_', 'm', 'a', 't', 't', 'e', 'r', //
+        4, '_', 't', 'c', 'p',                //
+        5, 'l', 'o', 'c', 'a', 'l',           //
+        0,                                    //
+    };
+    const BytesRange instanceRange(instanceName, instanceName + sizeof(instanceName));
+    NL_TEST_ASSERT(inSuite, cache.HasRecord(QType::SRV, SerializedQNameIterator(instanceRange, instanceName), AtSeconds(100)));
+    NL_TEST_ASSERT(inSuite, !cache.HasRecord(QType::TXT, SerializedQNameIterator(instanceRange, instanceName), AtSeconds(100)));
+}
+
+void ExpiresRecords(nlTestSuite * inSuite, void * inContext)
+{
+    const BytesRange reply(kReply, kReply + sizeof(kReply));
+    RecordCache<4> cache;
+
+    NL_TEST_ASSERT(inSuite,
+                   cache.Add(Inet::InterfaceId::Null(), RecordAt(kReply, sizeof(kReply), kSrvOffset), reply, AtSeconds(100)) ==
+                       CHIP_NO_ERROR);
+
+    // Records report the TTL they have left and stop being known answers at half of it
+    cache.ForEachRecord(AtSeconds(159), [&](const RecordCacheBase::CachedRecord & record) {
+        NL_TEST_ASSERT(inSuite, record.data.GetTtlSeconds() == 61);
+        NL_TEST_ASSERT(inSuite, record.usableAsKnownAnswer);
+        return Loop::Continue;
+    });
+    cache.ForEachRecord(AtSeconds(161), [&](const RecordCacheBase::CachedRecord & record) {
+        NL_TEST_ASSERT(inSuite, record.data.GetTtlSeconds() == 59);
+        NL_TEST_ASSERT(inSuite, !record.usableAsKnownAnswer);
+        return Loop::Continue;
+    });
+
+    NL_TEST_ASSERT(inSuite, CountRecords(cache, AtSeconds(219)) == 1);
+    NL_TEST_ASSERT(inSuite, CountRecords(cache, AtSeconds(220)) == 0);
+}
+
+void FlushesAndRemovesRecords(nlTestSuite * inSuite, void * inContext)
+{
+    uint8_t packet[sizeof(kReply)];
+    memcpy(packet, kReply, sizeof(packet));
+    const BytesRange reply(packet, packet + sizeof(packet));
+    RecordCache<4> cache;
+
+    NL_TEST_ASSERT(inSuite,
+                   cache.Add(Inet::InterfaceId::Null(), RecordAt(packet, sizeof(packet), kSrvOffset), reply, AtSeconds(100)) ==
+                       CHIP_NO_ERROR);
+
+    // The same record again is refreshed, not added
+    NL_TEST_ASSERT(inSuite,
+                   cache.Add(Inet::InterfaceId::Null(), RecordAt(packet, sizeof(packet), kSrvOffset), reply, AtSeconds(150)) ==
+                       CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, CountRecords(cache, AtSeconds(150)) == 1);
+    NL_TEST_ASSERT(inSuite, CountRecords(cache, AtSeconds(260)) == 1);
+
+    // A new port with the cache flush bit replaces the old record
+    packet[kSrvPortOffset + 1] = 0xA5;
+    NL_TEST_ASSERT(inSuite,
+                   cache.Add(Inet::InterfaceId::Null(), RecordAt(packet, sizeof(packet), kSrvOffset), reply, AtSeconds(160)) ==
+                       CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, CountRecords(cache, AtSeconds(160)) == 1);
+    cache.ForEachRecord(AtSeconds(160), [&](const RecordCacheBase::CachedRecord & record) {
+        SrvRecord srv;
+        NL_TEST_ASSERT(inSuite, srv.Parse(record.data.GetData(), record.range));
+        NL_TEST_ASSERT(inSuite, srv.GetPort() == 5541);
+        return Loop::Continue;
+    });
+
+    // A TTL of 0 removes it
+    packet[kSrvTtlOffset + 3] = 0;
+    NL_TEST_ASSERT(inSuite,
+                   cache.Add(Inet::InterfaceId::Null(), RecordAt(packet, sizeof(packet), kSrvOffset), reply, AtSeconds(170)) ==
+                       CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, CountRecords(cache, AtSeconds(170)) == 0);
+}
+
+void ReplacesRecordsClosestToExpiring(nlTestSuite * inSuite, void * inContext)
+{
+    uint8_t packet[sizeof(kReply)];
+    memcpy(packet, kReply, sizeof(packet));
+    const BytesRange reply(packet, packet + sizeof(packet));
+    RecordCache<2> cache;
+
+    // Ports 1, 2 and 3 received at the same time, port 2 expiring first
+    const uint8_t ttls[] = { 120, 60, 120 };
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        packet[kSrvPortOffset]     = 0;
+        packet[kSrvPortOffset + 1] = static_cast<uint8_t>(i + 1);
+        packet[kSrvTtlOffset + 3]  = ttls[i];
+        NL_TEST_ASSERT(inSuite,
+                       cache.Add(Inet::InterfaceId::Null(), RecordAt(packet, sizeof(packet), kSrvOffset), reply, AtSeconds(100)) ==
+                           CHIP_NO_ERROR);
+    }
+
+    uint16_t ports = 0;
+    cache.ForEachRecord(AtSeconds(100), [&](const RecordCacheBase::CachedRecord & record) {
+        SrvRecord srv;
+        NL_TEST_ASSERT(inSuite, srv.Parse(record.data.GetData(), record.range));
+        ports = static_cast<uint16_t>(ports | (1 << srv.GetPort()));
+        return Loop::Continue;
+    });
+    NL_TEST_ASSERT(inSuite, ports == ((1 << 1) | (1 << 3)));
+}
+
+void SendsCachedRecordsAsKnownAnswers(nlTestSuite * inSuite, void * inContext)
+{
+    const BytesRange reply(kReply, kReply + sizeof(kReply));
+    RecordCache<4> cache;
+
+    NL_TEST_ASSERT(inSuite,
+                   cache.Add(Inet::InterfaceId::Null(), RecordAt(kReply, sizeof(kReply), kPtrOffset), reply, AtSeconds(100)) ==
+                       CHIP_NO_ERROR);
+
+    System::PacketBufferHandle buffer = System::PacketBufferHandle::New(512);
+    NL_TEST_ASSERT(inSuite, !buffer.IsNull());
+    VerifyOrReturn(!buffer.IsNull());
+    QueryBuilder builder(std::move(buffer));
+
+    builder.AddQuery(Query(kServiceName).SetType(QType::ANY)).AddQuery(Query(kHostName).SetType(QType::AAAA));
+    NL_TEST_ASSERT(inSuite, builder.Ok());
+
+    size_t queryCount = 0;
+    builder.ForEachQuery([&](const QueryData & query) {
+        const FullQName expected = (queryCount == 0) ? FullQName(kServiceName) : FullQName(kHostName);
+        NL_TEST_ASSERT(inSuite, query.GetName() == expected);
+        queryCount++;
+    });
+    NL_TEST_ASSERT(inSuite, queryCount == 2);
+
+    size_t answerSize = 0;
+    cache.ForEachRecord(AtSeconds(110), [&](const RecordCacheBase::CachedRecord & record) {
+        NL_TEST_ASSERT(inSuite, builder.AddKnownAnswer(record.range));
+        answerSize = record.range.Size();
+        return Loop::Continue;
+    });
+    NL_TEST_ASSERT(inSuite, builder.Header().GetQueryCount() == 2);
+    NL_TEST_ASSERT(inSuite, builder.Header().GetAnswerCount() == 1);
+
+    // The known answer is the record with its remaining TTL
+    System::PacketBufferHandle packet = builder.ReleasePacket();
+    const BytesRange query(packet->Start(), packet->Start() + packet->DataLength());
+    const uint8_t * answer = query.End() - answerSize;
+    ResourceData knownAnswer;
+    NL_TEST_ASSERT(inSuite, knownAnswer.Parse(query, &answer));
+    NL_TEST_ASSERT(inSuite, knownAnswer.GetType() == QType::PTR);
+    NL_TEST_ASSERT(inSuite, knownAnswer.GetTtlSeconds() == 110);
+    NL_TEST_ASSERT(inSuite, knownAnswer.GetName() == FullQName(kServiceName));
+    NL_TEST_ASSERT(inSuite, answer == query.End());
+}
+
+const nlTest sTests[] = {
+    NL_TEST_DEF("CachesRecordsWithoutCompression", CachesRecordsWithoutCompression),   //
+    NL_TEST_DEF("ExpiresRecords", ExpiresRecords),                                     //
+    NL_TEST_DEF("FlushesAndRemovesRecords", FlushesAndRemovesRecords),                 //
+    NL_TEST_DEF("ReplacesRecordsClosestToExpiring", ReplacesRecordsClosestToExpiring), //
+    NL_TEST_DEF("SendsCachedRecordsAsKnownAnswers", SendsCachedRecordsAsKnownAnswers), //
+    NL_TEST_SENTINEL()                                                                 //
+};
+
+int TestSetup(void * inContext)
+{
+    return Platform::MemoryInit() == CHIP_NO_ERROR ? SUCCESS : FAILURE;
+}
+
+int TestTeardown(void * inContext)
+{
+    Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+} // namespace
+
+int TestRecordCache()
+{
+    nlTestSuite theSuite = { "RecordCache", sTests, &TestSetup, &TestTeardown };
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestRecordCache)
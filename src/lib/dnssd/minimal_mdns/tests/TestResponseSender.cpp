@@ -16,6 +16,8 @@
  */
 #include <lib/dnssd/minimal_mdns/ResponseSender.h>
 
+#include <algorithm>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -29,6 +31,8 @@
 
 #include <lib/support/CHIPMem.h>
 #include <lib/support/UnitTestRegistration.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <system/SystemClock.h>
 
 #include <nlunit-test.h>
 
@@ -344,6 +348,208 @@ void PtrSrvTxtMultipleRespondersToServiceListing(nlTestSuite * inSuite, void * i
     NL_TEST_ASSERT(inSuite, common1.server.GetHeaderFound());
 }
 
+/// An operational identity with its own query responder, as each fabric of a node has.
+struct OperationalIdentity
+{
+    uint8_t instanceNameStorage[64];
+    FullQName instance;
+    SrvResourceRecord srvRecord;
+    SrvResponder srvResponder;
+    QueryResponder<2> queryResponder;
+
+    OperationalIdentity(size_t index, const FullQName & host) :
+        instance(BuildInstanceName(instanceNameStorage, index)), srvRecord(instance, host, 5540), srvResponder(srvRecord)
+    {}
+
+    static FullQName BuildInstanceName(uint8_t * storage, size_t index)
+    {
+        char label[16];
+        snprintf(label, sizeof(label), "FABRIC%u", static_cast<unsigned>(index));
+        return FlatAllocatedQName::Build(storage, label, "instance");
+    }
+};
+
+void ManyOperationalIdentities(nlTestSuite * inSuite, void * inContext)
+{
+    // Far more than CHIP_CONFIG_MAX_FABRICS, as advertised by a bridge on many fabrics
+    constexpr size_t kIdentityCount = 300;
+
+    CommonTestElements common(inSuite, "test");
+    ResponseSender responseSender(&common.server);
+
+    std::vector<std::unique_ptr<OperationalIdentity>> identities;
+    for (size_t i = 0; i < kIdentityCount; i++)
+    {
+        identities.emplace_back(new OperationalIdentity(i, common.host));
+        NL_TEST_ASSERT(inSuite, responseSender.AddQueryResponder(&identities.back()->queryResponder) == CHIP_NO_ERROR);
+        identities.back()->queryResponder.AddResponder(&identities.back()->srvResponder);
+    }
+
+    // Names are matched regardless of case
+    uint8_t queryNameStorage[64];
+    common.recordWriter.WriteQName(FlatAllocatedQName::Build(queryNameStorage, "fabric123", "instance"));
+    QueryData queryData = QueryData(QType::SRV, QClass::IN, false, common.requestNameStart, common.requestBytesRange);
+
+    common.server.AddExpectedRecord(&identities[123]->srvRecord);
+    NL_TEST_ASSERT(inSuite, responseSender.Respond(1, queryData, &common.packetInfo, ResponseConfiguration()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, common.server.GetSendCalled());
+
+    NL_TEST_ASSERT(inSuite,
+                   responseSender.FindQueryResponder(QType::SRV, identities[200]->instance) == &identities[200]->queryResponder);
+    NL_TEST_ASSERT(inSuite, responseSender.FindQueryResponder(QType::TXT, identities[200]->instance) == nullptr);
+
+    // Identities added once records are indexed are found as well
+    OperationalIdentity lateIdentity(kIdentityCount, common.host);
+    NL_TEST_ASSERT(inSuite, responseSender.AddQueryResponder(&lateIdentity.queryResponder) == CHIP_NO_ERROR);
+    lateIdentity.queryResponder.AddResponder(&lateIdentity.srvResponder);
+    NL_TEST_ASSERT(inSuite, responseSender.FindQueryResponder(QType::SRV, lateIdentity.instance) == &lateIdentity.queryResponder);
+
+    // Removed identities are not answered for anymore
+    NL_TEST_ASSERT(inSuite, responseSender.RemoveQueryResponder(&identities[123]->queryResponder) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, responseSender.RemoveQueryResponder(&identities[123]->queryResponder) == CHIP_ERROR_NOT_FOUND);
+    common.server.Reset();
+    NL_TEST_ASSERT(inSuite, responseSender.Respond(2, queryData, &common.packetInfo, ResponseConfiguration()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, !common.server.GetSendCalled());
+
+    // Destroyed responders unregister themselves
+    identities.clear();
+    NL_TEST_ASSERT(inSuite, responseSender.FindQueryResponder(QType::SRV, lateIdentity.instance) == &lateIdentity.queryResponder);
+    NL_TEST_ASSERT(inSuite, responseSender.RemoveQueryResponder(&lateIdentity.queryResponder) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, responseSender.RemoveQueryResponder(&common.queryResponder) == CHIP_ERROR_NOT_FOUND);
+    NL_TEST_ASSERT(inSuite, !responseSender.HasQueryResponders());
+}
+
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+void SetStandardQuerySource(Inet::IPPacketInfo & packetInfo)
+{
+    // Queries from the mDNS port get replies that do not repeat the query, which can be cached
+    packetInfo.Clear();
+    packetInfo.SrcPort = 5353;
+    Inet::IPAddress::FromString("fe80::1", packetInfo.SrcAddress);
+}
+
+void CachedReplyToRepeatedQuery(nlTestSuite * inSuite, void * inContext)
+{
+    CommonTestElements common(inSuite, "test");
+    ResponseSender responseSender(&common.server);
+    NL_TEST_ASSERT(inSuite, responseSender.AddQueryResponder(&common.queryResponder) == CHIP_NO_ERROR);
+    common.queryResponder.AddResponder(&common.srvResponder);
+    SetStandardQuerySource(common.packetInfo);
+
+    common.recordWriter.WriteQName(common.instance);
+    QueryData queryData = QueryData(QType::ANY, QClass::IN, true, common.requestNameStart, common.requestBytesRange);
+
+    common.server.AddExpectedRecord(&common.srvRecord);
+    NL_TEST_ASSERT(inSuite, responseSender.Respond(1, queryData, &common.packetInfo, ResponseConfiguration()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, common.server.GetSendCalled());
+
+    // Records added since are part of the reply, cached replies are dropped when records change.
+    common.queryResponder.AddResponder(&common.txtResponder);
+    common.server.Reset();
+    common.server.AddExpectedRecord(&common.srvRecord);
+    common.server.AddExpectedRecord(&common.txtRecord);
+    NL_TEST_ASSERT(inSuite, responseSender.Respond(2, queryData, &common.packetInfo, ResponseConfiguration()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, common.server.GetSendCalled());
+
+    // Replies with adjusted TTLs are built from the records.
+    common.server.Reset();
+    common.server.AddExpectedRecord(&common.srvRecord);
+    common.server.AddExpectedRecord(&common.txtRecord);
+    NL_TEST_ASSERT(inSuite,
+                   responseSender.Respond(3, queryData, &common.packetInfo, ResponseConfiguration().SetTtlSecondsOverride(10)) ==
+                       CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, common.server.GetSendCalled());
+
+    common.server.Reset();
+    common.server.AddExpectedRecord(&common.srvRecord);
+    common.server.AddExpectedRecord(&common.txtRecord);
+    responseSender.InvalidateResponseCache();
+    NL_TEST_ASSERT(inSuite, responseSender.Respond(4, queryData, &common.packetInfo, ResponseConfiguration()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, common.server.GetSendCalled());
+}
+
+/// Keeps the last reply sent, without checking its content.
+class ReplyRecordingServer : private chip::PoolImpl<ServerBase::EndpointInfo, 0, chip::ObjectPoolMem::kInline,
+                                                    ServerBase::EndpointInfoPoolType::Interface>,
+                             public ServerBase
+{
+public:
+    ReplyRecordingServer() : ServerBase(*static_cast<ServerBase::EndpointInfoPoolType *>(this)) {}
+
+    CHIP_ERROR DirectSend(System::PacketBufferHandle && data, const Inet::IPAddress & addr, uint16_t port,
+                          Inet::InterfaceId interface) override
+    {
+        mLastReply.assign(data->Start(), data->Start() + data->DataLength());
+        mReplyCount++;
+        return CHIP_NO_ERROR;
+    }
+
+    std::vector<uint8_t> mLastReply;
+    size_t mReplyCount = 0;
+};
+
+void ResponseCacheThroughput(nlTestSuite * inSuite, void * inContext)
+{
+    // A commissioner on a busy network is asked about its services over and over, and about services it does not have.
+    constexpr size_t kQueryCount = 20000;
+
+    CommonTestElements common(inSuite, "test");
+    ReplyRecordingServer server;
+    ResponseSender responseSender(&server);
+    NL_TEST_ASSERT(inSuite, responseSender.AddQueryResponder(&common.queryResponder) == CHIP_NO_ERROR);
+    common.queryResponder.AddResponder(&common.ptrResponder).SetReportInServiceListing(true).SetReportAdditional(common.instance);
+    common.queryResponder.AddResponder(&common.srvResponder);
+    common.queryResponder.AddResponder(&common.txtResponder);
+    SetStandardQuerySource(common.packetInfo);
+
+    common.recordWriter.WriteQName(common.service);
+    QueryData serviceQuery = QueryData(QType::PTR, QClass::IN, true, common.requestNameStart, common.requestBytesRange);
+
+    uint8_t otherQueryStorage[64];
+    uint8_t otherServiceStorage[64];
+    FullQName otherService = FlatAllocatedQName::Build(otherServiceStorage, "other", "service");
+    Encoding::BigEndian::BufferWriter otherQueryWriter(otherQueryStorage, sizeof(otherQueryStorage));
+    RecordWriter otherRecordWriter(&otherQueryWriter);
+    otherRecordWriter.WriteQName(otherService);
+    QueryData otherQuery = QueryData(QType::PTR, QClass::IN, true, otherQueryStorage,
+                                     BytesRange(otherQueryStorage, otherQueryStorage + sizeof(otherQueryStorage)));
+
+    std::vector<uint8_t> builtReply;
+    System::Clock::Microseconds64 elapsed[2];
+    for (bool cached : { false, true })
+    {
+        server.mReplyCount = 0;
+        responseSender.InvalidateResponseCache();
+
+        System::Clock::Microseconds64 start = System::SystemClock().GetMonotonicMicroseconds64();
+        for (size_t i = 0; i < kQueryCount; i++)
+        {
+            if (!cached)
+            {
+                responseSender.InvalidateResponseCache();
+            }
+            const QueryData & query = (i % 2 == 0) ? serviceQuery : otherQuery;
+            NL_TEST_ASSERT(inSuite, responseSender.Respond(1, query, &common.packetInfo, ResponseConfiguration()) == CHIP_NO_ERROR);
+        }
+        elapsed[cached] = System::SystemClock().GetMonotonicMicroseconds64() - start;
+
+        // Only the queries for our service are answered, with the same reply whether it is cached or not
+        NL_TEST_ASSERT(inSuite, server.mReplyCount == kQueryCount / 2);
+        if (!cached)
+        {
+            builtReply = server.mLastReply;
+        }
+        NL_TEST_ASSERT(inSuite, !builtReply.empty() && server.mLastReply == builtReply);
+    }
+
+    for (bool cached : { false, true })
+    {
+        uint64_t rate = kQueryCount * 1000000 / std::max<uint64_t>(elapsed[cached].count(), 1);
+        ChipLogProgress(Discovery, "%s replies: %u queries per second", cached ? "Cached" : "Built", static_cast<unsigned>(rate));
+    }
+}
+#endif // CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+
 const nlTest sTests[] = {
     NL_TEST_DEF("SrvAnyResponseToInstance", SrvAnyResponseToInstance),                                       //
     NL_TEST_DEF("SrvTxtAnyResponseToInstance", SrvTxtAnyResponseToInstance),                                 //
@@ -355,6 +561,11 @@ const nlTest sTests[] = {
     NL_TEST_DEF("AddManyQueryResponders", AddManyQueryResponders),                                           //
     NL_TEST_DEF("PtrSrvTxtMultipleRespondersToInstance", PtrSrvTxtMultipleRespondersToInstance),             //
     NL_TEST_DEF("PtrSrvTxtMultipleRespondersToServiceListing", PtrSrvTxtMultipleRespondersToServiceListing), //
+    NL_TEST_DEF("ManyOperationalIdentities", ManyOperationalIdentities),                                     //
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+    NL_TEST_DEF("CachedReplyToRepeatedQuery", CachedReplyToRepeatedQuery),                                   //
+    NL_TEST_DEF("ResponseCacheThroughput", ResponseCacheThroughput),                                         //
+#endif
 
     NL_TEST_SENTINEL() //
 };
@@ -62,6 +62,10 @@ void TestSinglePeerAddRemove(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, attempts.NextScheduled() == ScheduledPeer(1, true));
     NL_TEST_ASSERT(inSuite, !attempts.NextScheduled().HasValue());
 
+    // still pending until complete, even though nothing is to be sent now
+    NL_TEST_ASSERT(inSuite, attempts.IsPending(ScheduledPeer(1, true).Value()));
+    NL_TEST_ASSERT(inSuite, !attempts.IsPending(ScheduledPeer(2, true).Value()));
+
     // one Next schedule is called, expect to have a delay of 1000 ms
     NL_TEST_ASSERT(inSuite, attempts.GetTimeUntilNextExpectedResponse() == Optional<Timeout>(1000_ms32));
     mockClock.AdvanceMonotonic(500_ms32);
@@ -84,6 +88,7 @@ void TestSinglePeerAddRemove(nlTestSuite * inSuite, void * inContext)
     attempts.Complete(MakePeerId(1));
     NL_TEST_ASSERT(inSuite, !attempts.GetTimeUntilNextExpectedResponse().HasValue());
     NL_TEST_ASSERT(inSuite, !attempts.NextScheduled().HasValue());
+    NL_TEST_ASSERT(inSuite, !attempts.IsPending(ScheduledPeer(1, false).Value()));
 }
 
 void TestSingleBrowseAddRemove(nlTestSuite * inSuite, void * inContext)
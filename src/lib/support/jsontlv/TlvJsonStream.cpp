@@ -0,0 +1,730 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <lib/support/jsontlv/TlvJsonStream.h>
+
+#include <lib/support/Base64.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/SafeInt.h>
+#include <lib/support/ScopedBuffer.h>
+
+#include <algorithm>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace chip {
+namespace {
+
+constexpr const char kRootKey[]      = "value";
+constexpr const char kBase64Header[] = "base64:";
+constexpr size_t kBase64HeaderLen    = ArraySize(kBase64Header) - 1;
+
+// Nesting accepted in the JSON, which is parsed recursively.
+constexpr uint8_t kMaxJsonDepth = 32;
+
+// Longest number accepted in the JSON, which is more than the 17 significant digits of a double with its sign and exponent.
+constexpr size_t kMaxNumberLen = 32;
+
+bool IsDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+void PutChar(Encoding::BufferWriter & output, char c)
+{
+    output.Put(static_cast<uint8_t>(c));
+}
+
+void PutUnsigned(Encoding::BufferWriter & output, uint64_t value)
+{
+    char digits[20];
+    size_t start = sizeof(digits);
+
+    do
+    {
+        digits[--start] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+
+    output.Put(&digits[start], sizeof(digits) - start);
+}
+
+void PutSigned(Encoding::BufferWriter & output, int64_t value)
+{
+    if (value < 0)
+    {
+        PutChar(output, '-');
+        PutUnsigned(output, 0 - static_cast<uint64_t>(value));
+    }
+    else
+    {
+        PutUnsigned(output, static_cast<uint64_t>(value));
+    }
+}
+
+// Doubles are written as jsoncpp writes them: with 17 significant digits, with a fraction or an exponent so that they
+// are read back as doubles, and as out of range numbers for infinities.
+void PutDouble(Encoding::BufferWriter & output, double value)
+{
+    if (isnan(value))
+    {
+        output.Put("null");
+        return;
+    }
+    if (isinf(value))
+    {
+        output.Put(value < 0 ? "-1e+9999" : "1e+9999");
+        return;
+    }
+
+    char number[kMaxNumberLen];
+    const int len = snprintf(number, sizeof(number), "%.17g", value);
+    output.Put(number, static_cast<size_t>(len));
+    if (strpbrk(number, ".e") == nullptr)
+    {
+        output.Put(".0");
+    }
+}
+
+void PutQuotedString(Encoding::BufferWriter & output, const CharSpan & str)
+{
+    static constexpr char kHexDigits[] = "0123456789abcdef";
+    const char * end                   = str.data() + str.size();
+    const char * run                   = str.data();
+
+    PutChar(output, '"');
+
+    // Write the runs of characters needing no escape at once.
+    for (const char * p = str.data(); p < end; p++)
+    {
+        const uint8_t c = static_cast<uint8_t>(*p);
+        if (c >= 0x20 && c != '"' && c != '\\')
+        {
+            continue;
+        }
+
+        output.Put(run, static_cast<size_t>(p - run));
+        run = p + 1;
+
+        switch (c)
+        {
+        case '"':
+            output.Put("\\\"");
+            break;
+        case '\\':
+            output.Put("\\\\");
+            break;
+        case '\b':
+            output.Put("\\b");
+            break;
+        case '\f':
+            output.Put("\\f");
+            break;
+        case '\n':
+            output.Put("\\n");
+            break;
+        case '\r':
+            output.Put("\\r");
+            break;
+        case '\t':
+            output.Put("\\t");
+            break;
+        default: {
+            const char escape[] = { '\\', 'u', '0', '0', kHexDigits[c >> 4], kHexDigits[c & 0xf] };
+            output.Put(escape, sizeof(escape));
+            break;
+        }
+        }
+    }
+
+    if (end > run)
+    {
+        output.Put(run, static_cast<size_t>(end - run));
+    }
+    PutChar(output, '"');
+}
+
+void PutBase64String(Encoding::BufferWriter & output, const ByteSpan & bytes)
+{
+    // Encode whole groups of 3 bytes at a time, so that only the last chunk gets padded.
+    constexpr size_t kChunkLen = 48;
+    char chunk[BASE64_ENCODED_LEN(kChunkLen)];
+
+    PutChar(output, '"');
+    output.Put(kBase64Header);
+
+    for (size_t offset = 0; offset < bytes.size(); offset += kChunkLen)
+    {
+        const size_t len = std::min(kChunkLen, bytes.size() - offset);
+        output.Put(chunk, Base64Encode(bytes.data() + offset, static_cast<uint16_t>(len), chunk));
+    }
+
+    PutChar(output, '"');
+}
+
+CHIP_ERROR PutElement(TLV::TLVReader & reader, Encoding::BufferWriter & output)
+{
+    switch (reader.GetType())
+    {
+    case TLV::kTLVType_UnsignedInteger: {
+        uint64_t v;
+        ReturnErrorOnFailure(reader.Get(v));
+        PutUnsigned(output, v);
+        break;
+    }
+
+    case TLV::kTLVType_SignedInteger: {
+        int64_t v;
+        ReturnErrorOnFailure(reader.Get(v));
+        PutSigned(output, v);
+        break;
+    }
+
+    case TLV::kTLVType_Boolean: {
+        bool v;
+        ReturnErrorOnFailure(reader.Get(v));
+        output.Put(v ? "true" : "false");
+        break;
+    }
+
+    case TLV::kTLVType_FloatingPointNumber: {
+        double v;
+        ReturnErrorOnFailure(reader.Get(v));
+        PutDouble(output, v);
+        break;
+    }
+
+    case TLV::kTLVType_ByteString: {
+        ByteSpan span;
+        ReturnErrorOnFailure(reader.Get(span));
+        PutBase64String(output, span);
+        break;
+    }
+
+    case TLV::kTLVType_UTF8String: {
+        CharSpan span;
+        ReturnErrorOnFailure(reader.Get(span));
+        PutQuotedString(output, span);
+        break;
+    }
+
+    case TLV::kTLVType_Null: {
+        output.Put("null");
+        break;
+    }
+
+    case TLV::kTLVType_Structure:
+    case TLV::kTLVType_Array: {
+        const bool isStructure = (reader.GetType() == TLV::kTLVType_Structure);
+        TLV::TLVType containerType;
+        ReturnErrorOnFailure(reader.EnterContainer(containerType));
+
+        CHIP_ERROR err;
+        bool first = true;
+
+        PutChar(output, isStructure ? '{' : '[');
+        while ((err = reader.Next()) == CHIP_NO_ERROR)
+        {
+            if (!first)
+            {
+                PutChar(output, ',');
+            }
+            first = false;
+
+            if (isStructure)
+            {
+                VerifyOrReturnError(TLV::IsContextTag(reader.GetTag()), CHIP_ERROR_INVALID_TLV_TAG);
+                PutChar(output, '"');
+                PutUnsigned(output, TLV::TagNumFromTag(reader.GetTag()));
+                output.Put("\":");
+            }
+
+            ReturnErrorOnFailure(PutElement(reader, output));
+        }
+
+        VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+        ReturnErrorOnFailure(reader.ExitContainer(containerType));
+        PutChar(output, isStructure ? '}' : ']');
+        break;
+    }
+
+    default:
+        return CHIP_ERROR_INVALID_TLV_ELEMENT;
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ReadHex4(const char * p, const char * end, uint32_t & value)
+{
+    VerifyOrReturnError(end - p >= 4, CHIP_ERROR_INVALID_ARGUMENT);
+
+    value = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        const char c = p[i];
+        uint32_t digit;
+        if (IsDigit(c))
+        {
+            digit = static_cast<uint32_t>(c - '0');
+        }
+        else if (c >= 'a' && c <= 'f')
+        {
+            digit = static_cast<uint32_t>(c - 'a' + 10);
+        }
+        else if (c >= 'A' && c <= 'F')
+        {
+            digit = static_cast<uint32_t>(c - 'A' + 10);
+        }
+        else
+        {
+            return CHIP_ERROR_INVALID_ARGUMENT;
+        }
+        value = (value << 4) | digit;
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+size_t PutUtf8(uint32_t codePoint, char * out)
+{
+    if (codePoint < 0x80)
+    {
+        out[0] = static_cast<char>(codePoint);
+        return 1;
+    }
+    if (codePoint < 0x800)
+    {
+        out[0] = static_cast<char>(0xC0 | (codePoint >> 6));
+        out[1] = static_cast<char>(0x80 | (codePoint & 0x3F));
+        return 2;
+    }
+    if (codePoint < 0x10000)
+    {
+        out[0] = static_cast<char>(0xE0 | (codePoint >> 12));
+        out[1] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        out[2] = static_cast<char>(0x80 | (codePoint & 0x3F));
+        return 3;
+    }
+    out[0] = static_cast<char>(0xF0 | (codePoint >> 18));
+    out[1] = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+    out[2] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+    out[3] = static_cast<char>(0x80 | (codePoint & 0x3F));
+    return 4;
+}
+
+/*
+ * Parses JSON text, writing each value to the TLV writer as soon as it is parsed. Strings are
+ * written straight from the JSON text, unless they contain escapes or are byte strings, which
+ * are decoded to a scratch buffer reused for the whole text.
+ */
+class JsonTlvEncoder
+{
+public:
+    JsonTlvEncoder(const CharSpan & json, TLV::TLVWriter & writer) :
+        mCursor(json.data()), mEnd(json.data() + json.size()), mWriter(writer)
+    {}
+
+    CHIP_ERROR Encode();
+
+private:
+    CHIP_ERROR EncodeValue(TLV::Tag tag, uint8_t depth);
+    CHIP_ERROR EncodeObject(TLV::Tag tag, uint8_t depth);
+    CHIP_ERROR EncodeArray(TLV::Tag tag, uint8_t depth);
+    CHIP_ERROR EncodeString(TLV::Tag tag);
+    CHIP_ERROR EncodeNumber(TLV::Tag tag);
+    CHIP_ERROR EncodeLiteral(TLV::Tag tag);
+
+    CHIP_ERROR ReadString(CharSpan & str, bool & escaped);
+    CHIP_ERROR ReadFieldId(uint8_t & fieldId);
+    CHIP_ERROR Unescape(const CharSpan & str, char * out, CharSpan & unescaped);
+    uint8_t * GetScratch(size_t size);
+
+    void SkipWhitespace();
+    bool Skip(char c);
+    bool SkipWord(const char * word);
+
+    const char * mCursor;
+    const char * const mEnd;
+    TLV::TLVWriter & mWriter;
+    Platform::ScopedMemoryBuffer<uint8_t> mScratch;
+    size_t mScratchSize = 0;
+};
+
+CHIP_ERROR JsonTlvEncoder::Encode()
+{
+    CharSpan key;
+    bool escaped;
+
+    VerifyOrReturnError(Skip('{'), CHIP_ERROR_INVALID_ARGUMENT);
+    SkipWhitespace();
+    ReturnErrorOnFailure(ReadString(key, escaped));
+    VerifyOrReturnError(!escaped && key.data_equal(CharSpan::fromCharString(kRootKey)), CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(Skip(':'), CHIP_ERROR_INVALID_ARGUMENT);
+    ReturnErrorOnFailure(EncodeValue(TLV::AnonymousTag(), 0));
+    VerifyOrReturnError(Skip('}'), CHIP_ERROR_INVALID_ARGUMENT);
+    SkipWhitespace();
+    VerifyOrReturnError(mCursor == mEnd, CHIP_ERROR_INVALID_ARGUMENT);
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR JsonTlvEncoder::EncodeValue(TLV::Tag tag, uint8_t depth)
+{
+    SkipWhitespace();
+    VerifyOrReturnError(mCursor < mEnd, CHIP_ERROR_INVALID_ARGUMENT);
+
+    switch (*mCursor)
+    {
+    case '{':
+        return EncodeObject(tag, depth);
+    case '[':
+        return EncodeArray(tag, depth);
+    case '"':
+        return EncodeString(tag);
+    default:
+        return (*mCursor == '-' || IsDigit(*mCursor)) ? EncodeNumber(tag) : EncodeLiteral(tag);
+    }
+}
+
+CHIP_ERROR JsonTlvEncoder::EncodeObject(TLV::Tag tag, uint8_t depth)
+{
+    TLV::TLVType outer;
+
+    VerifyOrReturnError(depth < kMaxJsonDepth, CHIP_ERROR_INVALID_ARGUMENT);
+    mCursor++;
+
+    ReturnErrorOnFailure(mWriter.StartContainer(tag, TLV::kTLVType_Structure, outer));
+    if (!Skip('}'))
+    {
+        do
+        {
+            uint8_t fieldId;
+            SkipWhitespace();
+            ReturnErrorOnFailure(ReadFieldId(fieldId));
+            VerifyOrReturnError(Skip(':'), CHIP_ERROR_INVALID_ARGUMENT);
+            ReturnErrorOnFailure(EncodeValue(TLV::ContextTag(fieldId), static_cast<uint8_t>(depth + 1)));
+        } while (Skip(','));
+        VerifyOrReturnError(Skip('}'), CHIP_ERROR_INVALID_ARGUMENT);
+    }
+
+    return mWriter.EndContainer(outer);
+}
+
+CHIP_ERROR JsonTlvEncoder::EncodeArray(TLV::Tag tag, uint8_t depth)
+{
+    TLV::TLVType outer;
+
+    VerifyOrReturnError(depth < kMaxJsonDepth, CHIP_ERROR_INVALID_ARGUMENT);
+    mCursor++;
+
+    ReturnErrorOnFailure(mWriter.StartContainer(tag, TLV::kTLVType_Array, outer));
+    if (!Skip(']'))
+    {
+        do
+        {
+            ReturnErrorOnFailure(EncodeValue(TLV::AnonymousTag(), static_cast<uint8_t>(depth + 1)));
+        } while (Skip(','));
+        VerifyOrReturnError(Skip(']'), CHIP_ERROR_INVALID_ARGUMENT);
+    }
+
+    return mWriter.EndContainer(outer);
+}
+
+CHIP_ERROR JsonTlvEncoder::EncodeString(TLV::Tag tag)
+{
+    CharSpan str;
+    bool escaped;
+
+    ReturnErrorOnFailure(ReadString(str, escaped));
+
+    const bool isByteString = str.size() >= kBase64HeaderLen && memcmp(str.data(), kBase64Header, kBase64HeaderLen) == 0;
+    if (!escaped && !isByteString)
+    {
+        return mWriter.PutString(tag, str);
+    }
+
+    // The scratch buffer holds the unescaped string, followed by the decoded bytes.
+    const size_t unescapedMax = escaped ? str.size() : 0;
+    const size_t decodedMax   = isByteString ? BASE64_MAX_DECODED_LEN(str.size()) : 0;
+    uint8_t * scratch         = GetScratch(unescapedMax + decodedMax);
+    VerifyOrReturnError(scratch != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    if (escaped)
+    {
+        ReturnErrorOnFailure(Unescape(str, reinterpret_cast<char *>(scratch), str));
+    }
+    if (!isByteString)
+    {
+        return mWriter.PutString(tag, str);
+    }
+
+    const CharSpan encoded = str.SubSpan(kBase64HeaderLen);
+    VerifyOrReturnError(CanCastTo<uint32_t>(encoded.size()), CHIP_ERROR_INVALID_ARGUMENT);
+
+    uint8_t * decoded         = scratch + unescapedMax;
+    const uint32_t decodedLen = Base64Decode32(encoded.data(), static_cast<uint32_t>(encoded.size()), decoded);
+    VerifyOrReturnError(decodedLen != UINT32_MAX, CHIP_ERROR_INVALID_ARGUMENT);
+
+    return mWriter.PutBytes(tag, decoded, decodedLen);
+}
+
+CHIP_ERROR JsonTlvEncoder::EncodeNumber(TLV::Tag tag)
+{
+    const char * start  = mCursor;
+    const bool negative = (*mCursor == '-');
+    uint64_t magnitude  = 0;
+    bool isInteger      = true;
+
+    if (negative)
+    {
+        mCursor++;
+    }
+
+    const char * digits = mCursor;
+    for (; mCursor < mEnd && IsDigit(*mCursor); mCursor++)
+    {
+        const uint64_t digit = static_cast<uint64_t>(*mCursor - '0');
+        isInteger            = isInteger && magnitude <= (UINT64_MAX - digit) / 10;
+        magnitude            = magnitude * 10 + digit;
+    }
+    VerifyOrReturnError(mCursor > digits, CHIP_ERROR_INVALID_ARGUMENT);
+
+    for (; mCursor < mEnd && (IsDigit(*mCursor) || (*mCursor != '\0' && strchr(".eE+-", *mCursor) != nullptr)); mCursor++)
+    {
+        isInteger = false;
+    }
+
+    if (isInteger && !negative)
+    {
+        return mWriter.Put(tag, magnitude);
+    }
+    if (isInteger && magnitude <= static_cast<uint64_t>(INT64_MAX))
+    {
+        return mWriter.Put(tag, -static_cast<int64_t>(magnitude));
+    }
+    if (isInteger && magnitude == static_cast<uint64_t>(INT64_MAX) + 1)
+    {
+        return mWriter.Put(tag, INT64_MIN);
+    }
+
+    // Numbers with a fraction or an exponent, and integers out of range, are doubles, as for jsoncpp.
+    char number[kMaxNumberLen + 1];
+    const size_t len = static_cast<size_t>(mCursor - start);
+    VerifyOrReturnError(len <= kMaxNumberLen, CHIP_ERROR_INVALID_ARGUMENT);
+    memcpy(number, start, len);
+    number[len] = '\0';
+
+    char * parsed;
+    const double value = strtod(number, &parsed);
+    VerifyOrReturnError(parsed == number + len, CHIP_ERROR_INVALID_ARGUMENT);
+
+    return mWriter.Put(tag, value);
+}
+
+CHIP_ERROR JsonTlvEncoder::EncodeLiteral(TLV::Tag tag)
+{
+    if (SkipWord("true"))
+    {
+        return mWriter.PutBoolean(tag, true);
+    }
+    if (SkipWord("false"))
+    {
+        return mWriter.PutBoolean(tag, false);
+    }
+    if (SkipWord("null"))
+    {
+        return mWriter.PutNull(tag);
+    }
+    return CHIP_ERROR_INVALID_ARGUMENT;
+}
+
+CHIP_ERROR JsonTlvEncoder::ReadString(CharSpan & str, bool & escaped)
+{
+    VerifyOrReturnError(mCursor < mEnd && *mCursor == '"', CHIP_ERROR_INVALID_ARGUMENT);
+
+    const char * start = ++mCursor;
+    escaped            = false;
+
+    for (; mCursor < mEnd; mCursor++)
+    {
+        if (*mCursor == '"')
+        {
+            str = CharSpan(start, static_cast<size_t>(mCursor - start));
+            mCursor++;
+            return CHIP_NO_ERROR;
+        }
+        if (*mCursor == '\\')
+        {
+            // The escaped character is validated by Unescape().
+            escaped = true;
+            VerifyOrReturnError(++mCursor < mEnd, CHIP_ERROR_INVALID_ARGUMENT);
+        }
+        else
+        {
+            VerifyOrReturnError(static_cast<uint8_t>(*mCursor) >= 0x20, CHIP_ERROR_INVALID_ARGUMENT);
+        }
+    }
+
+    return CHIP_ERROR_INVALID_ARGUMENT;
+}
+
+CHIP_ERROR JsonTlvEncoder::ReadFieldId(uint8_t & fieldId)
+{
+    CharSpan key;
+    bool escaped;
+    uint32_t value = 0;
+
+    ReturnErrorOnFailure(ReadString(key, escaped));
+    VerifyOrReturnError(!escaped && !key.empty(), CHIP_ERROR_INVALID_ARGUMENT);
+
+    for (char c : key)
+    {
+        VerifyOrReturnError(IsDigit(c) && value <= UINT8_MAX, CHIP_ERROR_INVALID_ARGUMENT);
+        value = value * 10 + static_cast<uint32_t>(c - '0');
+    }
+    VerifyOrReturnError(value <= UINT8_MAX, CHIP_ERROR_INVALID_ARGUMENT);
+
+    fieldId = static_cast<uint8_t>(value);
+    return CHIP_NO_ERROR;
+}
+
+// Unescaped strings are never longer than the escaped ones: escapes of up to 4 bytes of UTF-8 take at least 6 characters.
+CHIP_ERROR JsonTlvEncoder::Unescape(const CharSpan & str, char * out, CharSpan & unescaped)
+{
+    const char * end = str.data() + str.size();
+    size_t len       = 0;
+
+    for (const char * p = str.data(); p < end; p++)
+    {
+        if (*p != '\\')
+        {
+            out[len++] = *p;
+            continue;
+        }
+
+        // ReadString() made sure that a character follows each backslash.
+        switch (*++p)
+        {
+        case '"':
+        case '\\':
+        case '/':
+            out[len++] = *p;
+            break;
+        case 'b':
+            out[len++] = '\b';
+            break;
+        case 'f':
+            out[len++] = '\f';
+            break;
+        case 'n':
+            out[len++] = '\n';
+            break;
+        case 'r':
+            out[len++] = '\r';
+            break;
+        case 't':
+            out[len++] = '\t';
+            break;
+        case 'u': {
+            uint32_t codePoint;
+            ReturnErrorOnFailure(ReadHex4(p + 1, end, codePoint));
+            p += 4;
+
+            if (codePoint >= 0xD800 && codePoint < 0xDC00)
+            {
+                // A high surrogate, which must be followed by the escape of a low one.
+                uint32_t low;
+                VerifyOrReturnError(end - p > 2 && p[1] == '\\' && p[2] == 'u', CHIP_ERROR_INVALID_ARGUMENT);
+                ReturnErrorOnFailure(ReadHex4(p + 3, end, low));
+                VerifyOrReturnError(low >= 0xDC00 && low < 0xE000, CHIP_ERROR_INVALID_ARGUMENT);
+                p += 6;
+                codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+            }
+            else
+            {
+                VerifyOrReturnError(codePoint < 0xDC00 || codePoint >= 0xE000, CHIP_ERROR_INVALID_ARGUMENT);
+            }
+
+            len += PutUtf8(codePoint, out + len);
+            break;
+        }
+        default:
+            return CHIP_ERROR_INVALID_ARGUMENT;
+        }
+    }
+
+    unescaped = CharSpan(out, len);
+    return CHIP_NO_ERROR;
+}
+
+uint8_t * JsonTlvEncoder::GetScratch(size_t size)
+{
+    if (size > mScratchSize)
+    {
+        mScratch.Alloc(size);
+        mScratchSize = (mScratch.Get() != nullptr) ? size : 0;
+    }
+    return mScratch.Get();
+}
+
+void JsonTlvEncoder::SkipWhitespace()
+{
+    while (mCursor < mEnd && (*mCursor == ' ' || *mCursor == '\t' || *mCursor == '\n' || *mCursor == '\r'))
+    {
+        mCursor++;
+    }
+}
+
+bool JsonTlvEncoder::Skip(char c)
+{
+    SkipWhitespace();
+    VerifyOrReturnValue(mCursor < mEnd && *mCursor == c, false);
+    mCursor++;
+    return true;
+}
+
+bool JsonTlvEncoder::SkipWord(const char * word)
+{
+    const size_t len = strlen(word);
+    VerifyOrReturnValue(static_cast<size_t>(mEnd - mCursor) >= len && memcmp(mCursor, word, len) == 0, false);
+    mCursor += len;
+    return true;
+}
+
+} // namespace
+
+CHIP_ERROR TlvToJson(TLV::TLVReader & reader, Encoding::BufferWriter & output)
+{
+    output.Put("{\"");
+    output.Put(kRootKey);
+    output.Put("\":");
+    ReturnErrorOnFailure(PutElement(reader, output));
+    PutChar(output, '}');
+
+    return output.Fit() ? CHIP_NO_ERROR : CHIP_ERROR_BUFFER_TOO_SMALL;
+}
+
+CHIP_ERROR JsonToTlv(const CharSpan & json, TLV::TLVWriter & writer)
+{
+    JsonTlvEncoder encoder(json, writer);
+    return encoder.Encode();
+}
+
+} // namespace chip
@@ -0,0 +1,69 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Streaming conversions between TLV and the JSON representation of TlvJson.h,
+ *      which go straight from a TLVReader to an output buffer and from JSON text to
+ *      a TLVWriter, without building a Json::Value tree.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <lib/core/TLV.h>
+#include <lib/support/BufferWriter.h>
+#include <lib/support/Span.h>
+
+namespace chip {
+
+/*
+ * Given a TLVReader positioned at a particular cluster data payload, this function writes
+ * the JSON representation of the payload to the output, as JsonToString() would for the
+ * Json::Value produced by TlvToJson(), e.g. {"value":{"0":20,"1":true}}, with these differences:
+ *
+ *   - struct fields are written in the order they are encoded in,
+ *   - empty structures and byte strings are written as {} and "base64:", so that JsonToTlv()
+ *     encodes them back as such,
+ *   - strings are written whole, rather than up to their first null character,
+ *   - there is no bound on the length of strings, as nothing is allocated.
+ *
+ * The output is not null-terminated.
+ *
+ * @retval #CHIP_NO_ERROR                  If the payload was converted; output.Needed() is the length of the JSON.
+ * @retval #CHIP_ERROR_BUFFER_TOO_SMALL    If the JSON did not fit; output.Needed() is the length required.
+ * @retval other                           The error met reading the payload, or the payload is not supported.
+ */
+CHIP_ERROR TlvToJson(TLV::TLVReader & reader, Encoding::BufferWriter & output);
+
+/*
+ * Encodes the JSON representation of a cluster data payload, as written by TlvToJson(), into
+ * a single element with an anonymous tag. The JSON is encoded as it is parsed:
+ *
+ *   - objects become structures, whose member names are the context tags of their fields,
+ *   - arrays become arrays,
+ *   - strings starting with "base64:" become byte strings, and other strings UTF-8 strings,
+ *   - integers become unsigned integers, or signed integers when negative, and other numbers doubles,
+ *   - true, false and null become booleans and null.
+ *
+ * @retval #CHIP_NO_ERROR               If the payload was encoded.
+ * @retval #CHIP_ERROR_INVALID_ARGUMENT If the JSON is malformed or is not such a representation.
+ * @retval other                        The error met writing the payload.
+ */
+CHIP_ERROR JsonToTlv(const CharSpan & json, TLV::TLVWriter & writer);
+
+} // namespace chip
@@ -0,0 +1,603 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <lib/support/logging/BinaryLogFormat.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/SafeInt.h>
+#include <lib/support/TypeTraits.h>
+
+#include <cinttypes>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+
+namespace chip {
+namespace Logging {
+namespace BinaryLog {
+
+namespace {
+
+// Longest conversion specification handled, such as "%-#012.345llx".
+constexpr size_t kMaxConversionLength = 31;
+
+constexpr char kNullString[] = "(null)";
+
+enum class LengthModifier : uint8_t
+{
+    kNone,
+    kChar,
+    kShort,
+    kLong,
+    kLongLong,
+    kIntMax,
+    kSize,
+    kPtrDiff,
+    kLongDouble,
+};
+
+enum class ArgumentType : uint8_t
+{
+    kNone, ///< "%%"
+    kSigned,
+    kUnsigned,
+    kDouble,
+    kPointer,
+    kString,
+    kUnsupported,
+};
+
+struct Conversion
+{
+    size_t length                 = 0; ///< From the '%' to the conversion specifier included
+    bool widthArgument            = false;
+    bool precisionArgument        = false;
+    bool hasPrecision             = false;
+    size_t precision              = 0;
+    LengthModifier lengthModifier = LengthModifier::kNone;
+    ArgumentType type             = ArgumentType::kUnsupported;
+};
+
+// Parses the conversion specification starting with the '%' at 'spec'.
+Conversion ParseConversion(const char * spec)
+{
+    Conversion conversion;
+    const char * p = spec + 1;
+
+    p += strspn(p, "-+ #0'");
+    if (*p == '*')
+    {
+        conversion.widthArgument = true;
+        p++;
+    }
+    else
+    {
+        p += strspn(p, "0123456789");
+    }
+
+    if (*p == '.')
+    {
+        conversion.hasPrecision = true;
+        p++;
+        if (*p == '*')
+        {
+            conversion.precisionArgument = true;
+            p++;
+        }
+        else
+        {
+            for (; *p >= '0' && *p <= '9'; p++)
+            {
+                conversion.precision = chip::min(conversion.precision * 10 + static_cast<size_t>(*p - '0'), kMaxStringArgumentLength);
+            }
+        }
+    }
+
+    switch (*p)
+    {
+    case 'h':
+        conversion.lengthModifier = (p[1] == 'h') ? LengthModifier::kChar : LengthModifier::kShort;
+        p += (p[1] == 'h') ? 2 : 1;
+        break;
+    case 'l':
+        conversion.lengthModifier = (p[1] == 'l') ? LengthModifier::kLongLong : LengthModifier::kLong;
+        p += (p[1] == 'l') ? 2 : 1;
+        break;
+    case 'j':
+        conversion.lengthModifier = LengthModifier::kIntMax;
+        p++;
+        break;
+    case 'z':
+        conversion.lengthModifier = LengthModifier::kSize;
+        p++;
+        break;
+    case 't':
+        conversion.lengthModifier = LengthModifier::kPtrDiff;
+        p++;
+        break;
+    case 'L':
+        conversion.lengthModifier = LengthModifier::kLongDouble;
+        p++;
+        break;
+    default:
+        break;
+    }
+
+    switch (*p)
+    {
+    case '%':
+        conversion.type = ArgumentType::kNone;
+        break;
+    case 'd':
+    case 'i':
+        conversion.type = ArgumentType::kSigned;
+        break;
+    case 'u':
+    case 'o':
+    case 'x':
+    case 'X':
+        conversion.type = ArgumentType::kUnsigned;
+        break;
+    case 'c':
+        // Wide characters are not supported.
+        conversion.type = (conversion.lengthModifier == LengthModifier::kNone) ? ArgumentType::kSigned : ArgumentType::kUnsupported;
+        break;
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+        conversion.type = ArgumentType::kDouble;
+        break;
+    case 'p':
+        conversion.type = ArgumentType::kPointer;
+        break;
+    case 's':
+        // Wide strings are not supported.
+        conversion.type = (conversion.lengthModifier == LengthModifier::kNone) ? ArgumentType::kString : ArgumentType::kUnsupported;
+        break;
+    default:
+        // Including "%n", which writes to its argument.
+        conversion.type = ArgumentType::kUnsupported;
+        break;
+    }
+
+    if (*p != '\0')
+    {
+        p++;
+    }
+    conversion.length = static_cast<size_t>(p - spec);
+    if (conversion.length > kMaxConversionLength)
+    {
+        conversion.type = ArgumentType::kUnsupported;
+    }
+
+    return conversion;
+}
+
+uint64_t ReadSignedArgument(LengthModifier lengthModifier, va_list * args)
+{
+    switch (lengthModifier)
+    {
+    case LengthModifier::kLong:
+        return static_cast<uint64_t>(static_cast<int64_t>(va_arg(*args, long)));
+    case LengthModifier::kLongLong:
+        return static_cast<uint64_t>(static_cast<int64_t>(va_arg(*args, long long)));
+    case LengthModifier::kIntMax:
+        return static_cast<uint64_t>(static_cast<int64_t>(va_arg(*args, intmax_t)));
+    case LengthModifier::kSize:
+        return static_cast<uint64_t>(static_cast<int64_t>(va_arg(*args, std::make_signed_t<size_t>)));
+    case LengthModifier::kPtrDiff:
+        return static_cast<uint64_t>(static_cast<int64_t>(va_arg(*args, ptrdiff_t)));
+    default:
+        // Narrower arguments are promoted to int.
+        return static_cast<uint64_t>(static_cast<int64_t>(va_arg(*args, int)));
+    }
+}
+
+uint64_t ReadUnsignedArgument(LengthModifier lengthModifier, va_list * args)
+{
+    switch (lengthModifier)
+    {
+    case LengthModifier::kLong:
+        return static_cast<uint64_t>(va_arg(*args, unsigned long));
+    case LengthModifier::kLongLong:
+        return static_cast<uint64_t>(va_arg(*args, unsigned long long));
+    case LengthModifier::kIntMax:
+        return static_cast<uint64_t>(va_arg(*args, uintmax_t));
+    case LengthModifier::kSize:
+        return static_cast<uint64_t>(va_arg(*args, size_t));
+    case LengthModifier::kPtrDiff:
+        return static_cast<uint64_t>(va_arg(*args, std::make_unsigned_t<ptrdiff_t>));
+    default:
+        // Narrower arguments are promoted to int.
+        return static_cast<uint64_t>(va_arg(*args, unsigned int));
+    }
+}
+
+CHIP_ERROR EncodeArgumentList(const char * format, va_list * args, MutableByteSpan & buffer)
+{
+    Encoding::LittleEndian::BufferWriter writer(buffer.data(), buffer.size());
+
+    for (const char * spec = strchr(format, '%'); spec != nullptr; spec = strchr(spec, '%'))
+    {
+        Conversion conversion = ParseConversion(spec);
+        VerifyOrReturnError(conversion.type != ArgumentType::kUnsupported, CHIP_ERROR_NOT_IMPLEMENTED);
+        spec += conversion.length;
+
+        if (conversion.widthArgument)
+        {
+            writer.Put32(static_cast<uint32_t>(va_arg(*args, int)));
+        }
+        if (conversion.precisionArgument)
+        {
+            // A negative precision is taken as if the precision were omitted.
+            int precision = va_arg(*args, int);
+            writer.Put32(static_cast<uint32_t>(precision));
+            conversion.hasPrecision = (precision >= 0);
+            conversion.precision    = static_cast<size_t>(chip::max(precision, 0));
+        }
+
+        switch (conversion.type)
+        {
+        case ArgumentType::kSigned:
+            writer.Put64(ReadSignedArgument(conversion.lengthModifier, args));
+            break;
+        case ArgumentType::kUnsigned:
+            writer.Put64(ReadUnsignedArgument(conversion.lengthModifier, args));
+            break;
+        case ArgumentType::kDouble: {
+            double value = (conversion.lengthModifier == LengthModifier::kLongDouble) ? static_cast<double>(va_arg(*args, long double))
+                                                                                        : va_arg(*args, double);
+            uint64_t bits;
+            static_assert(sizeof(bits) == sizeof(value), "double is expected to be 64 bits");
+            memcpy(&bits, &value, sizeof(bits));
+            writer.Put64(bits);
+            break;
+        }
+        case ArgumentType::kPointer:
+            writer.Put64(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(va_arg(*args, void *))));
+            break;
+        case ArgumentType::kString: {
+            const char * string = va_arg(*args, const char *);
+            size_t maxLength    = conversion.hasPrecision ? chip::min(conversion.precision, kMaxStringArgumentLength)
+                                                          : kMaxStringArgumentLength;
+            if (string == nullptr)
+            {
+                string = kNullString;
+            }
+            if (writer.Available() > sizeof(uint16_t))
+            {
+                maxLength = chip::min(maxLength, writer.Available() - sizeof(uint16_t));
+            }
+            const size_t length = strnlen(string, maxLength);
+            writer.Put16(static_cast<uint16_t>(length)).Put(string, length);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    VerifyOrReturnError(writer.Fit(), CHIP_ERROR_BUFFER_TOO_SMALL);
+    buffer.reduce_size(writer.Needed());
+    return CHIP_NO_ERROR;
+}
+
+// Formats a single argument with its conversion specification, passing the width and precision
+// arguments of the specification first.
+template <typename T>
+int FormatArgument(char * out, size_t size, const char * spec, const Conversion & conversion, int width, int precision, T value)
+{
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wformat-nonliteral"
+    if (conversion.widthArgument && conversion.precisionArgument)
+    {
+        return snprintf(out, size, spec, width, precision, value);
+    }
+    if (conversion.widthArgument)
+    {
+        return snprintf(out, size, spec, width, value);
+    }
+    if (conversion.precisionArgument)
+    {
+        return snprintf(out, size, spec, precision, value);
+    }
+    return snprintf(out, size, spec, value);
+#pragma GCC diagnostic pop
+}
+
+int FormatSignedArgument(char * out, size_t size, const char * spec, const Conversion & conversion, int width, int precision,
+                         uint64_t value)
+{
+    const auto signedValue = static_cast<int64_t>(value);
+
+    switch (conversion.lengthModifier)
+    {
+    case LengthModifier::kLong:
+        return FormatArgument(out, size, spec, conversion, width, precision, static_cast<long>(signedValue));
+    case LengthModifier::kLongLong:
+        return FormatArgument(out, size, spec, conversion, width, precision, static_cast<long long>(signedValue));
+    case LengthModifier::kIntMax:
+        return FormatArgument(out, size, spec, conversion, width, precision, static_cast<intmax_t>(signedValue));
+    case LengthModifier::kSize:
+        return FormatArgument(out, size, spec, conversion, width, precision, static_cast<std::make_signed_t<size_t>>(signedValue));
+    case LengthModifier::kPtrDiff:
+        return FormatArgument(out, size, spec, conversion, width, precision, static_cast<ptrdiff_t>(signedValue));
+    default:
+        return FormatArgument(out, size, spec, conversion, width, precision, static_cast<int>(signedValue));
+    }
+}
+
+int FormatUnsignedArgument(char * out, size_t size, const char * spec, const Conversion & conversion, int width, int precision,
+                           uint64_t value)
+{
+    switch (conversion.lengthModifier)
+    {
+    case LengthModifier::kLong:
+        return FormatArgument(out, size, spec, conversion, width, precision, static_cast<unsigned long>(value));
+    case LengthModifier::kLongLong:
+        return FormatArgument(out, size, spec, conversion, width, precision, static_cast<unsigned long long>(value));
+    case LengthModifier::kIntMax:
+        return FormatArgument(out, size, spec, conversion, width, precision, static_cast<uintmax_t>(value));
+    case LengthModifier::kSize:
+        return FormatArgument(out, size, spec, conversion, width, precision, static_cast<size_t>(value));
+    case LengthModifier::kPtrDiff:
+        return FormatArgument(out, size, spec, conversion, width, precision,
+                              static_cast<std::make_unsigned_t<ptrdiff_t>>(value));
+    default:
+        return FormatArgument(out, size, spec, conversion, width, precision, static_cast<unsigned int>(value));
+    }
+}
+
+CHIP_ERROR PutRecordHeader(Encoding::LittleEndian::BufferWriter & writer, RecordType type, size_t bodyLength)
+{
+    VerifyOrReturnError(CanCastTo<uint16_t>(bodyLength), CHIP_ERROR_INVALID_ARGUMENT);
+    writer.Put8(to_underlying(type)).Put16(static_cast<uint16_t>(bodyLength));
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR WriterStatus(const Encoding::LittleEndian::BufferWriter & writer)
+{
+    return writer.Fit() ? CHIP_NO_ERROR : CHIP_ERROR_BUFFER_TOO_SMALL;
+}
+
+} // namespace
+
+CHIP_ERROR EncodeArguments(const char * format, va_list args, MutableByteSpan & buffer)
+{
+    va_list remainingArgs;
+    va_copy(remainingArgs, args);
+    CHIP_ERROR err = EncodeArgumentList(format, &remainingArgs, buffer);
+    va_end(remainingArgs);
+    return err;
+}
+
+CHIP_ERROR FormatMessage(const char * format, ByteSpan arguments, MutableCharSpan & buffer)
+{
+    VerifyOrReturnError(buffer.size() > 0, CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    Encoding::LittleEndian::Reader reader(arguments);
+    char * out        = buffer.data();
+    const size_t size = buffer.size();
+    size_t length     = 0; // Formatted so far, without the terminating null
+    const char * next = format;
+
+    while (*next != '\0')
+    {
+        const char * spec    = strchr(next, '%');
+        size_t literalLength = (spec == nullptr) ? strlen(next) : static_cast<size_t>(spec - next);
+        literalLength        = chip::min(literalLength, size - 1 - length);
+        memcpy(out + length, next, literalLength);
+        length += literalLength;
+        if (spec == nullptr)
+        {
+            break;
+        }
+
+        Conversion conversion = ParseConversion(spec);
+        VerifyOrReturnError(conversion.type != ArgumentType::kUnsupported, CHIP_ERROR_INVALID_ARGUMENT);
+        next = spec + conversion.length;
+
+        char conversionSpec[kMaxConversionLength + 1];
+        memcpy(conversionSpec, spec, conversion.length);
+        conversionSpec[conversion.length] = '\0';
+
+        uint32_t width     = 0;
+        uint32_t precision = 0;
+        if (conversion.widthArgument)
+        {
+            VerifyOrReturnError(reader.Read32(&width).StatusCode() == CHIP_NO_ERROR, CHIP_ERROR_INVALID_ARGUMENT);
+        }
+        if (conversion.precisionArgument)
+        {
+            VerifyOrReturnError(reader.Read32(&precision).StatusCode() == CHIP_NO_ERROR, CHIP_ERROR_INVALID_ARGUMENT);
+        }
+
+        char * argumentOut        = out + length;
+        const size_t available    = size - length;
+        const auto widthValue     = static_cast<int>(static_cast<int32_t>(width));
+        const auto precisionValue = static_cast<int>(static_cast<int32_t>(precision));
+        int written               = 0;
+        uint64_t value            = 0;
+        char string[kMaxStringArgumentLength + 1];
+        uint16_t stringLength = 0;
+
+        switch (conversion.type)
+        {
+        case ArgumentType::kNone:
+            written = (available > 1) ? snprintf(argumentOut, available, "%%") : 1;
+            break;
+        case ArgumentType::kSigned:
+            VerifyOrReturnError(reader.Read64(&value).StatusCode() == CHIP_NO_ERROR, CHIP_ERROR_INVALID_ARGUMENT);
+            written = FormatSignedArgument(argumentOut, available, conversionSpec, conversion, widthValue, precisionValue, value);
+            break;
+        case ArgumentType::kUnsigned:
+            VerifyOrReturnError(reader.Read64(&value).StatusCode() == CHIP_NO_ERROR, CHIP_ERROR_INVALID_ARGUMENT);
+            written = FormatUnsignedArgument(argumentOut, available, conversionSpec, conversion, widthValue, precisionValue, value);
+            break;
+        case ArgumentType::kDouble: {
+            VerifyOrReturnError(reader.Read64(&value).StatusCode() == CHIP_NO_ERROR, CHIP_ERROR_INVALID_ARGUMENT);
+            double doubleValue;
+            memcpy(&doubleValue, &value, sizeof(doubleValue));
+            written = (conversion.lengthModifier == LengthModifier::kLongDouble)
+                ? FormatArgument(argumentOut, available, conversionSpec, conversion, widthValue, precisionValue,
+                                 static_cast<long double>(doubleValue))
+                : FormatArgument(argumentOut, available, conversionSpec, conversion, widthValue, precisionValue, doubleValue);
+            break;
+        }
+        case ArgumentType::kPointer:
+            VerifyOrReturnError(reader.Read64(&value).StatusCode() == CHIP_NO_ERROR, CHIP_ERROR_INVALID_ARGUMENT);
+            written = FormatArgument(argumentOut, available, conversionSpec, conversion, widthValue, precisionValue,
+                                     reinterpret_cast<void *>(static_cast<uintptr_t>(value)));
+            break;
+        case ArgumentType::kString:
+            VerifyOrReturnError(reader.Read16(&stringLength).StatusCode() == CHIP_NO_ERROR, CHIP_ERROR_INVALID_ARGUMENT);
+            VerifyOrReturnError(stringLength <= kMaxStringArgumentLength, CHIP_ERROR_INVALID_ARGUMENT);
+            VerifyOrReturnError(reader.ReadBytes(reinterpret_cast<uint8_t *>(string), stringLength).StatusCode() == CHIP_NO_ERROR,
+                                CHIP_ERROR_INVALID_ARGUMENT);
+            string[stringLength] = '\0';
+            written = FormatArgument(argumentOut, available, conversionSpec, conversion, widthValue, precisionValue,
+                                     static_cast<const char *>(string));
+            break;
+        default:
+            break;
+        }
+
+        VerifyOrReturnError(written >= 0, CHIP_ERROR_INVALID_ARGUMENT);
+        length = chip::min(length + static_cast<size_t>(written), size - 1);
+    }
+
+    VerifyOrReturnError(reader.Remaining() == 0, CHIP_ERROR_INVALID_ARGUMENT);
+    out[length] = '\0';
+    buffer.reduce_size(length);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR FormatLine(uint64_t timestampMicros, uint32_t processId, uint32_t threadId, const char * module, const char * format,
+                      ByteSpan arguments, MutableCharSpan & buffer)
+{
+    VerifyOrReturnError(buffer.size() > 0, CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    int written = snprintf(buffer.data(), buffer.size(), "[%" PRIu64 ".%06" PRIu64 "][%" PRIu32 ":%" PRIu32 "] CHIP:%s: ",
+                           timestampMicros / 1000000, timestampMicros % 1000000, processId, threadId, module);
+    VerifyOrReturnError(written >= 0, CHIP_ERROR_INTERNAL);
+
+    const size_t prefixLength = chip::min(static_cast<size_t>(written), buffer.size() - 1);
+    MutableCharSpan message   = buffer.SubSpan(prefixLength);
+    ReturnErrorOnFailure(FormatMessage(format, arguments, message));
+    buffer.reduce_size(prefixLength + message.size());
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR EncodeFileHeader(Encoding::LittleEndian::BufferWriter & writer, uint32_t processId)
+{
+    writer.Put(kFileMagic, sizeof(kFileMagic)).Put16(kFileVersion).Put32(processId);
+    return WriterStatus(writer);
+}
+
+CHIP_ERROR EncodeStringRecord(Encoding::LittleEndian::BufferWriter & writer, uint32_t id, CharSpan string)
+{
+    ReturnErrorOnFailure(PutRecordHeader(writer, RecordType::kString, sizeof(uint32_t) + string.size()));
+    writer.Put32(id).Put(string.data(), string.size());
+    return WriterStatus(writer);
+}
+
+CHIP_ERROR EncodeMessageRecord(Encoding::LittleEndian::BufferWriter & writer, const MessageRecord & message)
+{
+    constexpr size_t kFixedLength = sizeof(uint64_t) + 3 * sizeof(uint32_t) + sizeof(uint8_t);
+
+    ReturnErrorOnFailure(PutRecordHeader(writer, RecordType::kMessage, kFixedLength + message.arguments.size()));
+    writer.Put64(message.timestampMicros)
+        .Put32(message.threadId)
+        .Put32(message.moduleId)
+        .Put32(message.formatId)
+        .Put8(message.category)
+        .Put(message.arguments.data(), message.arguments.size());
+    return WriterStatus(writer);
+}
+
+CHIP_ERROR EncodeDroppedRecord(Encoding::LittleEndian::BufferWriter & writer, uint32_t threadId, uint32_t dropped)
+{
+    ReturnErrorOnFailure(PutRecordHeader(writer, RecordType::kDropped, 2 * sizeof(uint32_t)));
+    writer.Put32(threadId).Put32(dropped);
+    return WriterStatus(writer);
+}
+
+CHIP_ERROR DecodeFileHeader(ByteSpan & data, uint32_t & processId)
+{
+    VerifyOrReturnError(data.size() >= kFileHeaderSize, CHIP_ERROR_BUFFER_TOO_SMALL);
+    VerifyOrReturnError(memcmp(data.data(), kFileMagic, sizeof(kFileMagic)) == 0, CHIP_ERROR_INVALID_FILE_IDENTIFIER);
+
+    Encoding::LittleEndian::Reader reader(data.SubSpan(sizeof(kFileMagic), kFileHeaderSize - sizeof(kFileMagic)));
+    uint16_t version = 0;
+    ReturnErrorOnFailure(reader.Read16(&version).Read32(&processId).StatusCode());
+    VerifyOrReturnError(version == kFileVersion, CHIP_ERROR_VERSION_MISMATCH);
+
+    data = data.SubSpan(kFileHeaderSize);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR DecodeRecord(ByteSpan & data, Record & record)
+{
+    // Only the record is given to the readers, which cannot track more than 64 KiB.
+    VerifyOrReturnError(data.size() >= kRecordHeaderSize, CHIP_ERROR_BUFFER_TOO_SMALL);
+    Encoding::LittleEndian::Reader reader(data.data(), kRecordHeaderSize);
+    uint8_t type        = 0;
+    uint16_t bodyLength = 0;
+    VerifyOrReturnError(reader.Read8(&type).Read16(&bodyLength).StatusCode() == CHIP_NO_ERROR, CHIP_ERROR_BUFFER_TOO_SMALL);
+    VerifyOrReturnError(data.size() - kRecordHeaderSize >= bodyLength, CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    ByteSpan body = data.SubSpan(kRecordHeaderSize, bodyLength);
+    Encoding::LittleEndian::Reader bodyReader(body);
+    record.type = static_cast<RecordType>(type);
+
+    switch (record.type)
+    {
+    case RecordType::kString:
+        VerifyOrReturnError(bodyReader.Read32(&record.id).StatusCode() == CHIP_NO_ERROR, CHIP_ERROR_DECODE_FAILED);
+        record.string = CharSpan(reinterpret_cast<const char *>(body.data()) + bodyReader.OctetsRead(), bodyReader.Remaining());
+        break;
+    case RecordType::kMessage:
+        VerifyOrReturnError(bodyReader.Read64(&record.message.timestampMicros)
+                                    .Read32(&record.message.threadId)
+                                    .Read32(&record.message.moduleId)
+                                    .Read32(&record.message.formatId)
+                                    .Read8(&record.message.category)
+                                    .StatusCode() == CHIP_NO_ERROR,
+                            CHIP_ERROR_DECODE_FAILED);
+        record.message.arguments = body.SubSpan(bodyReader.OctetsRead());
+        break;
+    case RecordType::kDropped:
+        VerifyOrReturnError(bodyReader.Read32(&record.id).Read32(&record.dropped).StatusCode() == CHIP_NO_ERROR,
+                            CHIP_ERROR_DECODE_FAILED);
+        break;
+    default:
+        break;
+    }
+
+    data = data.SubSpan(kRecordHeaderSize + bodyLength);
+    return CHIP_NO_ERROR;
+}
+
+} // namespace BinaryLog
+} // namespace Logging
+} // namespace chip
@@ -0,0 +1,143 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Encoding of log messages as their format string and raw arguments, so that they can be
+ *      formatted later than when they are logged, by another thread or offline, and the records
+ *      of the binary log file format built on it.
+ *
+ *      A binary log file starts with a header (magic, version, process id), followed by records
+ *      made of a type octet, a 16-bit body length and the body, all integers little-endian:
+ *
+ *         - kString:  string id (32 bits), string; defines a module name or a format string
+ *         - kMessage: timestamp in microseconds since the epoch (64 bits), thread id (32 bits),
+ *                     module string id (32 bits), format string id (32 bits), category (8 bits),
+ *                     encoded arguments
+ *         - kDropped: thread id (32 bits), number of messages dropped by the thread (32 bits)
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <lib/support/BufferReader.h>
+#include <lib/support/BufferWriter.h>
+#include <lib/support/Span.h>
+
+#include <stdarg.h>
+#include <stdint.h>
+
+namespace chip {
+namespace Logging {
+namespace BinaryLog {
+
+/// Longest string argument kept, longer strings are truncated.
+constexpr size_t kMaxStringArgumentLength = 256;
+
+constexpr uint8_t kFileMagic[]     = { 'C', 'H', 'I', 'P', 'B', 'L', 'O', 'G' };
+constexpr uint16_t kFileVersion    = 1;
+constexpr size_t kFileHeaderSize   = sizeof(kFileMagic) + sizeof(uint16_t) + sizeof(uint32_t);
+constexpr size_t kRecordHeaderSize = sizeof(uint8_t) + sizeof(uint16_t);
+
+enum class RecordType : uint8_t
+{
+    kString  = 1,
+    kMessage = 2,
+    kDropped = 3,
+};
+
+struct MessageRecord
+{
+    uint64_t timestampMicros = 0;
+    uint32_t threadId        = 0;
+    uint32_t moduleId        = 0;
+    uint32_t formatId        = 0;
+    uint8_t category         = 0;
+    ByteSpan arguments;
+};
+
+struct Record
+{
+    RecordType type;
+    MessageRecord message; ///< for kMessage
+    uint32_t id      = 0;  ///< string id for kString, thread id for kDropped
+    CharSpan string;       ///< for kString
+    uint32_t dropped = 0;  ///< for kDropped
+};
+
+/**
+ * Encode the arguments of a log message, as described by its printf-style format string.
+ *
+ * Integers, floating point numbers and pointers take 8 octets each; strings are copied, up to
+ * their precision if any and kMaxStringArgumentLength.  Strings are truncated further if needed
+ * for the arguments to fit in the buffer.
+ *
+ * @param[in]     format     The format string of the message.
+ * @param[in]     args       The arguments of the message, which are left for the caller to use
+ *                           again, to format the message right away for instance.
+ * @param[in,out] buffer     The buffer to encode into, reduced to the encoded arguments.
+ *
+ * @retval CHIP_ERROR_BUFFER_TOO_SMALL  The arguments do not fit in the buffer.
+ * @retval CHIP_ERROR_NOT_IMPLEMENTED   The format uses a conversion that cannot be encoded, such
+ *                                      as wide characters; the message must be formatted right away.
+ */
+CHIP_ERROR EncodeArguments(const char * format, va_list args, MutableByteSpan & buffer);
+
+/**
+ * Format a log message from its format string and encoded arguments, as vsnprintf would have
+ * from the original arguments.  The message is truncated to the buffer and always terminated.
+ *
+ * @param[in,out] buffer  The buffer to format into, reduced to the formatted message, without the
+ *                        terminating null.
+ *
+ * @retval CHIP_ERROR_INVALID_ARGUMENT  The arguments do not match the format string.
+ */
+CHIP_ERROR FormatMessage(const char * format, ByteSpan arguments, MutableCharSpan & buffer);
+
+/**
+ * Format a log line as the Linux platform logging does, "[seconds.micros][pid:tid] CHIP:module: message".
+ * The line is truncated to the buffer and always terminated.
+ */
+CHIP_ERROR FormatLine(uint64_t timestampMicros, uint32_t processId, uint32_t threadId, const char * module, const char * format,
+                      ByteSpan arguments, MutableCharSpan & buffer);
+
+CHIP_ERROR EncodeFileHeader(Encoding::LittleEndian::BufferWriter & writer, uint32_t processId);
+CHIP_ERROR EncodeStringRecord(Encoding::LittleEndian::BufferWriter & writer, uint32_t id, CharSpan string);
+CHIP_ERROR EncodeMessageRecord(Encoding::LittleEndian::BufferWriter & writer, const MessageRecord & message);
+CHIP_ERROR EncodeDroppedRecord(Encoding::LittleEndian::BufferWriter & writer, uint32_t threadId, uint32_t dropped);
+
+/**
+ * Decode the header at the start of a binary log file, and advance 'data' past it.
+ *
+ * @retval CHIP_ERROR_INVALID_FILE_IDENTIFIER  Not a binary log file.
+ * @retval CHIP_ERROR_VERSION_MISMATCH         A binary log file of an unknown version.
+ */
+CHIP_ERROR DecodeFileHeader(ByteSpan & data, uint32_t & processId);
+
+/**
+ * Decode the record at the start of 'data', and advance 'data' past it.  The spans of the record
+ * point into 'data'.
+ *
+ * @retval CHIP_ERROR_BUFFER_TOO_SMALL  The record is incomplete, as at the end of a log file still being written.
+ * @retval CHIP_ERROR_DECODE_FAILED     The record is malformed.  Records of unknown types are not errors,
+ *                                      they are returned with their type only.
+ */
+CHIP_ERROR DecodeRecord(ByteSpan & data, Record & record);
+
+} // namespace BinaryLog
+} // namespace Logging
+} // namespace chip
@@ -0,0 +1,247 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Measures the throughput of the conversions between TLV and JSON over a list of
+ *      event-like structures: through a Json::Value tree, as TlvToJson() and chip-tool's
+ *      CustomArgumentParser do, and streaming, with the converters of TlvJsonStream.h.
+ *
+ *      Usage: tlv-json-benchmark [iterations]
+ */
+
+#include <lib/core/CHIPError.h>
+#include <lib/core/TLV.h>
+#include <lib/support/Base64.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/jsontlv/TlvJson.h>
+#include <lib/support/jsontlv/TlvJsonStream.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace chip;
+using namespace chip::TLV;
+
+constexpr size_t kDefaultIterations = 1000;
+constexpr size_t kEvents            = 64;
+constexpr size_t kBufferSize        = 32768;
+
+// Writes a list of kEvents structures:
+// [ { 0: number, 1: delta, 2: flag, 3: bytes, 4: label, 5: reading, 6: [ 4 values ], 7: null }, ... ]
+CHIP_ERROR WriteEvents(TLVWriter & writer, size_t & elements)
+{
+    const uint8_t bytes[16] = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff };
+    TLVType events, event, values;
+
+    elements = 1;
+    ReturnErrorOnFailure(writer.StartContainer(AnonymousTag(), kTLVType_Array, events));
+    for (size_t i = 0; i < kEvents; i++)
+    {
+        ReturnErrorOnFailure(writer.StartContainer(AnonymousTag(), kTLVType_Structure, event));
+        ReturnErrorOnFailure(writer.Put(ContextTag(0), static_cast<uint64_t>(0x100000000 + i)));
+        ReturnErrorOnFailure(writer.Put(ContextTag(1), -static_cast<int64_t>(i * 1000)));
+        ReturnErrorOnFailure(writer.PutBoolean(ContextTag(2), (i & 1) != 0));
+        ReturnErrorOnFailure(writer.PutBytes(ContextTag(3), bytes, sizeof(bytes)));
+        ReturnErrorOnFailure(writer.PutString(ContextTag(4), "Front door \"main\" lock"));
+        ReturnErrorOnFailure(writer.Put(ContextTag(5), 21.5 + static_cast<double>(i) / 8));
+        ReturnErrorOnFailure(writer.StartContainer(ContextTag(6), kTLVType_Array, values));
+        for (uint16_t value = 0; value < 4; value++)
+        {
+            ReturnErrorOnFailure(writer.Put(AnonymousTag(), static_cast<uint16_t>(i * 4 + value)));
+        }
+        ReturnErrorOnFailure(writer.EndContainer(values));
+        ReturnErrorOnFailure(writer.PutNull(ContextTag(7)));
+        ReturnErrorOnFailure(writer.EndContainer(event));
+        elements += 13;
+    }
+    ReturnErrorOnFailure(writer.EndContainer(events));
+    return writer.Finalize();
+}
+
+// Encodes a Json::Value tree as chip-tool's CustomArgumentParser does, with the byte strings of TlvToJson().
+CHIP_ERROR PutTree(TLVWriter & writer, Tag tag, const Json::Value & value)
+{
+    static constexpr char kBase64Header[]    = "base64:";
+    static constexpr size_t kBase64HeaderLen = sizeof(kBase64Header) - 1;
+    TLVType outer;
+
+    if (value.isObject())
+    {
+        ReturnErrorOnFailure(writer.StartContainer(tag, kTLVType_Structure, outer));
+        for (auto const & id : value.getMemberNames())
+        {
+            ReturnErrorOnFailure(PutTree(writer, ContextTag(static_cast<uint8_t>(std::stoul(id))), value[id]));
+        }
+        return writer.EndContainer(outer);
+    }
+    if (value.isArray())
+    {
+        ReturnErrorOnFailure(writer.StartContainer(tag, kTLVType_Array, outer));
+        for (Json::ArrayIndex i = 0; i < value.size(); i++)
+        {
+            ReturnErrorOnFailure(PutTree(writer, AnonymousTag(), value[i]));
+        }
+        return writer.EndContainer(outer);
+    }
+    if (value.isString())
+    {
+        const std::string str = value.asString();
+        if (str.compare(0, kBase64HeaderLen, kBase64Header) == 0)
+        {
+            std::vector<uint8_t> bytes(BASE64_MAX_DECODED_LEN(str.size()));
+            const uint32_t len =
+                Base64Decode32(str.data() + kBase64HeaderLen, static_cast<uint32_t>(str.size() - kBase64HeaderLen), bytes.data());
+            VerifyOrReturnError(len != UINT32_MAX, CHIP_ERROR_INVALID_ARGUMENT);
+            return writer.PutBytes(tag, bytes.data(), len);
+        }
+        return writer.PutString(tag, CharSpan(str.data(), str.size()));
+    }
+    if (value.isNull())
+    {
+        return writer.PutNull(tag);
+    }
+    if (value.isBool())
+    {
+        return writer.PutBoolean(tag, value.asBool());
+    }
+    if (value.isUInt64())
+    {
+        return writer.Put(tag, static_cast<uint64_t>(value.asUInt64()));
+    }
+    if (value.isInt64())
+    {
+        return writer.Put(tag, static_cast<int64_t>(value.asInt64()));
+    }
+    return writer.Put(tag, value.asDouble());
+}
+
+template <typename Function>
+void Report(const char * name, size_t iterations, size_t elements, size_t length, Function function)
+{
+    uint64_t sum     = 0;
+    CHIP_ERROR err   = CHIP_NO_ERROR;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations && err == CHIP_NO_ERROR; i++)
+    {
+        err = function(sum);
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    if (err != CHIP_NO_ERROR)
+    {
+        printf("%-30s failed: %" CHIP_ERROR_FORMAT "\n", name, err.Format());
+        return;
+    }
+    const double total = static_cast<double>(iterations);
+    printf("%-30s %8.1f ns per element %8.1f MB/s of JSON (check %llu)\n", name, elapsed.count() * 1e9 / (total * elements),
+           total * length / elapsed.count() / 1e6, static_cast<unsigned long long>(sum));
+}
+
+} // namespace
+
+int main(int argc, char * argv[])
+{
+    const size_t iterations = (argc > 1) ? strtoul(argv[1], nullptr, 0) : kDefaultIterations;
+
+    if (iterations == 0)
+    {
+        fprintf(stderr, "Usage: %s [iterations]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (Platform::MemoryInit() != CHIP_NO_ERROR)
+    {
+        fprintf(stderr, "Failed to initialize the memory\n");
+        return EXIT_FAILURE;
+    }
+
+    std::vector<uint8_t> tlv(kBufferSize);
+    size_t elements = 0;
+    TLVWriter writer;
+    writer.Init(tlv.data(), tlv.size());
+    if (WriteEvents(writer, elements) != CHIP_NO_ERROR)
+    {
+        fprintf(stderr, "Failed to encode the events\n");
+        return EXIT_FAILURE;
+    }
+    const uint32_t tlvLength = writer.GetLengthWritten();
+
+    std::vector<uint8_t> json(kBufferSize);
+    Encoding::BufferWriter jsonWriter(json.data(), json.size());
+    TLVReader reader;
+    reader.Init(tlv.data(), tlvLength);
+    if (reader.Next() != CHIP_NO_ERROR || TlvToJson(reader, jsonWriter) != CHIP_NO_ERROR)
+    {
+        fprintf(stderr, "Failed to convert the events\n");
+        return EXIT_FAILURE;
+    }
+    const std::string jsonString(reinterpret_cast<const char *>(json.data()), jsonWriter.Needed());
+    printf("Events of %u bytes of TLV, %u bytes of JSON, %u elements\n", static_cast<unsigned>(tlvLength),
+           static_cast<unsigned>(jsonString.size()), static_cast<unsigned>(elements));
+
+    std::vector<uint8_t> output(kBufferSize);
+
+    Report("TLV to JSON, Json::Value tree", iterations, elements, jsonString.size(), [&](uint64_t & sum) {
+        TLVReader r;
+        Json::Value value;
+        r.Init(tlv.data(), tlvLength);
+        ReturnErrorOnFailure(r.Next());
+        ReturnErrorOnFailure(TlvToJson(r, value));
+        sum += JsonToString(value).size();
+        return CHIP_NO_ERROR;
+    });
+
+    Report("TLV to JSON, streaming", iterations, elements, jsonString.size(), [&](uint64_t & sum) {
+        TLVReader r;
+        Encoding::BufferWriter w(output.data(), output.size());
+        r.Init(tlv.data(), tlvLength);
+        ReturnErrorOnFailure(r.Next());
+        ReturnErrorOnFailure(TlvToJson(r, w));
+        sum += w.Needed();
+        return CHIP_NO_ERROR;
+    });
+
+    Report("JSON to TLV, Json::Value tree", iterations, elements, jsonString.size(), [&](uint64_t & sum) {
+        Json::Reader jsonReader;
+        Json::Value value;
+        TLVWriter w;
+        VerifyOrReturnError(jsonReader.parse(jsonString, value), CHIP_ERROR_INVALID_ARGUMENT);
+        w.Init(output.data(), output.size());
+        ReturnErrorOnFailure(PutTree(w, AnonymousTag(), value["value"]));
+        ReturnErrorOnFailure(w.Finalize());
+        sum += w.GetLengthWritten();
+        return CHIP_NO_ERROR;
+    });
+
+    Report("JSON to TLV, streaming", iterations, elements, jsonString.size(), [&](uint64_t & sum) {
+        TLVWriter w;
+        w.Init(output.data(), output.size());
+        ReturnErrorOnFailure(JsonToTlv(CharSpan(jsonString.data(), jsonString.size()), w));
+        ReturnErrorOnFailure(w.Finalize());
+        sum += w.GetLengthWritten();
+        return CHIP_NO_ERROR;
+    });
+
+    Platform::MemoryShutdown();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,293 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <lib/support/EnforceFormat.h>
+#include <lib/support/TypeTraits.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <lib/support/logging/BinaryLogFormat.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <nlunit-test.h>
+
+#include <cinttypes>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace chip;
+using namespace chip::Logging::BinaryLog;
+
+namespace {
+
+constexpr size_t kMessageSize = 512;
+
+// Checks that a message formatted from its encoded arguments is the same as formatted by vsnprintf.
+void ENFORCE_FORMAT(3, 4) CheckFormatted(nlTestSuite * inSuite, size_t messageSize, const char * format, ...)
+{
+    uint8_t argumentsBuffer[kMessageSize];
+    char expected[kMessageSize];
+    char message[kMessageSize];
+    va_list args;
+
+    va_start(args, format);
+    MutableByteSpan arguments(argumentsBuffer);
+    CHIP_ERROR err = EncodeArguments(format, args, arguments);
+    vsnprintf(expected, messageSize, format, args);
+    va_end(args);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    MutableCharSpan formatted(message, messageSize);
+    err = FormatMessage(format, arguments, formatted);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, formatted.size() == strlen(expected));
+    NL_TEST_ASSERT(inSuite, strcmp(message, expected) == 0);
+}
+
+CHIP_ERROR ENFORCE_FORMAT(2, 3) EncodeInto(MutableByteSpan & buffer, const char * format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    CHIP_ERROR err = EncodeArguments(format, args, buffer);
+    va_end(args);
+    return err;
+}
+
+void TestFormatIntegers(nlTestSuite * inSuite, void * inContext)
+{
+    CheckFormatted(inSuite, kMessageSize, "no arguments");
+    CheckFormatted(inSuite, kMessageSize, "%d %i %u %x %X %o", -42, 42, 4000000000u, 0xbeefu, 0xCAFEu, 0755u);
+    CheckFormatted(inSuite, kMessageSize, "%hhd %hhu %hd %hu", -3, 250, -30000, 60000);
+    CheckFormatted(inSuite, kMessageSize, "%ld %lu %lld %llu", -1234567890L, 1234567890UL, -1234567890123LL, 12345678901234ULL);
+    CheckFormatted(inSuite, kMessageSize, "%zu %zd %td %jd %ju", sizeof(uint64_t), static_cast<ssize_t>(-8),
+                   static_cast<ptrdiff_t>(-16), INTMAX_MIN, UINTMAX_MAX);
+    CheckFormatted(inSuite, kMessageSize, "%" PRIu8 " %" PRIx16 " %" PRId32 " %" PRIu64 " %08" PRIX32, static_cast<uint8_t>(200),
+                   static_cast<uint16_t>(0xabcd), INT32_MIN, UINT64_MAX, static_cast<uint32_t>(0x12ab));
+    CheckFormatted(inSuite, kMessageSize, ChipLogFormatX64 " " ChipLogFormatMEI, ChipLogValueX64(0x0123456789ABCDEFULL),
+                   ChipLogValueMEI(0xFFF1FC01u));
+    CheckFormatted(inSuite, kMessageSize, "[%-8d] [%+5d] [% d] [%#x] [%012lld]", 7, 7, 7, 255u, -99LL);
+    CheckFormatted(inSuite, kMessageSize, "%*d|%-*u|%.*d|%*.*x", 6, 1, 6, 2u, 4, 3, 8, 6, 0xfu);
+    CheckFormatted(inSuite, kMessageSize, "%c%c%c 100%%", 'a', 'b', 'c');
+}
+
+void TestFormatOtherTypes(nlTestSuite * inSuite, void * inContext)
+{
+    const char notTerminated[] = { 'a', 'b', 'c', 'd' };
+    const char * nullString    = nullptr;
+
+    CheckFormatted(inSuite, kMessageSize, "%s, %10s, %-10s!", "hello", "right", "left");
+    CheckFormatted(inSuite, kMessageSize, "%.3s %.*s", "truncated", static_cast<int>(sizeof(notTerminated)), notTerminated);
+    CheckFormatted(inSuite, kMessageSize, "%.*s|%.*s", 0, notTerminated, -1, "negative precision");
+    CheckFormatted(inSuite, kMessageSize, "%s", nullString);
+    CheckFormatted(inSuite, kMessageSize, "%f %.2f %e %g %a %10.3E", 3.14159, -2.5, 12345.678, 0.0001, 1.0, 6.02e23);
+    CheckFormatted(inSuite, kMessageSize, "%Lf", static_cast<long double>(1.5));
+    CheckFormatted(inSuite, kMessageSize, "%p %p", static_cast<void *>(&inSuite), static_cast<void *>(nullptr));
+}
+
+void TestFormatTruncated(nlTestSuite * inSuite, void * inContext)
+{
+    CheckFormatted(inSuite, 1, "%s", "nothing fits");
+    CheckFormatted(inSuite, 8, "%s and %d", "longer than the buffer", 12345);
+    CheckFormatted(inSuite, 10, "0123456789%d", 1);
+    CheckFormatted(inSuite, 5, "%08x", 0x1234u);
+
+    // Strings longer than the longest string argument are truncated.
+    char longString[kMaxStringArgumentLength + 10];
+    memset(longString, 'x', sizeof(longString) - 1);
+    longString[sizeof(longString) - 1] = '\0';
+
+    uint8_t argumentsBuffer[kMessageSize];
+    char message[kMessageSize];
+    MutableByteSpan arguments(argumentsBuffer);
+    NL_TEST_ASSERT(inSuite, EncodeInto(arguments, "%s", longString) == CHIP_NO_ERROR);
+
+    MutableCharSpan formatted(message);
+    NL_TEST_ASSERT(inSuite, FormatMessage("%s", arguments, formatted) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, formatted.size() == kMaxStringArgumentLength);
+    NL_TEST_ASSERT(inSuite, strncmp(message, longString, kMaxStringArgumentLength) == 0);
+}
+
+void TestEncodeErrors(nlTestSuite * inSuite, void * inContext)
+{
+    uint8_t argumentsBuffer[kMessageSize];
+
+    {
+        MutableByteSpan arguments(argumentsBuffer);
+        NL_TEST_ASSERT(inSuite, EncodeInto(arguments, "%ls", L"wide") == CHIP_ERROR_NOT_IMPLEMENTED);
+    }
+
+    {
+        MutableByteSpan arguments(argumentsBuffer, 12);
+        NL_TEST_ASSERT(inSuite, EncodeInto(arguments, "%d %d", 1, 2) == CHIP_ERROR_BUFFER_TOO_SMALL);
+    }
+
+    {
+        // Strings are truncated to what fits.
+        MutableByteSpan arguments(argumentsBuffer, 6);
+        char message[kMessageSize];
+        MutableCharSpan formatted(message);
+        NL_TEST_ASSERT(inSuite, EncodeInto(arguments, "%s", "truncated") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, FormatMessage("%s", arguments, formatted) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, formatted.data_equal(CharSpan::fromCharString("trun")));
+    }
+}
+
+void TestFormatErrors(nlTestSuite * inSuite, void * inContext)
+{
+    uint8_t argumentsBuffer[kMessageSize];
+    char message[kMessageSize];
+    MutableByteSpan arguments(argumentsBuffer);
+    NL_TEST_ASSERT(inSuite, EncodeInto(arguments, "%d %s", 1, "one") == CHIP_NO_ERROR);
+
+    // Missing arguments
+    MutableCharSpan formatted(message);
+    NL_TEST_ASSERT(inSuite, FormatMessage("%d %s %d", arguments, formatted) == CHIP_ERROR_INVALID_ARGUMENT);
+
+    // Extra arguments
+    formatted = MutableCharSpan(message);
+    NL_TEST_ASSERT(inSuite, FormatMessage("%d", arguments, formatted) == CHIP_ERROR_INVALID_ARGUMENT);
+
+    // Truncated arguments
+    formatted = MutableCharSpan(message);
+    NL_TEST_ASSERT(inSuite, FormatMessage("%d %s", arguments.SubSpan(0, arguments.size() - 1), formatted) ==
+                       CHIP_ERROR_INVALID_ARGUMENT);
+}
+
+void TestFormatLine(nlTestSuite * inSuite, void * inContext)
+{
+    uint8_t argumentsBuffer[kMessageSize];
+    char line[kMessageSize];
+    MutableByteSpan arguments(argumentsBuffer);
+    NL_TEST_ASSERT(inSuite, EncodeInto(arguments, "value %d", 12) == CHIP_NO_ERROR);
+
+    MutableCharSpan formatted(line);
+    NL_TEST_ASSERT(inSuite, FormatLine(1660000000000042ULL, 1234, 5678, "DMG", "value %d", arguments, formatted) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, formatted.data_equal(CharSpan::fromCharString("[1660000000.000042][1234:5678] CHIP:DMG: value 12")));
+
+    formatted = MutableCharSpan(line, 12);
+    NL_TEST_ASSERT(inSuite, FormatLine(1660000000000042ULL, 1234, 5678, "DMG", "value %d", arguments, formatted) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, formatted.data_equal(CharSpan::fromCharString("[1660000000")));
+}
+
+void TestFileRecords(nlTestSuite * inSuite, void * inContext)
+{
+    const uint8_t argumentsData[] = { 1, 2, 3 };
+    const uint8_t unknownRecord[] = { 0x7f, 2, 0, 0xaa, 0xbb };
+    uint8_t fileBuffer[128];
+
+    Encoding::LittleEndian::BufferWriter writer(fileBuffer, sizeof(fileBuffer));
+    MessageRecord message;
+    message.timestampMicros = 0x0102030405060708ULL;
+    message.threadId        = 42;
+    message.moduleId        = 1;
+    message.formatId        = 2;
+    message.category        = 3;
+    message.arguments       = ByteSpan(argumentsData);
+
+    NL_TEST_ASSERT(inSuite, EncodeFileHeader(writer, 1234) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, EncodeStringRecord(writer, 1, CharSpan::fromCharString("DMG")) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, EncodeMessageRecord(writer, message) == CHIP_NO_ERROR);
+    writer.Put(unknownRecord, sizeof(unknownRecord));
+    NL_TEST_ASSERT(inSuite, EncodeDroppedRecord(writer, 42, 7) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, writer.Fit());
+
+    ByteSpan data(fileBuffer, writer.Needed());
+    uint32_t processId = 0;
+    Record record;
+    NL_TEST_ASSERT(inSuite, DecodeFileHeader(data, processId) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, processId == 1234);
+
+    NL_TEST_ASSERT(inSuite, DecodeRecord(data, record) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, record.type == RecordType::kString);
+    NL_TEST_ASSERT(inSuite, record.id == 1);
+    NL_TEST_ASSERT(inSuite, record.string.data_equal(CharSpan::fromCharString("DMG")));
+
+    NL_TEST_ASSERT(inSuite, DecodeRecord(data, record) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, record.type == RecordType::kMessage);
+    NL_TEST_ASSERT(inSuite, record.message.timestampMicros == message.timestampMicros);
+    NL_TEST_ASSERT(inSuite, record.message.threadId == 42);
+    NL_TEST_ASSERT(inSuite, record.message.moduleId == 1);
+    NL_TEST_ASSERT(inSuite, record.message.formatId == 2);
+    NL_TEST_ASSERT(inSuite, record.message.category == 3);
+    NL_TEST_ASSERT(inSuite, record.message.arguments.data_equal(ByteSpan(argumentsData)));
+
+    NL_TEST_ASSERT(inSuite, DecodeRecord(data, record) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, to_underlying(record.type) == 0x7f);
+
+    // A record being written is incomplete.
+    ByteSpan incomplete = data.SubSpan(0, data.size() - 1);
+    NL_TEST_ASSERT(inSuite, DecodeRecord(incomplete, record) == CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    NL_TEST_ASSERT(inSuite, DecodeRecord(data, record) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, record.type == RecordType::kDropped);
+    NL_TEST_ASSERT(inSuite, record.id == 42);
+    NL_TEST_ASSERT(inSuite, record.dropped == 7);
+    NL_TEST_ASSERT(inSuite, data.empty());
+
+    // Not a binary log file
+    ByteSpan notALog(reinterpret_cast<const uint8_t *>("[1660000000.000042] CHIP"), 24);
+    NL_TEST_ASSERT(inSuite, DecodeFileHeader(notALog, processId) == CHIP_ERROR_INVALID_FILE_IDENTIFIER);
+}
+
+void TestLargeFile(nlTestSuite * inSuite, void * inContext)
+{
+    // Log files are decoded whole, and are usually larger than 64 KiB.
+    constexpr size_t kRecords = 20000;
+    std::vector<uint8_t> file(kFileHeaderSize + kRecords * (kRecordHeaderSize + 8));
+
+    Encoding::LittleEndian::BufferWriter writer(file.data(), file.size());
+    NL_TEST_ASSERT(inSuite, EncodeFileHeader(writer, 1234) == CHIP_NO_ERROR);
+    for (uint32_t i = 0; i < kRecords; i++)
+    {
+        NL_TEST_ASSERT(inSuite, EncodeDroppedRecord(writer, i, 1) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, writer.Fit() && writer.Needed() == file.size());
+
+    ByteSpan data(file.data(), file.size());
+    uint32_t processId = 0;
+    Record record;
+    NL_TEST_ASSERT(inSuite, DecodeFileHeader(data, processId) == CHIP_NO_ERROR);
+    for (uint32_t i = 0; i < kRecords; i++)
+    {
+        NL_TEST_ASSERT(inSuite, DecodeRecord(data, record) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, record.type == RecordType::kDropped && record.id == i);
+    }
+    NL_TEST_ASSERT(inSuite, data.empty());
+}
+
+const nlTest sTests[] = {
+    NL_TEST_DEF("TestFormatIntegers", TestFormatIntegers),     //
+    NL_TEST_DEF("TestFormatOtherTypes", TestFormatOtherTypes), //
+    NL_TEST_DEF("TestFormatTruncated", TestFormatTruncated),   //
+    NL_TEST_DEF("TestEncodeErrors", TestEncodeErrors),         //
+    NL_TEST_DEF("TestFormatErrors", TestFormatErrors),         //
+    NL_TEST_DEF("TestFormatLine", TestFormatLine),             //
+    NL_TEST_DEF("TestFileRecords", TestFileRecords),           //
+    NL_TEST_DEF("TestLargeFile", TestLargeFile),               //
+    NL_TEST_SENTINEL()                                         //
+};
+
+} // namespace
+
+int TestBinaryLogFormat()
+{
+    nlTestSuite theSuite = { "BinaryLogFormat", sTests, nullptr, nullptr };
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestBinaryLogFormat)
@@ -20,6 +20,7 @@
 #include <app/data-model/Encode.h>
 #include <lib/support/UnitTestRegistration.h>
 #include <lib/support/jsontlv/TlvJson.h>
+#include <lib/support/jsontlv/TlvJsonStream.h>
 #include <nlunit-test.h>
 #include <system/SystemPacketBuffer.h>
 #include <system/TLVPacketBufferBackingStore.h>
@@ -80,6 +81,66 @@ bool Matches(const char * referenceString, Json::Value & generatedValue)
     return matches;
 }
 
+CHIP_ERROR StreamToJson(const uint8_t * tlv, uint32_t tlvLen, std::string & json)
+{
+    char buf[1024];
+    Encoding::BufferWriter output(reinterpret_cast<uint8_t *>(buf), sizeof(buf));
+    TLV::TLVReader reader;
+
+    reader.Init(tlv, tlvLen);
+    ReturnErrorOnFailure(reader.Next());
+    ReturnErrorOnFailure(TlvToJson(reader, output));
+    json.assign(buf, output.Needed());
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR StreamToTlv(const char * json, uint8_t * tlv, uint32_t tlvSize, uint32_t & tlvLen)
+{
+    TLV::TLVWriter writer;
+
+    writer.Init(tlv, tlvSize);
+    ReturnErrorOnFailure(JsonToTlv(CharSpan::fromCharString(json), writer));
+    ReturnErrorOnFailure(writer.Finalize());
+    tlvLen = writer.GetLengthWritten();
+    return CHIP_NO_ERROR;
+}
+
+//
+// Checks that the streaming converter writes the same JSON as the tree converter, and that the
+// JSON is encoded back into TLV which converts to the same JSON.
+//
+void ValidateStreaming(Json::Value & treeValue)
+{
+    CHIP_ERROR err;
+    uint8_t tlv[1024];
+    uint32_t tlvLen;
+    std::string json;
+    std::string roundTripJson;
+
+    err = SetupReader();
+    NL_TEST_ASSERT(gSuite, err == CHIP_NO_ERROR);
+
+    char buf[1024];
+    Encoding::BufferWriter output(reinterpret_cast<uint8_t *>(buf), sizeof(buf));
+    err = TlvToJson(gReader, output);
+    NL_TEST_ASSERT(gSuite, err == CHIP_NO_ERROR);
+    json.assign(buf, output.Needed());
+
+    // Compare the parsed JSON, as struct fields are not written in the same order.
+    Json::Reader reader;
+    Json::Value streamedValue;
+    Json::Value referenceValue;
+    NL_TEST_ASSERT(gSuite, reader.parse(json, streamedValue));
+    NL_TEST_ASSERT(gSuite, reader.parse(JsonToString(treeValue), referenceValue));
+    NL_TEST_ASSERT(gSuite, streamedValue == referenceValue);
+
+    err = StreamToTlv(json.c_str(), tlv, sizeof(tlv), tlvLen);
+    NL_TEST_ASSERT(gSuite, err == CHIP_NO_ERROR);
+    err = StreamToJson(tlv, tlvLen, roundTripJson);
+    NL_TEST_ASSERT(gSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(gSuite, roundTripJson == json);
+}
+
 template <typename T>
 void EncodeAndValidate(T val, const char * expectedJsonString)
 {
@@ -102,6 +163,44 @@ void EncodeAndValidate(T val, const char * expectedJsonString)
 
     bool matches = Matches(expectedJsonString, d);
     NL_TEST_ASSERT(gSuite, matches);
+
+    ValidateStreaming(d);
+}
+
+// Encodes the JSON into TLV and checks that it converts back to the expected JSON.
+void JsonToTlvAndValidate(const char * json, const char * expectedJson)
+{
+    CHIP_ERROR err;
+    uint8_t tlv[1024];
+    uint32_t tlvLen;
+    std::string generatedJson;
+
+    err = StreamToTlv(json, tlv, sizeof(tlv), tlvLen);
+    NL_TEST_ASSERT(gSuite, err == CHIP_NO_ERROR);
+    err = StreamToJson(tlv, tlvLen, generatedJson);
+    NL_TEST_ASSERT(gSuite, err == CHIP_NO_ERROR);
+
+    auto matches = (generatedJson == expectedJson);
+
+    if (!matches)
+    {
+        printf("Didn't match!\n");
+        printf("Reference:\n");
+        printf("%s\n", expectedJson);
+
+        printf("Generated:\n");
+        printf("%s\n", generatedJson.c_str());
+    }
+
+    NL_TEST_ASSERT(gSuite, matches);
+}
+
+void JsonToTlvAndFail(const char * json)
+{
+    uint8_t tlv[1024];
+    uint32_t tlvLen;
+
+    NL_TEST_ASSERT(gSuite, StreamToTlv(json, tlv, sizeof(tlv), tlvLen) != CHIP_NO_ERROR);
 }
 
 void TestConverter(nlTestSuite * inSuite, void * inContext)
@@ -134,7 +233,7 @@ void TestConverter(nlTestSuite * inSuite, void * inContext)
                       "}\n");
 
     const char charBuf[] = "hello";
-    CharSpan charSpan(charBuf);
+    CharSpan charSpan = CharSpan::fromCharString(charBuf);
     EncodeAndValidate(charSpan,
                       "{\n"
                       "   \"value\" : \"hello\"\n"
@@ -232,6 +331,57 @@ void TestConverter(nlTestSuite * inSuite, void * inContext)
                       "}\n");
 }
 
+void TestStreamingConverter(nlTestSuite * inSuite, void * inContext)
+{
+    gSuite = inSuite;
+
+    // Integers out of range are doubles, and whitespace is allowed between tokens.
+    JsonToTlvAndValidate(" { \"value\" : [ 0, 18446744073709551615, -1, -9223372036854775808, 1.5, -2e3, 18446744073709551616 ] } ",
+                         "{\"value\":[0,18446744073709551615,-1,-9223372036854775808,1.5,-2000.0,1.8446744073709552e+19]}");
+
+    JsonToTlvAndValidate(R"({"value":{"0":true,"1":false,"2":null,"3":{},"4":[],"5":"","6":"base64:"}})",
+                         R"({"value":{"0":true,"1":false,"2":null,"3":{},"4":[],"5":"","6":"base64:"}})");
+
+    // Only the characters that need it are escaped back.
+    JsonToTlvAndValidate(R"({"value":"\"\\\/\b\f\n\r\t\u0001\u00e9\ud83d\ude00"})",
+                         "{\"value\":\"\\\"\\\\/\\b\\f\\n\\r\\t\\u0001\xc3\xa9\xf0\x9f\x98\x80\"}");
+
+    JsonToTlvAndValidate(R"({"value":["base64:AQIDBP/+mYjdzQ==","base64:AQIDBP\/+mYjdzQ=="]})",
+                         R"({"value":["base64:AQIDBP/+mYjdzQ==","base64:AQIDBP/+mYjdzQ=="]})");
+
+    JsonToTlvAndFail("");
+    JsonToTlvAndFail("{}");
+    JsonToTlvAndFail(R"({"other":1})");
+    JsonToTlvAndFail(R"({"value":1)");
+    JsonToTlvAndFail(R"({"value":1}})");
+    JsonToTlvAndFail(R"({"value":{"a":1}})");
+    JsonToTlvAndFail(R"({"value":{"256":1}})");
+    JsonToTlvAndFail(R"({"value":{"0":1,}})");
+    JsonToTlvAndFail(R"({"value":[1 2]})");
+    JsonToTlvAndFail(R"({"value":"unterminated})");
+    JsonToTlvAndFail(R"({"value":"\x"})");
+    JsonToTlvAndFail(R"({"value":"\ud83d"})");
+    JsonToTlvAndFail(R"({"value":"base64:A"})");
+    JsonToTlvAndFail(R"({"value":-})");
+    JsonToTlvAndFail(R"({"value":1..5})");
+    JsonToTlvAndFail(R"({"value":nul})");
+    JsonToTlvAndFail(R"({"value":[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[1]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]})");
+
+    // JSON which does not fit tells the room it needs.
+    const char json[] = R"({"value":[1,2,3]})";
+    uint8_t tlv[64];
+    uint32_t tlvLen;
+    NL_TEST_ASSERT(inSuite, StreamToTlv(json, tlv, sizeof(tlv), tlvLen) == CHIP_NO_ERROR);
+
+    char buf[8];
+    Encoding::BufferWriter output(reinterpret_cast<uint8_t *>(buf), sizeof(buf));
+    TLV::TLVReader reader;
+    reader.Init(tlv, tlvLen);
+    NL_TEST_ASSERT(inSuite, reader.Next() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, TlvToJson(reader, output) == CHIP_ERROR_BUFFER_TOO_SMALL);
+    NL_TEST_ASSERT(inSuite, output.Needed() == strlen(json));
+}
+
 int Initialize(void * apSuite)
 {
     VerifyOrReturnError(chip::Platform::MemoryInit() == CHIP_NO_ERROR, FAILURE);
@@ -245,7 +395,8 @@ int Finalize(void * aContext)
     return SUCCESS;
 }
 
-const nlTest sTests[] = { NL_TEST_DEF("TestConverter", TestConverter), NL_TEST_SENTINEL() };
+const nlTest sTests[] = { NL_TEST_DEF("TestConverter", TestConverter),
+                          NL_TEST_DEF("TestStreamingConverter", TestStreamingConverter), NL_TEST_SENTINEL() };
 
 } // namespace
 
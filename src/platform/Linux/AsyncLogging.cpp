@@ -0,0 +1,522 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <platform/Linux/AsyncLogging.h>
+
+#include <lib/core/CHIPConfig.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/EnforceFormat.h>
+#include <lib/support/logging/BinaryLogFormat.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <lib/support/logging/Constants.h>
+#include <platform/logging/LogV.h>
+#include <system/SystemError.h>
+
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#include <unordered_map>
+
+namespace chip {
+
+namespace DeviceLayer {
+void OnLogOutput();
+} // namespace DeviceLayer
+
+namespace Logging {
+namespace Platform {
+
+namespace {
+
+// Size of the ring buffer of each logging thread, a power of two.
+constexpr size_t kRingSize = 64 * 1024;
+
+// Fill level of a ring buffer above which detail and automation messages are dropped.
+constexpr size_t kLowPriorityRingLimit = kRingSize / 4 * 3;
+
+// Largest encoded arguments of a message.
+constexpr size_t kMaxArgumentsSize = 2 * CHIP_CONFIG_LOG_MESSAGE_MAX_SIZE;
+
+// Longest line written in text mode, including the prefix.
+constexpr size_t kMaxLineSize = CHIP_CONFIG_LOG_MESSAGE_MAX_SIZE + 64;
+
+// Largest binary log record.
+constexpr size_t kMaxRecordSize = BinaryLog::kRecordHeaderSize + 32 + kMaxArgumentsSize;
+
+// How long the writer thread waits before looking for new messages.
+constexpr std::chrono::milliseconds kWriterPollInterval(10);
+
+constexpr char kDroppedFormat[] = "%" PRIu32 " log messages dropped";
+
+struct RecordHeader
+{
+    uint64_t timestampMicros;
+    const char * module;
+    const char * format;
+    uint32_t threadId;
+    uint16_t argumentsLength;
+    uint8_t category;
+};
+
+/**
+ * Ring buffer of the messages logged by a thread, written by that thread only and read by the
+ * writer thread only.  Rings are kept once allocated, and reused by the threads started after
+ * their thread exited.
+ */
+class ThreadRing
+{
+public:
+    bool Init()
+    {
+        mBuffer.reset(new (std::nothrow) uint8_t[kRingSize]);
+        return mBuffer != nullptr;
+    }
+
+    bool Write(const RecordHeader & header, ByteSpan arguments, size_t limit)
+    {
+        const size_t write  = mWritePosition.load(std::memory_order_relaxed);
+        const size_t read   = mReadPosition.load(std::memory_order_acquire);
+        const size_t length = sizeof(header) + arguments.size();
+        if (write - read + length > limit)
+        {
+            return false;
+        }
+
+        CopyIn(write, &header, sizeof(header));
+        CopyIn(write + sizeof(header), arguments.data(), arguments.size());
+        mWritePosition.store(write + length, std::memory_order_release);
+        return true;
+    }
+
+    bool Read(RecordHeader & header, MutableByteSpan & arguments)
+    {
+        const size_t read  = mReadPosition.load(std::memory_order_relaxed);
+        const size_t write = mWritePosition.load(std::memory_order_acquire);
+        if (read == write)
+        {
+            return false;
+        }
+
+        CopyOut(read, &header, sizeof(header));
+        VerifyOrDie(header.argumentsLength <= arguments.size());
+        CopyOut(read + sizeof(header), arguments.data(), header.argumentsLength);
+        arguments.reduce_size(header.argumentsLength);
+        mReadPosition.store(read + sizeof(header) + header.argumentsLength, std::memory_order_release);
+        return true;
+    }
+
+    // Claimed by a running thread.
+    std::atomic<bool> mInUse{ false };
+    // Thread the messages dropped are reported for.
+    std::atomic<uint32_t> mThreadId{ 0 };
+    std::atomic<uint32_t> mDropped{ 0 };
+    ThreadRing * mNext = nullptr;
+
+private:
+    void CopyIn(size_t position, const void * data, size_t length)
+    {
+        const size_t offset = position & (kRingSize - 1);
+        const size_t first  = chip::min(length, kRingSize - offset);
+        memcpy(&mBuffer[offset], data, first);
+        memcpy(&mBuffer[0], static_cast<const uint8_t *>(data) + first, length - first);
+    }
+
+    void CopyOut(size_t position, void * data, size_t length) const
+    {
+        const size_t offset = position & (kRingSize - 1);
+        const size_t first  = chip::min(length, kRingSize - offset);
+        memcpy(data, &mBuffer[offset], first);
+        memcpy(static_cast<uint8_t *>(data) + first, &mBuffer[0], length - first);
+    }
+
+    std::unique_ptr<uint8_t[]> mBuffer;
+    // Free-running positions, the ring buffer holds the bytes between them.
+    std::atomic<size_t> mWritePosition{ 0 };
+    std::atomic<size_t> mReadPosition{ 0 };
+};
+
+static_assert((kRingSize & (kRingSize - 1)) == 0, "The ring size must be a power of two");
+
+// All the rings ever allocated; rings are only ever added at the head.
+std::atomic<ThreadRing *> sRings{ nullptr };
+std::atomic<uint64_t> sDroppedCount{ 0 };
+
+// Releases the ring of a thread when the thread exits.
+struct ThreadRingOwner
+{
+    ~ThreadRingOwner()
+    {
+        if (mRing != nullptr)
+        {
+            mRing->mInUse.store(false, std::memory_order_release);
+        }
+    }
+
+    ThreadRing * mRing = nullptr;
+};
+
+thread_local ThreadRingOwner tRingOwner;
+
+uint32_t GetThreadId()
+{
+    return static_cast<uint32_t>(syscall(SYS_gettid));
+}
+
+ThreadRing * AcquireRing()
+{
+    for (ThreadRing * ring = sRings.load(std::memory_order_acquire); ring != nullptr; ring = ring->mNext)
+    {
+        bool inUse = false;
+        if (ring->mInUse.compare_exchange_strong(inUse, true, std::memory_order_acquire))
+        {
+            ring->mThreadId.store(GetThreadId(), std::memory_order_relaxed);
+            return ring;
+        }
+    }
+
+    std::unique_ptr<ThreadRing> ring(new (std::nothrow) ThreadRing());
+    VerifyOrReturnValue(ring != nullptr && ring->Init(), nullptr);
+    ring->mInUse.store(true, std::memory_order_relaxed);
+    ring->mThreadId.store(GetThreadId(), std::memory_order_relaxed);
+
+    ring->mNext = sRings.load(std::memory_order_relaxed);
+    while (!sRings.compare_exchange_weak(ring->mNext, ring.get(), std::memory_order_release, std::memory_order_relaxed))
+    {
+    }
+    return ring.release();
+}
+
+uint64_t GetTimestampMicros()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000 + static_cast<uint64_t>(now.tv_nsec) / 1000;
+}
+
+CHIP_ERROR ENFORCE_FORMAT(2, 3) EncodeArguments(MutableByteSpan & arguments, const char * format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    CHIP_ERROR err = BinaryLog::EncodeArguments(format, args, arguments);
+    va_end(args);
+    return err;
+}
+
+class AsyncLogWriter
+{
+public:
+    CHIP_ERROR Start(const AsyncLoggingConfig & config);
+    void Flush();
+    void Stop();
+
+private:
+    static void * WriterThreadMain(void * context);
+    void WriteLogs();
+    bool WriteRings();
+    void WriteMessage(const RecordHeader & header, ByteSpan arguments);
+    void WriteDropped(uint32_t threadId, uint32_t dropped);
+    uint32_t GetStringId(const char * string);
+
+    AsyncLoggingConfig mConfig;
+    uint32_t mProcessId = 0;
+    pthread_t mWriterThread;
+    bool mRunning = false;
+
+    // Owned by the writer thread while running
+    std::unordered_map<const char *, uint32_t> mStringIds;
+
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    bool mStopWriter         = false;
+    uint64_t mFlushRequested = 0;
+    uint64_t mFlushCompleted = 0;
+};
+
+AsyncLogWriter sWriter;
+
+void ENFORCE_FORMAT(3, 0) LogToRing(const char * module, uint8_t category, const char * msg, va_list v)
+{
+    ThreadRingOwner & owner = tRingOwner;
+    if (owner.mRing == nullptr)
+    {
+        owner.mRing = AcquireRing();
+        if (owner.mRing == nullptr)
+        {
+            LogV(module, category, msg, v);
+            return;
+        }
+    }
+
+    RecordHeader header;
+    header.timestampMicros = GetTimestampMicros();
+    header.module          = module;
+    header.format          = msg;
+    header.threadId        = owner.mRing->mThreadId.load(std::memory_order_relaxed);
+    header.category        = category;
+
+    uint8_t argumentsBuffer[kMaxArgumentsSize];
+    MutableByteSpan arguments(argumentsBuffer);
+    if (BinaryLog::EncodeArguments(msg, v, arguments) != CHIP_NO_ERROR)
+    {
+        // Messages that cannot be recorded as is are formatted right away.
+        char formatted[CHIP_CONFIG_LOG_MESSAGE_MAX_SIZE];
+        vsnprintf(formatted, sizeof(formatted), msg, v);
+        header.format = "%s";
+        arguments     = MutableByteSpan(argumentsBuffer);
+        VerifyOrDie(EncodeArguments(arguments, "%s", formatted) == CHIP_NO_ERROR);
+    }
+    header.argumentsLength = static_cast<uint16_t>(arguments.size());
+
+    const bool lowPriority = (category == kLogCategory_Detail || category == kLogCategory_Automation);
+    if (!owner.mRing->Write(header, arguments, lowPriority ? kLowPriorityRingLimit : kRingSize))
+    {
+        owner.mRing->mDropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Let the application know that a log message has been emitted.
+    DeviceLayer::OnLogOutput();
+}
+
+CHIP_ERROR AsyncLogWriter::Start(const AsyncLoggingConfig & config)
+{
+    VerifyOrReturnError(!mRunning, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(config.output != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    mConfig         = config;
+    mProcessId      = static_cast<uint32_t>(getpid());
+    mStopWriter     = false;
+    mFlushRequested = 0;
+    mFlushCompleted = 0;
+    mStringIds.clear();
+
+    if (mConfig.binary)
+    {
+        uint8_t header[BinaryLog::kFileHeaderSize];
+        Encoding::LittleEndian::BufferWriter writer(header, sizeof(header));
+        ReturnErrorOnFailure(BinaryLog::EncodeFileHeader(writer, mProcessId));
+        VerifyOrReturnError(fwrite(header, 1, writer.Needed(), mConfig.output) == writer.Needed(), CHIP_ERROR_WRITE_FAILED);
+    }
+
+    int res = pthread_create(&mWriterThread, nullptr, WriterThreadMain, this);
+    VerifyOrReturnError(res == 0, CHIP_ERROR_POSIX(res));
+    mRunning = true;
+
+    SetLogRedirectCallback(LogToRing);
+    return CHIP_NO_ERROR;
+}
+
+void AsyncLogWriter::Flush()
+{
+    VerifyOrReturn(mRunning);
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    const uint64_t request = ++mFlushRequested;
+    mCondition.notify_all();
+    mCondition.wait(lock, [this, request] { return mFlushCompleted >= request; });
+}
+
+void AsyncLogWriter::Stop()
+{
+    VerifyOrReturn(mRunning);
+
+    SetLogRedirectCallback(nullptr);
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopWriter = true;
+    }
+    mCondition.notify_all();
+
+    pthread_join(mWriterThread, nullptr);
+    mRunning = false;
+}
+
+void * AsyncLogWriter::WriterThreadMain(void * context)
+{
+    static_cast<AsyncLogWriter *>(context)->WriteLogs();
+    return nullptr;
+}
+
+void AsyncLogWriter::WriteLogs()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    while (true)
+    {
+        const uint64_t flushRequested = mFlushRequested;
+        const bool stop               = mStopWriter;
+        lock.unlock();
+
+        while (WriteRings())
+        {
+        }
+        fflush(mConfig.output);
+
+        lock.lock();
+        if (mFlushCompleted != flushRequested)
+        {
+            mFlushCompleted = flushRequested;
+            mCondition.notify_all();
+        }
+        if (stop)
+        {
+            break;
+        }
+        mCondition.wait_for(lock, kWriterPollInterval,
+                            [this, flushRequested] { return mStopWriter || mFlushRequested != flushRequested; });
+    }
+}
+
+bool AsyncLogWriter::WriteRings()
+{
+    bool written = false;
+
+    for (ThreadRing * ring = sRings.load(std::memory_order_acquire); ring != nullptr; ring = ring->mNext)
+    {
+        uint8_t argumentsBuffer[kMaxArgumentsSize];
+        MutableByteSpan arguments(argumentsBuffer);
+        RecordHeader header;
+
+        while (ring->Read(header, arguments))
+        {
+            WriteMessage(header, arguments);
+            arguments = MutableByteSpan(argumentsBuffer);
+            written   = true;
+        }
+
+        // Reported once there is room in the ring again.
+        const uint32_t dropped = ring->mDropped.exchange(0, std::memory_order_relaxed);
+        if (dropped != 0)
+        {
+            sDroppedCount.fetch_add(dropped, std::memory_order_relaxed);
+            WriteDropped(ring->mThreadId.load(std::memory_order_relaxed), dropped);
+            written = true;
+        }
+    }
+
+    return written;
+}
+
+void AsyncLogWriter::WriteMessage(const RecordHeader & header, ByteSpan arguments)
+{
+    if (!mConfig.binary)
+    {
+        char line[kMaxLineSize];
+        MutableCharSpan formatted(line, sizeof(line) - 1);
+        if (BinaryLog::FormatLine(header.timestampMicros, mProcessId, header.threadId, header.module, header.format, arguments,
+                                  formatted) == CHIP_NO_ERROR)
+        {
+            line[formatted.size()] = '\n';
+            fwrite(line, 1, formatted.size() + 1, mConfig.output);
+        }
+        return;
+    }
+
+    uint8_t record[kMaxRecordSize];
+    Encoding::LittleEndian::BufferWriter writer(record, sizeof(record));
+    BinaryLog::MessageRecord message;
+    message.timestampMicros = header.timestampMicros;
+    message.threadId        = header.threadId;
+    message.moduleId        = GetStringId(header.module);
+    message.formatId        = GetStringId(header.format);
+    message.category        = header.category;
+    message.arguments       = arguments;
+    if (BinaryLog::EncodeMessageRecord(writer, message) == CHIP_NO_ERROR)
+    {
+        fwrite(record, 1, writer.Needed(), mConfig.output);
+    }
+}
+
+void AsyncLogWriter::WriteDropped(uint32_t threadId, uint32_t dropped)
+{
+    if (!mConfig.binary)
+    {
+        uint8_t argumentsBuffer[sizeof(uint64_t)];
+        MutableByteSpan arguments(argumentsBuffer);
+        RecordHeader header;
+        header.timestampMicros = GetTimestampMicros();
+        header.module          = "-";
+        header.format          = kDroppedFormat;
+        header.threadId        = threadId;
+        header.category        = kLogCategory_Error;
+        VerifyOrDie(EncodeArguments(arguments, kDroppedFormat, dropped) == CHIP_NO_ERROR);
+        WriteMessage(header, arguments);
+        return;
+    }
+
+    uint8_t record[BinaryLog::kRecordHeaderSize + 2 * sizeof(uint32_t)];
+    Encoding::LittleEndian::BufferWriter writer(record, sizeof(record));
+    if (BinaryLog::EncodeDroppedRecord(writer, threadId, dropped) == CHIP_NO_ERROR)
+    {
+        fwrite(record, 1, writer.Needed(), mConfig.output);
+    }
+}
+
+uint32_t AsyncLogWriter::GetStringId(const char * string)
+{
+    auto found = mStringIds.find(string);
+    if (found != mStringIds.end())
+    {
+        return found->second;
+    }
+
+    // Strings are defined in the file before their first use.
+    const uint32_t id   = static_cast<uint32_t>(mStringIds.size());
+    const size_t length = chip::min(strlen(string), kMaxRecordSize - BinaryLog::kRecordHeaderSize - sizeof(uint32_t));
+    uint8_t record[kMaxRecordSize];
+    Encoding::LittleEndian::BufferWriter writer(record, sizeof(record));
+    if (BinaryLog::EncodeStringRecord(writer, id, CharSpan(string, length)) == CHIP_NO_ERROR)
+    {
+        fwrite(record, 1, writer.Needed(), mConfig.output);
+    }
+    mStringIds.emplace(string, id);
+    return id;
+}
+
+} // namespace
+
+CHIP_ERROR StartAsyncLogging(const AsyncLoggingConfig & config)
+{
+    return sWriter.Start(config);
+}
+
+void FlushAsyncLogging()
+{
+    sWriter.Flush();
+}
+
+void StopAsyncLogging()
+{
+    sWriter.Stop();
+}
+
+uint64_t GetAsyncLoggingDroppedCount()
+{
+    return sDroppedCount.load(std::memory_order_relaxed);
+}
+
+} // namespace Platform
+} // namespace Logging
+} // namespace chip
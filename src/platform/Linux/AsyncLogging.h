@@ -0,0 +1,77 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Asynchronous logging backend for Linux.
+ *
+ *      Once started, log messages are no longer formatted and written by the thread logging them:
+ *      their format string and arguments are recorded into a lock-free ring buffer of the thread,
+ *      and a background thread formats and writes them, as text lines or in the binary log format
+ *      of lib/support/logging/BinaryLogFormat.h, to be decoded offline with chip-log-decoder.
+ *
+ *      Format strings are recorded by address, so they must stay valid for the process lifetime,
+ *      as the literals of the ChipLog macros do.  Messages of different threads may be written out
+ *      of order, their timestamps tell the order they were logged in.
+ *
+ *      When a ring buffer is full, messages are dropped and counted, and the number of messages
+ *      dropped is logged once there is room again.  Detail and automation messages are dropped
+ *      earlier, so that the last part of the ring buffer is left for errors and progress.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+
+#include <cstdint>
+#include <cstdio>
+
+namespace chip {
+namespace Logging {
+namespace Platform {
+
+struct AsyncLoggingConfig
+{
+    /// Where the log is written; not closed by the backend.
+    FILE * output = stdout;
+    /// Whether to write the binary log format instead of text lines.
+    bool binary = false;
+};
+
+/**
+ * Start logging asynchronously, redirecting the log messages with SetLogRedirectCallback.
+ */
+CHIP_ERROR StartAsyncLogging(const AsyncLoggingConfig & config = AsyncLoggingConfig());
+
+/**
+ * Wait until the messages logged so far have been written.
+ */
+void FlushAsyncLogging();
+
+/**
+ * Write the messages logged so far, and log synchronously again.
+ */
+void StopAsyncLogging();
+
+/**
+ * Total number of messages dropped because ring buffers were full.
+ */
+uint64_t GetAsyncLoggingDroppedCount();
+
+} // namespace Platform
+} // namespace Logging
+} // namespace chip
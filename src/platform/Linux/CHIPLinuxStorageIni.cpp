@@ -46,7 +46,7 @@ CHIP_ERROR ChipLinuxStorageIni::Init()
     return RemoveAll();
 }
 
-CHIP_ERROR ChipLinuxStorageIni::GetDefaultSection(std::map<std::string, std::string> & section)
+CHIP_ERROR ChipLinuxStorageIni::GetDefaultSection(std::map<std::string, std::string> *& section)
 {
     CHIP_ERROR retval = CHIP_NO_ERROR;
 
@@ -54,7 +54,8 @@ CHIP_ERROR ChipLinuxStorageIni::GetDefaultSection(std::map<std::string, std::str
 
     if (it != mConfigStore.sections.end())
     {
-        section = mConfigStore.sections["DEFAULT"];
+        // Not copied, lookups are done for every value read.
+        section = &it->second;
     }
     else
     {
@@ -127,19 +128,19 @@ CHIP_ERROR ChipLinuxStorageIni::CommitConfig(const std::string & configFile)
 
 CHIP_ERROR ChipLinuxStorageIni::GetUInt16Value(const char * key, uint16_t & val)
 {
-    CHIP_ERROR retval = CHIP_NO_ERROR;
-    std::map<std::string, std::string> section;
+    CHIP_ERROR retval                            = CHIP_NO_ERROR;
+    std::map<std::string, std::string> * section = nullptr;
 
     retval = GetDefaultSection(section);
 
     if (retval == CHIP_NO_ERROR)
     {
         std::string escapedKey = EscapeKey(key);
-        auto it                = section.find(escapedKey);
+        auto it                = section->find(escapedKey);
 
-        if (it != section.end())
+        if (it != section->end())
         {
-            if (!inipp::extract(section[escapedKey], val))
+            if (!inipp::extract(it->second, val))
             {
                 retval = CHIP_ERROR_INVALID_ARGUMENT;
             }
@@ -155,19 +156,19 @@ CHIP_ERROR ChipLinuxStorageIni::GetUInt16Value(const char * key, uint16_t & val)
 
 CHIP_ERROR ChipLinuxStorageIni::GetUIntValue(const char * key, uint32_t & val)
 {
-    CHIP_ERROR retval = CHIP_NO_ERROR;
-    std::map<std::string, std::string> section;
+    CHIP_ERROR retval                            = CHIP_NO_ERROR;
+    std::map<std::string, std::string> * section = nullptr;
 
     retval = GetDefaultSection(section);
 
     if (retval == CHIP_NO_ERROR)
     {
         std::string escapedKey = EscapeKey(key);
-        auto it                = section.find(escapedKey);
+        auto it                = section->find(escapedKey);
 
-        if (it != section.end())
+        if (it != section->end())
         {
-            if (!inipp::extract(section[escapedKey], val))
+            if (!inipp::extract(it->second, val))
             {
                 retval = CHIP_ERROR_INVALID_ARGUMENT;
             }
@@ -183,19 +184,19 @@ CHIP_ERROR ChipLinuxStorageIni::GetUIntValue(const char * key, uint32_t & val)
 
 CHIP_ERROR ChipLinuxStorageIni::GetUInt64Value(const char * key, uint64_t & val)
 {
-    CHIP_ERROR retval = CHIP_NO_ERROR;
-    std::map<std::string, std::string> section;
+    CHIP_ERROR retval                            = CHIP_NO_ERROR;
+    std::map<std::string, std::string> * section = nullptr;
 
     retval = GetDefaultSection(section);
 
     if (retval == CHIP_NO_ERROR)
     {
         std::string escapedKey = EscapeKey(key);
-        auto it                = section.find(escapedKey);
+        auto it                = section->find(escapedKey);
 
-        if (it != section.end())
+        if (it != section->end())
         {
-            if (!inipp::extract(section[escapedKey], val))
+            if (!inipp::extract(it->second, val))
             {
                 retval = CHIP_ERROR_INVALID_ARGUMENT;
             }
@@ -211,20 +212,20 @@ CHIP_ERROR ChipLinuxStorageIni::GetUInt64Value(const char * key, uint64_t & val)
 
 CHIP_ERROR ChipLinuxStorageIni::GetStringValue(const char * key, char * buf, size_t bufSize, size_t & outLen)
 {
-    CHIP_ERROR retval = CHIP_NO_ERROR;
-    std::map<std::string, std::string> section;
+    CHIP_ERROR retval                            = CHIP_NO_ERROR;
+    std::map<std::string, std::string> * section = nullptr;
 
     retval = GetDefaultSection(section);
 
     if (retval == CHIP_NO_ERROR)
     {
         std::string escapedKey = EscapeKey(key);
-        auto it                = section.find(escapedKey);
+        auto it                = section->find(escapedKey);
 
-        if (it != section.end())
+        if (it != section->end())
         {
             std::string value;
-            if (inipp::extract(section[escapedKey], value))
+            if (inipp::extract(it->second, value))
             {
                 size_t len = value.size();
 
@@ -257,17 +258,17 @@ CHIP_ERROR ChipLinuxStorageIni::GetBinaryBlobDataAndLengths(const char * key,
                                                             chip::Platform::ScopedMemoryBuffer<char> & encodedData,
                                                             size_t & encodedDataLen, size_t & decodedDataLen)
 {
-    size_t encodedDataPaddingLen = 0;
-    std::map<std::string, std::string> section;
-    CHIP_ERROR err = GetDefaultSection(section);
+    size_t encodedDataPaddingLen                 = 0;
+    std::map<std::string, std::string> * section = nullptr;
+    CHIP_ERROR err                               = GetDefaultSection(section);
     if (err != CHIP_NO_ERROR)
     {
         return err;
     }
 
     std::string escapedKey = EscapeKey(key);
-    auto it                = section.find(escapedKey);
-    if (it == section.end())
+    auto it                = section->find(escapedKey);
+    if (it == section->end())
     {
         return CHIP_ERROR_KEY_NOT_FOUND;
     }
@@ -275,7 +276,7 @@ CHIP_ERROR ChipLinuxStorageIni::GetBinaryBlobDataAndLengths(const char * key,
     std::string value;
 
     // Compute the expectedDecodedLen
-    if (!inipp::extract(section[escapedKey], value))
+    if (!inipp::extract(it->second, value))
     {
         return CHIP_ERROR_INVALID_ARGUMENT;
     }
@@ -341,15 +342,15 @@ CHIP_ERROR ChipLinuxStorageIni::GetBinaryBlobValue(const char * key, uint8_t * d
 
 bool ChipLinuxStorageIni::HasValue(const char * key)
 {
-    std::map<std::string, std::string> section;
+    std::map<std::string, std::string> * section = nullptr;
 
     if (GetDefaultSection(section) != CHIP_NO_ERROR)
         return false;
 
     std::string escapedKey = EscapeKey(key);
-    auto it                = section.find(escapedKey);
+    auto it                = section->find(escapedKey);
 
-    return it != section.end();
+    return it != section->end();
 }
 
 CHIP_ERROR ChipLinuxStorageIni::AddEntry(const char * key, const char * value)
@@ -44,7 +44,30 @@ CHIP_ERROR KeyValueStoreManagerImpl::_Get(const char * key, void * value, size_t
     // Copy data into value buffer
     VerifyOrReturnError(value != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
 
-    // On linux read first without a buffer which returns the size, and then
+    // Read straight into the value buffer when it holds the entire object, as
+    // for most reads, so that the object is looked up and decoded only once.
+    if (offset_bytes == 0)
+    {
+        CHIP_ERROR err = mStorage.ReadValueBin(key, static_cast<uint8_t *>(value), value_size, read_size);
+        if (err == CHIP_NO_ERROR)
+        {
+            if (read_bytes_size != nullptr)
+            {
+                *read_bytes_size = read_size;
+            }
+            return CHIP_NO_ERROR;
+        }
+        if (err == CHIP_ERROR_KEY_NOT_FOUND)
+        {
+            return CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND;
+        }
+        if (err != CHIP_ERROR_BUFFER_TOO_SMALL)
+        {
+            return err;
+        }
+    }
+
+    // Otherwise read first without a buffer which returns the size, and then
     // use a local buffer to read the entire object, which allows partial and
     // offset reads.
     CHIP_ERROR err = mStorage.ReadValueBin(key, nullptr, 0, read_size);
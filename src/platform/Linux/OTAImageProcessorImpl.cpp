@@ -21,6 +21,7 @@
 
 #include "OTAImageProcessorImpl.h"
 
+#include <string.h>
 #include <sys/stat.h>
 
 namespace chip {
@@ -63,16 +64,23 @@ CHIP_ERROR OTAImageProcessorImpl::Abort()
 
 CHIP_ERROR OTAImageProcessorImpl::ProcessBlock(ByteSpan & block)
 {
-    if (!mOfs.is_open() || !mOfs.good())
+    if (!mWriterRunning)
     {
         return CHIP_ERROR_INTERNAL;
     }
 
+    {
+        // The next block is only requested while a buffer is free
+        std::lock_guard<std::mutex> lock(mWriterMutex);
+        VerifyOrReturnError(mQueuedCount < kBlockBufferCount, CHIP_ERROR_INCORRECT_STATE);
+    }
+
     // Store block data for HandleProcessBlock to access
-    CHIP_ERROR err = SetBlock(block);
+    CHIP_ERROR err = SetBlock(mBlocks[mFillIndex], block);
     if (err != CHIP_NO_ERROR)
     {
         ChipLogError(SoftwareUpdate, "Cannot set block data: %" CHIP_ERROR_FORMAT, err.Format());
+        return err;
     }
 
     DeviceLayer::PlatformMgr().ScheduleWork(HandleProcessBlock, reinterpret_cast<intptr_t>(this));
@@ -125,9 +133,15 @@ void OTAImageProcessorImpl::HandlePrepareDownload(intptr_t context)
         return;
     }
 
+    // A previous download that was neither finalized nor aborted
+    imageProcessor->StopWriter(true /* discard */);
+    imageProcessor->mOfs.close();
+
     unlink(imageProcessor->mImageFile);
 
     imageProcessor->mHeaderParser.Init();
+    imageProcessor->mImageDigestLength = 0;
+    imageProcessor->mImageVerified     = false;
     imageProcessor->mOfs.open(imageProcessor->mImageFile, std::ofstream::out | std::ofstream::ate | std::ofstream::app);
     if (!imageProcessor->mOfs.good())
     {
@@ -135,6 +149,18 @@ void OTAImageProcessorImpl::HandlePrepareDownload(intptr_t context)
         return;
     }
 
+    CHIP_ERROR error = imageProcessor->mPayloadDigest.Begin();
+    if (error == CHIP_NO_ERROR)
+    {
+        error = imageProcessor->StartWriter();
+    }
+    if (error != CHIP_NO_ERROR)
+    {
+        imageProcessor->mOfs.close();
+        imageProcessor->mDownloader->OnPreparedForDownload(error);
+        return;
+    }
+
     imageProcessor->mDownloader->OnPreparedForDownload(CHIP_NO_ERROR);
 }
 
@@ -146,10 +172,34 @@ void OTAImageProcessorImpl::HandleFinalize(intptr_t context)
         return;
     }
 
+    // Let the writer thread write the blocks still queued
+    imageProcessor->StopWriter(false /* discard */);
     imageProcessor->mOfs.close();
-    imageProcessor->ReleaseBlock();
+    imageProcessor->ReleaseBlocks();
 
-    ChipLogProgress(SoftwareUpdate, "OTA image downloaded to %s", imageProcessor->mImageFile);
+    if (imageProcessor->mWriteFailed)
+    {
+        ChipLogError(SoftwareUpdate, "Failed to write the OTA image to %s", imageProcessor->mImageFile);
+    }
+    else if (!imageProcessor->VerifyImageDigest())
+    {
+        ChipLogError(SoftwareUpdate, "OTA image digest does not match the image header");
+    }
+    else
+    {
+        imageProcessor->mImageVerified = true;
+        ChipLogProgress(SoftwareUpdate, "OTA image downloaded to %s", imageProcessor->mImageFile);
+        return;
+    }
+
+    unlink(imageProcessor->mImageFile);
+
+    // The download has already completed, so the requestor would otherwise go on to apply the image
+    OTARequestorInterface * requestor = chip::GetRequestorInstance();
+    if (requestor != nullptr)
+    {
+        requestor->CancelImageUpdate();
+    }
 }
 
 void OTAImageProcessorImpl::HandleApply(intptr_t context)
@@ -160,6 +210,15 @@ void OTAImageProcessorImpl::HandleApply(intptr_t context)
     OTARequestorInterface * requestor = chip::GetRequestorInstance();
     VerifyOrReturn(requestor != nullptr);
 
+    // Keep the current image unless a complete, verified image was downloaded
+    if (!imageProcessor->mImageVerified)
+    {
+        ChipLogError(SoftwareUpdate, "No verified OTA image to apply");
+        requestor->CancelImageUpdate();
+        return;
+    }
+    imageProcessor->mImageVerified = false;
+
     // Move the downloaded image to the location where the new image is to be executed from
     unlink(kImageExecPath);
     rename(imageProcessor->mImageFile, kImageExecPath);
@@ -178,9 +237,11 @@ void OTAImageProcessorImpl::HandleAbort(intptr_t context)
         return;
     }
 
+    imageProcessor->StopWriter(true /* discard */);
     imageProcessor->mOfs.close();
     unlink(imageProcessor->mImageFile);
-    imageProcessor->ReleaseBlock();
+    imageProcessor->ReleaseBlocks();
+    imageProcessor->mImageVerified = false;
 }
 
 void OTAImageProcessorImpl::HandleProcessBlock(intptr_t context)
@@ -196,9 +257,15 @@ void OTAImageProcessorImpl::HandleProcessBlock(intptr_t context)
         ChipLogError(SoftwareUpdate, "mDownloader is null");
         return;
     }
+    else if (!imageProcessor->mWriterRunning)
+    {
+        // Aborted or finalized since the block was received
+        return;
+    }
 
-    ByteSpan block   = imageProcessor->mBlock;
-    CHIP_ERROR error = imageProcessor->ProcessHeader(block);
+    BlockBuffer & buffer = imageProcessor->mBlocks[imageProcessor->mFillIndex];
+    ByteSpan block       = buffer.mPayload;
+    CHIP_ERROR error     = imageProcessor->ProcessHeader(block);
     if (error != CHIP_NO_ERROR)
     {
         ChipLogError(SoftwareUpdate, "Image does not contain a valid header");
@@ -206,16 +273,50 @@ void OTAImageProcessorImpl::HandleProcessBlock(intptr_t context)
         return;
     }
 
-    if (!imageProcessor->mOfs.write(reinterpret_cast<const char *>(block.data()), static_cast<std::streamsize>(block.size())))
+    buffer.mPayload = block;
+    imageProcessor->mParams.downloadedBytes += block.size();
+    imageProcessor->mFillIndex = (imageProcessor->mFillIndex + 1) % kBlockBufferCount;
+
+    // Ask for the next block right away if a buffer is free, rather than once this one is written
+    bool fetchNextData;
     {
-        imageProcessor->mDownloader->EndDownload(CHIP_ERROR_WRITE_FAILED);
-        return;
+        std::lock_guard<std::mutex> lock(imageProcessor->mWriterMutex);
+        if (imageProcessor->mWriteFailed)
+        {
+            return;
+        }
+
+        imageProcessor->mQueuedCount++;
+        fetchNextData                 = imageProcessor->mQueuedCount < kBlockBufferCount;
+        imageProcessor->mFetchPending = !fetchNextData;
     }
+    imageProcessor->mWriterCondition.notify_one();
 
-    imageProcessor->mParams.downloadedBytes += block.size();
+    if (fetchNextData)
+    {
+        imageProcessor->mDownloader->FetchNextData();
+    }
+}
+
+void OTAImageProcessorImpl::HandleBlockWritten(intptr_t context)
+{
+    auto * imageProcessor = reinterpret_cast<OTAImageProcessorImpl *>(context);
+    VerifyOrReturn(imageProcessor != nullptr && imageProcessor->mDownloader != nullptr);
+
+    // The download may have been aborted or finalized in the meantime, in which case there is no next block to fetch
+    VerifyOrReturn(imageProcessor->mWriterRunning);
     imageProcessor->mDownloader->FetchNextData();
 }
 
+void OTAImageProcessorImpl::HandleWriteError(intptr_t context)
+{
+    auto * imageProcessor = reinterpret_cast<OTAImageProcessorImpl *>(context);
+    VerifyOrReturn(imageProcessor != nullptr && imageProcessor->mDownloader != nullptr);
+
+    VerifyOrReturn(imageProcessor->mWriterRunning);
+    imageProcessor->mDownloader->EndDownload(CHIP_ERROR_WRITE_FAILED);
+}
+
 CHIP_ERROR OTAImageProcessorImpl::ProcessHeader(ByteSpan & block)
 {
     if (mHeaderParser.IsInitialized())
@@ -228,50 +329,152 @@ CHIP_ERROR OTAImageProcessorImpl::ProcessHeader(ByteSpan & block)
         ReturnErrorOnFailure(error);
 
         mParams.totalFileBytes = header.mPayloadSize;
+
+        // The truncated SHA-256 digests are a prefix of the SHA-256 digest of the payload
+        if (header.mImageDigestType >= OTAImageDigestType::kSha256 && header.mImageDigestType <= OTAImageDigestType::kSha256_32 &&
+            header.mImageDigest.size() <= sizeof(mImageDigest))
+        {
+            memcpy(mImageDigest, header.mImageDigest.data(), header.mImageDigest.size());
+            mImageDigestLength = header.mImageDigest.size();
+        }
+        else
+        {
+            ChipLogProgress(SoftwareUpdate, "Image digest type %u is not verified", to_underlying(header.mImageDigestType));
+        }
+
         mHeaderParser.Clear();
     }
 
     return CHIP_NO_ERROR;
 }
 
-CHIP_ERROR OTAImageProcessorImpl::SetBlock(ByteSpan & block)
+CHIP_ERROR OTAImageProcessorImpl::SetBlock(BlockBuffer & buffer, ByteSpan & block)
 {
     if (!IsSpanUsable(block))
     {
-        ReleaseBlock();
+        buffer.mPayload = ByteSpan();
         return CHIP_NO_ERROR;
     }
-    if (mBlock.size() < block.size())
+    if (buffer.mCapacity < block.size())
     {
-        if (!mBlock.empty())
-        {
-            ReleaseBlock();
-        }
-        uint8_t * mBlock_ptr = static_cast<uint8_t *>(chip::Platform::MemoryAlloc(block.size()));
-        if (mBlock_ptr == nullptr)
+        chip::Platform::MemoryFree(buffer.mData);
+        buffer.mCapacity = 0;
+        buffer.mData     = static_cast<uint8_t *>(chip::Platform::MemoryAlloc(block.size()));
+        if (buffer.mData == nullptr)
         {
             return CHIP_ERROR_NO_MEMORY;
         }
-        mBlock = MutableByteSpan(mBlock_ptr, block.size());
+        buffer.mCapacity = block.size();
     }
-    CHIP_ERROR err = CopySpanToMutableSpan(block, mBlock);
-    if (err != CHIP_NO_ERROR)
+    memcpy(buffer.mData, block.data(), block.size());
+    buffer.mPayload = ByteSpan(buffer.mData, block.size());
+    return CHIP_NO_ERROR;
+}
+
+void OTAImageProcessorImpl::ReleaseBlocks()
+{
+    for (BlockBuffer & buffer : mBlocks)
     {
-        ChipLogError(SoftwareUpdate, "Cannot copy block data: %" CHIP_ERROR_FORMAT, err.Format());
-        return err;
+        chip::Platform::MemoryFree(buffer.mData);
+        buffer = BlockBuffer();
     }
+}
+
+CHIP_ERROR OTAImageProcessorImpl::StartWriter()
+{
+    mFillIndex     = 0;
+    mWriteIndex    = 0;
+    mQueuedCount   = 0;
+    mFetchPending  = false;
+    mStopWriter    = false;
+    mDiscardBlocks = false;
+    mWriteFailed   = false;
+
+    int res = pthread_create(&mWriterThread, nullptr, WriterThreadMain, this);
+    VerifyOrReturnError(res == 0, CHIP_ERROR_POSIX(res));
+
+    mWriterRunning = true;
     return CHIP_NO_ERROR;
 }
 
-CHIP_ERROR OTAImageProcessorImpl::ReleaseBlock()
+void OTAImageProcessorImpl::StopWriter(bool discard)
 {
-    if (mBlock.data() != nullptr)
+    VerifyOrReturn(mWriterRunning);
+
     {
-        chip::Platform::MemoryFree(mBlock.data());
+        std::lock_guard<std::mutex> lock(mWriterMutex);
+        mStopWriter    = true;
+        mDiscardBlocks = discard;
     }
+    mWriterCondition.notify_one();
 
-    mBlock = MutableByteSpan();
-    return CHIP_NO_ERROR;
+    pthread_join(mWriterThread, nullptr);
+    mWriterRunning = false;
+}
+
+void * OTAImageProcessorImpl::WriterThreadMain(void * context)
+{
+    static_cast<OTAImageProcessorImpl *>(context)->WriteQueuedBlocks();
+    return nullptr;
+}
+
+void OTAImageProcessorImpl::WriteQueuedBlocks()
+{
+    std::unique_lock<std::mutex> lock(mWriterMutex);
+
+    while (true)
+    {
+        mWriterCondition.wait(lock, [this] { return mQueuedCount > 0 || mStopWriter; });
+        if (mQueuedCount == 0 || mDiscardBlocks)
+        {
+            // Only stop once the queued blocks are written, unless they are discarded
+            break;
+        }
+
+        // The buffer is not touched by the Matter thread until it is released below
+        ByteSpan payload = mBlocks[mWriteIndex].mPayload;
+        bool failed      = mWriteFailed;
+        lock.unlock();
+
+        if (!failed)
+        {
+            failed = !mOfs.write(reinterpret_cast<const char *>(payload.data()), static_cast<std::streamsize>(payload.size())) ||
+                (mPayloadDigest.AddData(payload) != CHIP_NO_ERROR);
+        }
+
+        lock.lock();
+        mWriteIndex = (mWriteIndex + 1) % kBlockBufferCount;
+        mQueuedCount--;
+
+        if (failed && !mWriteFailed)
+        {
+            mWriteFailed = true;
+            DeviceLayer::PlatformMgr().ScheduleWork(HandleWriteError, reinterpret_cast<intptr_t>(this));
+        }
+        else if (mFetchPending && !mWriteFailed)
+        {
+            mFetchPending = false;
+            DeviceLayer::PlatformMgr().ScheduleWork(HandleBlockWritten, reinterpret_cast<intptr_t>(this));
+        }
+    }
+}
+
+bool OTAImageProcessorImpl::VerifyImageDigest()
+{
+    uint8_t digestBuffer[Crypto::kSHA256_Hash_Length];
+    MutableByteSpan digest(digestBuffer);
+    if (mPayloadDigest.Finish(digest) != CHIP_NO_ERROR)
+    {
+        return false;
+    }
+
+    if (mImageDigestLength == 0)
+    {
+        // Not a digest type that can be verified
+        return true;
+    }
+
+    return memcmp(digest.data(), mImageDigest, mImageDigestLength) == 0;
 }
 
 } // namespace chip
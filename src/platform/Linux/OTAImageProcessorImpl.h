@@ -19,20 +19,33 @@
 #pragma once
 
 #include <app/clusters/ota-requestor/OTADownloader.h>
+#include <crypto/CHIPCryptoPAL.h>
 #include <lib/core/OTAImageHeader.h>
 #include <platform/CHIPDeviceLayer.h>
 #include <platform/OTAImageProcessor.h>
 
+#include <condition_variable>
 #include <fstream>
+#include <mutex>
+#include <pthread.h>
 
 namespace chip {
 
 // Full file path to where the new image will be executed from post-download
 static char kImageExecPath[] = "/tmp/ota.update";
 
+/**
+ * Writes the downloaded image to a file from a background thread, so that disk writes do not delay the download.
+ *
+ * Blocks are copied into a ring of kBlockBufferCount buffers and queued for the writer thread, which also computes the digest of
+ * the image payload as it writes it. The next block is requested from the downloader as long as a buffer is free, and otherwise
+ * as soon as the writer releases one.
+ */
 class OTAImageProcessorImpl : public OTAImageProcessorInterface
 {
 public:
+    static constexpr size_t kBlockBufferCount = 4;
+
     //////////// OTAImageProcessorInterface Implementation ///////////////
     CHIP_ERROR PrepareDownload() override;
     CHIP_ERROR Finalize() override;
@@ -46,6 +59,13 @@ public:
     void SetOTAImageFile(const char * imageFile) { mImageFile = imageFile; }
 
 private:
+    struct BlockBuffer
+    {
+        uint8_t * mData  = nullptr;
+        size_t mCapacity = 0;
+        ByteSpan mPayload; ///< Part of the block to write, that is without the bytes of the image header
+    };
+
     //////////// Actual handlers for the OTAImageProcessorInterface ///////////////
     static void HandlePrepareDownload(intptr_t context);
     static void HandleFinalize(intptr_t context);
@@ -53,23 +73,60 @@ private:
     static void HandleAbort(intptr_t context);
     static void HandleProcessBlock(intptr_t context);
 
+    //////////// Scheduled by the writer thread ///////////////
+    static void HandleBlockWritten(intptr_t context);
+    static void HandleWriteError(intptr_t context);
+
     CHIP_ERROR ProcessHeader(ByteSpan & block);
 
     /**
-     * Called to allocate memory for mBlock if necessary and set it to block
+     * Called to allocate memory for the buffer if necessary and copy block into it
      */
-    CHIP_ERROR SetBlock(ByteSpan & block);
+    CHIP_ERROR SetBlock(BlockBuffer & buffer, ByteSpan & block);
 
     /**
-     * Called to release allocated memory for mBlock
+     * Called to release allocated memory for all the block buffers
      */
-    CHIP_ERROR ReleaseBlock();
+    void ReleaseBlocks();
+
+    CHIP_ERROR StartWriter();
+
+    /**
+     * Wait for the writer thread to exit. Queued blocks are written first, unless discard is true.
+     */
+    void StopWriter(bool discard);
+
+    static void * WriterThreadMain(void * context);
+    void WriteQueuedBlocks();
+
+    bool VerifyImageDigest();
 
     std::ofstream mOfs;
-    MutableByteSpan mBlock;
     OTADownloader * mDownloader;
     OTAImageHeaderParser mHeaderParser;
     const char * mImageFile = nullptr;
+
+    // Digest from the image header, only kept for the digest types that are a truncation of SHA-256
+    uint8_t mImageDigest[Crypto::kSHA256_Hash_Length];
+    size_t mImageDigestLength = 0;
+    Crypto::Hash_SHA256_stream mPayloadDigest;
+    bool mImageVerified = false; ///< Set once the image file is fully written and matches the digest, checked before applying it
+
+    BlockBuffer mBlocks[kBlockBufferCount];
+    size_t mFillIndex = 0; ///< Buffer that receives the next block, only used from the Matter thread
+
+    pthread_t mWriterThread;
+    bool mWriterRunning = false;
+
+    // The following are shared with the writer thread and protected by mWriterMutex
+    std::mutex mWriterMutex;
+    std::condition_variable mWriterCondition;
+    size_t mWriteIndex  = 0; ///< First buffer queued for the writer thread
+    size_t mQueuedCount = 0; ///< Number of buffers queued for the writer thread
+    bool mFetchPending  = false;
+    bool mStopWriter    = false;
+    bool mDiscardBlocks = false;
+    bool mWriteFailed   = false;
 };
 
 } // namespace chip
@@ -0,0 +1,200 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements the 'chip-log-decoder' command line tool, which prints the binary
+ *      log files written by the asynchronous logging backend as text lines.
+ */
+
+#include <lib/core/CHIPError.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/ErrorStr.h>
+#include <lib/support/logging/BinaryLogFormat.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <strings.h>
+#include <unordered_map>
+#include <vector>
+
+namespace chip {
+namespace Logging {
+namespace Platform {
+
+void LogV(const char * module, uint8_t category, const char * msg, va_list v) {}
+
+} // namespace Platform
+} // namespace Logging
+} // namespace chip
+
+namespace {
+
+using namespace chip;
+using namespace chip::Logging;
+
+// clang-format off
+const char * const sHelp =
+    "Usage: chip-log-decoder [ <binary-log-file> ]\n"
+    "\n"
+    "Print a binary log file as text lines; the file is read from standard input if not given.\n"
+    "\n";
+// clang-format on
+
+constexpr size_t kMaxLineSize = 2048;
+
+bool ReadAll(FILE * input, std::vector<uint8_t> & data)
+{
+    uint8_t buffer[4096];
+    size_t read;
+
+    while ((read = fread(buffer, 1, sizeof(buffer), input)) > 0)
+    {
+        data.insert(data.end(), buffer, buffer + read);
+    }
+
+    return ferror(input) == 0;
+}
+
+void PrintLine(const char * line, size_t length)
+{
+    fwrite(line, 1, length, stdout);
+    fputc('\n', stdout);
+}
+
+bool Decode(ByteSpan data)
+{
+    uint32_t processId;
+    CHIP_ERROR err = BinaryLog::DecodeFileHeader(data, processId);
+    if (err != CHIP_NO_ERROR)
+    {
+        fprintf(stderr, "Not a binary log file: %s\n", ErrorStr(err));
+        return false;
+    }
+
+    std::unordered_map<uint32_t, std::string> strings;
+    char line[kMaxLineSize];
+
+    while (!data.empty())
+    {
+        BinaryLog::Record record;
+        err = BinaryLog::DecodeRecord(data, record);
+        if (err == CHIP_ERROR_BUFFER_TOO_SMALL)
+        {
+            fprintf(stderr, "Warning: ignoring the incomplete record at the end of the file\n");
+            break;
+        }
+        if (err != CHIP_NO_ERROR)
+        {
+            fprintf(stderr, "Malformed record: %s\n", ErrorStr(err));
+            return false;
+        }
+
+        switch (record.type)
+        {
+        case BinaryLog::RecordType::kString:
+            strings[record.id] = std::string(record.string.data(), record.string.size());
+            break;
+
+        case BinaryLog::RecordType::kMessage: {
+            auto module = strings.find(record.message.moduleId);
+            auto format = strings.find(record.message.formatId);
+            if (module == strings.end() || format == strings.end())
+            {
+                fprintf(stderr, "Message with an undefined string, skipped\n");
+                break;
+            }
+
+            MutableCharSpan formatted(line);
+            err = BinaryLog::FormatLine(record.message.timestampMicros, processId, record.message.threadId, module->second.c_str(),
+                                        format->second.c_str(), record.message.arguments, formatted);
+            if (err != CHIP_NO_ERROR)
+            {
+                fprintf(stderr, "Message not matching its format \"%s\", skipped\n", format->second.c_str());
+                break;
+            }
+            PrintLine(formatted.data(), formatted.size());
+            break;
+        }
+
+        case BinaryLog::RecordType::kDropped: {
+            int length = snprintf(line, sizeof(line), "[%" PRIu32 ":%" PRIu32 "] %" PRIu32 " log messages dropped", processId,
+                                  record.id, record.dropped);
+            PrintLine(line, static_cast<size_t>(length));
+            break;
+        }
+
+        default:
+            // Records of later versions of the format
+            break;
+        }
+    }
+
+    return true;
+}
+
+} // namespace
+
+extern "C" int main(int argc, char * argv[])
+{
+    bool res     = false;
+    FILE * input = stdin;
+
+    chip::Platform::MemoryInit();
+
+    if (argc > 2)
+    {
+        fputs(sHelp, stderr);
+        return -1;
+    }
+
+    if (argc == 2)
+    {
+        if (strcasecmp(argv[1], "help") == 0 || strcasecmp(argv[1], "--help") == 0 || strcasecmp(argv[1], "-h") == 0)
+        {
+            return (fputs(sHelp, stdout) != EOF) ? 0 : -1;
+        }
+
+        input = fopen(argv[1], "rb");
+        if (input == nullptr)
+        {
+            fprintf(stderr, "Unable to open %s: %s\n", argv[1], strerror(errno));
+            return -1;
+        }
+    }
+
+    std::vector<uint8_t> data;
+    if (ReadAll(input, data))
+    {
+        res = Decode(ByteSpan(data.data(), data.size()));
+    }
+    else
+    {
+        fprintf(stderr, "Unable to read the binary log file\n");
+    }
+
+    if (input != stdin)
+    {
+        fclose(input);
+    }
+
+    return res ? 0 : -1;
+}
@@ -47,6 +47,29 @@ constexpr uint16_t kMaxMessageSize = static_cast<uint16_t>(System::PacketBuffer:
 
 constexpr int kListenBacklogSize = 2;
 
+// Have the endpoint receive each message into a buffer of its own, so that ProcessSingleMessage
+// can hand it up as is. Endpoints that cannot frame the received data are still handled, as
+// ProcessReceivedBuffer reassembles messages from any buffer chain.
+void EnableMessageFraming(Inet::TCPEndPoint * endPoint)
+{
+    CHIP_ERROR err = endPoint->EnableLengthPrefixedFraming(static_cast<uint16_t>(kMaxMessageSize - 1));
+    if (err != CHIP_NO_ERROR && err != CHIP_ERROR_NOT_IMPLEMENTED)
+    {
+        ChipLogError(Inet, "Failed to enable TCP message framing: %s", ErrorStr(err));
+    }
+}
+
+size_t HashPeer(const Inet::IPAddress & addr, uint16_t port)
+{
+    // FNV-1a over the address words and the port.
+    uint32_t hash = 2166136261u;
+    for (uint32_t word : addr.Addr)
+    {
+        hash = (hash ^ word) * 16777619u;
+    }
+    return (hash ^ port) * 16777619u;
+}
+
 } // namespace
 
 TCPBase::~TCPBase()
@@ -67,12 +90,99 @@ void TCPBase::CloseActiveConnections()
     {
         if (mActiveConnections[i].InUse())
         {
-            mActiveConnections[i].Free();
-            mUsedEndPointCount--;
+            ReleaseConnection(&mActiveConnections[i]);
         }
     }
 }
 
+void TCPBase::InitConnections()
+{
+    mFreeConnections = nullptr;
+    for (size_t i = mActiveConnectionsSize; i > 0; i--)
+    {
+        mActiveConnections[i - 1].Init(nullptr);
+        mActiveConnections[i - 1].mNextByPeer = mFreeConnections;
+        mFreeConnections                      = &mActiveConnections[i - 1];
+
+        mConnectionBuckets[i - 1].mByPeer     = nullptr;
+        mConnectionBuckets[i - 1].mByEndPoint = nullptr;
+    }
+    mActiveConnectionCount = 0;
+}
+
+TCPBase::ConnectionBucket & TCPBase::PeerBucket(const Inet::IPAddress & addr, uint16_t port)
+{
+    return mConnectionBuckets[HashPeer(addr, port) % mActiveConnectionsSize];
+}
+
+TCPBase::ConnectionBucket & TCPBase::EndPointBucket(const Inet::TCPEndPoint * endPoint)
+{
+    // Drop the low bits, which are the same for all endpoints because of their alignment.
+    return mConnectionBuckets[(reinterpret_cast<uintptr_t>(endPoint) / alignof(Inet::TCPEndPoint)) % mActiveConnectionsSize];
+}
+
+TCPBase::ActiveConnectionState * TCPBase::AllocateConnection(Inet::TCPEndPoint * endPoint)
+{
+    ActiveConnectionState * connection = mFreeConnections;
+    VerifyOrReturnValue(connection != nullptr, nullptr);
+    mFreeConnections = connection->mNextByPeer;
+
+    Inet::IPAddress ipAddress;
+    uint16_t port = 0;
+    Inet::InterfaceId interfaceId;
+    endPoint->GetPeerInfo(&ipAddress, &port);
+    endPoint->GetInterfaceId(&interfaceId);
+
+    connection->Init(endPoint);
+    connection->mPeerAddress = PeerAddress::TCP(ipAddress, port, interfaceId);
+
+    ConnectionBucket & peerBucket = PeerBucket(ipAddress, port);
+    connection->mNextByPeer       = peerBucket.mByPeer;
+    peerBucket.mByPeer            = connection;
+
+    ConnectionBucket & endPointBucket = EndPointBucket(endPoint);
+    connection->mNextByEndPoint       = endPointBucket.mByEndPoint;
+    endPointBucket.mByEndPoint        = connection;
+
+    mActiveConnectionCount++;
+
+#if INET_TCP_IDLE_CHECK_INTERVAL > 0
+    if (mIdleTimeout != System::Clock::kZero)
+    {
+        // The endpoint closes itself once idle for that long, see OnConnectionClosed.
+        endPoint->SetIdleTimeout(mIdleTimeout.count());
+    }
+#endif // INET_TCP_IDLE_CHECK_INTERVAL > 0
+
+    return connection;
+}
+
+void TCPBase::ReleaseConnection(ActiveConnectionState * connection)
+{
+    ActiveConnectionState ** link =
+        &PeerBucket(connection->mPeerAddress.GetIPAddress(), connection->mPeerAddress.GetPort()).mByPeer;
+    while (*link != connection)
+    {
+        link = &(*link)->mNextByPeer;
+    }
+    *link = connection->mNextByPeer;
+
+    link = &EndPointBucket(connection->mEndPoint).mByEndPoint;
+    while (*link != connection)
+    {
+        link = &(*link)->mNextByEndPoint;
+    }
+    *link = connection->mNextByEndPoint;
+
+    connection->Free();
+    connection->Init(nullptr);
+    connection->mNextByPeer = mFreeConnections;
+    mFreeConnections        = connection;
+
+    mActiveConnectionCount--;
+    mUsedEndPointCount--;
+}
+
 CHIP_ERROR TCPBase::Init(TcpListenParameters & params)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
@@ -100,6 +210,8 @@ CHIP_ERROR TCPBase::Init(TcpListenParameters & params)
     mListenSocket->OnConnectionReceived = OnConnectionReceived;
     mListenSocket->OnAcceptError        = OnAcceptError;
     mEndpointType                       = params.GetAddressType();
+    mIdleTimeout                        = params.GetIdleTimeout();
+    mMaxPendingSendSize                 = params.GetMaxPendingSendSize();
 
     mState = State::kInitialized;
 
@@ -134,19 +246,13 @@ TCPBase::ActiveConnectionState * TCPBase::FindActiveConnection(const PeerAddress
         return nullptr;
     }
 
-    for (size_t i = 0; i < mActiveConnectionsSize; i++)
+    for (ActiveConnectionState * connection = PeerBucket(address.GetIPAddress(), address.GetPort()).mByPeer;
+         connection != nullptr; connection = connection->mNextByPeer)
     {
-        if (!mActiveConnections[i].InUse())
-        {
-            continue;
-        }
-        Inet::IPAddress addr;
-        uint16_t port;
-        mActiveConnections[i].mEndPoint->GetPeerInfo(&addr, &port);
-
-        if ((addr == address.GetIPAddress()) && (port == address.GetPort()))
+        if ((connection->mPeerAddress.GetIPAddress() == address.GetIPAddress()) &&
+            (connection->mPeerAddress.GetPort() == address.GetPort()))
         {
-            return &mActiveConnections[i];
+            return connection;
         }
     }
 
@@ -155,14 +261,12 @@ TCPBase::ActiveConnectionState * TCPBase::FindActiveConnection(const PeerAddress
 
 TCPBase::ActiveConnectionState * TCPBase::FindActiveConnection(const Inet::TCPEndPoint * endPoint)
 {
-    for (size_t i = 0; i < mActiveConnectionsSize; i++)
+    ActiveConnectionState * connection = EndPointBucket(endPoint).mByEndPoint;
+    while (connection != nullptr && connection->mEndPoint != endPoint)
     {
-        if (mActiveConnections[i].mEndPoint == endPoint)
-        {
-            return &mActiveConnections[i];
-        }
+        connection = connection->mNextByEndPoint;
     }
-    return nullptr;
+    return connection;
 }
 
 CHIP_ERROR TCPBase::SendMessage(const Transport::PeerAddress & address, System::PacketBufferHandle && msgBuf)
@@ -190,6 +294,7 @@ CHIP_ERROR TCPBase::SendMessage(const Transport::PeerAddress & address, System::
 
     if (connection != nullptr)
     {
+        VerifyOrReturnError(CanQueueForSending(connection->mEndPoint->PendingSendLength(), msgBuf->DataLength()), CHIP_ERROR_BUSY);
         return connection->mEndPoint->Send(std::move(msgBuf));
     }
 
@@ -200,6 +305,7 @@ CHIP_ERROR TCPBase::SendAfterConnect(const PeerAddress & addr, System::PacketBuf
 {
     // This will initiate a connection to the specified peer
     bool alreadyConnecting = false;
+    CHIP_ERROR err         = CHIP_NO_ERROR;
 
     // Iterate through the ENTIRE array. If a pending packet for
     // the address already exists, this means a connection is pending and
@@ -209,16 +315,23 @@ CHIP_ERROR TCPBase::SendAfterConnect(const PeerAddress & addr, System::PacketBuf
         {
             // same destination exists.
             alreadyConnecting = true;
-            pending->mPacketBuffer->AddToEnd(std::move(msg));
+            if (CanQueueForSending(pending->mPacketBuffer->TotalLength(), msg->DataLength()))
+            {
+                pending->mPacketBuffer->AddToEnd(std::move(msg));
+            }
+            else
+            {
+                err = CHIP_ERROR_BUSY;
+            }
             return Loop::Break;
         }
         return Loop::Continue;
     });
 
-    // If already connecting, buffer was just enqueued for more sending
+    // If already connecting, buffer was just enqueued for more sending, unless it did not fit
     if (alreadyConnecting)
     {
-        return CHIP_NO_ERROR;
+        return err;
     }
 
     // Ensures sufficient active connections size exist
@@ -300,7 +413,8 @@ CHIP_ERROR TCPBase::ProcessSingleMessage(const PeerAddress & peerAddress, Active
     if (state->mReceived->DataLength() == messageSize)
     {
         // In this case, the head packet buffer contains exactly the message.
-        // This is common because typical messages fit in a network packet, and are delivered as such.
+        // This is always the case when the endpoint frames the received data, see EnableMessageFraming,
+        // and otherwise common because typical messages fit in a network packet, and are delivered as such.
         // Peel off the head to pass upstream, which effectively consumes it from `state->mReceived`.
         message = state->mReceived.PopHead();
     }
@@ -327,16 +441,16 @@ CHIP_ERROR TCPBase::ProcessSingleMessage(const PeerAddress & peerAddress, Active
 
 CHIP_ERROR TCPBase::OnTcpReceive(Inet::TCPEndPoint * endPoint, System::PacketBufferHandle && buffer)
 {
-    Inet::IPAddress ipAddress;
-    uint16_t port;
-    Inet::InterfaceId interfaceId;
+    TCPBase * tcp                      = reinterpret_cast<TCPBase *>(endPoint->mAppState);
+    ActiveConnectionState * connection = tcp->FindActiveConnection(endPoint);
+    CHIP_ERROR err                     = CHIP_ERROR_INTERNAL;
 
-    endPoint->GetPeerInfo(&ipAddress, &port);
-    endPoint->GetInterfaceId(&interfaceId);
-    PeerAddress peerAddress = PeerAddress::TCP(ipAddress, port, interfaceId);
-
-    TCPBase * tcp  = reinterpret_cast<TCPBase *>(endPoint->mAppState);
-    CHIP_ERROR err = tcp->ProcessReceivedBuffer(endPoint, peerAddress, std::move(buffer));
+    if (connection != nullptr)
+    {
+        // Copied, as the connection may be released while the messages are handled.
+        const PeerAddress peerAddress = connection->mPeerAddress;
+        err                           = tcp->ProcessReceivedBuffer(endPoint, peerAddress, std::move(buffer));
+    }
 
     if (err != CHIP_NO_ERROR)
     {
@@ -396,26 +510,17 @@ void TCPBase::OnConnectionComplete(Inet::TCPEndPoint * endPoint, CHIP_ERROR inet
         endPoint->Free();
         tcp->mUsedEndPointCount--;
     }
+    else if (tcp->AllocateConnection(endPoint) != nullptr)
+    {
+        EnableMessageFraming(endPoint);
+    }
     else
     {
-        bool connectionStored = false;
-        for (size_t i = 0; i < tcp->mActiveConnectionsSize; i++)
-        {
-            if (!tcp->mActiveConnections[i].InUse())
-            {
-                tcp->mActiveConnections[i].Init(endPoint);
-                connectionStored = true;
-                break;
-            }
-        }
-
         // since we track end points counts, we always expect to store the
         // connection.
-        if (!connectionStored)
-        {
-            endPoint->Free();
-            ChipLogError(Inet, "Internal logic error: insufficient space to store active connection");
-        }
+        endPoint->Free();
+        tcp->mUsedEndPointCount--;
+        ChipLogError(Inet, "Internal logic error: insufficient space to store active connection");
     }
 }
 
@@ -423,16 +528,13 @@ void TCPBase::OnConnectionClosed(Inet::TCPEndPoint * endPoint, CHIP_ERROR err)
 {
     TCPBase * tcp = reinterpret_cast<TCPBase *>(endPoint->mAppState);
 
-    ChipLogProgress(Inet, "Connection closed.");
+    ChipLogProgress(Inet, "Connection closed: %s", ErrorStr(err));
 
-    for (size_t i = 0; i < tcp->mActiveConnectionsSize; i++)
+    ActiveConnectionState * connection = tcp->FindActiveConnection(endPoint);
+    if (connection != nullptr)
     {
-        if (tcp->mActiveConnections[i].mEndPoint == endPoint)
-        {
-            ChipLogProgress(Inet, "Freeing closed connection.");
-            tcp->mActiveConnections[i].Free();
-            tcp->mUsedEndPointCount--;
-        }
+        ChipLogProgress(Inet, "Freeing closed connection.");
+        tcp->ReleaseConnection(connection);
     }
 }
 
@@ -441,17 +543,10 @@ void TCPBase::OnConnectionReceived(Inet::TCPEndPoint * listenEndPoint, Inet::TCP
 {
     TCPBase * tcp = reinterpret_cast<TCPBase *>(listenEndPoint->mAppState);
 
-    if (tcp->mUsedEndPointCount < tcp->mActiveConnectionsSize)
+    // have space to use one more (even if considering pending connections)
+    if (tcp->mUsedEndPointCount < tcp->mActiveConnectionsSize && tcp->AllocateConnection(endPoint) != nullptr)
     {
-        // have space to use one more (even if considering pending connections)
-        for (size_t i = 0; i < tcp->mActiveConnectionsSize; i++)
-        {
-            if (!tcp->mActiveConnections[i].InUse())
-            {
-                tcp->mActiveConnections[i].Init(endPoint);
-                break;
-            }
-        }
+        tcp->mUsedEndPointCount++;
 
         endPoint->mAppState            = listenEndPoint->mAppState;
         endPoint->OnDataReceived       = OnTcpReceive;
@@ -460,6 +555,7 @@ void TCPBase::OnConnectionReceived(Inet::TCPEndPoint * listenEndPoint, Inet::TCP
         endPoint->OnConnectionReceived = OnConnectionReceived;
         endPoint->OnAcceptError        = OnAcceptError;
         endPoint->OnPeerClose          = OnPeerClosed;
+        EnableMessageFraming(endPoint);
     }
     else
     {
@@ -476,25 +572,13 @@ void TCPBase::OnAcceptError(Inet::TCPEndPoint * endPoint, CHIP_ERROR err)
 void TCPBase::Disconnect(const PeerAddress & address)
 {
     // Closes an existing connection
-    for (size_t i = 0; i < mActiveConnectionsSize; i++)
+    ActiveConnectionState * connection = FindActiveConnection(address);
+    if (connection != nullptr && connection->mPeerAddress == address)
     {
-        if (mActiveConnections[i].InUse())
-        {
-            Inet::IPAddress ipAddress;
-            uint16_t port;
-            Inet::InterfaceId interfaceId;
-
-            mActiveConnections[i].mEndPoint->GetPeerInfo(&ipAddress, &port);
-            mActiveConnections[i].mEndPoint->GetInterfaceId(&interfaceId);
-            if (address == PeerAddress::TCP(ipAddress, port, interfaceId))
-            {
-                // NOTE: this leaves the socket in TIME_WAIT.
-                // Calling Abort() would clean it since SO_LINGER would be set to 0,
-                // however this seems not to be useful.
-                mActiveConnections[i].Free();
-                mUsedEndPointCount--;
-            }
-        }
+        // NOTE: this leaves the socket in TIME_WAIT.
+        // Calling Abort() would clean it since SO_LINGER would be set to 0,
+        // however this seems not to be useful.
+        ReleaseConnection(connection);
     }
 }
 
@@ -502,28 +586,12 @@ void TCPBase::OnPeerClosed(Inet::TCPEndPoint * endPoint)
 {
     TCPBase * tcp = reinterpret_cast<TCPBase *>(endPoint->mAppState);
 
-    for (size_t i = 0; i < tcp->mActiveConnectionsSize; i++)
-    {
-        if (tcp->mActiveConnections[i].mEndPoint == endPoint)
-        {
-            ChipLogProgress(Inet, "Freeing connection: connection closed by peer");
-            tcp->mActiveConnections[i].Free();
-            tcp->mUsedEndPointCount--;
-        }
-    }
-}
-
-bool TCPBase::HasActiveConnections() const
-{
-    for (size_t i = 0; i < mActiveConnectionsSize; i++)
+    ActiveConnectionState * connection = tcp->FindActiveConnection(endPoint);
+    if (connection != nullptr)
     {
-        if (mActiveConnections[i].InUse())
-        {
-            return true;
-        }
+        ChipLogProgress(Inet, "Freeing connection: connection closed by peer");
+        tcp->ReleaseConnection(connection);
     }
-
-    return false;
 }
 
 } // namespace Transport
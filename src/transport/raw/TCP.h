@@ -34,6 +34,7 @@
 #include <lib/core/CHIPCore.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/PoolWrapper.h>
+#include <system/SystemClock.h>
 #include <transport/raw/Base.h>
 
 namespace chip {
@@ -73,11 +74,29 @@ public:
         return *this;
     }
 
+    System::Clock::Milliseconds32 GetIdleTimeout() const { return mIdleTimeout; }
+    TcpListenParameters & SetIdleTimeout(System::Clock::Milliseconds32 timeout)
+    {
+        mIdleTimeout = timeout;
+
+        return *this;
+    }
+
+    uint32_t GetMaxPendingSendSize() const { return mMaxPendingSendSize; }
+    TcpListenParameters & SetMaxPendingSendSize(uint32_t size)
+    {
+        mMaxPendingSendSize = size;
+
+        return *this;
+    }
+
 private:
-    Inet::EndPointManager<Inet::TCPEndPoint> * mEndPointManager;   ///< Associated endpoint factory
-    Inet::IPAddressType mAddressType = Inet::IPAddressType::kIPv6; ///< type of listening socket
-    uint16_t mListenPort             = CHIP_PORT;                  ///< TCP listen port
-    Inet::InterfaceId mInterfaceId   = Inet::InterfaceId::Null();  ///< Interface to listen on
+    Inet::EndPointManager<Inet::TCPEndPoint> * mEndPointManager;             ///< Associated endpoint factory
+    Inet::IPAddressType mAddressType           = Inet::IPAddressType::kIPv6; ///< type of listening socket
+    uint16_t mListenPort                       = CHIP_PORT;                  ///< TCP listen port
+    Inet::InterfaceId mInterfaceId             = Inet::InterfaceId::Null();  ///< Interface to listen on
+    System::Clock::Milliseconds32 mIdleTimeout = System::Clock::kZero;       ///< Close connections idle for longer, 0 for never
+    uint32_t mMaxPendingSendSize               = 0;                          ///< Limit of bytes queued per connection, 0 for none
 };
 
 /**
@@ -113,8 +132,10 @@ protected:
     {
         void Init(Inet::TCPEndPoint * endPoint)
         {
-            mEndPoint = endPoint;
-            mReceived = nullptr;
+            mEndPoint       = endPoint;
+            mReceived       = nullptr;
+            mNextByPeer     = nullptr;
+            mNextByEndPoint = nullptr;
         }
 
         void Free()
@@ -130,14 +151,39 @@ protected:
 
         // Buffers received but not yet consumed.
         System::PacketBufferHandle mReceived;
+
+        // Address of the peer, kept so that lookups do not have to query the endpoint.
+        PeerAddress mPeerAddress;
+
+        // Next connection in the same bucket of the peer address and endpoint indexes.
+        // While the connection is not in use, mNextByPeer links the free connections.
+        ActiveConnectionState * mNextByPeer;
+        ActiveConnectionState * mNextByEndPoint;
+    };
+
+    /**
+     *  Heads of the chains of connections that hash to the same bucket, by peer address and by endpoint
+     */
+    struct ConnectionBucket
+    {
+        ActiveConnectionState * mByPeer;
+        ActiveConnectionState * mByEndPoint;
     };
 
+    /**
+     * Set up the connections as not in use, and the indexes as empty; to be called by the
+     * owner of the buffers once they have been constructed.
+     */
+    void InitConnections();
+
 public:
     using PendingPacketPoolType = PoolInterface<PendingPacket, const PeerAddress &, System::PacketBufferHandle &&>;
-    TCPBase(ActiveConnectionState * activeConnectionsBuffer, size_t bufferSize, PendingPacketPoolType & packetBuffers) :
-        mActiveConnections(activeConnectionsBuffer), mActiveConnectionsSize(bufferSize), mPendingPackets(packetBuffers)
+    TCPBase(ActiveConnectionState * activeConnectionsBuffer, ConnectionBucket * bucketsBuffer, size_t bufferSize,
+            PendingPacketPoolType & packetBuffers) :
+        mActiveConnections(activeConnectionsBuffer),
+        mConnectionBuckets(bucketsBuffer), mActiveConnectionsSize(bufferSize), mPendingPackets(packetBuffers)
     {
-        // activeConnectionsBuffer must be initialized by the caller.
+        // activeConnectionsBuffer and bucketsBuffer must be initialized by the caller, see InitConnections().
     }
     ~TCPBase() override;
 
@@ -158,6 +204,14 @@ public:
      */
     void Close() override;
 
+    /**
+     * Send a message to a peer, over the connection to the peer if one exists, or else once a
+     * connection has been established.
+     *
+     * @retval CHIP_ERROR_BUSY  The message would exceed the size of the data allowed to wait for
+     *                          sending on the connection, see TcpListenParameters::SetMaxPendingSendSize.
+     *                          Sending may succeed once the connection has caught up.
+     */
     CHIP_ERROR SendMessage(const PeerAddress & address, System::PacketBufferHandle && msgBuf) override;
 
     void Disconnect(const PeerAddress & address) override;
@@ -173,7 +227,7 @@ public:
      * before everything is cleaned up (socket closing is async, so after calling 'Close' on
      * the transport, some time may be needed to actually be able to close.)
      */
-    bool HasActiveConnections() const;
+    bool HasActiveConnections() const { return mActiveConnectionCount != 0; }
 
     /**
      * Close all active connections.
@@ -190,6 +244,31 @@ private:
     ActiveConnectionState * FindActiveConnection(const PeerAddress & addr);
     ActiveConnectionState * FindActiveConnection(const Inet::TCPEndPoint * endPoint);
 
+    /**
+     * Take a free connection for the given connected endpoint and add it to the indexes, or
+     * return nullptr if all connections are in use.
+     */
+    ActiveConnectionState * AllocateConnection(Inet::TCPEndPoint * endPoint);
+
+    /**
+     * Free the endpoint of a connection in use, remove the connection from the indexes and
+     * return it to the free connections.
+     */
+    void ReleaseConnection(ActiveConnectionState * connection);
+
+    ConnectionBucket & PeerBucket(const Inet::IPAddress & addr, uint16_t port);
+    ConnectionBucket & EndPointBucket(const Inet::TCPEndPoint * endPoint);
+
+    /**
+     * Whether a message of the given size may be queued after the given amount of data waiting for sending.
+     * A message is always accepted when nothing is waiting, so that large messages are not refused for good.
+     */
+    bool CanQueueForSending(uint32_t pendingSize, size_t messageSize) const
+    {
+        return mMaxPendingSendSize == 0 || pendingSize == 0 ||
+            (pendingSize <= mMaxPendingSendSize && messageSize <= mMaxPendingSendSize - pendingSize);
+    }
+
     /**
      * Sends the specified message once a connection has been established.
      *
@@ -257,9 +336,16 @@ private:
     // Number of active and 'pending connection' endpoints
     size_t mUsedEndPointCount = 0;
 
-    // Currently active connections
+    // Currently active connections, indexed by peer address and by endpoint
     ActiveConnectionState * mActiveConnections;
+    ConnectionBucket * mConnectionBuckets;
     const size_t mActiveConnectionsSize;
+    size_t mActiveConnectionCount            = 0;
+    ActiveConnectionState * mFreeConnections = nullptr;
+
+    // Connection limits, see TcpListenParameters
+    System::Clock::Milliseconds32 mIdleTimeout = System::Clock::kZero;
+    uint32_t mMaxPendingSendSize               = 0;
 
     // Data to be sent when connections succeed
     PendingPacketPoolType & mPendingPackets;
@@ -269,18 +355,13 @@ template <size_t kActiveConnectionsSize, size_t kPendingPacketSize>
 class TCP : public TCPBase
 {
 public:
-    TCP() : TCPBase(mConnectionsBuffer, kActiveConnectionsSize, mPendingPackets)
-    {
-        for (size_t i = 0; i < kActiveConnectionsSize; ++i)
-        {
-            mConnectionsBuffer[i].Init(nullptr);
-        }
-    }
+    TCP() : TCPBase(mConnectionsBuffer, mBucketsBuffer, kActiveConnectionsSize, mPendingPackets) { InitConnections(); }
     ~TCP() override { mPendingPackets.ReleaseAll(); }
 
 private:
     friend class TCPTest;
     TCPBase::ActiveConnectionState mConnectionsBuffer[kActiveConnectionsSize];
+    TCPBase::ConnectionBucket mBucketsBuffer[kActiveConnectionsSize];
     PoolImpl<PendingPacket, kPendingPacketSize, ObjectPoolMem::kInline, PendingPacketPoolType::Interface> mPendingPackets;
 };
 
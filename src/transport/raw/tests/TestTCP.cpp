@@ -37,6 +37,7 @@
 #include <nlbyteorder.h>
 #include <nlunit-test.h>
 
+#include <algorithm>
 #include <errno.h>
 #include <stdlib.h>
 #include <string.h>
@@ -54,6 +55,7 @@ class TCPTest
 {
 public:
     static void CheckProcessReceivedBuffer(nlTestSuite * inSuite, void * inContext);
+    static void CheckConnectionChurn(nlTestSuite * inSuite, void * inContext);
 };
 } // namespace Transport
 } // namespace chip
@@ -105,9 +107,14 @@ public:
         mReceiveHandlerCallCount++;
     }
 
-    void InitializeMessageTest(TCPImpl & tcp, const IPAddress & addr)
+    void InitializeMessageTest(TCPImpl & tcp, const IPAddress & addr,
+                               System::Clock::Milliseconds32 idleTimeout = System::Clock::kZero, uint32_t maxPendingSendSize = 0)
     {
-        CHIP_ERROR err = tcp.Init(Transport::TcpListenParameters(mContext.GetTCPEndPointManager()).SetAddressType(addr.Type()));
+        auto params = Transport::TcpListenParameters(mContext.GetTCPEndPointManager())
+                          .SetAddressType(addr.Type())
+                          .SetIdleTimeout(idleTimeout)
+                          .SetMaxPendingSendSize(maxPendingSendSize);
+        CHIP_ERROR err = tcp.Init(params);
 
         // retry a few times in case the port is somehow in use.
         // this is a WORKAROUND for flaky testing if we run tests very fast after each other.
@@ -126,7 +133,7 @@ public:
         {
             ChipLogProgress(NotSpecified, "RETRYING tcp initialization");
             chip::test_utils::SleepMillis(100);
-            err = tcp.Init(Transport::TcpListenParameters(mContext.GetTCPEndPointManager()).SetAddressType(addr.Type()));
+            err = tcp.Init(params);
         }
 
         NL_TEST_ASSERT(mSuite, err == CHIP_NO_ERROR);
@@ -137,7 +144,7 @@ public:
         mReceiveHandlerCallCount = 0;
     }
 
-    void SingleMessageTest(TCPImpl & tcp, const IPAddress & addr)
+    chip::System::PacketBufferHandle NewPayloadMessage()
     {
         chip::System::PacketBufferHandle buffer = chip::System::PacketBufferHandle::NewWithData(PAYLOAD, sizeof(PAYLOAD));
         NL_TEST_ASSERT(mSuite, !buffer.IsNull());
@@ -145,19 +152,84 @@ public:
         PacketHeader header;
         header.SetSourceNodeId(kSourceNodeId).SetDestinationNodeId(kDestinationNodeId).SetMessageCounter(kMessageCounter);
 
+        CHIP_ERROR err = header.EncodeBeforeData(buffer);
+        NL_TEST_ASSERT(mSuite, err == CHIP_NO_ERROR);
+        return buffer;
+    }
+
+    void SingleMessageTest(TCPImpl & tcp, const IPAddress & addr)
+    {
+        mReceiveHandlerCallCount = 0;
+
         SetCallback([](const uint8_t * message, size_t length, int count, void * data) { return memcmp(message, data, length); },
                     const_cast<void *>(static_cast<const void *>(PAYLOAD)));
 
-        CHIP_ERROR err = header.EncodeBeforeData(buffer);
+        // Should be able to send a message to itself by just calling send.
+        CHIP_ERROR err = tcp.SendMessage(Transport::PeerAddress::TCP(addr), NewPayloadMessage());
         NL_TEST_ASSERT(mSuite, err == CHIP_NO_ERROR);
 
-        // Should be able to send a message to itself by just calling send.
-        err = tcp.SendMessage(Transport::PeerAddress::TCP(addr), std::move(buffer));
+        mContext.DriveIOUntil(chip::System::Clock::Seconds16(5), [this]() { return mReceiveHandlerCallCount != 0; });
+        NL_TEST_ASSERT(mSuite, mReceiveHandlerCallCount == 1);
+
+        SetCallback(nullptr);
+    }
+
+    // Queues messages while the connection is being established, past the limit of data waiting for sending.
+    void PendingSendLimitTest(TCPImpl & tcp, const IPAddress & addr)
+    {
+        mReceiveHandlerCallCount = 0;
+
+        CHIP_ERROR err = tcp.SendMessage(Transport::PeerAddress::TCP(addr), NewPayloadMessage());
         NL_TEST_ASSERT(mSuite, err == CHIP_NO_ERROR);
+        err = tcp.SendMessage(Transport::PeerAddress::TCP(addr), NewPayloadMessage());
+        NL_TEST_ASSERT(mSuite, err == CHIP_ERROR_BUSY);
 
         mContext.DriveIOUntil(chip::System::Clock::Seconds16(5), [this]() { return mReceiveHandlerCallCount != 0; });
         NL_TEST_ASSERT(mSuite, mReceiveHandlerCallCount == 1);
 
+        // Once the connection has caught up, sending is possible again.
+        err = tcp.SendMessage(Transport::PeerAddress::TCP(addr), NewPayloadMessage());
+        NL_TEST_ASSERT(mSuite, err == CHIP_NO_ERROR);
+
+        mContext.DriveIOUntil(chip::System::Clock::Seconds16(5), [this]() { return mReceiveHandlerCallCount == 2; });
+        NL_TEST_ASSERT(mSuite, mReceiveHandlerCallCount == 2);
+    }
+
+    // Sends messages of various sizes back to back, so that they are received together and have to be framed.
+    void MultipleMessagesTest(TCPImpl & tcp, const IPAddress & addr)
+    {
+        static constexpr uint16_t kPayloadLengths[] = { 6, 1000, 1, 300 };
+
+        SetCallback([](const uint8_t * message, size_t length, int count, void * data) {
+            const uint8_t fill = static_cast<uint8_t>(count);
+            if (static_cast<size_t>(count) >= ArraySize(kPayloadLengths) || length != kPayloadLengths[count])
+            {
+                return -1;
+            }
+            return std::all_of(message, message + length, [fill](uint8_t byte) { return byte == fill; }) ? 0 : -1;
+        });
+
+        for (size_t i = 0; i < ArraySize(kPayloadLengths); i++)
+        {
+            chip::System::PacketBufferHandle buffer = chip::System::PacketBufferHandle::New(kPayloadLengths[i]);
+            NL_TEST_ASSERT(mSuite, !buffer.IsNull());
+            memset(buffer->Start(), static_cast<int>(i), kPayloadLengths[i]);
+            buffer->SetDataLength(kPayloadLengths[i]);
+
+            PacketHeader header;
+            header.SetSourceNodeId(kSourceNodeId).SetDestinationNodeId(kDestinationNodeId).SetMessageCounter(kMessageCounter);
+
+            CHIP_ERROR err = header.EncodeBeforeData(buffer);
+            NL_TEST_ASSERT(mSuite, err == CHIP_NO_ERROR);
+
+            err = tcp.SendMessage(Transport::PeerAddress::TCP(addr), std::move(buffer));
+            NL_TEST_ASSERT(mSuite, err == CHIP_NO_ERROR);
+        }
+
+        mContext.DriveIOUntil(chip::System::Clock::Seconds16(5),
+                              [this]() { return mReceiveHandlerCallCount == static_cast<int>(ArraySize(kPayloadLengths)); });
+        NL_TEST_ASSERT(mSuite, mReceiveHandlerCallCount == static_cast<int>(ArraySize(kPayloadLengths)));
+
         SetCallback(nullptr);
     }
 
@@ -232,6 +304,51 @@ void CheckMessageTest6(nlTestSuite * inSuite, void * inContext)
     CheckMessageTest(inSuite, inContext, addr);
 }
 
+void CheckMultipleMessagesTest6(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+    TCPImpl tcp;
+    IPAddress addr;
+    IPAddress::FromString("::1", addr);
+
+    MockTransportMgrDelegate gMockTransportMgrDelegate(inSuite, ctx);
+    gMockTransportMgrDelegate.InitializeMessageTest(tcp, addr);
+    gMockTransportMgrDelegate.MultipleMessagesTest(tcp, addr);
+    gMockTransportMgrDelegate.FinalizeMessageTest(tcp, addr);
+}
+
+#if INET_TCP_IDLE_CHECK_INTERVAL > 0
+void CheckIdleTimeoutTest6(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+    TCPImpl tcp;
+    IPAddress addr;
+    IPAddress::FromString("::1", addr);
+
+    MockTransportMgrDelegate gMockTransportMgrDelegate(inSuite, ctx);
+    gMockTransportMgrDelegate.InitializeMessageTest(tcp, addr, System::Clock::Milliseconds32(300));
+    gMockTransportMgrDelegate.SingleMessageTest(tcp, addr);
+
+    // Both ends of the connection are closed once idle, without disconnecting.
+    NL_TEST_ASSERT(inSuite, tcp.HasActiveConnections());
+    ctx.DriveIOUntil(chip::System::Clock::Seconds16(5), [&tcp]() { return !tcp.HasActiveConnections(); });
+    NL_TEST_ASSERT(inSuite, !tcp.HasActiveConnections());
+}
+#endif // INET_TCP_IDLE_CHECK_INTERVAL > 0
+
+void CheckPendingSendLimitTest6(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+    TCPImpl tcp;
+    IPAddress addr;
+    IPAddress::FromString("::1", addr);
+
+    MockTransportMgrDelegate gMockTransportMgrDelegate(inSuite, ctx);
+    gMockTransportMgrDelegate.InitializeMessageTest(tcp, addr, System::Clock::kZero, 40);
+    gMockTransportMgrDelegate.PendingSendLimitTest(tcp, addr);
+    gMockTransportMgrDelegate.FinalizeMessageTest(tcp, addr);
+}
+
 // Generates a packet buffer or a chain of packet buffers for a single message.
 struct TestData
 {
@@ -453,6 +570,35 @@ void chip::Transport::TCPTest::CheckProcessReceivedBuffer(nlTestSuite * inSuite,
     gMockTransportMgrDelegate.FinalizeMessageTest(tcp, addr);
 }
 
+// Connects, exchanges a message and disconnects many times, more than connections are available.
+void chip::Transport::TCPTest::CheckConnectionChurn(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr size_t kChurnIterations = 8 * kMaxTcpActiveConnectionCount;
+
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+    TCPImpl tcp;
+
+    IPAddress addr;
+    IPAddress::FromString("::1", addr);
+
+    MockTransportMgrDelegate gMockTransportMgrDelegate(inSuite, ctx);
+    gMockTransportMgrDelegate.InitializeMessageTest(tcp, addr);
+
+    for (size_t i = 0; i < kChurnIterations; i++)
+    {
+        gMockTransportMgrDelegate.SingleMessageTest(tcp, addr);
+
+        // Both the connecting and the accepted end of the connection are in use.
+        NL_TEST_ASSERT(inSuite, tcp.mUsedEndPointCount == 2);
+        NL_TEST_ASSERT(inSuite, tcp.FindActiveConnection(Transport::PeerAddress::TCP(addr)) != nullptr);
+
+        gMockTransportMgrDelegate.FinalizeMessageTest(tcp, addr);
+        NL_TEST_ASSERT(inSuite, !tcp.HasActiveConnections());
+        NL_TEST_ASSERT(inSuite, tcp.mUsedEndPointCount == 0);
+        NL_TEST_ASSERT(inSuite, tcp.mFreeConnections != nullptr);
+    }
+}
+
 // Test Suite
 /**
  *  Test Suite that lists all the test functions.
@@ -467,7 +613,13 @@ static const nlTest sTests[] =
 
     NL_TEST_DEF("Simple Init Test IPV6",        CheckSimpleInitTest6),
     NL_TEST_DEF("Message Self Test IPV6",       CheckMessageTest6),
+    NL_TEST_DEF("Multiple Messages Test IPV6",  CheckMultipleMessagesTest6),
     NL_TEST_DEF("ProcessReceivedBuffer Test",   chip::Transport::TCPTest::CheckProcessReceivedBuffer),
+    NL_TEST_DEF("Connection Churn Test",        chip::Transport::TCPTest::CheckConnectionChurn),
+#if INET_TCP_IDLE_CHECK_INTERVAL > 0
+    NL_TEST_DEF("Idle Timeout Test IPV6",       CheckIdleTimeoutTest6),
+#endif
+    NL_TEST_DEF("Pending Send Limit Test IPV6", CheckPendingSendLimitTest6),
 
     NL_TEST_SENTINEL()
 };